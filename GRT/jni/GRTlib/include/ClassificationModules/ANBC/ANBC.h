@@ -106,6 +106,63 @@ public:
     */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
+    /**
+     This predicts the class of the inputVector with the float copy of the class models.  The float models work directly in the log domain,
+     so an input that is very far from every class still gets a finite log likelihood for each class.
+     This overrides the predictFloatInplace function in the MLBase base class.
+     
+     @param VectorFloat &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictFloatInplace(VectorFloat &inputVector);
+    
+    /**
+     The ANBC algorithm supports the float prediction path.
+     
+     @return returns true
+    */
+    virtual bool getSupportsFloatPrediction() const{ return true; }
+    
+    /**
+     This predicts the class of the inputVector without modifying the ANBC instance, the results are written to the prediction.
+     This overrides the predictShared function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassifierPrediction &prediction: the prediction that the results will be written to
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const;
+    
+    /**
+     The ANBC algorithm supports shared prediction.
+     
+     @return returns true
+    */
+    virtual bool getSupportsSharedPrediction() const{ return true; }
+    
+    /**
+     This classifies each row in the inputData, giving the same results as calling predict on each row in turn.
+     Each class model is run over the whole batch in turn, so the parameters of one model stay in the cache.
+     This overrides the predictBatch function in the Classifier base class.
+     
+     @param const MatrixDouble &inputData: the data to classify, each row is one sample
+     @param vector< UINT > &predictedClassLabels: will be filled with the predicted class label of each row
+     @param MatrixDouble &predictedClassLikelihoods: will be filled with the class likelihoods of each row
+     @param MatrixDouble &predictedClassDistances: will be filled with the class distances of each row
+     @return returns true if the batch was classified, false otherwise
+    */
+    virtual bool predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances);
+    
     /**
      This resets the ANBC classifier.
      
@@ -216,9 +273,34 @@ private:
      */
     bool train(LabelledClassificationData &trainingData,double gamma);
     
+    /**
+     Computes the class likelihoods, the predicted class label and the maximum likelihood from the log likelihood in the class distances.
+     
+     @return returns void
+     */
+    void predictFromClassDistances();
+    
+    /**
+     Computes the class likelihoods, the predicted class label and the maximum likelihood from the log likelihood in the class distances,
+     without using any of the classifier's own outputs.  This is used by both predictFromClassDistances and predictShared.
+     
+     @return returns void
+     */
+    void predictFromClassDistances(const VectorDouble &classDistances,VectorDouble &classLikelihoods,UINT &predictedClassLabel,double &maxLikelihood) const;
+    
+    /**
+     Builds the float copy of the class models, the log likelihood of class k is floatLogOffsets[k] - sum_j floatPrecision[k][j]*(x[j]-floatMu[k][j])^2.
+     
+     @return returns true if the float model was built, false otherwise
+     */
+    virtual bool buildFloatModel();
+    
     bool weightsDataSet;                  //A flag to indicate if the user has manually set the weights buffer
     LabelledClassificationData weightsData; //The weights of each feature for each class for training the algorithm
 	vector< ANBC_Model > models;            //A buffer to hold all the models
+    MatrixFloat floatMu;                    //The mean of each dimension for each class, used by the float prediction path
+    MatrixFloat floatPrecision;             //1/(2*sigma^2) for each dimension of each class, this is zero for dimensions with a zero weight
+    VectorDouble floatLogOffsets;           //The sum of log(weight/(sigma*sqrt(2*PI))) over the weighted dimensions of each class
     
     static RegisterClassifierModule< ANBC > registerModule;
 };
@@ -113,6 +113,16 @@ public:
      */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
     /**
      This overrides the clear function in the Classifier base class.
      It will completely clear the ML module, removing any trained model and setting all the base variables to their default values.
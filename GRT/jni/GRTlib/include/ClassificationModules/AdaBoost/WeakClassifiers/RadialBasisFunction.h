@@ -162,6 +162,7 @@ public:
     
 protected:
     double rbf(const VectorDouble &a,const VectorDouble &b);
+    double rbf(const double *a,const VectorDouble &b);
   
     UINT numSteps;
     double positiveClassificationThreshold;
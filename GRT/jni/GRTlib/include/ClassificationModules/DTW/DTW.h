@@ -86,6 +86,73 @@ public:
 	UINT averageTemplateLength;          //The average length of the examples used to train this template
 };
 
+///////////////// DTW Template Bounds /////////////////
+//The warping band of a template for input time series of one specific length, along with the LB_Keogh envelope of the template over that band.
+//These are used by the banded search (in both prediction modes) and are rebuilt whenever the input length, warping radius or warping constraint changes.
+class DTWTemplateBounds{
+public:
+	DTWTemplateBounds(){
+        inputLength = 0;
+        radius = 0;
+        constrainWarpingPath = false;
+        connected = false;
+        bufferSize = 0;
+	}
+	~DTWTemplateBounds(){};
+
+    UINT inputLength;                   //The length of the input time series these bounds were computed for
+    double radius;                      //The warping radius these bounds were computed for
+    bool constrainWarpingPath;          //If the warping path was constrained when these bounds were computed
+    bool connected;                     //True if the template is finite and every cell in the band can be reached from the end of the cost matrix, the banded search can only be used if this is true
+    UINT bufferSize;                    //The number of cells that need to be stored for this template
+    vector< UINT > bandStart;           //The first column inside the warping band, for each row of the cost matrix
+    vector< UINT > bandEnd;             //The last column inside the warping band, for each row of the cost matrix
+    vector< UINT > rowStart;            //The first column stored for each row, this includes the cells that border the band and can be reached by the warping path
+    vector< UINT > rowEnd;              //The last column stored for each row
+    vector< UINT > rowOffset;           //The position of the first stored cell of each row in the cost buffer
+};
+
+///////////////// DTW Search Cell /////////////////
+//One cell on the stack of the full cost matrix search, along with the costs of the cells it depends on that have been searched so far.
+class DTWSearchCell{
+public:
+	DTWSearchCell(const int m=0,const int n=0){
+        this->m = m;
+        this->n = n;
+        numSearched = -1;
+        contribDist[0] = contribDist[1] = contribDist[2] = 0;
+	}
+	~DTWSearchCell(){};
+
+    int m;                              //The row of the cell
+    int n;                              //The column of the cell
+    int numSearched;                    //The number of cells this cell depends on that have been searched, -1 if the cell has not been tested yet
+    double contribDist[3];              //The costs of the cells this cell depends on, in the order they are searched
+};
+
+///////////////// DTW Streaming State /////////////////
+//The state of the streaming (SPRING) search for one template.  This holds the last column of the subsequence cost matrix, along with the best
+//match that has been found but not yet reported.
+class DTWStreamingState{
+public:
+	DTWStreamingState(){
+        matchFound = false;
+        matchDistance = 0;
+        matchStart = 0;
+        matchEnd = 0;
+	}
+	~DTWStreamingState(){};
+
+    VectorDouble cost;                  //The accumulated cost of the best warping path ending at each template sample and the last input sample
+    VectorDouble pathCostSum;           //The sum of the accumulated costs along each of these warping paths
+    vector< UINT > startIndex;          //The input sample each of these warping paths started at
+    vector< UINT > pathLength;          //The number of cells along each of these warping paths
+    bool matchFound;                    //True if a match has been found that has not been reported yet
+    double matchDistance;               //The distance of the match, the average of the accumulated costs along its warping path
+    UINT matchStart;                    //The input sample the match started at
+    UINT matchEnd;                      //The input sample the match ended at
+};
+
 class DTW : public Classifier
 {
 public:
@@ -154,6 +221,34 @@ public:
      */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
+    /**
+     This predicts the class of the float inputVector, the sample is converted to double and added to the realtime buffer.
+     When float prediction is enabled the banded search computes its local costs against a float copy of the templates, the cost
+     matrix and the full search (used when the band can not be used) stay in double.
+     This overrides the predictFloatInplace function in the MLBase base class.
+     
+     @param VectorFloat &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictFloatInplace(VectorFloat &inputVector);
+    
+    /**
+     The DTW algorithm supports the float prediction path.
+     
+     @return returns true
+     */
+    virtual bool getSupportsFloatPrediction() const{ return true; }
+    
     /**
      This predicts the class of the timeseries.
      This overrides the predict function in the Classifier base class.
@@ -214,6 +309,27 @@ public:
      */
     virtual bool loadModelFromFile(fstream &file);
     
+    /**
+     This saves the trained DTW model to a binary model file.  The settings are written as text and the time series of the templates
+     are written as a binary section.
+     This overrides the saveModelToBinaryFile function in the MLBase class.
+     
+     @param BinaryModelWriter &file: a reference to the binary model file the model will be saved to
+     @param const string &sectionName: the name of the section the model should be saved to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) const;
+    
+    /**
+     This loads a trained DTW model from a binary model file, the time series of the templates are copied out of the file without being parsed.
+     This overrides the loadModelFromBinaryFile function in the MLBase class.
+     
+     @param BinaryModelReader &file: a reference to the binary model file the model will be loaded from
+     @param const string &sectionName: the name of the section the model was saved to
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName);
+    
     /**
      This recomputes the null rejection thresholds for each of the classes in the DTW model.
      This will be called automatically if the setGamma(double gamma) function is called.
@@ -265,12 +381,90 @@ public:
      */
     bool setWarpingRadius(double radius);
 
+    /**
+     Deprecated, this setting no longer changes the prediction.  The standard search already fills only the cells inside the warping band of each
+     template, one row at a time, which is what the fast mode used to do.  The lower bounds the fast mode added on top of it could skip almost no
+     templates, as the DTW distance is the average of the accumulated costs along the warping path and the bounds can only be built from the local
+     costs, so the fast mode was no faster and left approximate class distances for the templates it skipped.  The setting is kept so existing code
+     still builds and getFastPredictionEnabled still returns the value that was set.
+     
+     @param bool useFastPrediction: the value returned by getFastPredictionEnabled
+     @return returns true
+     */
+    bool enableFastPrediction(bool useFastPrediction);
+
+    /**
+     Sets if the streaming prediction mode should be used for continuous prediction (i.e. when predict is called with a VectorDouble).  In the streaming
+     mode each template is matched against every subsequence of the input stream using the SPRING algorithm, rather than running DTW against the
+     last averageTemplateLength samples every time a new sample arrives.  Each new sample updates one column of the cost matrix of each template, so
+     each prediction costs O(template length) per template.
+     
+     The predicted class label is set to the class of the closest template when a match ends, i.e. as soon as no later sample could make the match
+     any better, and it is set to the null class label (0) for every other sample.  The distance of a match is the same distance the window search
+     uses, the average of the accumulated costs along the warping path.  A template matches if this distance is below its null rejection threshold, or
+     any distance if null rejection is disabled, and the same distance is used to pick the best of the overlapping matches of a template and the best
+     of the templates that end a match on the same sample.  The first and last input samples of the match can be accessed via
+     getMatchStartIndex() and getMatchEndIndex(), which count the samples since the last reset.
+     
+     The warping path is not constrained in the streaming mode, and it can not be used with z-normalization, smoothing or offsetUsingFirstSample, as these
+     are applied to a whole time series.
+     
+     @param bool useStreamingPrediction: if true then the streaming prediction mode will be used for continuous prediction
+     @return returns true if the streaming prediction mode was updated successfully, false otherwise
+     */
+    bool enableStreamingPrediction(bool useStreamingPrediction);
+
+    /**
+     Sets the number of threads that will be used to compute the distances between the training examples of each class when the templates are trained.
+     Each worker thread computes all the distances for the examples it is given, using its own cost buffers, so the trained templates and null rejection
+     thresholds are exactly the same for any number of threads.  The default value is 1, which computes the distances on the calling thread.
+     
+     @param const UINT numThreads: the number of training threads, this must be greater than 0
+     @return returns true if the number of threads was set successfully, false otherwise
+     */
+    bool setNumThreads(const UINT numThreads);
+
     /**
      Gets the rejection mode used for null rejection. The rejection mode will be one of the RejectionModes enums.
      
      @return returns an unsigned integer representing the current rejection mode
      */
     UINT getRejectionMode(){ return rejectionMode; }
+
+    /**
+     Gets the value set by enableFastPrediction, which no longer changes the prediction.
+     
+     @return returns the value set by enableFastPrediction
+     */
+    bool getFastPredictionEnabled(){ return useFastPrediction; }
+
+    /**
+     Gets if the streaming prediction mode is being used for continuous prediction.
+     
+     @return returns true if the streaming prediction mode is being used, false otherwise
+     */
+    bool getStreamingPredictionEnabled(){ return useStreamingPrediction; }
+
+    /**
+     Gets the number of threads that will be used to compute the distances between the training examples.
+     
+     @return returns the number of training threads
+     */
+    UINT getNumThreads(){ return numThreads; }
+
+    /**
+     Gets the index of the first input sample of the last match found by the streaming prediction mode.  The index counts the samples since the last reset.
+     
+     @return returns the index of the first sample of the last match
+     */
+    UINT getMatchStartIndex(){ return matchStartIndex; }
+
+    /**
+     Gets the index of the last input sample of the last match found by the streaming prediction mode.  The index counts the samples since the last reset.
+     
+     @return returns the index of the last sample of the last match
+     */
+    UINT getMatchEndIndex(){ return matchEndIndex; }
     
     /**
      Sets if z-normalization should be used for both training and realtime prediction.  This should be called before training the templates.
@@ -322,27 +516,50 @@ public:
 
     /**
      Gets the distances matrices from the last prediction.  Each element in the vector represents the distance matrices for each corresponding class.
+     The prediction does not keep the distance matrices, so they are computed from the last input time series the first time they are requested.
      
      @return returns a vector of MatrixDouble containing the distance matrices from the last prediction, or an empty vector if no prediction has been made
      */
-    vector< MatrixDouble > getDistanceMatrices(){ return distanceMatrices; }
+    vector< MatrixDouble > getDistanceMatrices();
 
     /**
      Gets the warping paths from the last prediction.  Each element in the vector represents the warping path for each corresponding class.
+     The prediction does not keep the warping paths, so they are computed from the last input time series the first time they are requested.
      
      @return returns a vector of vectors containing the warping paths from the last prediction, or an empty vector if no prediction has been made
      */
-    vector< vector< IndexDist > > getWarpingPaths(){ return warpPaths; }
+    vector< vector< IndexDist > > getWarpingPaths();
 
 private:
 	//Public training and prediction methods
 	bool train_NDDTW(LabelledTimeSeriesClassificationData &trainingData,DTWTemplate &dtwTemplate,UINT &bestIndex);
+	bool saveModelData(fstream &file,const bool saveTimeSeries) const;
+	bool loadModelData(fstream &file,const double *timeSeriesData,const UINT numTimeSeriesValues);
+	bool computeTrainingDistances(vector< MatrixDouble > &examples,const vector< bool > &finiteExamples,MatrixDouble &distances);
+	static void* trainingWorkerThread(void *workerData);
 
 	//The actual DTW function
+	bool computeDistances(MatrixDouble &timeSeries);
+	bool computeWarpingPaths();
 	double computeDistance(MatrixDouble &timeSeriesA,MatrixDouble &timeSeriesB,MatrixDouble &distanceMatrix,vector< IndexDist > &warpPath);
-    double d(int m,int n,MatrixDouble &distanceMatrix,const int M,const int N);
+	void accumulateCosts(const int i,const DTWTemplateBounds &bounds,const double *prevRow,double *row) const;
+	double searchCostMatrix(MatrixDouble &distanceMatrix,const int M,const int N);
+	static bool isFinite(const MatrixDouble &timeSeries);
 	double inline MIN_(double a,double b, double c);
 
+	//The banded DTW functions
+	bool buildTemplateBounds();
+	bool computeWarpingBand(const int M,const int N,DTWTemplateBounds &bounds) const;
+	bool computeTemplateBounds(const MatrixDouble &timeSeriesA,const UINT inputLength,DTWTemplateBounds &bounds) const;
+	double computeBandedDistance(const MatrixDouble &timeSeriesA,const DTWTemplateBounds &bounds,const MatrixDouble &timeSeriesB,VectorDouble &costBuffer,const MatrixFloat *floatTimeSeriesA=NULL,const MatrixFloat *floatTimeSeriesB=NULL) const;
+	void computeCosts(const double *x,const MatrixDouble &timeSeries,const UINT startIndex,const UINT endIndex,double *costs) const;
+	void computeCosts(const float *x,const MatrixFloat &timeSeries,const UINT startIndex,const UINT endIndex,double *costs) const;
+	virtual bool buildFloatModel();
+
+	//The streaming DTW functions
+	bool predictStreaming(VectorDouble &inputVector);
+	bool resetStreamingState();
+
 	//Private Scaling and Utility Functions
 	void scaleData(LabelledTimeSeriesClassificationData &trainingData);
 	void scaleData(MatrixDouble &data,MatrixDouble &scaledData);
@@ -358,7 +575,16 @@ public:
 	vector< DTWTemplate > templatesBuffer;		//A buffer to store the templates for each time series
     vector< MatrixDouble > distanceMatrices;
     vector< vector< IndexDist > > warpPaths;
+    MatrixDouble warpingPathTimeSeries;             //The time series of the last prediction, the distance matrices and warping paths are built from this when they are requested
     CircularBuffer< VectorDouble > continuousInputDataBuffer;
+    vector< DTWTemplateBounds > templateBounds;     //The warping band of each template, used by the banded search
+    VectorDouble costBuffer;                        //Stores the cells of the cost matrix that are inside (or border) the warping band, used by the banded search
+    vector< MatrixFloat > floatTemplates;           //A float copy of each template, used by the banded search when float prediction is enabled
+    MatrixFloat floatTimeSeries;                    //A float copy of the time series that is being classified
+    vector< DTWStreamingState > streamingStates;    //The state of the streaming search for each template
+    UINT                streamingSampleIndex;   //The number of samples the streaming search has processed since the last reset
+    UINT                matchStartIndex;        //The first input sample of the last match found by the streaming search
+    UINT                matchEndIndex;          //The last input sample of the last match found by the streaming search
 	UINT				numTemplates;			//The number of templates in our buffer
     UINT                rejectionMode;          //The rejection mode used to reject null gestures during the prediction phase
 
@@ -369,6 +595,8 @@ public:
 	bool				constrainZNorm;			//A flag to check if we need to constrain zNorm (only zNorm if stdDev > zNormConstrainThreshold)
 	bool				constrainWarpingPath;	//A flag to check if we need to constrain the dtw cost matrix and search
     bool                trimTrainingData;       //A flag to check if we need to trim the training data first before training
+    bool                useFastPrediction;      //The deprecated fast prediction flag, it no longer changes the prediction
+    bool                useStreamingPrediction; //A flag to check if the SPRING search should be used for continuous prediction
 
 	double				zNormConstrainThreshold;//The threshold value to be used if constrainZNorm is turned on
     double              radius;
@@ -378,6 +606,7 @@ public:
 	UINT				smoothingFactor;		//The smoothing factor if smoothing is used
 	UINT				distanceMethod;			//The distance method to be used (should be of enum DISTANCE_METHOD)
 	UINT				averageTemplateLength;	//The overall average template length (over all the templates)
+    UINT                numThreads;             //The number of threads used to compute the distances between the training examples
 	
 	enum DistanceMethods{ABSOLUTE_DIST=0,EUCLIDEAN_DIST,NORM_ABSOLUTE_DIST};
     enum RejectionModes{TEMPLATE_THRESHOLDS=0,CLASS_LIKELIHOODS,THRESHOLDS_AND_LIKELIHOODS};
@@ -0,0 +1,278 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief This class stores one or more trained decision trees in a flat layout that is fast to evaluate.
+
+ The DecisionTreeNode trees built at training time are compiled into a single contiguous array of FlatDecisionForestNode structs,
+ each tree is stored in depth first order (so a child always comes after its parent) and the trees are stored one after the other.
+ The class probabilities of every node are stored in one contiguous table, so a prediction is just a loop that steps through the
+ node array until it reaches a leaf.  This class is used by both the DecisionTree and RandomForests classifiers, it gives exactly the
+ same results as calling DecisionTreeNode::predict on each of the original trees.
+
+ Each threshold is also stored as a float, rounded up to the nearest float, so the float prediction functions take exactly the same
+ branch for a float input as the double functions take for the same input converted to a double.
+
+ A forest loaded from a memory mapped binary model file uses the arrays in the file directly, without copying them.  The forest (and
+ any copy of it) keeps the file mapped until it is cleared, adding a tree to such a forest first copies the arrays into memory.
+ */
+
+/**
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_FLAT_DECISION_FOREST_HEADER
+#define GRT_FLAT_DECISION_FOREST_HEADER
+
+#include "DecisionTreeNode.h"
+#include "../../Util/BinaryModelFile.h"
+
+namespace GRT{
+
+//The number of samples that are pushed through each tree together by predictBatch
+#define FLAT_DECISION_FOREST_BATCH_SIZE 32
+
+///////////////// Flat Decision Forest Node /////////////////
+class FlatDecisionForestNode{
+public:
+    FlatDecisionForestNode(){
+        threshold = 0;
+        featureIndex = 0;
+        leftChild = 0;
+        rightChild = 0;
+        isLeafNode = false;
+    }
+    ~FlatDecisionForestNode(){};
+
+    double threshold;                   //The decision threshold, an input goes right if x[featureIndex] >= threshold
+    UINT featureIndex;                  //The index of the feature the threshold is applied to
+    //A child always comes after its parent, so no node can have a child index of 0
+    UINT leftChild;                     //The index of the left child node, this is 0 if the node does not have a left child
+    UINT rightChild;                    //The index of the right child node, this is 0 if the node does not have a right child
+    bool isLeafNode;                    //True if this is a leaf node, the class probabilities of this node are then the prediction
+};
+
+class FlatDecisionForest : public GRTBase{
+public:
+    /**
+     Default Constructor.
+     */
+    FlatDecisionForest();
+
+    /**
+     Defines the copy constructor.
+
+     @param const FlatDecisionForest &rhs: the instance from which all the data will be copied into this instance
+     */
+    FlatDecisionForest(const FlatDecisionForest &rhs);
+
+    /**
+     Default Destructor.
+     */
+    virtual ~FlatDecisionForest();
+
+    /**
+     Defines how the data from the rhs FlatDecisionForest should be copied to this FlatDecisionForest
+
+     @param const FlatDecisionForest &rhs: another instance of a FlatDecisionForest
+     @return returns a reference to this instance of the FlatDecisionForest
+     */
+    FlatDecisionForest &operator=(const FlatDecisionForest &rhs);
+
+    /**
+     Removes all the trees and sets the number of input dimensions and classes.  This must be called before any trees are added.
+
+     @param const UINT numInputDimensions: the number of input dimensions the trees were trained with
+     @param const UINT numClasses: the number of classes, every node in the trees must have this many class probabilities
+     @return returns true if the forest was initialized, false otherwise
+     */
+    bool init(const UINT numInputDimensions,const UINT numClasses);
+
+    /**
+     Removes all the trees.
+
+     @return returns true if the forest was cleared
+     */
+    bool clear();
+
+    /**
+     Compiles a DecisionTreeNode tree into the flat layout and adds it to the end of the forest.  The tree is not modified.
+
+     @param const DecisionTreeNode *tree: a pointer to the root of the tree that should be added
+     @return returns true if the tree was added, false otherwise
+     */
+    bool addTree(const DecisionTreeNode *tree);
+
+    /**
+     Rebuilds the DecisionTreeNode tree at the treeIndex from the flat layout.
+     The user is in charge of cleaning up the memory so must delete the pointer when they no longer need it.
+
+     @param const UINT treeIndex: the index of the tree that should be rebuilt
+     @return returns a pointer to the root of the new tree, or NULL if the tree could not be rebuilt
+     */
+    DecisionTreeNode* buildTree(const UINT treeIndex) const;
+
+    /**
+     Finds the leaf that the input reaches in the tree at the treeIndex.
+
+     @param const UINT treeIndex: the index of the tree that should be used
+     @param const double *x: a pointer to the input vector, this must have numInputDimensions values
+     @return returns a pointer to the class probabilities of the leaf, or NULL if the input reached a branch that does not have a child
+     */
+    const double* predictTree(const UINT treeIndex,const double *x) const;
+
+    /**
+     Finds the leaf that the float input reaches in the tree at the treeIndex, using the float thresholds.
+
+     @param const UINT treeIndex: the index of the tree that should be used
+     @param const float *x: a pointer to the input vector, this must have numInputDimensions values
+     @return returns a pointer to the class probabilities of the leaf, or NULL if the input reached a branch that does not have a child
+     */
+    const double* predictTree(const UINT treeIndex,const float *x) const;
+
+    /**
+     Sums the class probabilities predicted by every tree in the forest, the trees are added in order.
+
+     @param const double *x: a pointer to the input vector, this must have numInputDimensions values
+     @param double *classSums: the numClasses sums will be written here
+     @return returns true if every tree made a prediction, false otherwise
+     */
+    bool predict(const double *x,double *classSums) const;
+
+    /**
+     Sums the class probabilities predicted by every tree in the forest for a float input, the trees are added in order.
+
+     @param const float *x: a pointer to the input vector, this must have numInputDimensions values
+     @param double *classSums: the numClasses sums will be written here
+     @return returns true if every tree made a prediction, false otherwise
+     */
+    bool predict(const float *x,double *classSums) const;
+
+    /**
+     Sums the class probabilities predicted by every tree in the forest for each row of the input data.  The rows are processed in
+     blocks, each tree is applied to every row in the block before moving on to the next tree, and the sums for each row are exactly
+     the same as calling predict on that row.
+
+     @param const MatrixDouble &inputData: the input data, each row is one sample and there must be numInputDimensions columns
+     @param MatrixDouble &classSums: will be resized to [numRows numClasses] and filled with the sums for each row
+     @return returns true if every tree made a prediction for every row, false otherwise
+     */
+    bool predictBatch(const MatrixDouble &inputData,MatrixDouble &classSums) const;
+
+    /**
+     This saves the flat forest to a file.
+
+     @param fstream &file: a reference to the file the forest will be saved to
+     @return returns true if the forest was saved successfully, false otherwise
+     */
+    bool saveToFile(fstream &file) const;
+
+    /**
+     This loads the flat forest from a file.  The file is checked so that every split node only points forwards to nodes in the
+     same tree and only uses valid feature indexs, which means predictions on a loaded forest always terminate.
+
+     @param fstream &file: a reference to the file the forest will be loaded from
+     @return returns true if the forest was loaded successfully, false otherwise
+     */
+    bool loadFromFile(fstream &file);
+
+    /**
+     This saves the flat forest to a binary model file, each array of the forest is written as one binary section.
+
+     @param BinaryModelWriter &file: a reference to the binary model file the forest will be saved to
+     @param const string &sectionName: the prefix of the names of the forest's sections
+     @return returns true if the forest was saved successfully, false otherwise
+     */
+    bool saveToBinaryFile(BinaryModelWriter &file,const string &sectionName) const;
+
+    /**
+     This loads the flat forest from a binary model file.  If the file is memory mapped the forest uses the arrays in the file without
+     copying them, otherwise the arrays are copied.  The forest is checked in the same way as loadFromFile.
+
+     @param BinaryModelReader &file: a reference to the binary model file the forest will be loaded from
+     @param const string &sectionName: the prefix of the names of the forest's sections
+     @return returns true if the forest was loaded successfully, false otherwise
+     */
+    bool loadFromBinaryFile(BinaryModelReader &file,const string &sectionName);
+
+    /**
+     Gets the number of trees in the forest.
+
+     @return returns the number of trees
+     */
+    UINT getNumTrees() const{ return numTrees; }
+
+    /**
+     Gets the total number of nodes in the forest.
+
+     @return returns the number of nodes
+     */
+    UINT getNumNodes() const{ return numNodes; }
+
+    /**
+     Gets the number of input dimensions the forest expects.
+
+     @return returns the number of input dimensions
+     */
+    UINT getNumInputDimensions() const{ return numInputDimensions; }
+
+    /**
+     Gets the number of classes predicted by the forest.
+
+     @return returns the number of classes
+     */
+    UINT getNumClasses() const{ return numClasses; }
+
+    /**
+     Gets if the forest is using the arrays of a memory mapped binary model file, rather than its own copy.
+
+     @return returns true if the forest is using a memory mapped file, false otherwise
+     */
+    bool getIsMemoryMapped() const{ return mappedFile.getIsOpen(); }
+
+protected:
+    bool addNode(const DecisionTreeNode *node,UINT &nodeIndex);
+    DecisionTreeNode* buildNode(const UINT nodeIndex,DecisionTreeNode *parent,const UINT depth) const;
+    bool validateForest();
+    void updateDataPointers();
+    void copyMappedData();
+    static float toFloatThreshold(const double threshold);
+
+    UINT numInputDimensions;                            ///> The number of input dimensions
+    UINT numClasses;                                    ///> The number of classes at each node
+    UINT numTrees;                                      ///> The number of trees
+    UINT numNodes;                                      ///> The number of nodes in all the trees
+    vector< UINT > treeRoots;                           ///> The index of the root node of each tree
+    vector< FlatDecisionForestNode > nodes;             ///> The nodes of every tree, each tree is stored in depth first order
+    vector< float > floatThresholds;                    ///> The threshold of each node rounded up to the nearest float
+    vector< UINT > nodeSizes;                           ///> The number of training samples that reached each node
+    vector< double > classProbabilities;                ///> The class probabilities of each node, [numNodes numClasses] in row major order
+    //The arrays used for prediction, these point into the vectors above or into the memory mapped file
+    const UINT *treeRootData;
+    const FlatDecisionForestNode *nodeData;
+    const float *floatThresholdData;
+    const UINT *nodeSizeData;
+    const double *classProbabilityData;
+    MemoryMappedFile mappedFile;                        ///> The binary model file the arrays point into, this is not open if the forest owns its arrays
+};
+
+} //End of namespace GRT
+
+#endif //GRT_FLAT_DECISION_FOREST_HEADER
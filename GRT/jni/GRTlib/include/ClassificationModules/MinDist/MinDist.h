@@ -96,6 +96,62 @@ public:
     */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
+    /**
+     This predicts the class of the inputVector with the float copy of the cluster centers.
+     This overrides the predictFloatInplace function in the MLBase base class.
+     
+     @param VectorFloat &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictFloatInplace(VectorFloat &inputVector);
+    
+    /**
+     The MinDist algorithm supports the float prediction path.
+     
+     @return returns true
+    */
+    virtual bool getSupportsFloatPrediction() const{ return true; }
+    
+    /**
+     This predicts the class of the inputVector without modifying the MinDist instance, the results are written to the prediction.
+     This overrides the predictShared function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassifierPrediction &prediction: the prediction that the results will be written to
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const;
+    
+    /**
+     The MinDist algorithm supports shared prediction.
+     
+     @return returns true
+    */
+    virtual bool getSupportsSharedPrediction() const{ return true; }
+    
+    /**
+     This classifies each row in the inputData, giving the same results as calling predict on each row in turn.
+     Each class model is run over the whole batch in turn, so the clusters of one model stay in the cache.
+     This overrides the predictBatch function in the Classifier base class.
+     
+     @param const MatrixDouble &inputData: the data to classify, each row is one sample
+     @param vector< UINT > &predictedClassLabels: will be filled with the predicted class label of each row
+     @param MatrixDouble &predictedClassLikelihoods: will be filled with the class likelihoods of each row
+     @param MatrixDouble &predictedClassDistances: will be filled with the class distances of each row
+     @return returns true if the batch was classified, false otherwise
+    */
+    virtual bool predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances);
+    
     /**
      This overrides the clear function in the Classifier base class.
      It will completely clear the ML module, removing any trained model and setting all the base variables to their default values.
@@ -184,8 +240,32 @@ private:
      */
     virtual bool train(LabelledClassificationData &trainingData,double gamma);
     
+    /**
+     Computes the class likelihoods, the predicted class label and the maximum likelihood from the class distances.
+     
+     @return returns void
+     */
+    void predictFromClassDistances();
+    
+    /**
+     Computes the class likelihoods, the predicted class label and the maximum likelihood from the class distances, without using any of
+     the classifier's own outputs.  This is used by both predictFromClassDistances and predictShared.
+     
+     @return returns void
+     */
+    void predictFromClassDistances(const VectorDouble &classDistances,VectorDouble &classLikelihoods,UINT &predictedClassLabel,double &maxLikelihood) const;
+    
+    /**
+     Stacks the cluster centers of every class model into one float matrix for the float prediction path.
+     
+     @return returns true if the float model was built, false otherwise
+     */
+    virtual bool buildFloatModel();
+    
 	UINT numClusters; 
 	vector< MinDistModel > models;            //A buffer to hold all the models
+    MatrixFloat floatClusters;                //The cluster centers of every class model stacked in class order, used by the float prediction path
+    vector< UINT > floatClusterOffsets;       //The first row of each class in floatClusters, with one extra entry for the end of the last class
     
     static RegisterClassifierModule< MinDist > registerModule;
 };
@@ -93,6 +93,46 @@ public:
     */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
+    /**
+     This predicts the class of the inputVector with the float copy of the softmax weights.  The weighted sums are computed in float,
+     the logistic function is computed in double.
+     This overrides the predictFloatInplace function in the MLBase base class.
+     
+     @param VectorFloat &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictFloatInplace(VectorFloat &inputVector);
+    
+    /**
+     The Softmax algorithm supports the float prediction path.
+     
+     @return returns true
+     */
+    virtual bool getSupportsFloatPrediction() const{ return true; }
+    
+    /**
+     This classifies each row in the inputData, giving the same results as calling predict on each row in turn.
+     Each softmax model is run over the whole batch in turn.
+     This overrides the predictBatch function in the Classifier base class.
+     
+     @param const MatrixDouble &inputData: the data to classify, each row is one sample
+     @param vector< UINT > &predictedClassLabels: will be filled with the predicted class label of each row
+     @param MatrixDouble &predictedClassLikelihoods: will be filled with the class likelihoods of each row
+     @param MatrixDouble &predictedClassDistances: will be filled with the class distances of each row
+     @return returns true if the batch was classified, false otherwise
+    */
+    virtual bool predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances);
+    
     /**
      This overrides the clear function in the Classifier base class.
      It will completely clear the ML module, removing any trained model and setting all the base variables to their default values.
@@ -195,11 +235,16 @@ public:
     
 private:
     bool trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,LabelledClassificationData &data);
+    void predictFromClassDistances();
+    virtual bool buildFloatModel();
     
     double learningRate;
     double minChange;
     UINT maxNumIterations;
     vector< SoftmaxModel > models;
+    MatrixFloat floatWeights;           //The weights of each class model, one row per class
+    VectorDouble floatBias;             //The bias (w0) of each class model
+    VectorFloat floatSums;              //A buffer for the weighted sum of each class model
     
     static RegisterClassifierModule< Softmax > registerModule;
 };
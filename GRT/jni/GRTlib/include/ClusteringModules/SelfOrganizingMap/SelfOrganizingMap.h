@@ -116,9 +116,9 @@ public:
         return exp( - (y/(2*SQR(sigma))) );
     }
     
-    bool saveNeuronToFile(fstream &file) const {
+    bool saveNeuronToFile(ostream &file) const {
         
-        if( !file.is_open() ){
+        if( !file.good() ){
             return false;
         }
         
@@ -319,6 +319,14 @@ public:
      */
     virtual bool saveModelToFile(fstream &file) const;
     
+    /**
+     This saves the trained SOM model to a stream, the SOMQuantizer uses this to save the SOM with its settings.
+     
+     @param ostream &file: a reference to the stream the SOM model will be saved to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    bool saveModelToFile(ostream &file) const;
+    
     /**
      This loads a trained SOM model from a file.
      This overrides the loadModelFromFile function in the base class.
@@ -34,6 +34,7 @@
 #include "MLBase.h"
 #include "../DataStructures/LabelledClassificationData.h"
 #include "../DataStructures/LabelledTimeSeriesClassificationData.h"
+#include "../Util/ClassifierPrediction.h"
 
 namespace GRT{
     
@@ -84,6 +85,20 @@ public:
      @return returns true if the derived class was cleared succesfully, false otherwise
      */
     virtual bool clear();
+    
+    /**
+     Classifies each row in the inputData matrix, giving the same results as calling predict on each row in turn.
+     The default implementation copies each row into a single reusable buffer and calls predictInplace, classifiers that
+     do not keep any state between predictions should override this with a batched version that processes the whole block at once.
+     After this function returns, the prediction state of the classifier (i.e. the predicted class label and class likelihoods) will match the last row.
+     
+     @param const MatrixDouble &inputData: the data to classify, each row is one sample and the number of columns must match the number of input dimensions
+     @param vector< UINT > &predictedClassLabels: will be filled with the predicted class label of each row
+     @param MatrixDouble &predictedClassLikelihoods: will be resized to [numRows numClasses] and filled with the class likelihoods of each row
+     @param MatrixDouble &predictedClassDistances: will be resized to [numRows numClasses] and filled with the class distances of each row
+     @return returns true if the batch was classified, false otherwise
+     */
+    virtual bool predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances);
 
     /**
      Returns the classifeir type as a string.
@@ -230,6 +245,27 @@ public:
      */
     bool getTimeseriesCompatible() const{ return classifierMode==TIMESERIES_CLASSIFIER_MODE; }
     
+    /**
+     Indicates if the classifier implements predictShared, so one trained instance can be used by several threads at the same time.
+     
+     @return returns true if the classifier supports shared prediction, false otherwise
+     */
+    virtual bool getSupportsSharedPrediction() const{ return false; }
+    
+    /**
+     Predicts the class of the inputVector without modifying the classifier, the predicted class label, likelihoods and distances (and any
+     scratch memory needed by the prediction) are written to the prediction instead of the classifier's own outputs.  This means several
+     threads can call predictShared on the same trained classifier at the same time, as long as each thread uses its own prediction and
+     nothing trains, loads or modifies the classifier while they are running.  Errors are not logged, so this is safe to call from any thread.
+     
+     The base class does not support shared prediction, check getSupportsSharedPrediction before calling this function.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassifierPrediction &prediction: the prediction that the results will be written to
+     @return returns true if the prediction was successful, false otherwise
+     */
+    virtual bool predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const{ return false; }
+    
     /**
      Defines a map between a string (which will contain the name of the classifier, such as ANBC) and a function returns a new instance of that classifier
      */
@@ -290,6 +326,33 @@ protected:
      @return returns true if the base settings were loaded, false otherwise
      */
     bool loadBaseSettingsFromFile(fstream &file);
+    
+    /**
+     Validates the inputData for a batch prediction and resizes the batch output buffers to match the number of rows in the inputData.
+     
+     @return returns true if the batch can be classified, false otherwise
+     */
+    bool initBatchPrediction(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances);
+    
+    /**
+     Scales each row of the inputData using the ranges computed during training, the result is stored in scaledData.
+     
+     @return returns true if the data was scaled, false otherwise
+     */
+    bool scaleBatch(const MatrixDouble &inputData,MatrixDouble &scaledData,const double minTarget,const double maxTarget);
+    
+    /**
+     Copies the current predictedClassLabel, classLikelihoods and classDistances into the rowIndex row of the batch output buffers.
+     */
+    void storeBatchPrediction(const UINT rowIndex,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances) const;
+    
+    /**
+     Checks the inputVector for a shared prediction and resizes the prediction's class likelihoods and distances to match the number of classes.
+     If the classifier uses scaling, the inputVector is scaled into the prediction's input buffer.
+     
+     @return returns a pointer to the (possibly scaled) input vector, or NULL if the classifier is not trained or the input size is wrong
+     */
+    const VectorDouble* initSharedPrediction(const VectorDouble &inputVector,ClassifierPrediction &prediction,const double minTarget,const double maxTarget) const;
 
     string classifierType;
     bool useNullRejection;
@@ -173,9 +173,9 @@ public:
 	bool getIsPostProcessingOutputModeClassLikelihoods() const;
     
     /**
-     @return returns a VectorDouble containing the most recent processed data
+     @return returns a const reference to a VectorDouble containing the most recent processed data
      */
-	VectorDouble getProcessedData() const;
+	const VectorDouble& getProcessedData() const;
     
     /**
      This typedef defines a map between a string and a PostProcessing pointer.
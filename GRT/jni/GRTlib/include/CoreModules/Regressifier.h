@@ -174,9 +174,9 @@ public:
     /**
      Gets a vector containing the regression data output by the regression algorithm, this will be an M-dimensional vector, where M is the number of output dimensions in the model.  
      
-     @return returns a vector containing the regression data output by the regression algorithm, an empty vector will be returned if the model has not been trained
+     @return returns a const reference to a vector containing the regression data output by the regression algorithm, an empty vector will be returned if the model has not been trained
      */
-    VectorDouble getRegressionData() const;
+    const VectorDouble& getRegressionData() const;
     
     /**
      Returns the ranges of the input (i.e. feature) data.
@@ -40,6 +40,8 @@
 
 namespace GRT{
 
+class LabelledClassificationDataView;
+
 class LabelledClassificationData : public GRTBase{
 public:
     
@@ -60,6 +62,13 @@ public:
 	*/
 	LabelledClassificationData(const LabelledClassificationData &rhs);
 
+    /**
+     Copies the samples of the view into this instance, this lets a view be passed to any function that takes a LabelledClassificationData.
+     
+     @param const LabelledClassificationDataView &view: the view from which the samples will be copied to this instance
+    */
+    LabelledClassificationData(const LabelledClassificationDataView &view);
+
 	/**
      Default Destructor
     */
@@ -74,25 +83,26 @@ public:
 	LabelledClassificationData& operator=(const LabelledClassificationData &rhs);
 
 	/**
-     Array Subscript Operator, returns the LabelledClassificationSample at index i.  
+     Array Subscript Operator, returns a reference to the sample at index i.  The reference points at row i of the sample matrix and the
+     i'th class label, so the sample is not copied.  The reference is only valid until the dataset is resized.
      It is up to the user to ensure that i is within the range of [0 totalNumSamples-1]
 
      @param const UINT &i: the index of the training sample you want to access.  Must be within the range of [0 totalNumSamples-1]
-     @return a reference to the i'th LabelledClassificationSample
+     @return a reference to the i'th sample
     */
-	inline LabelledClassificationSample& operator[] (const UINT &i){
-		return data[i];
+	inline LabelledClassificationSampleRef operator[] (const UINT &i){
+		return LabelledClassificationSampleRef( samples[i], &sampleLabels[i], numDimensions );
 	}
 
     /**
-     Const Array Subscript Operator, returns the LabelledClassificationSample at index i.
+     Const Array Subscript Operator, returns a const reference to the sample at index i.
      It is up to the user to ensure that i is within the range of [0 totalNumSamples-1]
 
      @param const UINT &i: the index of the training sample you want to access.  Must be within the range of [0 totalNumSamples-1]
-     @return a const reference to the i'th LabelledClassificationSample
+     @return a const reference to the i'th sample
     */
-    inline const LabelledClassificationSample& operator[] (const UINT &i) const{
-        return data[i];
+    inline ConstLabelledClassificationSampleRef operator[] (const UINT &i) const{
+        return ConstLabelledClassificationSampleRef( samples[i], &sampleLabels[i], numDimensions );
     }
 
 	/**
@@ -160,6 +170,17 @@ public:
     */
 	bool addSample(UINT classLabel,const VectorDouble &sample);
     
+	/**
+     Adds a new labelled sample to the dataset, copying the sample from a pointer to numDimensions values (such as a row of the sample
+     matrix of another dataset) without building a VectorDouble.
+     The class label should be greater than zero (as zero is used as the default null rejection class label).
+     
+     @param UINT classLabel: the class label of the corresponding sample
+     @param const double *sample: a pointer to the numDimensions values of the new sample
+     @return true if the sample was correctly added to the dataset, false otherwise
+    */
+	bool addSample(UINT classLabel,const double *sample);
+    
     /**
      Removes the last training sample added to the dataset.
      
@@ -313,9 +334,10 @@ public:
      
      @param const UINT K: the number of folds the dataset will be split into, K should be less than the number of samples in the dataset
      @param const bool useStratifiedSampling: sets if the dataset should be broken into homogeneous groups first before randomly being spilt, default value is false
+     @param const unsigned long long randomSeed: the seed used to randomly assign the samples to the folds, if this is zero then the seed will be set using the current system time, default value is 0
      @return returns true if the dataset was split correctly, false otherwise
     */
-    bool spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling = false);
+    bool spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling = false,const unsigned long long randomSeed = 0);
     
     /**
      Returns the training dataset for the k-th fold for cross validation.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
@@ -335,6 +357,38 @@ public:
     */
     LabelledClassificationData getTestFoldData(const UINT foldIndex) const;
     
+    /**
+     Returns a view of the training dataset for the k-th fold for cross validation.  The view holds the indexs of the samples rather than a copy
+     of the samples, so this dataset must not be changed while the view is in use.  The view contains the same samples, in the same order, as
+     the dataset returned by getTrainingFoldData.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
+     
+     @param const UINT foldIndex: the index of the fold you want the training data for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into 
+     @return returns a view of the training dataset
+    */
+    LabelledClassificationDataView getTrainingFoldView(const UINT foldIndex) const;
+    
+    /**
+     Returns a view of the test dataset for the k-th fold for cross validation.  The view contains the same samples, in the same order, as the
+     dataset returned by getTestFoldData.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
+     
+     @param const UINT foldIndex: the index of the fold you want the test data for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into 
+     @return returns a view of the test dataset
+    */
+    LabelledClassificationDataView getTestFoldView(const UINT foldIndex) const;
+    
+    /**
+     Randomly partitions the dataset into a training view and a test view, without changing or copying this dataset.  The samples are split in
+     the same way as the partition function splits them.
+     
+     @param const UINT trainingSizePercentage: sets the percentage of the samples that are added to the training view, the remaining samples are added to the test view
+     @param LabelledClassificationDataView &trainingSet: the view the training samples will be added to
+     @param LabelledClassificationDataView &testSet: the view the test samples will be added to
+     @param const bool useStratifiedSampling: sets if the dataset should be broken into homogeneous groups first before randomly being spilt, default value is false
+     @param const unsigned long long randomSeed: the seed used to randomly partition the samples, if this is zero then the seed will be set using the current system time, default value is 0
+     @return returns true if the views were created, false otherwise
+    */
+    bool getPartitionViews(const UINT trainingSizePercentage,LabelledClassificationDataView &trainingSet,LabelledClassificationDataView &testSet,const bool useStratifiedSampling = false,const unsigned long long randomSeed = 0) const;
+    
     /**
      Returns the all the data with the class label set by classLabel.
      The classLabel should be a valid classLabel, otherwise the dataset returned will be empty.
@@ -350,9 +404,21 @@ public:
      dataset will match the numSamples parameter.
      
      @param const UINT numSamples: the size of the bootstrapped dataset
+     @param const unsigned long long randomSeed: the seed used to randomly select the samples, if this is zero then the seed will be set using the current system time, default value is 0
      @return returns a bootstrapped LabelledClassificationData
      */
-    LabelledClassificationData getBootstrappedDataset(UINT numSamples=0) const;
+    LabelledClassificationData getBootstrappedDataset(UINT numSamples=0,const unsigned long long randomSeed=0) const;
+    
+    /**
+     Gets a bootstrapped view of the current dataset.  The view holds the indexs of the selected samples rather than a copy of the samples, so
+     this dataset must not be changed while the view is in use.  For the same randomSeed, the view contains the same samples as the dataset
+     returned by getBootstrappedDataset.
+     
+     @param const UINT numSamples: the size of the bootstrapped view, if this is zero then the size will match the size of the current dataset
+     @param const unsigned long long randomSeed: the seed used to randomly select the samples, if this is zero then the seed will be set using the current system time, default value is 0
+     @return returns a bootstrapped LabelledClassificationDataView
+     */
+    LabelledClassificationDataView getBootstrappedView(UINT numSamples=0,const unsigned long long randomSeed=0) const;
     
 	/**
      Reformats the LabelledClassificationData as LabelledRegressionData to enable regression algorithms like the MLP to be used as a classifier.
@@ -484,11 +550,12 @@ public:
     vector< MatrixDouble > getHistogramData(const UINT numBins) const;
     
 	/**
-     Gets the classification data.
+     Gets a copy of the classification data, with each sample in its own LabelledClassificationSample.
+     Use getSamples() and getSampleLabels() to read the data without copying it.
      
      @return a vector of LabelledClassificationSamples
     */
-	vector< LabelledClassificationSample > getClassificationData() const{ return data; }
+	vector< LabelledClassificationSample > getClassificationData() const;
 
     /**
      Gets the mean values across all classes in the dataset.
@@ -542,8 +609,34 @@ public:
      @return a MatrixDouble containing the data from the current dataset.
     */
     MatrixDouble getDataAsMatrixDouble() const;
+    
+    /**
+     Moves the data out of the dataset as a MatrixDouble, without copying it, and clears the dataset.  This returns just the data, not the labels.
+
+     @return a MatrixDouble containing the data that was in the dataset
+    */
+    MatrixDouble releaseDataAsMatrixDouble();
+    
+    /**
+     Gets the samples, stored as one contiguous M by N matrix where M is the number of samples and N is the number of dimensions.
+     Row i of the matrix is the i'th sample, so classifiers can read the training data directly without copying it.
+     
+     @return a const reference to the sample matrix
+    */
+    const MatrixDouble& getSamples() const{ return samples; }
+    
+    /**
+     Gets the class label of each sample, element i is the class label of row i of the sample matrix.
+     
+     @return a const reference to the vector of class labels
+    */
+    const vector< UINT >& getSampleLabels() const{ return sampleLabels; }
 
 private:
+    friend class LabelledClassificationDataView;
+    
+    void getPartitionIndexs(const UINT trainingSizePercentage,const bool useStratifiedSampling,Random &random,vector< UINT > &trainingIndexs,vector< UINT > &testIndexs) const;
+    vector< UINT > getBootstrappedIndexs(const UINT numSamples,const unsigned long long randomSeed) const;
     
     string datasetName;                                     ///< The name of the dataset
     string infoText;                                        ///< Some infoText about the dataset
@@ -555,7 +648,8 @@ private:
     bool allowNullGestureClass;                             ///< A flag that enables/disables a user from adding new samples with a class label matching the default null gesture label
     vector< MinMax > externalRanges;                        ///< A vector containing a set of externalRanges set by the user
 	vector< ClassTracker > classTracker;					///< A vector of ClassTracker, which keeps track of the number of samples of each class
-	vector< LabelledClassificationSample > data;            ///< The labelled classification data
+	MatrixDouble samples;                                   ///< The samples, stored as one contiguous [totalNumSamples numDimensions] matrix
+	vector< UINT > sampleLabels;                            ///< The class label of each sample, element i is the label of row i of the samples matrix
     vector< vector< UINT > >    crossValidationIndexs;      ///< A vector to hold the indexs of the dataset for the cross validation    
 };
 
@@ -0,0 +1,152 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The LabelledClassificationDataView is a read-only view of a subset of the samples of a LabelledClassificationData.
+
+ A view stores the indexs of its samples in the dataset rather than a copy of the samples, so a fold, a partition or a bootstrapped
+ replicate of a dataset costs one UINT per sample instead of a copy of every sample.  The [] operator of a view returns a reference to the
+ row of the dataset's sample matrix, so the samples can be read in the same way as they are read from a LabelledClassificationData.
+
+ The view points at the dataset it was created from, so the dataset must not be changed or destroyed while the view is in use.
+ Use getLabelledClassificationData() to copy the samples of a view into a new dataset that no longer depends on the original.
+
+ Views are made by the getTrainingFoldView, getTestFoldView, getPartitionViews and getBootstrappedView functions of the dataset.  Classifiers
+ can be trained with a view, classifiers that do not read views directly will copy the samples of the view into a dataset first.
+ */
+
+/**
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_LABELLED_CLASSIFICATION_DATA_VIEW_HEADER
+#define GRT_LABELLED_CLASSIFICATION_DATA_VIEW_HEADER
+
+#include "LabelledClassificationData.h"
+
+namespace GRT{
+
+class LabelledClassificationDataView{
+public:
+
+    /**
+     Default Constructor, creates an empty view that does not point at a dataset.
+    */
+    LabelledClassificationDataView();
+
+    /**
+     Creates a view of all the samples of the dataset, in the order they are stored in the dataset.  The view lists the classes in the
+     same order as the dataset and uses the same external ranges as the dataset.
+
+     @param const LabelledClassificationData &data: the dataset the view points at, this must not be changed while the view is in use
+    */
+    explicit LabelledClassificationDataView(const LabelledClassificationData &data);
+
+    /**
+     Creates a view of the samples of the dataset at the indexs.  An index can appear more than once, in which case the sample will appear
+     more than once in the view.  The classes of the view are listed in the order they first appear in the view, unless sortClassLabels is true.
+
+     @param const LabelledClassificationData &data: the dataset the view points at, this must not be changed while the view is in use
+     @param const vector< UINT > &indexs: the indexs of the samples in the dataset, each index must be less than the number of samples in the dataset
+     @param const bool sortClassLabels: sets if the classes of the view should be sorted by their class label, default value is false
+    */
+    LabelledClassificationDataView(const LabelledClassificationData &data,const vector< UINT > &indexs,const bool sortClassLabels = false);
+
+    /**
+     Default Destructor
+    */
+    ~LabelledClassificationDataView();
+
+    /**
+     Array Subscript Operator, returns a const reference to the i'th sample of the view.  The reference points at the row of the sample
+     matrix of the dataset, so the sample is not copied.
+     It is up to the user to ensure that i is within the range of [0 getNumSamples()-1]
+
+     @param const UINT &i: the index of the sample in the view.  Must be within the range of [0 getNumSamples()-1]
+     @return a const reference to the i'th sample of the view
+    */
+    inline ConstLabelledClassificationSampleRef operator[] (const UINT &i) const{
+        const UINT index = indexs[i];
+        return ConstLabelledClassificationSampleRef( data->getSamples()[index], &data->getSampleLabels()[index], numDimensions );
+    }
+
+    /**
+     Copies the samples of the view into a new dataset, in the order they appear in the view.  The classes of the new dataset are listed in
+     the same order as the classes of the view.
+
+     @return returns a new LabelledClassificationData containing a copy of the samples of the view
+    */
+    LabelledClassificationData getLabelledClassificationData() const;
+
+    /**
+     Gets the ranges of the samples in the view, or the external ranges if the view uses the external ranges of the dataset.
+
+     @return returns a vector of MinMax values representing the ranges of each dimension
+    */
+    vector< MinMax > getRanges() const;
+
+    /**
+     Gets the class labels of the view, in the same order as the class tracker.
+
+     @return returns a vector containing the class labels of the view
+    */
+    vector< UINT > getClassLabels() const;
+
+    /**
+     Gets the dataset the view points at.
+
+     @return returns a pointer to the dataset, or NULL if the view does not point at a dataset
+    */
+    const LabelledClassificationData* getDataset() const{ return data; }
+
+    /**
+     Gets the indexs of the samples of the view in the dataset, element i is the index of the i'th sample of the view.
+
+     @return returns a const reference to the indexs of the samples
+    */
+    const vector< UINT >& getIndexs() const{ return indexs; }
+
+    /**
+     Gets the class tracker of the view, this counts the samples of each class in the view.
+
+     @return returns a vector of ClassTrackers
+    */
+    const vector< ClassTracker >& getClassTracker() const{ return classTracker; }
+
+    UINT inline getNumDimensions() const{ return numDimensions; }
+    UINT inline getNumSamples() const{ return (UINT)indexs.size(); }
+    UINT inline getNumClasses() const{ return (UINT)classTracker.size(); }
+
+protected:
+    friend class LabelledClassificationData;
+
+    void updateClassTracker();
+
+    const LabelledClassificationData *data;                 ///< The dataset the view points at
+    UINT numDimensions;                                     ///< The number of dimensions of the dataset
+    bool useExternalRanges;                                 ///< A flag to show if getRanges should return the externalRanges values
+    vector< MinMax > externalRanges;                        ///< The external ranges of the dataset, these are only set if the view uses them
+    vector< UINT > indexs;                                  ///< The index of each sample of the view in the dataset
+    vector< ClassTracker > classTracker;                    ///< Keeps track of the number of samples of each class in the view
+};
+
+} //End of namespace GRT
+
+#endif //GRT_LABELLED_CLASSIFICATION_DATA_VIEW_HEADER
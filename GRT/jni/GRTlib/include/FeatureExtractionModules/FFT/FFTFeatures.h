@@ -121,10 +121,10 @@ public:
      This saves the feature extraction settings to a file.
      This overrides the saveSettingsToFile function in the FeatureExtraction base class.
      
-     @param fstream &file: a reference to the file to save the settings to
+     @param ostream &file: a reference to the file to save the settings to
      @return returns true if the settings were saved successfully, false otherwise
      */
-    virtual bool saveSettingsToFile(fstream &file) const;
+    virtual bool saveSettingsToFile(ostream &file) const;
     
     /**
      This loads the feature extraction settings from a file.
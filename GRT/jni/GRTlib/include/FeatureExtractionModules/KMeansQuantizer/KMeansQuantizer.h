@@ -128,10 +128,10 @@ public:
      This overrides the saveSettingsToFile function in the FeatureExtraction base class.
      You should add your own custom code to this function to define how your feature extraction module is saved to a file.
      
-     @param fstream &file: a reference to the file to save the settings to
+     @param ostream &file: a reference to the file to save the settings to
      @return returns true if the settings were saved successfully, false otherwise
      */
-    virtual bool saveSettingsToFile(fstream &file) const;
+    virtual bool saveSettingsToFile(ostream &file) const;
     
     /**
      This loads the feature extraction settings from a file.
@@ -96,6 +96,23 @@ class PrincipalComponentAnalysis{
      */
 	bool project(const MatrixDouble &data,MatrixDouble &prjData);
 	
+    /**
+     Sets if only the leading principal components should be computed.  When this is true the eigenvectors are found with a truncated
+     subspace iteration, which is much faster when only a few components of high dimensional data are kept.  With the maxVariance
+     version of computeFeatureVector the number of computed components is doubled until they reach the maxVariance.  The component
+     weights of the components that were not computed are set to zero.  This should be set before computeFeatureVector is called.
+
+     @param const bool useTruncatedSolver: sets if only the leading principal components should be computed. Default value=false
+     @return returns true if the parameter was updated
+     */
+    bool setUseTruncatedSolver(const bool useTruncatedSolver){ this->useTruncatedSolver = useTruncatedSolver; return true; }
+
+    /**
+     Returns true if only the leading principal components are being computed.
+     @return returns the useTruncatedSolver parameter
+     */
+    bool getUseTruncatedSolver(){ return useTruncatedSolver; }
+
     /**
      Returns true if the module was trained.
      @return returns true if the module has been trained, false otherwise
@@ -158,6 +175,7 @@ protected:
 
     bool trained;
     bool normData;
+    bool useTruncatedSolver;
 	UINT numInputDimensions;
 	UINT numPrincipalComponents;
     double maxVariance;
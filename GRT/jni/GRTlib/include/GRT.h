@@ -59,11 +59,19 @@
 #include "Util/EigenvalueDecomposition.h"
 #include "Util/TestResult.h"
 #include "Util/ClassificationResult.h"
+#include "Util/PredictionResult.h"
+#include "Util/LockFreeQueue.h"
+#include "Util/LatencyHistogram.h"
+#include "Util/PipelineProfiler.h"
+#include "Util/ClassifierPrediction.h"
+#include "Util/BinaryModelFile.h"
+#include "Util/FeatureCache.h"
 #include "Util/PeakDetection.h"
 #include "Util/ThresholdCrossingDetector.h"
 
 //Include the data structures
 #include "DataStructures/LabelledClassificationData.h"
+#include "DataStructures/LabelledClassificationDataView.h"
 #include "DataStructures/LabelledTimeSeriesClassificationData.h"
 #include "DataStructures/LabelledContinuousTimeSeriesClassificationData.h"
 #include "DataStructures/LabelledRegressionData.h"
@@ -73,6 +81,7 @@
 #include "CoreAlgorithms/EvolutionaryAlgorithm/EvolutionaryAlgorithm.h"
 #include "CoreAlgorithms/ParticleFilter/ParticleFilter.h"
 #include "CoreAlgorithms/ParticleSwarmOptimization/ParticleSwarmOptimization.h"
+#include "CoreAlgorithms/ParameterSearch/ParameterSearch.h"
 
 //Include the PreProcessing Modules
 #include "PreProcessingModules/Derivative.h"
@@ -81,6 +90,7 @@
 #include "PreProcessingModules/HighPassFilter.h"
 #include "PreProcessingModules/MovingAverageFilter.h"
 #include "PreProcessingModules/DoubleMovingAverageFilter.h"
+#include "PreProcessingModules/FusedLinearFilter.h"
 #include "PreProcessingModules/SavitzkyGolayFilter.h"
 #include "PreProcessingModules/DeadZone.h"
 
@@ -132,5 +142,7 @@
 
 //Include the Recognition Pipeline
 #include "CoreModules/GestureRecognitionPipeline.h"
+#include "CoreModules/AsyncPipeline.h"
+#include "CoreModules/PipelineSession.h"
 
 #endif //GRT_MAIN_HEADER
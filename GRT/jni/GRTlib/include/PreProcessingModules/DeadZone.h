@@ -109,10 +109,10 @@ public:
      This saves the current settings of the DeadZone to a file.
      This overrides the saveSettingsToFile function in the PreProcessing base class.
      
-     @param fstream &file: a reference to the file the settings will be saved to
+     @param ostream &file: a reference to the file the settings will be saved to
      @return returns true if the settings were saved successfully, false otherwise
      */
-    virtual bool saveSettingsToFile(fstream &file) const;
+    virtual bool saveSettingsToFile(ostream &file) const;
     
     /**
      This loads the DeadZone settings from a file.
@@ -95,6 +95,17 @@ public:
      */
     virtual bool reset();
     
+    /**
+     Gets the transfer function of the DoubleMovingAverageFilter, 2*MA(x) - MA(MA(x)), where MA is a moving average of size filterSize.
+     Like the MovingAverageFilter, the transfer function only matches the filter after its startup transient of 2*filterSize samples.
+     This overrides the getTransferFunction function in the PreProcessing base class.
+     
+     @param VectorDouble &numerator: will be set to the numerator coefficients of the transfer function
+     @param VectorDouble &denominator: will be set to the denominator coefficients of the transfer function
+     @return returns true if the filter has been initialized, false otherwise
+     */
+    virtual bool getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const;
+    
     /**
      This saves the current settings of the DoubleMovingAverageFilter to a file.
      This overrides the saveSettingsToFile function in the PreProcessing base class.
@@ -108,10 +119,10 @@ public:
      This saves the current settings of the DoubleMovingAverageFilter to a file.
      This overrides the saveSettingsToFile function in the PreProcessing base class.
      
-     @param fstream &file: a reference to the file the settings will be saved to
+     @param ostream &file: a reference to the file the settings will be saved to
      @return returns true if the settings were saved successfully, false otherwise
      */
-    virtual bool saveSettingsToFile(fstream &file) const;
+    virtual bool saveSettingsToFile(ostream &file) const;
     
     /**
      This loads the DoubleMovingAverageFilter settings from a file.
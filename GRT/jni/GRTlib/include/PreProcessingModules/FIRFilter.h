@@ -99,6 +99,16 @@ public:
      */
     virtual bool reset();
     
+    /**
+     Gets the transfer function of the FIRFilter, the FIR filter with gain*z as its coefficients.
+     This overrides the getTransferFunction function in the PreProcessing base class.
+     
+     @param VectorDouble &numerator: will be set to the numerator coefficients of the transfer function
+     @param VectorDouble &denominator: will be set to the denominator coefficients of the transfer function
+     @return returns true if the filter has been initialized, false otherwise
+     */
+    virtual bool getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const;
+    
     /**
      Sets the PreProcessing clear function, overwriting the base PreProcessing function.
      This function clears the filter values and de-initiliazes the filter.
@@ -120,10 +130,10 @@ public:
      This saves the current settings of the FIRFilter to a file.
      This overrides the saveSettingsToFile function in the PreProcessing base class.
      
-     @param fstream &file: a reference to the file the settings will be saved to
+     @param ostream &file: a reference to the file the settings will be saved to
      @return returns true if the settings were saved successfully, false otherwise
      */
-    virtual bool saveSettingsToFile(fstream &file) const;
+    virtual bool saveSettingsToFile(ostream &file) const;
     
     /**
      This loads the FIRFilter settings from a file.
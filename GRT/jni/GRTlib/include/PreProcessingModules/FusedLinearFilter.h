@@ -0,0 +1,240 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief This class implements a multichannel linear time invariant filter, that runs a chain of linear filters (such as the LowPassFilter,
+ HighPassFilter, MovingAverageFilter, DoubleMovingAverageFilter and FIRFilter) as one filter.  The transfer function of a chain of linear
+ filters is the product of the transfer functions of each filter, so the FusedLinearFilter multiplies the numerator and denominator
+ coefficients of each module it fuses and runs the result in a single transposed direct form II filter.  This replaces one pass over the
+ input (and one buffer) per filter with a single pass, with the channel loop innermost so it can be vectorized.
+
+ The GestureRecognitionPipeline uses this class to fuse runs of linear pre processing modules, see GestureRecognitionPipeline::setUseFilterFusion.
+ */
+
+/**
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_FUSED_LINEAR_FILTER_HEADER
+#define GRT_FUSED_LINEAR_FILTER_HEADER
+
+#include "../CoreModules/PreProcessing.h"
+
+namespace GRT{
+
+class FusedLinearFilter : public PreProcessing{
+public:
+    /**
+     Default Constructor.  The filter is not initialized until init or fuse is called.
+     */
+    FusedLinearFilter();
+
+    /**
+     Copy Constructor, copies the FusedLinearFilter from the rhs instance to this instance
+
+	 @param const FusedLinearFilter &rhs: another instance of the FusedLinearFilter class from which the data will be copied to this instance
+     */
+    FusedLinearFilter(const FusedLinearFilter &rhs);
+
+    /**
+     Default Destructor
+     */
+	virtual ~FusedLinearFilter();
+
+    /**
+     Sets the equals operator, copies the data from the rhs instance to this instance
+
+	 @param const FusedLinearFilter &rhs: another instance of the FusedLinearFilter class from which the data will be copied to this instance
+	 @return a reference to this instance of FusedLinearFilter
+     */
+	FusedLinearFilter& operator=(const FusedLinearFilter &rhs);
+
+    /**
+     Sets the PreProcessing deepCopyFrom function, overwriting the base PreProcessing function.
+     This function is used to deep copy the values from the input pointer to this instance of the PreProcessing module.
+     This function is called by the GestureRecognitionPipeline when the user adds a new PreProcessing module to the pipeline.
+
+	 @param const PreProcessing *preProcessing: a pointer to another instance of a FusedLinearFilter, the values of that instance will be cloned to this instance
+	 @return true if the deep copy was successful, false otherwise
+     */
+    virtual bool deepCopyFrom(const PreProcessing *preProcessing);
+
+    /**
+     Sets the PreProcessing process function, overwriting the base PreProcessing function.
+     This function is called by the GestureRecognitionPipeline when any new input data needs to be processed (during the prediction phase for example).
+
+	 @param const VectorDouble &inputVector: the inputVector that should be processed.  Must have the same dimensionality as the PreProcessing module
+	 @return true if the data was processed, false otherwise
+     */
+    virtual bool process(const VectorDouble &inputVector);
+
+    /**
+     Sets the PreProcessing processBatch function, overwriting the base PreProcessing function.
+     Filters each row of the inputData in order, writing the results to the matching row of the outputData.
+
+     @param const MatrixDouble &inputData: the samples that should be processed, one sample per row
+     @param MatrixDouble &outputData: will be resized to [M numOutputDimensions] and store the processed samples
+     @return true if the data was processed, false otherwise
+     */
+    virtual bool processBatch(const MatrixDouble &inputData,MatrixDouble &outputData);
+
+    /**
+     Sets the PreProcessing reset function, overwriting the base PreProcessing function.
+     This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
+     This function sets the state of the filter to zero.
+
+	 @return true if the filter was reset, false otherwise
+     */
+    virtual bool reset();
+
+    /**
+     Sets the PreProcessing clear function, overwriting the base PreProcessing function.
+     This function removes all the coefficients that have been fused into the filter.
+
+	 @return true if the filter was cleared, false otherwise
+     */
+    virtual bool clear();
+
+    /**
+     Gets the transfer function of the fused filter, the product of the transfer functions of each of the modules that have been fused.
+     This overrides the getTransferFunction function in the PreProcessing base class.
+
+     @param VectorDouble &numerator: will be set to the numerator coefficients of the transfer function
+     @param VectorDouble &denominator: will be set to the denominator coefficients of the transfer function
+     @return returns true if the filter has been initialized, false otherwise
+     */
+    virtual bool getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const;
+
+    /**
+     This saves the current settings of the FusedLinearFilter to a file.
+     This overrides the saveSettingsToFile function in the PreProcessing base class.
+
+     @param string filename: the name of the file to save the settings to
+     @return returns true if the settings were saved successfully, false otherwise
+     */
+    virtual bool saveSettingsToFile(string filename) const;
+
+    /**
+     This saves the current settings of the FusedLinearFilter to a file.
+     This overrides the saveSettingsToFile function in the PreProcessing base class.
+
+     @param ostream &file: a reference to the file the settings will be saved to
+     @return returns true if the settings were saved successfully, false otherwise
+     */
+    virtual bool saveSettingsToFile(ostream &file) const;
+
+    /**
+     This loads the FusedLinearFilter settings from a file.
+     This overrides the loadSettingsFromFile function in the PreProcessing base class.
+
+     @param string filename: the name of the file to load the settings from
+     @return returns true if the settings were loaded successfully, false otherwise
+     */
+    virtual bool loadSettingsFromFile(string filename);
+
+    /**
+     This loads the FusedLinearFilter settings from a file.
+     This overrides the loadSettingsFromFile function in the PreProcessing base class.
+
+     @param fstream &file: a reference to the file to load the settings from
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadSettingsFromFile(fstream &file);
+
+    /**
+     Initializes the filter with the transfer function H(z) = (b[0] + b[1]z^-1 + ...) / (a[0] + a[1]z^-1 + ...).  The coefficients are
+     normalized so that a[0] is 1, and the state of the filter is set to zero.
+
+     @param const VectorDouble &numerator: the numerator coefficients (b) of the transfer function, must not be empty
+     @param const VectorDouble &denominator: the denominator coefficients (a) of the transfer function, a[0] must not be zero
+     @param const UINT numDimensions: the dimensionality of the input data to filter
+	 @return true if the filter was initialized, false otherwise
+     */
+    bool init(const VectorDouble &numerator,const VectorDouble &denominator,const UINT numDimensions);
+
+    /**
+     Fuses a linear pre processing module onto the output of this filter, so that the filter then runs the chain of all the modules that
+     have been fused so far.  If this is the first module to be fused then the filter is initialized with the transfer function and
+     dimensionality of the module, otherwise the module must have the same dimensionality as the filter.  The state of the filter is set to zero.
+
+     @param const PreProcessing &preProcessingModule: the module to fuse, its getTransferFunction function must return true
+	 @return true if the module was fused, false otherwise
+     */
+    bool fuse(const PreProcessing &preProcessingModule);
+
+    /**
+     Filters the input, this should only be called if the dimensionality of the filter was set to 1.
+
+     @param const double x: the value to filter, this should only be called if the dimensionality of the filter was set to 1
+	 @return the filtered value.  Zero will be returned if the value was not filtered
+     */
+    double filter(const double x);
+
+    /**
+     Filters the input, the dimensionality of the input vector should match that of the filter.
+
+     @param const VectorDouble &x: the values to filter, the dimensionality of the input vector should match that of the filter
+	 @return the filtered values.  An empty vector will be returned if the values were not filtered
+     */
+    VectorDouble filter(const VectorDouble &x);
+
+    /**
+     Gets the number of modules that have been fused into this filter, this is one if the filter was set directly with init.
+
+	 @return returns the number of modules that have been fused into this filter
+     */
+    UINT getNumFusedModules() const;
+
+    /**
+     Gets the order of the filter, the number of past values the filter keeps for each dimension.
+
+	 @return returns the order of the filter
+     */
+    UINT getOrder() const;
+
+    /**
+     Gets the normalized numerator coefficients of the filter.
+
+	 @return returns a VectorDouble with the numerator coefficients, this will have getOrder()+1 elements
+     */
+    VectorDouble getNumerator() const;
+
+    /**
+     Gets the normalized denominator coefficients of the filter, the first coefficient is always 1.
+
+	 @return returns a VectorDouble with the denominator coefficients, this will have getOrder()+1 elements
+     */
+    VectorDouble getDenominator() const;
+
+protected:
+    void filterSample(const double *x,double *y);
+
+    UINT numFusedModules;       ///< The number of modules that have been fused into this filter
+    VectorDouble numerator;     ///< The normalized numerator coefficients (b) of the filter
+    VectorDouble denominator;   ///< The normalized denominator coefficients (a) of the filter, a[0] is 1
+    MatrixDouble state;         ///< The transposed direct form II state of the filter, one row per delay and one column per dimension
+
+    static RegisterPreProcessingModule< FusedLinearFilter > registerModule;
+
+};
+
+}//End of namespace GRT
+
+#endif //GRT_FUSED_LINEAR_FILTER_HEADER
@@ -43,6 +43,7 @@ public:
     bool init(const UINT numInputs,const UINT actvationFunction);
     void clear();
     double fire(const VectorDouble &x);
+    double activate(const double y) const;
 	double getDerivative(const double &y);
     static bool validateActivationFunction(const UINT actvationFunction);
     
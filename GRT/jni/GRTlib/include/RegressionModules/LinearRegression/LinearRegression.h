@@ -85,6 +85,16 @@ public:
     */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to perform regression on
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
     /**
      This saves the trained Logistic Regression model to a file.
      This overrides the saveModelToFile function in the ML base class.
@@ -0,0 +1,385 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The BinaryModelWriter and BinaryModelReader classes write and read the GRT binary model file, a versioned container that stores a
+ pipeline or model as a set of named sections.
+
+ The text model files have to be parsed number by number when they are loaded, which is slow for the large arrays of some models (the
+ training samples of KNN, the templates of DTW, the nodes of a random forest).  A binary model file stores these arrays as raw binary
+ sections, each one aligned to GRT_BINARY_MODEL_FILE_ALIGNMENT bytes, so they can be copied into the model with one memcpy or, when the
+ file is memory mapped, used directly from the mapping without any copy.  The settings of a model are still stored as text sections, these
+ are written and read with the existing saveModelToFile and loadModelFromFile functions, so any module that does not write its own binary
+ sections is stored as one text section.
+
+ The file starts with a 64 byte header (the "GRTMODEL" magic, the version, a byte order check and the offset of the section table), then
+ the sections, then the section table.  Binary sections are stored in the byte order of the machine that wrote them, a file written on a
+ machine with a different byte order is rejected when it is opened.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_BINARY_MODEL_FILE_HEADER
+#define GRT_BINARY_MODEL_FILE_HEADER
+
+#include <string.h>
+#include "../CoreModules/GRTBase.h"
+
+namespace GRT{
+
+#define GRT_BINARY_MODEL_FILE_VERSION 1
+#define GRT_BINARY_MODEL_FILE_ALIGNMENT 64
+#define GRT_BINARY_MODEL_FILE_MAX_SECTION_NAME_LENGTH 47
+
+///////////////// Binary Model File Header /////////////////
+//The header at the start of every binary model file, this is 64 bytes
+class BinaryModelFileHeader{
+public:
+    BinaryModelFileHeader(){
+        memcpy( magic, "GRTMODEL", 8 );
+        version = GRT_BINARY_MODEL_FILE_VERSION;
+        byteOrder = 0x01020304;
+        alignment = GRT_BINARY_MODEL_FILE_ALIGNMENT;
+        numSections = 0;
+        tableOffset = 0;
+        memset( reserved, 0, sizeof(reserved) );
+    }
+
+    char magic[8];                      //Always "GRTMODEL"
+    UINT version;                       //The version of the file format
+    UINT byteOrder;                     //0x01020304 written in the byte order of the machine that wrote the file
+    UINT alignment;                     //The alignment of each section, in bytes
+    UINT numSections;                   //The number of sections in the section table
+    unsigned long long tableOffset;     //The position of the section table in the file
+    char reserved[32];
+};
+
+///////////////// Binary Model File Section /////////////////
+//One entry of the section table
+class BinaryModelFileSection{
+public:
+    BinaryModelFileSection(){
+        memset( name, 0, sizeof(name) );
+        type = 0;
+        reserved = 0;
+        offset = 0;
+        size = 0;
+    }
+
+    char name[ GRT_BINARY_MODEL_FILE_MAX_SECTION_NAME_LENGTH+1 ];   //The name of the section, this is null terminated
+    UINT type;                          //One of the BinaryModelWriter::SectionTypes
+    UINT reserved;
+    unsigned long long offset;          //The position of the first byte of the section in the file
+    unsigned long long size;            //The size of the section in bytes
+};
+
+///////////////// Memory Mapped File /////////////////
+//A read only view of the contents of a file.  The file is memory mapped if the platform supports it, otherwise it is read into memory.
+//Copies of a MemoryMappedFile share the same view, which stays valid until the last copy is closed or destroyed, so a model that uses
+//the data of a binary model file without copying it can keep the file mapped by keeping a copy of the MemoryMappedFile.
+class MemoryMappedFile{
+public:
+    MemoryMappedFile();
+    MemoryMappedFile(const MemoryMappedFile &rhs);
+    ~MemoryMappedFile();
+    MemoryMappedFile& operator=(const MemoryMappedFile &rhs);
+
+    /**
+     Opens the file, any previous file is closed first.
+
+     @param const string &filename: the name of the file to open
+     @param const bool useMemoryMapping: if true the file is memory mapped (if the platform supports it), otherwise it is read into memory
+     @return returns true if the file was opened, false otherwise
+     */
+    bool open(const string &filename,const bool useMemoryMapping = true);
+
+    /**
+     Releases this view of the file, the file is unmapped when the last copy of the view is released.
+     */
+    void close();
+
+    /**
+     Gets if a file is open.
+
+     @return returns true if a file is open, false otherwise
+     */
+    bool getIsOpen() const{ return shared != NULL; }
+
+    /**
+     Gets if the open file is memory mapped, if false the file was read into memory.
+
+     @return returns true if the file is memory mapped, false otherwise
+     */
+    bool getIsMapped() const{ return shared != NULL && shared->mapped; }
+
+    /**
+     Gets a pointer to the contents of the file.
+
+     @return returns a pointer to the first byte of the file, or NULL if no file is open
+     */
+    const char* getData() const{ return shared != NULL ? shared->data : NULL; }
+
+    /**
+     Gets the size of the file.
+
+     @return returns the size of the file in bytes, or 0 if no file is open
+     */
+    unsigned long long getSize() const{ return shared != NULL ? shared->size : 0; }
+
+protected:
+    struct SharedFile{
+        char *data;
+        unsigned long long size;
+        bool mapped;
+        UINT numReferences;
+    };
+    SharedFile *shared;
+};
+
+///////////////// Binary Model Writer /////////////////
+class BinaryModelWriter : public GRTBase{
+public:
+    /**
+     Default Constructor.
+     */
+    BinaryModelWriter();
+
+    /**
+     Default Destructor, this closes the file if it is still open.
+     */
+    virtual ~BinaryModelWriter();
+
+    /**
+     Creates a new binary model file, any previous file is closed first.
+
+     @param const string &filename: the name of the file to create
+     @return returns true if the file was created, false otherwise
+     */
+    bool open(const string &filename);
+
+    /**
+     Writes the section table and closes the file.  The file is not valid until it has been closed.
+
+     @return returns true if the file was written and closed, false otherwise
+     */
+    bool close();
+
+    /**
+     Gets if a file is open.
+
+     @return returns true if a file is open, false otherwise
+     */
+    bool getIsOpen() const;
+
+    /**
+     Writes a binary section.  The section will start at a multiple of GRT_BINARY_MODEL_FILE_ALIGNMENT bytes from the start of the file.
+
+     @param const string &name: the name of the section, this must be unique within the file and can not be longer than GRT_BINARY_MODEL_FILE_MAX_SECTION_NAME_LENGTH
+     @param const void *data: a pointer to the data of the section, this can be NULL if numBytes is 0
+     @param const unsigned long long numBytes: the size of the data in bytes
+     @return returns true if the section was written, false otherwise
+     */
+    bool writeSection(const string &name,const void *data,const unsigned long long numBytes);
+
+    /**
+     Writes a vector as a binary section, the elements are written as they are stored in memory.
+
+     @param const string &name: the name of the section
+     @param const vector< T > &data: the data of the section
+     @return returns true if the section was written, false otherwise
+     */
+    template< class T > bool writeSection(const string &name,const vector< T > &data){
+        return writeSection( name, data.size() > 0 ? &data[0] : NULL, (unsigned long long)data.size()*sizeof(T) );
+    }
+
+    /**
+     Starts a text section, the text should then be written to the stream returned by getTextStream and the section finished with
+     endTextSection.  The stream writes doubles with enough digits to be read back exactly.  Only one text section can be open at a time and no binary sections can be written while it is open.
+
+     @param const string &name: the name of the section
+     @return returns true if the section was started, false otherwise
+     */
+    bool beginTextSection(const string &name);
+
+    /**
+     Finishes the current text section.
+
+     @return returns true if the section was finished, false otherwise
+     */
+    bool endTextSection();
+
+    /**
+     Gets the stream that the current text section should be written to.
+
+     @return returns a reference to the stream of the file
+     */
+    fstream& getTextStream();
+
+    enum SectionTypes{BINARY_SECTION=0,TEXT_SECTION};
+
+protected:
+    bool findSection(const string &name) const;
+    bool addSection(const string &name,const UINT type,const unsigned long long offset,const unsigned long long size);
+    bool alignFile();
+
+    fstream file;
+    string textSectionName;
+    unsigned long long textSectionStart;
+    bool textSectionOpen;
+    vector< BinaryModelFileSection > sections;
+};
+
+///////////////// Binary Model Reader /////////////////
+class BinaryModelReader : public GRTBase{
+public:
+    /**
+     Default Constructor.
+     */
+    BinaryModelReader();
+
+    /**
+     Default Destructor.
+     */
+    virtual ~BinaryModelReader();
+
+    /**
+     Opens a binary model file and reads its section table, any previous file is closed first.
+
+     @param const string &filename: the name of the file to open
+     @param const bool useMemoryMapping: if true the file is memory mapped and models can use the binary sections without copying them
+     @return returns true if the file was opened, false otherwise
+     */
+    bool open(const string &filename,const bool useMemoryMapping = true);
+
+    /**
+     Closes the file.  Any model that is using the memory mapped data keeps the file mapped until the model is cleared or destroyed.
+
+     @return returns true if the file was closed
+     */
+    bool close();
+
+    /**
+     Gets if a file is open.
+
+     @return returns true if a file is open, false otherwise
+     */
+    bool getIsOpen() const;
+
+    /**
+     Gets if the file contains a section with the name.
+
+     @param const string &name: the name of the section
+     @return returns true if the section exists, false otherwise
+     */
+    bool getHasSection(const string &name) const;
+
+    /**
+     Gets a pointer to the data of a binary section, the data stays valid while the file is open (and while any copy of the
+     MemoryMappedFile returned by getMappedFile exists).
+
+     @param const string &name: the name of the section
+     @param unsigned long long &numBytes: will be set to the size of the section in bytes
+     @return returns a pointer to the data of the section, or NULL if the section does not exist (an empty section also returns NULL)
+     */
+    const void* getSection(const string &name,unsigned long long &numBytes) const;
+
+    /**
+     Gets a pointer to the data of a binary section as an array of T, the size of the section must be a multiple of sizeof(T).
+
+     @param const string &name: the name of the section
+     @param UINT &size: will be set to the number of elements in the section
+     @return returns a pointer to the first element, or NULL if the section does not exist, is empty or does not hold whole elements
+     */
+    template< class T > const T* getSectionArray(const string &name,UINT &size) const{
+        unsigned long long numBytes = 0;
+        const void *data = getSection( name, numBytes );
+        size = 0;
+        if( data == NULL || numBytes % sizeof(T) != 0 || numBytes/sizeof(T) > numeric_limits< UINT >::max() ) return NULL;
+        size = (UINT)(numBytes/sizeof(T));
+        return (const T*)data;
+    }
+
+    /**
+     Copies a binary section into a vector, the size of the section must be a multiple of sizeof(T).
+
+     @param const string &name: the name of the section
+     @param vector< T > &data: will be resized and filled with the elements of the section
+     @return returns true if the section was read, false otherwise
+     */
+    template< class T > bool readSection(const string &name,vector< T > &data) const{
+        unsigned long long numBytes = 0;
+        if( !getHasSection( name ) ) return false;
+        const void *section = getSection( name, numBytes );
+        if( numBytes % sizeof(T) != 0 ) return false;
+        data.resize( (size_t)(numBytes/sizeof(T)) );
+        if( numBytes > 0 ) memcpy( &data[0], section, (size_t)numBytes );
+        return true;
+    }
+
+    /**
+     Moves the text stream to the start of a text section, the section can then be read from the stream returned by getTextStream.
+
+     @param const string &name: the name of the section
+     @return returns true if the section was found, false otherwise
+     */
+    bool beginTextSection(const string &name);
+
+    /**
+     Gets the stream that the current text section should be read from.
+
+     @return returns a reference to the stream of the file
+     */
+    fstream& getTextStream();
+
+    /**
+     Gets the view of the file, a model that uses the binary sections without copying them should keep a copy of this.
+
+     @return returns a reference to the view of the file
+     */
+    const MemoryMappedFile& getMappedFile() const;
+
+    /**
+     Gets the names of all the sections in the file.
+
+     @return returns a vector with the name of each section, in the order they were written
+     */
+    vector< string > getSectionNames() const;
+
+    /**
+     Checks if a file starts with the binary model file magic, this does not check the rest of the file.
+
+     @param const string &filename: the name of the file to check
+     @return returns true if the file is a binary model file, false otherwise
+     */
+    static bool isBinaryModelFile(const string &filename);
+
+protected:
+    const BinaryModelFileSection* findSection(const string &name) const;
+
+    MemoryMappedFile mappedFile;
+    fstream file;
+    vector< BinaryModelFileSection > sections;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_BINARY_MODEL_FILE_HEADER
@@ -0,0 +1,76 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The ClassifierPrediction class holds the output (and the scratch memory) of one call to Classifier::predictShared, so a trained
+ classifier can be shared by several threads without any of them writing to it.  Each thread (or PipelineSession) should own its own
+ ClassifierPrediction, the buffers are resized on the first prediction and then reused.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_CLASSIFIER_PREDICTION_HEADER
+#define GRT_CLASSIFIER_PREDICTION_HEADER
+
+#include "GRTCommon.h"
+#include "IndexedDouble.h"
+
+namespace GRT {
+
+class ClassifierPrediction{
+public:
+    /**
+     Default Constructor.
+     */
+    ClassifierPrediction(){
+        clear();
+    }
+
+    /**
+     Default Destructor.
+     */
+    ~ClassifierPrediction(){
+
+    }
+
+    /**
+     Resets the outputs of the prediction, the scratch buffers keep their memory.
+     */
+    void clear(){
+        predictedClassLabel = 0;
+        maxLikelihood = 0;
+        bestDistance = 0;
+    }
+
+    UINT predictedClassLabel;               ///< The predicted class label, this will be 0 if the prediction was rejected
+    double maxLikelihood;                   ///< The likelihood of the predicted class
+    double bestDistance;                    ///< The distance (or log likelihood, depending on the classifier) of the predicted class
+    VectorDouble classLikelihoods;          ///< The likelihood of each class
+    VectorDouble classDistances;            ///< The distance of each class
+    VectorDouble inputBuffer;               ///< Scratch: the scaled copy of the input vector
+    vector< VectorDouble > buffers;         ///< Scratch: classifier specific buffers
+    vector< IndexedDouble > indexedBuffer;  ///< Scratch: classifier specific buffer (for example the nearest neighbours)
+};
+
+}//End of namespace GRT
+
+#endif //GRT_CLASSIFIER_PREDICTION_HEADER
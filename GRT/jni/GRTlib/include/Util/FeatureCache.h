@@ -0,0 +1,215 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The FeatureCache class stores the output of the pre processing and feature extraction modules of a GestureRecognitionPipeline, so
+ the pipeline can train a classifier or regressifier on the same data again without running its front end again.
+
+ The GestureRecognitionPipeline has to run every training sample through its pre processing and feature extraction modules each time it is
+ trained, even when only the settings of the classifier have changed (for example for each fold of a cross validation, or for each point of
+ a parameter sweep).  If a FeatureCache is set with GestureRecognitionPipeline::setFeatureCache, the pipeline looks up the processed
+ training data using a key built from the settings of its front end modules and the values of the training data, and only runs the front
+ end when the key is not in the cache.
+
+ The cache is bounded by a memory size.  When the data held in memory grows past this size the least recently used entries are removed, or,
+ if a spill directory has been set, written to a binary model file in that directory and read back the next time they are used.  The cache
+ can be shared by several pipelines (and by the worker threads of the k-fold training functions), all the functions are thread safe.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_FEATURE_CACHE_HEADER
+#define GRT_FEATURE_CACHE_HEADER
+
+#include <pthread.h>
+#include <list>
+#include <map>
+#include "../CoreModules/PreProcessing.h"
+#include "../CoreModules/FeatureExtraction.h"
+#include "BinaryModelFile.h"
+
+namespace GRT{
+
+#define GRT_FEATURE_CACHE_DEFAULT_MAX_MEMORY_SIZE 268435456ULL       //256MB
+#define GRT_FEATURE_CACHE_HASH_OFFSET 14695981039346656037ULL       //The default seed of the hash
+#define GRT_FEATURE_CACHE_HASH_MULTIPLIER 0xc6a4a7935bd1e995ULL     //The MurmurHash64A multiplier
+
+//One entry of the FeatureCache
+class FeatureCacheEntry{
+public:
+    FeatureCacheEntry(){
+        key = 0;
+        spilled = false;
+    }
+
+    unsigned long long getMemorySize() const{
+        return (unsigned long long)data.getSize()*sizeof(double) + (unsigned long long)sampleIndexes.size()*sizeof(UINT);
+    }
+
+    unsigned long long key;                                     //The key of the entry
+    MatrixDouble data;                                          //The processed data, this is empty when the entry has been spilled
+    vector< UINT > sampleIndexes;                               //The index of the input sample of each row of data, this is empty when the entry has been spilled
+    vector< PreProcessing* > preProcessingModules;              //Copies of the pre processing modules after they processed the data, these stay in memory when the entry is spilled
+    vector< FeatureExtraction* > featureExtractionModules;      //Copies of the feature extraction modules after they processed the data
+    bool spilled;                                               //True if the data has been written to the spill file
+    string spillFilename;                                       //The file holding the data of a spilled entry
+};
+
+class FeatureCache : public GRTBase{
+public:
+    /**
+     Default Constructor.
+
+     @param const unsigned long long maxMemorySize: the maximum size (in bytes) of the processed data the cache holds in memory, default value is 256MB
+     @param const string &spillDirectory: the directory least recently used entries are written to when the cache is full, if this is empty then they are removed, default value is empty
+     */
+    FeatureCache(const unsigned long long maxMemorySize = GRT_FEATURE_CACHE_DEFAULT_MAX_MEMORY_SIZE,const string &spillDirectory = "");
+
+    /**
+     Default Destructor.  Removes all the entries, including the files of any spilled entries.
+     */
+    virtual ~FeatureCache();
+
+    /**
+     Looks up the entry with the key, if the entry has been spilled then it is read back from its file.
+
+     @param const unsigned long long key: the key of the entry
+     @param MatrixDouble &data: if the entry is found this will be set to the processed data of the entry
+     @return returns true if the entry was found, false otherwise
+     */
+    bool lookup(const unsigned long long key,MatrixDouble &data);
+
+    /**
+     Looks up the entry with the key, if the entry is found then the state of each module is set from the copy stored with the entry (using the
+     deepCopyFrom function of the module), so the modules are left as they were after they processed the data.  The entry is only used if it
+     has a copy of each module, and the type of each copy matches the type of the module.
+
+     @param const unsigned long long key: the key of the entry
+     @param MatrixDouble &data: if the entry is found this will be set to the processed data of the entry
+     @param vector< UINT > &sampleIndexes: if the entry is found this will be set to the index of the input sample of each row of data
+     @param const vector< PreProcessing* > &preProcessingModules: the pre processing modules that will be set from the entry
+     @param const vector< FeatureExtraction* > &featureExtractionModules: the feature extraction modules that will be set from the entry
+     @return returns true if the entry was found, false otherwise
+     */
+    bool lookup(const unsigned long long key,MatrixDouble &data,vector< UINT > &sampleIndexes,const vector< PreProcessing* > &preProcessingModules,const vector< FeatureExtraction* > &featureExtractionModules);
+
+    /**
+     Adds an entry to the cache, replacing any entry with the same key.  If the cache is now larger than the maximum memory size, the least
+     recently used entries are spilled (or removed if no spill directory has been set).
+
+     @param const unsigned long long key: the key of the entry
+     @param const MatrixDouble &data: the processed data
+     @return returns true if the entry was added to the cache, false otherwise
+     */
+    bool insert(const unsigned long long key,const MatrixDouble &data);
+
+    /**
+     Adds an entry to the cache along with a copy of each module, replacing any entry with the same key.
+
+     @param const unsigned long long key: the key of the entry
+     @param MatrixDouble data: the processed data, pass a temporary (or use std::move) so the data is moved into the entry rather than copied
+     @param const vector< UINT > &sampleIndexes: the index of the input sample of each row of data
+     @param const vector< PreProcessing* > &preProcessingModules: the pre processing modules after they processed the data
+     @param const vector< FeatureExtraction* > &featureExtractionModules: the feature extraction modules after they processed the data
+     @return returns true if the entry was added to the cache, false otherwise
+     */
+    bool insert(const unsigned long long key,MatrixDouble data,const vector< UINT > &sampleIndexes,const vector< PreProcessing* > &preProcessingModules,const vector< FeatureExtraction* > &featureExtractionModules);
+
+    /**
+     Removes all the entries from the cache, including the files of any spilled entries.  The hit and miss counters are not reset.
+
+     @return returns true if the cache was cleared
+     */
+    bool clear();
+
+    /**
+     Sets the maximum size (in bytes) of the processed data the cache holds in memory.  The copies of the modules stored with each entry are not
+     counted.  If the cache is now larger than this size the least recently used entries are spilled or removed.
+
+     @param const unsigned long long maxMemorySize: the maximum memory size in bytes
+     @return returns true if the parameter was set
+     */
+    bool setMaxMemorySize(const unsigned long long maxMemorySize);
+
+    /**
+     Sets the directory least recently used entries are written to when the cache is full.  The directory must already exist.  If this is
+     empty then least recently used entries are removed from the cache.  Entries that have already been spilled stay in their files.
+
+     @param const string &spillDirectory: the spill directory
+     @return returns true if the parameter was set
+     */
+    bool setSpillDirectory(const string &spillDirectory);
+
+    unsigned long long getMaxMemorySize() const;
+    string getSpillDirectory() const;
+    unsigned long long getMemorySize() const;
+    UINT getNumEntries() const;
+    UINT getNumSpilledEntries() const;
+    unsigned long long getNumHits() const;
+    unsigned long long getNumMisses() const;
+
+    /**
+     Hashes a block of bytes with MurmurHash64A, which mixes in 8 bytes at a time.  Several blocks can be hashed into one key by passing
+     the result of one call as the hash of the next call.
+
+     @param const void *data: a pointer to the bytes
+     @param const size_t numBytes: the number of bytes
+     @param const unsigned long long hash: the hash of any previous blocks, default value is GRT_FEATURE_CACHE_HASH_OFFSET
+     @return returns the hash of the bytes
+     */
+    static unsigned long long hash(const void *data,const size_t numBytes,const unsigned long long hash = GRT_FEATURE_CACHE_HASH_OFFSET);
+
+    /**
+     Hashes a string, see hash(const void *data,const size_t numBytes,const unsigned long long hash).
+     */
+    static unsigned long long hash(const string &value,const unsigned long long hash = GRT_FEATURE_CACHE_HASH_OFFSET);
+
+protected:
+    typedef list< FeatureCacheEntry > EntryList;
+    typedef map< unsigned long long, EntryList::iterator > EntryMap;
+
+    bool findEntry(const unsigned long long key,EntryList::iterator &iter);
+    void removeEntry(EntryList::iterator iter);
+    bool spillEntry(FeatureCacheEntry &entry);
+    bool loadSpilledEntry(FeatureCacheEntry &entry);
+    void enforceMaxMemorySize();
+
+    unsigned long long maxMemorySize;
+    unsigned long long memorySize;          //The size of the data of the entries held in memory
+    unsigned long long numHits;
+    unsigned long long numMisses;
+    UINT numSpilledEntries;
+    UINT numSpillFiles;                     //Used to give each spill file a unique name
+    string spillDirectory;
+    EntryList entries;                      //The entries, most recently used first
+    EntryMap entryMap;                      //Maps each key to its entry
+    mutable pthread_mutex_t mutex;
+
+private:
+    //The cache holds the copies of the modules and the spill files, so it can not be copied
+    FeatureCache(const FeatureCache &rhs);
+    FeatureCache& operator=(const FeatureCache &rhs);
+};
+
+} //End of namespace GRT
+
+#endif //GRT_FEATURE_CACHE_HEADER
@@ -106,6 +106,7 @@ inline double antilog(const double &x){ return exp( x ); }
 
 //Include the common classes
 #include "MatrixDouble.h"
+#include "MatrixFloat.h"
 #include "MinMax.h"
 #include "ClassTracker.h"
 #include "IndexedDouble.h"
@@ -123,7 +124,11 @@ inline double antilog(const double &x){ return exp( x ); }
 #include "TimeStamp.h"
 #include "Random.h"
 #include "Util.h"
+#include "DistanceKernels.h"
+#include "MatrixKernels.h"
+#include "RunningStatistics.h"
 #include "EigenvalueDecomposition.h"
+#include "SymmetricEigenDecomposition.h"
 #include "Cholesky.h"
 #include "LUDecomposition.h"
 #include "SVD.h"
@@ -34,6 +34,7 @@ namespace GRT {
 #endif
     
 typedef std::vector<double> VectorDouble;
+typedef std::vector<float> VectorFloat;
     
 }
 
@@ -0,0 +1,367 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The LockFreeQueue class is a bounded single producer, single consumer queue that does not use any locks, so a sensor callback
+ can push samples to a worker thread without ever waiting on a mutex.
+
+ Exactly one thread may call push and exactly one (other) thread may call pop.  The slots are allocated when the queue is resized and
+ are then reused, so if every value has the same size (for example a VectorDouble with the same number of dimensions) then pushing and
+ popping do not allocate any memory.
+
+ When the queue is full the push function applies the backpressure mode of the queue:
+ - BLOCK: push waits until the consumer frees a slot (or the queue is closed)
+ - DROP_OLDEST: the oldest value that has not been popped yet is dropped to make space for the new value
+ - COALESCE: the newest value in the queue is replaced by the new value, so the backlog does not grow but the latest value is never lost
+
+ Each slot has a state word that holds the index of the value in the slot and if the slot is empty, ready or busy.  A slot is claimed
+ (ready to busy) with a compare and swap, which lets the producer drop or coalesce a value without ever racing with the consumer reading it.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_LOCK_FREE_QUEUE_HEADER
+#define GRT_LOCK_FREE_QUEUE_HEADER
+
+#include <vector>
+#include <sched.h>
+
+namespace GRT{
+
+template< class T >
+class LockFreeQueue{
+public:
+    enum BackpressureModes{BLOCK=0,DROP_OLDEST,COALESCE,NUM_BACKPRESSURE_MODES};
+
+    /**
+     Default Constructor.  The queue has no capacity until resize is called.
+     */
+    LockFreeQueue(){
+        capacity = 0;
+        mask = 0;
+        backpressureMode = DROP_OLDEST;
+        head = 0;
+        tail = 0;
+        closed = 0;
+        resetCounters();
+    }
+
+    /**
+     Init Constructor.  Resizes the queue, see resize.
+
+     @param const unsigned int capacity: the number of values the queue can hold, this is rounded up to a power of two
+     @param const T &defaultValue: the value each slot is set to, use a value with the same size as the values that will be pushed to avoid allocations
+     @param const unsigned int backpressureMode: the backpressure mode of the queue, this should be one of the BackpressureModes enums
+     */
+    LockFreeQueue(const unsigned int capacity,const T &defaultValue = T(),const unsigned int backpressureMode = DROP_OLDEST){
+        this->capacity = 0;
+        this->mask = 0;
+        this->backpressureMode = DROP_OLDEST;
+        head = 0;
+        tail = 0;
+        closed = 0;
+        resetCounters();
+        resize( capacity, defaultValue );
+        setBackpressureMode( backpressureMode );
+    }
+
+    /**
+     Default Destructor.
+     */
+    ~LockFreeQueue(){}
+
+    /**
+     Resizes the queue and removes any values in it.  This is not thread safe, it must not be called while another thread is using the queue.
+
+     @param const unsigned int requestedCapacity: the number of values the queue can hold, this is rounded up to a power of two and must be greater than zero
+     @param const T &defaultValue: the value each slot is set to, use a value with the same size as the values that will be pushed to avoid allocations
+     @return returns true if the queue was resized, false otherwise
+     */
+    bool resize(const unsigned int requestedCapacity,const T &defaultValue = T()){
+        if( requestedCapacity == 0 || requestedCapacity > MAX_CAPACITY ) return false;
+
+        capacity = 1;
+        while( capacity < requestedCapacity ) capacity <<= 1;
+        mask = capacity-1;
+
+        slots.clear();
+        slots.resize( capacity, defaultValue );
+        slotStates.resize( capacity );
+        for(unsigned int i=0; i<capacity; i++){
+            slotStates[i] = getSlotState( i, SLOT_EMPTY );
+        }
+        head = 0;
+        tail = 0;
+        closed = 0;
+        resetCounters();
+
+        return true;
+    }
+
+    /**
+     Sets the backpressure mode, which controls what push does when the queue is full.  This is not thread safe, it should be set before
+     the queue is used.
+
+     @param const unsigned int backpressureMode: the new backpressure mode, this should be one of the BackpressureModes enums
+     @return returns true if the mode was set, false otherwise
+     */
+    bool setBackpressureMode(const unsigned int backpressureMode){
+        if( backpressureMode >= NUM_BACKPRESSURE_MODES ) return false;
+        this->backpressureMode = backpressureMode;
+        return true;
+    }
+
+    /**
+     Pushes a value onto the end of the queue.  This must only be called from the producer thread.  If the queue is full then the value is
+     handled using the backpressure mode of the queue.
+
+     @param const T &value: the value to push
+     @return returns true if the value was added to the queue, false if the queue has no capacity or was closed while push was blocked
+     */
+    bool push(const T &value){
+
+        if( capacity == 0 ) return false;
+
+        const unsigned int t = tail;
+        unsigned int numWaits = 0;
+
+        while( true ){
+            //Write the value if the slot at the tail is free
+            unsigned int &state = slotStates[ t & mask ];
+            if( atomicLoad( state ) == getSlotState( t, SLOT_EMPTY ) ){
+                slots[ t & mask ] = value;
+                atomicStore( state, getSlotState( t, SLOT_READY ) );
+                atomicStore( tail, t+1 );
+                atomicAdd( numPushed, 1 );
+                const unsigned int size = t + 1 - atomicLoad( head );
+                if( size > atomicLoad( maxSize ) ) atomicStore( maxSize, size );
+                return true;
+            }
+
+            //The queue is full.  Unless the oldest value has been claimed by the consumer (which will free its slot shortly), make space
+            //using the backpressure mode
+            if( atomicLoad( closed ) ) return false;
+            const unsigned int h = atomicLoad( head );
+            const bool full = t - h >= capacity;
+            switch( backpressureMode ){
+                case DROP_OLDEST:
+                    if( full && claimSlot( h ) ){
+                        atomicStore( head, h+1 );
+                        releaseSlot( h );
+                        atomicAdd( numDropped, 1 );
+                        continue;
+                    }
+                    break;
+                case COALESCE:
+                    if( full && claimSlot( t-1 ) ){
+                        slots[ (t-1) & mask ] = value;
+                        atomicStore( slotStates[ (t-1) & mask ], getSlotState( t-1, SLOT_READY ) );
+                        atomicAdd( numPushed, 1 );
+                        atomicAdd( numCoalesced, 1 );
+                        return true;
+                    }
+                    break;
+                default:
+                    break;
+            }
+
+            wait( numWaits );
+        }
+
+        return false;
+    }
+
+    /**
+     Pops the value at the front of the queue.  This must only be called from the consumer thread.
+
+     @param T &value: if a value is popped it will be assigned to this variable
+     @return returns true if a value was popped, false if the queue was empty
+     */
+    bool pop(T &value){
+
+        while( true ){
+            const unsigned int h = atomicLoad( head );
+            if( h == atomicLoad( tail ) ) return false;
+
+            if( claimSlot( h ) ){
+                atomicStore( head, h+1 );
+                value = slots[ h & mask ];
+                releaseSlot( h );
+                return true;
+            }
+
+            //If the head has not moved then the producer is coalescing the only value in the queue, so treat the queue as empty for now
+            if( atomicLoad( head ) == h ) return false;
+        }
+
+        return false;
+    }
+
+    /**
+     Closes the queue, any push that is blocked (or any future push that finds the queue full in BLOCK mode) will return false.  Values
+     can still be popped from a closed queue.  This can be called from any thread.
+     */
+    void close(){
+        atomicStore( closed, 1 );
+    }
+
+    /**
+     Gets if the queue has been closed.
+
+     @return returns true if the queue has been closed, false otherwise
+     */
+    bool getIsClosed() const{
+        return atomicLoad( closed ) != 0;
+    }
+
+    /**
+     Gets the capacity of the queue, this is the requested capacity rounded up to a power of two.
+
+     @return returns the capacity of the queue
+     */
+    unsigned int getCapacity() const{
+        return capacity;
+    }
+
+    /**
+     Gets the number of values in the queue.  This can be called from any thread, the value is a snapshot that may be out of date by the
+     time it is used.
+
+     @return returns the number of values in the queue
+     */
+    unsigned int getSize() const{
+        return atomicLoad( tail ) - atomicLoad( head );
+    }
+
+    /**
+     Gets the largest number of values the queue has held since it was last resized.
+
+     @return returns the largest number of values the queue has held
+     */
+    unsigned int getMaxSize() const{
+        return atomicLoad( maxSize );
+    }
+
+    /**
+     Gets the number of values that have been pushed since the queue was last resized, this includes values that were later dropped.
+
+     @return returns the number of values that have been pushed
+     */
+    unsigned int getNumPushed() const{
+        return atomicLoad( numPushed );
+    }
+
+    /**
+     Gets the number of values that have been dropped by the DROP_OLDEST backpressure mode.
+
+     @return returns the number of values that have been dropped
+     */
+    unsigned int getNumDropped() const{
+        return atomicLoad( numDropped );
+    }
+
+    /**
+     Gets the number of values that have been replaced by the COALESCE backpressure mode.
+
+     @return returns the number of values that have been coalesced
+     */
+    unsigned int getNumCoalesced() const{
+        return atomicLoad( numCoalesced );
+    }
+
+    /**
+     Gets the backpressure mode of the queue.
+
+     @return returns the backpressure mode, this will be one of the BackpressureModes enums
+     */
+    unsigned int getBackpressureMode() const{
+        return backpressureMode;
+    }
+
+protected:
+    enum SlotStates{SLOT_EMPTY=0,SLOT_READY,SLOT_BUSY};
+    enum{MAX_CAPACITY=(1u<<30)};
+
+    //The state word of a slot holds the (truncated) index of the value the slot is waiting for or holding in the top 30 bits, so a stale
+    //index can never claim a slot that has since been reused for a newer value
+    static inline unsigned int getSlotState(const unsigned int index,const unsigned int state){
+        return (index << 2) | state;
+    }
+
+    inline bool claimSlot(const unsigned int index){
+        return atomicCompareExchange( slotStates[ index & mask ], getSlotState( index, SLOT_READY ), getSlotState( index, SLOT_BUSY ) );
+    }
+
+    inline void releaseSlot(const unsigned int index){
+        atomicStore( slotStates[ index & mask ], getSlotState( index+capacity, SLOT_EMPTY ) );
+    }
+
+    void resetCounters(){
+        maxSize = 0;
+        numPushed = 0;
+        numDropped = 0;
+        numCoalesced = 0;
+    }
+
+    static inline void wait(unsigned int &numWaits){
+        if( ++numWaits > 64 ) sched_yield();
+    }
+
+    static inline unsigned int atomicLoad(const unsigned int &value){
+        return __atomic_load_n( &value, __ATOMIC_ACQUIRE );
+    }
+
+    static inline void atomicStore(unsigned int &value,const unsigned int newValue){
+        __atomic_store_n( &value, newValue, __ATOMIC_RELEASE );
+    }
+
+    static inline void atomicAdd(unsigned int &value,const unsigned int delta){
+        __atomic_fetch_add( &value, delta, __ATOMIC_RELAXED );
+    }
+
+    static inline bool atomicCompareExchange(unsigned int &value,unsigned int expected,const unsigned int newValue){
+        return __atomic_compare_exchange_n( &value, &expected, newValue, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE );
+    }
+
+    //The queue can not be copied while other threads are using it
+    LockFreeQueue(const LockFreeQueue &rhs);
+    LockFreeQueue& operator=(const LockFreeQueue &rhs);
+
+    unsigned int capacity;
+    unsigned int mask;
+    unsigned int backpressureMode;
+    std::vector< T > slots;
+    std::vector< unsigned int > slotStates;
+    unsigned int head;                      ///< The index of the next value to pop, advanced by whichever thread claims that value
+    char headPadding[64];                   ///< Keeps the head and tail on separate cache lines
+    unsigned int tail;                      ///< The index the next value will be pushed to, only written by the producer
+    char tailPadding[64];
+    unsigned int closed;
+    unsigned int maxSize;
+    unsigned int numPushed;
+    unsigned int numDropped;
+    unsigned int numCoalesced;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_LOCK_FREE_QUEUE_HEADER
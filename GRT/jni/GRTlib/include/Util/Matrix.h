@@ -31,6 +31,7 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 
 namespace GRT{
     
@@ -53,6 +54,9 @@ public:
      @param const UINT cols: sets the number of columns in the matrix, must be a value greater than zero
     */
 	Matrix(const unsigned int rows,const unsigned int cols){
+        this->rows = 0;
+        this->cols = 0;
+        this->capacity = 0;
         dataPtr = NULL;
         resize(rows,cols);
 	}
@@ -69,18 +73,25 @@ public:
         this->capacity = 0;
         
 		if(this!=&rhs){
-			 this->rows = rhs.rows;
-			 this->cols = rhs.cols;
-			 this->capacity = rhs.rows;
-			 dataPtr = new T*[rows];
-			 for(unsigned int i=0; i<rows; i++){
-				 dataPtr[i] = new T[cols];
-				 for(unsigned int j=0; j<cols; j++)
-					 this->dataPtr[i][j] = rhs.dataPtr[i][j];
-			 }
+			copyFrom( rhs );
 		}
 	}
     
+#if __cplusplus >= 201103L
+    /**
+     Move Constructor, takes ownership of the data buffer from the rhs Matrix, leaving the rhs Matrix empty
+     
+     @param Matrix &&rhs: the Matrix from which the data buffer will be moved
+    */
+	Matrix(Matrix &&rhs){
+        this->dataPtr = NULL;
+        this->rows = 0;
+        this->cols = 0;
+        this->capacity = 0;
+        moveFrom( rhs );
+	}
+#endif
+    
     /**
      Copy Constructor, copies the values from the input vector to this Matrix instance.
      The input vector must be a vector< vector< T > > in a [rows cols] format.  The number of
@@ -115,9 +126,7 @@ public:
 		//Resize the matrix and copy the data
 		if( resize(tempRows,tempCols) ){
 			for(unsigned int i=0; i<tempRows; i++){
-				for(unsigned int j=0; j<tempCols; j++){
-                	dataPtr[i][j] = data[i][j];
-				}
+				std::copy( data[i].begin(), data[i].end(), (*this)[i] );
 			}
 		}
         
@@ -138,19 +147,26 @@ public:
     */
 	Matrix& operator=(const Matrix &rhs){
 		if(this!=&rhs){
-			 this->clear();
-			 this->rows = rhs.rows;
-			 this->cols = rhs.cols;
-			 this->capacity = rhs.rows;
-			 dataPtr = new T*[rows];
-			 for(unsigned int i=0; i<rows; i++){
-				 dataPtr[i] = new T[cols];
-				 for(unsigned int j=0; j<cols; j++)
-					 this->dataPtr[i][j] = rhs.dataPtr[i][j];
-			 }
+			copyFrom( rhs );
+		}
+		return *this;
+	}
+    
+#if __cplusplus >= 201103L
+    /**
+     Defines how the data from the rhs Matrix should be moved to this Matrix. The rhs Matrix will be left empty.
+     
+     @param Matrix &&rhs: another instance of a Matrix
+     @return returns a reference to this instance of the Matrix
+    */
+	Matrix& operator=(Matrix &&rhs){
+		if(this!=&rhs){
+			this->clear();
+			moveFrom( rhs );
 		}
 		return *this;
 	}
+#endif
     
     /**
      Returns a pointer to the data at row r
@@ -159,7 +175,7 @@ public:
      @return a pointer to the data at row r
     */
 	inline T* operator[](const unsigned int r){
-		return dataPtr[r];
+		return dataPtr + (size_t(r) * cols);
 	}
     
     /**
@@ -169,7 +185,7 @@ public:
      @return a const pointer to the data at row r
      */
 	inline const T* operator[](const unsigned int r) const{
-		return dataPtr[r];
+		return dataPtr + (size_t(r) * cols);
 	}
 
     /**
@@ -179,10 +195,8 @@ public:
      @return returns a row vector from the Matrix at the row index r
     */
 	std::vector<T> getRowVector(const unsigned int r) const{
-		std::vector<T> rowVector(cols);
-		for(unsigned int c=0; c<cols; c++)
-			rowVector[c] = dataPtr[r][c];
-		return rowVector;
+		const T *row = (*this)[r];
+		return std::vector<T>(row,row+cols);
 	}
 
     /**
@@ -194,7 +208,7 @@ public:
 	std::vector<T> getColVector(const unsigned int c) const{
 		std::vector<T> columnVector(rows);
 		for(unsigned int r=0; r<rows; r++)
-			columnVector[r] = dataPtr[r][c];
+			columnVector[r] = dataPtr[ size_t(r)*cols + c ];
 		return columnVector;
 	}
     
@@ -211,23 +225,9 @@ public:
         
 		if( rows == 0 || cols == 0 ) return std::vector<T>();
         
-		std::vector<T> vectorData(rows*cols);
-        
-		if( concatByRow ){
-			for(unsigned int i=0; i<rows; i++){
-				for(unsigned int j=0; j<cols; j++){
-					vectorData[ (i*cols)+j ] = dataPtr[i][j];
-				}
-			}
-		}else{
-			for(unsigned int j=0; j<cols; j++){
-				for(unsigned int i=0; i<rows; i++){
-					vectorData[ (i*cols)+j ] = dataPtr[i][j];
-				}
-			}
-		}
-        
-		return vectorData;
+		//The data is stored row by row, so the concatenation is a straight copy of the buffer. Note that the column loop has always
+		//written the data back in row order, so both values of concatByRow return the row-by-row data and this is kept for the callers
+		return std::vector<T>(dataPtr,dataPtr+getSize());
     }
 
     /**
@@ -241,21 +241,15 @@ public:
 		//Clear any previous memory
 		clear();
 		if( r > 0 && c > 0 ){
-			rows = r;
-			cols = c;
-			capacity = r;
-			dataPtr = new T*[rows];
+			dataPtr = new T[ size_t(r)*c ];
             
 			//Check to see if the memory was created correctly
 			if( dataPtr == NULL ){
-				rows = 0;
-				cols = 0;
-				capacity = 0;
 				return false;
 			}
-			for(unsigned int i=0; i<rows; i++){
-				dataPtr[i] = new T[cols];
-			}
+			rows = r;
+			cols = c;
+			capacity = r;
 			return true;
 		}
 		return false;
@@ -269,9 +263,7 @@ public:
     */
 	bool setAllValues(const T &value){
 		if(dataPtr!=NULL){
-			for(unsigned int i=0; i<rows; i++)
-				for(unsigned int j=0; j<cols; j++)
-					dataPtr[i][j] = value;
+			std::fill( dataPtr, dataPtr+getSize(), value );
             return true;
 		}
         return false;
@@ -290,8 +282,7 @@ public:
 		if( row.size() != cols ) return false;
 		if( rowIndex >= rows ) return false;
 
-		for(unsigned int j=0; j<cols; j++)
-			dataPtr[ rowIndex ][ j ] = row[ j ];
+		std::copy( row.begin(), row.end(), (*this)[rowIndex] );
         return true;
 	}
 	
@@ -309,7 +300,7 @@ public:
 		if( colIndex >= cols ) return false;
 
 		for(unsigned int i=0; i<rows; i++)
-			dataPtr[ i ][ colIndex ] = column[ i ];
+			dataPtr[ size_t(i)*cols + colIndex ] = column[ i ];
         return true;
 	}
 
@@ -318,6 +309,8 @@ public:
      the number of columns in the Matrix, unless the Matrix size has not been set, in which case the new sample size will define the
      number of columns in the Matrix.
      
+     If the Matrix has reached its capacity then the capacity is doubled, so a sequence of push_backs runs in amortized constant time.
+     
      @param const std::vector<T> &sample: the new column vector you want to add to the end of the Matrix.  Its size should match the number of columns in the Matrix
      @return returns true or false, indicating if the push was successful 
     */
@@ -329,8 +322,7 @@ public:
                 clear();
                 return false;
             }
-			for(unsigned int j=0; j<cols; j++)
-				dataPtr[0][j] = sample[j];
+			std::copy( sample.begin(), sample.end(), dataPtr );
 			return true;
 		}
 
@@ -339,44 +331,16 @@ public:
 			return false;
 		}
 
-		
-		//Check to see if we have reached the capacity, if not then simply add the new data
-		if( rows < capacity ){
-			//Add the new sample at the end
-			for(unsigned int j=0; j<cols; j++)
-				dataPtr[rows][j] = sample[j];
-				
-		}else{ //Otherwise we copy the existing data from the data ptr into a new buffer of size (rows+1) and add the sample at the end
-			T** tempDataPtr = NULL;
-			tempDataPtr = new T*[ rows+1 ];
-			if( tempDataPtr == NULL ){//If NULL then we have run out of memory
+		//Check to see if we have reached the capacity, if so then grow the buffer before adding the new data
+		if( rows >= capacity ){
+			if( !reserve( capacity > 0 ? capacity*2 : 1 ) ){
 				return false;
 			}
-			for(unsigned int i=0; i<rows+1; i++){
-				tempDataPtr[i] = new T[cols];
-			}
-
-			//Copy the original data
-			for(unsigned int i=0; i<rows; i++)
-				for(unsigned int j=0; j<cols; j++)
-					tempDataPtr[i][j] = dataPtr[i][j];
-
-			//Add the new sample at the end
-			for(unsigned int j=0; j<cols; j++)
-				tempDataPtr[rows][j] = sample[j];
-
-			//Delete the original data and copy the pointer
-			for(unsigned int i=0; i<rows; i++){
-				delete[] dataPtr[i];
-				dataPtr[i] = NULL;
-			}
-			delete[] dataPtr;
-			dataPtr = tempDataPtr;
-			
-			//Increment the capacity so it matches the number of rows
-			capacity++;
 		}
 		
+		//Add the new sample at the end
+		std::copy( sample.begin(), sample.end(), (*this)[rows] );
+		
         //Increment the number of rows
 		rows++;
 
@@ -384,6 +348,62 @@ public:
 		return true;
 	}
 	
+	/**
+     Adds a new row to the end of the Matrix, copying the values from the row pointer, which must point to at least cols values.
+     The number of columns must already be set (by a resize, a push_back of a vector or setNumCols).
+     
+     If the Matrix has reached its capacity then the capacity is doubled, so a sequence of push_backs runs in amortized constant time.
+     
+     @param const T *row: a pointer to the values of the new row
+     @return returns true or false, indicating if the push was successful 
+    */
+	bool push_back(const T *row){
+		if( cols == 0 || row == NULL ){
+			return false;
+		}
+		
+		//The row can be a row of this Matrix, so keep its offset as the reserve below can move the buffer
+		const bool isOwnRow = dataPtr != NULL && row >= dataPtr && row < dataPtr + size_t(rows)*cols;
+		const size_t rowOffset = isOwnRow ? size_t(row - dataPtr) : 0;
+		
+		if( rows >= capacity ){
+			if( !reserve( capacity > 0 ? capacity*2 : 1 ) ){
+				return false;
+			}
+			if( isOwnRow ) row = dataPtr + rowOffset;
+		}
+		
+		std::copy( row, row+cols, dataPtr + size_t(rows)*cols );
+		rows++;
+		
+		return true;
+	}
+	
+	/**
+     Removes the last row of the Matrix. The buffer is kept, so the capacity of the Matrix does not change and new rows can be pushed
+     back without a reallocation.
+     
+     @return returns true if the last row was removed, false if the Matrix has no rows
+    */
+	bool pop_back(){
+		if( rows == 0 ) return false;
+		rows--;
+		return true;
+	}
+	
+	/**
+     Sets the number of columns of an empty Matrix, so rows can be reserved and pushed back before the first row has been added.
+     
+     @param const unsigned int cols: the number of columns, must be greater than zero
+     @return returns true if the number of columns was set, false if the Matrix already has rows or cols is zero
+    */
+	bool setNumCols(const unsigned int cols){
+		if( rows > 0 || cols == 0 ) return false;
+		clear();
+		this->cols = cols;
+		return true;
+	}
+	
 	/**
      This function reserves a consistent block of data so new rows can more effecitenly be pushed_back into the Matrix.
      The capacity variable represents the number of rows you want to reserve, based on the current number of columns.
@@ -396,27 +416,21 @@ public:
 		//If the number of columns has not been set, then we can not do anything
 		if( cols == 0 ) return false;
 		
+		//There is no need to reallocate if we already have enough space
+		if( capacity <= this->capacity ) return true;
+		
 		//Reserve the data and copy and existing data
-		T** tempDataPtr = NULL;
-		tempDataPtr = new T*[ capacity ];
+		T* tempDataPtr = NULL;
+		tempDataPtr = new T[ size_t(capacity)*cols ];
 		if( tempDataPtr == NULL ){//If NULL then we have run out of memory
 			return false;
 		}
-		for(unsigned int i=0; i<capacity; i++){
-			tempDataPtr[i] = new T[cols];
-		}
 
 		//Copy the existing data into the new memory
-		for(unsigned int i=0; i<rows; i++)
-			for(unsigned int j=0; j<cols; j++)
-				tempDataPtr[i][j] = dataPtr[i][j];
-
-		//Delete the original data and copy the pointer
-		for(unsigned int i=0; i<rows; i++){
-			delete[] dataPtr[i];
-			dataPtr[i] = NULL;
+		if( dataPtr != NULL ){
+			std::copy( dataPtr, dataPtr+getSize(), tempDataPtr );
+			delete[] dataPtr;
 		}
-		delete[] dataPtr;
 		dataPtr = tempDataPtr;
 		
 		//Store the new capacity
@@ -430,10 +444,6 @@ public:
     */
 	void clear(){
 		if( dataPtr != NULL ){
-			for(unsigned int i=0; i<rows; i++){
-                delete[] dataPtr[i];
-                dataPtr[i] = NULL;
-			}
 			delete[] dataPtr;
 			dataPtr = NULL;
 		}
@@ -463,13 +473,77 @@ public:
      @return returns the number of columns in the Matrix
     */
 	inline unsigned int getCapacity() const{ return capacity; }
+    
+    /**
+     Gets the number of elements between the start of one row and the start of the next row in the data buffer.
+     The Matrix data is stored row-major in one contiguous buffer, so element [i][j] is at getData()[ i*getStride() + j ].
+     
+     @return returns the row stride of the Matrix data buffer
+    */
+	inline unsigned int getStride() const{ return cols; }
+    
+    /**
+     Gets the total number of elements in the Matrix (rows * cols).
+     
+     @return returns the number of elements in the Matrix
+    */
+	inline size_t getSize() const{ return size_t(rows) * cols; }
+    
+    /**
+     Gets a pointer to the start of the contiguous, row-major data buffer. This will be NULL if the Matrix is empty.
+     
+     @return returns a pointer to the data buffer
+    */
+	inline T* getData(){ return dataPtr; }
+    
+    /**
+     Gets a const pointer to the start of the contiguous, row-major data buffer. This will be NULL if the Matrix is empty.
+     
+     @return returns a const pointer to the data buffer
+    */
+	inline const T* getData() const{ return dataPtr; }
 
 protected:
     
+    /**
+     Copies the size and values of the rhs Matrix into this Matrix. If this Matrix already has enough capacity then the
+     existing buffer is reused, otherwise a new buffer is allocated.
+    */
+	void copyFrom(const Matrix &rhs){
+		if( rhs.dataPtr == NULL || rhs.getSize() == 0 ){
+			clear();
+			return;
+		}
+		if( dataPtr == NULL || size_t(capacity)*cols < rhs.getSize() ){
+			clear();
+			dataPtr = new T[ rhs.getSize() ];
+			capacity = rhs.rows;
+		}else{
+			capacity = (unsigned int)( (size_t(capacity)*cols) / rhs.cols );
+		}
+		rows = rhs.rows;
+		cols = rhs.cols;
+		std::copy( rhs.dataPtr, rhs.dataPtr+rhs.getSize(), dataPtr );
+	}
+    
+    /**
+     Takes ownership of the rhs data buffer, leaving the rhs Matrix empty. This Matrix must be empty before calling this function.
+    */
+	void moveFrom(Matrix &rhs){
+		dataPtr = rhs.dataPtr;
+		rows = rhs.rows;
+		cols = rhs.cols;
+		capacity = rhs.capacity;
+		rhs.dataPtr = NULL;
+		rhs.rows = 0;
+		rhs.cols = 0;
+		rhs.capacity = 0;
+	}
+    
 	unsigned int rows;      ///< The number of rows in the Matrix
 	unsigned int cols;      ///< The number of columns in the Matrix
 	unsigned int capacity;  ///< The actual capacity of the Matrix, this will be the number of rows, not the actual memory size
-	T **dataPtr;            ///< A pointer to the data
+	T *dataPtr;             ///< A pointer to the contiguous, row-major data buffer, element [i][j] is stored at dataPtr[ i*cols + j ]
 
 };
 
@@ -68,6 +68,22 @@ public:
      */
     MatrixDouble(const Matrix<double> &rhs);
     
+#if __cplusplus >= 201103L
+    /**
+     Move Constructor, takes ownership of the data buffer from the rhs MatrixDouble, leaving the rhs MatrixDouble empty
+     
+     @param MatrixDouble &&rhs: the MatrixDouble from which the data buffer will be moved
+     */
+    MatrixDouble(MatrixDouble &&rhs);
+    
+    /**
+     Move Constructor, takes ownership of the data buffer from the rhs Matrix, leaving the rhs Matrix empty
+     
+     @param Matrix<double> &&rhs: the Matrix from which the data buffer will be moved
+     */
+    MatrixDouble(Matrix<double> &&rhs);
+#endif
+    
     /**
      Destructor, cleans up any memory
      */
@@ -89,6 +105,24 @@ public:
      */
     MatrixDouble& operator=(const Matrix<double> &rhs);
     
+#if __cplusplus >= 201103L
+    /**
+     Defines how the data from the rhs MatrixDouble should be moved to this MatrixDouble. The rhs MatrixDouble will be left empty.
+     
+     @param MatrixDouble &&rhs: another instance of a MatrixDouble
+     @return returns a reference to this instance of the MatrixDouble
+     */
+    MatrixDouble& operator=(MatrixDouble &&rhs);
+    
+    /**
+     Defines how the data from the rhs Matrix<double> should be moved to this MatrixDouble. The rhs Matrix will be left empty.
+     
+     @param Matrix<double> &&rhs: an instance of a Matrix<double>
+     @return returns a reference to this instance of the MatrixDouble
+     */
+    MatrixDouble& operator=(Matrix<double> &&rhs);
+#endif
+    
     /**
      Defines how the data from the rhs vector of VectorDoubles should be copied to this MatrixDouble
      
@@ -163,6 +197,28 @@ public:
      */
     MatrixDouble multiple(const MatrixDouble &b) const;
     
+    /**
+     Performs the multiplcation of this matrix (a) by the vector b, writing the results into c: c = a * b
+     The product is computed with the vectorized MatrixKernels::gemv kernel, and c is only resized if it is not already the right size.
+     
+     @param const VectorDouble &b: the vector to multiple with this matrix
+     @param VectorDouble &c: the vector the results will be written to, this can be the same vector as b
+     @return returns true if the multiplcation was successful, false otherwise
+     */
+    bool multiple(const VectorDouble &b,VectorDouble &c) const;
+    
+    /**
+     Performs the multiplcation of this matrix (a) by the matrix b, writing the results into c: c = a * b
+     The product is computed with the cache-blocked MatrixKernels::gemm kernel, and c is only resized if it is not already the right size.
+     Large products can be split over several threads, the results are the same for any number of threads.
+     
+     @param const MatrixDouble &b: the matrix to multiple with this matrix
+     @param MatrixDouble &c: the matrix the results will be written to, this can be the same matrix as this matrix or b
+     @param const UINT numThreads: the maximum number of threads that can be used for large products, the default is 1
+     @return returns true if the multiplcation was successful, false otherwise
+     */
+    bool multiple(const MatrixDouble &b,MatrixDouble &c,const UINT numThreads = 1) const;
+    
     /**
      Gets the mean of each column in the matrix and returns this as a VectorDouble.
      
@@ -0,0 +1,125 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The MatrixFloat class is a single precision Matrix, it is used by the classifiers to store the float copy of a trained model
+ that the float prediction path runs on (see MLBase::setUseFloatPrediction).  Half the size of a MatrixDouble means twice as many values
+ in each SIMD register and half the memory bandwidth, which matters for large KNN training sets, DTW templates and MLP weights.
+
+ A MatrixFloat can be built directly from a MatrixDouble, each value is rounded to the nearest float.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_MATRIX_FLOAT_HEADER
+#define GRT_MATRIX_FLOAT_HEADER
+
+#include "Matrix.h"
+#include "GRTTypedefs.h"
+
+namespace GRT{
+
+class MatrixFloat : public Matrix<float>{
+public:
+    /**
+     Default Constructor
+     */
+    MatrixFloat();
+
+    /**
+     Constructor, sets the size of the matrix to [rows cols]
+
+     @param const UINT rows: sets the number of rows in the matrix, must be a value greater than zero
+     @param const UINT cols: sets the number of columns in the matrix, must be a value greater than zero
+     */
+    MatrixFloat(const unsigned int rows,const unsigned int cols);
+
+    /**
+     Copy Constructor, copies the values from the rhs MatrixFloat to this MatrixFloat instance
+
+     @param const MatrixFloat &rhs: the MatrixFloat from which the values will be copied
+     */
+    MatrixFloat(const MatrixFloat &rhs);
+
+    /**
+     Copy Constructor, copies the values from the rhs Matrix to this MatrixFloat instance
+
+     @param const Matrix<float> &rhs: the Matrix from which the values will be copied
+     */
+    MatrixFloat(const Matrix<float> &rhs);
+
+    /**
+     Conversion Constructor, copies the values from the rhs double Matrix to this MatrixFloat instance, rounding each value to a float
+
+     @param const Matrix<double> &rhs: the Matrix from which the values will be copied
+     */
+    explicit MatrixFloat(const Matrix<double> &rhs);
+
+    /**
+     Destructor, cleans up any memory
+     */
+    virtual ~MatrixFloat();
+
+    /**
+     Defines how the data from the rhs MatrixFloat should be copied to this MatrixFloat
+
+     @param const MatrixFloat &rhs: another instance of a MatrixFloat
+     @return returns a reference to this instance of the MatrixFloat
+     */
+    MatrixFloat& operator=(const MatrixFloat &rhs);
+
+    /**
+     Defines how the data from the rhs Matrix<float> should be copied to this MatrixFloat
+
+     @param const Matrix<float> &rhs: an instance of a Matrix<float>
+     @return returns a reference to this instance of the MatrixFloat
+     */
+    MatrixFloat& operator=(const Matrix<float> &rhs);
+
+    /**
+     Defines how the data from the rhs Matrix<double> should be copied to this MatrixFloat, each value is rounded to a float
+
+     @param const Matrix<double> &rhs: an instance of a Matrix<double>
+     @return returns a reference to this instance of the MatrixFloat
+     */
+    MatrixFloat& operator=(const Matrix<double> &rhs);
+
+    /**
+     Copies the values of a double Matrix into this MatrixFloat, rounding each value to a float.  The matrix is resized to the size of rhs,
+     if rhs is empty then this matrix is cleared.
+
+     @param const Matrix<double> &rhs: the Matrix from which the values will be copied
+     @return returns true if the values were copied, false otherwise
+     */
+    bool copyFromDouble(const Matrix<double> &rhs);
+
+    /**
+     Copies the values of this MatrixFloat into a new double Matrix.
+
+     @return returns a Matrix<double> with the same size and values as this matrix
+     */
+    Matrix<double> toDouble() const;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_MATRIX_FLOAT_HEADER
@@ -0,0 +1,175 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The PipelineProfiler class keeps a LatencyHistogram for each module of a GestureRecognitionPipeline, so the time (and the number of
+ calls and failures) of every pre processing, feature extraction, context, classifier, regressifier and post processing module can be
+ queried while the pipeline is running.
+
+ Profiling is off by default, when it is off each module costs one extra branch per prediction.  When it is on each module costs two
+ reads of the monotonic clock.  Define GRT_DISABLE_PROFILING when building the library to compile the profiling out of the pipeline
+ completely, the profiler API is still available but nothing is recorded.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_PIPELINE_PROFILER_HEADER
+#define GRT_PIPELINE_PROFILER_HEADER
+
+#include "LatencyHistogram.h"
+
+#ifndef GRT_DISABLE_PROFILING
+    #define GRT_PROFILING_ENABLED
+#endif
+
+namespace GRT{
+
+class PipelineProfiler{
+public:
+    //The stages are listed in the order they run in the pipeline, PREDICT is the time of the whole predict call
+    enum StageTypes{START_OF_PIPELINE_CONTEXT=0,PREPROCESSING,AFTER_PREPROCESSING_CONTEXT,FEATURE_EXTRACTION,AFTER_FEATURE_EXTRACTION_CONTEXT,
+                    CLASSIFIER,REGRESSIFIER,AFTER_CLASSIFIER_CONTEXT,POSTPROCESSING,END_OF_PIPELINE_CONTEXT,PREDICT,NUM_STAGE_TYPES};
+
+    /**
+     Default Constructor.
+     */
+    PipelineProfiler();
+
+    /**
+     Default Destructor.
+     */
+    ~PipelineProfiler();
+
+    /**
+     Turns the profiler on or off, turning the profiler on does not clear the statistics that have already been recorded.
+
+     @param const bool enabled: sets if each stage should be timed
+     @return returns true if the profiler was set, false if it was turned on but the library was built with GRT_DISABLE_PROFILING
+     */
+    bool setEnabled(const bool enabled);
+
+    /**
+     Gets if the profiler is on.
+
+     @return returns true if the profiler is on, false otherwise
+     */
+    bool getEnabled() const{ return enabled; }
+
+    /**
+     Removes all the recorded statistics.
+     */
+    void clear();
+
+    /**
+     Gets the current time of the monotonic clock used to time each stage, if the profiler is off this returns zero without reading the clock.
+
+     @return returns the current time in nanoseconds
+     */
+    inline unsigned long long startStage() const{ return enabled ? getTimeNanoSeconds() : 0; }
+
+    /**
+     Records the time since startTime for one call of a stage.  The statistics for a new stage are allocated the first time it is recorded.
+
+     @param const UINT stageType: the type of the stage, this should be one of the StageTypes enums
+     @param const UINT moduleIndex: the index of the module within the stage
+     @param const unsigned long long startTime: the time returned by startStage when the call started
+     @param const bool success: false if the module failed
+     */
+    void recordStage(const UINT stageType,const UINT moduleIndex,const unsigned long long startTime,const bool success);
+
+    /**
+     Gets the number of modules that have been recorded for a stage type.
+
+     @param const UINT stageType: the type of the stage, this should be one of the StageTypes enums
+     @return returns the number of modules recorded for that stage type
+     */
+    UINT getNumModules(const UINT stageType) const;
+
+    /**
+     Gets the statistics of one module.
+
+     @param const UINT stageType: the type of the stage, this should be one of the StageTypes enums
+     @param const UINT moduleIndex: the index of the module within the stage
+     @return returns the statistics of the module, these will be empty if the module has not been recorded
+     */
+    const LatencyHistogram& getStatistics(const UINT stageType,const UINT moduleIndex) const;
+
+    /**
+     Gets the name of a stage type, this is used when the profiling report is printed.
+
+     @param const UINT stageType: the type of the stage, this should be one of the StageTypes enums
+     @return returns the name of the stage type
+     */
+    static string getStageTypeAsString(const UINT stageType);
+
+    /**
+     Reads the monotonic clock.
+
+     @return returns the current time in nanoseconds, this is only meaningful relative to another call
+     */
+    static unsigned long long getTimeNanoSeconds();
+
+protected:
+    bool enabled;
+    vector< vector< LatencyHistogram > > stages;
+    LatencyHistogram emptyStatistics;
+};
+
+/**
+ The PipelineProfilerScope times one call of a module: the time is recorded when the scope ends, as a failure unless setSuccess was
+ called, so an early return after a module fails is recorded as a failure without any extra code.
+ */
+class PipelineProfilerScope{
+public:
+    PipelineProfilerScope(PipelineProfiler &profiler,const UINT stageType,const UINT moduleIndex):profiler(profiler),stageType(stageType),moduleIndex(moduleIndex){
+        enabled = profiler.getEnabled();
+        success = false;
+        startTime = profiler.startStage();
+    }
+
+    ~PipelineProfilerScope(){
+        if( enabled ) profiler.recordStage( stageType, moduleIndex, startTime, success );
+    }
+
+    inline void setSuccess(){ success = true; }
+
+protected:
+    PipelineProfiler &profiler;
+    const UINT stageType;
+    const UINT moduleIndex;
+    bool enabled;
+    bool success;
+    unsigned long long startTime;
+};
+
+//These macros time the rest of the enclosing scope, and compile to nothing when GRT_DISABLE_PROFILING is defined
+#ifdef GRT_PROFILING_ENABLED
+    #define GRT_PROFILE_STAGE(scope,profiler,stageType,moduleIndex) PipelineProfilerScope scope( profiler, stageType, moduleIndex )
+    #define GRT_PROFILE_STAGE_SUCCESS(scope) scope.setSuccess()
+#else
+    #define GRT_PROFILE_STAGE(scope,profiler,stageType,moduleIndex)
+    #define GRT_PROFILE_STAGE_SUCCESS(scope)
+#endif
+
+}//End of namespace GRT
+
+#endif //GRT_PIPELINE_PROFILER_HEADER
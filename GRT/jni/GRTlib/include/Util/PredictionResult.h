@@ -0,0 +1,67 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The PredictionResult class stores the output of one prediction made by an AsyncPipeline.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_PREDICTION_RESULT_HEADER
+#define GRT_PREDICTION_RESULT_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT {
+
+class PredictionResult{
+public:
+    /**
+     Default Constructor.
+     */
+    PredictionResult(){
+        sampleIndex = 0;
+        predictionSuccess = false;
+        predictedClassLabel = 0;
+        unprocessedPredictedClassLabel = 0;
+        maximumLikelihood = 0;
+    }
+
+    /**
+     Default Destructor.
+     */
+    ~PredictionResult(){
+
+    }
+
+    UINT sampleIndex;                       ///< The index of the sample that was predicted, this is the number of samples that were pushed before it
+    bool predictionSuccess;                 ///< True if the pipeline predicted the sample, false if the prediction failed
+    UINT predictedClassLabel;               ///< The predicted class label of the pipeline (classification mode only)
+    UINT unprocessedPredictedClassLabel;    ///< The class label predicted by the classifier, before any post processing (classification mode only)
+    double maximumLikelihood;               ///< The maximum likelihood of the prediction (classification mode only)
+    VectorDouble classLikelihoods;          ///< The class likelihoods of the prediction (classification mode only)
+    VectorDouble regressionData;            ///< The output of the regressifier (regression mode only)
+};
+
+}//End of namespace GRT
+
+#endif //GRT_PREDICTION_RESULT_HEADER
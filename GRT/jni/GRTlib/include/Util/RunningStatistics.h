@@ -0,0 +1,191 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The RunningStatistics class computes the mean, variance, min/max ranges and (optionally) the covariance of a dataset in a single
+ pass over the data.
+
+ Samples can be added one at a time (for example while a dataset is being recorded) using Welford's update, or a whole MatrixDouble
+ can be added at once.  A matrix is processed in blocks of rows, the centered cross products of each block are computed with the
+ MatrixKernels::gemm kernel and the blocks are combined with Chan's pairwise update, which keeps the results numerically stable even
+ for millions of rows.  The rows of a large matrix can also be split over several threads.  Two RunningStatistics instances that
+ summarize different parts of a dataset can be merged, the result is the summary of all the samples.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_RUNNING_STATISTICS_HEADER
+#define GRT_RUNNING_STATISTICS_HEADER
+
+#include "MatrixDouble.h"
+
+namespace GRT{
+
+//The number of rows of a matrix that are summarized together before they are merged into the running statistics
+#define GRT_RUNNING_STATISTICS_BLOCK_SIZE 256
+
+class RunningStatistics{
+public:
+    /**
+     Default Constructor.
+
+     @param const UINT numDimensions: the number of dimensions of the data, this can be zero if init will be called later
+     @param const bool computeCovariance: sets if the covariance matrix should be computed, this costs O(D^2) per sample
+     */
+    RunningStatistics(const UINT numDimensions = 0,const bool computeCovariance = false);
+
+    /**
+     Copy Constructor, copies the statistics from the rhs instance to this instance.
+
+     @param const RunningStatistics &rhs: another instance of the RunningStatistics class
+     */
+    RunningStatistics(const RunningStatistics &rhs);
+
+    /**
+     Default Destructor.
+     */
+    ~RunningStatistics();
+
+    /**
+     Sets the equals operator, copies the statistics from the rhs instance to this instance.
+
+     @param const RunningStatistics &rhs: another instance of the RunningStatistics class
+     @return a reference to this instance of the RunningStatistics
+     */
+    RunningStatistics& operator=(const RunningStatistics &rhs);
+
+    /**
+     Sets the number of dimensions of the data and if the covariance should be computed.  This will clear any previous statistics.
+
+     @param const UINT numDimensions: the number of dimensions of the data, must be greater than zero
+     @param const bool computeCovariance: sets if the covariance matrix should be computed
+     @return returns true if the statistics were initialized, false otherwise
+     */
+    bool init(const UINT numDimensions,const bool computeCovariance = false);
+
+    /**
+     Clears any previous statistics, the number of dimensions is not changed.
+     */
+    void clear();
+
+    /**
+     Adds one sample to the statistics.
+
+     @param const VectorDouble &sample: the new sample, its size must match the number of dimensions
+     @return returns true if the sample was added, false otherwise
+     */
+    bool update(const VectorDouble &sample);
+
+    /**
+     Adds every row of the data to the statistics.  If numThreads is greater than one and the matrix is large enough, the rows are split
+     into bands that are summarized on separate threads and then merged in order.
+
+     @param const MatrixDouble &data: the new samples, one per row, the number of columns must match the number of dimensions
+     @param const UINT numThreads: the maximum number of threads that can be used, the calling thread counts as one of them
+     @return returns true if the samples were added, false otherwise
+     */
+    bool update(const MatrixDouble &data,const UINT numThreads = 1);
+
+    /**
+     Merges the statistics from the rhs instance into this instance, after this call this instance summarizes the samples from both.
+
+     @param const RunningStatistics &rhs: the statistics to merge, these must have the same number of dimensions and covariance setting
+     @return returns true if the statistics were merged, false otherwise
+     */
+    bool merge(const RunningStatistics &rhs);
+
+    /**
+     Gets the number of samples that have been added.
+
+     @return returns the number of samples
+     */
+    UINT getNumSamples() const{ return numSamples; }
+
+    /**
+     Gets the number of dimensions of the data.
+
+     @return returns the number of dimensions
+     */
+    UINT getNumDimensions() const{ return numDimensions; }
+
+    /**
+     Gets if the covariance matrix is being computed.
+
+     @return returns true if the covariance matrix is being computed, false otherwise
+     */
+    bool getComputeCovariance() const{ return computeCovariance; }
+
+    /**
+     Gets the mean of each dimension.
+
+     @return returns a VectorDouble with the mean of each dimension, these will be zero if no samples have been added
+     */
+    VectorDouble getMean() const;
+
+    /**
+     Gets the sample variance (normalized by N-1) of each dimension.
+
+     @return returns a VectorDouble with the variance of each dimension, these will be zero if less than two samples have been added
+     */
+    VectorDouble getVariance() const;
+
+    /**
+     Gets the sample standard deviation (normalized by N-1) of each dimension.
+
+     @return returns a VectorDouble with the standard deviation of each dimension, these will be zero if less than two samples have been added
+     */
+    VectorDouble getStdDev() const;
+
+    /**
+     Gets the min and max values of each dimension.
+
+     @return returns a vector with the ranges of each dimension, this will be empty if no samples have been added
+     */
+    vector< MinMax > getRanges() const;
+
+    /**
+     Gets the sample covariance matrix (normalized by N-1).  The covariance must have been enabled when the statistics were initialized.
+
+     @return returns a [D D] MatrixDouble with the covariance, this will be empty if the covariance is not being computed
+     */
+    MatrixDouble getCovarianceMatrix() const;
+
+protected:
+    bool updateRows(const MatrixDouble &data,const UINT rowStart,const UINT rowEnd);
+    void mergeMoments(const UINT n,const double *rhsMean,const double *rhsM2,const MatrixDouble *rhsComoment);
+    static void* updateWorkerThread(void *workerData);
+
+    UINT numDimensions;                     ///< The number of dimensions of the data
+    bool computeCovariance;                 ///< True if the covariance matrix is being computed
+    UINT numSamples;                        ///< The number of samples that have been added
+    VectorDouble mean;                      ///< The running mean of each dimension
+    VectorDouble m2;                        ///< The running sum of squared differences from the mean of each dimension
+    MatrixDouble comoment;                  ///< The running sum of the outer products of the differences from the mean, if computeCovariance is true
+    vector< MinMax > ranges;                ///< The min and max values of each dimension
+
+    WarningLog warningLog;
+    ErrorLog errorLog;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_RUNNING_STATISTICS_HEADER
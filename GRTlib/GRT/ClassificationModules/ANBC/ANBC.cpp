@@ -59,6 +59,9 @@ ANBC& ANBC::operator=(const ANBC &rhs){
         this->weightsDataSet = rhs.weightsDataSet;
         this->weightsData = rhs.weightsData;
 		this->models = rhs.models;
+        this->floatMu = rhs.floatMu;
+        this->floatPrecision = rhs.floatPrecision;
+        this->floatLogOffsets = rhs.floatLogOffsets;
         
         //Classifier variables
         copyBaseVariables( (Classifier*)&rhs );
@@ -77,6 +80,9 @@ bool ANBC::deepCopyFrom(const Classifier *classifier){
         this->weightsDataSet = ptr->weightsDataSet;
         this->weightsData = ptr->weightsData;
 		this->models = ptr->models;
+        this->floatMu = ptr->floatMu;
+        this->floatPrecision = ptr->floatPrecision;
+        this->floatLogOffsets = ptr->floatLogOffsets;
         
         //Clone the classifier variables
         return copyBaseVariables( classifier );
@@ -93,6 +99,12 @@ bool ANBC::train(LabelledClassificationData trainingData){
  This method returns the ID of the most likely class given the observation x and the trained models
  */
 bool ANBC::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool ANBC::predictInplace(VectorDouble &inputVector){
+    
+    if( useFloatPrediction ) return predictAsFloat( inputVector );
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - ANBC Model Not Trained!" << endl;
@@ -118,11 +130,86 @@ bool ANBC::predict(VectorDouble inputVector){
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
     if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
     
+	for(UINT k=0; k<numClasses; k++){
+		classDistances[k] = models[k].predict( inputVector );
+    }
+    
+    predictFromClassDistances();
+    
+    return true;
+}
+
+bool ANBC::predictFloatInplace(VectorFloat &inputVector){
+    
+    if( !trained ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - ANBC Model Not Trained!" << endl;
+        return false;
+    }
+    
+    predictedClassLabel = 0;
+	maxLikelihood = -10000;
+    
+	if( inputVector.size() != numInputDimensions ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The size of the input vector (" << inputVector.size() << ") does not match the num features in the model (" << numInputDimensions << endl;
+		return false;
+	}
+    
+    if( floatLogOffsets.size() != numClasses ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The float model has not been built, float prediction must be enabled first!" << endl;
+        return false;
+    }
+    
+    if( useScaling ){
+        for(UINT n=0; n<numInputDimensions; n++){
+            inputVector[n] = float( scale(inputVector[n], ranges[n].minValue, ranges[n].maxValue, MIN_SCALE_VALUE, MAX_SCALE_VALUE) );
+        }
+    }
+    
+    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
+    if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
+    
+    const float *x = &inputVector[0];
+    for(UINT k=0; k<numClasses; k++){
+        const float *mu = floatMu[k];
+        const float *precision = floatPrecision[k];
+        float sum = 0;
+        for(UINT j=0; j<numInputDimensions; j++){
+            const float d = x[j] - mu[j];
+            sum += precision[j] * d * d;
+        }
+        classDistances[k] = floatLogOffsets[k] - sum;
+    }
+    
+    predictFromClassDistances();
+    
+    return true;
+}
+
+bool ANBC::predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const{
+    
+    //The input is scaled into the prediction's buffer, so nothing in this instance is written to
+    const VectorDouble *x = initSharedPrediction( inputVector, prediction, MIN_SCALE_VALUE, MAX_SCALE_VALUE );
+    if( x == NULL ) return false;
+    
+    for(UINT k=0; k<numClasses; k++){
+        prediction.classDistances[k] = models[k].predict( *x );
+    }
+    
+    predictFromClassDistances( prediction.classDistances, prediction.classLikelihoods, prediction.predictedClassLabel, prediction.maxLikelihood );
+    
+    return true;
+}
+
+void ANBC::predictFromClassDistances(){
+    predictFromClassDistances( classDistances, classLikelihoods, predictedClassLabel, maxLikelihood );
+}
+    
+void ANBC::predictFromClassDistances(const VectorDouble &classDistances,VectorDouble &classLikelihoods,UINT &predictedClassLabel,double &maxLikelihood) const{
+    
     double classLikelihoodsSum = 0;
     double minDist = -99e+99;
+    predictedClassLabel = 0;
 	for(UINT k=0; k<numClasses; k++){
-		classDistances[k] = models[k].predict( inputVector );
-        
         //At this point the class likelihoods and class distances are the same thing
         classLikelihoods[k] = classDistances[k];
         
@@ -152,6 +239,92 @@ bool ANBC::predict(VectorDouble inputVector){
         if( minDist >= models[predictedClassLabel].threshold ) predictedClassLabel = models[predictedClassLabel].classLabel;
         else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
     }else predictedClassLabel = models[predictedClassLabel].classLabel;
+}
+
+bool ANBC::buildFloatModel(){
+    
+    if( models.size() != numClasses ) return false;
+    
+    floatMu.resize( numClasses, numInputDimensions );
+    floatPrecision.resize( numClasses, numInputDimensions );
+    floatLogOffsets.resize( numClasses );
+    
+    //log( gauss(x,mu,sigma) * w ) = log( w / (sigma*sqrt(2*PI)) ) - (x-mu)^2 / (2*sigma^2)
+    for(UINT k=0; k<numClasses; k++){
+        if( models[k].N != numInputDimensions ) return false;
+        floatLogOffsets[k] = 0;
+        for(UINT j=0; j<numInputDimensions; j++){
+            if( models[k].weights[j] > 0 ){
+                if( !(models[k].sigma[j] > 0) ) return false;
+                floatMu[k][j] = float( models[k].mu[j] );
+                floatPrecision[k][j] = float( 1.0 / (2.0*models[k].sigma[j]*models[k].sigma[j]) );
+                floatLogOffsets[k] += log( models[k].weights[j] / (models[k].sigma[j]*sqrt(TWO_PI)) );
+            }else{
+                floatMu[k][j] = 0;
+                floatPrecision[k][j] = 0;
+            }
+        }
+    }
+    
+    return true;
+}
+
+bool ANBC::predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances){
+    
+    //The float prediction path classifies each row on its own
+    if( useFloatPrediction ) return Classifier::predictBatch(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    
+    if( !initBatchPrediction(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances) ) return false;
+    
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ) return true;
+    
+    //Scale the input data if needed
+    const MatrixDouble *data = &inputData;
+    MatrixDouble scaledData;
+    if( useScaling ){
+        if( !scaleBatch(inputData,scaledData,MIN_SCALE_VALUE,MAX_SCALE_VALUE) ) return false;
+        data = &scaledData;
+    }
+    
+    //Compute the log likelihood of every row for each class model
+    for(UINT k=0; k<numClasses; k++){
+        models[k].predict( *data, predictedClassDistances, k );
+    }
+    
+    //Compute the likelihoods and predicted class label for each row, this matches the predict function
+    for(UINT i=0; i<M; i++){
+        predictedClassLabel = 0;
+        double classLikelihoodsSum = 0;
+        double minDist = -99e+99;
+        for(UINT k=0; k<numClasses; k++){
+            classDistances[k] = predictedClassDistances[i][k];
+            classLikelihoods[k] = classDistances[k];
+            
+            if( isinf(classLikelihoods[k]) || isnan(classLikelihoods[k]) ) classLikelihoods[k] = -10000;
+            
+            classLikelihoods[k] = exp( classLikelihoods[k] );
+            classLikelihoodsSum += classLikelihoods[k];
+            
+            if( classDistances[k] > minDist ){
+                minDist = classDistances[k];
+                predictedClassLabel = k;
+            }
+        }
+        
+        for(UINT k=0; k<numClasses; k++){
+            if( classLikelihoodsSum == 0 ) classLikelihoods[k] = 0;
+            else classLikelihoods[k] /= classLikelihoodsSum;
+        }
+        maxLikelihood = classLikelihoods[predictedClassLabel];
+        
+        if( useNullRejection ){
+            if( minDist >= models[predictedClassLabel].threshold ) predictedClassLabel = models[predictedClassLabel].classLabel;
+            else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+        }else predictedClassLabel = models[predictedClassLabel].classLabel;
+        
+        storeBatchPrediction(i,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    }
     
     return true;
 }
@@ -262,6 +435,10 @@ bool ANBC::train(LabelledClassificationData &labelledTrainingData,double gamma){
     
     //Flag that the models have been trained
     trained = true;
+    
+    //Build the float copy of the models if float prediction is enabled
+    updateFloatModel();
+    
     return trained;
     
 }
@@ -292,6 +469,9 @@ bool ANBC::clear(){
     //Clear the ANBC model
     weightsData.clear();
     models.clear();
+    floatMu.clear();
+    floatPrecision.clear();
+    floatLogOffsets.clear();
     
     return true;
 }
@@ -389,6 +569,9 @@ bool ANBC::loadModelFromFile(fstream &file){
     numClasses = 0;
     models.clear();
     classLabels.clear();
+    floatMu.clear();
+    floatPrecision.clear();
+    floatLogOffsets.clear();
     
     if(!file.is_open())
     {
@@ -581,6 +764,9 @@ bool ANBC::loadModelFromFile(fstream &file){
     classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
     classDistances.resize(numClasses,DEFAULT_NULL_DISTANCE_VALUE);
     
+    //Build the float copy of the models if float prediction is enabled
+    updateFloatModel();
+    
     return true;
 }
     
@@ -37,36 +37,16 @@ bool ANBC_Model::train(UINT classLabel,MatrixDouble &trainingData,VectorDouble &
 	//Update the weights buffer
 	weights = weightsVector;
 
-	//Resize the buffers
-	mu.resize( N );
-	sigma.resize( N );
-
-	//Calculate the mean for each dimension
-	for(UINT j=0; j<N; j++){
-		mu[j] = 0.0;
-
-		for(UINT i=0; i<M; i++){
-			mu[j] += trainingData[i][j];
-        }
-
-		mu[j] /= double(M);
-        
-        if( mu[j] == 0 ){
-            return false;
-        }
+	//Calculate the mean and sample standard deviation for each dimension in a single pass
+	RunningStatistics stats( N );
+	if( !stats.update( trainingData ) ){
+		return false;
 	}
+	mu = stats.getMean();
+	sigma = stats.getStdDev();
 
-	//Calculate the sample standard deviation
 	for(UINT j=0; j<N; j++){
-		sigma[j] = 0.0;
-
-		for(UINT i=0; i<M; i++){
-			sigma[j] += SQR( trainingData[i][j]-mu[j] );
-        }
-
-		sigma[j] = sqrt( sigma[j]/double(M-1) );
-        
-        if( sigma[j] == 0 ){
+        if( mu[j] == 0 || sigma[j] == 0 ){
             return false;
         }
 	}
@@ -104,7 +84,7 @@ bool ANBC_Model::train(UINT classLabel,MatrixDouble &trainingData,VectorDouble &
 	return true;
 }
 
-double ANBC_Model::predict(const VectorDouble &x){
+double ANBC_Model::predict(const VectorDouble &x) const{
 	double prediction = 0.0;
 	for(UINT j=0; j<N; j++){
 		if(weights[j]>0)
@@ -113,6 +93,19 @@ double ANBC_Model::predict(const VectorDouble &x){
 	return prediction;
 }
 
+void ANBC_Model::predict(const MatrixDouble &inputData,MatrixDouble &distances,const UINT colIndex){
+	const UINT M = inputData.getNumRows();
+	for(UINT i=0; i<M; i++){
+		const double *x = inputData[i];
+		double prediction = 0.0;
+		for(UINT j=0; j<N; j++){
+			if(weights[j]>0)
+				prediction += log(gauss(x[j],mu[j],sigma[j]) * weights[j]);
+		}
+		distances[i][colIndex] = prediction;
+	}
+}
+
 double ANBC_Model::predictUnnormed(const VectorDouble &x){
 	double prediction = 0.0;
 	for(UINT j=0; j<N; j++){
@@ -122,7 +115,7 @@ double ANBC_Model::predictUnnormed(const VectorDouble &x){
 	return prediction;
 }
 
-inline double ANBC_Model::gauss(const double x,const double mu,const double sigma){
+inline double ANBC_Model::gauss(const double x,const double mu,const double sigma) const{
 	return ( 1.0/(sigma*sqrt(TWO_PI)) ) * exp( - ( ((x-mu)*(x-mu))/(2*(sigma*sigma)) ) );
 }
 
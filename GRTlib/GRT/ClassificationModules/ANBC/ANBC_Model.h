@@ -41,9 +41,10 @@ public:
 	~ANBC_Model(void){};
 
 	bool train(UINT classLabel,MatrixDouble &trainingData,VectorDouble &weightsVector);
-	double predict(const VectorDouble &observation);
+	double predict(const VectorDouble &observation) const;
+	void predict(const MatrixDouble &inputData,MatrixDouble &distances,const UINT colIndex);
 	double predictUnnormed(const VectorDouble &x);
-	inline double gauss(const double x,const double mu,const double sigma);
+	inline double gauss(const double x,const double mu,const double sigma) const;
 	inline double unnormedGauss(const double x,const double mu,const double sigma);
 	void recomputeThresholdValue(const double gamma);
 
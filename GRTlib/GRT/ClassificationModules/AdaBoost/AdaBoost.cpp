@@ -270,6 +270,10 @@ bool AdaBoost::train(LabelledClassificationData trainingData){
 }
     
 bool AdaBoost::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool AdaBoost::predictInplace(VectorDouble &inputVector){
     
     predictedClassLabel = 0;
     maxLikelihood = -10000;
@@ -151,7 +151,7 @@ bool RadialBasisFunction::train(LabelledClassificationData &trainingData, Vector
         double error = 0;
         for(UINT i=0; i<M; i++){
             bool positiveSample = trainingData[ i ].getClassLabel() == WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL;
-            double v = rbf(trainingData[ i ].getSample(),rbfCentre);
+            double v = rbf(trainingData[ i ].getData(),rbfCentre);
             
             if( (v >= positiveClassificationThreshold && !positiveSample) || (v<positiveClassificationThreshold && positiveSample) ){
                 error += weights[i];
@@ -196,6 +196,16 @@ double RadialBasisFunction::rbf(const VectorDouble &a,const VectorDouble &b){
     return exp( gamma * r );
 }
     
+double RadialBasisFunction::rbf(const double *a,const VectorDouble &b){
+    const UINT N = (UINT)b.size();
+    //The training samples are read straight from the rows of the training data, so the size is taken from the centre
+    double r = 0;
+    for(UINT i=0; i<N; i++){
+        r += SQR(a[i]-b[i]);
+    }
+    return exp( gamma * r );
+}
+    
 bool RadialBasisFunction::saveModelToFile(fstream &file) const{
     
     if(!file.is_open())
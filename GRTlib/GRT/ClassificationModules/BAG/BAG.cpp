@@ -134,7 +134,8 @@ bool BAG::train(LabelledClassificationData trainingData){
 
     //Train the ensemble
     for(UINT i=0; i<ensembleSize; i++){
-        LabelledClassificationData boostedDataset = trainingData.getBootstrappedDataset();
+        //The bootstrapped view only holds the indexs of the samples, classifiers that can not read a view will copy the samples of the view
+        LabelledClassificationDataView boostedDataset = trainingData.getBootstrappedView();
         
         //Train the classifier with the bootstrapped dataset
         if( !ensemble[i]->train( boostedDataset ) ){
@@ -152,6 +153,10 @@ bool BAG::train(LabelledClassificationData trainingData){
 }
 
 bool BAG::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool BAG::predictInplace(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
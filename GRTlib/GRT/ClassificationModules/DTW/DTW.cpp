@@ -19,6 +19,7 @@
  */
 
 #include "DTW.h"
+#include <pthread.h>
 
 namespace GRT{
     
@@ -41,6 +42,12 @@ DTW::DTW(bool useScaling,bool useNullRejection,double nullRejectionCoeff,UINT re
 	useZNormalisation=false;
 	constrainZNorm=false;
     trimTrainingData = false;
+    useFastPrediction = false;
+    useStreamingPrediction = false;
+    numThreads = 1;
+    streamingSampleIndex = 0;
+    matchStartIndex = 0;
+    matchEndIndex = 0;
 
 	zNormConstrainThreshold=0.2;
 	trimThreshold = 0.1;
@@ -74,7 +81,14 @@ DTW& DTW::operator=(const DTW &rhs){
 		this->templatesBuffer = rhs.templatesBuffer;
         this->distanceMatrices = rhs.distanceMatrices;
         this->warpPaths = rhs.warpPaths;
+        this->warpingPathTimeSeries = rhs.warpingPathTimeSeries;
         this->continuousInputDataBuffer = rhs.continuousInputDataBuffer;
+        this->templateBounds = rhs.templateBounds;
+        this->floatTemplates = rhs.floatTemplates;
+        this->streamingStates = rhs.streamingStates;
+        this->streamingSampleIndex = rhs.streamingSampleIndex;
+        this->matchStartIndex = rhs.matchStartIndex;
+        this->matchEndIndex = rhs.matchEndIndex;
         this->numTemplates = rhs.numTemplates;
         this->rejectionMode = rhs.rejectionMode;
         this->useSmoothing = rhs.useSmoothing;
@@ -82,6 +96,9 @@ DTW& DTW::operator=(const DTW &rhs){
         this->constrainZNorm = rhs.constrainZNorm;
         this->constrainWarpingPath = rhs.constrainWarpingPath;
         this->trimTrainingData = rhs.trimTrainingData;
+        this->useFastPrediction = rhs.useFastPrediction;
+        this->useStreamingPrediction = rhs.useStreamingPrediction;
+        this->numThreads = rhs.numThreads;
         this->zNormConstrainThreshold = rhs.zNormConstrainThreshold;
         this->radius = rhs.radius;
         this->offsetUsingFirstSample = rhs.offsetUsingFirstSample;
@@ -108,7 +125,14 @@ bool DTW::deepCopyFrom(const Classifier *classifier){
         this->templatesBuffer = ptr->templatesBuffer;
         this->distanceMatrices = ptr->distanceMatrices;
         this->warpPaths = ptr->warpPaths;
+        this->warpingPathTimeSeries = ptr->warpingPathTimeSeries;
         this->continuousInputDataBuffer = ptr->continuousInputDataBuffer;
+        this->templateBounds = ptr->templateBounds;
+        this->floatTemplates = ptr->floatTemplates;
+        this->streamingStates = ptr->streamingStates;
+        this->streamingSampleIndex = ptr->streamingSampleIndex;
+        this->matchStartIndex = ptr->matchStartIndex;
+        this->matchEndIndex = ptr->matchEndIndex;
         this->numTemplates = ptr->numTemplates;
         this->rejectionMode = ptr->rejectionMode;
         this->useSmoothing = ptr->useSmoothing;
@@ -116,6 +140,9 @@ bool DTW::deepCopyFrom(const Classifier *classifier){
         this->constrainZNorm = ptr->constrainZNorm;
         this->constrainWarpingPath = ptr->constrainWarpingPath;
         this->trimTrainingData = ptr->trimTrainingData;
+        this->useFastPrediction = ptr->useFastPrediction;
+        this->useStreamingPrediction = ptr->useStreamingPrediction;
+        this->numThreads = ptr->numThreads;
         this->zNormConstrainThreshold = ptr->zNormConstrainThreshold;
         this->radius = ptr->radius;
         this->offsetUsingFirstSample = ptr->offsetUsingFirstSample;
@@ -252,6 +279,15 @@ bool DTW::train(LabelledTimeSeriesClassificationData labelledTrainingData){
     //Recompute the null rejection thresholds
     recomputeNullRejectionThresholds();
 
+    //Precompute the warping bands used by the banded search
+    buildTemplateBounds();
+
+    //Setup the streaming search for the new templates
+    resetStreamingState();
+    
+    //Build the float copy of the templates if float prediction is enabled
+    updateFloatModel();
+
     //Resize the prediction results to make sure it is setup for realtime prediction
     continuousInputDataBuffer.clear();
     continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numInputDimensions,0));
@@ -270,41 +306,37 @@ bool DTW::train_NDDTW(LabelledTimeSeriesClassificationData &trainingData,DTWTemp
    VectorDouble results(numExamples,0.0);
    MatrixDouble distanceResults(numExamples,numExamples);
    dtwTemplate.averageTemplateLength = 0;
-    
+
+   //Smooth and offset each example once, rather than once for every pair
+   vector< MatrixDouble > examples( numExamples );
+   vector< bool > finiteExamples( numExamples, true );
    for(UINT m=0; m<numExamples; m++){
-       
-	   MatrixDouble templateA; //The m'th template
-	   MatrixDouble templateB; //The n'th template
 	   dtwTemplate.averageTemplateLength += trainingData[m].getLength();
 
 	   //Smooth the data if required
-	   if( useSmoothing ) smoothData(trainingData[m].getData(),smoothingFactor,templateA);
-	   else templateA = trainingData[m].getData();
+	   if( useSmoothing ) smoothData(trainingData[m].getData(),smoothingFactor,examples[m]);
+	   else examples[m] = trainingData[m].getData();
        
        if( offsetUsingFirstSample ){
-           offsetTimeseries(templateA);
+           offsetTimeseries(examples[m]);
        }
 
+       finiteExamples[m] = isFinite( examples[m] );
+   }
+
+   //Compute the distance between every pair of examples
+   if( !computeTrainingDistances(examples,finiteExamples,distanceResults) ){
+       errorLog << "_train_NDDTW(LabelledTimeSeriesClassificationData &trainingData,DTWTemplate &dtwTemplate,UINT &bestIndex - Failed to compute the distances between the training examples!" << endl;
+       return false;
+   }
+
+   for(UINT m=0; m<numExamples; m++){
 	   for(UINT n=0; n<numExamples; n++){
 		if(m!=n){
-		    //Smooth the data if required
-		    if( useSmoothing ) smoothData(trainingData[n].getData(),smoothingFactor,templateB);
-		    else templateB = trainingData[n].getData();
-            
-            if( offsetUsingFirstSample ){
-                offsetTimeseries(templateB);
-            }
-
-			//Compute the distance between the two time series
-            MatrixDouble distanceMatrix(templateA.getNumRows(),templateB.getNumRows());
-            vector< IndexDist > warpPath;
-			double dist = computeDistance(templateA,templateB,distanceMatrix,warpPath);
-            
-            trainingLog << "Template: " << m << " Timeseries: " << n << " Dist: " << dist << endl;
+            trainingLog << "Template: " << m << " Timeseries: " << n << " Dist: " << distanceResults[m][n] << endl;
 
 			//Update the results values
-			distanceResults[m][n] = dist;
-			results[m] += dist;
+			results[m] += distanceResults[m][n];
 		}else distanceResults[m][n] = 0; //The distance is zero because the two timeseries are the same
 	   }
    }
@@ -348,6 +380,109 @@ bool DTW::train_NDDTW(LabelledTimeSeriesClassificationData &trainingData,DTWTemp
 }
 
 
+/**
+ Shared state for one of the DTW training worker threads. The example counter is shared by all the workers and is protected by the mutex,
+ the band, cost buffer and list of unconnected pairs are owned by the worker.
+ */
+struct DTWTrainingWorkerData{
+    const DTW *dtw;
+    const vector< MatrixDouble > *examples;
+    const vector< bool > *finiteExamples;
+    MatrixDouble *distances;
+    UINT *nextExampleIndex;
+    pthread_mutex_t *mutex;
+    DTWTemplateBounds bounds;
+    VectorDouble costBuffer;
+    vector< IndexDist > unconnectedPairs;
+};
+
+void* DTW::trainingWorkerThread(void *workerData){
+
+    DTWTrainingWorkerData *worker = (DTWTrainingWorkerData*)workerData;
+    const vector< MatrixDouble > &examples = *worker->examples;
+    const UINT numExamples = (UINT)examples.size();
+
+    while( true ){
+        //Grab the next example, each worker fills the rows of the distance matrix for the examples it grabs
+        pthread_mutex_lock( worker->mutex );
+        const UINT m = (*worker->nextExampleIndex)++;
+        pthread_mutex_unlock( worker->mutex );
+        if( m >= numExamples ) break;
+
+        for(UINT n=0; n<numExamples; n++){
+            if( m == n ) continue;
+
+            //The distance is not symmetric (the band and the tie breaks depend on the order of the time series), so every pair is computed
+            if( (*worker->finiteExamples)[m] && (*worker->finiteExamples)[n] ){
+                worker->dtw->computeTemplateBounds(examples[m],examples[n].getNumRows(),worker->bounds);
+                if( worker->bounds.connected ){
+                    (*worker->distances)[m][n] = worker->dtw->computeBandedDistance(examples[m],worker->bounds,examples[n],worker->costBuffer);
+                    continue;
+                }
+            }
+
+            //This pair needs the full search, which is run on the calling thread once all the workers have finished
+            worker->unconnectedPairs.push_back( IndexDist(m,n) );
+        }
+    }
+
+    return NULL;
+}
+
+bool DTW::computeTrainingDistances(vector< MatrixDouble > &examples,const vector< bool > &finiteExamples,MatrixDouble &distances){
+
+    const UINT numExamples = (UINT)examples.size();
+    const UINT numWorkers = numThreads < numExamples ? numThreads : numExamples;
+    UINT nextExampleIndex = 0;
+    pthread_mutex_t mutex;
+    pthread_mutex_init( &mutex, NULL );
+
+    if( numWorkers == 0 ){
+        pthread_mutex_destroy( &mutex );
+        return false;
+    }
+
+    vector< DTWTrainingWorkerData > workers( numWorkers );
+    for(UINT i=0; i<numWorkers; i++){
+        workers[i].dtw = this;
+        workers[i].examples = &examples;
+        workers[i].finiteExamples = &finiteExamples;
+        workers[i].distances = &distances;
+        workers[i].nextExampleIndex = &nextExampleIndex;
+        workers[i].mutex = &mutex;
+    }
+
+    //Start the worker threads, the calling thread acts as the first worker. If a thread can not be started then its examples will be run by the other workers
+    vector< pthread_t > threads( numWorkers );
+    vector< bool > threadStarted( numWorkers, false );
+    for(UINT i=1; i<numWorkers; i++){
+        threadStarted[i] = pthread_create( &threads[i], NULL, trainingWorkerThread, &workers[i] ) == 0;
+        if( !threadStarted[i] ){
+            warningLog << "computeTrainingDistances(vector< MatrixDouble > &examples,const vector< bool > &finiteExamples,MatrixDouble &distances) - Failed to start worker thread " << i << "!" << endl;
+        }
+    }
+
+    trainingWorkerThread( &workers[0] );
+
+    for(UINT i=1; i<numWorkers; i++){
+        if( threadStarted[i] ) pthread_join( threads[i], NULL );
+    }
+    pthread_mutex_destroy( &mutex );
+
+    //Run the full search for any pairs that could not use the banded search
+    MatrixDouble distanceMatrix;
+    vector< IndexDist > warpPath;
+    for(UINT i=0; i<numWorkers; i++){
+        for(UINT k=0; k<workers[i].unconnectedPairs.size(); k++){
+            const UINT m = workers[i].unconnectedPairs[k].x;
+            const UINT n = workers[i].unconnectedPairs[k].y;
+            distances[m][n] = computeDistance(examples[m],examples[n],distanceMatrix,warpPath);
+        }
+    }
+
+    return true;
+}
+
 bool DTW::predict(MatrixDouble inputTimeSeries){
 
     if( !trained ){
@@ -398,16 +533,24 @@ bool DTW::predict(MatrixDouble inputTimeSeries){
 
 	//Make the prediction by finding the closest template
     double sum = 0;
-    if( distanceMatrices.size() != numTemplates ) distanceMatrices.resize( numTemplates );
-    if( warpPaths.size() != numTemplates ) warpPaths.resize( numTemplates );
+
+    //The distance matrices and warping paths are only built if they are requested, so just keep the time series they would be built from
+    distanceMatrices.clear();
+    warpPaths.clear();
+    warpingPathTimeSeries = *timeSeriesPtr;
     
+    //The banded search computes its local costs against the float templates if float prediction is enabled
+    if( useFloatPrediction ) floatTimeSeries.copyFromDouble( *timeSeriesPtr );
+
 	//Test the timeSeries against all the templates in the timeSeries buffer
-	for(UINT k=0; k<numTemplates; k++){
-		//Perform DTW
-		classDistances[k] = computeDistance(templatesBuffer[k].timeSeries,*timeSeriesPtr,distanceMatrices[k],warpPaths[k]);
+    if( !computeDistances( *timeSeriesPtr ) ){
+        errorLog << "predict(Matrix<double> &timeSeries) - Failed to compute the distances to the templates!" << endl;
+        return false;
+    }
+    for(UINT k=0; k<numTemplates; k++){
         classLikelihoods[k] = classDistances[k];
         sum += classLikelihoods[k];
-	}
+    }
 
 	//See which gave the min distance
 	UINT closestTemplateIndex = 0;
@@ -458,6 +601,10 @@ bool DTW::predict(MatrixDouble inputTimeSeries){
 }
 
 bool DTW::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool DTW::predictInplace(VectorDouble &inputVector){
 
     if( !trained ){
         errorLog << "predict(vector<double> inputVector) - The model has not been trained!" << endl;
@@ -477,6 +624,11 @@ bool DTW::predict(VectorDouble inputVector){
     //Add the new input to the circular buffer
     continuousInputDataBuffer.push_back( inputVector );
 
+    //The streaming search only needs the new sample
+    if( useStreamingPrediction ){
+        return predictStreaming( inputVector );
+    }
+
     if( continuousInputDataBuffer.getNumValuesInBuffer() < averageTemplateLength ){
         //We haven't got enough samples yet so can't do the prediction
         return true;
@@ -495,8 +647,16 @@ bool DTW::predict(VectorDouble inputVector){
 
 }
 
+bool DTW::predictFloatInplace(VectorFloat &inputVector){
+    
+    //The realtime buffer stores double samples, the float templates are used when the buffer is classified
+    VectorDouble x( inputVector.begin(), inputVector.end() );
+    return predictInplace( x );
+}
+
 bool DTW::reset(){
     continuousInputDataBuffer.clear();
+    resetStreamingState();
     if( trained ){
         continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numInputDimensions,0));
         recomputeNullRejectionThresholds();
@@ -513,7 +673,13 @@ bool DTW::clear(){
     templatesBuffer.clear();
     distanceMatrices.clear();
     warpPaths.clear();
+    warpingPathTimeSeries.clear();
     continuousInputDataBuffer.clear();
+    templateBounds.clear();
+    costBuffer.clear();
+    floatTemplates.clear();
+    floatTimeSeries.clear();
+    resetStreamingState();
     
     return true;
 }
@@ -541,6 +707,10 @@ bool DTW::setModels( vector< DTWTemplate > newTemplates ){
 		for(UINT i=0; i<templatesBuffer.size(); i++){
 			classLabels[i] = templatesBuffer[i].classLabel;
 		}
+		//The bounds, streaming state and float copy of the old templates are no longer valid
+		buildTemplateBounds();
+		resetStreamingState();
+		updateFloatModel();
 		return true;
 	}
 	return false;
@@ -548,12 +718,75 @@ bool DTW::setModels( vector< DTWTemplate > newTemplates ){
 
 ////////////////////////// computeDistance ///////////////////////////////////////////
 
+bool DTW::computeDistances(MatrixDouble &timeSeries){
+
+    const UINT N = timeSeries.getNumRows();
+
+    if( templateBounds.size() != numTemplates ) templateBounds.resize( numTemplates );
+
+    //The forward pass can only be used for finite data, any unknown distance method is left to the full search, which will report the error
+    const bool useForwardPass = (distanceMethod == ABSOLUTE_DIST || distanceMethod == EUCLIDEAN_DIST || distanceMethod == NORM_ABSOLUTE_DIST) && isFinite( timeSeries );
+
+    //The float copies are only used if they match the templates and the input time series
+    const bool useFloatCosts = useFloatPrediction && floatTemplates.size() == numTemplates && floatTimeSeries.getNumRows() == N && floatTimeSeries.getNumCols() == timeSeries.getNumCols();
+
+    MatrixDouble distanceMatrix;
+    vector< IndexDist > warpPath;
+    for(UINT k=0; k<numTemplates; k++){
+        DTWTemplateBounds &bounds = templateBounds[k];
+        if( useForwardPass ){
+            if( bounds.inputLength != N || bounds.radius != radius || bounds.constrainWarpingPath != constrainWarpingPath ){
+                computeTemplateBounds(templatesBuffer[k].timeSeries,N,bounds);
+            }
+
+            //Only the cells inside (or bordering) the warping band are stored, the full distance matrix and warping path are not needed
+            if( bounds.connected ){
+                if( useFloatCosts ){
+                    classDistances[k] = computeBandedDistance(templatesBuffer[k].timeSeries,bounds,timeSeries,costBuffer,&floatTemplates[k],&floatTimeSeries);
+                }else classDistances[k] = computeBandedDistance(templatesBuffer[k].timeSeries,bounds,timeSeries,costBuffer);
+                if( isinf( classDistances[k] ) ){
+                    warningLog << "computeDistances(MatrixDouble &timeSeries) - Could not compute a warping path for template " << k << "!" << endl;
+                }
+                continue;
+            }
+        }
+        classDistances[k] = computeDistance(templatesBuffer[k].timeSeries,timeSeries,distanceMatrix,warpPath);
+    }
+
+    return true;
+}
+
+bool DTW::computeWarpingPaths(){
+
+    distanceMatrices.clear();
+    warpPaths.clear();
+
+    if( !trained || warpingPathTimeSeries.getNumRows() == 0 ) return false;
+
+    distanceMatrices.resize( numTemplates );
+    warpPaths.resize( numTemplates );
+    for(UINT k=0; k<numTemplates; k++){
+        computeDistance(templatesBuffer[k].timeSeries,warpingPathTimeSeries,distanceMatrices[k],warpPaths[k]);
+    }
+
+    return true;
+}
+
+vector< MatrixDouble > DTW::getDistanceMatrices(){
+    if( distanceMatrices.size() != numTemplates ) computeWarpingPaths();
+    return distanceMatrices;
+}
+
+vector< vector< IndexDist > > DTW::getWarpingPaths(){
+    if( warpPaths.size() != numTemplates ) computeWarpingPaths();
+    return warpPaths;
+}
+
 double DTW::computeDistance(MatrixDouble &timeSeriesA,MatrixDouble &timeSeriesB,MatrixDouble &distanceMatrix,vector< IndexDist > &warpPath){
 
 	const int M = timeSeriesA.getNumRows();
 	const int N = timeSeriesB.getNumRows();
-	const int C = timeSeriesA.getNumCols();
-	int i,j,k,index = 0;
+	int i,j,index = 0;
 	double totalDist,v,normFactor = 0.;
     
     warpPath.clear();
@@ -561,60 +794,47 @@ double DTW::computeDistance(MatrixDouble &timeSeriesA,MatrixDouble &timeSeriesB,
         distanceMatrix.resize(M, N);
     }
 
-	switch (distanceMethod) {
-		case (ABSOLUTE_DIST):
-			for(i=0; i<M; i++){
-				for(j=0; j<N; j++){
-					distanceMatrix[i][j] = 0.0;
-					for(k=0; k< C; k++){
-					   distanceMatrix[i][j] += fabs(timeSeriesA[i][k]-timeSeriesB[j][k]);
-					}
-				}
-			}
-			break;
-		case (EUCLIDEAN_DIST):
-			//Calculate Euclidean Distance for all possible values
-			for(i=0; i<M; i++){
-				for(j=0; j<N; j++){
-					distanceMatrix[i][j] = 0.0;
-					for(k=0; k< C; k++){
-						distanceMatrix[i][j] += SQR( timeSeriesA[i][k]-timeSeriesB[j][k] );
-					}
-					distanceMatrix[i][j] = sqrt( distanceMatrix[i][j] );
-				}
-			}
-			break;
-		case (NORM_ABSOLUTE_DIST):
-			for(i=0; i<M; i++){
-				for(j=0; j<N; j++){
-					distanceMatrix[i][j] = 0.0;
-					for(k=0; k< C; k++){
-					   distanceMatrix[i][j] += fabs(timeSeriesA[i][k]-timeSeriesB[j][k]);
-					}
-					distanceMatrix[i][j]/=N;
-				}
-			}
-			break;
-		default:
-			errorLog<<"ERROR: Unknown distance method: "<<distanceMethod<<endl;
-			return -1;
-			break;
-	}
+    if( distanceMethod != ABSOLUTE_DIST && distanceMethod != EUCLIDEAN_DIST && distanceMethod != NORM_ABSOLUTE_DIST ){
+        errorLog<<"ERROR: Unknown distance method: "<<distanceMethod<<endl;
+        return -1;
+    }
 
-    //Run the recursive search function to build the cost matrix
-    double distance = sqrt( d(M-1,N-1,distanceMatrix,M,N) );
+    //The forward pass gives exactly the same cost matrix as the full search if every local cost is finite and every cell in the warping band
+    //is reached by the full search, otherwise the full search is used
+    DTWTemplateBounds band;
+    const bool useForwardPass = M > 0 && N > 0 && isFinite( timeSeriesA ) && isFinite( timeSeriesB ) && computeWarpingBand(M,N,band);
+
+    double distance = 0;
+    if( useForwardPass ){
+        //Each row of the distance matrix is filled by comparing one sample of timeSeriesA against the samples of timeSeriesB that are inside (or
+        //border) the band, the full search would flag every other cell as unreachable
+        for(i=0; i<M; i++){
+            double *row = distanceMatrix[i];
+            for(j=0; j<int(band.rowStart[i]); j++) row[j] = NAN;
+            for(j=band.rowEnd[i]+1; j<N; j++) row[j] = NAN;
+            computeCosts(timeSeriesA[i],timeSeriesB,band.rowStart[i],band.rowEnd[i],row + band.rowStart[i]);
+            accumulateCosts(i,band,i > 0 ? distanceMatrix[i-1] : NULL,row);
+        }
+        distance = sqrt( distanceMatrix[M-1][N-1] );
+    }else{
+        //Each row of the distance matrix is filled by comparing one sample of timeSeriesA against every sample in timeSeriesB
+        for(i=0; i<M; i++){
+            computeCosts(timeSeriesA[i],timeSeriesB,0,N-1,distanceMatrix[i]);
+        }
+        distance = sqrt( searchCostMatrix(distanceMatrix,M,N) );
+    }
 
     if( isinf(distance) || isnan(distance) ){
         warningLog << "DTW computeDistance(...) - Distance Matrix Values are INF!" << endl;
         return INFINITY;
     }
-    
-    //cout << "DIST: " << distance << endl;
 
-    //The distMatrix values are negative so make them positive
-    for(i=0; i<M; i++){
-        for(j=0; j<N; j++){
-            distanceMatrix[i][j] = fabs( distanceMatrix[i][j] );
+    //The full search leaves the values it has visited negative, so make them positive
+    if( !useForwardPass ){
+        for(i=0; i<M; i++){
+            for(j=0; j<N; j++){
+                distanceMatrix[i][j] = fabs( distanceMatrix[i][j] );
+            }
         }
     }
 
@@ -664,112 +884,568 @@ double DTW::computeDistance(MatrixDouble &timeSeriesA,MatrixDouble &timeSeriesB,
 	return totalDist/normFactor;
 }
 
-double DTW::d(int m,int n,MatrixDouble &distanceMatrix,const int M,const int N){
-    double dist = 0;
-    //The following is based on Matlab code by Eamonn Keogh and Michael Pazzani
-    
-    //If this cell is NAN then it has already been flagged as unreachable
-    if( isnan( distanceMatrix[m][n] ) ){
-        return NAN;
+void DTW::accumulateCosts(const int i,const DTWTemplateBounds &bounds,const double *prevRow,double *row) const{
+
+    //The rows are indexed by column, so prevRow and row only need to be valid over the cells stored for their row
+    const int start = bounds.bandStart[i];
+    const int end = bounds.bandEnd[i];
+    const int prevStart = i > 0 ? int(bounds.bandStart[i-1]) : 0;
+    const int prevEnd = i > 0 ? int(bounds.bandEnd[i-1]) : -1;
+
+    for(int j=start; j<=end; j++){
+        if( i == 0 ){
+            if( j > 0 ) row[j] = row[j] + row[j-1];
+        }else if( j == 0 ){
+            row[j] = row[j] + prevRow[j];
+        }else{
+            //Any cell outside the band is unreachable
+            const double contribDist1 = j-1 >= prevStart && j-1 <= prevEnd ? prevRow[j-1] : NAN;
+            const double contribDist2 = j >= prevStart && j <= prevEnd ? prevRow[j] : NAN;
+            const double contribDist3 = j-1 >= start ? row[j-1] : NAN;
+            double minValue = numeric_limits<double>::max();
+            int index = 0;
+            if( contribDist1 < minValue ){ minValue = contribDist1; index = 1; }
+            if( contribDist2 < minValue ){ minValue = contribDist2; index = 2; }
+            if( contribDist3 < minValue ){ minValue = contribDist3; index = 3; }
+            row[j] = index != 0 ? row[j] + minValue : 0;
+        }
     }
+}
 
-    if( constrainWarpingPath ){
-        double r = ceil( min(M,N)*radius );
-        //Test to see if the current cell is outside of the warping window
-        if( fabs( n-((N-1)/((M-1)/double(m))) ) > r ){
-            if( n-((N-1)/((M-1)/double(m))) > 0 ){
-                for(int i=0; i<m; i++){
-                    for(int j=n; j<N; j++){
-                        distanceMatrix[i][j] = NAN;
+double DTW::searchCostMatrix(MatrixDouble &distanceMatrix,const int M,const int N){
+    //The following is based on Matlab code by Eamonn Keogh and Michael Pazzani
+    //This searches back from the last cell in the same order as the original recursive search, but keeps its own stack of cells on the heap, so
+    //long time series can not overflow the thread's stack.  Each visited cell is negated to record that it has been visited
+    vector< DTWSearchCell > stack;
+    stack.reserve( M+N );
+    stack.push_back( DTWSearchCell(M-1,N-1) );
+    const double r = ceil( min(M,N)*radius );
+    double dist = 0;
+
+    while( stack.size() > 0 ){
+        DTWSearchCell &cell = stack.back();
+        const int m = cell.m;
+        const int n = cell.n;
+
+        if( cell.numSearched < 0 ){
+            //If this cell is NAN then it has already been flagged as unreachable
+            if( isnan( distanceMatrix[m][n] ) ){
+                dist = NAN;
+                stack.pop_back();
+                continue;
+            }
+
+            if( constrainWarpingPath ){
+                //Test to see if the current cell is outside of the warping window
+                if( fabs( n-((N-1)/((M-1)/double(m))) ) > r ){
+                    if( n-((N-1)/((M-1)/double(m))) > 0 ){
+                        for(int i=0; i<m; i++){
+                            for(int j=n; j<N; j++){
+                                distanceMatrix[i][j] = NAN;
+                            }
+                        }
+                    }else{
+                        for(int i=m; i<M; i++){
+                            for(int j=0; j<n; j++){
+                                distanceMatrix[i][j] = NAN;
+                            }
+                        }
                     }
+                    dist = NAN;
+                    stack.pop_back();
+                    continue;
                 }
-            }else{
-                for(int i=m; i<M; i++){
-                    for(int j=0; j<n; j++){
-                        distanceMatrix[i][j] = NAN;
-                    }
+            }
+
+            //If this cell contains a negative value then it has already been searched, the cost is the absolute value
+            if( distanceMatrix[m][n] < 0 ){
+                dist = fabs( distanceMatrix[m][n] );
+                stack.pop_back();
+                continue;
+            }
+
+            //A warping path has reached the end
+            if( m == 0 && n == 0 ){
+                dist = distanceMatrix[0][0];
+                distanceMatrix[0][0] = -distanceMatrix[0][0];
+                stack.pop_back();
+                continue;
+            }
+
+            cell.numSearched = 0;
+        }else{
+            //One of the cells this cell depends on has just been searched
+            cell.contribDist[ cell.numSearched++ ] = dist;
+        }
+
+        //The top row can only move left and the left column can only move down, every other cell considers the three main directions
+        const int numContribs = m == 0 || n == 0 ? 1 : 3;
+        if( cell.numSearched < numContribs ){
+            if( m == 0 ) stack.push_back( DTWSearchCell(m,n-1) );
+            else if( n == 0 ) stack.push_back( DTWSearchCell(m-1,n) );
+            else{
+                switch( cell.numSearched ){
+                    case 0:
+                        stack.push_back( DTWSearchCell(m-1,n-1) );
+                        break;
+                    case 1:
+                        stack.push_back( DTWSearchCell(m-1,n) );
+                        break;
+                    default:
+                        stack.push_back( DTWSearchCell(m,n-1) );
+                        break;
                 }
             }
-            return NAN;
+            continue;
         }
+
+        if( numContribs == 1 ){
+            dist = distanceMatrix[m][n] + cell.contribDist[0];
+        }else{
+            double minValue = numeric_limits<double>::max();
+            int index = 0;
+            if( cell.contribDist[0] < minValue ){ minValue = cell.contribDist[0]; index = 1; }
+            if( cell.contribDist[1] < minValue ){ minValue = cell.contribDist[1]; index = 2; }
+            if( cell.contribDist[2] < minValue ){ minValue = cell.contribDist[2]; index = 3; }
+            dist = index != 0 ? distanceMatrix[m][n] + minValue : 0;
+        }
+
+        distanceMatrix[m][n] = -dist; //Negate the value to record that it has been visited
+        stack.pop_back();
+    }
+
+    return dist;
+}
+
+bool DTW::isFinite(const MatrixDouble &timeSeries){
+    const UINT M = timeSeries.getNumRows();
+    const UINT C = timeSeries.getNumCols();
+    for(UINT i=0; i<M; i++){
+        for(UINT j=0; j<C; j++){
+            if( isnan( timeSeries[i][j] ) || isinf( timeSeries[i][j] ) ) return false;
+        }
+    }
+    return true;
+}
+
+inline double DTW::MIN_(double a,double b, double c){
+	double v = a;
+	if(b<v) v = b;
+	if(c<v) v = c;
+	return v;
+}
+
+////////////////////////// BANDED DTW FUNCTIONS //////////////////////////
+
+bool DTW::buildTemplateBounds(){
+
+    //Remove the bounds of any previous templates
+    templateBounds.clear();
+    templateBounds.resize( templatesBuffer.size() );
+
+    //Compute the bounds for the length of the realtime input buffer (after any smoothing), the bounds for any other length are computed when they are needed
+    UINT inputLength = averageTemplateLength;
+    if( useSmoothing && smoothingFactor > 1 && inputLength >= smoothingFactor ){
+        inputLength = (inputLength/smoothingFactor) + (inputLength%smoothingFactor != 0 ? 1 : 0);
     }
 
-    //If this cell contains a negative value then it has already been searched
-    //The cost is therefore the absolute value of the negative value so return it
-    if( distanceMatrix[m][n] < 0 ){
-        dist = fabs( distanceMatrix[m][n] );
-        return dist;
+    for(UINT k=0; k<templatesBuffer.size(); k++){
+        computeTemplateBounds(templatesBuffer[k].timeSeries,inputLength,templateBounds[k]);
     }
 
-    //Case 1: A warping path has reached the end
-    //Return the contribution of distance
-    //Negate the value, to record the fact that this cell has been visited
-    //End of recursion
-    if( m == 0 && n == 0 ){
-        dist = distanceMatrix[0][0];
-        distanceMatrix[0][0] = -distanceMatrix[0][0];
-        return dist;
+    return true;
+}
+
+bool DTW::computeWarpingBand(const int M,const int N,DTWTemplateBounds &bounds) const{
+
+    bounds.bufferSize = 0;
+
+    //Find the columns inside the warping band for each row, using the same test as the full search
+    bounds.bandStart.resize(M);
+    bounds.bandEnd.resize(M);
+    const double r = ceil( min(M,N)*radius );
+    for(int i=0; i<M; i++){
+        const double diagonal = (N-1)/((M-1)/double(i));
+        if( !constrainWarpingPath || isnan( diagonal ) ){
+            bounds.bandStart[i] = 0;
+            bounds.bandEnd[i] = N-1;
+            continue;
+        }
+
+        //Start at the column closest to the diagonal and grow the band in both directions
+        int j = (int)floor( diagonal + 0.5 );
+        if( j > N-1 ) j = N-1;
+        if( fabs( j-diagonal ) > r ) return false;
+        int start = j;
+        int end = j;
+        while( start > 0 && !(fabs( (start-1)-diagonal ) > r) ) start--;
+        while( end < N-1 && !(fabs( (end+1)-diagonal ) > r) ) end++;
+        bounds.bandStart[i] = start;
+        bounds.bandEnd[i] = end;
     }
 
-    //Case 2: we are somewhere in the top row of the matrix
-    //Only need to consider moving left
-    if( m == 0 ){
-        double contribDist = d(m,n-1,distanceMatrix,M,N);
+    //The forward pass requires the band of each row to overlap (or touch) the band of the previous row, as every cell is then reached by the full search
+    for(int i=1; i<M; i++){
+        if( bounds.bandStart[i] < bounds.bandStart[i-1] || bounds.bandEnd[i] < bounds.bandEnd[i-1] || bounds.bandStart[i] > bounds.bandEnd[i-1]+1 ) return false;
+    }
+
+    //The full search flags the cells behind each cell it tests outside the band as unreachable, the cells it does not flag keep their local cost
+    //and can be used by the warping path. Below the band only the cell next to the band is left, above the band the cells are left up to the first
+    //column that is tested outside the band in any of the following rows
+    bounds.rowStart.resize(M);
+    bounds.rowEnd.resize(M);
+    bounds.rowOffset.resize(M);
+    UINT aboveLimit = N;
+    for(int i=M-1; i>=0; i--){
+        bounds.rowStart[i] = bounds.bandStart[i] > 0 ? bounds.bandStart[i]-1 : 0;
+        bounds.rowEnd[i] = aboveLimit-1;
+        if( i < M-1 && bounds.bandEnd[i+1] > bounds.bandEnd[i] ) aboveLimit = bounds.bandEnd[i]+1;
+    }
+    for(int i=0; i<M; i++){
+        bounds.rowOffset[i] = bounds.bufferSize;
+        bounds.bufferSize += bounds.rowEnd[i] - bounds.rowStart[i] + 1;
+    }
 
-        dist = distanceMatrix[m][n] + contribDist;
+    return true;
+}
 
-        distanceMatrix[m][n] = -dist;
-        return dist;
-    }else{
-        //Case 3: we are somewhere in the left column of the matrix
-        //Only need to consider moving down
-        if ( n == 0) {
-            double contribDist = d(m-1,n,distanceMatrix,M,N);
+bool DTW::computeTemplateBounds(const MatrixDouble &timeSeriesA,const UINT inputLength,DTWTemplateBounds &bounds) const{
 
-            dist = distanceMatrix[m][n] + contribDist;
+    const int M = timeSeriesA.getNumRows();
+    const int N = inputLength;
 
-            distanceMatrix[m][n] = -dist;
-            return dist;
-        }else{
-            //Case 4: We are somewhere away from the edges so consider moving in the three main directions
-            double contribDist1 = d(m-1,n-1,distanceMatrix,M,N);
-            double contribDist2 = d(m-1,n,distanceMatrix,M,N);
-            double contribDist3 = d(m,n-1,distanceMatrix,M,N);
-            double minValue = numeric_limits<double>::max();
-            int index = 0;
-            if( contribDist1 < minValue ){ minValue = contribDist1; index = 1; }
-			if( contribDist2 < minValue ){ minValue = contribDist2; index = 2; }
-			if( contribDist3 < minValue ){ minValue = contribDist3; index = 3; }
+    bounds.inputLength = inputLength;
+    bounds.radius = radius;
+    bounds.constrainWarpingPath = constrainWarpingPath;
+    bounds.connected = false;
+    bounds.bufferSize = 0;
 
-            switch ( index ) {
-                case 1:
-                    dist = distanceMatrix[m][n] + minValue;
-                    break;
-                case 2:
-                    dist = distanceMatrix[m][n] + minValue;
-                    break;
-                case 3:
-                    dist = distanceMatrix[m][n] + minValue;
-                    break;
+    if( M == 0 || N == 0 ) return false;
 
-                default:
+    //The full search treats any NAN cell as unreachable, so templates that are not finite must use the full search
+    if( !isFinite( timeSeriesA ) ) return false;
+
+    if( !computeWarpingBand(M,N,bounds) ) return false;
+
+    bounds.connected = true;
+    return true;
+}
+
+double DTW::computeBandedDistance(const MatrixDouble &timeSeriesA,const DTWTemplateBounds &bounds,const MatrixDouble &timeSeriesB,VectorDouble &costBuffer,const MatrixFloat *floatTimeSeriesA,const MatrixFloat *floatTimeSeriesB) const{
+
+    //Note, this does not log anything so that it can be called from the training threads
+    const int M = timeSeriesA.getNumRows();
+    const int N = timeSeriesB.getNumRows();
+    int i,j,index = 0;
+    double totalDist,v,normFactor = 0.;
+
+    if( costBuffer.size() < bounds.bufferSize ) costBuffer.resize( bounds.bufferSize );
+    double *cost = &costBuffer[0];
+
+    //Fill the cost matrix one row at a time, this gives the same costs as the full search as every cell in the band is reached by it
+    for(i=0; i<M; i++){
+        double *row = cost + bounds.rowOffset[i] - bounds.rowStart[i];
+        const double *prevRow = i > 0 ? cost + bounds.rowOffset[i-1] - bounds.rowStart[i-1] : NULL;
+
+        //Compute the local costs of this row, the cells bordering the band keep their local cost
+        if( floatTimeSeriesA != NULL && floatTimeSeriesB != NULL ){
+            computeCosts((*floatTimeSeriesA)[i],*floatTimeSeriesB,bounds.rowStart[i],bounds.rowEnd[i],row + bounds.rowStart[i]);
+        }else computeCosts(timeSeriesA[i],timeSeriesB,bounds.rowStart[i],bounds.rowEnd[i],row + bounds.rowStart[i]);
+
+        accumulateCosts(i,bounds,prevRow,row);
+    }
+
+    double distance = sqrt( cost[ bounds.rowOffset[M-1] + (N-1) - bounds.rowStart[M-1] ] );
+    if( isinf(distance) || isnan(distance) ){
+        return INFINITY;
+    }
+
+    //Now follow the warp path back through the cost matrix, any cell that is not stored is unreachable
+#define DTW_COST(i,j) ( int(j) >= int(bounds.rowStart[i]) && int(j) <= int(bounds.rowEnd[i]) ? cost[ bounds.rowOffset[i] + (j) - bounds.rowStart[i] ] : NAN )
+    i=M-1;
+    j=N-1;
+    totalDist = DTW_COST(i,j);
+    normFactor = 1;
+    while( true ) {
+        if( i==0 && j==0 ) break;
+        if( i==0 ){ j--; }
+        else{
+            if( j==0 ) i--;
+            else{
+                //Find the minimum cell to move to
+                v = numeric_limits<double>::max();
+                index = 0;
+                if( DTW_COST(i-1,j) < v ){ v = DTW_COST(i-1,j); index = 1; }
+                if( DTW_COST(i,j-1) < v ){ v = DTW_COST(i,j-1); index = 2; }
+                if( DTW_COST(i-1,j-1) <= v ){ index = 3; }
+                switch(index){
+                    case(1):
+                        i--;
+                        break;
+                    case(2):
+                        j--;
+                        break;
+                    case(3):
+                        i--;
+                        j--;
+                        break;
+                    default:
+                        return INFINITY;
+                        break;
+                }
+            }
+        }
+        normFactor++;
+        totalDist += DTW_COST(i,j);
+    }
+#undef DTW_COST
+
+    return totalDist/normFactor;
+}
+
+void DTW::computeCosts(const double *x,const MatrixDouble &timeSeries,const UINT startIndex,const UINT endIndex,double *costs) const{
+
+    const UINT N = timeSeries.getNumRows();
+    const UINT C = timeSeries.getNumCols();
+    const UINT numCosts = endIndex - startIndex + 1;
+
+    //Compute the local costs in exactly the same way as computeDistance
+    switch( distanceMethod ){
+        case (ABSOLUTE_DIST):
+            DistanceKernels::manhattan( x, timeSeries[startIndex], numCosts, timeSeries.getStride(), C, costs );
+            break;
+        case (EUCLIDEAN_DIST):
+            DistanceKernels::squaredEuclidean( x, timeSeries[startIndex], numCosts, timeSeries.getStride(), C, costs );
+            for(UINT j=0; j<numCosts; j++){
+                costs[j] = sqrt( costs[j] );
+            }
+            break;
+        case (NORM_ABSOLUTE_DIST):
+            DistanceKernels::manhattan( x, timeSeries[startIndex], numCosts, timeSeries.getStride(), C, costs );
+            for(UINT j=0; j<numCosts; j++){
+                costs[j]/=N;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void DTW::computeCosts(const float *x,const MatrixFloat &timeSeries,const UINT startIndex,const UINT endIndex,double *costs) const{
+
+    const UINT N = timeSeries.getNumRows();
+    const UINT C = timeSeries.getNumCols();
+
+    //Compute the float distances a block at a time, the costs are then stored as doubles so the cost matrix is summed in double
+    float dist[ GRT_DISTANCE_KERNEL_BLOCK_SIZE ];
+    for(UINT blockStart=startIndex; blockStart<=endIndex; blockStart+=GRT_DISTANCE_KERNEL_BLOCK_SIZE){
+        const UINT B = endIndex-blockStart+1 < GRT_DISTANCE_KERNEL_BLOCK_SIZE ? endIndex-blockStart+1 : GRT_DISTANCE_KERNEL_BLOCK_SIZE;
+        double *blockCosts = costs + (blockStart-startIndex);
+        switch( distanceMethod ){
+            case (ABSOLUTE_DIST):
+                DistanceKernels::manhattan( x, timeSeries[blockStart], B, timeSeries.getStride(), C, dist );
+                for(UINT j=0; j<B; j++) blockCosts[j] = dist[j];
+                break;
+            case (EUCLIDEAN_DIST):
+                DistanceKernels::squaredEuclidean( x, timeSeries[blockStart], B, timeSeries.getStride(), C, dist );
+                for(UINT j=0; j<B; j++) blockCosts[j] = sqrt( double(dist[j]) );
+                break;
+            case (NORM_ABSOLUTE_DIST):
+                DistanceKernels::manhattan( x, timeSeries[blockStart], B, timeSeries.getStride(), C, dist );
+                for(UINT j=0; j<B; j++) blockCosts[j] = double(dist[j])/N;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool DTW::buildFloatModel(){
+    
+    if( templatesBuffer.size() != numTemplates ) return false;
+    
+    floatTemplates.resize( numTemplates );
+    for(UINT k=0; k<numTemplates; k++){
+        if( !floatTemplates[k].copyFromDouble( templatesBuffer[k].timeSeries ) ) return false;
+    }
+    
+    return true;
+}
+
+////////////////////////// STREAMING DTW FUNCTIONS //////////////////////////
+
+bool DTW::predictStreaming(VectorDouble &inputVector){
+
+    //These are applied to a whole time series, so they can not be applied to one sample at a time
+    if( useZNormalisation || useSmoothing || offsetUsingFirstSample ){
+        errorLog << "predictStreaming(VectorDouble &inputVector) - The streaming prediction mode can not be used with z-normalization, smoothing or offsetUsingFirstSample!" << endl;
+        return false;
+    }
+
+    if( streamingStates.size() != numTemplates ) resetStreamingState();
+
+    //Scale the input sample if needed
+    if( useScaling ){
+        for(UINT j=0; j<numInputDimensions; j++){
+            inputVector[j] = scale(inputVector[j],ranges[j].minValue,ranges[j].maxValue,0.0,1.0);
+        }
+    }
+
+    const UINT t = streamingSampleIndex++;
+    UINT matchTemplateIndex = numTemplates;
+    double matchDistance = INFINITY;
+    double sum = 0;
+
+    for(UINT k=0; k<numTemplates; k++){
+        const MatrixDouble &timeSeriesA = templatesBuffer[k].timeSeries;
+        const UINT M = timeSeriesA.getNumRows();
+        DTWStreamingState &state = streamingStates[k];
+
+        if( M == 0 ){
+            classDistances[k] = INFINITY;
+            continue;
+        }
+
+        //Compute the cost between the new sample and every sample in the template
+        if( costBuffer.size() < M ) costBuffer.resize( M );
+        double *localCost = &costBuffer[0];
+        switch( distanceMethod ){
+            case (ABSOLUTE_DIST):
+                DistanceKernels::manhattan( &inputVector[0], timeSeriesA.getData(), M, timeSeriesA.getStride(), numInputDimensions, localCost );
+                break;
+            case (EUCLIDEAN_DIST):
+                DistanceKernels::squaredEuclidean( &inputVector[0], timeSeriesA.getData(), M, timeSeriesA.getStride(), numInputDimensions, localCost );
+                for(UINT i=0; i<M; i++){
+                    localCost[i] = sqrt( localCost[i] );
+                }
+                break;
+            case (NORM_ABSOLUTE_DIST):
+                //The window search normalizes by the length of the input time series, so use the length of the realtime buffer
+                DistanceKernels::manhattan( &inputVector[0], timeSeriesA.getData(), M, timeSeriesA.getStride(), numInputDimensions, localCost );
+                for(UINT i=0; i<M; i++){
+                    localCost[i] /= averageTemplateLength;
+                }
+                break;
+            default:
+                errorLog << "predictStreaming(VectorDouble &inputVector) - Unknown distance method: " << distanceMethod << endl;
+                return false;
+                break;
+        }
+
+        //Update the column of the cost matrix for the new sample. A warping path can start at any input sample, so the first template
+        //sample always starts a new path, every other cell extends the cheapest of the diagonal, previous sample or previous template sample
+        double diagonalCost = state.cost[0];
+        double diagonalCostSum = state.pathCostSum[0];
+        UINT diagonalStart = state.startIndex[0];
+        UINT diagonalLength = state.pathLength[0];
+        state.cost[0] = localCost[0];
+        state.pathCostSum[0] = localCost[0];
+        state.startIndex[0] = t;
+        state.pathLength[0] = 1;
+        for(UINT i=1; i<M; i++){
+            const double previousCost = state.cost[i];
+            const double previousCostSum = state.pathCostSum[i];
+            const UINT previousStart = state.startIndex[i];
+            const UINT previousLength = state.pathLength[i];
+
+            double minValue = INFINITY;
+            double costSum = INFINITY;
+            UINT start = t;
+            UINT length = 0;
+            if( diagonalCost < minValue ){ minValue = diagonalCost; costSum = diagonalCostSum; start = diagonalStart; length = diagonalLength; }
+            if( previousCost < minValue ){ minValue = previousCost; costSum = previousCostSum; start = previousStart; length = previousLength; }
+            if( state.cost[i-1] < minValue ){ minValue = state.cost[i-1]; costSum = state.pathCostSum[i-1]; start = state.startIndex[i-1]; length = state.pathLength[i-1]; }
+
+            //If no cell can be reached then this cell can not be reached either
+            state.cost[i] = localCost[i] + minValue;
+            state.pathCostSum[i] = costSum + state.cost[i];
+            state.startIndex[i] = start;
+            state.pathLength[i] = length + 1;
+
+            diagonalCost = previousCost;
+            diagonalCostSum = previousCostSum;
+            diagonalStart = previousStart;
+            diagonalLength = previousLength;
+        }
+
+        //The matches are accepted, replaced and ranked by the same distance as computeDistance, the average of the accumulated costs along
+        //the warping path, which is the distance the null rejection thresholds are trained on. The accumulated cost never decreases along a
+        //path, so the distance of a path can only grow as it is extended, and the pending match is reported once no warping path that
+        //overlaps it has a lower distance
+        if( state.matchFound ){
+            bool canImprove = false;
+            for(UINT i=0; i<M; i++){
+                if( state.startIndex[i] <= state.matchEnd && state.pathCostSum[i] < state.matchDistance * state.pathLength[i] ){
+                    canImprove = true;
                     break;
+                }
             }
+            if( !canImprove ){
+                if( state.matchDistance < matchDistance ){
+                    matchDistance = state.matchDistance;
+                    matchTemplateIndex = k;
+                }
+                state.matchFound = false;
 
-            distanceMatrix[m][n] = -dist; //Negate the value to record that it has been visited
-            return dist;
+                //The matches can not overlap, so remove any warping path that started before the end of this match
+                for(UINT i=0; i<M; i++){
+                    if( state.startIndex[i] <= state.matchEnd ) state.cost[i] = INFINITY;
+                }
+            }
         }
+
+        //Check if the warping path that ends at the last template sample is a new match, or is better than the pending match
+        const double distance = state.pathCostSum[M-1] / state.pathLength[M-1];
+        const double threshold = useNullRejection ? nullRejectionThresholds[k] : INFINITY;
+        if( !isinf( state.cost[M-1] ) && distance <= threshold && (!state.matchFound || distance < state.matchDistance) ){
+            state.matchFound = true;
+            state.matchDistance = distance;
+            state.matchStart = state.startIndex[M-1];
+            state.matchEnd = t;
+        }
+
+        classDistances[k] = distance;
+        classLikelihoods[k] = distance;
+        sum += distance;
     }
 
-    //This should not happen!
-    return dist;
+    //Normalize the class likelihoods, using the distance of the best warping path currently ending at each template
+    bestDistance = numTemplates > 0 ? classDistances[0] : INFINITY;
+    maxLikelihood = 0;
+    for(UINT k=0; k<numTemplates; k++){
+        if( classDistances[k] < bestDistance ) bestDistance = classDistances[k];
+        classLikelihoods[k] = sum > 0 && !isinf(sum) ? (sum-classLikelihoods[k])/sum : 0;
+        if( classLikelihoods[k] > maxLikelihood ) maxLikelihood = classLikelihoods[k];
+    }
+
+    //A class is only predicted when a match ends
+    if( matchTemplateIndex < numTemplates ){
+        const DTWStreamingState &state = streamingStates[ matchTemplateIndex ];
+        predictedClassLabel = templatesBuffer[ matchTemplateIndex ].classLabel;
+        bestDistance = matchDistance;
+        matchStartIndex = state.matchStart;
+        matchEndIndex = state.matchEnd;
+    }else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+
+    return true;
 }
 
-inline double DTW::MIN_(double a,double b, double c){
-	double v = a;
-	if(b<v) v = b;
-	if(c<v) v = c;
-	return v;
+bool DTW::resetStreamingState(){
+
+    streamingStates.clear();
+    streamingStates.resize( templatesBuffer.size() );
+    for(UINT k=0; k<templatesBuffer.size(); k++){
+        const UINT M = templatesBuffer[k].timeSeries.getNumRows();
+        streamingStates[k].cost.resize(M,INFINITY);
+        streamingStates[k].pathCostSum.resize(M,INFINITY);
+        streamingStates[k].startIndex.resize(M,0);
+        streamingStates[k].pathLength.resize(M,0);
+    }
+    streamingSampleIndex = 0;
+    matchStartIndex = 0;
+    matchEndIndex = 0;
+
+    return true;
 }
 
 
@@ -942,6 +1618,32 @@ bool DTW::saveModelToFile( string fileName ) const{
 }
     
 bool DTW::saveModelToFile( fstream &file ) const{
+    return saveModelData( file, true );
+}
+
+bool DTW::saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) const{
+    
+    //The settings and the template headers are written as text, the time series of every template are written one after the other in a binary section
+    if( !file.beginTextSection( sectionName ) ){
+        errorLog << "saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) - Failed to start section: " << sectionName << endl;
+        return false;
+    }
+    
+    const bool settingsSaved = saveModelData( file.getTextStream(), false );
+    if( !file.endTextSection() || !settingsSaved ){
+        return false;
+    }
+    
+    vector< double > timeSeries;
+    for(UINT i=0; i<numTemplates; i++){
+        const MatrixDouble &templateTimeSeries = templatesBuffer[i].timeSeries;
+        if( templateTimeSeries.getNumRows() > 0 ) timeSeries.insert( timeSeries.end(), templateTimeSeries[0], templateTimeSeries[0] + templateTimeSeries.getSize() );
+    }
+    
+    return file.writeSection( sectionName + "/TimeSeries", timeSeries );
+}
+
+bool DTW::saveModelData( fstream &file, const bool saveTimeSeries ) const{
     
     if(!file.is_open()){
         errorLog << "saveModelToFile( string fileName ) - Could not open file to save data" << endl;
@@ -985,10 +1687,12 @@ bool DTW::saveModelToFile( fstream &file ) const{
         file<<"TrainingSigma: "<<templatesBuffer[i].trainingSigma<<endl;
         file<<"AverageTemplateLength: "<<templatesBuffer[i].averageTemplateLength<<endl;
         file<<"TimeSeries: \n";
-        for(UINT k=0; k<templatesBuffer[i].timeSeries.getNumRows(); k++){
-            for(UINT j=0; j<templatesBuffer[i].timeSeries.getNumCols(); j++){
-                file << templatesBuffer[i].timeSeries[k][j] << "\t";
-            }file << endl;
+        if( saveTimeSeries ){
+            for(UINT k=0; k<templatesBuffer[i].timeSeries.getNumRows(); k++){
+                for(UINT j=0; j<templatesBuffer[i].timeSeries.getNumCols(); j++){
+                    file << templatesBuffer[i].timeSeries[k][j] << "\t";
+                }file << endl;
+            }
         }
         file<<"***************************"<<endl;
         file<<endl;
@@ -1014,10 +1718,33 @@ bool DTW::loadModelFromFile( string fileName ){
 }
 
 bool DTW::loadModelFromFile( fstream &file ){
+    return loadModelData( file, NULL, 0 );
+}
+
+bool DTW::loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName){
+    
+    if( !file.beginTextSection( sectionName ) ){
+        errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - Failed to find section: " << sectionName << endl;
+        return false;
+    }
+    
+    if( !file.getHasSection( sectionName + "/TimeSeries" ) ){
+        errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - Failed to find the template time series!" << endl;
+        return false;
+    }
+    
+    UINT numTimeSeriesValues = 0;
+    const double *timeSeriesData = file.getSectionArray< double >( sectionName + "/TimeSeries", numTimeSeriesValues );
+    
+    return loadModelData( file.getTextStream(), timeSeriesData, numTimeSeriesValues );
+}
+
+bool DTW::loadModelData( fstream &file, const double *timeSeriesData, const UINT numTimeSeriesValues ){
     
     std::string word;
     UINT timeSeriesLength;
     UINT ts;
+    UINT timeSeriesOffset = 0;
     
     if(!file.is_open())
     {
@@ -1246,9 +1973,22 @@ bool DTW::loadModelFromFile( fstream &file ){
             errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find template timeseries!" << endl;
             return false;
         }
-        for(UINT k=0; k<timeSeriesLength; k++)
-            for(UINT j=0; j<numInputDimensions; j++)
-                file >> templatesBuffer[i].timeSeries[k][j];
+        if( timeSeriesData != NULL ){
+            //The time series was saved in the binary section, after the time series of the previous templates
+            const UINT numValues = timeSeriesLength*numInputDimensions;
+            if( numValues > numTimeSeriesValues - timeSeriesOffset ){
+                numTemplates=0;
+                trained = false;
+                errorLog << "loadDTWModelFromFile( string fileName ) - The template timeseries are larger than the binary section!" << endl;
+                return false;
+            }
+            if( numValues > 0 ) memcpy( templatesBuffer[i].timeSeries[0], timeSeriesData + timeSeriesOffset, numValues*sizeof(double) );
+            timeSeriesOffset += numValues;
+        }else{
+            for(UINT k=0; k<timeSeriesLength; k++)
+                for(UINT j=0; j<numInputDimensions; j++)
+                    file >> templatesBuffer[i].timeSeries[k][j];
+        }
         
         //Check for the footer
         file >> word;
@@ -1262,6 +2002,13 @@ bool DTW::loadModelFromFile( fstream &file ){
         }
     }
     
+    if( timeSeriesData != NULL && timeSeriesOffset != numTimeSeriesValues ){
+        numTemplates=0;
+        trained = false;
+        errorLog << "loadDTWModelFromFile( string fileName ) - The template timeseries do not match the binary section!" << endl;
+        return false;
+    }
+    
     //Resize the prediction results to make sure it is setup for realtime prediction
     continuousInputDataBuffer.clear();
     continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numInputDimensions,0));
@@ -1270,8 +2017,17 @@ bool DTW::loadModelFromFile( fstream &file ){
     classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
     classDistances.resize(numClasses,DEFAULT_NULL_DISTANCE_VALUE);
     
+    //Precompute the warping bands used by the banded search
+    buildTemplateBounds();
+    
+    //Setup the streaming search for the new templates
+    resetStreamingState();
+    
     trained = true;
     
+    //Build the float copy of the templates if float prediction is enabled
+    updateFloatModel();
+    
     return true;
 }
 bool DTW::setRejectionMode(UINT rejectionMode){
@@ -1297,6 +2053,29 @@ bool DTW::setWarpingRadius(double radius){
     return true;
 }
 
+bool DTW::enableFastPrediction(bool useFastPrediction){
+    //The standard search is the banded search, so this flag no longer changes the prediction
+    this->useFastPrediction = useFastPrediction;
+    return true;
+}
+
+bool DTW::enableStreamingPrediction(bool useStreamingPrediction){
+    this->useStreamingPrediction = useStreamingPrediction;
+    return resetStreamingState();
+}
+
+bool DTW::setNumThreads(const UINT numThreads){
+    
+    if( numThreads == 0 ){
+        errorLog << "setNumThreads(const UINT numThreads) - The number of threads must be greater than zero!" << endl;
+        return false;
+    }
+    
+    this->numThreads = numThreads;
+    
+    return true;
+}
+
 bool DTW::enableZNormalization(bool useZNormalisation,bool constrainZNorm){ 
 	this->useZNormalisation = useZNormalisation; 
 	this->constrainZNorm = constrainZNorm;
@@ -69,6 +69,7 @@ DecisionTree& DecisionTree::operator=(const DecisionTree &rhs){
         if( rhs.getTrained() ){
             //Deep copy the decision tree
             decisionTree = (DecisionTreeNode*)rhs.deepCopyTree();
+            flatTree = rhs.flatTree;
         }
         
         this->numSplittingSteps = rhs.numSplittingSteps;
@@ -97,6 +98,7 @@ bool DecisionTree::deepCopyFrom(const Classifier *classifier){
         if( ptr->getTrained() ){
             //Deep copy the decision tree
             this->decisionTree = ptr->deepCopyTree();
+            this->flatTree = ptr->flatTree;
         }
         
         this->numSplittingSteps = ptr->numSplittingSteps;
@@ -113,6 +115,30 @@ bool DecisionTree::deepCopyFrom(const Classifier *classifier){
 
 bool DecisionTree::train(LabelledClassificationData trainingData){
     
+    //The ranges are computed before the training data is scaled
+    const vector< MinMax > ranges = trainingData.getRanges();
+    
+    //Scale the training data if needed
+    if( useScaling ){
+        //Scale the training data between 0 and 1
+        trainingData.scale(0, 1);
+    }
+    
+    return trainTree( LabelledClassificationDataView( trainingData ), ranges );
+}
+    
+bool DecisionTree::train(const LabelledClassificationDataView &trainingData){
+    
+    //The samples of a view can not be scaled in place, so scaled training data is copied and scaled by the other train function
+    if( useScaling ){
+        return train( trainingData.getLabelledClassificationData() );
+    }
+    
+    return trainTree( trainingData, trainingData.getRanges() );
+}
+    
+bool DecisionTree::trainTree(const LabelledClassificationDataView &trainingData,const vector< MinMax > &ranges){
+    
     const unsigned int M = trainingData.getNumSamples();
     const unsigned int N = trainingData.getNumDimensions();
     const unsigned int K = trainingData.getNumClasses();
@@ -121,20 +147,14 @@ bool DecisionTree::train(LabelledClassificationData trainingData){
     clear();
     
     if( M == 0 ){
-        errorLog << "train(LabelledClassificationData labelledTrainingData) - Training data has zero samples!" << endl;
+        errorLog << "trainTree(const LabelledClassificationDataView &trainingData,const vector< MinMax > &ranges) - Training data has zero samples!" << endl;
         return false;
     }
     
     numInputDimensions = N;
     numClasses = K;
     classLabels = trainingData.getClassLabels();
-    ranges = trainingData.getRanges();
-    
-    //Scale the training data if needed
-    if( useScaling ){
-        //Scale the training data between 0 and 1
-        trainingData.scale(0, 1);
-    }
+    this->ranges = ranges;
     
     vector< UINT > features(N);
     for(UINT i=0; i<N; i++){
@@ -148,12 +168,29 @@ bool DecisionTree::train(LabelledClassificationData trainingData){
         return false;
     }
     
+    //Compile the tree into the flat form that is used for prediction
+    if( !flatTree.init( N, K ) || !flatTree.addTree( decisionTree ) ){
+        clear();
+        errorLog << "trainTree(const LabelledClassificationDataView &trainingData,const vector< MinMax > &ranges) - Failed to compile the flat tree!" << endl;
+        return false;
+    }
+    
     //Flag that the algorithm has been trained
     trained = true;
+    
+    //Check the flat tree can be used for float prediction if it is enabled
+    updateFloatModel();
+    
     return trained;
 }
 
 bool DecisionTree::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool DecisionTree::predictInplace(VectorDouble &inputVector){
+    
+    if( useFloatPrediction ) return predictAsFloat( inputVector );
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
@@ -184,10 +221,61 @@ bool DecisionTree::predict(VectorDouble inputVector){
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
     if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
     
-    if( !decisionTree->predict( inputVector, classLikelihoods ) ){
+    //Walk the flat tree, this gives the same result as decisionTree->predict( inputVector, classLikelihoods )
+    const double *y = flatTree.predictTree( 0, &inputVector[0] );
+    if( y == NULL ){
         errorLog << "predict(VectorDouble inputVector) - Failed to predict!" << endl;
         return false;
     }
+    std::copy( y, y+numClasses, classLikelihoods.begin() );
+    
+    predictFromClassLikelihoods();
+    
+    return true;
+}
+
+bool DecisionTree::predictFloatInplace(VectorFloat &inputVector){
+    
+    if( !trained ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - Model Not Trained!" << endl;
+        return false;
+    }
+    
+    predictedClassLabel = 0;
+	maxLikelihood = -10000;
+    
+	if( inputVector.size() != numInputDimensions ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The size of the input vector (" << inputVector.size() << ") does not match the num features in the model (" << numInputDimensions << endl;
+		return false;
+	}
+    
+    if( flatTree.getNumTrees() != 1 ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The flat tree has not been built!" << endl;
+        return false;
+    }
+    
+    if( useScaling ){
+        for(UINT n=0; n<numInputDimensions; n++){
+            inputVector[n] = float( scale(inputVector[n], ranges[n].minValue, ranges[n].maxValue, 0, 1) );
+        }
+    }
+    
+    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
+    if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
+    
+    const double *y = flatTree.predictTree( 0, &inputVector[0] );
+    if( y == NULL ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - Failed to predict!" << endl;
+        return false;
+    }
+    std::copy( y, y+numClasses, classLikelihoods.begin() );
+    
+    predictFromClassLikelihoods();
+    
+    return true;
+}
+
+void DecisionTree::predictFromClassLikelihoods(){
     
     UINT K = (UINT)classLikelihoods.size();
     UINT maxIndex = 0;
@@ -200,6 +288,53 @@ bool DecisionTree::predict(VectorDouble inputVector){
     }
     
     predictedClassLabel = classLabels[ maxIndex ];
+}
+
+bool DecisionTree::buildFloatModel(){
+    //The flat tree always stores the float thresholds, so there is nothing else to build
+    return flatTree.getNumTrees() == 1;
+}
+    
+bool DecisionTree::predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances){
+    
+    //The float prediction path classifies each row on its own
+    if( useFloatPrediction ) return Classifier::predictBatch(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    
+    if( !initBatchPrediction(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances) ) return false;
+    
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ) return true;
+    
+    //Scale the input data if needed
+    const MatrixDouble *data = &inputData;
+    MatrixDouble scaledData;
+    if( useScaling ){
+        if( !scaleBatch(inputData,scaledData,0,1) ) return false;
+        data = &scaledData;
+    }
+    
+    //Find the leaf of every row, with a single tree the sums are just the class probabilities of the leaf
+    if( !flatTree.predictBatch( *data, predictedClassLikelihoods ) ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances) - Failed to predict!" << endl;
+        return false;
+    }
+    
+    //Compute the predicted class label for each row, this matches the predict function
+    for(UINT i=0; i<M; i++){
+        const double *y = predictedClassLikelihoods[i];
+        UINT maxIndex = 0;
+        maxLikelihood = 0;
+        for(UINT k=0; k<numClasses; k++){
+            classLikelihoods[k] = y[k];
+            if( classLikelihoods[k] > maxLikelihood ){
+                maxLikelihood = classLikelihoods[k];
+                maxIndex = k;
+            }
+        }
+        predictedClassLabel = classLabels[ maxIndex ];
+        
+        storeBatchPrediction(i,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    }
     
     return true;
 }
@@ -214,6 +349,7 @@ bool DecisionTree::clear(){
         delete decisionTree;
         decisionTree = NULL;
     }
+    flatTree.clear();
     
     return true;
 }
@@ -249,9 +385,15 @@ bool DecisionTree::saveModelToFile(fstream &file) const{
 	}
     
 	//Write the header info
-	file << "GRT_DECISION_TREE_MODEL_FILE_V1.0\n";
+	file << "GRT_DECISION_TREE_MODEL_FILE_V2.0\n";
     file << "NumFeatures: " << numInputDimensions << endl;
 	file << "NumClasses: "<<numClasses<<endl;
+    file << "ClassLabels: ";
+    for(UINT k=0; k<classLabels.size(); k++){
+        file << classLabels[k];
+        if( k < classLabels.size()-1 ) file << "\t";
+    }
+    file << endl;
     file << "UseScaling: " << useScaling << endl;
     file << "UseNullRejection: " << useNullRejection << endl;
 	
@@ -272,7 +414,7 @@ bool DecisionTree::saveModelToFile(fstream &file) const{
     
     if( decisionTree != NULL ){
         file << "Tree:\n";
-        if( !decisionTree->saveToFile( file ) ){
+        if( !flatTree.saveToFile( file ) ){
             errorLog << "saveModelToFile(fstream &file) - Failed to save tree to file!" << endl;
             return false;
         }
@@ -314,11 +456,14 @@ bool DecisionTree::loadModelFromFile(fstream &file){
     
     //Find the file type header
     file >> word;
-    if(word != "GRT_DECISION_TREE_MODEL_FILE_V1.0"){
+    if(word != "GRT_DECISION_TREE_MODEL_FILE_V1.0" && word != "GRT_DECISION_TREE_MODEL_FILE_V2.0"){
         errorLog << "loadModelFromFile(string filename) - Could not find Model File Header" << endl;
         return false;
     }
     
+    //V2.0 files store the class labels and the flat tree, V1.0 files store the tree node by node
+    const bool hasFlatTree = word == "GRT_DECISION_TREE_MODEL_FILE_V2.0";
+    
     file >> word;
     if(word != "NumFeatures:"){
         errorLog << "loadModelFromFile(string filename) - Could not find NumFeatures!" << endl;
@@ -333,6 +478,23 @@ bool DecisionTree::loadModelFromFile(fstream &file){
     }
     file >> numClasses;
     
+    classLabels.resize( numClasses );
+    if( hasFlatTree ){
+        file >> word;
+        if(word != "ClassLabels:"){
+            errorLog << "loadModelFromFile(string filename) - Could not find ClassLabels!" << endl;
+            return false;
+        }
+        for(UINT k=0; k<numClasses; k++){
+            file >> classLabels[k];
+        }
+    }else{
+        warningLog << "loadModelFromFile(string filename) - The model file does not contain the class labels, they will be set to 1 to " << numClasses << endl;
+        for(UINT k=0; k<numClasses; k++){
+            classLabels[k] = k+1;
+        }
+    }
+    
     file >> word;
     if(word != "UseScaling:"){
         errorLog << "loadModelFromFile(string filename) - Could not find UseScaling!" << endl;
@@ -405,7 +567,34 @@ bool DecisionTree::loadModelFromFile(fstream &file){
     }
     file >> trained;
     
-    if( trained ){
+    if( trained && hasFlatTree ){
+        file >> word;
+        if(word != "Tree:"){
+            errorLog << "loadModelFromFile(string filename) - Could not find the Tree!" << endl;
+            return false;
+        }
+        
+        if( !flatTree.loadFromFile( file ) ){
+            clear();
+            errorLog << "loadModelFromFile(fstream &file) - Failed to load the flat tree from file!" << endl;
+            return false;
+        }
+        
+        if( flatTree.getNumTrees() != 1 || flatTree.getNumInputDimensions() != numInputDimensions || flatTree.getNumClasses() != numClasses ){
+            clear();
+            errorLog << "loadModelFromFile(fstream &file) - The flat tree does not match the model!" << endl;
+            return false;
+        }
+        
+        //Rebuild the node tree so it can still be accessed through getTree
+        decisionTree = flatTree.buildTree( 0 );
+        
+        if( decisionTree == NULL ){
+            clear();
+            errorLog << "loadModelFromFile(fstream &file) - Failed to rebuild the tree!" << endl;
+            return false;
+        }
+    }else if( trained ){
         file >> word;
         if(word != "Tree:"){
             errorLog << "loadModelFromFile(string filename) - Could not find the Tree!" << endl;
@@ -427,8 +616,18 @@ bool DecisionTree::loadModelFromFile(fstream &file){
             errorLog << "loadModelFromFile(fstream &file) - Failed to load tree from file!" << endl;
             return false;
         }
+        
+        //Compile the flat tree that is used for prediction
+        if( !flatTree.init( numInputDimensions, numClasses ) || !flatTree.addTree( decisionTree ) ){
+            clear();
+            errorLog << "loadModelFromFile(fstream &file) - Failed to compile the flat tree!" << endl;
+            return false;
+        }
     }
     
+    //Check the flat tree can be used for float prediction if it is enabled
+    updateFloatModel();
+    
     return true;
 }
     
@@ -445,6 +644,10 @@ const DecisionTreeNode* DecisionTree::getTree() const{
     return decisionTree;
 }
     
+const FlatDecisionForest& DecisionTree::getFlatTree() const{
+    return flatTree;
+}
+    
 UINT DecisionTree::getTrainingMode() const{
     return trainingMode;
 }
@@ -503,10 +706,9 @@ bool DecisionTree::setRemoveFeaturesAtEachSpilt(const bool removeFeaturesAtEachS
     return true;
 }
     
-DecisionTreeNode* DecisionTree::buildTree(const LabelledClassificationData &trainingData,DecisionTreeNode *parent,vector< UINT > features,const vector< UINT > &classLabels){
+DecisionTreeNode* DecisionTree::buildTree(const LabelledClassificationDataView &trainingData,DecisionTreeNode *parent,vector< UINT > features,const vector< UINT > &classLabels){
     
     const UINT M = trainingData.getNumSamples();
-    const UINT N = trainingData.getNumDimensions();
     
     //Get the depth
     UINT depth = 0;
@@ -555,24 +757,25 @@ DecisionTreeNode* DecisionTree::buildTree(const LabelledClassificationData &trai
         features.erase( features.begin()+featureIndex );
     }
     
-    //Split the data
-    LabelledClassificationData lhs(N);
-    LabelledClassificationData rhs(N);
+    //Split the data, the children are views of the same dataset so only the indexs of the samples are copied
+    const vector< UINT > &indexs = trainingData.getIndexs();
+    vector< UINT > lhs;
+    vector< UINT > rhs;
     
     for(UINT i=0; i<M; i++){
         if( node->predict( trainingData[i].getSample() ) ){
-            rhs.addSample(trainingData[i].getClassLabel(), trainingData[i].getSample());
-        }else lhs.addSample(trainingData[i].getClassLabel(), trainingData[i].getSample());
+            rhs.push_back( indexs[i] );
+        }else lhs.push_back( indexs[i] );
     }
     
     //Run the recursive tree building on the children
-    node->setLeftChild( buildTree( lhs, node, features, classLabels ) );
-    node->setRightChild( buildTree( rhs, node, features, classLabels ) );
+    node->setLeftChild( buildTree( LabelledClassificationDataView( *trainingData.getDataset(), lhs ), node, features, classLabels ) );
+    node->setRightChild( buildTree( LabelledClassificationDataView( *trainingData.getDataset(), rhs ), node, features, classLabels ) );
     
     return node;
 }
     
-bool DecisionTree::computeBestSpilt( const LabelledClassificationData &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold ){
+bool DecisionTree::computeBestSpilt( const LabelledClassificationDataView &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold ){
     
     switch( trainingMode ){
         case BEST_ITERATIVE_SPILT:
@@ -590,7 +793,7 @@ bool DecisionTree::computeBestSpilt( const LabelledClassificationData &trainingD
     return true;
 }
     
-bool DecisionTree::computeBestSpiltBestIterativeSpilt( const LabelledClassificationData &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold ){
+bool DecisionTree::computeBestSpiltBestIterativeSpilt( const LabelledClassificationDataView &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold ){
     
     const UINT M = trainingData.getNumSamples();
     const UINT N = (UINT)features.size();
@@ -616,8 +819,17 @@ bool DecisionTree::computeBestSpiltBestIterativeSpilt( const LabelledClassificat
     
     MatrixDouble classProbabilities(K,2);
     
+    //The class index of each sample is found once, and each feature is copied into a buffer before its thresholds are tested, so the
+    //thresholds are tested against contiguous values rather than against the rows of the dataset the view points at
+    vector< UINT > classIndexs(M);
+    VectorDouble featureValues(M);
+    for(UINT i=0; i<M; i++){
+        classIndexs[i] = getClassLabelIndexValue( trainingData[i].getClassLabel() );
+    }
+    
     //Loop over each feature and try and find the best split point
     for(UINT n=0; n<N; n++){
+        for(UINT i=0; i<M; i++) featureValues[i] = trainingData[i][ features[n] ];
         minRange = ranges[n].minValue;
         maxRange = ranges[n].maxValue;
         step = (maxRange-minRange)/double(numSplittingSteps);
@@ -628,9 +840,9 @@ bool DecisionTree::computeBestSpiltBestIterativeSpilt( const LabelledClassificat
             groupCounter[0] = groupCounter[1] = 0;
             classProbabilities.setAllValues(0);
             for(UINT i=0; i<M; i++){
-                groupIndex[i] = trainingData[ i ][ features[n] ] >= threshold ? 1 : 0;
+                groupIndex[i] = featureValues[i] >= threshold ? 1 : 0;
                 groupCounter[ groupIndex[i] ]++;
-                classProbabilities[ getClassLabelIndexValue(trainingData[i].getClassLabel()) ][ groupIndex[i] ]++;
+                classProbabilities[ classIndexs[i] ][ groupIndex[i] ]++;
             }
             
             //Compute the class probabilities for the lhs group and rhs group
@@ -668,7 +880,7 @@ bool DecisionTree::computeBestSpiltBestIterativeSpilt( const LabelledClassificat
     return true;
 }
     
-bool DecisionTree::computeBestSpiltBestRandomSpilt( const LabelledClassificationData &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold ){
+bool DecisionTree::computeBestSpiltBestRandomSpilt( const LabelledClassificationDataView &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold ){
     
     const UINT M = trainingData.getNumSamples();
     const UINT N = (UINT)features.size();
@@ -691,8 +903,17 @@ bool DecisionTree::computeBestSpiltBestRandomSpilt( const LabelledClassification
     
     MatrixDouble classProbabilities(K,2);
     
+    //The class index of each sample is found once, and each feature is copied into a buffer before its thresholds are tested, so the
+    //thresholds are tested against contiguous values rather than against the rows of the dataset the view points at
+    vector< UINT > classIndexs(M);
+    VectorDouble featureValues(M);
+    for(UINT i=0; i<M; i++){
+        classIndexs[i] = getClassLabelIndexValue( trainingData[i].getClassLabel() );
+    }
+    
     //Loop over each feature and try and find the best split point
     for(UINT n=0; n<N; n++){
+        for(UINT i=0; i<M; i++) featureValues[i] = trainingData[i][ features[n] ];
         for(UINT m=0; m<numSplittingSteps; m++){
             //Randomly choose the threshold
             threshold = rand.getRandomNumberUniform(ranges[n].minValue,ranges[n].maxValue);
@@ -701,9 +922,9 @@ bool DecisionTree::computeBestSpiltBestRandomSpilt( const LabelledClassification
             groupCounter[0] = groupCounter[1] = 0;
             classProbabilities.setAllValues(0);
             for(UINT i=0; i<M; i++){
-                groupIndex[i] = trainingData[ i ][ features[n] ] >= threshold ? 1 : 0;
+                groupIndex[i] = featureValues[i] >= threshold ? 1 : 0;
                 groupCounter[ groupIndex[i] ]++;
-                classProbabilities[ getClassLabelIndexValue(trainingData[i].getClassLabel()) ][ groupIndex[i] ]++;
+                classProbabilities[ classIndexs[i] ][ groupIndex[i] ]++;
             }
             
             //Compute the class probabilities for the lhs group and rhs group
@@ -738,7 +959,7 @@ bool DecisionTree::computeBestSpiltBestRandomSpilt( const LabelledClassification
     return true;
 }
     
-VectorDouble DecisionTree::getClassProbabilities( const LabelledClassificationData &trainingData, const vector< UINT > &classLabels ){
+VectorDouble DecisionTree::getClassProbabilities( const LabelledClassificationDataView &trainingData, const vector< UINT > &classLabels ){
     const UINT K = (UINT)classLabels.size();
     const UINT N = (UINT)trainingData.getNumClasses();
     const double M = (double)trainingData.getNumSamples();
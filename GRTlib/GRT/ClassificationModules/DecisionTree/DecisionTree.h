@@ -35,6 +35,7 @@
 
 #include "../../CoreModules/Classifier.h"
 #include "DecisionTreeNode.h"
+#include "FlatDecisionForest.h"
 
 namespace GRT{
 
@@ -91,6 +92,16 @@ public:
     */
     virtual bool train(LabelledClassificationData trainingData);
     
+    /**
+     This trains the DecisionTree model, using a view of the labelled classification data.  The tree is built from the indexs of the samples
+     of the view, so the samples are not copied unless the training data needs to be scaled.
+     This overrides the train function in the MLBase class.
+     
+     @param const LabelledClassificationDataView &trainingData: a reference to a view of the training data
+     @return returns true if the DecisionTree model was trained, false otherwise
+    */
+    virtual bool train(const LabelledClassificationDataView &trainingData);
+    
     /**
      This predicts the class of the inputVector.
      This overrides the predict function in the Classifier base class.
@@ -100,6 +111,44 @@ public:
     */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
+    /**
+     This predicts the class of the inputVector by walking the flat tree with its float thresholds.
+     This overrides the predictFloatInplace function in the MLBase base class.
+     
+     @param VectorFloat &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictFloatInplace(VectorFloat &inputVector);
+    
+    /**
+     The DecisionTree algorithm supports the float prediction path.
+     
+     @return returns true
+     */
+    virtual bool getSupportsFloatPrediction() const{ return true; }
+    
+    /**
+     This classifies each row of the inputData, using the flat copy of the tree.
+     This overrides the predictBatch function in the Classifier base class.
+     
+     @param const MatrixDouble &inputData: the data to classify, each row is one sample
+     @param vector< UINT > &predictedClassLabels: will be filled with the predicted class label of each row
+     @param MatrixDouble &predictedClassLikelihoods: will be filled with the class likelihoods of each row
+     @param MatrixDouble &predictedClassDistances: will be filled with the class distances of each row
+     @return returns true if the batch was classified, false otherwise
+     */
+    virtual bool predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances);
+    
     /**
      This overrides the clear function in the Classifier base class.
      It will completely clear the ML module, removing any trained model and setting all the base variables to their default values.
@@ -125,7 +174,7 @@ public:
     virtual bool saveModelToFile(string filename) const;
     
     /**
-     This saves the trained DecisionTree model to a file.
+     This saves the trained DecisionTree model to a file.  The tree is saved in its flat form, one line per node.
      This overrides the saveModelToFile function in the Classifier base class.
      
      @param fstream &file: a reference to the file the DecisionTree model will be saved to
@@ -143,7 +192,8 @@ public:
     virtual bool loadModelFromFile(string filename);
     
     /**
-     This loads a trained DecisionTree model from a file.
+     This loads a trained DecisionTree model from a file.  Files saved with the older node by node format can still be loaded,
+     the class labels are not stored in those files so they will be set to 1 to K.
      This overrides the loadModelFromFile function in the Classifier base class.
      
      @param fstream &file: a reference to the file the DecisionTree model will be loaded from
@@ -167,6 +217,14 @@ public:
      */
     const DecisionTreeNode* getTree() const;
     
+    /**
+     Gets the flat copy of the decision tree that is used for predictions.  This is compiled from the tree after training and
+     is the form the tree is saved in.  It will be empty if the model has not been trained.
+     
+     @return returns a const reference to the flat tree
+     */
+    const FlatDecisionForest& getFlatTree() const;
+    
     /**
      Gets the current training mode. This will be one of the TrainingModes enums.
      
@@ -264,12 +322,16 @@ private:
     UINT maxDepth;
     bool removeFeaturesAtEachSpilt;
     DecisionTreeNode *decisionTree;
+    FlatDecisionForest flatTree;
     
-    DecisionTreeNode* buildTree( const LabelledClassificationData &trainingData, DecisionTreeNode *parent, vector< UINT > features, const vector< UINT > &classLabels );
-    bool computeBestSpilt( const LabelledClassificationData &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold );
-    bool computeBestSpiltBestIterativeSpilt( const LabelledClassificationData &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold );
-    bool computeBestSpiltBestRandomSpilt( const LabelledClassificationData &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold );
-    VectorDouble getClassProbabilities( const LabelledClassificationData &trainingData, const vector< UINT > &classLabels );
+    bool trainTree( const LabelledClassificationDataView &trainingData, const vector< MinMax > &ranges );
+    DecisionTreeNode* buildTree( const LabelledClassificationDataView &trainingData, DecisionTreeNode *parent, vector< UINT > features, const vector< UINT > &classLabels );
+    bool computeBestSpilt( const LabelledClassificationDataView &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold );
+    bool computeBestSpiltBestIterativeSpilt( const LabelledClassificationDataView &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold );
+    bool computeBestSpiltBestRandomSpilt( const LabelledClassificationDataView &trainingData, const vector< UINT > &features, const vector< UINT > &classLabels, UINT &featureIndex, double &threshold );
+    VectorDouble getClassProbabilities( const LabelledClassificationDataView &trainingData, const vector< UINT > &classLabels );
+    void predictFromClassLikelihoods();
+    virtual bool buildFloatModel();
     
     
     static RegisterClassifierModule< DecisionTree > registerModule;
@@ -0,0 +1,590 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FlatDecisionForest.h"
+
+namespace GRT{
+
+FlatDecisionForest::FlatDecisionForest(){
+    numInputDimensions = 0;
+    numClasses = 0;
+    updateDataPointers();
+    debugLog.setProceedingText("[DEBUG FlatDecisionForest]");
+    errorLog.setProceedingText("[ERROR FlatDecisionForest]");
+    warningLog.setProceedingText("[WARNING FlatDecisionForest]");
+}
+
+FlatDecisionForest::FlatDecisionForest(const FlatDecisionForest &rhs){
+    debugLog.setProceedingText("[DEBUG FlatDecisionForest]");
+    errorLog.setProceedingText("[ERROR FlatDecisionForest]");
+    warningLog.setProceedingText("[WARNING FlatDecisionForest]");
+    *this = rhs;
+}
+
+FlatDecisionForest::~FlatDecisionForest(){
+}
+
+FlatDecisionForest& FlatDecisionForest::operator=(const FlatDecisionForest &rhs){
+    if( this != &rhs ){
+        this->numInputDimensions = rhs.numInputDimensions;
+        this->numClasses = rhs.numClasses;
+        this->treeRoots = rhs.treeRoots;
+        this->nodes = rhs.nodes;
+        this->floatThresholds = rhs.floatThresholds;
+        this->nodeSizes = rhs.nodeSizes;
+        this->classProbabilities = rhs.classProbabilities;
+        this->mappedFile = rhs.mappedFile;
+        if( mappedFile.getIsOpen() ){
+            //Share the arrays of the memory mapped file, the copy keeps the file mapped
+            this->numTrees = rhs.numTrees;
+            this->numNodes = rhs.numNodes;
+            this->treeRootData = rhs.treeRootData;
+            this->nodeData = rhs.nodeData;
+            this->floatThresholdData = rhs.floatThresholdData;
+            this->nodeSizeData = rhs.nodeSizeData;
+            this->classProbabilityData = rhs.classProbabilityData;
+        }else updateDataPointers();
+    }
+    return *this;
+}
+
+bool FlatDecisionForest::init(const UINT numInputDimensions,const UINT numClasses){
+
+    clear();
+
+    if( numInputDimensions == 0 || numClasses == 0 ){
+        errorLog << "init(const UINT numInputDimensions,const UINT numClasses) - The number of input dimensions and classes must both be greater than zero!" << endl;
+        return false;
+    }
+
+    this->numInputDimensions = numInputDimensions;
+    this->numClasses = numClasses;
+
+    return true;
+}
+
+bool FlatDecisionForest::clear(){
+    numInputDimensions = 0;
+    numClasses = 0;
+    treeRoots.clear();
+    nodes.clear();
+    floatThresholds.clear();
+    nodeSizes.clear();
+    classProbabilities.clear();
+    mappedFile.close();
+    updateDataPointers();
+    return true;
+}
+
+bool FlatDecisionForest::addTree(const DecisionTreeNode *tree){
+
+    if( tree == NULL ){
+        errorLog << "addTree(const DecisionTreeNode *tree) - The tree pointer is NULL!" << endl;
+        return false;
+    }
+
+    if( numClasses == 0 ){
+        errorLog << "addTree(const DecisionTreeNode *tree) - The forest has not been initialized!" << endl;
+        return false;
+    }
+
+    //The arrays of a memory mapped file can not be changed, so take a copy of them first
+    if( mappedFile.getIsOpen() ) copyMappedData();
+
+    //Add the nodes in depth first order, if anything goes wrong then remove any nodes that were added for this tree
+    const UINT treeStart = (UINT)nodes.size();
+    UINT rootIndex = 0;
+    if( !addNode( tree, rootIndex ) ){
+        nodes.resize( treeStart );
+        floatThresholds.resize( treeStart );
+        nodeSizes.resize( treeStart );
+        classProbabilities.resize( treeStart*numClasses );
+        updateDataPointers();
+        errorLog << "addTree(const DecisionTreeNode *tree) - Failed to add tree!" << endl;
+        return false;
+    }
+
+    treeRoots.push_back( rootIndex );
+    updateDataPointers();
+
+    return true;
+}
+
+DecisionTreeNode* FlatDecisionForest::buildTree(const UINT treeIndex) const{
+
+    if( treeIndex >= numTrees ){
+        errorLog << "buildTree(const UINT treeIndex) - The treeIndex is out of bounds!" << endl;
+        return NULL;
+    }
+
+    return buildNode( treeRootData[ treeIndex ], NULL, 0 );
+}
+
+const double* FlatDecisionForest::predictTree(const UINT treeIndex,const double *x) const{
+
+    //This gives the same result as DecisionTreeNode::predict, including a failed prediction if the input reaches a missing child
+    const FlatDecisionForestNode *flatNodes = nodeData;
+    const FlatDecisionForestNode *node = flatNodes + treeRootData[ treeIndex ];
+    while( !node->isLeafNode ){
+        const UINT childIndex = x[ node->featureIndex ] >= node->threshold ? node->rightChild : node->leftChild;
+        if( childIndex == 0 ) return NULL;
+        node = flatNodes + childIndex;
+    }
+
+    return classProbabilityData + (node-flatNodes)*numClasses;
+}
+
+const double* FlatDecisionForest::predictTree(const UINT treeIndex,const float *x) const{
+
+    //The float thresholds are rounded up, so x >= floatThreshold gives the same branch as double(x) >= threshold
+    const FlatDecisionForestNode *flatNodes = nodeData;
+    const float *thresholds = floatThresholdData;
+    UINT nodeIndex = treeRootData[ treeIndex ];
+    while( !flatNodes[ nodeIndex ].isLeafNode ){
+        const FlatDecisionForestNode &node = flatNodes[ nodeIndex ];
+        nodeIndex = x[ node.featureIndex ] >= thresholds[ nodeIndex ] ? node.rightChild : node.leftChild;
+        if( nodeIndex == 0 ) return NULL;
+    }
+
+    return classProbabilityData + nodeIndex*numClasses;
+}
+
+bool FlatDecisionForest::predict(const double *x,double *classSums) const{
+
+    for(UINT k=0; k<numClasses; k++){
+        classSums[k] = 0;
+    }
+
+    for(UINT i=0; i<numTrees; i++){
+        const double *y = predictTree( i, x );
+        if( y == NULL ) return false;
+
+        for(UINT k=0; k<numClasses; k++){
+            classSums[k] += y[k];
+        }
+    }
+
+    return true;
+}
+
+bool FlatDecisionForest::predict(const float *x,double *classSums) const{
+
+    for(UINT k=0; k<numClasses; k++){
+        classSums[k] = 0;
+    }
+
+    for(UINT i=0; i<numTrees; i++){
+        const double *y = predictTree( i, x );
+        if( y == NULL ) return false;
+
+        for(UINT k=0; k<numClasses; k++){
+            classSums[k] += y[k];
+        }
+    }
+
+    return true;
+}
+
+bool FlatDecisionForest::predictBatch(const MatrixDouble &inputData,MatrixDouble &classSums) const{
+
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,MatrixDouble &classSums) - The number of columns in the input data does not match the number of input dimensions!" << endl;
+        return false;
+    }
+
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ){
+        classSums.clear();
+        return true;
+    }
+
+    if( classSums.getNumRows() != M || classSums.getNumCols() != numClasses ) classSums.resize( M, numClasses );
+
+    //Push each block of rows through one tree at a time, so the top of each tree stays in the cache while it is used by the block.
+    //Each row still adds the trees in order, so the sums match the predict function exactly.
+    for(UINT blockStart=0; blockStart<M; blockStart+=FLAT_DECISION_FOREST_BATCH_SIZE){
+        const UINT blockEnd = blockStart+FLAT_DECISION_FOREST_BATCH_SIZE < M ? blockStart+FLAT_DECISION_FOREST_BATCH_SIZE : M;
+
+        for(UINT i=blockStart; i<blockEnd; i++){
+            double *sums = classSums[i];
+            for(UINT k=0; k<numClasses; k++){
+                sums[k] = 0;
+            }
+        }
+
+        for(UINT j=0; j<numTrees; j++){
+            for(UINT i=blockStart; i<blockEnd; i++){
+                const double *y = predictTree( j, inputData[i] );
+                if( y == NULL ) return false;
+
+                double *sums = classSums[i];
+                for(UINT k=0; k<numClasses; k++){
+                    sums[k] += y[k];
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool FlatDecisionForest::saveToFile(fstream &file) const{
+
+    if(!file.is_open())
+    {
+        errorLog << "saveToFile(fstream &file) - File is not open!" << endl;
+        return false;
+    }
+
+    file << "NumInputDimensions: " << numInputDimensions << endl;
+    file << "NumClasses: " << numClasses << endl;
+    file << "NumTrees: " << numTrees << endl;
+    file << "NumNodes: " << numNodes << endl;
+
+    file << "TreeRoots: ";
+    for(UINT i=0; i<numTrees; i++){
+        file << treeRootData[i];
+        if( i < numTrees-1 ) file << "\t";
+    }
+    file << endl;
+
+    //Each node is written on one line: IsLeafNode FeatureIndex Threshold LeftChild RightChild NodeSize ClassProbabilities
+    file << "Nodes:\n";
+    for(UINT i=0; i<numNodes; i++){
+        file << nodeData[i].isLeafNode << "\t" << nodeData[i].featureIndex << "\t" << nodeData[i].threshold << "\t";
+        file << nodeData[i].leftChild << "\t" << nodeData[i].rightChild << "\t" << nodeSizeData[i];
+        for(UINT k=0; k<numClasses; k++){
+            file << "\t" << classProbabilityData[ i*numClasses + k ];
+        }
+        file << endl;
+    }
+
+    return true;
+}
+
+bool FlatDecisionForest::loadFromFile(fstream &file){
+
+    clear();
+
+    if(!file.is_open())
+    {
+        errorLog << "loadFromFile(fstream &file) - File is not open!" << endl;
+        return false;
+    }
+
+    string word;
+    UINT numTreesInFile = 0;
+    UINT numNodesInFile = 0;
+
+    file >> word;
+    if( word != "NumInputDimensions:" ){
+        errorLog << "loadFromFile(fstream &file) - Failed to find NumInputDimensions header!" << endl;
+        return false;
+    }
+    file >> numInputDimensions;
+
+    file >> word;
+    if( word != "NumClasses:" ){
+        errorLog << "loadFromFile(fstream &file) - Failed to find NumClasses header!" << endl;
+        clear();
+        return false;
+    }
+    file >> numClasses;
+
+    file >> word;
+    if( word != "NumTrees:" ){
+        errorLog << "loadFromFile(fstream &file) - Failed to find NumTrees header!" << endl;
+        clear();
+        return false;
+    }
+    file >> numTreesInFile;
+
+    file >> word;
+    if( word != "NumNodes:" ){
+        errorLog << "loadFromFile(fstream &file) - Failed to find NumNodes header!" << endl;
+        clear();
+        return false;
+    }
+    file >> numNodesInFile;
+
+    if( numInputDimensions == 0 || numClasses == 0 || numNodesInFile < numTreesInFile || (numTreesInFile == 0 && numNodesInFile > 0) ){
+        errorLog << "loadFromFile(fstream &file) - The forest size is not valid!" << endl;
+        clear();
+        return false;
+    }
+
+    file >> word;
+    if( word != "TreeRoots:" ){
+        errorLog << "loadFromFile(fstream &file) - Failed to find TreeRoots header!" << endl;
+        clear();
+        return false;
+    }
+    treeRoots.resize( numTreesInFile );
+    for(UINT i=0; i<numTreesInFile; i++){
+        file >> treeRoots[i];
+    }
+
+    file >> word;
+    if( word != "Nodes:" ){
+        errorLog << "loadFromFile(fstream &file) - Failed to find Nodes header!" << endl;
+        clear();
+        return false;
+    }
+
+    nodes.resize( numNodesInFile );
+    floatThresholds.resize( numNodesInFile );
+    nodeSizes.resize( numNodesInFile );
+    classProbabilities.resize( numNodesInFile*numClasses );
+    for(UINT i=0; i<numNodesInFile; i++){
+        FlatDecisionForestNode &node = nodes[i];
+        file >> node.isLeafNode;
+        file >> node.featureIndex;
+        file >> node.threshold;
+        floatThresholds[i] = toFloatThreshold( node.threshold );
+        file >> node.leftChild;
+        file >> node.rightChild;
+        file >> nodeSizes[i];
+        for(UINT k=0; k<numClasses; k++){
+            file >> classProbabilities[ i*numClasses + k ];
+        }
+
+        if( file.fail() ){
+            errorLog << "loadFromFile(fstream &file) - Failed to read node " << i << "!" << endl;
+            clear();
+            return false;
+        }
+    }
+    updateDataPointers();
+
+    if( !validateForest() ){
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool FlatDecisionForest::saveToBinaryFile(BinaryModelWriter &file,const string &sectionName) const{
+
+    //The size of a node is stored with the forest, so a file written by a build with a different node layout is rejected when it is loaded
+    const UINT header[5] = {numInputDimensions,numClasses,numTrees,numNodes,(UINT)sizeof(FlatDecisionForestNode)};
+
+    if( !file.writeSection( sectionName + "/Header", header, sizeof(header) ) ||
+        !file.writeSection( sectionName + "/TreeRoots", treeRootData, (unsigned long long)numTrees*sizeof(UINT) ) ||
+        !file.writeSection( sectionName + "/Nodes", nodeData, (unsigned long long)numNodes*sizeof(FlatDecisionForestNode) ) ||
+        !file.writeSection( sectionName + "/FloatThresholds", floatThresholdData, (unsigned long long)numNodes*sizeof(float) ) ||
+        !file.writeSection( sectionName + "/NodeSizes", nodeSizeData, (unsigned long long)numNodes*sizeof(UINT) ) ||
+        !file.writeSection( sectionName + "/ClassProbabilities", classProbabilityData, (unsigned long long)numNodes*numClasses*sizeof(double) ) ){
+        errorLog << "saveToBinaryFile(BinaryModelWriter &file,const string &sectionName) - Failed to write the forest!" << endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool FlatDecisionForest::loadFromBinaryFile(BinaryModelReader &file,const string &sectionName){
+
+    clear();
+
+    UINT headerSize = 0;
+    const UINT *header = file.getSectionArray< UINT >( sectionName + "/Header", headerSize );
+    if( header == NULL || headerSize != 5 ){
+        errorLog << "loadFromBinaryFile(BinaryModelReader &file,const string &sectionName) - Failed to find the forest header!" << endl;
+        return false;
+    }
+
+    if( header[4] != sizeof(FlatDecisionForestNode) ){
+        errorLog << "loadFromBinaryFile(BinaryModelReader &file,const string &sectionName) - The forest was saved with a different node layout!" << endl;
+        return false;
+    }
+
+    const UINT numTreesInFile = header[2];
+    const UINT numNodesInFile = header[3];
+    if( header[0] == 0 || header[1] == 0 || numNodesInFile < numTreesInFile || (numTreesInFile == 0 && numNodesInFile > 0) ){
+        errorLog << "loadFromBinaryFile(BinaryModelReader &file,const string &sectionName) - The forest size is not valid!" << endl;
+        return false;
+    }
+
+    UINT rootsSize = 0, nodesSize = 0, thresholdsSize = 0, nodeSizesSize = 0, probabilitiesSize = 0;
+    const UINT *roots = file.getSectionArray< UINT >( sectionName + "/TreeRoots", rootsSize );
+    const FlatDecisionForestNode *flatNodes = file.getSectionArray< FlatDecisionForestNode >( sectionName + "/Nodes", nodesSize );
+    const float *thresholds = file.getSectionArray< float >( sectionName + "/FloatThresholds", thresholdsSize );
+    const UINT *sizes = file.getSectionArray< UINT >( sectionName + "/NodeSizes", nodeSizesSize );
+    const double *probabilities = file.getSectionArray< double >( sectionName + "/ClassProbabilities", probabilitiesSize );
+    if( rootsSize != numTreesInFile || nodesSize != numNodesInFile || thresholdsSize != numNodesInFile || nodeSizesSize != numNodesInFile ||
+        (unsigned long long)probabilitiesSize != (unsigned long long)numNodesInFile*header[1] ){
+        errorLog << "loadFromBinaryFile(BinaryModelReader &file,const string &sectionName) - The forest arrays do not match the forest size!" << endl;
+        return false;
+    }
+
+    numInputDimensions = header[0];
+    numClasses = header[1];
+
+    if( file.getMappedFile().getIsMapped() ){
+        //Use the arrays in the file directly, the forest keeps the file mapped until it is cleared
+        mappedFile = file.getMappedFile();
+        numTrees = numTreesInFile;
+        numNodes = numNodesInFile;
+        treeRootData = roots;
+        nodeData = flatNodes;
+        floatThresholdData = thresholds;
+        nodeSizeData = sizes;
+        classProbabilityData = probabilities;
+    }else{
+        treeRoots.assign( roots, roots + numTreesInFile );
+        nodes.assign( flatNodes, flatNodes + numNodesInFile );
+        floatThresholds.assign( thresholds, thresholds + numNodesInFile );
+        nodeSizes.assign( sizes, sizes + numNodesInFile );
+        classProbabilities.assign( probabilities, probabilities + probabilitiesSize );
+        updateDataPointers();
+    }
+
+    if( !validateForest() ){
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool FlatDecisionForest::validateForest(){
+
+    //The trees must be stored one after the other, starting with the first node
+    for(UINT i=0; i<numTrees; i++){
+        const bool validRoot = i == 0 ? treeRootData[i] == 0 : treeRootData[i] > treeRootData[i-1] && treeRootData[i] < numNodes;
+        if( !validRoot ){
+            errorLog << "validateForest() - The root of tree " << i << " is not valid!" << endl;
+            return false;
+        }
+    }
+
+    UINT treeIndex = 0;
+    for(UINT i=0; i<numNodes; i++){
+        const FlatDecisionForestNode &node = nodeData[i];
+
+        //Children can only point forwards to nodes in the same tree, so a prediction can never loop or leave the tree
+        if( treeIndex+1 < numTrees && i == treeRootData[ treeIndex+1 ] ) treeIndex++;
+        const UINT treeEnd = treeIndex+1 < numTrees ? treeRootData[ treeIndex+1 ] : numNodes;
+        const bool validLeftChild = node.leftChild == 0 || (!node.isLeafNode && node.leftChild > i && node.leftChild < treeEnd);
+        const bool validRightChild = node.rightChild == 0 || (!node.isLeafNode && node.rightChild > i && node.rightChild < treeEnd);
+        const bool validFeatureIndex = node.isLeafNode || node.featureIndex < numInputDimensions;
+        if( !validLeftChild || !validRightChild || !validFeatureIndex ){
+            errorLog << "validateForest() - Node " << i << " is not valid!" << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FlatDecisionForest::updateDataPointers(){
+    numTrees = (UINT)treeRoots.size();
+    numNodes = (UINT)nodes.size();
+    treeRootData = numTrees > 0 ? &treeRoots[0] : NULL;
+    nodeData = numNodes > 0 ? &nodes[0] : NULL;
+    floatThresholdData = numNodes > 0 ? &floatThresholds[0] : NULL;
+    nodeSizeData = numNodes > 0 ? &nodeSizes[0] : NULL;
+    classProbabilityData = classProbabilities.size() > 0 ? &classProbabilities[0] : NULL;
+}
+
+void FlatDecisionForest::copyMappedData(){
+    treeRoots.assign( treeRootData, treeRootData + numTrees );
+    nodes.assign( nodeData, nodeData + numNodes );
+    floatThresholds.assign( floatThresholdData, floatThresholdData + numNodes );
+    nodeSizes.assign( nodeSizeData, nodeSizeData + numNodes );
+    classProbabilities.assign( classProbabilityData, classProbabilityData + (size_t)numNodes*numClasses );
+    mappedFile.close();
+    updateDataPointers();
+}
+
+bool FlatDecisionForest::addNode(const DecisionTreeNode *node,UINT &nodeIndex){
+
+    if( node->getNumClasses() != numClasses ){
+        errorLog << "addNode(const DecisionTreeNode *node,UINT &nodeIndex) - The number of class probabilities at the node does not match the number of classes!" << endl;
+        return false;
+    }
+
+    nodeIndex = (UINT)nodes.size();
+    nodes.push_back( FlatDecisionForestNode() );
+    nodes[ nodeIndex ].threshold = node->getThreshold();
+    floatThresholds.push_back( toFloatThreshold( node->getThreshold() ) );
+    nodes[ nodeIndex ].featureIndex = node->getFeatureIndex();
+    nodes[ nodeIndex ].isLeafNode = node->getIsLeafNode();
+    nodeSizes.push_back( node->getNodeSize() );
+    VectorDouble nodeClassProbabilities = node->getClassProbabilities();
+    classProbabilities.insert( classProbabilities.end(), nodeClassProbabilities.begin(), nodeClassProbabilities.end() );
+
+    //The children of a leaf node are never used for a prediction, so they are not added
+    if( node->getIsLeafNode() ) return true;
+
+    if( node->getFeatureIndex() >= numInputDimensions ){
+        errorLog << "addNode(const DecisionTreeNode *node,UINT &nodeIndex) - The feature index at the node is out of bounds!" << endl;
+        return false;
+    }
+
+    UINT childIndex = 0;
+    if( node->getHasLeftChild() ){
+        if( !addNode( (const DecisionTreeNode*)node->getLeftChild(), childIndex ) ) return false;
+        nodes[ nodeIndex ].leftChild = childIndex;
+    }
+
+    if( node->getHasRightChild() ){
+        if( !addNode( (const DecisionTreeNode*)node->getRightChild(), childIndex ) ) return false;
+        nodes[ nodeIndex ].rightChild = childIndex;
+    }
+
+    return true;
+}
+
+DecisionTreeNode* FlatDecisionForest::buildNode(const UINT nodeIndex,DecisionTreeNode *parent,const UINT depth) const{
+
+    DecisionTreeNode *node = new DecisionTreeNode;
+
+    if( node == NULL ){
+        return NULL;
+    }
+
+    const FlatDecisionForestNode &flatNode = nodeData[ nodeIndex ];
+    VectorDouble nodeClassProbabilities( classProbabilityData + nodeIndex*numClasses, classProbabilityData + (nodeIndex+1)*numClasses );
+    node->initNode( parent, depth, flatNode.isLeafNode );
+    node->set( nodeSizeData[ nodeIndex ], flatNode.featureIndex, flatNode.threshold, nodeClassProbabilities );
+
+    if( flatNode.leftChild != 0 ){
+        node->setLeftChild( buildNode( flatNode.leftChild, node, depth+1 ) );
+    }
+
+    if( flatNode.rightChild != 0 ){
+        node->setRightChild( buildNode( flatNode.rightChild, node, depth+1 ) );
+    }
+
+    return node;
+}
+
+float FlatDecisionForest::toFloatThreshold(const double threshold){
+
+    //Round the threshold up to the smallest float that is not less than it, a float x is then >= this value exactly when it is >= threshold
+    float floatThreshold = float( threshold );
+    if( double(floatThreshold) < threshold ){
+        floatThreshold = nextafterf( floatThreshold, numeric_limits<float>::infinity() );
+    }
+    return floatThreshold;
+}
+
+} //End of namespace GRT
@@ -38,6 +38,7 @@ GMM::GMM(UINT numMixtureModels,bool useScaling,bool useNullRejection,double null
     this->nullRejectionCoeff = nullRejectionCoeff;
     this->maxIter = maxIter;
     this->minChange = minChange;
+    this->useDiagonalCovariance = false;
 }
 
 GMM::GMM(const GMM &rhs){
@@ -57,7 +58,12 @@ GMM& GMM::operator=(const GMM &rhs){
         this->numMixtureModels = rhs.numMixtureModels;
         this->maxIter = rhs.maxIter;
         this->minChange = rhs.minChange;
+        this->useDiagonalCovariance = rhs.useDiagonalCovariance;
         this->models = rhs.models;
+        this->floatMu = rhs.floatMu;
+        this->floatInvSigma = rhs.floatInvSigma;
+        this->floatLogCoefficients = rhs.floatLogCoefficients;
+        this->floatMixtureOffsets = rhs.floatMixtureOffsets;
         
         this->debugLog = rhs.debugLog;
         this->errorLog = rhs.errorLog;
@@ -80,7 +86,12 @@ bool GMM::deepCopyFrom(const Classifier *classifier){
         this->numMixtureModels = ptr->numMixtureModels;
         this->maxIter = ptr->maxIter;
         this->minChange = ptr->minChange;
+        this->useDiagonalCovariance = ptr->useDiagonalCovariance;
         this->models = ptr->models;
+        this->floatMu = ptr->floatMu;
+        this->floatInvSigma = ptr->floatInvSigma;
+        this->floatLogCoefficients = ptr->floatLogCoefficients;
+        this->floatMixtureOffsets = ptr->floatMixtureOffsets;
         
         this->debugLog = ptr->debugLog;
         this->errorLog = ptr->errorLog;
@@ -93,13 +104,20 @@ bool GMM::deepCopyFrom(const Classifier *classifier){
 }
 
 bool GMM::predict(VectorDouble x){
+    return predictInplace( x );
+}
 
+bool GMM::predictInplace(VectorDouble &x){
+    
+    if( useFloatPrediction ) return predictAsFloat( x );
+    
 	predictedClassLabel = 0;
 	
     if( classDistances.size() != numClasses || classLikelihoods.size() != numClasses ){
         classDistances.resize(numClasses);
         classLikelihoods.resize(numClasses);
     }
+    logLikelihoods.resize(numClasses);
     
     if( !trained ){
         errorLog << "predict(VectorDouble x) - Mixture Models have not been trained!" << endl;
@@ -117,43 +135,173 @@ bool GMM::predict(VectorDouble x){
         }
     }
 
-	UINT bestIndex = 0;
-	maxLikelihood = 0;
-    bestDistance = 0;
-    double sum = 0;
 	for(UINT k=0; k<numClasses; k++){
-        classDistances[k] = computeMixtureLikelihood(x,k);
+        logLikelihoods[k] = computeMixtureLogLikelihood(x,k);
+    }
+    
+    predictFromLogLikelihoods();
+    
+	return true;
+}
+
+bool GMM::predictFloatInplace(VectorFloat &x){
+    
+	predictedClassLabel = 0;
+    
+    if( classDistances.size() != numClasses || classLikelihoods.size() != numClasses ){
+        classDistances.resize(numClasses);
+        classLikelihoods.resize(numClasses);
+    }
+    logLikelihoods.resize(numClasses);
+    
+    if( !trained ){
+        errorLog << "predictFloatInplace(VectorFloat &x) - Mixture Models have not been trained!" << endl;
+        return false;
+    }
+    
+    if( x.size() != numInputDimensions ){
+        errorLog << "predictFloatInplace(VectorFloat &x) - The size of the input vector (" << x.size() << ") does not match that of the number of features the model was trained with (" << numInputDimensions << ")." << endl;
+        return false;
+    }
+    
+    if( floatMixtureOffsets.size() != numClasses+1 ){
+        errorLog << "predictFloatInplace(VectorFloat &x) - The float model has not been built, float prediction must be enabled first!" << endl;
+        return false;
+    }
+    
+    if( useScaling ){
+        for(UINT i=0; i<numInputDimensions; i++){
+            x[i] = float( scale(x[i], ranges[i].minValue, ranges[i].maxValue, GMM_MIN_SCALE_VALUE, GMM_MAX_SCALE_VALUE) );
+        }
+    }
+    
+    const UINT N = numInputDimensions;
+    floatDiff.resize( N );
+    floatTemp.resize( N );
+    floatLogGauss.resize( floatMixtureOffsets[numClasses] );
+	for(UINT k=0; k<numClasses; k++){
+        double maxValue = -numeric_limits< double >::max();
+        for(UINT t=floatMixtureOffsets[k]; t<floatMixtureOffsets[k+1]; t++){
+            const float *mu = floatMu[t];
+            for(UINT j=0; j<N; j++){
+                floatDiff[j] = x[j] - mu[j];
+            }
+            MatrixKernels::gemv( floatInvSigma[t*N], floatInvSigma.getStride(), &floatDiff[0], &floatTemp[0], N, N );
+            float q = 0;
+            for(UINT j=0; j<N; j++){
+                q += floatDiff[j] * floatTemp[j];
+            }
+            floatLogGauss[t] = floatLogCoefficients[t] - 0.5 * double(q);
+            if( floatLogGauss[t] > maxValue ) maxValue = floatLogGauss[t];
+        }
         
-        //cout << "K: " << k << " Dist: " << classDistances[k] << endl;
-        classLikelihoods[k] = classDistances[k];
-        sum += classLikelihoods[k];
-		if( classLikelihoods[k] > bestDistance ){
-			bestDistance = classLikelihoods[k];
+        //Combine the Gaussians of this class with log-sum-exp
+        double sum = 0;
+        for(UINT t=floatMixtureOffsets[k]; t<floatMixtureOffsets[k+1]; t++){
+            sum += exp( floatLogGauss[t] - maxValue );
+        }
+        logLikelihoods[k] = maxValue + log( sum );
+    }
+    
+    predictFromLogLikelihoods();
+    
+	return true;
+}
+
+bool GMM::predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const{
+    
+    //The input is scaled into the prediction's buffer, so nothing in this instance is written to
+    const VectorDouble *x = initSharedPrediction( inputVector, prediction, GMM_MIN_SCALE_VALUE, GMM_MAX_SCALE_VALUE );
+    if( x == NULL ) return false;
+    
+    //Buffer 0 holds the log likelihood of each class, buffers 1 and 2 are the scratch memory of the mixture models
+    if( prediction.buffers.size() < 3 ) prediction.buffers.resize(3);
+    VectorDouble &logLikelihoods = prediction.buffers[0];
+    if( logLikelihoods.size() != numClasses ) logLikelihoods.resize(numClasses);
+    
+    for(UINT k=0; k<numClasses; k++){
+        logLikelihoods[k] = models[k].computeMixtureLogLikelihood( *x, prediction.buffers[1], prediction.buffers[2] );
+    }
+    
+    predictFromLogLikelihoods( logLikelihoods, prediction.classDistances, prediction.classLikelihoods, prediction.predictedClassLabel, prediction.maxLikelihood, prediction.bestDistance );
+    
+    return true;
+}
+
+void GMM::predictFromLogLikelihoods(){
+    predictFromLogLikelihoods( logLikelihoods, classDistances, classLikelihoods, predictedClassLabel, maxLikelihood, bestDistance );
+}
+    
+void GMM::predictFromLogLikelihoods(const VectorDouble &logLikelihoods,VectorDouble &classDistances,VectorDouble &classLikelihoods,UINT &predictedClassLabel,double &maxLikelihood,double &bestDistance) const{
+    
+	UINT bestIndex = 0;
+	for(UINT k=1; k<numClasses; k++){
+		if( logLikelihoods[k] > logLikelihoods[bestIndex] ){
 			bestIndex = k;
 		}
 	}
     
-    //Normalize the likelihoods
+    //Normalize the likelihoods relative to the best class, so they are still valid when every mixture likelihood underflows
+    double sum = 0;
+	for(UINT k=0; k<numClasses; k++){
+        classDistances[k] = exp( logLikelihoods[k] );
+        classLikelihoods[k] = exp( logLikelihoods[k] - logLikelihoods[bestIndex] );
+        sum += classLikelihoods[k];
+	}
     for(unsigned int k=0; k<numClasses; k++){
         classLikelihoods[k] /= sum;
     }
+    bestDistance = classDistances[bestIndex];
     maxLikelihood = classLikelihoods[bestIndex];
     
     if( useNullRejection ){
         
-        //cout << "Dist: " << classDistances[bestIndex] << " RejectionThreshold: " << models[bestIndex].getRejectionThreshold() << endl;
-        
         //If the best distance is below the modles rejection threshold then set the predicted class label as the best class label
         //Otherwise set the predicted class label as the default null rejection class label of 0
-        if( classDistances[bestIndex] >= models[bestIndex].getNullRejectionThreshold() ){
+        if( logLikelihoods[bestIndex] >= log( models[bestIndex].getNullRejectionThreshold() ) ){
             predictedClassLabel = models[bestIndex].getClassLabel();
         }else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
    }else{
        //Get the predicted class label
        predictedClassLabel = models[bestIndex].getClassLabel();
    }
-	
-	return true;
+}
+
+bool GMM::buildFloatModel(){
+    
+    if( models.size() != numClasses ) return false;
+    
+    const UINT N = numInputDimensions;
+    UINT numGaussians = 0;
+    for(UINT k=0; k<numClasses; k++){
+        numGaussians += models[k].getK();
+    }
+    if( numGaussians == 0 ) return false;
+    
+    floatMu.resize( numGaussians, N );
+    floatInvSigma.resize( numGaussians*N, N );
+    floatLogCoefficients.resize( numGaussians );
+    floatMixtureOffsets.resize( numClasses+1 );
+    
+    UINT t = 0;
+    for(UINT k=0; k<numClasses; k++){
+        floatMixtureOffsets[k] = t;
+        for(UINT m=0; m<models[k].getK(); m++){
+            const GuassModel &gauss = models[k][m];
+            if( gauss.mu.size() != N || gauss.invSigma.getNumRows() != N || gauss.invSigma.getNumCols() != N ) return false;
+            for(UINT i=0; i<N; i++){
+                floatMu[t][i] = float( gauss.mu[i] );
+                for(UINT j=0; j<N; j++){
+                    floatInvSigma[t*N+i][j] = float( gauss.invSigma[j][i] );
+                }
+            }
+            floatLogCoefficients[t] = -0.5*( N*log(TWO_PI) + gauss.logDet ) - models[k].getLogNormalizationFactor();
+            t++;
+        }
+    }
+    floatMixtureOffsets[numClasses] = t;
+    
+    return true;
 }
 
 bool GMM::train(LabelledClassificationData trainingData){
@@ -207,6 +355,15 @@ bool GMM::train(LabelledClassificationData trainingData){
             models[k][j].mu = gaussianMixtureModel.getMu().getRowVector(j);
             models[k][j].sigma = gaussianMixtureModel.getSigma()[j];
             
+            //In the diagonal covariance mode the off diagonal terms are dropped, so sigma, invSigma and det all describe the diagonal model
+            if( useDiagonalCovariance ){
+                for(UINT i=0; i<numInputDimensions; i++){
+                    for(UINT n=0; n<numInputDimensions; n++){
+                        if( i != n ) models[k][j].sigma[i][n] = 0;
+                    }
+                }
+            }
+            
             //Compute the determinant and invSigma for the realtime prediction
             LUDecomposition ludcmp( models[k][j].sigma );
             if( !ludcmp.inverse( models[k][j].invSigma ) ){
@@ -217,8 +374,12 @@ bool GMM::train(LabelledClassificationData trainingData){
             models[k][j].det = ludcmp.det();
         }
         
-        //Compute the normalize factor
-        models[k].recomputeNormalizationFactor();
+        //Compute the Cholesky factors for the realtime prediction, this also computes the normalize factor
+        if( !models[k].recomputeCholeskyFactors( useDiagonalCovariance ) ){
+            models.clear();
+            errorLog << "train(LabelledClassificationData trainingData) - Failed to compute the Cholesky factors for class " << classLabel << ", the covariance matrix is not positive definite!" << endl;
+            return false;
+        }
         
         //Compute the rejection thresholds
         double mu = 0;
@@ -265,9 +426,12 @@ bool GMM::train(LabelledClassificationData trainingData){
     //Flag that the models have been trained
     trained = true;
     
+    //Build the float copy of the models if float prediction is enabled
+    updateFloatModel();
+    
     return true;
 }
-    
+
 double GMM::computeMixtureLikelihood(const VectorDouble &x,const UINT k){
     if( k >= numClasses ){
         errorLog << "computeMixtureLikelihood(const VectorDouble x,const UINT k) - Invalid k value!" << endl;
@@ -276,6 +440,14 @@ double GMM::computeMixtureLikelihood(const VectorDouble &x,const UINT k){
     return models[k].computeMixtureLikelihood(x);
 }
     
+double GMM::computeMixtureLogLikelihood(const VectorDouble &x,const UINT k){
+    if( k >= numClasses ){
+        errorLog << "computeMixtureLogLikelihood(const VectorDouble x,const UINT k) - Invalid k value!" << endl;
+        return -numeric_limits< double >::max();
+    }
+    return models[k].computeMixtureLogLikelihood(x);
+}
+    
 bool GMM::saveModelToFile(string filename) const{
     
 	std::fstream file; 
@@ -304,7 +476,7 @@ bool GMM::saveModelToFile(fstream &file) const{
     }
     
     //Write the header info
-    file << "GRT_GMM_MODEL_FILE_V1.0\n";
+    file << "GRT_GMM_MODEL_FILE_V2.0\n";
     file << "NumFeatures: " << numInputDimensions << endl;
     file << "NumClasses: " << numClasses << endl;
     file << "NumMixtureModels: " << numMixtureModels << endl;
@@ -313,6 +485,7 @@ bool GMM::saveModelToFile(fstream &file) const{
     file << "UseScaling: " << useScaling << endl;
     file << "UseNullRejection: " << useNullRejection << endl;
     file << "NullRejectionCoeff: " << nullRejectionCoeff << endl;
+    file << "UseDiagonalCovariance: " << useDiagonalCovariance << endl;
     
     ///Write the ranges if needed
     if( useScaling ){
@@ -386,6 +559,10 @@ bool GMM::loadModelFromFile(fstream &file){
     numClasses = 0;
     models.clear();
     classLabels.clear();
+    floatMu.clear();
+    floatInvSigma.clear();
+    floatLogCoefficients.clear();
+    floatMixtureOffsets.clear();
     
     if(!file.is_open())
     {
@@ -397,11 +574,14 @@ bool GMM::loadModelFromFile(fstream &file){
     
     //Find the file type header
     file >> word;
-    if(word != "GRT_GMM_MODEL_FILE_V1.0"){
+    if(word != "GRT_GMM_MODEL_FILE_V1.0" && word != "GRT_GMM_MODEL_FILE_V2.0"){
         errorLog << "loadModelFromFile(fstream &file) - Could not find Model File Header" << endl;
         return false;
     }
     
+    //Version 1 files were written before the diagonal covariance mode was added, so they always use the full covariance
+    const bool hasCovarianceMode = word == "GRT_GMM_MODEL_FILE_V2.0";
+    
     file >> word;
     if(word != "NumFeatures:"){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NumFeatures " << endl;
@@ -458,6 +638,16 @@ bool GMM::loadModelFromFile(fstream &file){
     }
     file >> nullRejectionCoeff;
     
+    useDiagonalCovariance = false;
+    if( hasCovarianceMode ){
+        file >> word;
+        if(word != "UseDiagonalCovariance:"){
+            errorLog << "loadModelFromFile(fstream &file) - Could not find UseDiagonalCovariance" << endl;
+            return false;
+        }
+        file >> useDiagonalCovariance;
+    }
+    
     ///Read the ranges if needed
     if( useScaling ){
         //Resize the ranges buffer
@@ -598,6 +788,12 @@ bool GMM::loadModelFromFile(fstream &file){
             
         }
         
+        //Compute the Cholesky factors for the realtime prediction
+        if( !models[k].recomputeCholeskyFactors( useDiagonalCovariance ) ){
+            errorLog << "loadModelFromFile(fstream &file) - Failed to compute the Cholesky factors for model " << k+1 << ", the covariance matrix is not positive definite!" << endl;
+            return false;
+        }
+        
     }
     
     //Set the null rejection thresholds
@@ -610,6 +806,9 @@ bool GMM::loadModelFromFile(fstream &file){
     //Flag that the models have been trained
     trained = true;
     
+    //Build the float copy of the models if float prediction is enabled
+    updateFloatModel();
+    
     return true;
 }
     
@@ -620,6 +819,11 @@ bool GMM::clear(){
     
     //Clear the GMM model
     models.clear();
+    logLikelihoods.clear();
+    floatMu.clear();
+    floatInvSigma.clear();
+    floatLogCoefficients.clear();
+    floatMixtureOffsets.clear();
     
     return true;
 }
@@ -652,6 +856,16 @@ bool GMM::setNumMixtureModels(UINT K){
     }
     return false;
 }
+    
+bool GMM::getUseDiagonalCovariance() const{
+    return useDiagonalCovariance;
+}
+    
+bool GMM::setUseDiagonalCovariance(const bool useDiagonalCovariance){
+    this->useDiagonalCovariance = useDiagonalCovariance;
+    return true;
+}
+    
 bool GMM::setMinChange(double minChange){
     if( minChange > 0 ){
         this->minChange = minChange;
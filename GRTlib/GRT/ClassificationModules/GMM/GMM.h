@@ -6,6 +6,10 @@
  @brief This class implements the Gaussian Mixture Model Classifier algorithm. The Gaussian Mixture Model 
  Classifier (GMM) is basic but useful classification algorithm that can be used to classify an N-dimensional signal.
  
+ The prediction is computed in the log domain: each Gaussian is evaluated with a triangular solve against the Cholesky factor of its
+ covariance matrix and the Gaussians of each mixture are combined with log-sum-exp, so the likelihoods do not underflow for high dimensional
+ inputs.  The diagonal covariance mode (see setUseDiagonalCovariance) reduces the cost of each Gaussian from O(N^2) to O(N).
+ 
  @example ClassificationModulesExamples/GMMExample/GMMExample.cpp
  
  @note The GMM algorithm can fail to train on some occasions, if this happens just try and run the training algorithm
@@ -100,6 +104,50 @@ public:
      */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
+    /**
+     This predicts the class of the inputVector with the float copy of the mixture models.  The quadratic form of each Gaussian is computed
+     in float, the log-likelihoods and the log-sum-exp over each mixture are computed in double.
+     This overrides the predictFloatInplace function in the MLBase base class.
+     
+     @param VectorFloat &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictFloatInplace(VectorFloat &inputVector);
+    
+    /**
+     The GMM algorithm supports the float prediction path.
+     
+     @return returns true
+     */
+    virtual bool getSupportsFloatPrediction() const{ return true; }
+    
+    /**
+     This predicts the class of the inputVector without modifying the GMM instance, the results are written to the prediction.
+     This overrides the predictShared function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassifierPrediction &prediction: the prediction that the results will be written to
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const;
+    
+    /**
+     The GMM algorithm supports shared prediction.
+     
+     @return returns true
+    */
+    virtual bool getSupportsSharedPrediction() const{ return true; }
+    
     /**
      This overrides the clear function in the Classifier base class.
      It will completely clear the ML module, removing any trained model and setting all the base variables to their default values.
@@ -167,6 +215,13 @@ public:
      */
     vector< MixtureModel > getModels();
     
+    /**
+     This function returns true if the GMM uses only the diagonal of each covariance matrix.
+     
+     @return returns true if the diagonal covariance mode is enabled, false otherwise
+     */
+    bool getUseDiagonalCovariance() const;
+    
     /**
      This function sets the number of mixture models used for class. You should call this function before you train the GMM model.
      The number of mixture models must be greater than 0.
@@ -176,6 +231,15 @@ public:
      */
     bool setNumMixtureModels(UINT K);
     
+    /**
+     This function sets if the GMM should use only the diagonal of each covariance matrix.  Each Gaussian then costs O(N) to evaluate
+     rather than O(N^2), at the cost of ignoring any correlation between the features.  You should call this function before you train the GMM model.
+     
+     @param const bool useDiagonalCovariance: if true then the off diagonal terms of each covariance matrix are dropped
+     @return returns true if the parameter was updated
+     */
+    bool setUseDiagonalCovariance(const bool useDiagonalCovariance);
+    
     /**
      This function sets the minChange parameter which controls when the GMM train function should stop. MinChange must be greater than zero.
      
@@ -195,11 +259,24 @@ public:
     
 protected:
     double computeMixtureLikelihood(const VectorDouble &x,UINT k);
+    double computeMixtureLogLikelihood(const VectorDouble &x,UINT k);
+    void predictFromLogLikelihoods();
+    void predictFromLogLikelihoods(const VectorDouble &logLikelihoods,VectorDouble &classDistances,VectorDouble &classLikelihoods,UINT &predictedClassLabel,double &maxLikelihood,double &bestDistance) const;
+    virtual bool buildFloatModel();
     
     UINT numMixtureModels;
     UINT maxIter;
     double minChange;
+    bool useDiagonalCovariance;
     vector< MixtureModel > models;
+    VectorDouble logLikelihoods;            //The log of the normalized mixture likelihood of each class for the last prediction
+    MatrixFloat floatMu;                    //The mean of every Gaussian of every class, stacked in class order
+    MatrixFloat floatInvSigma;              //The transposed inverse covariance of every Gaussian, each Gaussian has numInputDimensions rows
+    VectorDouble floatLogCoefficients;      //The log normalization of each Gaussian, minus the log normalization factor of its mixture model
+    vector< UINT > floatMixtureOffsets;     //The first Gaussian of each class, with one extra entry for the end of the last class
+    VectorFloat floatDiff;                  //A buffer for x-mu
+    VectorFloat floatTemp;                  //A buffer for invSigma*(x-mu)
+    VectorDouble floatLogGauss;             //A buffer for the log-likelihood of each Gaussian
     
     DebugLog debugLog;
     ErrorLog errorLog;
@@ -41,6 +41,7 @@ class GuassModel{
 public:
     GuassModel(){
         det = 0;
+        logDet = 0;
     }
     
     ~GuassModel(){
@@ -74,9 +75,11 @@ public:
     }
     
     double det;
+    double logDet;                          //The log of the determinant of sigma, computed from the Cholesky factor
     VectorDouble mu;
     MatrixDouble sigma;
     MatrixDouble invSigma;
+    MatrixDouble choleskyL;                 //The lower triangular Cholesky factor of sigma, used for the realtime prediction
 };
     
 class MixtureModel{
@@ -85,6 +88,8 @@ public:
         classLabel = 0;
         K = 0;
         normFactor = 1;
+        logNormFactor = 0;
+        useDiagonalCovariance = false;
         nullRejectionThreshold = 0;
         trainingMu = 0;
         trainingSigma = 0;
@@ -103,12 +108,75 @@ public:
 	}
     
     double computeMixtureLikelihood(const vector<double> &x){
+        return exp( computeMixtureLogLikelihood(x) );
+    }
+    
+    /**
+     Computes the log of the normalized mixture likelihood of x.  Each Gaussian is evaluated with a triangular solve against its
+     Cholesky factor and the Gaussians are combined with log-sum-exp, so the result does not underflow when x is far from every
+     Gaussian or the number of dimensions is high.  The Cholesky factors must have been computed with recomputeCholeskyFactors.
+     */
+    double computeMixtureLogLikelihood(const vector<double> &x){
+        return computeMixtureLogLikelihood( x, logGaussBuffer, solveBuffer );
+    }
+    
+    /**
+     Computes the log of the normalized mixture likelihood of x, using the caller's scratch buffers instead of the model's own buffers
+     so several threads can evaluate the same model at the same time.  The buffers are resized if needed.
+     */
+    double computeMixtureLogLikelihood(const vector<double> &x,VectorDouble &logGaussBuffer,VectorDouble &solveBuffer) const{
+        
+        if( K == 0 ) return -numeric_limits< double >::max();
+        
+        const UINT N = (UINT)x.size();
+        const double logTwoPiTerm = 0.5 * N * log(TWO_PI);
+        if( logGaussBuffer.size() != K ) logGaussBuffer.resize(K);
+        if( solveBuffer.size() != N ) solveBuffer.resize(N);
+        
+        double maxValue = -numeric_limits< double >::max();
+        for(UINT k=0; k<K; k++){
+            logGaussBuffer[k] = -logTwoPiTerm - 0.5*( gaussModels[k].logDet + computeMahalanobisDistance(x,gaussModels[k],solveBuffer) );
+            if( logGaussBuffer[k] > maxValue ) maxValue = logGaussBuffer[k];
+        }
+        
         double sum = 0;
         for(UINT k=0; k<K; k++){
-            sum += gauss(x,gaussModels[k].det,gaussModels[k].mu,gaussModels[k].invSigma);
+            sum += exp( logGaussBuffer[k] - maxValue );
         }
+        
         //Normalize the mixture likelihood
-        return sum/normFactor;
+        return maxValue + log( sum ) - logNormFactor;
+    }
+    
+    /**
+     Computes the Cholesky factor and log determinant of the covariance of each Gaussian, these are used by computeMixtureLogLikelihood.
+     If useDiagonalCovariance is true then only the diagonal of each covariance matrix is used, so each Gaussian costs O(N) to evaluate.
+     This also recomputes the normalization factor.
+     
+     @return returns true if every covariance matrix was factored, false if one of them is not positive definite
+     */
+    bool recomputeCholeskyFactors(const bool useDiagonalCovariance){
+        this->useDiagonalCovariance = useDiagonalCovariance;
+        for(UINT k=0; k<K; k++){
+            GuassModel &model = gaussModels[k];
+            const UINT N = model.sigma.getNumRows();
+            if( useDiagonalCovariance ){
+                model.choleskyL.resize(N,N);
+                model.choleskyL.setAllValues(0);
+                model.logDet = 0;
+                for(UINT i=0; i<N; i++){
+                    if( model.sigma[i][i] <= 0 ) return false;
+                    model.choleskyL[i][i] = sqrt( model.sigma[i][i] );
+                    model.logDet += log( model.sigma[i][i] );
+                }
+            }else{
+                Cholesky cholesky( model.sigma );
+                if( !cholesky.getSuccess() ) return false;
+                model.choleskyL = cholesky.el;
+                model.logDet = cholesky.logdet();
+            }
+        }
+        return recomputeNormalizationFactor();
     }
     
     bool resize(UINT K){
@@ -137,10 +205,20 @@ public:
     }
     
     bool recomputeNormalizationFactor(){
-        normFactor = 0;
+        //The normalization factor is the sum of the peak of each Gaussian, this is computed in the log domain as the peaks
+        //can overflow or underflow when the number of dimensions is high
+        if( K == 0 ) return false;
+        double maxValue = -numeric_limits< double >::max();
         for(UINT k=0; k<K; k++){
-            normFactor += gauss(gaussModels[k].mu,gaussModels[k].det,gaussModels[k].mu,gaussModels[k].invSigma);
+            const double logPeak = -0.5*( gaussModels[k].mu.size()*log(TWO_PI) + gaussModels[k].logDet );
+            if( logPeak > maxValue ) maxValue = logPeak;
         }
+        double sum = 0;
+        for(UINT k=0; k<K; k++){
+            sum += exp( -0.5*( gaussModels[k].mu.size()*log(TWO_PI) + gaussModels[k].logDet ) - maxValue );
+        }
+        logNormFactor = maxValue + log( sum );
+        normFactor = exp( logNormFactor );
         return true;
     }
     
@@ -173,6 +251,14 @@ public:
         return normFactor;
     }
     
+    double getLogNormalizationFactor() const {
+        return logNormFactor;
+    }
+    
+    bool getUseDiagonalCovariance() const {
+        return useDiagonalCovariance;
+    }
+    
     bool setClassLabel(const UINT classLabel){
         this->classLabel = classLabel;
         return true;
@@ -180,6 +266,7 @@ public:
     
     bool setNormalizationFactor(const double normFactor){
         this->normFactor = normFactor;
+        this->logNormFactor = log( normFactor );
         return true;
     }
     
@@ -195,25 +282,31 @@ public:
     }
     
 private:    
-    double gauss(const VectorDouble &x,double det,const VectorDouble &mu,Matrix<double> &invSigma){
+    //Computes (x-mu)' * inv(sigma) * (x-mu) as the squared norm of the solution of L*v = x-mu
+    double computeMahalanobisDistance(const VectorDouble &x,const GuassModel &model,VectorDouble &solveBuffer) const{
         
-        double y = 0;
-        double sum = 0;
         const UINT N = (UINT)x.size();
-        VectorDouble temp(N,0);
+        const MatrixDouble &L = model.choleskyL;
+        double sum = 0;
         
-        //Compute the first part of the equation
-        y = (1.0/pow(TWO_PI,N/2.0)) * (1.0/pow(det,0.5));
+        if( useDiagonalCovariance ){
+            for(UINT i=0; i<N; i++){
+                const double v = (x[i]-model.mu[i]) / L[i][i];
+                sum += v*v;
+            }
+            return sum;
+        }
         
-        //Compute the later half    
         for(UINT i=0; i<N; i++){
-            for(UINT j=0; j<N; j++){
-                temp[i] += (x[j]-mu[j]) * invSigma[j][i];
-            }
-            sum += (x[i]-mu[i]) * temp[i];
+            const double *row = L[i];
+            double v = x[i]-model.mu[i];
+            for(UINT j=0; j<i; j++) v -= row[j]*solveBuffer[j];
+            v /= row[i];
+            solveBuffer[i] = v;
+            sum += v*v;
         }
         
-        return ( y*exp( -0.5*sum ) );
+        return sum;
     }
     
     UINT classLabel;
@@ -223,7 +316,11 @@ private:
 	double trainingMu;                      //The average confidence value in the training data
 	double trainingSigma;                   //The simga confidence value in the training data
     double normFactor;
+    double logNormFactor;
+    bool useDiagonalCovariance;             //If true then only the diagonal of each covariance matrix is used for the prediction
     vector< GuassModel > gaussModels;
+    VectorDouble logGaussBuffer;
+    VectorDouble solveBuffer;
     
 };
     
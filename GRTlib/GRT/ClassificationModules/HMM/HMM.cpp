@@ -180,6 +180,10 @@ namespace GRT {
   }
 
   bool HMM::predict(VectorDouble inputVector){
+      return predictInplace( inputVector );
+  }
+  
+  bool HMM::predictInplace(VectorDouble &inputVector){
 
     predictedClassLabel = 0;
     maxLikelihood = -10000;
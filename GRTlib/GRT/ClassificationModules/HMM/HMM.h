@@ -81,6 +81,16 @@ public:
      */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
     /**
      This predicts the class of the timeseries.
      This overrides the predict function in the Classifier base class.
@@ -34,6 +34,7 @@ KNN::KNN(unsigned int K,bool useScaling,bool useNullRejection,double nullRejecti
     this->searchForBestKValue = searchForBestKValue;
     this->minKSearchValue = minKSearchValue;
     this->maxKSearchValue = maxKSearchValue;
+    this->useSpatialIndex = false;
     classifierType = "KNN";
     classifierMode = STANDARD_CLASSIFIER_MODE;
     distanceMethod = EUCLIDEAN_DISTANCE;
@@ -65,10 +66,15 @@ KNN& KNN::operator=(const KNN &rhs){
         this->searchForBestKValue = rhs.searchForBestKValue;
         this->minKSearchValue = rhs.minKSearchValue;
         this->maxKSearchValue = rhs.maxKSearchValue;
+        this->useSpatialIndex = rhs.useSpatialIndex;
         this->trainingData = rhs.trainingData;
+        this->floatTrainingSamples = rhs.floatTrainingSamples;
         this->trainingMu = rhs.trainingMu;
         this->trainingSigma = rhs.trainingSigma;
         this->rejectionThresholds = rhs.rejectionThresholds;
+        this->indexNodes = rhs.indexNodes;
+        this->indexOrder = rhs.indexOrder;
+        this->floatIndexSamples = rhs.floatIndexSamples;
         
         //Classifier variables
         copyBaseVariables( (Classifier*)&rhs );
@@ -89,10 +95,15 @@ bool KNN::deepCopyFrom(const Classifier *classifier){
         this->searchForBestKValue = ptr->searchForBestKValue;
         this->minKSearchValue = ptr->minKSearchValue;
         this->maxKSearchValue = ptr->maxKSearchValue;
+        this->useSpatialIndex = ptr->useSpatialIndex;
         this->trainingData = ptr->trainingData;
+        this->floatTrainingSamples = ptr->floatTrainingSamples;
         this->trainingMu = ptr->trainingMu;
         this->trainingSigma = ptr->trainingSigma;
         this->rejectionThresholds = ptr->rejectionThresholds;
+        this->indexNodes = ptr->indexNodes;
+        this->indexOrder = ptr->indexOrder;
+        this->floatIndexSamples = ptr->floatIndexSamples;
         
         //Classifier variables
         return copyBaseVariables( classifier );
@@ -121,9 +132,13 @@ bool KNN::train(LabelledClassificationData trainingData){
     this->numInputDimensions = trainingData.getNumDimensions();
     this->numClasses = trainingData.getNumClasses();
     
-    //TODO: In the future need to build a kdtree from the training data to allow better realtime prediction
     this->trainingData = trainingData;
     
+    //Build the spatial index, if the index can not be built then the neighbours will be found by searching the training data linearly
+    if( useSpatialIndex ){
+        buildSpatialIndex();
+    }
+    
     //Set the class labels
     classLabels.resize(numClasses);
     for(UINT k=0; k<numClasses; k++){
@@ -132,7 +147,7 @@ bool KNN::train(LabelledClassificationData trainingData){
 
     //If we do not need to search for the best K value, then call the sub training function and return the result
 	if( !searchForBestKValue ){
-        return train_(trainingData,K);
+        return train_(LabelledClassificationDataView(trainingData),K);
     }
 
     //If we have got this far then we are going to search for the best K value
@@ -141,9 +156,10 @@ bool KNN::train(LabelledClassificationData trainingData){
     vector< IndexedDouble > trainingAccuracyLog;
 
     for(UINT k=minKSearchValue; k<=maxKSearchValue; k++){
-        //Randomly spilt the data and use 80% to train the algorithm and 20% to test it
-        LabelledClassificationData trainingSet(trainingData);
-        LabelledClassificationData testSet = trainingSet.partition(80,true);
+        //Randomly spilt the data and use 80% to train the algorithm and 20% to test it, the views only hold the indexs of the samples
+        LabelledClassificationDataView trainingSet;
+        LabelledClassificationDataView testSet;
+        trainingData.getPartitionViews(80,trainingSet,testSet,true);
 
         if( !train_(trainingSet, k) ){
             errorLog << "Failed to train model for a k value of " << k << endl;
@@ -203,16 +219,17 @@ bool KNN::train(LabelledClassificationData trainingData){
 
         //Use the minimum index, this should give us the best accuracy with the minimum K value
         //We now need to train the model again to make sure all the training metrics are computed correctly
-        return train_(trainingData,tempLog[0].index);
+        return train_(LabelledClassificationDataView(trainingData),tempLog[0].index);
     }
 
     return false;
 }
 
-bool KNN::train_(const LabelledClassificationData &trainingData,const UINT K){
+bool KNN::train_(const LabelledClassificationDataView &trainingData,const UINT K){
 
     //Set the dimensionality of the input data
     this->K = K;
+    neighbourBuffer.reserve( K );
 
     //Flag that the algorithm has been trained so we can compute the rejection thresholds
     trained = true;
@@ -301,16 +318,29 @@ bool KNN::train_(const LabelledClassificationData &trainingData,const UINT K){
         useNullRejection = tempUseNullRejection;
         
     }else{
-        //Resize the rejection thresholds but set the values to 0
+        //Resize the training mu, sigma and rejection thresholds but set the values to 0, so the model can still be saved and loaded
+        trainingMu.clear();
+        trainingMu.resize( numClasses, 0 );
+        trainingSigma.clear();
+        trainingSigma.resize( numClasses, 0 );
         rejectionThresholds.clear();
         rejectionThresholds.resize( numClasses, 0 );
     }
-
+    
+    //Build the float copy of the training samples if float prediction is enabled
+    updateFloatModel();
+    
     return true;
 }
 
 bool KNN::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
 
+bool KNN::predictInplace(VectorDouble &inputVector){
+    
+    if( useFloatPrediction ) return predictAsFloat( inputVector );
+    
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - KNN model has not been trained" << endl;
         return false;
@@ -332,6 +362,49 @@ bool KNN::predict(VectorDouble inputVector){
     return predict(inputVector,K);
 }
 
+bool KNN::predictFloatInplace(VectorFloat &inputVector){
+    
+    if( !trained ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - KNN model has not been trained" << endl;
+        return false;
+    }
+    
+    if( inputVector.size() != numInputDimensions ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - the size of the input vector " << inputVector.size() << " does not match the number of features " << numInputDimensions <<  endl;
+        return false;
+    }
+    
+    if( floatTrainingSamples.getNumRows() != trainingData.getNumSamples() ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The float model has not been built, float prediction must be enabled first!" << endl;
+        return false;
+    }
+    
+    if( K > trainingData.getNumSamples() ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - K Is Greater Than The Number Of Training Samples" << endl;
+        return false;
+    }
+    
+    if( distanceMethod != EUCLIDEAN_DISTANCE && distanceMethod != COSINE_DISTANCE && distanceMethod != MANHATTAN_DISTANCE ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - unkown distance measure!" << endl;
+        return false;
+    }
+    
+    //Scale the input vector if needed
+    if( useScaling ){
+        for(UINT i=0; i<inputVector.size(); i++){
+            inputVector[i] = float( scale(inputVector[i], ranges[i].minValue, ranges[i].maxValue, 0, 1) );
+        }
+    }
+    
+    neighbourBuffer.clear();
+    neighbourBuffer.reserve( K );
+    if( !searchFloatSpatialIndex( inputVector, K, neighbourBuffer, indexInputBuffer ) ){
+        searchFloatTrainingData( inputVector, K, neighbourBuffer );
+    }
+    
+    return predict( neighbourBuffer );
+}
+
 bool KNN::predict(const VectorDouble &inputVector,const UINT K){
 
     if( !trained ){
@@ -349,50 +422,58 @@ bool KNN::predict(const VectorDouble &inputVector,const UINT K){
         return false;
     }
 
-    //TODO - need to build a kdtree of the training data to allow better realtime prediction
-    const UINT M = trainingData.getNumSamples();
-    vector< IndexedDouble > neighbours;
+    if( distanceMethod != EUCLIDEAN_DISTANCE && distanceMethod != COSINE_DISTANCE && distanceMethod != MANHATTAN_DISTANCE ){
+        errorLog << "predict(vector< double > inputVector) - unkown distance measure!" << endl;
+        return false;
+    }
 
-    for(UINT i=0; i<M; i++){
-        double dist = 0;
-        UINT classLabel = trainingData[i].getClassLabel();
-        VectorDouble trainingSample = trainingData[i].getSample();
-
-        switch( distanceMethod ){
-            case EUCLIDEAN_DISTANCE:
-                dist = computeEuclideanDistance(inputVector,trainingSample);
-                break;
-            case COSINE_DISTANCE:
-                dist = computeCosineDistance(inputVector,trainingSample);
-                break;
-            case MANHATTAN_DISTANCE:
-                dist = computeManhattanDistance(inputVector, trainingSample);
-                break;
-            default:
-                errorLog << "predict(vector< double > inputVector) - unkown distance measure!" << endl;
-                return false;
-                break;
-        }
+    //The neighbours are found in the member buffer, which is only allocated if K has grown since the last prediction
+    neighbourBuffer.clear();
+    neighbourBuffer.reserve( K );
 
-        if( neighbours.size() < K ){
-            neighbours.push_back( IndexedDouble(classLabel,dist) );
-        }else{
-            //Find the maximum value in the neighbours buffer
-            double maxValue = neighbours[0].value;
-            UINT maxIndex = 0;
-            for(UINT n=1; n<neighbours.size(); n++){
-                if( neighbours[n].value > maxValue ){
-                    maxValue = neighbours[n].value;
-                    maxIndex = n;
-                }
-            }
+    if( !searchSpatialIndex( inputVector, K, neighbourBuffer, indexInputBuffer ) ){
+        searchTrainingData( inputVector, K, neighbourBuffer );
+    }
 
-            //If the dist is less than the maximum value in the buffer, then replace that value with the new dist
-            if( dist < maxValue ){
-                neighbours[ maxIndex ] = IndexedDouble(classLabel,dist);
-            }
-        }
+    return predict( neighbourBuffer );
+}
+    
+bool KNN::predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const{
+    
+    //The input is scaled into the prediction's buffer, so nothing in this instance is written to
+    const VectorDouble *x = initSharedPrediction( inputVector, prediction, 0, 1 );
+    if( x == NULL ) return false;
+    
+    if( K > trainingData.getNumSamples() ) return false;
+    if( distanceMethod != EUCLIDEAN_DISTANCE && distanceMethod != COSINE_DISTANCE && distanceMethod != MANHATTAN_DISTANCE ) return false;
+    
+    //The neighbours are kept in the prediction, so they are only allocated on the first prediction
+    vector< IndexedDouble > &neighbours = prediction.indexedBuffer;
+    neighbours.clear();
+    neighbours.reserve( K );
+    if( prediction.buffers.size() == 0 ) prediction.buffers.resize( 1 );
+    
+    if( !searchSpatialIndex( *x, K, neighbours, prediction.buffers[0] ) ){
+        searchTrainingData( *x, K, neighbours );
+    }
+    
+    return predictFromNeighbours( neighbours, prediction.classLikelihoods, prediction.classDistances, prediction.predictedClassLabel, prediction.maxLikelihood );
+}
+    
+bool KNN::predict(vector< IndexedDouble > &neighbours){
+    
+    if( !predictFromNeighbours( neighbours, classLikelihoods, classDistances, predictedClassLabel, maxLikelihood ) ){
+        errorLog << "predict(VectorDouble inputVector) - Class label of training example can not be zero!" << endl;
+        return false;
     }
+    
+    return true;
+}
+    
+bool KNN::predictFromNeighbours(vector< IndexedDouble > &neighbours,VectorDouble &classLikelihoods,VectorDouble &classDistances,UINT &predictedClassLabel,double &maxLikelihood) const{
+    
+    //Sort the neighbours so the class distances are summed in the same order, regardless of how the neighbours were found
+    std::sort(neighbours.begin(),neighbours.end(),sortNeighboursByDistance);
 
     //Predict the class ID using the labels of the K nearest neighbours
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
@@ -402,11 +483,8 @@ bool KNN::predict(const VectorDouble &inputVector,const UINT K){
 
     //Count the classes
     for(UINT k=0; k<neighbours.size(); k++){
-        UINT classLabel = neighbours[k].index;
-        if( classLabel == 0 ){
-            errorLog << "predict(VectorDouble inputVector) - Class label of training example can not be zero!" << endl;
-            return false;
-        }
+        UINT classLabel = trainingData[ neighbours[k].index ].getClassLabel();
+        if( classLabel == 0 ) return false;
 
 		//Find the index of the classLabel
 		UINT classLabelIndex = 0;
@@ -457,6 +535,90 @@ bool KNN::predict(const VectorDouble &inputVector,const UINT K){
     return true;
 }
     
+bool KNN::predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances){
+    
+    //The float prediction path classifies each row on its own
+    if( useFloatPrediction ) return Classifier::predictBatch(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    
+    if( !initBatchPrediction(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances) ) return false;
+    
+    if( K > trainingData.getNumSamples() ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances) - K Is Greater Than The Number Of Training Samples" << endl;
+        return false;
+    }
+    
+    if( distanceMethod != EUCLIDEAN_DISTANCE && distanceMethod != COSINE_DISTANCE && distanceMethod != MANHATTAN_DISTANCE ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances) - unkown distance measure!" << endl;
+        return false;
+    }
+    
+    const UINT M = inputData.getNumRows();
+    const UINT numTrainingSamples = trainingData.getNumSamples();
+    const MatrixDouble &trainingSamples = trainingData.getSamples();
+    if( M == 0 ) return true;
+    
+    //Scale the input data if needed
+    const MatrixDouble *data = &inputData;
+    MatrixDouble scaledData;
+    if( useScaling ){
+        if( !scaleBatch(inputData,scaledData,0,1) ) return false;
+        data = &scaledData;
+    }
+    
+    //If the spatial index has been built then each row is searched on its own, rows the index can not search are searched linearly
+    if( indexNodes.size() > 0 ){
+        VectorDouble inputVector( numInputDimensions, 0 );
+        VectorDouble indexInput;
+        vector< IndexedDouble > neighbours;
+        neighbours.reserve( K );
+        
+        for(UINT r=0; r<M; r++){
+            const double *x = (*data)[r];
+            std::copy( x, x+numInputDimensions, inputVector.begin() );
+            neighbours.clear();
+            
+            if( !searchSpatialIndex( inputVector, K, neighbours, indexInput ) ){
+                searchTrainingData( inputVector, K, neighbours );
+            }
+            
+            if( !predict( neighbours ) ) return false;
+            storeBatchPrediction(r,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+        }
+        
+        return true;
+    }
+    
+    //Each training sample is compared against every row in the current block before moving on to the next sample, so each sample is
+    //only fetched once per block. The rows still see the training samples in the same order as the predict function, so the neighbours match
+    const UINT blockSize = M < KNN_BATCH_BLOCK_SIZE ? M : KNN_BATCH_BLOCK_SIZE;
+    VectorDouble blockDistances( blockSize, 0 );
+    vector< vector< IndexedDouble > > blockNeighbours( blockSize );
+    for(UINT r=0; r<blockSize; r++) blockNeighbours[r].reserve( K );
+    
+    for(UINT blockStart=0; blockStart<M; blockStart+=blockSize){
+        const UINT B = blockStart+blockSize <= M ? blockSize : M-blockStart;
+        
+        for(UINT r=0; r<B; r++){
+            blockNeighbours[r].clear();
+        }
+        
+        //The distance functions are symmetric, so the distances from one training sample to all the rows in the block are computed in one call
+        for(UINT i=0; i<numTrainingSamples; i++){
+            computeDistances( trainingSamples[i], (*data)[blockStart], B, data->getStride(), &blockDistances[0] );
+            for(UINT r=0; r<B; r++){
+                updateNeighbours( blockNeighbours[r], K, i, blockDistances[r] );
+            }
+        }
+        
+        for(UINT r=0; r<B; r++){
+            if( !predict( blockNeighbours[r] ) ) return false;
+            storeBatchPrediction(blockStart+r,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+        }
+    }
+    
+    return true;
+}
+    
 bool KNN::clear(){
     
     //Clear the Classifier variables
@@ -464,9 +626,13 @@ bool KNN::clear(){
     
     //Clear the KNN model
     trainingData.clear();
+    floatTrainingSamples.clear();
     trainingMu.clear();
     trainingSigma.clear();
     rejectionThresholds.clear();
+    indexNodes.clear();
+    indexOrder.clear();
+    floatIndexSamples.clear();
     
     return true;
 }
@@ -495,8 +661,46 @@ bool KNN::saveModelToFile(fstream &file) const{
         return false;
     }
     
+    if( !saveModelSettingsToFile( file ) ){
+        return false;
+    }
+    
+    file <<"NumTrainingSamples: " << trainingData.getNumSamples() << endl;
+    file <<"TrainingData: \n";
+    
+    //Right each of the models
+    for(UINT i=0; i<trainingData.getNumSamples(); i++){
+        file<< trainingData[i].getClassLabel() << "\t";
+        
+        for(UINT j=0; j<numInputDimensions; j++){
+            file << trainingData[i][j] << "\t";
+        }
+        file << endl;
+    }
+    
+    //Write the structure of the spatial index, the node bounds are recomputed from the training data when the model is loaded
+    file <<"UseSpatialIndex: " << useSpatialIndex << endl;
+    file <<"NumIndexNodes: " << indexNodes.size() << endl;
+    
+    if( indexNodes.size() > 0 ){
+        file <<"IndexOrder: ";
+        for(UINT i=0; i<indexOrder.size(); i++){
+            file << indexOrder[i] << "\t";
+        }file << endl;
+        
+        file <<"IndexNodes: \n";
+        for(UINT i=0; i<indexNodes.size(); i++){
+            file << indexNodes[i].leftChild << "\t" << indexNodes[i].rightChild << "\t" << indexNodes[i].startIndex << "\t" << indexNodes[i].endIndex << endl;
+        }
+    }
+    
+    return true;
+}
+
+bool KNN::saveModelSettingsToFile(fstream &file) const{
+    
     //Write the header info
-    file<<"GRT_KNN_MODEL_FILE_V1.0\n";
+    file<<"GRT_KNN_MODEL_FILE_V2.0\n";
     file<<"NumFeatures: " << numInputDimensions << endl;
     file<<"NumClasses: " << numClasses << endl;
     file<<"K: "<<K<<endl;
@@ -525,17 +729,43 @@ bool KNN::saveModelToFile(fstream &file) const{
         file << trainingSigma[j] << "\t";
     }file << endl;
     
-    file <<"NumTrainingSamples: " << trainingData.getNumSamples() << endl;
-    file <<"TrainingData: \n";
+    return true;
+}
+
+bool KNN::saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) const{
     
-    //Right each of the models
-    for(UINT i=0; i<trainingData.getNumSamples(); i++){
-        file<< trainingData[i].getClassLabel() << "\t";
-        
-        for(UINT j=0; j<numInputDimensions; j++){
-            file << trainingData[i][j] << "\t";
-        }
-        file << endl;
+    //The settings are written as text, the training data and the spatial index are written as binary sections
+    if( !file.beginTextSection( sectionName ) ){
+        errorLog << "saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) - Failed to start section: " << sectionName << endl;
+        return false;
+    }
+    
+    fstream &stream = file.getTextStream();
+    const bool settingsSaved = saveModelSettingsToFile( stream );
+    stream <<"UseSpatialIndex: " << useSpatialIndex << endl;
+    if( !file.endTextSection() || !settingsSaved ){
+        return false;
+    }
+    
+    const UINT M = trainingData.getNumSamples();
+    const vector< UINT > &sampleLabels = trainingData.getSampleLabels();
+    const MatrixDouble &trainingSamples = trainingData.getSamples();
+    
+    //Each index node is stored as its children and sample range, the bounds are recomputed from the training data when the model is loaded
+    vector< UINT > nodeData( indexNodes.size()*4 );
+    for(UINT i=0; i<indexNodes.size(); i++){
+        nodeData[i*4] = indexNodes[i].leftChild;
+        nodeData[i*4+1] = indexNodes[i].rightChild;
+        nodeData[i*4+2] = indexNodes[i].startIndex;
+        nodeData[i*4+3] = indexNodes[i].endIndex;
+    }
+    
+    if( !file.writeSection( sectionName + "/ClassLabels", sampleLabels ) ||
+        !file.writeSection( sectionName + "/Samples", M > 0 ? trainingSamples[0] : NULL, (unsigned long long)M*numInputDimensions*sizeof(double) ) ||
+        !file.writeSection( sectionName + "/IndexOrder", indexOrder ) ||
+        !file.writeSection( sectionName + "/IndexNodes", nodeData ) ){
+        errorLog << "saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) - Failed to write the training data!" << endl;
+        return false;
     }
     
     return true;
@@ -567,13 +797,202 @@ bool KNN::loadModelFromFile(fstream &file){
     }
     
     std::string word;
+    bool hasSpatialIndex = false;
+    if( !loadModelSettingsFromFile( file, hasSpatialIndex ) ){
+        return false;
+    }
     
-    //Find the file type header
     file >> word;
-    if(word != "GRT_KNN_MODEL_FILE_V1.0"){
+    if(word != "NumTrainingSamples:"){
+        errorLog << "loadModelFromFile(fstream &file) - Could not find NumTrainingSamples!" << endl;
+        return false;
+    }
+    unsigned int numTrainingSamples = 0;
+    file >> numTrainingSamples;
+    
+    file >> word;
+    if(word != "TrainingData:"){
+        errorLog << "loadModelFromFile(fstream &file) - Could not find TrainingData!" << endl;
+        return false;
+    }
+    
+    //Load the training data
+    trainingData.setNumDimensions(numInputDimensions);
+    unsigned int classLabel = 0;
+    vector< double > sample(numInputDimensions,0);
+    for(UINT i=0; i<numTrainingSamples; i++){
+        //Read the class label
+        file >> classLabel;
+        
+        //Read the feature vector
+        for(UINT j=0; j<numInputDimensions; j++){
+            file >> sample[j];
+        }
+        
+        //Add it to the training data
+        trainingData.addSample(classLabel, sample);
+    }
+    
+    //Set the class labels
+    classLabels.resize(numClasses);
+    for(UINT k=0; k<numClasses; k++){
+        classLabels[k] = trainingData.getClassTracker()[k].classLabel;
+    }
+    
+    //Load the spatial index
+    useSpatialIndex = false;
+    indexNodes.clear();
+    indexOrder.clear();
+    floatIndexSamples.clear();
+    
+    if( hasSpatialIndex ){
+        file >> word;
+        if(word != "UseSpatialIndex:"){
+            errorLog << "loadModelFromFile(fstream &file) - Could not find UseSpatialIndex!" << endl;
+            return false;
+        }
+        file >> useSpatialIndex;
+        
+        file >> word;
+        if(word != "NumIndexNodes:"){
+            errorLog << "loadModelFromFile(fstream &file) - Could not find NumIndexNodes!" << endl;
+            return false;
+        }
+        unsigned int numIndexNodes = 0;
+        file >> numIndexNodes;
+        
+        if( numIndexNodes > 0 ){
+            file >> word;
+            if(word != "IndexOrder:"){
+                errorLog << "loadModelFromFile(fstream &file) - Could not find IndexOrder!" << endl;
+                return false;
+            }
+            indexOrder.resize( numTrainingSamples );
+            for(UINT i=0; i<numTrainingSamples; i++){
+                file >> indexOrder[i];
+            }
+            
+            file >> word;
+            if(word != "IndexNodes:"){
+                errorLog << "loadModelFromFile(fstream &file) - Could not find IndexNodes!" << endl;
+                return false;
+            }
+            indexNodes.resize( numIndexNodes );
+            for(UINT i=0; i<numIndexNodes; i++){
+                file >> indexNodes[i].leftChild;
+                file >> indexNodes[i].rightChild;
+                file >> indexNodes[i].startIndex;
+                file >> indexNodes[i].endIndex;
+            }
+            
+            if( !validateSpatialIndex() ){
+                errorLog << "loadModelFromFile(fstream &file) - The spatial index is not valid!" << endl;
+                return false;
+            }
+        }
+    }
+    
+    //Flag that the model has been trained
+    trained = true;
+    
+    //Compute the null rejection thresholds
+    recomputeNullRejectionThresholds();
+    
+    //Build the float copy of the training samples if float prediction is enabled
+    updateFloatModel();
+    
+    return true;
+}
+    
+bool KNN::loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName){
+    
+    clear();
+    
+    if( !file.beginTextSection( sectionName ) ){
+        errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - Failed to find section: " << sectionName << endl;
+        return false;
+    }
+    
+    fstream &stream = file.getTextStream();
+    bool hasSpatialIndex = false;
+    if( !loadModelSettingsFromFile( stream, hasSpatialIndex ) ){
+        return false;
+    }
+    
+    std::string word;
+    stream >> word;
+    if(word != "UseSpatialIndex:"){
+        errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - Could not find UseSpatialIndex!" << endl;
+        return false;
+    }
+    stream >> useSpatialIndex;
+    
+    //Copy the training data out of the binary sections, each sample is copied straight into the training data rather than being parsed
+    UINT numTrainingSamples = 0;
+    UINT numValues = 0;
+    const UINT *sampleLabels = file.getSectionArray< UINT >( sectionName + "/ClassLabels", numTrainingSamples );
+    const double *samples = file.getSectionArray< double >( sectionName + "/Samples", numValues );
+    if( sampleLabels == NULL || samples == NULL || numInputDimensions == 0 || (unsigned long long)numValues != (unsigned long long)numTrainingSamples*numInputDimensions ){
+        errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - The training data is missing or does not match the number of features!" << endl;
+        return false;
+    }
+    
+    trainingData.setNumDimensions( numInputDimensions );
+    trainingData.reserve( numTrainingSamples );
+    for(UINT i=0; i<numTrainingSamples; i++){
+        trainingData.addSample( sampleLabels[i], samples + size_t(i)*numInputDimensions );
+    }
+    
+    classLabels.resize(numClasses);
+    for(UINT k=0; k<numClasses; k++){
+        classLabels[k] = trainingData.getClassTracker()[k].classLabel;
+    }
+    
+    //Load the spatial index
+    vector< UINT > nodeData;
+    if( !file.readSection( sectionName + "/IndexOrder", indexOrder ) || !file.readSection( sectionName + "/IndexNodes", nodeData ) || nodeData.size() % 4 != 0 ){
+        errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - Failed to read the spatial index!" << endl;
+        clear();
+        return false;
+    }
+    
+    indexNodes.resize( nodeData.size()/4 );
+    for(UINT i=0; i<indexNodes.size(); i++){
+        indexNodes[i].leftChild = nodeData[i*4];
+        indexNodes[i].rightChild = nodeData[i*4+1];
+        indexNodes[i].startIndex = nodeData[i*4+2];
+        indexNodes[i].endIndex = nodeData[i*4+3];
+    }
+    
+    if( indexNodes.size() > 0 && !validateSpatialIndex() ){
+        errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - The spatial index is not valid!" << endl;
+        clear();
+        return false;
+    }
+    
+    //Flag that the model has been trained
+    trained = true;
+    
+    //Compute the null rejection thresholds
+    recomputeNullRejectionThresholds();
+    
+    //Build the float copy of the training samples if float prediction is enabled
+    updateFloatModel();
+    
+    return true;
+}
+
+bool KNN::loadModelSettingsFromFile(fstream &file,bool &hasSpatialIndex){
+    
+    std::string word;
+    
+    //Find the file type header, version 1.0 files do not contain the spatial index
+    file >> word;
+    if(word != "GRT_KNN_MODEL_FILE_V1.0" && word != "GRT_KNN_MODEL_FILE_V2.0"){
         errorLog << "loadModelFromFile(fstream &file) - Could not find Model File Header!" << endl;
         return false;
     }
+    hasSpatialIndex = word == "GRT_KNN_MODEL_FILE_V2.0";
     
     //Find the file type header
     file >> word;
@@ -689,42 +1108,50 @@ bool KNN::loadModelFromFile(fstream &file){
         file >> trainingSigma[j];
     }
     
-    file >> word;
-    if(word != "NumTrainingSamples:"){
-        errorLog << "loadModelFromFile(fstream &file) - Could not find NumTrainingSamples!" << endl;
-        return false;
-    }
-    unsigned int numTrainingSamples = 0;
-    file >> numTrainingSamples;
+    return true;
+}
+
+bool KNN::validateSpatialIndex(){
     
-    file >> word;
-    if(word != "TrainingData:"){
-        errorLog << "loadModelFromFile(fstream &file) - Could not find TrainingData!" << endl;
-        return false;
+    const UINT numTrainingSamples = trainingData.getNumSamples();
+    const UINT numIndexNodes = (UINT)indexNodes.size();
+    bool valid = indexOrder.size() == numTrainingSamples;
+    
+    for(UINT i=0; i<indexOrder.size() && valid; i++){
+        if( indexOrder[i] >= numTrainingSamples ){
+            errorLog << "validateSpatialIndex() - IndexOrder contains an invalid training sample index!" << endl;
+            valid = false;
+        }
     }
     
-    //Load the training data
-    trainingData.setNumDimensions(numInputDimensions);
-    unsigned int classLabel = 0;
-    vector< double > sample(numInputDimensions,0);
-    for(UINT i=0; i<numTrainingSamples; i++){
-        //Read the class label
-        file >> classLabel;
-        
-        //Read the feature vector
-        for(UINT j=0; j<numInputDimensions; j++){
-            file >> sample[j];
+    for(UINT i=0; i<numIndexNodes && valid; i++){
+        //Children are always stored after their parent, so this also makes sure the index can not contain a cycle
+        const bool validChildren = indexNodes[i].isLeaf() ? indexNodes[i].rightChild == 0 : indexNodes[i].leftChild > i && indexNodes[i].rightChild > i && indexNodes[i].leftChild < numIndexNodes && indexNodes[i].rightChild < numIndexNodes;
+        if( !validChildren || indexNodes[i].startIndex >= indexNodes[i].endIndex || indexNodes[i].endIndex > numTrainingSamples ){
+            errorLog << "validateSpatialIndex() - Index node " << i << " is not valid!" << endl;
+            valid = false;
         }
-        
-        //Add it to the training data
-        trainingData.addSample(classLabel, sample);
     }
     
-    //Flag that the model has been trained
-    trained = true;
+    //Recompute the bounds of each node from the training data
+    MatrixDouble points;
+    if( valid && !computeSpatialIndexPoints( points ) ){
+        errorLog << "validateSpatialIndex() - Failed to compute the spatial index bounds!" << endl;
+        valid = false;
+    }
     
-    //Compute the null rejection thresholds
-    recomputeNullRejectionThresholds();
+    if( !valid ){
+        indexNodes.clear();
+        indexOrder.clear();
+        floatIndexSamples.clear();
+        return false;
+    }
+    
+    for(UINT i=0; i<numIndexNodes; i++){
+        computeSpatialIndexNodeBounds( points, indexNodes[i] );
+    }
+    
+    buildFloatIndexSamples();
     
     return true;
 }
@@ -747,6 +1174,7 @@ bool KNN::recomputeNullRejectionThresholds(){
 bool KNN::setK(UINT K){
     if( K > 0 ){
         this->K = K;
+        neighbourBuffer.reserve( K );
         return true;
     }
     return false;
@@ -779,45 +1207,495 @@ bool KNN::setNullRejectionCoeff(double nullRejectionCoeff){
 bool KNN::setDistanceMethod(UINT distanceMethod){
     if( distanceMethod == EUCLIDEAN_DISTANCE || distanceMethod == COSINE_DISTANCE || distanceMethod == MANHATTAN_DISTANCE ){
         this->distanceMethod = distanceMethod;
+        
+        //The index bounds depend on the distance method, so the index needs to be rebuilt
+        if( trained && useSpatialIndex ){
+            buildSpatialIndex();
+        }
         return true;
     }
     return false;
 }
 
-double KNN::computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b){
-    double dist = 0;
-    for(UINT j=0; j<numInputDimensions; j++){
-        dist += SQR( a[j] - b[j] );
+bool KNN::enableSpatialIndex(bool useSpatialIndex){
+    this->useSpatialIndex = useSpatialIndex;
+    
+    if( !trained ) return true;
+    
+    if( useSpatialIndex ){
+        return buildSpatialIndex();
     }
-    return sqrt( dist );
+    
+    indexNodes.clear();
+    indexOrder.clear();
+    floatIndexSamples.clear();
+    return true;
 }
 
-double KNN::computeCosineDistance(const VectorDouble &a,const VectorDouble &b){
-    double dist = 0;
-
-    double dotAB = 0;
-    double magA = 0;
-    double magB = 0;
+void KNN::updateNeighbours(vector< IndexedDouble > &neighbours,const UINT K,const UINT sampleIndex,const double dist) const{
+    
+    if( neighbours.size() < K ){
+        neighbours.push_back( IndexedDouble(sampleIndex,dist) );
+        return;
+    }
+    
+    //Find the furthest neighbour in the buffer, ties are broken by the training sample index so the neighbours do not depend on the
+    //order the training samples are visited in
+    UINT maxIndex = 0;
+    for(UINT n=1; n<neighbours.size(); n++){
+        if( neighbours[n].value > neighbours[maxIndex].value || (neighbours[n].value == neighbours[maxIndex].value && neighbours[n].index > neighbours[maxIndex].index) ){
+            maxIndex = n;
+        }
+    }
+    
+    //If the dist is less than the maximum value in the buffer, then replace that value with the new dist
+    if( dist < neighbours[maxIndex].value || (dist == neighbours[maxIndex].value && sampleIndex < neighbours[maxIndex].index) ){
+        neighbours[ maxIndex ] = IndexedDouble(sampleIndex,dist);
+    }
+}
+    
+void KNN::searchTrainingData(const VectorDouble &inputVector,const UINT K,vector< IndexedDouble > &neighbours) const{
+    
+    //The distances are computed a block of training samples at a time, so no memory needs to be allocated
+    double distances[ GRT_DISTANCE_KERNEL_BLOCK_SIZE ];
+    const MatrixDouble &trainingSamples = trainingData.getSamples();
+    const UINT M = trainingSamples.getNumRows();
+    for(UINT blockStart=0; blockStart<M; blockStart+=GRT_DISTANCE_KERNEL_BLOCK_SIZE){
+        const UINT B = blockStart+GRT_DISTANCE_KERNEL_BLOCK_SIZE <= M ? GRT_DISTANCE_KERNEL_BLOCK_SIZE : M-blockStart;
+        computeDistances( &inputVector[0], trainingSamples[blockStart], B, trainingSamples.getStride(), distances );
+        for(UINT i=0; i<B; i++){
+            updateNeighbours( neighbours, K, blockStart+i, distances[i] );
+        }
+    }
+}
+    
+void KNN::searchFloatTrainingData(const VectorFloat &inputVector,const UINT K,vector< IndexedDouble > &neighbours){
+    
+    float distances[ GRT_DISTANCE_KERNEL_BLOCK_SIZE ];
+    const UINT M = floatTrainingSamples.getNumRows();
+    for(UINT blockStart=0; blockStart<M; blockStart+=GRT_DISTANCE_KERNEL_BLOCK_SIZE){
+        const UINT B = blockStart+GRT_DISTANCE_KERNEL_BLOCK_SIZE <= M ? GRT_DISTANCE_KERNEL_BLOCK_SIZE : M-blockStart;
+        computeFloatDistances( &inputVector[0], floatTrainingSamples[blockStart], B, floatTrainingSamples.getStride(), distances );
+        for(UINT i=0; i<B; i++){
+            updateNeighbours( neighbours, K, blockStart+i, distances[i] );
+        }
+    }
+}
+    
+bool KNN::buildFloatModel(){
+    
+    if( !floatTrainingSamples.copyFromDouble( trainingData.getSamples() ) ) return false;
+    
+    buildFloatIndexSamples();
+    
+    return true;
+}
+    
+bool KNN::buildFloatIndexSamples(){
+    
+    //The float samples are copied in the order of the index, so the samples of each index leaf are one block for the float distance kernels
+    const UINT M = (UINT)indexOrder.size();
+    if( M == 0 || floatTrainingSamples.getNumRows() != M ){
+        floatIndexSamples.clear();
+        return false;
+    }
+    
+    if( !floatIndexSamples.resize( M, numInputDimensions ) ) return false;
+    for(UINT i=0; i<M; i++){
+        const float *sample = floatTrainingSamples[ indexOrder[i] ];
+        std::copy( sample, sample+numInputDimensions, floatIndexSamples[i] );
+    }
+    
+    return true;
+}
+    
+bool KNN::buildSpatialIndex(){
+    
+    indexNodes.clear();
+    indexOrder.clear();
+    floatIndexSamples.clear();
+    
+    MatrixDouble points;
+    if( !computeSpatialIndexPoints( points ) ){
+        warningLog << "buildSpatialIndex() - The training data can not be indexed, the neighbours will be found by a linear search!" << endl;
+        return false;
+    }
+    
+    const UINT M = points.getNumRows();
+    indexOrder.resize( M );
+    for(UINT i=0; i<M; i++){
+        indexOrder[i] = i;
+    }
+    
+    indexNodes.reserve( 2*(M/KNN_INDEX_LEAF_SIZE) + 1 );
+    buildSpatialIndexNode( points, 0, M );
+    
+    buildFloatIndexSamples();
+    
+    return true;
+}
 
+/**
+ Orders training sample indexs by the value of one dimension, this is used to find the median sample when splitting an index node.
+ */
+class KNNIndexSampleCompare{
+public:
+    KNNIndexSampleCompare(const MatrixDouble &points,const UINT dimension):points(points),dimension(dimension){}
+    
+    bool operator()(const UINT a,const UINT b) const{
+        return points[a][dimension] < points[b][dimension];
+    }
+    
+    const MatrixDouble &points;
+    const UINT dimension;
+};
+    
+UINT KNN::buildSpatialIndexNode(const MatrixDouble &points,const UINT startIndex,const UINT endIndex){
+    
+    //Note that the nodes buffer can grow while the children are built, so the node is always accessed by its index
+    const UINT nodeIndex = (UINT)indexNodes.size();
+    indexNodes.push_back( KNNIndexNode() );
+    indexNodes[ nodeIndex ].startIndex = startIndex;
+    indexNodes[ nodeIndex ].endIndex = endIndex;
+    computeSpatialIndexNodeBounds( points, indexNodes[ nodeIndex ] );
+    
+    if( endIndex-startIndex <= KNN_INDEX_LEAF_SIZE ){
+        return nodeIndex;
+    }
+    
+    //Split the node at the median of its widest dimension
+    UINT splitDimension = 0;
+    double maxRange = 0;
     for(UINT j=0; j<numInputDimensions; j++){
-        dotAB += a[j] * b[j];
-        magA += SQR(a[j]);
-        magB += SQR(b[j]);
+        const double range = indexNodes[ nodeIndex ].maxValues[j] - indexNodes[ nodeIndex ].minValues[j];
+        if( range > maxRange ){
+            maxRange = range;
+            splitDimension = j;
+        }
+    }
+    
+    //If all the samples are the same then there is nothing to split
+    if( maxRange == 0 ){
+        return nodeIndex;
+    }
+    
+    const UINT midIndex = startIndex + (endIndex-startIndex)/2;
+    std::nth_element(indexOrder.begin()+startIndex,indexOrder.begin()+midIndex,indexOrder.begin()+endIndex,KNNIndexSampleCompare(points,splitDimension));
+    
+    const UINT leftChild = buildSpatialIndexNode( points, startIndex, midIndex );
+    const UINT rightChild = buildSpatialIndexNode( points, midIndex, endIndex );
+    indexNodes[ nodeIndex ].leftChild = leftChild;
+    indexNodes[ nodeIndex ].rightChild = rightChild;
+    
+    return nodeIndex;
+}
+    
+bool KNN::computeSpatialIndexPoints(MatrixDouble &points){
+    
+    const UINT M = trainingData.getNumSamples();
+    if( M == 0 || numInputDimensions == 0 ) return false;
+    
+    points.resize( M, numInputDimensions );
+    
+    for(UINT i=0; i<M; i++){
+        const double *sample = trainingData[i].getData();
+        double *point = points[i];
+        double magnitude = 0;
+        
+        for(UINT j=0; j<numInputDimensions; j++){
+            if( isnan( sample[j] ) || isinf( sample[j] ) ) return false;
+            point[j] = sample[j];
+            magnitude += SQR( sample[j] );
+        }
+        
+        //The cosine distance only depends on the direction of the samples, so the index is built over the normalized samples
+        if( distanceMethod == COSINE_DISTANCE ){
+            if( magnitude == 0 ) return false;
+            magnitude = sqrt( magnitude );
+            for(UINT j=0; j<numInputDimensions; j++){
+                point[j] /= magnitude;
+            }
+        }
+    }
+    
+    return true;
+}
+    
+void KNN::computeSpatialIndexNodeBounds(const MatrixDouble &points,KNNIndexNode &node) const{
+    
+    const double *point = points[ indexOrder[ node.startIndex ] ];
+    node.minValues.assign( point, point+numInputDimensions );
+    node.maxValues.assign( point, point+numInputDimensions );
+    
+    for(UINT i=node.startIndex+1; i<node.endIndex; i++){
+        point = points[ indexOrder[i] ];
+        for(UINT j=0; j<numInputDimensions; j++){
+            if( point[j] < node.minValues[j] ) node.minValues[j] = point[j];
+            else if( point[j] > node.maxValues[j] ) node.maxValues[j] = point[j];
+        }
+    }
+}
+    
+bool KNN::searchSpatialIndex(const VectorDouble &inputVector,const UINT K,vector< IndexedDouble > &neighbours,VectorDouble &indexInput) const{
+    
+    if( indexNodes.size() == 0 ) return false;
+    
+    //The index can not bound NaN or infinite inputs, these are left to the linear search
+    double magnitude = 0;
+    for(UINT j=0; j<numInputDimensions; j++){
+        if( isnan( inputVector[j] ) || isinf( inputVector[j] ) ) return false;
+        magnitude += SQR( inputVector[j] );
+    }
+    
+    if( distanceMethod != COSINE_DISTANCE ){
+        searchSpatialIndexNode( 0, inputVector, inputVector, K, neighbours );
+        return true;
+    }
+    
+    //The cosine index is built over the normalized samples, so the bounds need the normalized input
+    if( magnitude == 0 ) return false;
+    magnitude = sqrt( magnitude );
+    indexInput.resize( numInputDimensions );
+    for(UINT j=0; j<numInputDimensions; j++){
+        indexInput[j] = inputVector[j] / magnitude;
+    }
+    searchSpatialIndexNode( 0, inputVector, indexInput, K, neighbours );
+    
+    return true;
+}
+    
+void KNN::searchSpatialIndexNode(const UINT nodeIndex,const VectorDouble &inputVector,const VectorDouble &indexInput,const UINT K,vector< IndexedDouble > &neighbours) const{
+    
+    const KNNIndexNode &node = indexNodes[ nodeIndex ];
+    
+    //The distances are computed exactly as they are in the linear search, so the neighbours match
+    if( node.isLeaf() ){
+        for(UINT i=node.startIndex; i<node.endIndex; i++){
+            const UINT sampleIndex = indexOrder[i];
+            updateNeighbours( neighbours, K, sampleIndex, computeDistance( &inputVector[0], trainingData[ sampleIndex ].getData() ) );
+        }
+        return;
+    }
+    
+    //Search the closest child first, so the neighbours are tightened as quickly as possible
+    UINT firstChild = node.leftChild;
+    UINT secondChild = node.rightChild;
+    double firstBound = computeSpatialIndexBound( indexNodes[ firstChild ], indexInput, false );
+    double secondBound = computeSpatialIndexBound( indexNodes[ secondChild ], indexInput, false );
+    if( secondBound < firstBound ){
+        std::swap( firstChild, secondChild );
+        std::swap( firstBound, secondBound );
+    }
+    
+    if( !canPruneSpatialIndexNode( firstBound, neighbours, K, KNN_INDEX_TOLERANCE ) ){
+        searchSpatialIndexNode( firstChild, inputVector, indexInput, K, neighbours );
     }
+    
+    if( !canPruneSpatialIndexNode( secondBound, neighbours, K, KNN_INDEX_TOLERANCE ) ){
+        searchSpatialIndexNode( secondChild, inputVector, indexInput, K, neighbours );
+    }
+}
+    
+bool KNN::searchFloatSpatialIndex(const VectorFloat &inputVector,const UINT K,vector< IndexedDouble > &neighbours,VectorDouble &indexInput) const{
+    
+    if( indexNodes.size() == 0 || floatIndexSamples.getNumRows() != indexOrder.size() ) return false;
+    
+    //The index can not bound NaN or infinite inputs, these are left to the linear search
+    double magnitude = 0;
+    for(UINT j=0; j<numInputDimensions; j++){
+        if( isnan( inputVector[j] ) || isinf( inputVector[j] ) ) return false;
+        magnitude += SQR( double(inputVector[j]) );
+    }
+    if( distanceMethod == COSINE_DISTANCE ){
+        if( magnitude == 0 ) return false;
+        magnitude = sqrt( magnitude );
+    }else magnitude = 1;
+    
+    //The bounds are computed in double precision, the cosine index is built over the normalized samples so the bounds need the normalized input
+    indexInput.resize( numInputDimensions );
+    for(UINT j=0; j<numInputDimensions; j++){
+        indexInput[j] = inputVector[j] / magnitude;
+    }
+    searchFloatSpatialIndexNode( 0, inputVector, indexInput, K, neighbours );
+    
+    return true;
+}
+    
+void KNN::searchFloatSpatialIndexNode(const UINT nodeIndex,const VectorFloat &inputVector,const VectorDouble &indexInput,const UINT K,vector< IndexedDouble > &neighbours) const{
+    
+    const KNNIndexNode &node = indexNodes[ nodeIndex ];
+    
+    //The distances are computed exactly as they are in the linear float search, so the neighbours match.  A leaf that could not be split
+    //can hold more samples than the leaf size, so the leaf is still searched a block at a time
+    if( node.isLeaf() ){
+        float distances[ GRT_DISTANCE_KERNEL_BLOCK_SIZE ];
+        for(UINT blockStart=node.startIndex; blockStart<node.endIndex; blockStart+=GRT_DISTANCE_KERNEL_BLOCK_SIZE){
+            const UINT B = blockStart+GRT_DISTANCE_KERNEL_BLOCK_SIZE <= node.endIndex ? GRT_DISTANCE_KERNEL_BLOCK_SIZE : node.endIndex-blockStart;
+            computeFloatDistances( &inputVector[0], floatIndexSamples[blockStart], B, floatIndexSamples.getStride(), distances );
+            for(UINT i=0; i<B; i++){
+                updateNeighbours( neighbours, K, indexOrder[blockStart+i], distances[i] );
+            }
+        }
+        return;
+    }
+    
+    UINT firstChild = node.leftChild;
+    UINT secondChild = node.rightChild;
+    double firstBound = computeSpatialIndexBound( indexNodes[ firstChild ], indexInput, true );
+    double secondBound = computeSpatialIndexBound( indexNodes[ secondChild ], indexInput, true );
+    if( secondBound < firstBound ){
+        std::swap( firstChild, secondChild );
+        std::swap( firstBound, secondBound );
+    }
+    
+    if( !canPruneSpatialIndexNode( firstBound, neighbours, K, KNN_FLOAT_INDEX_TOLERANCE ) ){
+        searchFloatSpatialIndexNode( firstChild, inputVector, indexInput, K, neighbours );
+    }
+    
+    if( !canPruneSpatialIndexNode( secondBound, neighbours, K, KNN_FLOAT_INDEX_TOLERANCE ) ){
+        searchFloatSpatialIndexNode( secondChild, inputVector, indexInput, K, neighbours );
+    }
+}
+    
+double KNN::computeSpatialIndexBound(const KNNIndexNode &node,const VectorDouble &indexInput,const bool roundToFloat) const{
+    
+    double bound = 0;
+    double gap = 0;
+    double minValue = 0;
+    double maxValue = 0;
+    
+    //The float search measures the distances to the float copies of the samples.  Rounding to float keeps the order of the values, so the
+    //float copy of every sample in the node is inside the node's bounding box rounded to float
+    switch( distanceMethod ){
+        case EUCLIDEAN_DISTANCE:
+            for(UINT j=0; j<numInputDimensions; j++){
+                minValue = roundToFloat ? double( float( node.minValues[j] ) ) : node.minValues[j];
+                maxValue = roundToFloat ? double( float( node.maxValues[j] ) ) : node.maxValues[j];
+                if( indexInput[j] < minValue ) gap = minValue - indexInput[j];
+                else if( indexInput[j] > maxValue ) gap = indexInput[j] - maxValue;
+                else gap = 0;
+                bound += SQR( gap );
+            }
+            return sqrt( bound );
+        case COSINE_DISTANCE:
+            //The samples in the node are normalized, so the cosine with the normalized input can not be less than the smallest dot product with the node's bounding box
+            for(UINT j=0; j<numInputDimensions; j++){
+                bound += indexInput[j] >= 0 ? indexInput[j] * node.minValues[j] : indexInput[j] * node.maxValues[j];
+            }
+            return bound;
+        case MANHATTAN_DISTANCE:
+            for(UINT j=0; j<numInputDimensions; j++){
+                minValue = roundToFloat ? double( float( node.minValues[j] ) ) : node.minValues[j];
+                maxValue = roundToFloat ? double( float( node.maxValues[j] ) ) : node.maxValues[j];
+                if( indexInput[j] < minValue ) bound += minValue - indexInput[j];
+                else if( indexInput[j] > maxValue ) bound += indexInput[j] - maxValue;
+            }
+            return bound;
+        default:
+            break;
+    }
+    
+    return 0;
+}
+    
+bool KNN::canPruneSpatialIndexNode(const double bound,const vector< IndexedDouble > &neighbours,const UINT K,const double tolerance) const{
+    
+    if( neighbours.size() < K ) return false;
+    
+    double maxValue = neighbours[0].value;
+    for(UINT n=1; n<neighbours.size(); n++){
+        if( neighbours[n].value > maxValue ) maxValue = neighbours[n].value;
+    }
+    
+    //The bounds are not computed with exactly the same floating point operations as the distances, so a node is only pruned if its bound 
+    //is beyond the furthest neighbour by more than the tolerance. A node that is only tied with the furthest neighbour is never pruned, as 
+    //it could contain a sample with a lower index
+    if( distanceMethod == COSINE_DISTANCE ){
+        return bound > maxValue + tolerance;
+    }
+    return bound > maxValue + maxValue*tolerance;
+}
+    
+bool KNN::sortNeighboursByDistance(const IndexedDouble &a,const IndexedDouble &b){
+    //NaN distances are sorted after all the other distances, so the ordering stays well defined
+    const bool aIsNaN = isnan( a.value );
+    const bool bIsNaN = isnan( b.value );
+    if( aIsNaN || bIsNaN ){
+        if( aIsNaN && bIsNaN ) return a.index < b.index;
+        return bIsNaN;
+    }
+    if( a.value == b.value ) return a.index < b.index;
+    return a.value < b.value;
+}
+    
+void KNN::computeDistances(const double *x,const double *rows,const UINT numRows,const UINT rowStride,double *distances) const{
+    switch( distanceMethod ){
+        case EUCLIDEAN_DISTANCE:
+            DistanceKernels::squaredEuclidean( x, rows, numRows, rowStride, numInputDimensions, distances );
+            for(UINT i=0; i<numRows; i++){
+                distances[i] = sqrt( distances[i] );
+            }
+            break;
+        case COSINE_DISTANCE:
+            DistanceKernels::cosine( x, rows, numRows, rowStride, numInputDimensions, distances );
+            break;
+        case MANHATTAN_DISTANCE:
+            DistanceKernels::manhattan( x, rows, numRows, rowStride, numInputDimensions, distances );
+            break;
+        default:
+            for(UINT i=0; i<numRows; i++){
+                distances[i] = BIG_DISTANCE;
+            }
+            break;
+    }
+}
 
-    dist = dotAB / (sqrt(magA) * sqrt(magB));
+void KNN::computeFloatDistances(const float *x,const float *rows,const UINT numRows,const UINT rowStride,float *distances) const{
+    switch( distanceMethod ){
+        case EUCLIDEAN_DISTANCE:
+            DistanceKernels::squaredEuclidean( x, rows, numRows, rowStride, numInputDimensions, distances );
+            for(UINT i=0; i<numRows; i++){
+                distances[i] = sqrtf( distances[i] );
+            }
+            break;
+        case COSINE_DISTANCE:
+            DistanceKernels::cosine( x, rows, numRows, rowStride, numInputDimensions, distances );
+            break;
+        case MANHATTAN_DISTANCE:
+            DistanceKernels::manhattan( x, rows, numRows, rowStride, numInputDimensions, distances );
+            break;
+        default:
+            for(UINT i=0; i<numRows; i++){
+                distances[i] = float( BIG_DISTANCE );
+            }
+            break;
+    }
+}
 
-    return dist;
+double KNN::computeDistance(const double *a,const double *b) const{
+    switch( distanceMethod ){
+        case EUCLIDEAN_DISTANCE:
+            return computeEuclideanDistance(a,b);
+        case COSINE_DISTANCE:
+            return computeCosineDistance(a,b);
+        case MANHATTAN_DISTANCE:
+            return computeManhattanDistance(a,b);
+        default:
+            break;
+    }
+    return BIG_DISTANCE;
 }
 
-double KNN::computeManhattanDistance(const VectorDouble &a,const VectorDouble &b){
-    double dist = 0;
+double KNN::computeEuclideanDistance(const double *a,const double *b) const{
+    return sqrt( DistanceKernels::squaredEuclidean( a, b, numInputDimensions ) );
+}
 
-    for(UINT j=0; j<numInputDimensions; j++){
-        dist += fabs( a[j] - b[j] );
-    }
+double KNN::computeCosineDistance(const double *a,const double *b) const{
+    return DistanceKernels::cosine( a, b, numInputDimensions );
+}
 
-    return dist;
+double KNN::computeManhattanDistance(const double *a,const double *b) const{
+    return DistanceKernels::manhattan( a, b, numInputDimensions );
 }
 
 } //End of namespace GRT
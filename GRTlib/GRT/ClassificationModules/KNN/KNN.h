@@ -45,6 +45,32 @@
 namespace GRT{
     
 #define BIG_DISTANCE 99e+99
+#define KNN_BATCH_BLOCK_SIZE 32
+#define KNN_INDEX_LEAF_SIZE 16
+#define KNN_INDEX_TOLERANCE 1.0e-9
+#define KNN_FLOAT_INDEX_TOLERANCE 1.0e-4
+
+///////////////// KNN Index Node /////////////////
+class KNNIndexNode{
+public:
+    KNNIndexNode(){
+        leftChild = 0;
+        rightChild = 0;
+        startIndex = 0;
+        endIndex = 0;
+    }
+    ~KNNIndexNode(){};
+    
+    //The root is always the first node, so no other node can have a child index of 0
+    bool isLeaf() const{ return leftChild == 0; }
+
+    UINT leftChild;                     //The index of the left child node, this is 0 for a leaf node
+    UINT rightChild;                    //The index of the right child node, this is 0 for a leaf node
+    UINT startIndex;                    //The first position in the index order that belongs to this node
+    UINT endIndex;                      //One past the last position in the index order that belongs to this node
+    VectorDouble minValues;             //The minimum value of each dimension over the samples in this node
+    VectorDouble maxValues;             //The maximum value of each dimension over the samples in this node
+};
 
 class KNN : public Classifier
 {
@@ -109,6 +135,63 @@ public:
     */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictInplace(VectorDouble &inputVector);
+
+    /**
+     This predicts the class of the inputVector with the float copy of the training data.  If the kd-tree index has been built it is used
+     to find the neighbours, the float distances are only computed for the samples in the index nodes that can not be pruned.
+     This overrides the predictFloatInplace function in the MLBase base class.
+
+     @param VectorFloat &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictFloatInplace(VectorFloat &inputVector);
+
+    /**
+     The KNN algorithm supports the float prediction path.
+
+     @return returns true
+    */
+    virtual bool getSupportsFloatPrediction() const{ return true; }
+    
+    /**
+     This predicts the class of the inputVector without modifying the KNN instance, the results (and the neighbours) are written to the prediction.
+     This overrides the predictShared function in the Classifier base class.
+
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassifierPrediction &prediction: the prediction that the results will be written to
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const;
+
+    /**
+     The KNN algorithm supports shared prediction.
+
+     @return returns true
+    */
+    virtual bool getSupportsSharedPrediction() const{ return true; }
+    
+    /**
+     This classifies each row in the inputData, giving the same results as calling predict on each row in turn.
+     The rows are processed in small blocks, each training sample is compared against every row in a block before moving on to the next sample.
+     This overrides the predictBatch function in the Classifier base class.
+     
+     @param const MatrixDouble &inputData: the data to classify, each row is one sample
+     @param vector< UINT > &predictedClassLabels: will be filled with the predicted class label of each row
+     @param MatrixDouble &predictedClassLikelihoods: will be filled with the class likelihoods of each row
+     @param MatrixDouble &predictedClassDistances: will be filled with the class distances of each row
+     @return returns true if the batch was classified, false otherwise
+    */
+    virtual bool predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances);
+    
     /**
      This overrides the clear function in the Classifier base class.
      It will completely clear the ML module, removing any trained model and setting all the base variables to their default values.
@@ -153,6 +236,27 @@ public:
      */
     virtual bool loadModelFromFile(fstream &file);
     
+    /**
+     This saves the trained KNN model to a binary model file.  The settings are written as text, the training samples, their class
+     labels and the spatial index are written as binary sections.
+     This overrides the saveModelToBinaryFile function in the MLBase class.
+     
+     @param BinaryModelWriter &file: a reference to the binary model file the model will be saved to
+     @param const string &sectionName: the name of the section the model should be saved to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) const;
+    
+    /**
+     This loads a trained KNN model from a binary model file.  The training samples are copied out of the file, they are not parsed.
+     This overrides the loadModelFromBinaryFile function in the MLBase class.
+     
+     @param BinaryModelReader &file: a reference to the binary model file the model will be loaded from
+     @param const string &sectionName: the name of the section the model was saved to
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName);
+    
     /**
      This recomputes the null rejection thresholds for each of the classes in the KNN model.
      This will be called automatically if the setGamma(double gamma) function is called.
@@ -177,6 +281,13 @@ public:
     */
     UINT getDistanceMethod(){ return distanceMethod; }
     
+    /**
+     Returns true if a kd-tree index of the training data will be used to find the nearest neighbours.
+     
+     @return returns true if the spatial index is enabled, false otherwise
+    */
+    bool getUseSpatialIndex(){ return useSpatialIndex; }
+    
     //Setters
     /**
      Sets the K nearest neighbours that will be searched for by the algorithm during prediction.
@@ -228,23 +339,66 @@ public:
      @return returns true if the distance method was updated successfully, false otherwise
      */
     bool setDistanceMethod(UINT distanceMethod);
+    
+    /**
+     Sets if a kd-tree index of the training data should be built at train time and used to find the nearest neighbours.
+     The index supports all the distance methods and gives exactly the same neighbours as the linear search, including ties, 
+     which are broken by the order of the training samples.  Inputs the index can not bound (i.e. NaN values, or an input with a 
+     zero magnitude for the cosine distance) are searched linearly.  If the model is already trained then the index will be 
+     built or removed straight away.
+     
+     @param bool useSpatialIndex: sets if the spatial index should be used
+     @return returns true if the spatial index was updated successfully, false otherwise
+     */
+    bool enableSpatialIndex(bool useSpatialIndex);
 
 protected:
-    bool train_(const LabelledClassificationData &trainingData,const UINT K);
+    bool train_(const LabelledClassificationDataView &trainingData,const UINT K);
     bool predict(const VectorDouble &inputVector,const UINT K);
-    double computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b);
-    double computeCosineDistance(const VectorDouble &a,const VectorDouble &b);
-    double computeManhattanDistance(const VectorDouble &a,const VectorDouble &b);
+    bool predict(vector< IndexedDouble > &neighbours);
+    bool predictFromNeighbours(vector< IndexedDouble > &neighbours,VectorDouble &classLikelihoods,VectorDouble &classDistances,UINT &predictedClassLabel,double &maxLikelihood) const;
+    void updateNeighbours(vector< IndexedDouble > &neighbours,const UINT K,const UINT sampleIndex,const double dist) const;
+    void searchTrainingData(const VectorDouble &inputVector,const UINT K,vector< IndexedDouble > &neighbours) const;
+    void searchFloatTrainingData(const VectorFloat &inputVector,const UINT K,vector< IndexedDouble > &neighbours);
+    virtual bool buildFloatModel();
+    bool buildFloatIndexSamples();
+    bool saveModelSettingsToFile(fstream &file) const;
+    bool loadModelSettingsFromFile(fstream &file,bool &hasSpatialIndex);
+    bool validateSpatialIndex();
+    bool buildSpatialIndex();
+    UINT buildSpatialIndexNode(const MatrixDouble &points,const UINT startIndex,const UINT endIndex);
+    bool computeSpatialIndexPoints(MatrixDouble &points);
+    void computeSpatialIndexNodeBounds(const MatrixDouble &points,KNNIndexNode &node) const;
+    bool searchSpatialIndex(const VectorDouble &inputVector,const UINT K,vector< IndexedDouble > &neighbours,VectorDouble &indexInput) const;
+    void searchSpatialIndexNode(const UINT nodeIndex,const VectorDouble &inputVector,const VectorDouble &indexInput,const UINT K,vector< IndexedDouble > &neighbours) const;
+    bool searchFloatSpatialIndex(const VectorFloat &inputVector,const UINT K,vector< IndexedDouble > &neighbours,VectorDouble &indexInput) const;
+    void searchFloatSpatialIndexNode(const UINT nodeIndex,const VectorFloat &inputVector,const VectorDouble &indexInput,const UINT K,vector< IndexedDouble > &neighbours) const;
+    double computeSpatialIndexBound(const KNNIndexNode &node,const VectorDouble &indexInput,const bool roundToFloat) const;
+    bool canPruneSpatialIndexNode(const double bound,const vector< IndexedDouble > &neighbours,const UINT K,const double tolerance) const;
+    static bool sortNeighboursByDistance(const IndexedDouble &a,const IndexedDouble &b);
+    void computeDistances(const double *x,const double *rows,const UINT numRows,const UINT rowStride,double *distances) const;
+    void computeFloatDistances(const float *x,const float *rows,const UINT numRows,const UINT rowStride,float *distances) const;
+    double computeDistance(const double *a,const double *b) const;
+    double computeEuclideanDistance(const double *a,const double *b) const;
+    double computeCosineDistance(const double *a,const double *b) const;
+    double computeManhattanDistance(const double *a,const double *b) const;
     
     UINT K;                                     ///> The number of neighbours to search for
     UINT distanceMethod;                        ///> The distance method used to compute the distance between each data point
     bool searchForBestKValue;                   ///> Sets if the best K value should be searched for or if the model should be trained with K
     UINT minKSearchValue;                       ///> The minimum K value to start the search from
     UINT maxKSearchValue;                       ///> The maximum K value to end the search at
+    bool useSpatialIndex;                       ///> Sets if a kd-tree index of the training data should be used to find the neighbours
     LabelledClassificationData trainingData;    ///> Holds the trainingData to perform the predictions
+    MatrixFloat floatTrainingSamples;           ///> A float copy of the training samples, used by the float prediction path
     VectorDouble trainingMu;                    ///> Holds the average max-class distance of the training data for each of classes
     VectorDouble trainingSigma;                 ///> Holds the stddev of the max-class distance of the training data for each of classes
     VectorDouble rejectionThresholds;           ///> Holds the rejection threshold for each of the classes
+    vector< KNNIndexNode > indexNodes;          ///> The nodes of the kd-tree index, the root is the first node.  This is empty if the index has not been built
+    vector< UINT > indexOrder;                  ///> The training sample indexs, ordered so the samples of each index node are contiguous
+    MatrixFloat floatIndexSamples;              ///> A float copy of the training samples in the index order, used by the float index search.  This is empty unless both the index and the float model are built
+    vector< IndexedDouble > neighbourBuffer;    ///> Holds the neighbours found by predict, this is reserved for K neighbours so predict does not allocate
+    VectorDouble indexInputBuffer;              ///> Holds the normalized input of the cosine index search, so predict does not allocate
     
     static RegisterClassifierModule< KNN > registerModule;
     
@@ -196,6 +196,10 @@ bool LDA::train(LabelledClassificationData trainingData){
 }
 
 bool LDA::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool LDA::predictInplace(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(vector< double > inputVector) - LDA Model Not Trained!" << endl;
@@ -58,6 +58,8 @@ MinDist& MinDist::operator=(const MinDist &rhs){
         //MinDist variables
         this->numClusters = rhs.numClusters;
         this->models = rhs.models;
+        this->floatClusters = rhs.floatClusters;
+        this->floatClusterOffsets = rhs.floatClusterOffsets;
         
         //Classifier variables
         copyBaseVariables( (Classifier*)&rhs );
@@ -75,6 +77,8 @@ bool MinDist::deepCopyFrom(const Classifier *classifier){
         
         this->numClusters = ptr->numClusters;
         this->models = ptr->models;
+        this->floatClusters = ptr->floatClusters;
+        this->floatClusterOffsets = ptr->floatClusterOffsets;
         
         //Classifier variables
         return copyBaseVariables( classifier );
@@ -88,6 +92,12 @@ bool MinDist::train(LabelledClassificationData trainingData){
 }
 
 bool MinDist::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool MinDist::predictInplace(VectorDouble &inputVector){
+    
+    if( useFloatPrediction ) return predictAsFloat( inputVector );
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - MinDist Model Not Trained!" << endl;
@@ -113,15 +123,99 @@ bool MinDist::predict(VectorDouble inputVector){
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
     if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
     
+	for(UINT k=0; k<numClasses; k++){
+		classDistances[k] = models[k].predict( inputVector );
+    }
+    
+    predictFromClassDistances();
+    
+    return true;
+}
+
+bool MinDist::predictFloatInplace(VectorFloat &inputVector){
+    
+    if( !trained ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - MinDist Model Not Trained!" << endl;
+        return false;
+    }
+    
+    predictedClassLabel = 0;
+	maxLikelihood = 0;
+    
+	if( inputVector.size() != numInputDimensions ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The size of the input vector (" << inputVector.size() << ") does not match the num features in the model (" << numInputDimensions << endl;
+		return false;
+	}
+    
+    if( floatClusterOffsets.size() != numClasses+1 ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The float model has not been built, float prediction must be enabled first!" << endl;
+        return false;
+    }
+    
+    if( useScaling ){
+        for(UINT n=0; n<numInputDimensions; n++){
+            inputVector[n] = float( scale(inputVector[n], ranges[n].minValue, ranges[n].maxValue, 0, 1) );
+        }
+    }
+    
+    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
+    if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
+    
+    //The clusters of all the classes are searched a block at a time, each distance is assigned to the class that owns its row
+    float dist[ GRT_DISTANCE_KERNEL_BLOCK_SIZE ];
+    const UINT numRows = floatClusters.getNumRows();
+    UINT k = 0;
+    float minDist = numeric_limits<float>::max();
+    for(UINT blockStart=0; blockStart<numRows; blockStart+=GRT_DISTANCE_KERNEL_BLOCK_SIZE){
+        const UINT B = blockStart+GRT_DISTANCE_KERNEL_BLOCK_SIZE <= numRows ? GRT_DISTANCE_KERNEL_BLOCK_SIZE : numRows-blockStart;
+        DistanceKernels::squaredEuclidean( &inputVector[0], floatClusters[blockStart], B, floatClusters.getStride(), numInputDimensions, dist );
+        for(UINT i=0; i<B; i++){
+            while( blockStart+i >= floatClusterOffsets[k+1] ){
+                classDistances[k++] = sqrt( double(minDist) );
+                minDist = numeric_limits<float>::max();
+            }
+            if( dist[i] < minDist ) minDist = dist[i];
+        }
+    }
+    while( k < numClasses ){
+        classDistances[k++] = sqrt( double(minDist) );
+        minDist = numeric_limits<float>::max();
+    }
+    
+    predictFromClassDistances();
+    
+    return true;
+}
+
+bool MinDist::predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const{
+    
+    //The input is scaled into the prediction's buffer, so nothing in this instance is written to
+    const VectorDouble *x = initSharedPrediction( inputVector, prediction, 0, 1 );
+    if( x == NULL ) return false;
+    
+    for(UINT k=0; k<numClasses; k++){
+        prediction.classDistances[k] = models[k].predict( *x );
+    }
+    
+    predictFromClassDistances( prediction.classDistances, prediction.classLikelihoods, prediction.predictedClassLabel, prediction.maxLikelihood );
+    
+    return true;
+}
+
+void MinDist::predictFromClassDistances(){
+    predictFromClassDistances( classDistances, classLikelihoods, predictedClassLabel, maxLikelihood );
+}
+    
+void MinDist::predictFromClassDistances(const VectorDouble &classDistances,VectorDouble &classLikelihoods,UINT &predictedClassLabel,double &maxLikelihood) const{
+    
     double classLikelihoodsSum = 0;
     double minDist = numeric_limits<double>::max();
+    predictedClassLabel = 0;
 	for(UINT k=0; k<numClasses; k++){
-		classDistances[k] = models[k].predict( inputVector );
-        
         //At this point the class likelihoods and class distances are the same thing
         classLikelihoods[k] = classDistances[k];
         classLikelihoodsSum += classDistances[k];
-
+        
         //Keep track of the best value
 		if( classDistances[k] < minDist ){
 			minDist = classDistances[k];
@@ -134,14 +228,98 @@ bool MinDist::predict(VectorDouble inputVector){
     	for(UINT k=0; k<numClasses; k++){
         	classLikelihoods[k] = (classLikelihoodsSum-classLikelihoods[k])/classLikelihoodsSum;
     	}
-        maxLikelihood = classLikelihoods[predictedClassLabel];
-	}else maxLikelihood = classLikelihoods[predictedClassLabel];
+	}
+    maxLikelihood = classLikelihoods[predictedClassLabel];
     
     if( useNullRejection ){
         //Check to see if the best result is greater than the models threshold
         if( minDist <= models[predictedClassLabel].getRejectionThreshold() ) predictedClassLabel = models[predictedClassLabel].getClassLabel();
         else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
     }else predictedClassLabel = models[predictedClassLabel].getClassLabel();
+}
+
+bool MinDist::buildFloatModel(){
+    
+    if( models.size() != numClasses ) return false;
+    
+    UINT numRows = 0;
+    for(UINT k=0; k<numClasses; k++){
+        if( models[k].getNumFeatures() != numInputDimensions ) return false;
+        numRows += models[k].getNumClusters();
+    }
+    if( numRows == 0 ) return false;
+    
+    floatClusters.resize( numRows, numInputDimensions );
+    floatClusterOffsets.resize( numClasses+1 );
+    UINT row = 0;
+    for(UINT k=0; k<numClasses; k++){
+        floatClusterOffsets[k] = row;
+        Matrix<double> clusters = models[k].getClusters();
+        for(UINT i=0; i<clusters.getNumRows(); i++){
+            for(UINT j=0; j<numInputDimensions; j++){
+                floatClusters[row][j] = float( clusters[i][j] );
+            }
+            row++;
+        }
+    }
+    floatClusterOffsets[numClasses] = row;
+    
+    return true;
+}
+
+bool MinDist::predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances){
+    
+    //The float prediction path classifies each row on its own
+    if( useFloatPrediction ) return Classifier::predictBatch(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    
+    if( !initBatchPrediction(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances) ) return false;
+    
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ) return true;
+    
+    //Scale the input data if needed
+    const MatrixDouble *data = &inputData;
+    MatrixDouble scaledData;
+    if( useScaling ){
+        if( !scaleBatch(inputData,scaledData,0,1) ) return false;
+        data = &scaledData;
+    }
+    
+    //Compute the distance between every row and each class model
+    for(UINT k=0; k<numClasses; k++){
+        models[k].predict( *data, predictedClassDistances, k );
+    }
+    
+    //Compute the likelihoods and predicted class label for each row, this matches the predict function
+    for(UINT i=0; i<M; i++){
+        predictedClassLabel = 0;
+        double classLikelihoodsSum = 0;
+        double minDist = numeric_limits<double>::max();
+        for(UINT k=0; k<numClasses; k++){
+            classDistances[k] = predictedClassDistances[i][k];
+            classLikelihoods[k] = classDistances[k];
+            classLikelihoodsSum += classDistances[k];
+            
+            if( classDistances[k] < minDist ){
+                minDist = classDistances[k];
+                predictedClassLabel = k;
+            }
+        }
+        
+        if( classLikelihoodsSum != 0 ){
+            for(UINT k=0; k<numClasses; k++){
+                classLikelihoods[k] = (classLikelihoodsSum-classLikelihoods[k])/classLikelihoodsSum;
+            }
+        }
+        maxLikelihood = classLikelihoods[predictedClassLabel];
+        
+        if( useNullRejection ){
+            if( minDist <= models[predictedClassLabel].getRejectionThreshold() ) predictedClassLabel = models[predictedClassLabel].getClassLabel();
+            else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+        }else predictedClassLabel = models[predictedClassLabel].getClassLabel();
+        
+        storeBatchPrediction(i,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    }
     
     return true;
 }
@@ -210,6 +388,10 @@ bool MinDist::train(LabelledClassificationData &labelledTrainingData,double gamm
 	}
     
     trained = true;
+    
+    //Build the float copy of the clusters if float prediction is enabled
+    updateFloatModel();
+    
     return true;
 }
     
@@ -220,6 +402,8 @@ bool MinDist::clear(){
     
     //Clear the MinDist variables
     models.clear();
+    floatClusters.clear();
+    floatClusterOffsets.clear();
     return true;
 }
 
@@ -327,6 +511,8 @@ bool MinDist::loadModelFromFile(fstream &file){
     numClasses = 0;
     models.clear();
     classLabels.clear();
+    floatClusters.clear();
+    floatClusterOffsets.clear();
     
     if(!file.is_open())
     {
@@ -473,6 +659,9 @@ bool MinDist::loadModelFromFile(fstream &file){
     
     trained = true;
     
+    //Build the float copy of the clusters if float prediction is enabled
+    updateFloatModel();
+    
     return true;
 }
     
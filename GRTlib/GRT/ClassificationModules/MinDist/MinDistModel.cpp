@@ -103,23 +103,35 @@ bool MinDistModel::train(UINT classLabel,MatrixDouble &trainingData,UINT numClus
 	
 }
 
-double MinDistModel::predict(const VectorDouble &inputVector){
+double MinDistModel::predict(const VectorDouble &inputVector) const{
 	
-	double minDist = numeric_limits<double>::max();
-	double dist = 0;
-	
-	for(UINT k=0; k<numClusters; k++){
-		dist = 0;
-        for(UINT n=0; n<numFeatures; n++){
-            dist += SQR( clusters[k][n]-inputVector[n] );
+    //Only compute the sqrt for the minimum distance
+	return sqrt( computeMinSquaredDistance( &inputVector[0] ) );
+}
+    
+void MinDistModel::predict(const MatrixDouble &inputData,MatrixDouble &distances,const UINT colIndex){
+    
+    const UINT M = inputData.getNumRows();
+    for(UINT i=0; i<M; i++){
+        distances[i][colIndex] = sqrt( computeMinSquaredDistance( inputData[i] ) );
+    }
+}
+    
+double MinDistModel::computeMinSquaredDistance(const double *x) const{
+    
+    //The distances to the clusters are computed a block at a time, so no memory needs to be allocated
+    double dist[ GRT_DISTANCE_KERNEL_BLOCK_SIZE ];
+    double minDist = numeric_limits<double>::max();
+    
+    for(UINT blockStart=0; blockStart<numClusters; blockStart+=GRT_DISTANCE_KERNEL_BLOCK_SIZE){
+        const UINT B = blockStart+GRT_DISTANCE_KERNEL_BLOCK_SIZE <= numClusters ? GRT_DISTANCE_KERNEL_BLOCK_SIZE : numClusters-blockStart;
+        DistanceKernels::squaredEuclidean( x, clusters[blockStart], B, clusters.getStride(), numFeatures, dist );
+        for(UINT k=0; k<B; k++){
+            if( dist[k] < minDist )
+                minDist = dist[k];
         }
-		if( dist < minDist )
-			minDist = dist;
-	}
+    }
     
-    //Only compute the sqrt for the minimum distance
-	return sqrt( minDist );
-     
     return minDist;
 }
 	
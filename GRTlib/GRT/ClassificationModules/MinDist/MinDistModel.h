@@ -57,7 +57,8 @@ public:
 	MinDistModel &operator=(const MinDistModel &rhs);
 	
 	bool train(UINT classLabel,MatrixDouble &trainingData,UINT numClusters);
-	double predict(const VectorDouble &observation);
+	double predict(const VectorDouble &observation) const;
+	void predict(const MatrixDouble &inputData,MatrixDouble &distances,const UINT colIndex);
 	void recomputeThresholdValue();
 	
 	UINT getClassLabel() const;
@@ -79,6 +80,7 @@ public:
     
 private:
     double SQR(double x){ return x*x; }
+    double computeMinSquaredDistance(const double *x) const;
 	UINT classLabel;
 	UINT numFeatures;
 	UINT numClusters;
@@ -25,9 +25,10 @@ namespace GRT{
 //Register the RandomForests module with the Classifier base class
 RegisterClassifierModule< RandomForests >  RandomForests::registerModule("RandomForests");
 
-RandomForests::RandomForests(bool useScaling,UINT numRandomSplits,UINT minNumSamplesPerNode,UINT maxDepth)
+RandomForests::RandomForests(bool useScaling,UINT numRandomSplits,UINT minNumSamplesPerNode,UINT maxDepth,UINT forestSize)
 {
     this->useScaling = useScaling;
+    this->forestSize = forestSize;
     this->numRandomSplits = numRandomSplits;
     this->minNumSamplesPerNode = minNumSamplesPerNode;
     this->maxDepth = maxDepth;
@@ -60,10 +61,8 @@ RandomForests& RandomForests::operator=(const RandomForests &rhs){
         clear();
         
         if( rhs.getTrained() ){
-            //Deep copy the forest
-            for(UINT i=0; i<rhs.forest.size(); i++){
-                this->forest.push_back( rhs.forest[i]->deepCopyTree() );
-            }
+            //Copy the forest
+            this->forest = rhs.forest;
         }
         
         this->forestSize = rhs.forestSize;
@@ -89,10 +88,8 @@ bool RandomForests::deepCopyFrom(const Classifier *classifier){
         this->clear();
         
         if( ptr->getTrained() ){
-            //Deep copy the forest
-            for(UINT i=0; i<ptr->forest.size(); i++){
-                this->forest.push_back( ptr->forest[i]->deepCopyTree() );
-            }
+            //Copy the forest
+            this->forest = ptr->forest;
         }
         
         this->forestSize = ptr->forestSize;
@@ -120,6 +117,9 @@ bool RandomForests::train(LabelledClassificationData trainingData){
         return false;
     }
     
+    //The bootstrapped datasets used to train each tree have sorted class labels, so sort the labels here so the forest's class order matches the trees
+    trainingData.sortClassLabels();
+    
     numInputDimensions = N;
     numClasses = K;
     classLabels = trainingData.getClassLabels();
@@ -132,7 +132,6 @@ bool RandomForests::train(LabelledClassificationData trainingData){
     }
     
     //Train the random forest
-    forestSize = 10;
     Random random;
     
     DecisionTree tree;
@@ -142,24 +141,44 @@ bool RandomForests::train(LabelledClassificationData trainingData){
     tree.setMinNumSamplesPerNode( minNumSamplesPerNode );
     tree.setMaxDepth( maxDepth );
     
+    if( !forest.init( N, K ) ){
+        errorLog << "train(LabelledClassificationData labelledTrainingData) - Failed to init the forest!" << endl;
+        return false;
+    }
+    
     for(UINT i=0; i<forestSize; i++){
-        LabelledClassificationData data = trainingData.getBootstrappedDataset();
+        //The bootstrapped view only holds the indexs of the samples, so the training data is not copied for each tree
+        LabelledClassificationDataView data = trainingData.getBootstrappedView();
         
         if( !tree.train( data ) ){
             errorLog << "train(LabelledClassificationData labelledTrainingData) - Failed to train tree at forest index: " << i << endl;
             return false;
         }
         
-        //Deep copy the tree into the forest
-        forest.push_back( tree.deepCopyTree() );
+        //Compile the tree into the flat forest
+        if( !forest.addTree( tree.getTree() ) ){
+            clear();
+            errorLog << "train(LabelledClassificationData labelledTrainingData) - Failed to add tree to the forest at forest index: " << i << endl;
+            return false;
+        }
     }
     
     //Flag that the algorithm has been trained
     trained = true;
+    
+    //Check the forest can be used for float prediction if it is enabled
+    updateFloatModel();
+    
     return trained;
 }
 
 bool RandomForests::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool RandomForests::predictInplace(VectorDouble &inputVector){
+    
+    if( useFloatPrediction ) return predictAsFloat( inputVector );
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
@@ -189,18 +208,76 @@ bool RandomForests::predict(VectorDouble inputVector){
         classDistances[j] = 0;
     }
     
-    VectorDouble y;
-    for(UINT i=0; i<forestSize; i++){
-        if( !forest[i]->predict(inputVector, y) ){
-            errorLog << "predict(VectorDouble inputVector) - Tree " << i << " failed prediction!" << endl;
-            return false;
-        }
-        
-        for(UINT j=0; j<numClasses; j++){
-            classDistances[j] += y[j];
+    //Sum the class probabilities from each tree, in tree order
+    if( !forest.predict( &inputVector[0], &classDistances[0] ) ){
+        errorLog << "predict(VectorDouble inputVector) - A tree in the forest failed prediction!" << endl;
+        return false;
+    }
+    
+    predictFromClassDistances();
+    
+    return true;
+}
+
+bool RandomForests::predictFloatInplace(VectorFloat &inputVector){
+    
+    if( !trained ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - Model Not Trained!" << endl;
+        return false;
+    }
+    
+    predictedClassLabel = 0;
+	maxLikelihood = -10000;
+    
+	if( inputVector.size() != numInputDimensions ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The size of the input vector (" << inputVector.size() << ") does not match the num features in the model (" << numInputDimensions << endl;
+		return false;
+	}
+    
+    if( useScaling ){
+        for(UINT n=0; n<numInputDimensions; n++){
+            inputVector[n] = float( scale(inputVector[n], ranges[n].minValue, ranges[n].maxValue, 0, 1) );
         }
     }
     
+    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
+    if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
+    
+    //Sum the class probabilities from each tree, in tree order
+    if( !forest.predict( &inputVector[0], &classDistances[0] ) ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - A tree in the forest failed prediction!" << endl;
+        return false;
+    }
+    
+    predictFromClassDistances();
+    
+    return true;
+}
+
+bool RandomForests::predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const{
+    
+    //The input is scaled into the prediction's buffer, so nothing in this instance is written to
+    const VectorDouble *x = initSharedPrediction( inputVector, prediction, 0, 1 );
+    if( x == NULL ) return false;
+    
+    for(UINT j=0; j<numClasses; j++){
+        prediction.classDistances[j] = 0;
+    }
+    
+    //Sum the class probabilities from each tree, in tree order
+    if( !forest.predict( &(*x)[0], &prediction.classDistances[0] ) ) return false;
+    
+    predictFromClassDistances( prediction.classDistances, prediction.classLikelihoods, prediction.predictedClassLabel, prediction.maxLikelihood, prediction.bestDistance );
+    
+    return true;
+}
+
+void RandomForests::predictFromClassDistances(){
+    predictFromClassDistances( classDistances, classLikelihoods, predictedClassLabel, maxLikelihood, bestDistance );
+}
+    
+void RandomForests::predictFromClassDistances(const VectorDouble &classDistances,VectorDouble &classLikelihoods,UINT &predictedClassLabel,double &maxLikelihood,double &bestDistance) const{
+    
     maxLikelihood = 0;
     bestDistance = 0;
     UINT bestIndex = 0;
@@ -215,6 +292,57 @@ bool RandomForests::predict(VectorDouble inputVector){
     }
     
     predictedClassLabel = classLabels[ bestIndex ];
+}
+
+bool RandomForests::buildFloatModel(){
+    //The flat forest always stores the float thresholds, so there is nothing else to build
+    return forest.getNumTrees() > 0;
+}
+    
+bool RandomForests::predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances){
+    
+    //The float prediction path classifies each row on its own
+    if( useFloatPrediction ) return Classifier::predictBatch(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    
+    if( !initBatchPrediction(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances) ) return false;
+    
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ) return true;
+    
+    //Scale the input data if needed
+    const MatrixDouble *data = &inputData;
+    MatrixDouble scaledData;
+    if( useScaling ){
+        if( !scaleBatch(inputData,scaledData,0,1) ) return false;
+        data = &scaledData;
+    }
+    
+    //Sum the class probabilities from each tree for every row
+    if( !forest.predictBatch( *data, predictedClassDistances ) ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances) - A tree in the forest failed prediction!" << endl;
+        return false;
+    }
+    
+    //Compute the likelihoods and predicted class label for each row, this matches the predict function
+    for(UINT i=0; i<M; i++){
+        const double *sums = predictedClassDistances[i];
+        maxLikelihood = 0;
+        bestDistance = 0;
+        UINT bestIndex = 0;
+        for(UINT k=0; k<numClasses; k++){
+            classDistances[k] = sums[k];
+            classLikelihoods[k] = classDistances[k] / double(forestSize);
+            
+            if( classLikelihoods[k] > maxLikelihood ){
+                maxLikelihood = classLikelihoods[k];
+                bestDistance = classDistances[k];
+                bestIndex = k;
+            }
+        }
+        predictedClassLabel = classLabels[ bestIndex ];
+        
+        storeBatchPrediction(i,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    }
     
     return true;
 }
@@ -225,13 +353,6 @@ bool RandomForests::clear(){
     Classifier::clear();
     
     //Delete the forest
-    for(UINT i=0; i<forest.size(); i++){
-        if( forest[i] != NULL ){
-            forest[i]->clear();
-            delete forest[i];
-            forest[i] = NULL;
-        }
-    }
     forest.clear();
     
     return true;
@@ -247,9 +368,16 @@ bool RandomForests::print() const{
     cout << "ForestBuilt: " << (trained ? 1 : 0) << endl;
     
     cout << "Forest:\n";
-    for(UINT i=0; i<forestSize; i++){
+    for(UINT i=0; i<forest.getNumTrees(); i++){
         cout << "Tree: " << i+1 << endl;
-        forest[i]->print();
+        
+        //Rebuild the tree from the flat forest so it can be printed
+        DecisionTreeNode *tree = forest.buildTree( i );
+        if( tree != NULL ){
+            tree->print();
+            tree->clear();
+            delete tree;
+        }
     }
     
     return true;
@@ -279,10 +407,54 @@ bool RandomForests::saveModelToFile(fstream &file) const{
 		return false;
 	}
     
+    if( !saveModelSettingsToFile( file ) ){
+        return false;
+    }
+    
+    if( trained ){
+        file << "Forest:\n";
+        if( !forest.saveToFile( file ) ){
+            errorLog << "saveModelToFile(fstream &file) - Failed to save the forest to file!" << endl;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool RandomForests::saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) const{
+    
+    //The settings are written as text, the forest arrays are written as binary sections
+    if( !file.beginTextSection( sectionName ) ){
+        errorLog << "saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) - Failed to start section: " << sectionName << endl;
+        return false;
+    }
+    
+    const bool settingsSaved = saveModelSettingsToFile( file.getTextStream() );
+    if( !file.endTextSection() || !settingsSaved ){
+        return false;
+    }
+    
+    if( trained && !forest.saveToBinaryFile( file, sectionName + "/Forest" ) ){
+        errorLog << "saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) - Failed to save the forest!" << endl;
+        return false;
+    }
+    
+    return true;
+}
+
+bool RandomForests::saveModelSettingsToFile(fstream &file) const{
+    
 	//Write the header info
-	file << "GRT_RANDOM_FOREST_MODEL_FILE_V1.0\n";
+	file << "GRT_RANDOM_FOREST_MODEL_FILE_V2.0\n";
     file << "NumFeatures: "<<numInputDimensions<<endl;
 	file << "NumClasses: "<<numClasses<<endl;
+    file << "ClassLabels: ";
+    for(UINT k=0; k<classLabels.size(); k++){
+        file << classLabels[k];
+        if( k < classLabels.size()-1 ) file << "\t";
+    }
+    file << endl;
     file << "UseScaling: " << useScaling << endl;
     file << "UseNullRejection: " << useNullRejection << endl;
 	
@@ -300,17 +472,6 @@ bool RandomForests::saveModelToFile(fstream &file) const{
     file << "MaxDepth: " << maxDepth << endl;
     file << "ForestBuilt: " << (trained ? 1 : 0) << endl;
     
-    if( trained ){
-        file << "Forest:\n";
-        for(UINT i=0; i<forestSize; i++){
-            file << "Tree: " << i+1 << endl;
-            if( !forest[i]->saveToFile( file ) ){
-                errorLog << "saveModelToFile(fstream &file) - Failed to save tree " << i << " to file!" << endl;
-                return false;
-            }
-        }
-    }
-    
     return true;
 }
 
@@ -339,15 +500,142 @@ bool RandomForests::loadModelFromFile(fstream &file){
         return false;
     }
     
+    std::string word;
+    bool hasFlatForest = false;
+    if( !loadModelSettingsFromFile( file, hasFlatForest ) ){
+        return false;
+    }
+    
+    if( trained && hasFlatForest ){
+        file >> word;
+        if(word != "Forest:"){
+            errorLog << "loadModelFromFile(string filename) - Could not find the Forest!" << endl;
+            return false;
+        }
+        
+        if( !forest.loadFromFile( file ) ){
+            clear();
+            errorLog << "loadModelFromFile(fstream &file) - Failed to load the forest from file!" << endl;
+            return false;
+        }
+        
+        if( forest.getNumTrees() != forestSize || forest.getNumInputDimensions() != numInputDimensions || forest.getNumClasses() != numClasses ){
+            clear();
+            errorLog << "loadModelFromFile(fstream &file) - The forest does not match the model!" << endl;
+            return false;
+        }
+    }else if( trained ){
+        file >> word;
+        if(word != "Forest:"){
+            errorLog << "loadModelFromFile(string filename) - Could not find the Forest!" << endl;
+            return false;
+        }
+        
+        if( !forest.init( numInputDimensions, numClasses ) ){
+            clear();
+            errorLog << "loadModelFromFile(fstream &file) - Failed to init the forest!" << endl;
+            return false;
+        }
+        
+        UINT treeIndex;
+        for(UINT i=0; i<forestSize; i++){
+            
+            file >> word;
+            if(word != "Tree:"){
+                errorLog << "loadModelFromFile(string filename) - Could not find the Tree Header!" << endl;
+                return false;
+            }
+            file >> treeIndex;
+            
+            if( treeIndex != i+1 ){
+                errorLog << "loadModelFromFile(string filename) - Incorrect tree index: " << treeIndex << endl;
+                return false;
+            }
+            
+            //Create a new DTree
+            DecisionTreeNode *tree = new DecisionTreeNode;
+            
+            if( tree == NULL ){
+                errorLog << "loadModelFromFile(fstream &file) - Failed to create new Tree!" << endl;
+                return false;
+            }
+            
+            tree->setParent( NULL );
+            if( !tree->loadFromFile( file ) ){
+                tree->clear();
+                delete tree;
+                clear();
+                errorLog << "loadModelFromFile(fstream &file) - Failed to load tree from file!" << endl;
+                return false;
+            }
+            
+            //Compile the tree into the flat forest, the node tree is not needed after this
+            const bool treeAdded = forest.addTree( tree );
+            tree->clear();
+            delete tree;
+            
+            if( !treeAdded ){
+                clear();
+                errorLog << "loadModelFromFile(fstream &file) - Failed to add tree to the forest!" << endl;
+                return false;
+            }
+        }
+    }
+    
+    //Check the forest can be used for float prediction if it is enabled
+    updateFloatModel();
+    
+    return true;
+}
+
+bool RandomForests::loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName){
+    
+    clear();
+    
+    if( !file.beginTextSection( sectionName ) ){
+        errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - Failed to find section: " << sectionName << endl;
+        return false;
+    }
+    
+    bool hasFlatForest = false;
+    if( !loadModelSettingsFromFile( file.getTextStream(), hasFlatForest ) ){
+        return false;
+    }
+    
+    if( trained ){
+        //If the file is memory mapped the forest uses the arrays in the file directly
+        if( !forest.loadFromBinaryFile( file, sectionName + "/Forest" ) ){
+            clear();
+            errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - Failed to load the forest!" << endl;
+            return false;
+        }
+        
+        if( forest.getNumTrees() != forestSize || forest.getNumInputDimensions() != numInputDimensions || forest.getNumClasses() != numClasses ){
+            clear();
+            errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - The forest does not match the model!" << endl;
+            return false;
+        }
+    }
+    
+    updateFloatModel();
+    
+    return true;
+}
+
+bool RandomForests::loadModelSettingsFromFile(fstream &file,bool &hasFlatForest){
+    
     std::string word;
     
     //Find the file type header
     file >> word;
-    if(word != "GRT_RANDOM_FOREST_MODEL_FILE_V1.0"){
+    if(word != "GRT_RANDOM_FOREST_MODEL_FILE_V1.0" && word != "GRT_RANDOM_FOREST_MODEL_FILE_V2.0"){
         errorLog << "loadModelFromFile(string filename) - Could not find Model File Header" << endl;
         return false;
     }
     
+    //V2.0 files store the class labels and the flat forest, V1.0 files store each tree node by node
+    hasFlatForest = word == "GRT_RANDOM_FOREST_MODEL_FILE_V2.0";
+    
     file >> word;
     if(word != "NumFeatures:"){
         errorLog << "loadModelFromFile(string filename) - Could not find NumFeatures!" << endl;
@@ -362,6 +650,23 @@ bool RandomForests::loadModelFromFile(fstream &file){
     }
     file >> numClasses;
     
+    classLabels.resize( numClasses );
+    if( hasFlatForest ){
+        file >> word;
+        if(word != "ClassLabels:"){
+            errorLog << "loadModelFromFile(string filename) - Could not find ClassLabels!" << endl;
+            return false;
+        }
+        for(UINT k=0; k<numClasses; k++){
+            file >> classLabels[k];
+        }
+    }else{
+        warningLog << "loadModelFromFile(string filename) - The model file does not contain the class labels, they will be set to 1 to " << numClasses << endl;
+        for(UINT k=0; k<numClasses; k++){
+            classLabels[k] = k+1;
+        }
+    }
+    
     file >> word;
     if(word != "UseScaling:"){
         errorLog << "loadModelFromFile(string filename) - Could not find UseScaling!" << endl;
@@ -427,50 +732,13 @@ bool RandomForests::loadModelFromFile(fstream &file){
     }
     file >> trained;
     
-    if( trained ){
-        file >> word;
-        if(word != "Forest:"){
-            errorLog << "loadModelFromFile(string filename) - Could not find the Forest!" << endl;
-            return false;
-        }
-        
-        UINT treeIndex;
-        for(UINT i=0; i<forestSize; i++){
-            
-            file >> word;
-            if(word != "Tree:"){
-                errorLog << "loadModelFromFile(string filename) - Could not find the Tree Header!" << endl;
-                return false;
-            }
-            file >> treeIndex;
-            
-            if( treeIndex != i+1 ){
-                errorLog << "loadModelFromFile(string filename) - Incorrect tree index: " << treeIndex << endl;
-                return false;
-            }
-            
-            //Create a new DTree
-            DecisionTreeNode *tree = new DecisionTreeNode;
-            
-            if( tree == NULL ){
-                errorLog << "loadModelFromFile(fstream &file) - Failed to create new Tree!" << endl;
-                return false;
-            }
-            
-            tree->setParent( NULL );
-            if( !tree->loadFromFile( file ) ){
-                errorLog << "loadModelFromFile(fstream &file) - Failed to load tree from file!" << endl;
-                return false;
-            }
-            
-            //Add the tree to the forest
-            forest.push_back( tree );
-        }
-    }
-    
     return true;
 }
     
+UINT RandomForests::getForestSize()const{
+    return forestSize;
+}
+
 UINT RandomForests::getNumRandomSpilts()const{
     return numRandomSplits;
 }
@@ -483,6 +751,38 @@ UINT RandomForests::getMaxDepth()const{
     return maxDepth;
 }
     
+const FlatDecisionForest& RandomForests::getFlatForest() const{
+    return forest;
+}
+    
+vector< DecisionTreeNode* > RandomForests::getForest() const{
+    
+    vector< DecisionTreeNode* > trees;
+    trees.reserve( forest.getNumTrees() );
+    for(UINT i=0; i<forest.getNumTrees(); i++){
+        DecisionTreeNode *tree = forest.buildTree( i );
+        if( tree == NULL ){
+            errorLog << "getForest() - Failed to rebuild the tree at forest index: " << i << endl;
+            for(UINT j=0; j<trees.size(); j++){
+                trees[j]->clear();
+                delete trees[j];
+            }
+            trees.clear();
+            return trees;
+        }
+        trees.push_back( tree );
+    }
+    return trees;
+}
+    
+bool RandomForests::setForestSize(const UINT forestSize){
+    if( forestSize > 0 ){
+        this->forestSize = forestSize;
+        return true;
+    }
+    return false;
+}
+
 bool RandomForests::setNumRandomSpilts(const UINT numRandomSplits){
     if( numRandomSplits > 0 ){
         this->numRandomSplits = numRandomSplits;
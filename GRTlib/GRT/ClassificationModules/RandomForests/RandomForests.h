@@ -48,8 +48,9 @@ public:
      @param UINT numRandomSplits: sets the number of random spilts that will be used to search for the best spliting value for each node. Default value = 100
      @param UINT minNumSamplesPerNode: sets the minimum number of samples that are allowed per node, if the number of samples is below that, the node will become a leafNode.  Default value = 5
      @param UINT maxDepth: sets the maximum depth of the tree. Default value = 10
+     @param UINT forestSize: sets the number of trees in the forest. Default value = 10
      */
-	RandomForests(bool useScaling=false,UINT numRandomSplits=100,UINT minNumSamplesPerNode=5,UINT maxDepth=10);
+	RandomForests(bool useScaling=false,UINT numRandomSplits=100,UINT minNumSamplesPerNode=5,UINT maxDepth=10,UINT forestSize=10);
     
     /**
      Defines the copy constructor.
@@ -98,6 +99,62 @@ public:
     */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
+    /**
+     This predicts the class of the inputVector by walking the flat forest with its float thresholds.
+     This overrides the predictFloatInplace function in the MLBase base class.
+     
+     @param VectorFloat &inputVector: a reference to the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictFloatInplace(VectorFloat &inputVector);
+    
+    /**
+     The RandomForests algorithm supports the float prediction path.
+     
+     @return returns true
+     */
+    virtual bool getSupportsFloatPrediction() const{ return true; }
+    
+    /**
+     This predicts the class of the inputVector without modifying the RandomForests instance, the results are written to the prediction.
+     This overrides the predictShared function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassifierPrediction &prediction: the prediction that the results will be written to
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const;
+    
+    /**
+     The RandomForests algorithm supports shared prediction.
+     
+     @return returns true
+     */
+    virtual bool getSupportsSharedPrediction() const{ return true; }
+    
+    /**
+     This classifies each row of the inputData.  Blocks of rows are pushed through the flat forest one tree at a time, which gives
+     exactly the same results as calling predict on each row.
+     This overrides the predictBatch function in the Classifier base class.
+     
+     @param const MatrixDouble &inputData: the data to classify, each row is one sample
+     @param vector< UINT > &predictedClassLabels: will be filled with the predicted class label of each row
+     @param MatrixDouble &predictedClassLikelihoods: will be filled with the class likelihoods of each row
+     @param MatrixDouble &predictedClassDistances: will be filled with the class distances of each row
+     @return returns true if the batch was classified, false otherwise
+     */
+    virtual bool predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances);
+    
     /**
      This function clears the RandomForests module, removing any trained model and setting all the base variables to their default values.
      
@@ -122,7 +179,7 @@ public:
     virtual bool saveModelToFile(string filename) const;
     
     /**
-     This saves the trained RandomForests model to a file.
+     This saves the trained RandomForests model to a file.  The forest is saved in its flat form, one line per node.
      This overrides the saveModelToFile function in the Classifier base class.
      
      @param fstream &file: a reference to the file the RandomForests model will be saved to
@@ -140,7 +197,8 @@ public:
     virtual bool loadModelFromFile(string filename);
     
     /**
-     This loads a trained RandomForests model from a file.
+     This loads a trained RandomForests model from a file.  Files saved with the older node by node format can still be loaded,
+     the class labels are not stored in those files so they will be set to 1 to K.
      This overrides the loadModelFromFile function in the Classifier base class.
      
      @param fstream &file: a reference to the file the RandomForests model will be loaded from
@@ -148,6 +206,28 @@ public:
      */
     virtual bool loadModelFromFile(fstream &file);
     
+    /**
+     This saves the trained RandomForests model to a binary model file.  The settings are written as text and the flat forest is written
+     as binary sections.
+     This overrides the saveModelToBinaryFile function in the MLBase class.
+     
+     @param BinaryModelWriter &file: a reference to the binary model file the model will be saved to
+     @param const string &sectionName: the name of the section the model should be saved to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) const;
+    
+    /**
+     This loads a trained RandomForests model from a binary model file.  If the file is memory mapped the forest uses the arrays in
+     the file without copying them.
+     This overrides the loadModelFromBinaryFile function in the MLBase class.
+     
+     @param BinaryModelReader &file: a reference to the binary model file the model will be loaded from
+     @param const string &sectionName: the name of the section the model was saved to
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName);
+    
     /**
      Gets the current training mode. This will be one of the TrainingModes enums.
      
@@ -155,6 +235,13 @@ public:
      */
     UINT getTrainingMode() const;
     
+    /**
+     Gets the number of trees in the forest.
+     
+     @return returns the number of trees in the forest
+     */
+    UINT getForestSize() const;
+    
     /**
      Gets the number of random spilts that will be used to search for the best spliting value for each node.
      
@@ -178,7 +265,33 @@ public:
     UINT getMaxDepth() const;
     
     /**
-     Sets the number of steps that will be used to search for the best spliting value for each node.
+     Gets the flat forest that is used for predictions.  Each tree is compiled into the flat forest as it is trained.
+     It will be empty if the model has not been trained.
+     
+     @return returns a const reference to the flat forest
+     */
+    const FlatDecisionForest& getFlatForest() const;
+    
+    /**
+     Gets a copy of each tree in the forest as a DecisionTreeNode tree.  The forest only stores the flat form of the trees, so each
+     tree is rebuilt from the flat forest.  The user is in charge of cleaning up the memory so must delete each pointer when they
+     no longer need it.  The vector will be empty if the model has not been trained.
+     
+     @return returns a vector of pointers to copies of the trees in the forest
+     */
+    vector< DecisionTreeNode* > getForest() const;
+    
+    /**
+     Sets the number of trees in the forest.  This will be used the next time the model is trained.
+     Value must be larger than zero.
+     
+     @param const UINT forestSize: the number of trees in the forest
+     @return returns true if the parameter was set, false otherwise
+     */
+    bool setForestSize(const UINT forestSize);
+    
+    /**
+     Sets the number of stepsthat will be used to search for the best spliting value for each node.
      
      A higher value will increase the chances of building a better model, but will take longer to train the model.
      Value must be larger than zero.
@@ -212,7 +325,13 @@ private:
     UINT numRandomSplits;
     UINT minNumSamplesPerNode;
     UINT maxDepth;
-    vector< DecisionTreeNode* > forest;
+    FlatDecisionForest forest;
+    
+    bool saveModelSettingsToFile(fstream &file) const;
+    bool loadModelSettingsFromFile(fstream &file,bool &hasFlatForest);
+    void predictFromClassDistances();
+    void predictFromClassDistances(const VectorDouble &classDistances,VectorDouble &classLikelihoods,UINT &predictedClassLabel,double &maxLikelihood,double &bestDistance) const;
+    virtual bool buildFloatModel();
     
     static RegisterClassifierModule< RandomForests > registerModule;
     
@@ -166,6 +166,10 @@ bool SVM::train(LabelledClassificationData trainingData){
 }
 
 bool SVM::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool SVM::predictInplace(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - The SVM model has not been trained!" << endl;
@@ -481,7 +485,7 @@ bool SVM::convertLabelledClassificationDataToLIBSVMFormat(LabelledClassification
         prob.x[i] = new svm_node[numInputDimensions+1];
         for(UINT j=0; j<numInputDimensions; j++){
             prob.x[i][j].index = j+1;
-            prob.x[i][j].value = trainingData[i].getSample()[j];
+            prob.x[i][j].value = trainingData[i][j];
         }
         prob.x[i][numInputDimensions].index = -1; //Assign the final node value
         prob.x[i][numInputDimensions].value = 0;
@@ -59,6 +59,8 @@ Softmax& Softmax::operator=(const Softmax &rhs){
         this->minChange = rhs.minChange;
         this->maxNumIterations = rhs.maxNumIterations;
         this->models = rhs.models;
+        this->floatWeights = rhs.floatWeights;
+        this->floatBias = rhs.floatBias;
         
         //Copy the base classifier variables
         copyBaseVariables( (Classifier*)&rhs );
@@ -77,6 +79,8 @@ bool Softmax::deepCopyFrom(const Classifier *classifier){
         this->minChange = ptr->minChange;
         this->maxNumIterations = ptr->maxNumIterations;
         this->models = ptr->models;
+        this->floatWeights = ptr->floatWeights;
+        this->floatBias = ptr->floatBias;
         
         //Copy the base classifier variables
         return copyBaseVariables( classifier );
@@ -125,10 +129,20 @@ bool Softmax::train(LabelledClassificationData trainingData){
     
     //Flag that the algorithm has been trained
     trained = true;
+    
+    //Build the float copy of the weights if float prediction is enabled
+    updateFloatModel();
+    
     return trained;
 }
 
 bool Softmax::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool Softmax::predictInplace(VectorDouble &inputVector){
+    
+    if( useFloatPrediction ) return predictAsFloat( inputVector );
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
@@ -154,19 +168,71 @@ bool Softmax::predict(VectorDouble inputVector){
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
     if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
     
-    //Loop over each class and compute the likelihood of the input data coming from class k. Pick the class with the highest likelihood
+    //Loop over each class and compute the likelihood of the input data coming from class k
+    for(UINT k=0; k<numClasses; k++){
+        classDistances[k] = models[k].compute( inputVector );
+    }
+    
+    predictFromClassDistances();
+    
+    return true;
+}
+
+bool Softmax::predictFloatInplace(VectorFloat &inputVector){
+    
+    if( !trained ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - Model Not Trained!" << endl;
+        return false;
+    }
+    
+    predictedClassLabel = 0;
+	maxLikelihood = -10000;
+    
+	if( inputVector.size() != numInputDimensions ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The size of the input vector (" << inputVector.size() << ") does not match the num features in the model (" << numInputDimensions << endl;
+		return false;
+	}
+    
+    if( floatBias.size() != numClasses ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The float model has not been built, float prediction must be enabled first!" << endl;
+        return false;
+    }
+    
+    if( useScaling ){
+        for(UINT n=0; n<numInputDimensions; n++){
+            inputVector[n] = float( scale(inputVector[n], ranges[n].minValue, ranges[n].maxValue, 0, 1) );
+        }
+    }
+    
+    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
+    if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
+    
+    //Compute the weighted sum of every class model in one pass over the weights
+    floatSums.resize( numClasses );
+    MatrixKernels::gemv( floatWeights[0], floatWeights.getStride(), &inputVector[0], &floatSums[0], numClasses, numInputDimensions );
+    for(UINT k=0; k<numClasses; k++){
+        classDistances[k] = 1.0 / (1.0+exp( -(floatBias[k]+floatSums[k]) ));
+    }
+    
+    predictFromClassDistances();
+    
+    return true;
+}
+
+void Softmax::predictFromClassDistances(){
+    
+    //Pick the class with the highest likelihood
     double sum = 0;
     double bestEstimate = numeric_limits<double>::min();
     UINT bestIndex = 0;
     for(UINT k=0; k<numClasses; k++){
-        double estimate = models[k].compute( inputVector );
+        const double estimate = classDistances[k];
         
         if( estimate > bestEstimate ){
             bestEstimate = estimate;
             bestIndex = k;
         }
         
-        classDistances[k] = estimate;
         classLikelihoods[k] = estimate;
         sum += estimate;
     }
@@ -179,10 +245,84 @@ bool Softmax::predict(VectorDouble inputVector){
         //If the sum is less than the value above then none of the models found a positive class
         maxLikelihood = bestEstimate;
         predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
-        return true;
+        return;
     }
     maxLikelihood = classLikelihoods[bestIndex];
     predictedClassLabel = classLabels[bestIndex];
+}
+
+bool Softmax::buildFloatModel(){
+    
+    if( models.size() != numClasses || numClasses == 0 ) return false;
+    
+    floatWeights.resize( numClasses, numInputDimensions );
+    floatBias.resize( numClasses );
+    for(UINT k=0; k<numClasses; k++){
+        if( models[k].w.size() != numInputDimensions ) return false;
+        for(UINT n=0; n<numInputDimensions; n++){
+            floatWeights[k][n] = float( models[k].w[n] );
+        }
+        floatBias[k] = models[k].w0;
+    }
+    
+    return true;
+}
+    
+bool Softmax::predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances){
+    
+    //The float prediction path classifies each row on its own
+    if( useFloatPrediction ) return Classifier::predictBatch(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    
+    if( !initBatchPrediction(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances) ) return false;
+    
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ) return true;
+    
+    //Scale the input data if needed
+    const MatrixDouble *data = &inputData;
+    MatrixDouble scaledData;
+    if( useScaling ){
+        if( !scaleBatch(inputData,scaledData,0,1) ) return false;
+        data = &scaledData;
+    }
+    
+    //Compute the estimate of every row for each class model
+    for(UINT k=0; k<numClasses; k++){
+        models[k].compute( *data, predictedClassDistances, k );
+    }
+    
+    //Compute the likelihoods and predicted class label for each row, this matches the predict function
+    for(UINT i=0; i<M; i++){
+        double sum = 0;
+        double bestEstimate = numeric_limits<double>::min();
+        UINT bestIndex = 0;
+        for(UINT k=0; k<numClasses; k++){
+            const double estimate = predictedClassDistances[i][k];
+            
+            if( estimate > bestEstimate ){
+                bestEstimate = estimate;
+                bestIndex = k;
+            }
+            
+            classDistances[k] = estimate;
+            classLikelihoods[k] = estimate;
+            sum += estimate;
+        }
+        
+        if( sum > 1.0e-5 ){
+            for(UINT k=0; k<numClasses; k++){
+                classLikelihoods[k] /= sum;
+            }
+            maxLikelihood = classLikelihoods[bestIndex];
+            predictedClassLabel = classLabels[bestIndex];
+        }else{
+            //None of the models found a positive class
+            maxLikelihood = bestEstimate;
+            predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+        }
+        
+        storeBatchPrediction(i,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    }
     
     return true;
 }
@@ -228,7 +368,7 @@ bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,LabelledClas
             UINT i = randomTrainingOrder[m];
             
             //Compute the error, given the current weights
-            error = y[i] - model.compute( data[i].getSample() );
+            error = y[i] - model.compute( data[i].getData() );
             errorSum += error;
             
             //Update the weights
@@ -264,6 +404,8 @@ bool Softmax::clear(){
     
     //Clear the Softmax model
     models.clear();
+    floatWeights.clear();
+    floatBias.clear();
     
     return true;
 }
@@ -342,6 +484,8 @@ bool Softmax::loadModelFromFile(fstream &file){
     numClasses = 0;
     models.clear();
     classLabels.clear();
+    floatWeights.clear();
+    floatBias.clear();
     
     if(!file.is_open())
     {
@@ -448,6 +592,9 @@ bool Softmax::loadModelFromFile(fstream &file){
     //Flag that the model has been trained
     trained = true;
     
+    //Build the float copy of the weights if float prediction is enabled
+    updateFloatModel();
+    
     return true;
 }
     
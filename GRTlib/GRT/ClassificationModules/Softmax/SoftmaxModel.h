@@ -69,6 +69,26 @@ public:
         return (1.0 / (1.0+exp(-sum)));
     }
     
+    double compute(const double *x){
+        double sum = w0;
+        for(UINT i=0; i<N; i++){
+            sum += x[i]*w[i];
+        }
+        return (1.0 / (1.0+exp(-sum)));
+    }
+    
+    void compute(const MatrixDouble &inputData,MatrixDouble &results,const UINT colIndex){
+        const UINT M = inputData.getNumRows();
+        for(UINT i=0; i<M; i++){
+            const double *x = inputData[i];
+            double sum = w0;
+            for(UINT j=0; j<N; j++){
+                sum += x[j]*w[j];
+            }
+            results[i][colIndex] = (1.0 / (1.0+exp(-sum)));
+        }
+    }
+    
     UINT classLabel;
     UINT N; //The number of dimensions
     VectorDouble w; //The coefficents
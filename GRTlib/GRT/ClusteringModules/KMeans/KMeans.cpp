@@ -147,16 +147,15 @@ bool KMeans::predict(VectorDouble inputVector,UINT &predictedClusterLabel,double
 	maxLikelihood = 0;
 	if( clusterLikelihoods.size() != numClusters )
         clusterLikelihoods.resize( numClusters );
+    
+    //We don't need to compute the sqrt as it works without it and is faster
+    if( numClusters > 0 ){
+        DistanceKernels::squaredEuclidean( &inputVector[0], clusters[0], numClusters, clusters.getStride(), numInputDimensions, &clusterLikelihoods[0] );
+    }
 	
 	for(UINT i=0; i<numClusters; i++){
 		
-		double dist = 0;
-		for(UINT j=0; j<numInputDimensions; j++){
-			dist += SQR( inputVector[j]-clusters[i][j] );
-		}
-        
-        //We don't need to compute the sqrt as it works without it and is faster
-		clusterLikelihoods[i] = dist;
+		const double dist = clusterLikelihoods[i];
 		sum += dist;
 				
 		if( dist < minDist ){
@@ -411,22 +410,24 @@ bool KMeans::trainModel(MatrixDouble &data){
 }
 
 UINT KMeans::estep(const MatrixDouble &data) {
-		UINT k,m,n,kmin;
-		double dmin,d;
+		UINT k,m,kmin,blockStart,B;
+		double dmin;
+		double d[ GRT_DISTANCE_KERNEL_BLOCK_SIZE ];
 		nchg = 0;
 		kmin = 0;
 
 		//Reset Count
 		for (k=0; k < numClusters; k++) count[k] = 0;
 
-		//Search for the closest center and reasign if needed
+		//Search for the closest center and reasign if needed, the distances to the centers are computed a block at a time
 		for (m=0; m < numTrainingSamples; m++) {
 			dmin = 9.99e+99; //Set dmin to a really big value
-			for (k=0; k < numClusters; k++) {
-				d = 0.0;
-				for (n=0; n < numInputDimensions; n++)
-					d += SQR( data[m][n]-clusters[k][n] );
-				if (d <= dmin){ dmin = d; kmin = k; }
+			for (blockStart=0; blockStart < numClusters; blockStart+=GRT_DISTANCE_KERNEL_BLOCK_SIZE) {
+				B = blockStart+GRT_DISTANCE_KERNEL_BLOCK_SIZE <= numClusters ? GRT_DISTANCE_KERNEL_BLOCK_SIZE : numClusters-blockStart;
+				DistanceKernels::squaredEuclidean( data[m], clusters[blockStart], B, clusters.getStride(), numInputDimensions, d );
+				for (k=0; k < B; k++) {
+					if (d[k] <= dmin){ dmin = d[k]; kmin = blockStart+k; }
+				}
 			}
 			if ( kmin != assign[m] ){
                 nchg++;
@@ -465,11 +466,7 @@ double KMeans::calculateTheta(const MatrixDouble &data){
 
 	for(UINT m=0; m < numTrainingSamples; m++){
 		UINT k = assign[m];
-		double sum = 0;
-		for(UINT n=0; n < numInputDimensions; n++){
-				sum += SQR(clusters[k][n] - data[m][n]);
-		}
-		theta += sum;
+		theta += DistanceKernels::squaredEuclidean( clusters[k], data[m], numInputDimensions );
 	}
 
 	return theta;
@@ -344,16 +344,20 @@ bool SelfOrganizingMap::saveModelToFile(string filename) const{
 }
 
 bool SelfOrganizingMap::saveModelToFile(fstream &file) const{
+    return saveModelToFile( (ostream&)file );
+}
+    
+bool SelfOrganizingMap::saveModelToFile(ostream &file) const{
     
     if( !trained ){
-        errorLog << "saveModelToFile(fstream &file) - Can't save model to file, the model has not been trained!" << endl;
+        errorLog << "saveModelToFile(ostream &file) - Can't save model to file, the model has not been trained!" << endl;
         return false;
     }
     
     file << "GRT_SELF_ORGANIZING_MAP_MODEL_FILE_V1.0\n";
     
     if( !saveClustererSettingsToFile( file ) ){
-        errorLog << "saveModelToFile(fstream &file) - Failed to save cluster settings to file!" << endl;
+        errorLog << "saveModelToFile(ostream &file) - Failed to save cluster settings to file!" << endl;
         return false;
     }
     
@@ -374,7 +378,7 @@ bool SelfOrganizingMap::saveModelToFile(fstream &file) const{
         file << "Neurons: \n";
         for(UINT i=0; i<neurons.size(); i++){
             if( !neurons[i].saveNeuronToFile( file ) ){
-                errorLog << "saveModelToFile(fstream &file) - Failed to save neuron to file!" << endl;
+                errorLog << "saveModelToFile(ostream &file) - Failed to save neuron to file!" << endl;
                 return false;
             }
         }
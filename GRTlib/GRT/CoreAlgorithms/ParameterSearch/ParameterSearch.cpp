@@ -0,0 +1,769 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ParameterSearch.h"
+#include "../../ClassificationModules/KNN/KNN.h"
+#include "../../ClassificationModules/SVM/SVM.h"
+#include "../../ClassificationModules/DTW/DTW.h"
+#include "../../ClassificationModules/RandomForests/RandomForests.h"
+#include "../../RegressionModules/ArtificialNeuralNetworks/MLP/MLP.h"
+
+namespace GRT{
+
+////////////////////////////////////// Built In Setters //////////////////////////////////////
+//Values are rounded to the nearest integer for parameters that take an integer
+
+static UINT roundToUINT(const double value){
+    return value > 0 ? (UINT)floor( value + 0.5 ) : 0;
+}
+
+static bool setClassifierNullRejectionCoeff(GestureRecognitionPipeline &pipeline,const double value){
+    Classifier *classifier = pipeline.getClassifier();
+    return classifier != NULL && classifier->setNullRejectionCoeff( value );
+}
+
+static bool setKNNK(GestureRecognitionPipeline &pipeline,const double value){
+    KNN *knn = dynamic_cast< KNN* >( pipeline.getClassifier() );
+    return knn != NULL && knn->setK( roundToUINT( value ) );
+}
+
+static bool setSVMC(GestureRecognitionPipeline &pipeline,const double value){
+    SVM *svm = dynamic_cast< SVM* >( pipeline.getClassifier() );
+    return svm != NULL && svm->setC( value );
+}
+
+static bool setSVMGamma(GestureRecognitionPipeline &pipeline,const double value){
+    SVM *svm = dynamic_cast< SVM* >( pipeline.getClassifier() );
+    if( svm == NULL ) return false;
+    
+    //The gamma value can only be set if the automatic gamma is disabled
+    svm->enableAutoGamma( false );
+    return svm->setGamma( value );
+}
+
+static bool setDTWWarpingRadius(GestureRecognitionPipeline &pipeline,const double value){
+    DTW *dtw = dynamic_cast< DTW* >( pipeline.getClassifier() );
+    return dtw != NULL && dtw->setWarpingRadius( value );
+}
+
+static bool setRandomForestsForestSize(GestureRecognitionPipeline &pipeline,const double value){
+    RandomForests *forest = dynamic_cast< RandomForests* >( pipeline.getClassifier() );
+    return forest != NULL && forest->setForestSize( roundToUINT( value ) );
+}
+
+static bool setRandomForestsMaxDepth(GestureRecognitionPipeline &pipeline,const double value){
+    RandomForests *forest = dynamic_cast< RandomForests* >( pipeline.getClassifier() );
+    return forest != NULL && forest->setMaxDepth( roundToUINT( value ) );
+}
+
+static bool setMLPNumHiddenNeurons(GestureRecognitionPipeline &pipeline,const double value){
+    //The MLP sets the size of its layers when it is initialized, so it is initialized again with the same input and output layers
+    MLP *mlp = dynamic_cast< MLP* >( pipeline.getRegressifier() );
+    if( mlp == NULL || mlp->getNumInputNeurons() == 0 ) return false;
+    return mlp->init( mlp->getNumInputNeurons(), roundToUINT( value ), mlp->getNumOutputNeurons() );
+}
+
+////////////////////////////////////// Data Type Helpers //////////////////////////////////////
+//The search is written once for the three types of training data, these overloads hide the differences between them
+
+static bool spiltData(LabelledClassificationData &data,const UINT K,const bool useStratifiedSampling,const unsigned long long randomSeed){
+    return data.spiltDataIntoKFolds( K, useStratifiedSampling, randomSeed );
+}
+
+static bool spiltData(LabelledTimeSeriesClassificationData &data,const UINT K,const bool useStratifiedSampling,const unsigned long long randomSeed){
+    return data.spiltDataIntoKFolds( K, useStratifiedSampling, randomSeed );
+}
+
+static bool spiltData(LabelledRegressionData &data,const UINT K,const bool useStratifiedSampling,const unsigned long long randomSeed){
+    return data.spiltDataIntoKFolds( K, randomSeed );
+}
+
+//The classification training folds are views of the round data, so the candidates do not each copy the training samples for every fold
+static LabelledClassificationDataView getTrainingFold(const LabelledClassificationData &data,const UINT k){
+    return data.getTrainingFoldView( k );
+}
+
+static LabelledTimeSeriesClassificationData getTrainingFold(const LabelledTimeSeriesClassificationData &data,const UINT k){
+    return data.getTrainingFoldData( k );
+}
+
+static LabelledRegressionData getTrainingFold(const LabelledRegressionData &data,const UINT k){
+    return data.getTrainingFoldData( k );
+}
+
+static double getFoldScore(const GestureRecognitionPipeline &pipeline,const LabelledClassificationData &data){
+    return pipeline.getTestAccuracy();
+}
+
+static double getFoldScore(const GestureRecognitionPipeline &pipeline,const LabelledTimeSeriesClassificationData &data){
+    return pipeline.getTestAccuracy();
+}
+
+static double getFoldScore(const GestureRecognitionPipeline &pipeline,const LabelledRegressionData &data){
+    return pipeline.getTestRMSError();
+}
+
+static bool getIsRegressionData(const LabelledClassificationData &data){ return false; }
+static bool getIsRegressionData(const LabelledTimeSeriesClassificationData &data){ return false; }
+static bool getIsRegressionData(const LabelledRegressionData &data){ return true; }
+
+//Orders the results by rank, see ParameterSearch::getLeaderboard
+class ParameterSearchResultComparator{
+public:
+    ParameterSearchResultComparator(const bool higherScoreIsBetter):higherScoreIsBetter(higherScoreIsBetter){}
+
+    bool operator()(const ParameterSearchResult &a,const ParameterSearchResult &b) const{
+        if( a.failed != b.failed ) return !a.failed;
+        if( a.round != b.round ) return a.round > b.round;
+        if( a.stopped != b.stopped ) return !a.stopped;
+        if( a.score != b.score ) return higherScoreIsBetter ? a.score > b.score : a.score < b.score;
+        return a.candidateIndex < b.candidateIndex;
+    }
+
+    bool higherScoreIsBetter;
+};
+
+//Orders candidate indexes by the rank of their results
+class ParameterSearchResultIndexComparator{
+public:
+    ParameterSearchResultIndexComparator(const vector< ParameterSearchResult > &results,const bool higherScoreIsBetter):results(results),comparator(higherScoreIsBetter){}
+
+    bool operator()(const UINT a,const UINT b) const{
+        return comparator( results[a], results[b] );
+    }
+
+    const vector< ParameterSearchResult > &results;
+    ParameterSearchResultComparator comparator;
+};
+
+////////////////////////////////////// Worker Threads //////////////////////////////////////
+
+/**
+ Shared state for one of the worker threads.  The next candidate index and the completed scores are shared by all the workers and are protected
+ by the mutex.  Each candidate is only evaluated by one worker, so the workers write to their own entries of the results without locking.
+ */
+template< class T >
+struct ParameterSearchWorkerData{
+    const ParameterSearch *search;
+    const GestureRecognitionPipeline *pipeline;
+    const T *roundData;
+    const vector< UINT > *candidateIndexes;
+    vector< ParameterSearchResult > *results;
+    UINT kFoldValue;
+    UINT numToKeep;
+    UINT round;
+    double dataFraction;
+    bool useEarlyStopping;
+    bool higherScoreIsBetter;
+    UINT *nextIndex;
+    vector< double > *completedScores;
+    pthread_mutex_t *mutex;
+};
+
+template< class T >
+void* parameterSearchWorkerThread(void *workerData){
+
+    ParameterSearchWorkerData< T > *worker = (ParameterSearchWorkerData< T >*)workerData;
+    const UINT K = worker->kFoldValue;
+
+    while( true ){
+        pthread_mutex_lock( worker->mutex );
+        if( *worker->nextIndex >= worker->candidateIndexes->size() ){
+            pthread_mutex_unlock( worker->mutex );
+            break;
+        }
+        ParameterSearchResult &result = (*worker->results)[ (*worker->candidateIndexes)[ (*worker->nextIndex)++ ] ];
+        pthread_mutex_unlock( worker->mutex );
+
+        result.round = worker->round;
+        result.dataFraction = worker->dataFraction;
+        result.numFolds = K;
+        result.score = 0;
+        result.foldScores.clear();
+        result.stopped = false;
+
+        Timer timer;
+        timer.start();
+
+        //Each candidate gets its own deep copy of the pipeline, the folds are shared read-only
+        GestureRecognitionPipeline pipeline( *worker->pipeline );
+        bool ok = worker->search->setParameters( pipeline, result.parameterValues );
+        double scoreSum = 0;
+
+        for(UINT k=0; k<K && ok; k++){
+            ok = pipeline.train( getTrainingFold( *worker->roundData, k ) ) && pipeline.test( worker->roundData->getTestFoldData(k) );
+            if( !ok ) break;
+
+            const double foldScore = getFoldScore( pipeline, *worker->roundData );
+            result.foldScores.push_back( foldScore );
+            scoreSum += foldScore;
+
+            //The best score the candidate can still get assumes the remaining folds are perfect, an accuracy of 100% or an RMS error of 0
+            if( worker->useEarlyStopping && k+1 < K ){
+                const double bestPossibleScore = worker->higherScoreIsBetter ? (scoreSum + (K-k-1)*100.0) / K : scoreSum / K;
+                pthread_mutex_lock( worker->mutex );
+                const vector< double > &completedScores = *worker->completedScores;
+                if( completedScores.size() >= worker->numToKeep ){
+                    const double threshold = completedScores[ worker->numToKeep-1 ];
+                    result.stopped = worker->higherScoreIsBetter ? bestPossibleScore < threshold : bestPossibleScore > threshold;
+                }
+                pthread_mutex_unlock( worker->mutex );
+                if( result.stopped ) break;
+            }
+        }
+
+        result.trainingTime += timer.getMilliSeconds();
+        result.failed = !ok;
+        if( !ok ) continue;
+
+        result.score = scoreSum / result.foldScores.size();
+
+        //Keep the scores of the completed candidates sorted best first, so the score a candidate has to beat to be kept is at numToKeep-1
+        if( !result.stopped ){
+            pthread_mutex_lock( worker->mutex );
+            vector< double > &completedScores = *worker->completedScores;
+            vector< double >::iterator iter = completedScores.begin();
+            while( iter != completedScores.end() && (worker->higherScoreIsBetter ? *iter >= result.score : *iter <= result.score) ) iter++;
+            completedScores.insert( iter, result.score );
+            pthread_mutex_unlock( worker->mutex );
+        }
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////// ParameterSearch //////////////////////////////////////
+
+ParameterSearch::ParameterSearch(const UINT searchMode,const UINT kFoldValue,const UINT numThreads){
+    this->searchMode = searchMode;
+    this->kFoldValue = kFoldValue;
+    this->numThreads = numThreads;
+    numRandomCandidates = 20;
+    reductionFactor = 3;
+    minDataFraction = 0.1;
+    randomSeed = 0;
+    useEarlyStopping = true;
+    useStratifiedSampling = false;
+    higherScoreIsBetter = true;
+    searchTime = 0;
+
+    debugLog.setProceedingText("[DEBUG ParameterSearch]");
+    errorLog.setProceedingText("[ERROR ParameterSearch]");
+    trainingLog.setProceedingText("[TRAINING ParameterSearch]");
+    warningLog.setProceedingText("[WARNING ParameterSearch]");
+}
+
+ParameterSearch::~ParameterSearch(){
+}
+
+bool ParameterSearch::addParameter(const string &name,const VectorDouble &values,ParameterSearchSetter setter){
+
+    if( values.size() == 0 ){
+        errorLog << "addParameter(const string &name,const VectorDouble &values,ParameterSearchSetter setter) - The parameter " << name << " has no values!" << endl;
+        return false;
+    }
+
+    SearchParameter parameter;
+    parameter.name = name;
+    parameter.setter = setter != NULL ? setter : getBuiltInSetter( name );
+    parameter.values = values;
+
+    if( parameter.setter == NULL ){
+        errorLog << "addParameter(const string &name,const VectorDouble &values,ParameterSearchSetter setter) - There is no built in setter for the parameter " << name << ", a setter must be given!" << endl;
+        return false;
+    }
+
+    parameters.push_back( parameter );
+    return true;
+}
+
+bool ParameterSearch::addParameter(const string &name,const double minValue,const double maxValue,const bool logScale,const bool integerValues,ParameterSearchSetter setter){
+
+    if( minValue > maxValue || (logScale && minValue <= 0) ){
+        errorLog << "addParameter(const string &name,const double minValue,const double maxValue,...) - The range of the parameter " << name << " is not valid!" << endl;
+        return false;
+    }
+
+    SearchParameter parameter;
+    parameter.name = name;
+    parameter.setter = setter != NULL ? setter : getBuiltInSetter( name );
+    parameter.minValue = minValue;
+    parameter.maxValue = maxValue;
+    parameter.logScale = logScale;
+    parameter.integerValues = integerValues;
+
+    if( parameter.setter == NULL ){
+        errorLog << "addParameter(const string &name,const double minValue,const double maxValue,...) - There is no built in setter for the parameter " << name << ", a setter must be given!" << endl;
+        return false;
+    }
+
+    parameters.push_back( parameter );
+    return true;
+}
+
+bool ParameterSearch::clear(){
+    parameters.clear();
+    results.clear();
+    leaderboard.clear();
+    searchTime = 0;
+    return true;
+}
+
+bool ParameterSearch::search(const GestureRecognitionPipeline &pipeline,const LabelledClassificationData &trainingData){
+    if( !pipeline.getIsClassifierSet() ){
+        errorLog << "search(const GestureRecognitionPipeline &pipeline,const LabelledClassificationData &trainingData) - The pipeline does not have a classifier!" << endl;
+        return false;
+    }
+    return search_( pipeline, trainingData );
+}
+
+bool ParameterSearch::search(const GestureRecognitionPipeline &pipeline,const LabelledTimeSeriesClassificationData &trainingData){
+    if( !pipeline.getIsClassifierSet() ){
+        errorLog << "search(const GestureRecognitionPipeline &pipeline,const LabelledTimeSeriesClassificationData &trainingData) - The pipeline does not have a classifier!" << endl;
+        return false;
+    }
+    return search_( pipeline, trainingData );
+}
+
+bool ParameterSearch::search(const GestureRecognitionPipeline &pipeline,const LabelledRegressionData &trainingData){
+    if( !pipeline.getIsRegressifierSet() ){
+        errorLog << "search(const GestureRecognitionPipeline &pipeline,const LabelledRegressionData &trainingData) - The pipeline does not have a regressifier!" << endl;
+        return false;
+    }
+    return search_( pipeline, trainingData );
+}
+
+template< class T >
+bool ParameterSearch::search_(const GestureRecognitionPipeline &pipeline,const T &trainingData){
+
+    Timer timer;
+    timer.start();
+
+    results.clear();
+    leaderboard.clear();
+    searchTime = 0;
+    higherScoreIsBetter = !getIsRegressionData( trainingData );
+
+    if( trainingData.getNumSamples() < kFoldValue ){
+        errorLog << "search_(const GestureRecognitionPipeline &pipeline,const T &trainingData) - There are fewer training samples (" << trainingData.getNumSamples() << ") than folds (" << kFoldValue << ")!" << endl;
+        return false;
+    }
+
+    vector< VectorDouble > candidates;
+    if( !createCandidates( candidates ) ){
+        return false;
+    }
+
+    results.resize( candidates.size() );
+    vector< UINT > candidateIndexes( candidates.size() );
+    for(UINT i=0; i<candidates.size(); i++){
+        results[i].candidateIndex = i;
+        results[i].parameterValues = candidates[i];
+        candidateIndexes[i] = i;
+    }
+
+    //The grid and random searches are one round on all the data.  Successive halving runs a round for each time the candidates are reduced, the
+    //last round uses all the data and each round before it uses reductionFactor times less data than the next, but never less than minDataFraction
+    UINT numRounds = 1;
+    if( searchMode == SUCCESSIVE_HALVING ){
+        UINT numCandidates = (UINT)candidates.size();
+        while( numCandidates > reductionFactor ){
+            numCandidates = (numCandidates + reductionFactor - 1) / reductionFactor;
+            numRounds++;
+        }
+    }
+    const UINT maxNumSubsets = (UINT)floor( 1.0 / minDataFraction + 1.0e-9 );
+
+    bool result = true;
+    for(UINT round=0; round<numRounds && result; round++){
+
+        //The data of this round is one of numSubsets equal parts of the training data, each part must be large enough to be split into the folds
+        UINT numSubsets = 1;
+        for(UINT r=round+1; r<numRounds; r++) numSubsets *= reductionFactor;
+        numSubsets = min( numSubsets, min( maxNumSubsets, trainingData.getNumSamples() / kFoldValue ) );
+        if( numSubsets == 0 ) numSubsets = 1;
+
+        const unsigned long long roundSeed = randomSeed != 0 ? randomSeed + 2*round + 1 : 0;
+        T roundData( trainingData );
+        if( numSubsets > 1 ){
+            T subsets( trainingData );
+            if( !spiltData( subsets, numSubsets, useStratifiedSampling, roundSeed ) && !spiltData( subsets, numSubsets, false, roundSeed ) ){
+                warningLog << "search_(const GestureRecognitionPipeline &pipeline,const T &trainingData) - Failed to split the training data into " << numSubsets << " subsets, round " << round << " will use all the data." << endl;
+                numSubsets = 1;
+            }else roundData = subsets.getTestFoldData( 0 );
+        }
+
+        if( !spiltData( roundData, kFoldValue, useStratifiedSampling, roundSeed != 0 ? roundSeed + 1 : 0 ) && !spiltData( roundData, kFoldValue, false, roundSeed != 0 ? roundSeed + 1 : 0 ) ){
+            errorLog << "search_(const GestureRecognitionPipeline &pipeline,const T &trainingData) - Failed to split the training data into " << kFoldValue << " folds!" << endl;
+            result = false;
+            break;
+        }
+
+        //Successive halving keeps the best 1/reductionFactor of the candidates for the next round, the other searches only need the best candidate
+        const UINT numToKeep = round+1 < numRounds ? (UINT)(candidateIndexes.size() + reductionFactor - 1) / reductionFactor : 1;
+
+        trainingLog << "Round " << round << ": evaluating " << candidateIndexes.size() << " candidates on " << roundData.getNumSamples() << " samples" << endl;
+
+        if( !evaluateCandidates( pipeline, roundData, candidateIndexes, numToKeep, round, 1.0 / numSubsets ) ){
+            result = false;
+            break;
+        }
+
+        //Keep the best candidates that completed this round
+        std::sort( candidateIndexes.begin(), candidateIndexes.end(), ParameterSearchResultIndexComparator( results, higherScoreIsBetter ) );
+        UINT numKept = 0;
+        while( numKept < numToKeep && numKept < candidateIndexes.size() && !results[ candidateIndexes[numKept] ].failed && !results[ candidateIndexes[numKept] ].stopped ) numKept++;
+        candidateIndexes.resize( numKept );
+
+        if( numKept == 0 ){
+            errorLog << "search_(const GestureRecognitionPipeline &pipeline,const T &trainingData) - All the candidates failed in round " << round << "!" << endl;
+            result = false;
+        }
+    }
+
+    buildLeaderboard();
+    searchTime = timer.getMilliSeconds();
+
+    return result;
+}
+
+template< class T >
+bool ParameterSearch::evaluateCandidates(const GestureRecognitionPipeline &pipeline,const T &roundData,const vector< UINT > &candidateIndexes,const UINT numToKeep,const UINT round,const double dataFraction){
+
+    const UINT numWorkers = min( numThreads, (UINT)candidateIndexes.size() );
+    UINT nextIndex = 0;
+    vector< double > completedScores;
+    pthread_mutex_t mutex;
+    pthread_mutex_init( &mutex, NULL );
+
+    vector< ParameterSearchWorkerData< T > > workers( numWorkers );
+    for(UINT i=0; i<numWorkers; i++){
+        workers[i].search = this;
+        workers[i].pipeline = &pipeline;
+        workers[i].roundData = &roundData;
+        workers[i].candidateIndexes = &candidateIndexes;
+        workers[i].results = &results;
+        workers[i].kFoldValue = kFoldValue;
+        workers[i].numToKeep = numToKeep;
+        workers[i].round = round;
+        workers[i].dataFraction = dataFraction;
+        workers[i].useEarlyStopping = useEarlyStopping;
+        workers[i].higherScoreIsBetter = higherScoreIsBetter;
+        workers[i].nextIndex = &nextIndex;
+        workers[i].completedScores = &completedScores;
+        workers[i].mutex = &mutex;
+    }
+
+    //Start the worker threads, the calling thread acts as the first worker. If a thread can not be started then its candidates will be run by the other workers
+    vector< pthread_t > threads( numWorkers );
+    vector< bool > threadStarted( numWorkers, false );
+    for(UINT i=1; i<numWorkers; i++){
+        threadStarted[i] = pthread_create( &threads[i], NULL, parameterSearchWorkerThread< T >, &workers[i] ) == 0;
+        if( !threadStarted[i] ){
+            warningLog << "evaluateCandidates(...) - Failed to start worker thread " << i << "!" << endl;
+        }
+    }
+
+    if( numWorkers > 0 ) parameterSearchWorkerThread< T >( &workers[0] );
+
+    for(UINT i=1; i<numWorkers; i++){
+        if( threadStarted[i] ) pthread_join( threads[i], NULL );
+    }
+    pthread_mutex_destroy( &mutex );
+
+    return true;
+}
+
+bool ParameterSearch::createCandidates(vector< VectorDouble > &candidates){
+
+    candidates.clear();
+    const UINT numParameters = (UINT)parameters.size();
+
+    if( numParameters == 0 ){
+        errorLog << "createCandidates(vector< VectorDouble > &candidates) - No parameters have been added!" << endl;
+        return false;
+    }
+
+    bool allParametersHaveValues = true;
+    for(UINT j=0; j<numParameters; j++){
+        if( parameters[j].values.size() == 0 ) allParametersHaveValues = false;
+    }
+
+    if( searchMode == GRID_SEARCH && !allParametersHaveValues ){
+        errorLog << "createCandidates(vector< VectorDouble > &candidates) - The grid search needs a list of values for every parameter!" << endl;
+        return false;
+    }
+
+    if( searchMode == GRID_SEARCH || (searchMode == SUCCESSIVE_HALVING && allParametersHaveValues) ){
+        //Every combination of the values, the last parameter changes fastest
+        vector< UINT > index( numParameters, 0 );
+        while( true ){
+            VectorDouble candidate( numParameters );
+            for(UINT j=0; j<numParameters; j++) candidate[j] = parameters[j].values[ index[j] ];
+            candidates.push_back( candidate );
+
+            int j = (int)numParameters-1;
+            while( j >= 0 && ++index[j] == parameters[j].values.size() ){
+                index[j] = 0;
+                j--;
+            }
+            if( j < 0 ) break;
+        }
+        return true;
+    }
+
+    if( searchMode != RANDOM_SEARCH && searchMode != SUCCESSIVE_HALVING ){
+        errorLog << "createCandidates(vector< VectorDouble > &candidates) - Unknown search mode: " << searchMode << endl;
+        return false;
+    }
+
+    Random random( randomSeed );
+    for(UINT i=0; i<numRandomCandidates; i++){
+        VectorDouble candidate( numParameters );
+        for(UINT j=0; j<numParameters; j++){
+            const SearchParameter &parameter = parameters[j];
+            if( parameter.values.size() > 0 ){
+                const UINT index = min( (UINT)random.getRandomNumberInt( 0, (int)parameter.values.size() ), (UINT)parameter.values.size()-1 );
+                candidate[j] = parameter.values[ index ];
+            }else{
+                if( parameter.logScale ) candidate[j] = exp( random.getRandomNumberUniform( log( parameter.minValue ), log( parameter.maxValue ) ) );
+                else candidate[j] = random.getRandomNumberUniform( parameter.minValue, parameter.maxValue );
+                if( parameter.integerValues ) candidate[j] = floor( candidate[j] + 0.5 );
+            }
+        }
+        candidates.push_back( candidate );
+    }
+
+    return true;
+}
+
+bool ParameterSearch::buildLeaderboard(){
+
+    leaderboard = results;
+    std::sort( leaderboard.begin(), leaderboard.end(), ParameterSearchResultComparator( higherScoreIsBetter ) );
+
+    for(UINT i=0; i<leaderboard.size(); i++){
+        leaderboard[i].rank = i+1;
+        results[ leaderboard[i].candidateIndex ].rank = i+1;
+    }
+
+    return true;
+}
+
+bool ParameterSearch::setParameters(GestureRecognitionPipeline &pipeline,const VectorDouble &parameterValues) const{
+
+    if( parameterValues.size() != parameters.size() ){
+        errorLog << "setParameters(GestureRecognitionPipeline &pipeline,const VectorDouble &parameterValues) - The number of values (" << parameterValues.size() << ") does not match the number of parameters (" << parameters.size() << ")!" << endl;
+        return false;
+    }
+
+    for(UINT j=0; j<parameters.size(); j++){
+        if( !parameters[j].setter( pipeline, parameterValues[j] ) ){
+            errorLog << "setParameters(GestureRecognitionPipeline &pipeline,const VectorDouble &parameterValues) - Failed to set the parameter " << parameters[j].name << " to " << parameterValues[j] << "!" << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ParameterSearch::setBestParameters(GestureRecognitionPipeline &pipeline) const{
+
+    if( leaderboard.size() == 0 || leaderboard[0].failed ){
+        errorLog << "setBestParameters(GestureRecognitionPipeline &pipeline) - There is no result, the search has not been run or it failed!" << endl;
+        return false;
+    }
+
+    return setParameters( pipeline, leaderboard[0].parameterValues );
+}
+
+bool ParameterSearch::printLeaderboard(const UINT numResults) const{
+
+    if( leaderboard.size() == 0 ) return false;
+
+    cout << "Rank\tCandidate";
+    for(UINT j=0; j<parameters.size(); j++) cout << "\t" << parameters[j].name;
+    cout << "\t" << (higherScoreIsBetter ? "Accuracy" : "RMSError") << "\tFolds\tRound\tData\tStopped\tTime(ms)" << endl;
+
+    const UINT N = numResults > 0 && numResults < leaderboard.size() ? numResults : (UINT)leaderboard.size();
+    for(UINT i=0; i<N; i++){
+        const ParameterSearchResult &result = leaderboard[i];
+        cout << result.rank << "\t" << result.candidateIndex;
+        for(UINT j=0; j<result.parameterValues.size(); j++) cout << "\t" << result.parameterValues[j];
+        if( result.failed ) cout << "\tFAILED";
+        else cout << "\t" << result.score;
+        cout << "\t" << result.foldScores.size() << "/" << result.numFolds << "\t" << result.round << "\t" << result.dataFraction;
+        cout << "\t" << (result.stopped ? "yes" : "no") << "\t" << result.trainingTime << endl;
+    }
+
+    return true;
+}
+
+vector< ParameterSearchResult > ParameterSearch::getLeaderboard() const{
+    return leaderboard;
+}
+
+ParameterSearchResult ParameterSearch::getBestResult() const{
+    if( leaderboard.size() == 0 ) return ParameterSearchResult();
+    return leaderboard[0];
+}
+
+UINT ParameterSearch::getSearchMode() const{
+    return searchMode;
+}
+
+UINT ParameterSearch::getKFoldValue() const{
+    return kFoldValue;
+}
+
+UINT ParameterSearch::getNumThreads() const{
+    return numThreads;
+}
+
+UINT ParameterSearch::getNumRandomCandidates() const{
+    return numRandomCandidates;
+}
+
+UINT ParameterSearch::getReductionFactor() const{
+    return reductionFactor;
+}
+
+double ParameterSearch::getMinDataFraction() const{
+    return minDataFraction;
+}
+
+unsigned long long ParameterSearch::getRandomSeed() const{
+    return randomSeed;
+}
+
+bool ParameterSearch::getUseEarlyStopping() const{
+    return useEarlyStopping;
+}
+
+bool ParameterSearch::getUseStratifiedSampling() const{
+    return useStratifiedSampling;
+}
+
+UINT ParameterSearch::getNumParameters() const{
+    return (UINT)parameters.size();
+}
+
+vector< SearchParameter > ParameterSearch::getParameters() const{
+    return parameters;
+}
+
+UINT ParameterSearch::getNumCandidates() const{
+    return (UINT)results.size();
+}
+
+UINT ParameterSearch::getNumStoppedCandidates() const{
+    UINT numStopped = 0;
+    for(UINT i=0; i<results.size(); i++){
+        if( results[i].stopped ) numStopped++;
+    }
+    return numStopped;
+}
+
+double ParameterSearch::getSearchTime() const{
+    return searchTime;
+}
+
+bool ParameterSearch::setSearchMode(const UINT searchMode){
+    if( searchMode != GRID_SEARCH && searchMode != RANDOM_SEARCH && searchMode != SUCCESSIVE_HALVING ){
+        errorLog << "setSearchMode(const UINT searchMode) - Unknown search mode: " << searchMode << endl;
+        return false;
+    }
+    this->searchMode = searchMode;
+    return true;
+}
+
+bool ParameterSearch::setKFoldValue(const UINT kFoldValue){
+    if( kFoldValue < 2 ){
+        errorLog << "setKFoldValue(const UINT kFoldValue) - The number of folds must be at least 2!" << endl;
+        return false;
+    }
+    this->kFoldValue = kFoldValue;
+    return true;
+}
+
+bool ParameterSearch::setNumThreads(const UINT numThreads){
+    if( numThreads == 0 ){
+        errorLog << "setNumThreads(const UINT numThreads) - The number of threads must be greater than zero!" << endl;
+        return false;
+    }
+    this->numThreads = numThreads;
+    return true;
+}
+
+bool ParameterSearch::setNumRandomCandidates(const UINT numRandomCandidates){
+    if( numRandomCandidates == 0 ){
+        errorLog << "setNumRandomCandidates(const UINT numRandomCandidates) - The number of candidates must be greater than zero!" << endl;
+        return false;
+    }
+    this->numRandomCandidates = numRandomCandidates;
+    return true;
+}
+
+bool ParameterSearch::setReductionFactor(const UINT reductionFactor){
+    if( reductionFactor < 2 ){
+        errorLog << "setReductionFactor(const UINT reductionFactor) - The reduction factor must be at least 2!" << endl;
+        return false;
+    }
+    this->reductionFactor = reductionFactor;
+    return true;
+}
+
+bool ParameterSearch::setMinDataFraction(const double minDataFraction){
+    if( minDataFraction <= 0 || minDataFraction > 1 ){
+        errorLog << "setMinDataFraction(const double minDataFraction) - The fraction must be in the range (0 1]!" << endl;
+        return false;
+    }
+    this->minDataFraction = minDataFraction;
+    return true;
+}
+
+bool ParameterSearch::setRandomSeed(const unsigned long long randomSeed){
+    this->randomSeed = randomSeed;
+    return true;
+}
+
+bool ParameterSearch::setUseEarlyStopping(const bool useEarlyStopping){
+    this->useEarlyStopping = useEarlyStopping;
+    return true;
+}
+
+bool ParameterSearch::setUseStratifiedSampling(const bool useStratifiedSampling){
+    this->useStratifiedSampling = useStratifiedSampling;
+    return true;
+}
+
+ParameterSearchSetter ParameterSearch::getBuiltInSetter(const string &name){
+    if( name == "Classifier.nullRejectionCoeff" ) return setClassifierNullRejectionCoeff;
+    if( name == "KNN.K" ) return setKNNK;
+    if( name == "SVM.C" ) return setSVMC;
+    if( name == "SVM.gamma" ) return setSVMGamma;
+    if( name == "DTW.warpingRadius" ) return setDTWWarpingRadius;
+    if( name == "RandomForests.forestSize" ) return setRandomForestsForestSize;
+    if( name == "RandomForests.maxDepth" ) return setRandomForestsMaxDepth;
+    if( name == "MLP.numHiddenNeurons" ) return setMLPNumHiddenNeurons;
+    return NULL;
+}
+
+} //End of namespace GRT
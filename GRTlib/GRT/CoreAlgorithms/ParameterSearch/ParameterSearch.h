@@ -0,0 +1,352 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The ParameterSearch class searches the parameters of the classifier (or regressifier) of a GestureRecognitionPipeline using k-fold
+ cross validation, and ranks the candidates it tried in a leaderboard.
+
+ Three search modes are supported:
+ - GRID_SEARCH: every combination of the values of the parameters is tried.
+ - RANDOM_SEARCH: a fixed number of candidates are drawn at random from the values (or ranges) of the parameters.
+ - SUCCESSIVE_HALVING: the candidates (the grid if every parameter has a list of values, random candidates otherwise) are first evaluated on a
+   small part of the training data, only the best 1/reductionFactor of them are evaluated again on reductionFactor times more data, and so on
+   until one candidate is left or all the data is used.
+
+ Each candidate is a copy of the pipeline passed to the search function with the parameter values set by a ParameterSearchSetter.  Setters are
+ built in for the common parameters (see getBuiltInSetter), custom setters can be passed to addParameter.  The candidates are evaluated on a pool
+ of worker threads, which share the training data and its folds read-only.  All the candidates of a round use the same folds.
+
+ If early stopping is enabled, a candidate is stopped after any fold once its best possible score (the score it would get if it scored perfectly
+ on all the remaining folds) can no longer place it among the candidates that are kept (the best candidate for the grid and random searches,
+ the best 1/reductionFactor for successive halving).  This never drops a candidate that could have been kept, so the winner is the same with or
+ without early stopping, but which of the losing candidates are stopped depends on the order the workers finish in.
+
+ If the pipeline has pre processing or feature extraction modules, setting a FeatureCache on the pipeline lets the candidates share the output
+ of the front end (see GestureRecognitionPipeline::setFeatureCache).
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_PARAMETER_SEARCH_HEADER
+#define GRT_PARAMETER_SEARCH_HEADER
+
+#include <pthread.h>
+#include "../../CoreModules/GestureRecognitionPipeline.h"
+
+namespace GRT{
+
+/**
+ Sets one parameter of a pipeline.  The setter should return false if the pipeline does not have the module the parameter belongs to, or if
+ the value is not valid for the parameter.
+ */
+typedef bool (*ParameterSearchSetter)(GestureRecognitionPipeline &pipeline,const double value);
+
+//One of the parameters of a ParameterSearch
+class SearchParameter{
+public:
+    SearchParameter(){
+        setter = NULL;
+        minValue = 0;
+        maxValue = 0;
+        logScale = false;
+        integerValues = false;
+    }
+
+    string name;                    //The name of the parameter
+    ParameterSearchSetter setter;   //Sets the parameter on a pipeline
+    VectorDouble values;            //The values to search, this is empty if the parameter is searched over a range
+    double minValue;                //The minimum value of the range
+    double maxValue;                //The maximum value of the range
+    bool logScale;                  //If true then random values are drawn uniformly from the log of the range
+    bool integerValues;             //If true then random values are rounded to the nearest integer
+};
+
+//The result of one candidate of a ParameterSearch
+class ParameterSearchResult{
+public:
+    ParameterSearchResult(){
+        candidateIndex = 0;
+        rank = 0;
+        score = 0;
+        numFolds = 0;
+        round = 0;
+        dataFraction = 0;
+        stopped = false;
+        failed = false;
+        trainingTime = 0;
+    }
+
+    UINT candidateIndex;            //The index of the candidate, in the order the candidates were created
+    UINT rank;                      //The position of the candidate in the leaderboard, starting at 1
+    VectorDouble parameterValues;   //The value of each parameter, in the order the parameters were added
+    double score;                   //The mean cross validation accuracy (classification) or RMS error (regression) of the folds that were run in the last round
+    VectorDouble foldScores;        //The accuracy or RMS error of each fold that was run in the last round
+    UINT numFolds;                  //The number of folds in the last round
+    UINT round;                     //The last round the candidate was evaluated in, this is always 0 for the grid and random searches
+    double dataFraction;            //The fraction of the training data that was used in the last round
+    bool stopped;                   //True if the candidate was stopped early in the last round
+    bool failed;                    //True if the pipeline failed to train or test, or a parameter could not be set
+    double trainingTime;            //The time spent training and testing the candidate in all rounds, in milliseconds
+};
+
+class ParameterSearch : public GRTBase{
+public:
+    /**
+     Default Constructor.
+
+     @param const UINT searchMode: the search mode, this should be one of the SearchModes enums.  Default value = GRID_SEARCH
+     @param const UINT kFoldValue: the number of folds used to evaluate each candidate.  Default value = 5
+     @param const UINT numThreads: the number of threads used to evaluate the candidates.  Default value = 1
+     */
+    ParameterSearch(const UINT searchMode = GRID_SEARCH,const UINT kFoldValue = 5,const UINT numThreads = 1);
+
+    /**
+     Default Destructor.
+     */
+    virtual ~ParameterSearch();
+
+    /**
+     Adds a parameter that is searched over a list of values.  If the setter is NULL then the built in setter with the same name is used, see
+     getBuiltInSetter.
+
+     @param const string &name: the name of the parameter
+     @param const VectorDouble &values: the values to search
+     @param ParameterSearchSetter setter: the function that sets the parameter on a pipeline.  Default value = NULL
+     @return returns true if the parameter was added, false otherwise
+     */
+    bool addParameter(const string &name,const VectorDouble &values,ParameterSearchSetter setter = NULL);
+
+    /**
+     Adds a parameter that is searched over a range.  A parameter with a range can only be used by the random search, or by successive halving
+     (which then uses random candidates).
+
+     @param const string &name: the name of the parameter
+     @param const double minValue: the minimum value of the range
+     @param const double maxValue: the maximum value of the range
+     @param const bool logScale: if true then values are drawn uniformly from the log of the range, in which case minValue must be larger than zero.  Default value = false
+     @param const bool integerValues: if true then values are rounded to the nearest integer.  Default value = false
+     @param ParameterSearchSetter setter: the function that sets the parameter on a pipeline.  Default value = NULL
+     @return returns true if the parameter was added, false otherwise
+     */
+    bool addParameter(const string &name,const double minValue,const double maxValue,const bool logScale = false,const bool integerValues = false,ParameterSearchSetter setter = NULL);
+
+    /**
+     Removes all the parameters and the results of the last search.
+
+     @return returns true if the parameters were removed
+     */
+    bool clear();
+
+    /**
+     Searches the parameters of the pipeline using the training data.  The pipeline is not changed, use setBestParameters to set the parameters
+     of the winning candidate on a pipeline.  The pipeline must have a classifier.
+
+     @param const GestureRecognitionPipeline &pipeline: the pipeline the candidates are copied from
+     @param const LabelledClassificationData &trainingData: the training data
+     @return returns true if the search completed and at least one candidate was evaluated, false otherwise
+     */
+    bool search(const GestureRecognitionPipeline &pipeline,const LabelledClassificationData &trainingData);
+
+    /**
+     Searches the parameters of the pipeline using time series training data, see search(const GestureRecognitionPipeline &pipeline,const LabelledClassificationData &trainingData).
+     */
+    bool search(const GestureRecognitionPipeline &pipeline,const LabelledTimeSeriesClassificationData &trainingData);
+
+    /**
+     Searches the parameters of the pipeline using regression training data, the pipeline must have a regressifier.  The candidates are ranked
+     by their RMS error, lowest first.
+     */
+    bool search(const GestureRecognitionPipeline &pipeline,const LabelledRegressionData &trainingData);
+
+    /**
+     Sets the parameter values on the pipeline, using the setter of each parameter.
+
+     @param GestureRecognitionPipeline &pipeline: the pipeline the values will be set on
+     @param const VectorDouble &parameterValues: the value of each parameter, in the order the parameters were added
+     @return returns true if all the values were set, false otherwise
+     */
+    bool setParameters(GestureRecognitionPipeline &pipeline,const VectorDouble &parameterValues) const;
+
+    /**
+     Sets the parameter values of the winning candidate of the last search on the pipeline.
+
+     @param GestureRecognitionPipeline &pipeline: the pipeline the values will be set on
+     @return returns true if all the values were set, false otherwise
+     */
+    bool setBestParameters(GestureRecognitionPipeline &pipeline) const;
+
+    /**
+     Prints the leaderboard of the last search to std::cout.
+
+     @param const UINT numResults: the number of results to print, if zero then all the results are printed.  Default value = 0
+     @return returns true if the leaderboard was printed, false otherwise
+     */
+    bool printLeaderboard(const UINT numResults = 0) const;
+
+    /**
+     Gets the leaderboard of the last search.  The candidates that reached the last round come first, ranked by their score, followed by the
+     candidates that were dropped, ranked by the round they reached and then by their score.  Candidates that were stopped early are ranked
+     after the candidates that completed the same round, and candidates that failed come last.
+
+     @return returns the leaderboard
+     */
+    vector< ParameterSearchResult > getLeaderboard() const;
+
+    /**
+     Gets the winning candidate of the last search, this is the first result of the leaderboard.
+
+     @return returns the winning candidate, or an empty result if the last search failed
+     */
+    ParameterSearchResult getBestResult() const;
+
+    UINT getSearchMode() const;
+    UINT getKFoldValue() const;
+    UINT getNumThreads() const;
+    UINT getNumRandomCandidates() const;
+    UINT getReductionFactor() const;
+    double getMinDataFraction() const;
+    unsigned long long getRandomSeed() const;
+    bool getUseEarlyStopping() const;
+    bool getUseStratifiedSampling() const;
+    UINT getNumParameters() const;
+    vector< SearchParameter > getParameters() const;
+    UINT getNumCandidates() const;
+    UINT getNumStoppedCandidates() const;
+    double getSearchTime() const;
+
+    /**
+     Sets the search mode, this should be one of the SearchModes enums.
+
+     @param const UINT searchMode: the search mode
+     @return returns true if the search mode was set, false otherwise
+     */
+    bool setSearchMode(const UINT searchMode);
+
+    /**
+     Sets the number of folds used to evaluate each candidate, this must be at least 2.
+
+     @param const UINT kFoldValue: the number of folds
+     @return returns true if the parameter was set, false otherwise
+     */
+    bool setKFoldValue(const UINT kFoldValue);
+
+    /**
+     Sets the number of threads used to evaluate the candidates, the calling thread counts as one of the threads.
+
+     @param const UINT numThreads: the number of threads, this must be larger than zero
+     @return returns true if the parameter was set, false otherwise
+     */
+    bool setNumThreads(const UINT numThreads);
+
+    /**
+     Sets the number of candidates drawn by the random search, and by successive halving if any parameter is searched over a range.
+
+     @param const UINT numRandomCandidates: the number of candidates, this must be larger than zero
+     @return returns true if the parameter was set, false otherwise
+     */
+    bool setNumRandomCandidates(const UINT numRandomCandidates);
+
+    /**
+     Sets the reduction factor of successive halving.  Only the best 1/reductionFactor of the candidates of each round are kept, and each round
+     uses reductionFactor times more training data than the round before it.
+
+     @param const UINT reductionFactor: the reduction factor, this must be at least 2
+     @return returns true if the parameter was set, false otherwise
+     */
+    bool setReductionFactor(const UINT reductionFactor);
+
+    /**
+     Sets the smallest fraction of the training data used by the first round of successive halving.
+
+     @param const double minDataFraction: the fraction, this must be in the range (0 1]
+     @return returns true if the parameter was set, false otherwise
+     */
+    bool setMinDataFraction(const double minDataFraction);
+
+    /**
+     Sets the seed used to draw the random candidates and to split the training data into folds and subsets.  If the seed is zero then the
+     system time is used.
+
+     @param const unsigned long long randomSeed: the seed
+     @return returns true if the parameter was set
+     */
+    bool setRandomSeed(const unsigned long long randomSeed);
+
+    /**
+     Sets if candidates that can no longer be kept should be stopped early.
+
+     @param const bool useEarlyStopping: if true then early stopping is enabled
+     @return returns true if the parameter was set
+     */
+    bool setUseEarlyStopping(const bool useEarlyStopping);
+
+    /**
+     Sets if the folds (and the subsets used by successive halving) of classification data should be stratified by class.
+
+     @param const bool useStratifiedSampling: if true then stratified sampling is used
+     @return returns true if the parameter was set
+     */
+    bool setUseStratifiedSampling(const bool useStratifiedSampling);
+
+    /**
+     Gets the built in setter with the name.  The built in setters are:
+     - "Classifier.nullRejectionCoeff": Classifier::setNullRejectionCoeff
+     - "KNN.K": KNN::setK
+     - "SVM.C": SVM::setC
+     - "SVM.gamma": SVM::setGamma (the automatic gamma of the SVM is disabled so the value is used)
+     - "DTW.warpingRadius": DTW::setWarpingRadius (the warping path must be constrained for the radius to be used)
+     - "RandomForests.forestSize": RandomForests::setForestSize
+     - "RandomForests.maxDepth": RandomForests::setMaxDepth
+     - "MLP.numHiddenNeurons": re-initializes the MLP regressifier with the number of hidden neurons
+
+     @param const string &name: the name of the setter
+     @return returns the setter, or NULL if there is no built in setter with the name
+     */
+    static ParameterSearchSetter getBuiltInSetter(const string &name);
+
+    enum SearchModes{GRID_SEARCH=0,RANDOM_SEARCH,SUCCESSIVE_HALVING};
+
+protected:
+    template< class T > bool search_(const GestureRecognitionPipeline &pipeline,const T &trainingData);
+    template< class T > bool evaluateCandidates(const GestureRecognitionPipeline &pipeline,const T &roundData,const vector< UINT > &candidateIndexes,const UINT numToKeep,const UINT round,const double dataFraction);
+    bool createCandidates(vector< VectorDouble > &candidates);
+    bool buildLeaderboard();
+
+    UINT searchMode;
+    UINT kFoldValue;
+    UINT numThreads;
+    UINT numRandomCandidates;
+    UINT reductionFactor;
+    double minDataFraction;
+    unsigned long long randomSeed;
+    bool useEarlyStopping;
+    bool useStratifiedSampling;
+    bool higherScoreIsBetter;               //True for classification (accuracy), false for regression (RMS error)
+    vector< SearchParameter > parameters;
+    vector< ParameterSearchResult > results;        //The result of each candidate, indexed by candidate index
+    vector< ParameterSearchResult > leaderboard;    //The results sorted by rank
+    double searchTime;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_PARAMETER_SEARCH_HEADER
@@ -0,0 +1,240 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AsyncPipeline.h"
+#include <unistd.h>
+
+namespace GRT{
+
+enum StopRequests{NO_STOP_REQUEST=0,STOP_WHEN_EMPTY,STOP_NOW};
+
+AsyncPipeline::AsyncPipeline(){
+    pipeline = NULL;
+    running = false;
+    stopRequested = NO_STOP_REQUEST;
+    numProcessedSamples = 0;
+    numFailedPredictions = 0;
+    useResultQueue = false;
+    pushBuffer.sampleIndex = 0;
+
+    debugLog.setProceedingText("[DEBUG AsyncPipeline]");
+    errorLog.setProceedingText("[ERROR AsyncPipeline]");
+    warningLog.setProceedingText("[WARNING AsyncPipeline]");
+}
+
+AsyncPipeline::~AsyncPipeline(){
+    stop( false );
+}
+
+bool AsyncPipeline::start(GestureRecognitionPipeline &pipeline,const UINT queueSize,const UINT backpressureMode,const UINT resultQueueSize){
+
+    if( running ){
+        errorLog << "start(...) - The inference thread is already running!" << endl;
+        return false;
+    }
+
+    if( !pipeline.getTrained() ){
+        errorLog << "start(...) - The pipeline has not been trained!" << endl;
+        return false;
+    }
+
+    if( backpressureMode > COALESCE ){
+        errorLog << "start(...) - Unknown backpressureMode: " << backpressureMode << endl;
+        return false;
+    }
+
+    //Size every queued sample and result up front, so pushing and popping them does not allocate
+    Sample defaultSample;
+    defaultSample.sampleIndex = 0;
+    defaultSample.data.resize( pipeline.getInputVectorDimensionsSize(), 0 );
+    if( !sampleQueue.resize( queueSize, defaultSample ) ){
+        errorLog << "start(...) - Invalid queueSize: " << queueSize << endl;
+        return false;
+    }
+    sampleQueue.setBackpressureMode( backpressureMode );
+    pushBuffer = defaultSample;
+
+    useResultQueue = resultQueueSize > 0;
+    if( useResultQueue ){
+        PredictionResult defaultResult;
+        if( pipeline.getIsPipelineInClassificationMode() ){
+            defaultResult.classLikelihoods.resize( pipeline.getNumClasses(), 0 );
+        }else defaultResult.regressionData.resize( pipeline.getOutputVectorDimensionsSize(), 0 );
+        if( !resultQueue.resize( resultQueueSize, defaultResult ) ){
+            errorLog << "start(...) - Invalid resultQueueSize: " << resultQueueSize << endl;
+            return false;
+        }
+        resultQueue.setBackpressureMode( LockFreeQueue< PredictionResult >::DROP_OLDEST );
+    }
+
+    this->pipeline = &pipeline;
+    stopRequested = NO_STOP_REQUEST;
+    numProcessedSamples = 0;
+    numFailedPredictions = 0;
+
+    if( pthread_create( &thread, NULL, inferenceThread, this ) != 0 ){
+        errorLog << "start(...) - Failed to create the inference thread!" << endl;
+        this->pipeline = NULL;
+        return false;
+    }
+    running = true;
+
+    return true;
+}
+
+bool AsyncPipeline::stop(const bool predictQueuedSamples){
+
+    if( !running ) return false;
+
+    //Close the sample queue so a producer that is blocked on a full queue returns
+    __atomic_store_n( &stopRequested, predictQueuedSamples ? STOP_WHEN_EMPTY : STOP_NOW, __ATOMIC_RELEASE );
+    sampleQueue.close();
+
+    pthread_join( thread, NULL );
+    running = false;
+    pipeline = NULL;
+
+    return true;
+}
+
+bool AsyncPipeline::pushSample(const VectorDouble &inputVector){
+
+    if( !running ){
+        errorLog << "pushSample(const VectorDouble &inputVector) - The inference thread is not running!" << endl;
+        return false;
+    }
+
+    if( inputVector.size() != pushBuffer.data.size() ){
+        errorLog << "pushSample(const VectorDouble &inputVector) - The size of the input vector (" << inputVector.size() << ") does not match the input dimensions of the pipeline (" << pushBuffer.data.size() << ")" << endl;
+        return false;
+    }
+
+    //The push buffer already has the right size, so these copies do not allocate
+    pushBuffer.sampleIndex = sampleQueue.getNumPushed();
+    std::copy( inputVector.begin(), inputVector.end(), pushBuffer.data.begin() );
+
+    return sampleQueue.push( pushBuffer );
+}
+
+bool AsyncPipeline::popResult(PredictionResult &result){
+    if( !useResultQueue ) return false;
+    return resultQueue.pop( result );
+}
+
+bool AsyncPipeline::registerResultObserver(Observer< PredictionResult > &observer){
+    if( running ){
+        errorLog << "registerResultObserver(Observer< PredictionResult > &observer) - Observers can not be registered while the inference thread is running!" << endl;
+        return false;
+    }
+    return resultObserverManager.registerObserver( observer );
+}
+
+bool AsyncPipeline::removeResultObserver(const Observer< PredictionResult > &observer){
+    if( running ){
+        errorLog << "removeResultObserver(const Observer< PredictionResult > &observer) - Observers can not be removed while the inference thread is running!" << endl;
+        return false;
+    }
+    return resultObserverManager.removeObserver( observer );
+}
+
+bool AsyncPipeline::getIsRunning() const{
+    return running;
+}
+
+UINT AsyncPipeline::getQueueDepth() const{
+    return sampleQueue.getSize();
+}
+
+UINT AsyncPipeline::getMaxQueueDepth() const{
+    return sampleQueue.getMaxSize();
+}
+
+UINT AsyncPipeline::getNumPushedSamples() const{
+    return sampleQueue.getNumPushed();
+}
+
+UINT AsyncPipeline::getNumDroppedSamples() const{
+    return sampleQueue.getNumDropped();
+}
+
+UINT AsyncPipeline::getNumCoalescedSamples() const{
+    return sampleQueue.getNumCoalesced();
+}
+
+UINT AsyncPipeline::getNumProcessedSamples() const{
+    return __atomic_load_n( &numProcessedSamples, __ATOMIC_ACQUIRE );
+}
+
+UINT AsyncPipeline::getNumFailedPredictions() const{
+    return __atomic_load_n( &numFailedPredictions, __ATOMIC_ACQUIRE );
+}
+
+UINT AsyncPipeline::getNumDroppedResults() const{
+    return useResultQueue ? resultQueue.getNumDropped() : 0;
+}
+
+void* AsyncPipeline::inferenceThread(void *data){
+    ((AsyncPipeline*)data)->runInferenceThread();
+    return NULL;
+}
+
+void AsyncPipeline::runInferenceThread(){
+
+    const bool classificationMode = pipeline->getIsPipelineInClassificationMode();
+    Sample sample;
+    sample.sampleIndex = 0;
+    sample.data.resize( pipeline->getInputVectorDimensionsSize(), 0 );
+    PredictionResult result;
+    UINT numIdlePolls = 0;
+
+    while( true ){
+
+        const UINT stopRequest = __atomic_load_n( &stopRequested, __ATOMIC_ACQUIRE );
+        if( stopRequest == STOP_NOW ) break;
+
+        if( !sampleQueue.pop( sample ) ){
+            if( stopRequest == STOP_WHEN_EMPTY ) break;
+
+            //Spin briefly so a steady stream of samples is picked up straight away, then back off so an idle thread does not burn a core
+            if( ++numIdlePolls < 1000 ) sched_yield();
+            else usleep( 100 );
+            continue;
+        }
+        numIdlePolls = 0;
+
+        result.sampleIndex = sample.sampleIndex;
+        result.predictionSuccess = pipeline->predict( sample.data );
+        if( result.predictionSuccess ){
+            if( classificationMode ){
+                result.predictedClassLabel = pipeline->getPredictedClassLabel();
+                result.unprocessedPredictedClassLabel = pipeline->getUnProcessedPredictedClassLabel();
+                result.maximumLikelihood = pipeline->getMaximumLikelihood();
+                result.classLikelihoods = pipeline->getClassLikelihoods();
+            }else result.regressionData = pipeline->getRegressionData();
+        }else __atomic_fetch_add( &numFailedPredictions, 1, __ATOMIC_RELEASE );
+
+        resultObserverManager.notifyObservers( result );
+        if( useResultQueue ) resultQueue.push( result );
+
+        __atomic_fetch_add( &numProcessedSamples, 1, __ATOMIC_RELEASE );
+    }
+}
+
+} //End of namespace GRT
@@ -0,0 +1,215 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The AsyncPipeline class runs a trained GestureRecognitionPipeline on its own inference thread, so a sensor callback can hand off
+ each sample without waiting for the prediction.
+
+ The producer (for example a sensor callback) calls pushSample, which copies the sample into a lock-free single producer, single
+ consumer queue and returns straight away.  The inference thread pops each sample, calls the pipeline's predict function and delivers
+ a PredictionResult to any registered Observer< PredictionResult > (on the inference thread) and to a result queue, which another
+ thread can drain with popResult.
+
+ If the inference thread falls behind and the sample queue fills up, pushSample applies the backpressure mode:
+ - BLOCK: pushSample waits until there is space in the queue
+ - DROP_OLDEST: the oldest sample that has not been predicted yet is dropped
+ - COALESCE: the newest sample in the queue is replaced by the new sample
+
+ While the AsyncPipeline is running it owns the pipeline, no other thread should use the pipeline until stop has been called.
+ Only one thread may call pushSample and only one thread may call popResult.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_ASYNC_PIPELINE_HEADER
+#define GRT_ASYNC_PIPELINE_HEADER
+
+#include "GestureRecognitionPipeline.h"
+#include "../Util/LockFreeQueue.h"
+#include "../Util/PredictionResult.h"
+#include "../Util/ObserverManager.h"
+#include <pthread.h>
+
+namespace GRT{
+
+class AsyncPipeline : public GRTBase
+{
+public:
+    enum BackpressureModes{BLOCK=0,DROP_OLDEST,COALESCE};
+
+    /**
+     Default Constructor.
+     */
+    AsyncPipeline();
+
+    /**
+     Default Destructor, stops the inference thread if it is running (without predicting the samples that are still in the queue).
+     */
+    virtual ~AsyncPipeline();
+
+    /**
+     Starts the inference thread.  The pipeline must be trained, and must not be used by any other thread until stop is called.
+
+     @param GestureRecognitionPipeline &pipeline: the pipeline that will be used to predict each sample
+     @param const UINT queueSize: the number of samples the sample queue can hold, this is rounded up to a power of two.  Default value = 64
+     @param const UINT backpressureMode: what pushSample does when the sample queue is full, this should be one of the BackpressureModes enums.  Default value = DROP_OLDEST
+     @param const UINT resultQueueSize: the number of results the result queue can hold, if the queue is full the oldest result is dropped.  If this is zero then results are only delivered to the observers.  Default value = 64
+     @return returns true if the inference thread was started, false otherwise
+     */
+    bool start(GestureRecognitionPipeline &pipeline,const UINT queueSize = 64,const UINT backpressureMode = DROP_OLDEST,const UINT resultQueueSize = 64);
+
+    /**
+     Stops the inference thread.  After this returns the pipeline can be used by the calling thread again.
+
+     @param const bool predictQueuedSamples: if true the inference thread predicts the samples that are still in the queue before it stops,
+     otherwise they are discarded.  Default value = true
+     @return returns true if the inference thread was stopped, false if it was not running
+     */
+    bool stop(const bool predictQueuedSamples = true);
+
+    /**
+     Pushes a new sample onto the sample queue.  This should only be called from the producer thread, and does not allocate any memory.
+
+     @param const VectorDouble &inputVector: the sample to predict, its size must match the input dimensions of the pipeline
+     @return returns true if the sample was queued, false if the AsyncPipeline is not running, the sample has the wrong size or the queue was stopped while pushSample was blocked
+     */
+    bool pushSample(const VectorDouble &inputVector);
+
+    /**
+     Pops the oldest result from the result queue.  This should only be called from one thread.
+
+     @param PredictionResult &result: if a result is popped it will be assigned to this variable
+     @return returns true if a result was popped, false if the result queue is empty
+     */
+    bool popResult(PredictionResult &result);
+
+    /**
+     Registers an observer that will be notified of each PredictionResult.  The observer is notified on the inference thread, so it should
+     return quickly.  Observers can only be registered while the inference thread is not running.
+
+     @param Observer< PredictionResult > &observer: the observer to register
+     @return returns true if the observer was registered, false otherwise
+     */
+    bool registerResultObserver(Observer< PredictionResult > &observer);
+
+    /**
+     Removes an observer that was registered with registerResultObserver.  Observers can only be removed while the inference thread is not running.
+
+     @param const Observer< PredictionResult > &observer: the observer to remove
+     @return returns true if the observer was removed, false otherwise
+     */
+    bool removeResultObserver(const Observer< PredictionResult > &observer);
+
+    /**
+     Gets if the inference thread is running.
+
+     @return returns true if the inference thread is running, false otherwise
+     */
+    bool getIsRunning() const;
+
+    /**
+     Gets the number of samples that are waiting in the sample queue.
+
+     @return returns the number of samples in the sample queue
+     */
+    UINT getQueueDepth() const;
+
+    /**
+     Gets the largest number of samples that have been waiting in the sample queue since the AsyncPipeline was started.
+
+     @return returns the largest number of samples that have been in the sample queue
+     */
+    UINT getMaxQueueDepth() const;
+
+    /**
+     Gets the number of samples that have been pushed since the AsyncPipeline was started, this includes the dropped and coalesced samples.
+
+     @return returns the number of samples that have been pushed
+     */
+    UINT getNumPushedSamples() const;
+
+    /**
+     Gets the number of samples that were dropped by the DROP_OLDEST backpressure mode.
+
+     @return returns the number of dropped samples
+     */
+    UINT getNumDroppedSamples() const;
+
+    /**
+     Gets the number of samples that were replaced by the COALESCE backpressure mode.
+
+     @return returns the number of coalesced samples
+     */
+    UINT getNumCoalescedSamples() const;
+
+    /**
+     Gets the number of samples the inference thread has predicted, this includes the samples the pipeline failed to predict.
+
+     @return returns the number of samples that have been predicted
+     */
+    UINT getNumProcessedSamples() const;
+
+    /**
+     Gets the number of samples the pipeline failed to predict.
+
+     @return returns the number of failed predictions
+     */
+    UINT getNumFailedPredictions() const;
+
+    /**
+     Gets the number of results that were dropped because the result queue was full.
+
+     @return returns the number of dropped results
+     */
+    UINT getNumDroppedResults() const;
+
+protected:
+    //A queued sample, with the index it was pushed with
+    struct Sample{
+        UINT sampleIndex;
+        VectorDouble data;
+    };
+
+    static void* inferenceThread(void *data);
+    void runInferenceThread();
+
+    GestureRecognitionPipeline *pipeline;
+    pthread_t thread;
+    bool running;
+    UINT stopRequested;                                 ///< Set (atomically) by stop, 1 to predict the queued samples then stop, 2 to stop now
+    UINT numProcessedSamples;
+    UINT numFailedPredictions;
+    bool useResultQueue;
+    Sample pushBuffer;                                  ///< Only used by the producer thread
+    LockFreeQueue< Sample > sampleQueue;
+    LockFreeQueue< PredictionResult > resultQueue;
+    ObserverManager< PredictionResult > resultObserverManager;
+
+private:
+    //The inference thread holds a pointer to this instance, so it can not be copied
+    AsyncPipeline(const AsyncPipeline &rhs);
+    AsyncPipeline& operator=(const AsyncPipeline &rhs);
+};
+
+} //End of namespace GRT
+
+#endif //GRT_ASYNC_PIPELINE_HEADER
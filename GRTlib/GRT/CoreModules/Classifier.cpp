@@ -143,6 +143,27 @@ bool Classifier::clear(){
     
     return true;
 }
+    
+bool Classifier::predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances){
+    
+    if( !initBatchPrediction(inputData,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances) ) return false;
+    
+    //Copy each row into the same buffer so the loop does not allocate
+    const UINT M = inputData.getNumRows();
+    VectorDouble inputVector( numInputDimensions );
+    for(UINT i=0; i<M; i++){
+        std::copy( inputData[i], inputData[i]+numInputDimensions, inputVector.begin() );
+        
+        if( !predictInplace( inputVector ) ){
+            errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances) - Failed to predict row: " << i << endl;
+            return false;
+        }
+        
+        storeBatchPrediction(i,predictedClassLabels,predictedClassLikelihoods,predictedClassDistances);
+    }
+    
+    return true;
+}
 
 string Classifier::getClassifierType() const{
     return classifierType; 
@@ -231,5 +252,88 @@ const Classifier& Classifier::getBaseClassifier() const{
     return *this;
 }
 
+bool Classifier::initBatchPrediction(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances){
+    
+    if( !trained ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances) - The classifier has not been trained!" << endl;
+        return false;
+    }
+    
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances) - The number of columns in the input data (" << inputData.getNumCols() << ") does not match the number of input dimensions (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    const UINT M = inputData.getNumRows();
+    predictedClassLabels.resize( M );
+    if( M == 0 ){
+        predictedClassLikelihoods.clear();
+        predictedClassDistances.clear();
+        return true;
+    }
+    
+    if( predictedClassLikelihoods.getNumRows() != M || predictedClassLikelihoods.getNumCols() != numClasses ) predictedClassLikelihoods.resize( M, numClasses );
+    if( predictedClassDistances.getNumRows() != M || predictedClassDistances.getNumCols() != numClasses ) predictedClassDistances.resize( M, numClasses );
+    
+    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
+    if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
+    
+    return true;
+}
+    
+bool Classifier::scaleBatch(const MatrixDouble &inputData,MatrixDouble &scaledData,const double minTarget,const double maxTarget){
+    
+    const UINT M = inputData.getNumRows();
+    const UINT N = inputData.getNumCols();
+    
+    if( N != ranges.size() ){
+        errorLog << "scaleBatch(const MatrixDouble &inputData,MatrixDouble &scaledData,const double minTarget,const double maxTarget) - The number of columns in the input data does not match the number of ranges!" << endl;
+        return false;
+    }
+    
+    scaledData = inputData;
+    for(UINT i=0; i<M; i++){
+        double *x = scaledData[i];
+        for(UINT n=0; n<N; n++){
+            x[n] = scale(x[n], ranges[n].minValue, ranges[n].maxValue, minTarget, maxTarget);
+        }
+    }
+    
+    return true;
+}
+    
+void Classifier::storeBatchPrediction(const UINT rowIndex,vector< UINT > &predictedClassLabels,MatrixDouble &predictedClassLikelihoods,MatrixDouble &predictedClassDistances) const{
+    
+    predictedClassLabels[ rowIndex ] = predictedClassLabel;
+    
+    //Some classifiers do not fill the likelihoods or distances, so only copy the values that exist
+    const UINT K = predictedClassLikelihoods.getNumCols();
+    double *likelihoods = predictedClassLikelihoods[ rowIndex ];
+    double *distances = predictedClassDistances[ rowIndex ];
+    for(UINT k=0; k<K; k++){
+        likelihoods[k] = k < classLikelihoods.size() ? classLikelihoods[k] : 0;
+        distances[k] = k < classDistances.size() ? classDistances[k] : 0;
+    }
+}
+    
+const VectorDouble* Classifier::initSharedPrediction(const VectorDouble &inputVector,ClassifierPrediction &prediction,const double minTarget,const double maxTarget) const{
+    
+    prediction.clear();
+    
+    if( !trained || inputVector.size() != numInputDimensions ) return NULL;
+    
+    //These only allocate on the first prediction
+    if( prediction.classLikelihoods.size() != numClasses ) prediction.classLikelihoods.resize(numClasses);
+    if( prediction.classDistances.size() != numClasses ) prediction.classDistances.resize(numClasses);
+    
+    if( !useScaling ) return &inputVector;
+    
+    if( prediction.inputBuffer.size() != numInputDimensions ) prediction.inputBuffer.resize(numInputDimensions);
+    for(UINT n=0; n<numInputDimensions; n++){
+        prediction.inputBuffer[n] = scale(inputVector[n], ranges[n].minValue, ranges[n].maxValue, minTarget, maxTarget);
+    }
+    return &prediction.inputBuffer;
+}
+    
 } //End of namespace GRT
 
@@ -117,10 +117,10 @@ bool Clusterer::clear(){
     return true;
 }
     
-bool Clusterer::saveClustererSettingsToFile(fstream &file) const{
+bool Clusterer::saveClustererSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveClustererSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveClustererSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
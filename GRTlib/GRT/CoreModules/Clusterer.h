@@ -207,7 +207,7 @@ protected:
      
      @return returns true if the base settings were saved, false otherwise
      */
-    bool saveClustererSettingsToFile(fstream &file) const;
+    bool saveClustererSettingsToFile(ostream &file) const;
     
     /**
      Loads the core clusterer settings from a file.
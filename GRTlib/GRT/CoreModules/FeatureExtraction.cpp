@@ -81,6 +81,41 @@ bool FeatureExtraction::copyBaseVariables(const FeatureExtraction *featureExtrac
     return true;
 }
     
+bool FeatureExtraction::computeFeaturesBatch(const MatrixDouble &inputData,MatrixDouble &outputData){
+    
+    if( !initialized ){
+        errorLog << "computeFeaturesBatch(const MatrixDouble &inputData,MatrixDouble &outputData) - The module has not been initialized!" << endl;
+        return false;
+    }
+    
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << "computeFeaturesBatch(const MatrixDouble &inputData,MatrixDouble &outputData) - The number of columns in the input data (" << inputData.getNumCols() << ") does not match the number of input dimensions (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ){
+        outputData.clear();
+        return true;
+    }
+    if( outputData.getNumRows() != M || outputData.getNumCols() != numOutputDimensions ) outputData.resize( M, numOutputDimensions );
+    
+    //Copy each row into the same buffer so the loop does not allocate
+    VectorDouble inputVector( numInputDimensions );
+    for(UINT i=0; i<M; i++){
+        std::copy( inputData[i], inputData[i]+numInputDimensions, inputVector.begin() );
+        
+        if( !computeFeatures( inputVector ) || featureVector.size() != numOutputDimensions ){
+            errorLog << "computeFeaturesBatch(const MatrixDouble &inputData,MatrixDouble &outputData) - Failed to compute the features for row: " << i << endl;
+            return false;
+        }
+        
+        std::copy( featureVector.begin(), featureVector.end(), outputData[i] );
+    }
+    
+    return true;
+}
+    
 bool FeatureExtraction::init(){
     
     //Clear any previous feature vector
@@ -104,10 +139,10 @@ bool FeatureExtraction::init(){
     return true;
 }
 
-bool FeatureExtraction::saveFeatureExtractionSettingsToFile(fstream &file) const{
+bool FeatureExtraction::saveFeatureExtractionSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveFeatureExtractionSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveFeatureExtractionSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -169,7 +204,7 @@ bool FeatureExtraction::getFeatureDataReady() const{
     return featureDataReady;
 }
 
-VectorDouble FeatureExtraction::getFeatureVector() const{ 
+const VectorDouble& FeatureExtraction::getFeatureVector() const{ 
     return featureVector; 
 }
     
@@ -73,6 +73,17 @@ public:
      */
     virtual bool computeFeatures(const VectorDouble &inputVector){ return false; }
     
+    /**
+     Computes the features for each row in the inputData, storing the feature vector for each row in the matching row of the outputData.
+     The rows are processed in order, so modules that buffer their input give the same result as calling computeFeatures on each row in turn.
+     The default implementation calls computeFeatures for each row, the derived class can override this if it can process the block more efficiently.
+     
+     @param const MatrixDouble &inputData: the data to process, each row is one sample
+     @param MatrixDouble &outputData: will be resized to [numRows numOutputDimensions] and filled with the feature vectors
+     @return returns true if the features were computed, false otherwise
+     */
+    virtual bool computeFeaturesBatch(const MatrixDouble &inputData,MatrixDouble &outputData);
+    
     /**
      This function is called by the GestureRecognitionPipeline's reset function.
      This function should be overwritten by the derived class.
@@ -103,10 +114,10 @@ public:
      This saves the feature extraction settings to a file.
      This function should be overwritten by the derived class.
      
-     @param fstream &file: a reference to the file to save the settings to
+     @param ostream &file: a reference to the file to save the settings to
      @return returns true if the settings were saved successfully, false otherwise (the base class always returns false)
      */
-    virtual bool saveSettingsToFile(fstream &file) const{ return false; }
+    virtual bool saveSettingsToFile(ostream &file) const{ return false; }
     
     /**
      This loads the feature extraction settings from a file.
@@ -155,9 +166,9 @@ public:
     /**
      Returns the current feature vector.
      
-     @return returns the current feature vector, this vector will be empty if the module has not been initialized
+     @return returns a const reference to the current feature vector, this vector will be empty if the module has not been initialized
      */
-    VectorDouble getFeatureVector() const;
+    const VectorDouble& getFeatureVector() const;
     
     /**
      Defines a map between a string (which will contain the name of the featureExtraction module, such as FFT) and a function returns a new instance of that featureExtraction
@@ -192,7 +203,7 @@ protected:
      
      @return returns true if the base settings were saved, false otherwise
      */
-    bool saveFeatureExtractionSettingsToFile(fstream &file) const;
+    bool saveFeatureExtractionSettingsToFile(ostream &file) const;
     
     /**
      Loads the core base settings from a file.
@@ -19,6 +19,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include "GestureRecognitionPipeline.h"
+#include <pthread.h>
 
 namespace GRT{
 
@@ -33,6 +34,10 @@ GestureRecognitionPipeline::GestureRecognitionPipeline(void)
     predictionModuleIndex = 0;
     numTrainingSamples = 0;
     numTestSamples = 0;
+    numThreads = 1;
+    useFilterFusion = false;
+    fusedPreProcessingModulesValid = false;
+    preProcessingModulesEditable = false;
     testAccuracy = 0;
     testRMSError = 0;
     testSquaredError = 0;
@@ -42,6 +47,7 @@ GestureRecognitionPipeline::GestureRecognitionPipeline(void)
     trainingTime = 0;
     classifier = NULL;
     regressifier = NULL;
+    featureCache = NULL;
     contextModules.resize( NUM_CONTEXT_LEVELS );
 
     debugLog.setProceedingText("[DEBUG GRP]");
@@ -61,6 +67,10 @@ GestureRecognitionPipeline::GestureRecognitionPipeline(const GestureRecognitionP
     predictionModuleIndex = 0;
     numTrainingSamples = 0;
     numTestSamples = 0;
+    numThreads = 1;
+    useFilterFusion = false;
+    fusedPreProcessingModulesValid = false;
+    preProcessingModulesEditable = false;
     testAccuracy = 0;
     testRMSError = 0;
     testSquaredError = 0;
@@ -70,6 +80,7 @@ GestureRecognitionPipeline::GestureRecognitionPipeline(const GestureRecognitionP
     trainingTime = 0;
     classifier = NULL;
     regressifier = NULL;
+    featureCache = NULL;
     contextModules.resize( NUM_CONTEXT_LEVELS );
     
     debugLog.setProceedingText("[DEBUG GRP]");
@@ -96,6 +107,10 @@ GestureRecognitionPipeline& GestureRecognitionPipeline::operator=(const GestureR
 	    this->predictionModuleIndex = rhs.predictionModuleIndex;
         this->numTrainingSamples = rhs.numTrainingSamples;
         this->numTestSamples = rhs.numTestSamples;
+        this->numThreads = rhs.numThreads;
+        this->useFilterFusion = rhs.useFilterFusion;
+        this->profiler = rhs.profiler;
+        this->featureCache = rhs.featureCache;
 	    this->testAccuracy = rhs.testAccuracy;
 	    this->testRMSError = rhs.testRMSError;
         this->testSquaredError = rhs.testSquaredError;
@@ -154,6 +169,7 @@ GestureRecognitionPipeline& GestureRecognitionPipeline::operator=(const GestureR
 GestureRecognitionPipeline::~GestureRecognitionPipeline(void)
 {
     //Clean up the memory
+    deleteFusedPreProcessingModules();
     deleteAllPreProcessingModules();
     deleteAllFeatureExtractionModules();
     deleteClassifier();
@@ -163,6 +179,10 @@ GestureRecognitionPipeline::~GestureRecognitionPipeline(void)
 } 
     
 bool GestureRecognitionPipeline::train(const LabelledClassificationData &trainingData){
+    return train( LabelledClassificationDataView( trainingData ) );
+}
+    
+bool GestureRecognitionPipeline::train(const LabelledClassificationDataView &trainingData){
     
     trained = false;
     trainingTime = 0;
@@ -202,7 +222,42 @@ bool GestureRecognitionPipeline::train(const LabelledClassificationData &trainin
     
     LabelledClassificationData processedTrainingData( numDimensions );
     
-    for(UINT i=0; i<trainingData.getNumSamples(); i++){
+    //Without any preprocessing or feature extraction modules the samples are not changed, so the classifier is trained with a view of the
+    //samples rather than a copy of them.  Samples with the null class label are left out of the view, as they can not be added to the copy
+    const bool useTrainingView = !getIsPreProcessingSet() && !getIsFeatureExtractionSet();
+    vector< UINT > viewIndexs;
+    if( useTrainingView ){
+        viewIndexs.reserve( trainingData.getNumSamples() );
+        for(UINT i=0; i<trainingData.getNumSamples(); i++){
+            if( trainingData[i].getClassLabel() != GRT_DEFAULT_NULL_CLASS_LABEL ) viewIndexs.push_back( trainingData.getIndexs()[i] );
+        }
+    }
+    
+    //If a feature cache has been set, then try to get the processed training data from the cache before running the front end modules
+    unsigned long long cacheKey = 0;
+    bool useFeatureCache = getFrontEndHash( "LabelledClassificationData", cacheKey );
+    bool featuresCached = false;
+    vector< UINT > sampleIndexes;
+    if( useFeatureCache ){
+        cacheKey = hashTrainingData( trainingData, cacheKey );
+        MatrixDouble cachedData;
+        if( featureCache->lookup( cacheKey, cachedData, sampleIndexes, preProcessingModules, featureExtractionModules ) ){
+            featuresCached = cachedData.getNumRows() == sampleIndexes.size() && (cachedData.getNumRows() == 0 || cachedData.getNumCols() == numDimensions);
+            for(UINT i=0; i<sampleIndexes.size() && featuresCached; i++){
+                if( sampleIndexes[i] < trainingData.getNumSamples() ){
+                    processedTrainingData.addSample( trainingData[ sampleIndexes[i] ].getClassLabel(), cachedData.getRowVector(i) );
+                }else featuresCached = false;
+            }
+            if( !featuresCached ){
+                warningLog << "train(LabelledClassificationData trainingData) - The feature cache entry does not match the training data, the entry will be replaced!" << endl;
+                processedTrainingData.clear();
+                sampleIndexes.clear();
+                reset();
+            }
+        }
+    }
+    
+    for(UINT i=0; i<trainingData.getNumSamples() && !featuresCached && !useTrainingView; i++){
         bool okToAddProcessedData = true;
         UINT classLabel = trainingData[i].getClassLabel();
         VectorDouble trainingSample = trainingData[i].getSample();
@@ -241,20 +296,29 @@ bool GestureRecognitionPipeline::train(const LabelledClassificationData &trainin
         if( okToAddProcessedData ){
             //Add the training sample to the processed training data
             processedTrainingData.addSample(classLabel, trainingSample);
+            if( useFeatureCache ) sampleIndexes.push_back( i );
         }
         
     }
     
-    if( processedTrainingData.getNumSamples() != trainingData.getNumSamples() ){
+    LabelledClassificationDataView processedTrainingView = useTrainingView ? LabelledClassificationDataView( *trainingData.getDataset(), viewIndexs ) : LabelledClassificationDataView( processedTrainingData );
+    
+    if( processedTrainingView.getNumSamples() != trainingData.getNumSamples() ){
         
-        warningLog << "train(LabelledClassificationData trainingData) - Lost " << trainingData.getNumSamples()-processedTrainingData.getNumSamples() << " of " << trainingData.getNumSamples() << " training samples due to the processing stage!" << endl;
+        warningLog << "train(LabelledClassificationData trainingData) - Lost " << trainingData.getNumSamples()-processedTrainingView.getNumSamples() << " of " << trainingData.getNumSamples() << " training samples due to the processing stage!" << endl;
     }
 
     //Store the number of training samples
-    numTrainingSamples = processedTrainingData.getNumSamples();
+    numTrainingSamples = processedTrainingView.getNumSamples();
     
     //Train the classifier
-    trained = classifier->train( processedTrainingData );
+    trained = classifier->train( processedTrainingView );
+    
+    //The processed training data is not needed once the classifier has been trained, so it is moved into the cache rather than copied
+    if( useFeatureCache && !featuresCached ){
+        featureCache->insert( cacheKey, processedTrainingData.releaseDataAsMatrixDouble(), sampleIndexes, preProcessingModules, featureExtractionModules );
+    }
+    
     if( !trained ){
         errorLog << "train(LabelledClassificationData trainingData) - Failed To Train Classifier: " << classifier->getLastErrorMessage() << endl;
         return false;
@@ -289,8 +353,9 @@ bool GestureRecognitionPipeline::train(LabelledClassificationData trainingData,c
     Timer timer;
     timer.start();
 
-    //Spilt the data into K folds
-    bool spiltResult = trainingData.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling);
+    //Spilt the data into K folds, if a feature cache has been set then the folds are seeded from the data so each call uses the same folds
+    const unsigned long long randomSeed = featureCache != NULL ? hashTrainingData( trainingData, GRT_FEATURE_CACHE_HASH_OFFSET ) | 1 : 0;
+    bool spiltResult = trainingData.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling, randomSeed);
     
     if( !spiltResult ){
         return false;
@@ -298,27 +363,36 @@ bool GestureRecognitionPipeline::train(LabelledClassificationData trainingData,c
     
     //Run the k-fold training and testing
     double crossValidationAccuracy = 0;
-    LabelledClassificationData foldTrainingData;
-    LabelledClassificationData foldTestData;
     vector< TestResult > cvResults(kFoldValue);
 
-    for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-		foldTrainingData = trainingData.getTrainingFoldData(k);
-        
-        if( !train( foldTrainingData ) ){
+    if( numThreads > 1 && kFoldValue > 1 ){
+        //Run the folds on the worker threads, the fold results are merged in fold order so they match the serial path
+        if( !trainKFoldsInParallel( trainingData, kFoldValue, cvResults ) ){
             return false;
         }
         
-        //Test the classification system
-        foldTestData = trainingData.getTestFoldData(k);
-        
-        if( !test( foldTestData ) ){
-            return false;
+        for(UINT k=0; k<kFoldValue; k++){
+            crossValidationAccuracy += cvResults[k].accuracy;
         }
+    }else{
+        LabelledClassificationData foldTestData;
         
-        crossValidationAccuracy += getTestAccuracy();
-        cvResults[k] = getTestResults();
+        for(UINT k=0; k<kFoldValue; k++){
+            ///Train the classification system, the training fold is a view of the training data so the samples are not copied for each fold
+            if( !train( trainingData.getTrainingFoldView(k) ) ){
+                return false;
+            }
+            
+            //Test the classification system
+            foldTestData = trainingData.getTestFoldData(k);
+            
+            if( !test( foldTestData ) ){
+                return false;
+            }
+            
+            crossValidationAccuracy += getTestAccuracy();
+            cvResults[k] = getTestResults();
+        }
     }
 
     //Flag that the model has been trained
@@ -366,32 +440,44 @@ bool GestureRecognitionPipeline::train(LabelledTimeSeriesClassificationData trai
     
     //Setup the data structure, if the classifier works with timeseries data then we use LabelledTimeSeriesClassificationData
     //otherwise we format the data as LabelledClassificationData
+    UINT trainingDataInputDimensionSize = trainingData.getNumDimensions();
+    if( getIsPreProcessingSet() ){
+        trainingDataInputDimensionSize = preProcessingModules[ preProcessingModules.size()-1 ]->getNumOutputDimensions();
+    }
+    if( getIsFeatureExtractionSet() ){
+        trainingDataInputDimensionSize = featureExtractionModules[ featureExtractionModules.size()-1 ]->getNumOutputDimensions();
+    }
     if( classifier->getTimeseriesCompatible() ){
-        UINT trainingDataInputDimensionSize = trainingData.getNumDimensions();
-        if( getIsPreProcessingSet() ){
-            trainingDataInputDimensionSize = preProcessingModules[ preProcessingModules.size()-1 ]->getNumOutputDimensions();
-        }
-        if( getIsFeatureExtractionSet() ){
-            trainingDataInputDimensionSize = featureExtractionModules[ featureExtractionModules.size()-1 ]->getNumOutputDimensions();
-        }
         labelledTimeseriesClassificationData.setNumDimensions( trainingDataInputDimensionSize );
     }else{
-        UINT trainingDataInputDimensionSize = trainingData.getNumDimensions();
-        if( getIsPreProcessingSet() ){
-            trainingDataInputDimensionSize = preProcessingModules[ preProcessingModules.size()-1 ]->getNumOutputDimensions();
-        }
-        if( getIsFeatureExtractionSet() ){
-            trainingDataInputDimensionSize = featureExtractionModules[ featureExtractionModules.size()-1 ]->getNumOutputDimensions();
-        }
         labelledClassificationData.setNumDimensions( trainingDataInputDimensionSize );
     }
     
+    //If a feature cache has been set, then look up the feature data of each sample in the cache. The modules are reset for each sample, so each
+    //sample is cached by itself. The last sample is always processed, so the modules are left in the same state as if the cache was not used
+    unsigned long long frontEndHash = 0;
+    const bool useFeatureCache = getFrontEndHash( "LabelledTimeSeriesClassificationData", frontEndHash );
+    vector< unsigned long long > cacheKeys;
+    vector< MatrixDouble > cachedFeatureData;
+    vector< bool > featuresCached( trainingData.getNumSamples(), false );
+    if( useFeatureCache ){
+        cacheKeys.resize( trainingData.getNumSamples() );
+        cachedFeatureData.resize( trainingData.getNumSamples() );
+        for(UINT i=0; i<trainingData.getNumSamples(); i++){
+            cacheKeys[i] = hashTimeSeries( trainingData[i].getData(), frontEndHash );
+            if( i+1 < trainingData.getNumSamples() && featureCache->lookup( cacheKeys[i], cachedFeatureData[i] ) ){
+                featuresCached[i] = cachedFeatureData[i].getNumRows() == 0 || cachedFeatureData[i].getNumCols() == trainingDataInputDimensionSize;
+            }
+        }
+    }
+    
     //Pass the timeseries data through any pre-processing modules and add it to the processedTrainingData structure
     for(UINT i=0; i<trainingData.getNumSamples(); i++){
         UINT classLabel = trainingData[i].getClassLabel();
         MatrixDouble trainingSample = trainingData[i].getData();
         
-        if( getIsPreProcessingSet() ){
+        //The feature data of a cached sample is already known, so the original sample is just added to keep the samples in order
+        if( getIsPreProcessingSet() && !featuresCached[i] ){
             
             //Try to process the matrix data row-by-row
             bool resetPreprocessingModule = true;
@@ -444,63 +530,65 @@ bool GestureRecognitionPipeline::train(LabelledTimeSeriesClassificationData trai
     //Add the data to either the timeseries or classification data structures
     for(UINT i=0; i<processedTrainingData.getNumSamples(); i++){
         UINT classLabel = processedTrainingData[i].getClassLabel();
-        MatrixDouble trainingSample = processedTrainingData[i].getData();
-        bool featureDataReady = false;
-        bool resetFeatureExtractionModules = true;
-        
         MatrixDouble featureData;
-        //Try to process the matrix data row-by-row
-        for(UINT r=0; r<trainingSample.getNumRows(); r++){
-            VectorDouble inputVector = trainingSample.getRowVector( r );
-            featureDataReady = true;
-            
-             //Pass the processed training data through the feature extraction
-            if( getIsFeatureExtractionSet() ){
+        
+        if( featuresCached[i] ){
+            featureData = cachedFeatureData[i];
+            cachedFeatureData[i].clear();
+        }else{
+            const MatrixDouble &trainingSample = processedTrainingData[i].getData();
+            bool resetFeatureExtractionModules = true;
             
-                for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
-                    
-                    if( resetFeatureExtractionModules ){
-                        featureExtractionModules[moduleIndex]->reset();
-                    }
-                    
-                    if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
-                        errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To Compute Features For Training Data. FeatureExtractionModuleIndex: ";
-                        errorLog << moduleIndex;
-                        errorLog << endl;
-                        return false;
-                    }
-                    
-                    //Overwrite the input vector with the features so this can either be input to the next feature module 
-                    //or converted to the LabelledClassificationData format
-                    inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
-                    featureDataReady = featureExtractionModules[moduleIndex]->getFeatureDataReady();
-                }
+            //Try to process the matrix data row-by-row
+            for(UINT r=0; r<trainingSample.getNumRows(); r++){
+                VectorDouble inputVector = trainingSample.getRowVector( r );
+                bool featureDataReady = true;
                 
-                //The feature extraction modules should only be reset on r == 0
-                resetFeatureExtractionModules = false;
+                //Pass the processed training data through the feature extraction
+                if( getIsFeatureExtractionSet() ){
                 
-                if( featureDataReady ){
-                    
-                    if( classifier->getTimeseriesCompatible() ){
-                        if( !featureData.push_back( inputVector ) ){
-                            errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To add feature vector to feature data matrix! FeatureExtractionModuleIndex: " << endl;
+                    for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+                        
+                        if( resetFeatureExtractionModules ){
+                            featureExtractionModules[moduleIndex]->reset();
+                        }
+                        
+                        if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
+                            errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To Compute Features For Training Data. FeatureExtractionModuleIndex: ";
+                            errorLog << moduleIndex;
+                            errorLog << endl;
                             return false;
                         }
-                    }else labelledClassificationData.addSample(classLabel, inputVector);
+                        
+                        //Overwrite the input vector with the features so this can either be input to the next feature module 
+                        //or converted to the LabelledClassificationData format
+                        inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
+                        featureDataReady = featureExtractionModules[moduleIndex]->getFeatureDataReady();
+                    }
+                    
+                    //The feature extraction modules should only be reset on r == 0
+                    resetFeatureExtractionModules = false;
                 }
                 
-            }else{
-                if( classifier->getTimeseriesCompatible() ){
+                if( featureDataReady ){
                     if( !featureData.push_back( inputVector ) ){
                         errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To add feature vector to feature data matrix! FeatureExtractionModuleIndex: " << endl;
                         return false;
                     }
                 }
-                else labelledClassificationData.addSample(classLabel, inputVector);
+            }
+            
+            if( useFeatureCache ){
+                featureCache->insert( cacheKeys[i], featureData );
             }
         }
         
         if( classifier->getTimeseriesCompatible() ) labelledTimeseriesClassificationData.addSample(classLabel, featureData);
+        else{
+            for(UINT r=0; r<featureData.getNumRows(); r++){
+                labelledClassificationData.addSample(classLabel, featureData.getRowVector( r ));
+            }
+        }
         
     }
         
@@ -547,35 +635,50 @@ bool GestureRecognitionPipeline::train(LabelledTimeSeriesClassificationData trai
     Timer timer;
     timer.start();
     
-    //Spilt the data into K folds
-    if( !trainingData.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling) ){
+    //Spilt the data into K folds, if a feature cache has been set then the folds are seeded from the data so each call uses the same folds
+    const unsigned long long randomSeed = featureCache != NULL ? hashTrainingData( trainingData, GRT_FEATURE_CACHE_HASH_OFFSET ) | 1 : 0;
+    if( !trainingData.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling, randomSeed) ){
         errorLog << "train(LabelledTimeSeriesClassificationData trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed To Spilt Dataset into KFolds!" << endl;
         return false;
     }
     
     //Run the k-fold training and testing
     double crossValidationAccuracy = 0;
-    LabelledTimeSeriesClassificationData foldTrainingData;
-    LabelledTimeSeriesClassificationData foldTestData;
     
-    for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-		foldTrainingData = trainingData.getTrainingFoldData(k);
-        
-        if( !train( foldTrainingData ) ){
-            errorLog << "train(LabelledTimeSeriesClassificationData trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to train pipeline for fold " << k << "." << endl;
+    if( numThreads > 1 && kFoldValue > 1 ){
+        //Run the folds on the worker threads, the fold results are merged in fold order so they match the serial path
+        vector< TestResult > foldResults;
+        if( !trainKFoldsInParallel( trainingData, kFoldValue, foldResults ) ){
+            errorLog << "train(LabelledTimeSeriesClassificationData trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to train pipeline in parallel!" << endl;
             return false;
         }
         
-        //Test the classification system
-        foldTestData = trainingData.getTestFoldData(k);
-        
-        if( !test( foldTestData ) ){
-            errorLog << "train(LabelledTimeSeriesClassificationData trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to test pipeline for fold " << k << "." << endl;
-            return false;
+        for(UINT k=0; k<kFoldValue; k++){
+            crossValidationAccuracy += foldResults[k].accuracy;
         }
+    }else{
+        LabelledTimeSeriesClassificationData foldTrainingData;
+        LabelledTimeSeriesClassificationData foldTestData;
         
-        crossValidationAccuracy += getTestAccuracy();
+        for(UINT k=0; k<kFoldValue; k++){
+            ///Train the classification system
+            foldTrainingData = trainingData.getTrainingFoldData(k);
+            
+            if( !train( foldTrainingData ) ){
+                errorLog << "train(LabelledTimeSeriesClassificationData trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to train pipeline for fold " << k << "." << endl;
+                return false;
+            }
+            
+            //Test the classification system
+            foldTestData = trainingData.getTestFoldData(k);
+            
+            if( !test( foldTestData ) ){
+                errorLog << "train(LabelledTimeSeriesClassificationData trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to test pipeline for fold " << k << "." << endl;
+                return false;
+            }
+            
+            crossValidationAccuracy += getTestAccuracy();
+        }
     }
 
     //Flag that the model has been trained
@@ -631,7 +734,32 @@ bool GestureRecognitionPipeline::train(LabelledRegressionData trainingData){
     
     processedTrainingData.setInputAndTargetDimensions(numInputs, numTargets);
     
-    for(UINT i=0; i<trainingData.getNumSamples(); i++){
+    //If a feature cache has been set, then try to get the processed training data from the cache before running the front end modules
+    unsigned long long cacheKey = 0;
+    bool useFeatureCache = getFrontEndHash( "LabelledRegressionData", cacheKey );
+    bool featuresCached = false;
+    MatrixDouble processedInputData;
+    vector< UINT > sampleIndexes;
+    if( useFeatureCache ){
+        cacheKey = hashTrainingData( trainingData, cacheKey );
+        if( featureCache->lookup( cacheKey, processedInputData, sampleIndexes, preProcessingModules, featureExtractionModules ) ){
+            featuresCached = processedInputData.getNumRows() == sampleIndexes.size() && (processedInputData.getNumRows() == 0 || processedInputData.getNumCols() == numInputs);
+            for(UINT i=0; i<sampleIndexes.size() && featuresCached; i++){
+                if( sampleIndexes[i] < trainingData.getNumSamples() ){
+                    featuresCached = processedTrainingData.addSample( processedInputData.getRowVector(i), trainingData[ sampleIndexes[i] ].getTargetVector() );
+                }else featuresCached = false;
+            }
+            if( !featuresCached ){
+                warningLog << "train(const LabelledRegressionData trainingData) - The feature cache entry does not match the training data, the entry will be replaced!" << endl;
+                processedTrainingData.clear();
+                processedInputData.clear();
+                sampleIndexes.clear();
+                reset();
+            }
+        }
+    }
+    
+    for(UINT i=0; i<trainingData.getNumSamples() && !featuresCached; i++){
         VectorDouble inputVector = trainingData[i].getInputVector();
         VectorDouble targetVector = trainingData[i].getTargetVector();
         
@@ -662,6 +790,19 @@ bool GestureRecognitionPipeline::train(LabelledRegressionData trainingData){
             errorLog << "train(const LabelledRegressionData trainingData) - Failed to add processed training sample to training data" << endl;
             return false;
         }
+        
+        if( useFeatureCache ){
+            processedInputData.push_back( inputVector );
+            sampleIndexes.push_back( i );
+        }
+    }
+    
+    if( useFeatureCache && !featuresCached ){
+#if __cplusplus >= 201103L
+        featureCache->insert( cacheKey, std::move( processedInputData ), sampleIndexes, preProcessingModules, featureExtractionModules );
+#else
+        featureCache->insert( cacheKey, processedInputData, sampleIndexes, preProcessingModules, featureExtractionModules );
+#endif
     }
     
     //Store the number of training samples
@@ -708,8 +849,9 @@ bool GestureRecognitionPipeline::train(LabelledRegressionData trainingData,const
     Timer timer;
     timer.start();
     
-    //Spilt the data into K folds
-    bool spiltResult = trainingData.spiltDataIntoKFolds(kFoldValue);
+    //Spilt the data into K folds, if a feature cache has been set then the folds are seeded from the data so each call uses the same folds
+    const unsigned long long randomSeed = featureCache != NULL ? hashTrainingData( trainingData, GRT_FEATURE_CACHE_HASH_OFFSET ) | 1 : 0;
+    bool spiltResult = trainingData.spiltDataIntoKFolds(kFoldValue, randomSeed);
     
     if( !spiltResult ){
         return false;
@@ -717,25 +859,38 @@ bool GestureRecognitionPipeline::train(LabelledRegressionData trainingData,const
     
     //Run the k-fold training and testing
     double crossValidationAccuracy = 0;
-    LabelledRegressionData foldTrainingData;
-    LabelledRegressionData foldTestData;
-    for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-        foldTrainingData = trainingData.getTrainingFoldData(k);
-        
-        if( !train( foldTrainingData ) ){
+    
+    if( numThreads > 1 && kFoldValue > 1 ){
+        //Run the folds on the worker threads, the fold results are merged in fold order so they match the serial path
+        vector< TestResult > foldResults;
+        if( !trainKFoldsInParallel( trainingData, kFoldValue, foldResults ) ){
             return false;
         }
         
-        //Test the classification system
-        foldTestData = trainingData.getTestFoldData(k);
-        
-        if( !test( foldTestData ) ){
-            return false;
+        for(UINT k=0; k<kFoldValue; k++){
+            crossValidationAccuracy += foldResults[k].rmsError;
         }
+    }else{
+        LabelledRegressionData foldTrainingData;
+        LabelledRegressionData foldTestData;
+        for(UINT k=0; k<kFoldValue; k++){
+            ///Train the classification system
+            foldTrainingData = trainingData.getTrainingFoldData(k);
+            
+            if( !train( foldTrainingData ) ){
+                return false;
+            }
+            
+            //Test the classification system
+            foldTestData = trainingData.getTestFoldData(k);
+            
+            if( !test( foldTestData ) ){
+                return false;
+            }
 
-        crossValidationAccuracy += getTestRMSError();
-        
+            crossValidationAccuracy += getTestRMSError();
+            
+        }
     }
 
     //Flag that the model has been trained
@@ -748,6 +903,241 @@ bool GestureRecognitionPipeline::train(LabelledRegressionData trainingData,const
     
     return true;
 }
+
+/**
+ Shared state for one of the k-fold cross validation worker threads. The fold counter, failed fold index and last fold pipeline are shared by all
+ the workers and are protected by the mutex, everything else is owned by the worker.
+ */
+/**
+ Gets the training data for the k-th fold.  The classification training fold is a view of the training data, so the workers do not each hold a copy
+ of the training samples, the other data types do not have views so their folds are copied.
+ */
+static LabelledClassificationDataView getTrainingFold(const LabelledClassificationData &trainingData,const UINT k){
+    return trainingData.getTrainingFoldView( k );
+}
+
+static LabelledTimeSeriesClassificationData getTrainingFold(const LabelledTimeSeriesClassificationData &trainingData,const UINT k){
+    return trainingData.getTrainingFoldData( k );
+}
+
+static LabelledRegressionData getTrainingFold(const LabelledRegressionData &trainingData,const UINT k){
+    return trainingData.getTrainingFoldData( k );
+}
+
+template< class T >
+struct KFoldWorkerData{
+    GestureRecognitionPipeline *pipeline;
+    const T *trainingData;
+    vector< TestResult > *foldResults;
+    UINT kFoldValue;
+    UINT *nextFoldIndex;
+    UINT *failedFoldIndex;
+    GestureRecognitionPipeline **lastFoldPipeline;
+    pthread_mutex_t *mutex;
+};
+
+template< class T >
+void* kFoldWorkerThread(void *workerData){
+    
+    KFoldWorkerData< T > *worker = (KFoldWorkerData< T >*)workerData;
+    
+    while( true ){
+        //Grab the next fold, the folds are handed out in order so the worker that gets the last fold will run it last
+        pthread_mutex_lock( worker->mutex );
+        if( *worker->nextFoldIndex >= worker->kFoldValue || *worker->failedFoldIndex < worker->kFoldValue ){
+            pthread_mutex_unlock( worker->mutex );
+            break;
+        }
+        const UINT k = (*worker->nextFoldIndex)++;
+        if( k == worker->kFoldValue-1 ){
+            *worker->lastFoldPipeline = worker->pipeline;
+        }
+        pthread_mutex_unlock( worker->mutex );
+        
+        //Train and test this worker's copy of the pipeline with the k-th fold
+        bool foldResult = worker->pipeline->train( getTrainingFold( *worker->trainingData, k ) );
+        
+        if( foldResult ){
+            foldResult = worker->pipeline->test( worker->trainingData->getTestFoldData(k) );
+        }
+        
+        if( !foldResult ){
+            pthread_mutex_lock( worker->mutex );
+            if( k < *worker->failedFoldIndex ) *worker->failedFoldIndex = k;
+            pthread_mutex_unlock( worker->mutex );
+            break;
+        }
+        
+        (*worker->foldResults)[k] = worker->pipeline->getTestResults();
+    }
+    
+    return NULL;
+}
+
+template< class T >
+bool GestureRecognitionPipeline::trainKFoldsInParallel(const T &trainingData,const UINT kFoldValue,vector< TestResult > &foldResults){
+    
+    const UINT numWorkers = numThreads < kFoldValue ? numThreads : kFoldValue;
+    UINT nextFoldIndex = 0;
+    UINT failedFoldIndex = kFoldValue;
+    GestureRecognitionPipeline *lastFoldPipeline = NULL;
+    pthread_mutex_t mutex;
+    pthread_mutex_init( &mutex, NULL );
+    
+    foldResults.clear();
+    foldResults.resize( kFoldValue );
+    
+    //Each worker gets its own deep copy of the pipeline, the training data is shared read-only
+    vector< GestureRecognitionPipeline* > pipelines( numWorkers );
+    vector< KFoldWorkerData< T > > workers( numWorkers );
+    for(UINT i=0; i<numWorkers; i++){
+        pipelines[i] = new GestureRecognitionPipeline( *this );
+        workers[i].pipeline = pipelines[i];
+        workers[i].trainingData = &trainingData;
+        workers[i].foldResults = &foldResults;
+        workers[i].kFoldValue = kFoldValue;
+        workers[i].nextFoldIndex = &nextFoldIndex;
+        workers[i].failedFoldIndex = &failedFoldIndex;
+        workers[i].lastFoldPipeline = &lastFoldPipeline;
+        workers[i].mutex = &mutex;
+    }
+    
+    //Start the worker threads, the calling thread acts as the first worker. If a thread can not be started then its folds will be run by the other workers
+    vector< pthread_t > threads( numWorkers );
+    vector< bool > threadStarted( numWorkers, false );
+    for(UINT i=1; i<numWorkers; i++){
+        threadStarted[i] = pthread_create( &threads[i], NULL, kFoldWorkerThread< T >, &workers[i] ) == 0;
+        if( !threadStarted[i] ){
+            warningLog << "trainKFoldsInParallel(const T &trainingData,const UINT kFoldValue,vector< TestResult > &foldResults) - Failed to start worker thread " << i << "!" << endl;
+        }
+    }
+    
+    kFoldWorkerThread< T >( &workers[0] );
+    
+    for(UINT i=1; i<numWorkers; i++){
+        if( threadStarted[i] ) pthread_join( threads[i], NULL );
+    }
+    pthread_mutex_destroy( &mutex );
+    
+    bool result = failedFoldIndex == kFoldValue;
+    
+    if( result ){
+        //Leave this pipeline in the same state as the serial path, which is trained and tested on the last fold
+        *this = *lastFoldPipeline;
+    }else{
+        errorLog << "trainKFoldsInParallel(const T &trainingData,const UINT kFoldValue,vector< TestResult > &foldResults) - Failed to train or test pipeline for fold " << failedFoldIndex << "." << endl;
+    }
+    
+    for(UINT i=0; i<numWorkers; i++){
+        delete pipelines[i];
+        pipelines[i] = NULL;
+    }
+    
+    return result;
+}
+
+bool GestureRecognitionPipeline::getFrontEndHash(const string &dataType,unsigned long long &frontEndHash) const{
+    
+    if( featureCache == NULL || (!getIsPreProcessingSet() && !getIsFeatureExtractionSet()) ){
+        return false;
+    }
+    
+    //Write the settings of the modules to a string, at full precision so any change to a setting changes the hash
+    std::ostringstream settings;
+    settings.precision( numeric_limits< double >::digits10 + 2 );
+    
+    bool ok = true;
+    settings << dataType << endl;
+    for(UINT i=0; i<preProcessingModules.size() && ok; i++){
+        settings << preProcessingModules[i]->getPreProcessingType() << endl;
+        ok = preProcessingModules[i]->saveSettingsToFile( settings );
+    }
+    for(UINT i=0; i<featureExtractionModules.size() && ok; i++){
+        settings << featureExtractionModules[i]->getFeatureExtractionType() << endl;
+        ok = featureExtractionModules[i]->saveSettingsToFile( settings );
+    }
+    
+    if( !ok ){
+        warningLog << "getFrontEndHash(const string &dataType,unsigned long long &frontEndHash) - Failed to get the settings of a module, the feature cache will not be used!" << endl;
+        return false;
+    }
+    
+    frontEndHash = FeatureCache::hash( settings.str() );
+    
+    return true;
+}
+
+unsigned long long GestureRecognitionPipeline::hashTrainingData(const LabelledClassificationData &trainingData,const unsigned long long hash){
+    
+    const UINT numSamples = trainingData.getNumSamples();
+    const UINT numDimensions = trainingData.getNumDimensions();
+    unsigned long long value = FeatureCache::hash( &numSamples, sizeof(numSamples), hash );
+    value = FeatureCache::hash( &numDimensions, sizeof(numDimensions), value );
+    for(UINT i=0; i<numSamples; i++){
+        const UINT classLabel = trainingData[i].getClassLabel();
+        value = FeatureCache::hash( &classLabel, sizeof(classLabel), value );
+        if( numDimensions > 0 ) value = FeatureCache::hash( trainingData[i].getData(), numDimensions*sizeof(double), value );
+    }
+    
+    return value;
+}
+
+unsigned long long GestureRecognitionPipeline::hashTrainingData(const LabelledClassificationDataView &trainingData,const unsigned long long hash){
+    
+    //The samples are hashed in the same way as a LabelledClassificationData, so a view and a copy of the view have the same hash
+    const UINT numSamples = trainingData.getNumSamples();
+    const UINT numDimensions = trainingData.getNumDimensions();
+    unsigned long long value = FeatureCache::hash( &numSamples, sizeof(numSamples), hash );
+    value = FeatureCache::hash( &numDimensions, sizeof(numDimensions), value );
+    for(UINT i=0; i<numSamples; i++){
+        const UINT classLabel = trainingData[i].getClassLabel();
+        value = FeatureCache::hash( &classLabel, sizeof(classLabel), value );
+        if( numDimensions > 0 ) value = FeatureCache::hash( trainingData[i].getData(), numDimensions*sizeof(double), value );
+    }
+    
+    return value;
+}
+
+unsigned long long GestureRecognitionPipeline::hashTrainingData(const LabelledTimeSeriesClassificationData &trainingData,const unsigned long long hash){
+    
+    const UINT numSamples = trainingData.getNumSamples();
+    unsigned long long value = FeatureCache::hash( &numSamples, sizeof(numSamples), hash );
+    for(UINT i=0; i<numSamples; i++){
+        const UINT classLabel = trainingData[i].getClassLabel();
+        value = FeatureCache::hash( &classLabel, sizeof(classLabel), value );
+        value = hashTimeSeries( trainingData[i].getData(), value );
+    }
+    
+    return value;
+}
+
+unsigned long long GestureRecognitionPipeline::hashTrainingData(const LabelledRegressionData &trainingData,const unsigned long long hash){
+    
+    const UINT numSamples = trainingData.getNumSamples();
+    const UINT numInputDimensions = trainingData.getNumInputDimensions();
+    const UINT numTargetDimensions = trainingData.getNumTargetDimensions();
+    unsigned long long value = FeatureCache::hash( &numSamples, sizeof(numSamples), hash );
+    value = FeatureCache::hash( &numInputDimensions, sizeof(numInputDimensions), value );
+    value = FeatureCache::hash( &numTargetDimensions, sizeof(numTargetDimensions), value );
+    for(UINT i=0; i<numSamples; i++){
+        const VectorDouble &inputVector = trainingData[i].getInputVector();
+        const VectorDouble &targetVector = trainingData[i].getTargetVector();
+        if( inputVector.size() > 0 ) value = FeatureCache::hash( &inputVector[0], inputVector.size()*sizeof(double), value );
+        if( targetVector.size() > 0 ) value = FeatureCache::hash( &targetVector[0], targetVector.size()*sizeof(double), value );
+    }
+    
+    return value;
+}
+
+unsigned long long GestureRecognitionPipeline::hashTimeSeries(const MatrixDouble &timeSeries,const unsigned long long hash){
+    
+    const UINT numRows = timeSeries.getNumRows();
+    const UINT numCols = timeSeries.getNumCols();
+    unsigned long long value = FeatureCache::hash( &numRows, sizeof(numRows), hash );
+    value = FeatureCache::hash( &numCols, sizeof(numCols), value );
+    
+    return FeatureCache::hash( timeSeries.getData(), timeSeries.getSize()*sizeof(double), value );
+}
     
 bool GestureRecognitionPipeline::test(const LabelledClassificationData &testData){
     
@@ -825,19 +1215,22 @@ bool GestureRecognitionPipeline::test(const LabelledClassificationData &testData
     Timer timer;
     timer.start();
 
+    //Pass all the test samples through the pipeline as one batch
+    vector< UINT > unProcessedClassLabels;
+    vector< UINT > predictedClassLabels;
+    MatrixDouble testLikelihoods;
+    MatrixDouble testDistances;
+    if( !predictBatch_classifier(testData.getDataAsMatrixDouble(),unProcessedClassLabels,predictedClassLabels,testLikelihoods,testDistances) ){
+        errorLog << "test(LabelledClassificationData testData) - Prediction failed for the test data!" << endl;
+        return false;
+    }
+
     //Run the test
     for(UINT i=0; i<numTestSamples; i++){
         UINT classLabel = testData[i].getClassLabel();
-        VectorDouble testSample = testData[i].getSample();
-        
-        //Pass the test sample through the pipeline
-        if( !predict( testSample ) ){
-            errorLog << "test(LabelledClassificationData testData) - Prediction failed for test sample at index: " << i << endl;
-            return false;
-        }
         
         //Update the test metrics
-        UINT predictedClassLabel = getPredictedClassLabel();
+        UINT predictedClassLabel = predictedClassLabels[i];
         
         if( !updateTestMetrics(classLabel,predictedClassLabel,precisionCounter,recallCounter,rejectionPrecisionCounter,rejectionRecallCounter, confusionMatrixCounter) ){
             errorLog << "test(LabelledClassificationData testData) - Failed to update test metrics at test sample index: " << i << endl;
@@ -845,7 +1238,7 @@ bool GestureRecognitionPipeline::test(const LabelledClassificationData &testData
         }
         
         //Keep track of the classification results encase the user needs them later
-        testResults[i].setClassificationResult(i, classLabel, predictedClassLabel, getUnProcessedPredictedClassLabel(),getClassLikelihoods(), getClassDistances());
+        testResults[i].setClassificationResult(i, classLabel, predictedClassLabel, unProcessedClassLabels[i], testLikelihoods.getRowVector(i), testDistances.getRowVector(i));
 
         //Update any observers
         classifier->notifyTestResultsObservers( testResults[i] );
@@ -1130,11 +1523,17 @@ bool GestureRecognitionPipeline::predict(const VectorDouble &inputVector){
     }
 
 	if( getIsClassifierSet() ){
-        return predict_classifier( inputVector );
+        GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::PREDICT, 0 );
+        if( !predict_classifier( inputVector ) ) return false;
+        GRT_PROFILE_STAGE_SUCCESS( profilerScope );
+        return true;
     }
 
 	if( getIsRegressifierSet() ){
-        return predict_regressifier( inputVector );
+        GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::PREDICT, 0 );
+        if( !predict_regressifier( inputVector ) ) return false;
+        GRT_PROFILE_STAGE_SUCCESS( profilerScope );
+        return true;
     }
 
     errorLog << "predict(const VectorDouble &inputVector) - Neither a classifier or regressifer is not set" << endl;
@@ -1160,6 +1559,9 @@ bool GestureRecognitionPipeline::predict(MatrixDouble inputMatrix){
 		return false;
     }
 
+    //Only the whole call is profiled here, as each module processes the entire matrix rather than one sample
+    GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::PREDICT, 0 );
+
 	predictedClassLabel = 0;
     
     //Update the context module
@@ -1277,14 +1679,29 @@ bool GestureRecognitionPipeline::predict(MatrixDouble inputMatrix){
     //TODO
     predictionModuleIndex = END_OF_PIPELINE;
 
+    GRT_PROFILE_STAGE_SUCCESS( profilerScope );
 	return true;
 }
 
-bool GestureRecognitionPipeline::map(VectorDouble inputVector){
+bool GestureRecognitionPipeline::predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels){
+    MatrixDouble classLikelihoods;
+    MatrixDouble classDistances;
+    return predictBatch(inputData,predictedClassLabels,classLikelihoods,classDistances);
+}
+    
+bool GestureRecognitionPipeline::predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &classLikelihoods,MatrixDouble &classDistances){
+    vector< UINT > unProcessedClassLabels;
+    return predictBatch_classifier(inputData,unProcessedClassLabels,predictedClassLabels,classLikelihoods,classDistances);
+}
+
+bool GestureRecognitionPipeline::map(const VectorDouble &inputVector){
 	return predict_regressifier( inputVector );
 }
 
-bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
+bool GestureRecognitionPipeline::predict_classifier(const VectorDouble &inputVector){
+    
+    //The data pointer tracks the output of the most recent module, this avoids copying the data between each stage of the pipeline
+    const VectorDouble *data = &inputVector;
     
     predictedClassLabel = 0;
     
@@ -1292,25 +1709,30 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     predictionModuleIndex = START_OF_PIPELINE;
     if( contextModules[ START_OF_PIPELINE ].size() > 0 ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ START_OF_PIPELINE ].size(); moduleIndex++){
-            if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::START_OF_PIPELINE_CONTEXT, moduleIndex );
+            if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( *data ) ){
+                errorLog << "predict_classifier(const VectorDouble &inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
                 return false;
             }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
             if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->getOK() ){
                 return true;
             }
-            inputVector = contextModules[ START_OF_PIPELINE ][moduleIndex]->getProcessedData();
+            data = &contextModules[ START_OF_PIPELINE ][moduleIndex]->getProcessedData();
         }
     }
     
     //Perform any pre-processing
     if( getIsPreProcessingSet() ){
-        for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
-            if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
+        const vector< PreProcessing* > &modules = getActivePreProcessingModules();
+        for(UINT moduleIndex=0; moduleIndex<modules.size(); moduleIndex++){
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::PREPROCESSING, moduleIndex );
+            if( !modules[moduleIndex]->process( *data ) ){
+                errorLog << "predict_classifier(const VectorDouble &inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
                 return false;
             }
-            inputVector = preProcessingModules[moduleIndex]->getProcessedData();
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
+            data = &modules[moduleIndex]->getProcessedData();
         }
     }
     
@@ -1318,26 +1740,30 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     predictionModuleIndex = AFTER_PREPROCESSING;
     if( contextModules[ AFTER_PREPROCESSING ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << endl;
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::AFTER_PREPROCESSING_CONTEXT, moduleIndex );
+            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( *data ) ){
+                errorLog << "predict_classifier(const VectorDouble &inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << endl;
                 return false;
             }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
             if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getOK() ){
                 predictionModuleIndex = AFTER_PREPROCESSING;
                 return false;
             }
-            inputVector = contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
+            data = &contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
         }
     }
     
     //Perform any feature extraction
     if( getIsFeatureExtractionSet() ){
         for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
-            if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::FEATURE_EXTRACTION, moduleIndex );
+            if( !featureExtractionModules[moduleIndex]->computeFeatures( *data ) ){
+                errorLog << "predict_classifier(const VectorDouble &inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
                 return false;
             }
-            inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
+            data = &featureExtractionModules[moduleIndex]->getFeatureVector();
         }
     }
     
@@ -1345,32 +1771,43 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
     if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << endl;
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::AFTER_FEATURE_EXTRACTION_CONTEXT, moduleIndex );
+            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( *data ) ){
+                errorLog << "predict_classifier(const VectorDouble &inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << endl;
                 return false;
             }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
             if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getOK() ){
                 predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
                 return false;
             }
-            inputVector = contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
+            data = &contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
         }
     }
     
-    //Perform the classification
-    if( !classifier->predict(inputVector) ){
-        errorLog << "predict_classifier(VectorDouble inputVector) - Prediction Failed! " << classifier->getLastErrorMessage() << endl;
-        return false;
+    //Perform the classification, the classifier may modify its input (i.e. scaling) so we give it a copy in the reusable input buffer
+    predictionInputBuffer = *data;
+    {
+        GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::CLASSIFIER, 0 );
+        if( !classifier->predictInplace( predictionInputBuffer ) ){
+            errorLog << "predict_classifier(const VectorDouble &inputVector) - Prediction Failed! " << classifier->getLastErrorMessage() << endl;
+            return false;
+        }
+        GRT_PROFILE_STAGE_SUCCESS( profilerScope );
     }
     predictedClassLabel = classifier->getPredictedClassLabel();
     
     //Update the context module
     if( contextModules[ AFTER_CLASSIFIER ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_CLASSIFIER ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( vector<double>(1,predictedClassLabel) ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << endl;
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::AFTER_CLASSIFIER_CONTEXT, moduleIndex );
+            predictionLabelBuffer.resize(1);
+            predictionLabelBuffer[0] = predictedClassLabel;
+            if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( predictionLabelBuffer ) ){
+                errorLog << "predict_classifier(const VectorDouble &inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << endl;
                 return false;
             }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
             if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->getOK() ){
                 predictionModuleIndex = AFTER_CLASSIFIER;
                 return false;
@@ -1384,97 +1821,253 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     if( getIsPostProcessingSet() ){
         
         if( pipelineMode != CLASSIFICATION_MODE){
-            errorLog << "predict_classifier(VectorDouble inputVector) - Pipeline Mode Is Not in CLASSIFICATION_MODE!" << endl;
+            errorLog << "predict_classifier(const VectorDouble &inputVector) - Pipeline Mode Is Not in CLASSIFICATION_MODE!" << endl;
             return false;
         }
         
-        VectorDouble data;
         for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::POSTPROCESSING, moduleIndex );
             
             //Select which input we should give the postprocessing module
             if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() ){
                 //Set the input
-                data.resize(1);
-                data[0] = predictedClassLabel;
+                predictionLabelBuffer.resize(1);
+                predictionLabelBuffer[0] = predictedClassLabel;
                 
                 //Verify that the input size is OK
-                if( data.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
-                    errorLog << "predict_classifier(VectorDouble inputVector) - The size of the data vector (" << int(data.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
+                if( predictionLabelBuffer.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
+                    errorLog << "predict_classifier(const VectorDouble &inputVector) - The size of the data vector (" << int(predictionLabelBuffer.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
                     return false;
                 }
                 
                 //Postprocess the data
-                if( !postProcessingModules[moduleIndex]->process( data ) ){
-                    errorLog << "predict_classifier(VectorDouble inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
+                if( !postProcessingModules[moduleIndex]->process( predictionLabelBuffer ) ){
+                    errorLog << "predict_classifier(const VectorDouble &inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
                     return false;
                 }
-                
-                //Select which output we should update
-                data = postProcessingModules[moduleIndex]->getProcessedData();  
             }
             
             //Select which output we should update
             if( postProcessingModules[moduleIndex]->getIsPostProcessingOutputModePredictedClassLabel() ){
                 //Get the processed predicted class label
-                data = postProcessingModules[moduleIndex]->getProcessedData(); 
+                const VectorDouble &processedData = postProcessingModules[moduleIndex]->getProcessedData(); 
                 
                 //Verify that the output size is OK
-                if( data.size() != 1 ){
-                    errorLog << "predict_classifier(VectorDouble inputVector) - The size of the processed data vector (" << int(data.size()) << ") from postProcessingModule at the moduleIndex: " << moduleIndex << " is not equal to 1 even though it is in OutputModePredictedClassLabel!" << endl;
+                if( processedData.size() != 1 ){
+                    errorLog << "predict_classifier(const VectorDouble &inputVector) - The size of the processed data vector (" << int(processedData.size()) << ") from postProcessingModule at the moduleIndex: " << moduleIndex << " is not equal to 1 even though it is in OutputModePredictedClassLabel!" << endl;
                     return false;
                 }
                 
-                //Update the predicted class label
-                predictedClassLabel = (UINT)data[0];
+                //Update the predicted class label
+                predictedClassLabel = (UINT)processedData[0];
+            }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
+                  
+        }
+    } 
+    
+    //Update the context module
+    predictionModuleIndex = END_OF_PIPELINE;
+    if( contextModules[ END_OF_PIPELINE ].size() ){
+        for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::END_OF_PIPELINE_CONTEXT, moduleIndex );
+            predictionLabelBuffer.resize(1);
+            predictionLabelBuffer[0] = predictedClassLabel;
+            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( predictionLabelBuffer ) ){
+                errorLog << "predict_classifier(const VectorDouble &inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
+                return false;
+            }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
+            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->getOK() ){
+                predictionModuleIndex = END_OF_PIPELINE;
+                return false;
+            }
+            predictedClassLabel = (UINT)contextModules[ END_OF_PIPELINE ][moduleIndex]->getProcessedData()[0];
+        }
+    }
+    
+    return true;
+}
+    
+bool GestureRecognitionPipeline::predictBatch_classifier(const MatrixDouble &inputData,vector< UINT > &unProcessedClassLabels,vector< UINT > &predictedClassLabels,MatrixDouble &classLikelihoods,MatrixDouble &classDistances){
+    
+    //Make sure the classification model has been trained
+    if( !trained ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - The classifier has not been trained" << endl;
+        return false;
+    }
+    
+    if( !getIsClassifierSet() ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - A classifier has not been set" << endl;
+        return false;
+    }
+    
+    //Make sure the dimensionality of the input data matches the inputVectorDimensions
+    if( inputData.getNumCols() != inputVectorDimensions ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - The dimensionality of the input data (" << inputData.getNumCols() << ") does not match that of the input vector dimensions of the pipeline (" << inputVectorDimensions << ")" << endl;
+        return false;
+    }
+    
+    const UINT M = inputData.getNumRows();
+    predictedClassLabel = 0;
+    
+    //Context modules can stop a prediction part way through the pipeline, so in this case each row is passed through the pipeline on its own
+    if( getIsContextSet() ){
+        const UINT K = classifier->getNumClasses();
+        unProcessedClassLabels.resize( M );
+        predictedClassLabels.resize( M );
+        classLikelihoods.resize( M, K );
+        classDistances.resize( M, K );
+        
+        VectorDouble inputVector( inputVectorDimensions );
+        for(UINT i=0; i<M; i++){
+            std::copy( inputData[i], inputData[i]+inputVectorDimensions, inputVector.begin() );
+            
+            if( !predict_classifier( inputVector ) ){
+                errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - Prediction failed for row: " << i << endl;
+                return false;
+            }
+            
+            unProcessedClassLabels[i] = classifier->getPredictedClassLabel();
+            predictedClassLabels[i] = predictedClassLabel;
+            
+            VectorDouble likelihoods = classifier->getClassLikelihoods();
+            VectorDouble distances = classifier->getClassDistances();
+            for(UINT k=0; k<K; k++){
+                classLikelihoods[i][k] = k < likelihoods.size() ? likelihoods[k] : 0;
+                classDistances[i][k] = k < distances.size() ? distances[k] : 0;
+            }
+        }
+        return true;
+    }
+    
+    //Pass the whole block through each module in turn, the two buffers are swapped between each stage so the data is not copied
+    const MatrixDouble *data = &inputData;
+    MatrixDouble buffers[2];
+    UINT bufferIndex = 0;
+    
+    //Perform any pre-processing
+    predictionModuleIndex = START_OF_PIPELINE;
+    if( getIsPreProcessingSet() ){
+        const vector< PreProcessing* > &modules = getActivePreProcessingModules();
+        for(UINT moduleIndex=0; moduleIndex<modules.size(); moduleIndex++){
+            if( !modules[moduleIndex]->processBatch( *data, buffers[bufferIndex] ) ){
+                errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - Failed to PreProcess Input Data. PreProcessingModuleIndex: " << moduleIndex << endl;
+                return false;
+            }
+            data = &buffers[bufferIndex];
+            bufferIndex = 1 - bufferIndex;
+        }
+    }
+    
+    //Perform any feature extraction
+    predictionModuleIndex = AFTER_PREPROCESSING;
+    if( getIsFeatureExtractionSet() ){
+        for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+            if( !featureExtractionModules[moduleIndex]->computeFeaturesBatch( *data, buffers[bufferIndex] ) ){
+                errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
+                return false;
+            }
+            data = &buffers[bufferIndex];
+            bufferIndex = 1 - bufferIndex;
+        }
+    }
+    
+    //Perform the classification
+    predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
+    if( !classifier->predictBatch( *data, unProcessedClassLabels, classLikelihoods, classDistances ) ){
+        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - Prediction Failed! " << classifier->getLastErrorMessage() << endl;
+        return false;
+    }
+    predictedClassLabels = unProcessedClassLabels;
+    
+    //Perform any post processing, the post processing modules keep state so the rows are processed in order
+    predictionModuleIndex = AFTER_CLASSIFIER;
+    if( getIsPostProcessingSet() ){
+        
+        if( pipelineMode != CLASSIFICATION_MODE){
+            errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - Pipeline Mode Is Not in CLASSIFICATION_MODE!" << endl;
+            return false;
+        }
+        
+        for(UINT i=0; i<M; i++){
+            for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+                
+                //Select which input we should give the postprocessing module
+                if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() ){
+                    predictionLabelBuffer.resize(1);
+                    predictionLabelBuffer[0] = predictedClassLabels[i];
+                    
+                    //Verify that the input size is OK
+                    if( predictionLabelBuffer.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
+                        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - The size of the data vector (" << int(predictionLabelBuffer.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
+                        return false;
+                    }
+                    
+                    //Postprocess the data
+                    if( !postProcessingModules[moduleIndex]->process( predictionLabelBuffer ) ){
+                        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
+                        return false;
+                    }
+                }
+                
+                //Select which output we should update
+                if( postProcessingModules[moduleIndex]->getIsPostProcessingOutputModePredictedClassLabel() ){
+                    const VectorDouble &processedData = postProcessingModules[moduleIndex]->getProcessedData();
+                    
+                    //Verify that the output size is OK
+                    if( processedData.size() != 1 ){
+                        errorLog << "predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels) - The size of the processed data vector (" << int(processedData.size()) << ") from postProcessingModule at the moduleIndex: " << moduleIndex << " is not equal to 1 even though it is in OutputModePredictedClassLabel!" << endl;
+                        return false;
+                    }
+                    
+                    //Update the predicted class label
+                    predictedClassLabels[i] = (UINT)processedData[0];
+                }
             }
-                  
         }
-    } 
+    }
     
-    //Update the context module
+    //Leave the pipeline in the same state as if the last row had been passed to predict
+    if( M > 0 ) predictedClassLabel = predictedClassLabels[M-1];
     predictionModuleIndex = END_OF_PIPELINE;
-    if( contextModules[ END_OF_PIPELINE ].size() ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
-            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( vector<double>(1,predictedClassLabel) ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->getOK() ){
-                predictionModuleIndex = END_OF_PIPELINE;
-                return false;
-            }
-            predictedClassLabel = (UINT)contextModules[ END_OF_PIPELINE ][moduleIndex]->getProcessedData()[0];
-        }
-    }
     
     return true;
 }
     
-bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
+bool GestureRecognitionPipeline::predict_regressifier(const VectorDouble &inputVector){
+    
+    //The data pointer tracks the output of the most recent module, this avoids copying the data between each stage of the pipeline
+    const VectorDouble *data = &inputVector;
     
     //Update the context module
     predictionModuleIndex = START_OF_PIPELINE;
     if( contextModules[ START_OF_PIPELINE ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ START_OF_PIPELINE ].size(); moduleIndex++){
-            if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::START_OF_PIPELINE_CONTEXT, moduleIndex );
+            if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( *data ) ){
+                errorLog << "predict_regressifier(const VectorDouble &inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
                 return false;
             }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
             if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->getOK() ){
                 return true;
             }
-            inputVector = contextModules[ START_OF_PIPELINE ][moduleIndex]->getProcessedData();
+            data = &contextModules[ START_OF_PIPELINE ][moduleIndex]->getProcessedData();
         }
     }
     
     //Perform any pre-processing
     if( getIsPreProcessingSet() ){
-        for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
-            if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
+        const vector< PreProcessing* > &modules = getActivePreProcessingModules();
+        for(UINT moduleIndex=0; moduleIndex<modules.size(); moduleIndex++){
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::PREPROCESSING, moduleIndex );
+            if( !modules[moduleIndex]->process( *data ) ){
+                errorLog << "predict_regressifier(const VectorDouble &inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
                 return false;
             }
-            inputVector = preProcessingModules[moduleIndex]->getProcessedData();
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
+            data = &modules[moduleIndex]->getProcessedData();
         }
     }
     
@@ -1482,26 +2075,30 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     predictionModuleIndex = AFTER_PREPROCESSING;
     if( contextModules[ AFTER_PREPROCESSING ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << endl;
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::AFTER_PREPROCESSING_CONTEXT, moduleIndex );
+            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( *data ) ){
+                errorLog << "predict_regressifier(const VectorDouble &inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << endl;
                 return false;
             }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
             if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getOK() ){
                 predictionModuleIndex = AFTER_PREPROCESSING;
                 return false;
             }
-            inputVector = contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
+            data = &contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
         }
     }
     
     //Perform any feature extraction
     if( getIsFeatureExtractionSet() ){
         for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
-            if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::FEATURE_EXTRACTION, moduleIndex );
+            if( !featureExtractionModules[moduleIndex]->computeFeatures( *data ) ){
+                errorLog << "predict_regressifier(const VectorDouble &inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
                 return false;
             }
-            inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
+            data = &featureExtractionModules[moduleIndex]->getFeatureVector();
         }
     }
     
@@ -1509,32 +2106,41 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
     if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << endl;
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::AFTER_FEATURE_EXTRACTION_CONTEXT, moduleIndex );
+            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( *data ) ){
+                errorLog << "predict_regressifier(const VectorDouble &inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << endl;
                 return false;
             }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
             if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getOK() ){
                 predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
                 return false;
             }
-            inputVector = contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
+            data = &contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
         }
     }
     
-    //Perform the regression
-    if( !regressifier->predict(inputVector) ){
-        errorLog << "predict_regressifier(VectorDouble inputVector) - Prediction Failed! " << regressifier->getLastErrorMessage() << endl;
-        return false;
+    //Perform the regression, the regressifier may modify its input (i.e. scaling) so we give it a copy in the reusable input buffer
+    predictionInputBuffer = *data;
+    {
+        GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::REGRESSIFIER, 0 );
+        if( !regressifier->predictInplace( predictionInputBuffer ) ){
+            errorLog << "predict_regressifier(const VectorDouble &inputVector) - Prediction Failed! " << regressifier->getLastErrorMessage() << endl;
+            return false;
+        }
+        GRT_PROFILE_STAGE_SUCCESS( profilerScope );
     }
     regressionData = regressifier->getRegressionData();
     
     //Update the context module
     if( contextModules[ AFTER_CLASSIFIER ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_CLASSIFIER ].size(); moduleIndex++){
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::AFTER_CLASSIFIER_CONTEXT, moduleIndex );
             if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( regressionData ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << endl;
+                errorLog << "predict_regressifier(const VectorDouble &inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << endl;
                 return false;
             }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
             if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->getOK() ){
                 predictionModuleIndex = AFTER_CLASSIFIER;
                 return false;
@@ -1548,21 +2154,23 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     if( getIsPostProcessingSet() ){
         
         if( pipelineMode != REGRESSION_MODE ){
-            errorLog << "predict_regressifier(VectorDouble inputVector) - Pipeline Mode Is Not In RegressionMode!" << endl;
+            errorLog << "predict_regressifier(const VectorDouble &inputVector) - Pipeline Mode Is Not In RegressionMode!" << endl;
             return false;
         }
           
         for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::POSTPROCESSING, moduleIndex );
             if( regressionData.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - The size of the regression vector (" << int(regressionData.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
+                errorLog << "predict_regressifier(const VectorDouble &inputVector) - The size of the regression vector (" << int(regressionData.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
                 return false;
             }
             
             if( !postProcessingModules[moduleIndex]->process( regressionData ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
+                errorLog << "predict_regressifier(const VectorDouble &inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
                 return false;
             }
-            regressionData = postProcessingModules[moduleIndex]->getProcessedData();        
+            regressionData = postProcessingModules[moduleIndex]->getProcessedData();
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );        
         }
         
     } 
@@ -1571,10 +2179,12 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     predictionModuleIndex = END_OF_PIPELINE;
     if( contextModules[ END_OF_PIPELINE ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
-            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
+            GRT_PROFILE_STAGE( profilerScope, profiler, PipelineProfiler::END_OF_PIPELINE_CONTEXT, moduleIndex );
+            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( *data ) ){
+                errorLog << "predict_regressifier(const VectorDouble &inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
                 return false;
             }
+            GRT_PROFILE_STAGE_SUCCESS( profilerScope );
             if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->getOK() ){
                 predictionModuleIndex = END_OF_PIPELINE;
                 return false;
@@ -1596,6 +2206,9 @@ bool GestureRecognitionPipeline::reset(){
                 return false;
             }
         }
+        for(UINT i=0; i<fusedLinearFilters.size(); i++){
+            fusedLinearFilters[i]->reset();
+        }
     }
     
     //Reset any feature extraction
@@ -1653,6 +2266,60 @@ bool GestureRecognitionPipeline::savePipelineToFile(const string &filename){
         return false;
     }
     
+    const bool saved = savePipelineToFile( file, true );
+    
+    //Close the file
+    file.close();
+    
+    return saved;
+}
+
+bool GestureRecognitionPipeline::savePipelineToBinaryFile(const string &filename){
+    
+    if( !initialized ){
+        errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write pipeline to file as the pipeline has not been initialized yet!" << endl;
+        return false;
+    }
+    
+    BinaryModelWriter file;
+    if( !file.open( filename ) ){
+        errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to open file with filename: " << filename << endl;
+        return false;
+    }
+    
+    //The module types and the settings of the pre processing, feature extraction and post processing modules are small, so they are
+    //written as text in the same format as savePipelineToFile.  The classifier or regressifier then writes its own sections.
+    if( !file.beginTextSection( "Pipeline" ) ){
+        return false;
+    }
+    const bool settingsSaved = savePipelineToFile( file.getTextStream(), false );
+    if( !file.endTextSection() || !settingsSaved ){
+        errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write the pipeline settings!" << endl;
+        return false;
+    }
+    
+    switch( pipelineMode ){
+        case CLASSIFICATION_MODE:
+            if( getIsClassifierSet() && !classifier->saveModelToBinaryFile( file, "Classifier" ) ){
+                errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write classifier model to file!" << endl;
+                return false;
+            }
+            break;
+        case REGRESSION_MODE:
+            if( getIsRegressifierSet() && !regressifier->saveModelToBinaryFile( file, "Regressifier" ) ){
+                errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write regressifier model to file!" << endl;
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+    
+    return file.close();
+}
+
+bool GestureRecognitionPipeline::savePipelineToFile(fstream &file,const bool saveModel){
+    
     //Write the pipeline header info
     file << "GRT_PIPELINE_FILE_V1.0\n";
     file << "PipelineMode: " << getPipelineModeAsString() << endl;
@@ -1700,7 +2367,6 @@ bool GestureRecognitionPipeline::savePipelineToFile(const string &filename){
         file << "PreProcessingModule_" << Util::intToString(i+1) << endl;
         if( !preProcessingModules[i]->saveSettingsToFile( file ) ){
             errorLog << "Failed to write preprocessing module " << i << " settings to file!" << endl;
-            file.close();
             return false;
         }
     }
@@ -1710,19 +2376,18 @@ bool GestureRecognitionPipeline::savePipelineToFile(const string &filename){
         file << "FeatureExtractionModule_" << Util::intToString(i+1) << endl;
         if( !featureExtractionModules[i]->saveSettingsToFile( file ) ){
             errorLog << "Failed to write feature extraction module " << i << " settings to file!" << endl;
-            file.close();
             return false;
         }
     }
     
-    switch( pipelineMode ){
+    //The model is not written here when the pipeline is saved to a binary model file, it is written to its own sections
+    switch( saveModel ? pipelineMode : PIPELINE_MODE_NOT_SET ){
         case PIPELINE_MODE_NOT_SET:
             break;
         case CLASSIFICATION_MODE:
             if( getIsClassifierSet() ){
                 if( !classifier->saveModelToFile( file ) ){
                     errorLog << "Failed to write classifier model to file!" << endl;
-                    file.close();
                     return false;
                 }
             }
@@ -1731,7 +2396,6 @@ bool GestureRecognitionPipeline::savePipelineToFile(const string &filename){
             if( getIsRegressifierSet() ){
                 if( !regressifier->saveModelToFile( file ) ){
                     errorLog << "Failed to write regressifier model to file!" << endl;
-                    file.close();
                     return false;
                 }
             }
@@ -1745,19 +2409,20 @@ bool GestureRecognitionPipeline::savePipelineToFile(const string &filename){
         file << "PostProcessingModule_" << Util::intToString(i+1) << endl;
         if( !postProcessingModules[i]->saveSettingsToFile( file ) ){
             errorLog <<"Failed to write post processing module " << i << " settings to file!" << endl;
-            file.close();
             return false;
         }
     }
     
-    //Close the file
-    file.close();
-    
     return true;
 }
 
 bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
     
+    //Binary model files are detected by their header, so either format can be loaded
+    if( BinaryModelReader::isBinaryModelFile( filename ) ){
+        return loadPipelineFromBinaryFile( filename );
+    }
+    
     fstream file;
 
 	//Clear any previous setup
@@ -1769,14 +2434,79 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
         errorLog << "loadPipelineFromFile(string filename) - Failed to open file with filename: " << filename << endl;
         return false;
     }
+    
+    const bool loaded = loadPipelineFromFile( file, true );
+    
+    //Close the file
+    file.close();
+    
+    if( !loaded ) return false;
+    
+    updateInputVectorDimensions();
+    
+    return true;
+}
+
+bool GestureRecognitionPipeline::loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMapping){
+    
+	//Clear any previous setup
+	clearAll();
+    
+    BinaryModelReader file;
+    if( !file.open( filename, useMemoryMapping ) ){
+        errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMapping) - Failed to open file with filename: " << filename << endl;
+        return false;
+    }
+    
+    if( !file.beginTextSection( "Pipeline" ) || !loadPipelineFromFile( file.getTextStream(), false ) ){
+        errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMapping) - Failed to load the pipeline settings!" << endl;
+        return false;
+    }
+    
+    switch( pipelineMode ){
+        case CLASSIFICATION_MODE:
+            if( !classifier->loadModelFromBinaryFile( file, "Classifier" ) ){
+                errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMapping) - Failed to load classifier model from file!" << endl;
+                return false;
+            }
+            break;
+        case REGRESSION_MODE:
+            if( !regressifier->loadModelFromBinaryFile( file, "Regressifier" ) ){
+                errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMapping) - Failed to load regressifier model from file!" << endl;
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+    
+    updateInputVectorDimensions();
+    
+    return true;
+}
+
+bool GestureRecognitionPipeline::convertPipelineFile(const string &inputFilename,const string &outputFilename){
+    
+    GestureRecognitionPipeline pipeline;
+    
+    //Read the input into memory rather than mapping it, so the output can be written over the input
+    const bool binaryInput = BinaryModelReader::isBinaryModelFile( inputFilename );
+    const bool loaded = binaryInput ? pipeline.loadPipelineFromBinaryFile( inputFilename, false ) : pipeline.loadPipelineFromFile( inputFilename );
+    if( !loaded ){
+        return false;
+    }
+    
+    return binaryInput ? pipeline.savePipelineToFile( outputFilename ) : pipeline.savePipelineToBinaryFile( outputFilename );
+}
 
+bool GestureRecognitionPipeline::loadPipelineFromFile(fstream &file,const bool loadModel){
+    
 	string word;
 	
 	//Load the file header
 	file >> word;
 	if( word != "GRT_PIPELINE_FILE_V1.0" ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read file header" << endl;
-		file.close();
         return false;
 	}
 	
@@ -1784,7 +2514,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	file >> word;
 	if( word != "PipelineMode:" ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read PipelineMode" << endl;
-		file.close();
         return false;
 	}
 	file >> word;
@@ -1794,7 +2523,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	file >> word;
 	if( word != "NumPreprocessingModules:" ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read NumPreprocessingModules" << endl;
-		file.close();
         return false;
 	}
 	unsigned int numPreprocessingModules;
@@ -1804,7 +2532,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	file >> word;
 	if( word != "NumFeatureExtractionModules:" ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read NumFeatureExtractionModules" << endl;
-		file.close();
         return false;
 	}
 	unsigned int numFeatureExtractionModules;
@@ -1814,7 +2541,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	file >> word;
 	if( word != "NumPostprocessingModules:" ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read NumPostprocessingModules" << endl;
-		file.close();
         return false;
 	}
 	unsigned int numPostprocessingModules;
@@ -1824,7 +2550,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	file >> word;
 	if( word != "Trained:" ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read Trained" << endl;
-		file.close();
         return false;
 	}
 	file >> trained;
@@ -1838,7 +2563,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	file >> word;
 	if( word != "PreProcessingModuleDatatypes:" ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read PreProcessingModuleDatatypes" << endl;
-		file.close();
         return false;
 	}
     for(UINT i=0; i<numPreprocessingModules; i++){
@@ -1846,7 +2570,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 		preProcessingModules[i] = PreProcessing::createInstanceFromString( word );
 		if( preProcessingModules[i] == NULL ){
             errorLog << "loadPipelineFromFile(string filename) - Failed to create preprocessing instance from string: " << word << endl;
-			file.close();
 	        return false;
 		}
     }
@@ -1855,7 +2578,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	file >> word;
 	if( word != "FeatureExtractionModuleDatatypes:" ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read FeatureExtractionModuleDatatypes" << endl;
-		file.close();
         return false;
 	}
     for(UINT i=0; i<numFeatureExtractionModules; i++){
@@ -1863,7 +2585,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 		featureExtractionModules[i] = FeatureExtraction::createInstanceFromString( word );
 		if( featureExtractionModules[i] == NULL ){
             errorLog << "loadPipelineFromFile(string filename) - Failed to create feature extraction instance from string: " << word << endl;
-			file.close();
 	        return false;
 		}
     }
@@ -1875,7 +2596,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 			file >> word;
 			if( word != "ClassificationModuleDatatype:" ){
                 errorLog << "loadPipelineFromFile(string filename) - Failed to read ClassificationModuleDatatype" << endl;
-				file.close();
 		        return false;
 			}
 			//Load the classifier type
@@ -1885,7 +2605,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 			classifier = Classifier::createInstanceFromString( word );
 			if( classifier == NULL ){
                 errorLog << "loadPipelineFromFile(string filename) - Failed to create classifier instance from string: " << word << endl;
-				file.close();
 		        return false;
 			}
             break;
@@ -1893,7 +2612,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 			file >> word;
 			if( word != "RegressionnModuleDatatype:" ){
                 errorLog << "loadPipelineFromFile(string filename) - Failed to read RegressionnModuleDatatype" << endl;
-				file.close();
 		        return false;
 			}
 			//Load the regressifier type
@@ -1903,7 +2621,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 			regressifier = Regressifier::createInstanceFromString( word );
 			if( regressifier == NULL ){
                 errorLog << "loadPipelineFromFile(string filename) - Failed to create regressifier instance from string: " << word << endl;
-				file.close();
 		        return false;
 			}
             break;
@@ -1915,7 +2632,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	file >> word;
 	if( word != "PostProcessingModuleDatatypes:" ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read PostProcessingModuleDatatypes" << endl;
-		file.close();
 	    return false;
 	}
 	for(UINT i=0; i<numPostprocessingModules; i++){
@@ -1929,7 +2645,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 		file >> word;
         if( !preProcessingModules[i]->loadSettingsFromFile( file ) ){
             errorLog << "Failed to load preprocessing module " << i << " settings from file!" << endl;
-            file.close();
             return false;
         }
     }
@@ -1940,26 +2655,23 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 		file >> word;
 	    if( !featureExtractionModules[i]->loadSettingsFromFile( file ) ){
             errorLog << "Failed to load feature extraction module " << i << " settings from file!" << endl;
-	        file.close();
 	        return false;
 	    }
 	}
 	
-	//Load the classifier or regressifer data
-	switch( pipelineMode ){
+	//Load the classifier or regressifer data, unless the model is stored in the sections of a binary model file
+	switch( loadModel ? pipelineMode : PIPELINE_MODE_NOT_SET ){
         case PIPELINE_MODE_NOT_SET:
             break;
         case CLASSIFICATION_MODE:
                if( !classifier->loadModelFromFile( file ) ){
                    errorLog << "Failed to load classifier model from file!" << endl;
-                   file.close();
                    return false;
                }
             break;
         case REGRESSION_MODE:
                if( !regressifier->loadModelFromFile( file ) ){
                    errorLog << "Failed to load regressifier model from file!" << endl;
-                   file.close();
                    return false;
                }
             break;
@@ -1973,21 +2685,25 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 		file >> word;
         if( !postProcessingModules[i]->loadSettingsFromFile( file ) ){
             errorLog << "Failed to load post processing module " << i << " settings from file!" << endl;
-            file.close();
             return false;
         }
     }
     
-    //Close the file
-    file.close();
+    //The pipeline now has a classifier or regressifier, in the same way as after setClassifier or setRegressifier
+    initialized = getIsClassifierSet() || getIsRegressifierSet();
+    
+    return true;
+}
+
+void GestureRecognitionPipeline::updateInputVectorDimensions(){
     
     //Set the expected input vector size
     inputVectorDimensions = 0;
     
-    if( numPreprocessingModules > 0 ){
+    if( getNumPreProcessingModules() > 0 ){
         inputVectorDimensions = preProcessingModules[0]->getNumInputDimensions();
     }else{
-        if( numFeatureExtractionModules > 0 ){
+        if( getNumFeatureExtractionModules() > 0 ){
             inputVectorDimensions = featureExtractionModules[0]->getNumInputDimensions();
         }else{
             switch( pipelineMode ){
@@ -2004,8 +2720,6 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
             }
         }
     }
-    
-    return true;
 }
     
 bool GestureRecognitionPipeline::preProcessData(VectorDouble inputVector,bool computeFeatures){
@@ -2140,6 +2854,11 @@ UINT GestureRecognitionPipeline::getNumPostProcessingModules() const{
     return (UINT)postProcessingModules.size(); 
 }
     
+UINT GestureRecognitionPipeline::getNumContextModules(const UINT contextLevel) const{ 
+    if( contextLevel >= contextModules.size() ) return 0;
+    return (UINT)contextModules[ contextLevel ].size(); 
+}
+    
 UINT GestureRecognitionPipeline::getPredictionModuleIndexPosition() const{ 
     return predictionModuleIndex; 
 }
@@ -2227,6 +2946,86 @@ double GestureRecognitionPipeline::getTrainingTime() const{
     return trainingTime;
 }
 
+UINT GestureRecognitionPipeline::getNumThreads() const{
+    return numThreads;
+}
+
+bool GestureRecognitionPipeline::getUseFilterFusion() const{
+    return useFilterFusion;
+}
+
+FeatureCache* GestureRecognitionPipeline::getFeatureCache() const{
+    return featureCache;
+}
+
+bool GestureRecognitionPipeline::getProfilingEnabled() const{
+    return profiler.getEnabled();
+}
+
+const PipelineProfiler& GestureRecognitionPipeline::getProfiler() const{
+    return profiler;
+}
+
+string GestureRecognitionPipeline::getProfilingReportAsString() const{
+
+    //The pre processing statistics are recorded against the modules predict ran, which are the fused modules if filter fusion is enabled
+    const vector< PreProcessing* > &activePreProcessingModules = useFilterFusion && fusedPreProcessingModulesValid ? fusedPreProcessingModules : preProcessingModules;
+
+    std::stringstream stream;
+    stream << "Stage\tModuleIndex\tModule\tCalls\tFailures\tMean(us)\tP50(us)\tP99(us)\tMax(us)\n";
+
+    for(UINT stageType=0; stageType<PipelineProfiler::NUM_STAGE_TYPES; stageType++){
+        for(UINT moduleIndex=0; moduleIndex<profiler.getNumModules(stageType); moduleIndex++){
+            const LatencyHistogram &statistics = profiler.getStatistics( stageType, moduleIndex );
+            if( statistics.getNumCalls() == 0 ) continue;
+
+            //Look up the name of the module, the module may have been removed since it was profiled
+            string moduleName = "REMOVED_MODULE";
+            switch( stageType ){
+                case PipelineProfiler::START_OF_PIPELINE_CONTEXT:
+                case PipelineProfiler::AFTER_PREPROCESSING_CONTEXT:
+                case PipelineProfiler::AFTER_FEATURE_EXTRACTION_CONTEXT:
+                case PipelineProfiler::AFTER_CLASSIFIER_CONTEXT:
+                case PipelineProfiler::END_OF_PIPELINE_CONTEXT:
+                    {
+                        const UINT contextLevel = stageType == PipelineProfiler::START_OF_PIPELINE_CONTEXT ? START_OF_PIPELINE :
+                                                  stageType == PipelineProfiler::AFTER_PREPROCESSING_CONTEXT ? AFTER_PREPROCESSING :
+                                                  stageType == PipelineProfiler::AFTER_FEATURE_EXTRACTION_CONTEXT ? AFTER_FEATURE_EXTRACTION :
+                                                  stageType == PipelineProfiler::AFTER_CLASSIFIER_CONTEXT ? AFTER_CLASSIFIER : END_OF_PIPELINE;
+                        if( moduleIndex < contextModules[ contextLevel ].size() ) moduleName = contextModules[ contextLevel ][ moduleIndex ]->getContextType();
+                    }
+                    break;
+                case PipelineProfiler::PREPROCESSING:
+                    if( moduleIndex < activePreProcessingModules.size() ) moduleName = activePreProcessingModules[ moduleIndex ]->getPreProcessingType();
+                    break;
+                case PipelineProfiler::FEATURE_EXTRACTION:
+                    if( moduleIndex < featureExtractionModules.size() ) moduleName = featureExtractionModules[ moduleIndex ]->getFeatureExtractionType();
+                    break;
+                case PipelineProfiler::CLASSIFIER:
+                    if( classifier != NULL ) moduleName = classifier->getClassifierType();
+                    break;
+                case PipelineProfiler::REGRESSIFIER:
+                    if( regressifier != NULL ) moduleName = regressifier->getRegressifierType();
+                    break;
+                case PipelineProfiler::POSTPROCESSING:
+                    if( moduleIndex < postProcessingModules.size() ) moduleName = postProcessingModules[ moduleIndex ]->getPostProcessingType();
+                    break;
+                case PipelineProfiler::PREDICT:
+                    moduleName = "GestureRecognitionPipeline";
+                    break;
+                default:
+                    break;
+            }
+
+            stream << PipelineProfiler::getStageTypeAsString( stageType ) << "\t" << moduleIndex << "\t" << moduleName << "\t";
+            stream << statistics.getNumCalls() << "\t" << statistics.getNumFailures() << "\t" << statistics.getMeanTime() << "\t";
+            stream << statistics.getPercentileTime( 0.5 ) << "\t" << statistics.getPercentileTime( 0.99 ) << "\t" << statistics.getMaximumTime() << "\n";
+        }
+    }
+
+    return stream.str();
+}
+
 double GestureRecognitionPipeline::getTrainingRMSError() const{
     return getIsRegressifierSet() ? regressifier->getRootMeanSquaredTrainingError() : 0;
 }
@@ -2296,6 +3095,9 @@ VectorDouble GestureRecognitionPipeline::getUnProcessedRegressionData() const{
 }
     
 VectorDouble GestureRecognitionPipeline::getPreProcessedData() const{
+    if( useFilterFusion && fusedPreProcessingModulesValid && fusedPreProcessingModules.size() > 0 ){
+        return fusedPreProcessingModules[ fusedPreProcessingModules.size()-1 ]->getProcessedData();
+    }
     if( getIsPreProcessingSet() ){ 
         return preProcessingModules[ preProcessingModules.size()-1 ]->getProcessedData(); 
     }
@@ -2343,7 +3145,17 @@ vector< TestResult > GestureRecognitionPipeline::getCrossValidationResults() con
     return crossValidationResults;
 }
     
-PreProcessing* GestureRecognitionPipeline::getPreProcessingModule(const UINT moduleIndex) const{
+PreProcessing* GestureRecognitionPipeline::getPreProcessingModule(const UINT moduleIndex){
+    if( moduleIndex < preProcessingModules.size() ){
+        //The caller can change the settings of the module through this pointer, so the fused filters check the transfer functions when the pipeline predicts
+        preProcessingModulesEditable = true;
+        return preProcessingModules[ moduleIndex ];
+    }
+    warningLog << "getPreProcessingModule(const UINT moduleIndex) - Failed to get pre processing module!" << endl;
+    return NULL;
+}
+    
+const PreProcessing* GestureRecognitionPipeline::getPreProcessingModule(const UINT moduleIndex) const{
     if( moduleIndex < preProcessingModules.size() ){
         return preProcessingModules[ moduleIndex ];
     }
@@ -2416,8 +3228,9 @@ bool GestureRecognitionPipeline::addPreProcessingModule(const PreProcessing &pre
     
     preProcessingModules.insert(iter, newInstance);
 
-    //The pipeline has been changed, so flag that the pipeline is no longer trained
+    //The pipeline has been changed, so flag that the pipeline is no longer trained and the fused filters need to be rebuilt
     trained = false;
+    fusedPreProcessingModulesValid = false;
     
     return true;
 }
@@ -2527,6 +3340,59 @@ bool GestureRecognitionPipeline::setRegressifier(const Regressifier &regressifie
     return true;
 }
 
+bool GestureRecognitionPipeline::setNumThreads(const UINT numThreads){
+    
+    if( numThreads == 0 ){
+        errorLog << "setNumThreads(const UINT numThreads) - The number of threads must be greater than zero!" << endl;
+        return false;
+    }
+    
+    this->numThreads = numThreads;
+    
+    return true;
+}
+
+bool GestureRecognitionPipeline::setUseFilterFusion(const bool useFilterFusion){
+    
+    this->useFilterFusion = useFilterFusion;
+    
+    //Rebuild the fused filters the next time the pipeline predicts
+    deleteFusedPreProcessingModules();
+    
+    return true;
+}
+
+bool GestureRecognitionPipeline::setFeatureCache(FeatureCache *featureCache){
+    
+    this->featureCache = featureCache;
+    
+    return true;
+}
+
+bool GestureRecognitionPipeline::setProfilingEnabled(const bool profilingEnabled){
+    
+    if( !profiler.setEnabled( profilingEnabled ) ){
+        warningLog << "setProfilingEnabled(const bool profilingEnabled) - Profiling can not be enabled as the library was built with GRT_DISABLE_PROFILING" << endl;
+        return false;
+    }
+    
+    return true;
+}
+
+bool GestureRecognitionPipeline::clearProfilingStatistics(){
+    
+    profiler.clear();
+    
+    return true;
+}
+
+bool GestureRecognitionPipeline::printProfilingReport() const{
+    
+    cout << getProfilingReportAsString();
+    
+    return true;
+}
+
 bool GestureRecognitionPipeline::addPostProcessingModule(const PostProcessing &postProcessingModule,UINT insertIndex){
     
     //Validate the insertIndex is valid
@@ -2634,8 +3500,9 @@ bool GestureRecognitionPipeline::removePreProcessingModule(UINT moduleIndex){
     preProcessingModules[ moduleIndex ] = NULL;
     preProcessingModules.erase( preProcessingModules.begin() + moduleIndex );
 
-    //The pipeline has been changed, so flag that the pipeline is no longer trained
+    //The pipeline has been changed, so flag that the pipeline is no longer trained and the fused filters need to be rebuilt
     trained = false;
+    fusedPreProcessingModulesValid = false;
 
     return true;
 }
@@ -2716,6 +3583,7 @@ bool GestureRecognitionPipeline::clearAll(){
 	removeRegressifier();
 	removeAllPostProcessingModules();
 	removeAllContextModules();
+    profiler.clear();
 	
 	return true;
 }
@@ -2752,6 +3620,147 @@ void GestureRecognitionPipeline::deleteAllPreProcessingModules(){
         preProcessingModules.clear();
         trained = false;
     }
+    fusedPreProcessingModulesValid = false;
+    preProcessingModulesEditable = false;
+}
+
+bool GestureRecognitionPipeline::buildFusedPreProcessingModules(){
+    
+    deleteFusedPreProcessingModules();
+    
+    //Keep the transfer function of each module (empty if the module is not linear), so a change to the settings of a module can be found when the pipeline predicts
+    fusedNumerators.resize( preProcessingModules.size() );
+    fusedDenominators.resize( preProcessingModules.size() );
+    for(UINT i=0; i<preProcessingModules.size(); i++){
+        if( !preProcessingModules[i]->getTransferFunction( fusedNumerators[i], fusedDenominators[i] ) ){
+            fusedNumerators[i].clear();
+            fusedDenominators[i].clear();
+        }
+    }
+    
+    UINT moduleIndex = 0;
+    while( moduleIndex < preProcessingModules.size() ){
+        
+        //Find the run of linear modules that starts at this module
+        UINT runEnd = moduleIndex;
+        while( runEnd < preProcessingModules.size() && fusedDenominators[ runEnd ].size() > 0 ){
+            runEnd++;
+        }
+        
+        //A single module gains nothing from being fused, so keep the original module
+        if( runEnd - moduleIndex < 2 ){
+            fusedPreProcessingModules.push_back( preProcessingModules[ moduleIndex ] );
+            moduleIndex++;
+            continue;
+        }
+        
+        FusedLinearFilter *fusedFilter = new FusedLinearFilter();
+        for(UINT i=moduleIndex; i<runEnd; i++){
+            if( !fusedFilter->fuse( *preProcessingModules[i] ) ){
+                errorLog << "buildFusedPreProcessingModules() - Failed to fuse PreProcessingModule " << i << endl;
+                delete fusedFilter;
+                deleteFusedPreProcessingModules();
+                return false;
+            }
+        }
+        fusedLinearFilters.push_back( fusedFilter );
+        fusedRunStarts.push_back( moduleIndex );
+        fusedPreProcessingModules.push_back( fusedFilter );
+        moduleIndex = runEnd;
+    }
+    
+    fusedPreProcessingModulesValid = true;
+    
+    return true;
+}
+
+void GestureRecognitionPipeline::deleteFusedPreProcessingModules(){
+    for(UINT i=0; i<fusedLinearFilters.size(); i++){
+        delete fusedLinearFilters[i];
+        fusedLinearFilters[i] = NULL;
+    }
+    fusedLinearFilters.clear();
+    fusedRunStarts.clear();
+    fusedPreProcessingModules.clear();
+    fusedNumerators.clear();
+    fusedDenominators.clear();
+    fusedPreProcessingModulesValid = false;
+}
+
+bool GestureRecognitionPipeline::updateFusedPreProcessingModules(){
+    
+    if( !fusedPreProcessingModulesValid || fusedDenominators.size() != preProcessingModules.size() ){
+        return buildFusedPreProcessingModules();
+    }
+    
+    //The settings of the modules can only change through a pointer from the non-const getPreProcessingModule
+    if( !preProcessingModulesEditable ) return true;
+    
+    //Compare the transfer function of each module with the one it had when the fused filters were built
+    bool transferFunctionsChanged = false;
+    for(UINT i=0; i<preProcessingModules.size(); i++){
+        const bool isLinear = preProcessingModules[i]->getTransferFunction( transferNumerator, transferDenominator );
+        
+        //A module that has become linear, or is no longer linear, changes the runs, so all the fused filters are rebuilt
+        if( isLinear != (fusedDenominators[i].size() > 0) ){
+            return buildFusedPreProcessingModules();
+        }
+        if( isLinear && (transferNumerator != fusedNumerators[i] || transferDenominator != fusedDenominators[i]) ){
+            transferFunctionsChanged = true;
+        }
+    }
+    
+    //The fused filters keep their state if none of the modules have changed
+    if( !transferFunctionsChanged ) return true;
+    
+    //Only the runs that contain a changed module are fused again, the other fused filters keep their state
+    for(UINT runIndex=0; runIndex<fusedLinearFilters.size(); runIndex++){
+        const UINT runStart = fusedRunStarts[ runIndex ];
+        const UINT runEnd = runStart + fusedLinearFilters[ runIndex ]->getNumFusedModules();
+        bool runChanged = false;
+        for(UINT i=runStart; i<runEnd; i++){
+            preProcessingModules[i]->getTransferFunction( transferNumerator, transferDenominator );
+            if( transferNumerator != fusedNumerators[i] || transferDenominator != fusedDenominators[i] ){
+                runChanged = true;
+                break;
+            }
+        }
+        if( !runChanged ) continue;
+        
+        FusedLinearFilter *fusedFilter = new FusedLinearFilter();
+        for(UINT i=runStart; i<runEnd; i++){
+            if( !fusedFilter->fuse( *preProcessingModules[i] ) ){
+                errorLog << "updateFusedPreProcessingModules() - Failed to fuse PreProcessingModule " << i << endl;
+                delete fusedFilter;
+                deleteFusedPreProcessingModules();
+                return false;
+            }
+        }
+        for(UINT i=0; i<fusedPreProcessingModules.size(); i++){
+            if( fusedPreProcessingModules[i] == fusedLinearFilters[ runIndex ] ) fusedPreProcessingModules[i] = fusedFilter;
+        }
+        delete fusedLinearFilters[ runIndex ];
+        fusedLinearFilters[ runIndex ] = fusedFilter;
+    }
+    
+    for(UINT i=0; i<preProcessingModules.size(); i++){
+        preProcessingModules[i]->getTransferFunction( fusedNumerators[i], fusedDenominators[i] );
+    }
+    
+    return true;
+}
+
+const vector< PreProcessing* >& GestureRecognitionPipeline::getActivePreProcessingModules(){
+    
+    if( !useFilterFusion ) return preProcessingModules;
+    
+    //Rebuild the fused filters if the settings of any of the modules have been changed since they were fused
+    if( !updateFusedPreProcessingModules() ){
+        warningLog << "getActivePreProcessingModules() - Failed to fuse the PreProcessingModules, the original modules will be used instead" << endl;
+        return preProcessingModules;
+    }
+    
+    return fusedPreProcessingModules;
 }
     
 void GestureRecognitionPipeline::deleteAllFeatureExtractionModules(){
@@ -36,6 +36,7 @@
 #define GRT_GESTURE_RECOGNITION_PIPELINE_HEADER
 
 #include "PreProcessing.h"
+#include "../PreProcessingModules/FusedLinearFilter.h"
 #include "FeatureExtraction.h"
 #include "Classifier.h"
 #include "Regressifier.h"
@@ -44,6 +45,8 @@
 #include "../DataStructures/LabelledContinuousTimeSeriesClassificationData.h"
 #include "../Util/ClassificationResult.h"
 #include "../Util/TestResult.h"
+#include "../Util/PipelineProfiler.h"
+#include "../Util/FeatureCache.h"
 
 namespace GRT{
     
@@ -83,6 +86,17 @@ public:
 	*/
     bool train(const LabelledClassificationData &trainingData);
 
+	/**
+     This is the training interface for training a Classifier with a view of a LabelledClassificationData, such as a training fold or a bootstrapped
+     view of a dataset.  If the pipeline has no PreProcessing or FeatureExtraction modules then the Classification module is trained with a view
+     of the samples, so the samples are not copied.  The dataset the view points at must not be changed while the pipeline is being trained.
+     The function will return true if the classifier was trained successfully, false otherwise.
+
+	@param const LabelledClassificationDataView &trainingData: a view of the labelled classification training data that will be used to train the classifier at the core of the pipeline
+	@return bool returns true if the classifier was trained successfully, false otherwise
+	*/
+    bool train(const LabelledClassificationDataView &trainingData);
+
 	/**
      This is the main training interface for training a Classifier with LabelledClassificationData using K-fold cross validation.  This function will pass 
      the trainingData through any PreProcessing or FeatureExtraction modules that have been added to the GestureRecognitionPipeline, and then calls the 
@@ -203,6 +217,30 @@ public:
      @return bool returns true if the prediction was successful, false otherwise
      */
     bool predict(MatrixDouble inputMatrix);
+    
+    /**
+     This function classifies each row in the inputData, giving the same results as calling predict on each row in turn.
+     Each stage of the pipeline processes the whole block before passing it on to the next stage, which is much faster than
+     calling predict for each row when a large amount of data needs to be classified offline.
+     If any context modules have been added to the pipeline, then each row will be passed through the pipeline one at a time.
+     
+     @param const MatrixDouble &inputData: the data to classify, each row is one sample and the number of columns must match the input vector dimensions of the pipeline
+     @param vector< UINT > &predictedClassLabels: will be filled with the predicted class label of each row
+     @return bool returns true if the prediction was successful, false otherwise
+     */
+    bool predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels);
+    
+    /**
+     This function classifies each row in the inputData, giving the same results as calling predict on each row in turn.
+     See the predictBatch function above for more info.
+     
+     @param const MatrixDouble &inputData: the data to classify, each row is one sample and the number of columns must match the input vector dimensions of the pipeline
+     @param vector< UINT > &predictedClassLabels: will be filled with the predicted class label of each row
+     @param MatrixDouble &classLikelihoods: will be filled with the class likelihoods of each row
+     @param MatrixDouble &classDistances: will be filled with the class distances of each row
+     @return bool returns true if the prediction was successful, false otherwise
+     */
+    bool predictBatch(const MatrixDouble &inputData,vector< UINT > &predictedClassLabels,MatrixDouble &classLikelihoods,MatrixDouble &classDistances);
 
     /**
      This function is now depreciated, you should use the predict function instead.
@@ -210,10 +248,10 @@ public:
      This function used to be the main interface for all regression using the gesture recognition pipeline.  
      You should only call this function if you  have trained the pipeline.  The input vector should be the same size as your training data.
 
-     @param VectorDouble inputVector: the input data that will be passed through the pipeline for regression
+     @param const VectorDouble &inputVector: the input data that will be passed through the pipeline for regression
      @return bool returns true if the regression was successful, false otherwise
 	*/
-    bool map(VectorDouble inputVector);
+    bool map(const VectorDouble &inputVector);
     
     /**
      This function is the main interface for resetting the entire gesture recognition pipeline.  This function will call reset on all the modules in 
@@ -233,11 +271,44 @@ public:
 
     /**
      This function will load an entire pipeline from a file.  This includes all the modules types, settings, and models.
+     The file can be either a text file saved by savePipelineToFile or a binary file saved by savePipelineToBinaryFile, binary
+     files are found automatically and are loaded with loadPipelineFromBinaryFile (using memory mapping).
 
      @param const string &filename: the name of the file you want to load the pipeline from
      @return bool returns true if the pipeline was loaded successful, false otherwise
 	*/
     bool loadPipelineFromFile(const string &filename);
+
+    /**
+     This function will save the entire pipeline to a binary model file (see BinaryModelFile.h).  The module settings are saved in the
+     same way as savePipelineToFile, but the large arrays of the model (such as the nodes of a RandomForests model, or the training
+     samples of KNN and DTW) are saved as raw binary sections, so the file is smaller and much faster to load.
+
+     @param const string &filename: the name of the file you want to save the pipeline to
+     @return bool returns true if the pipeline was saved successful, false otherwise
+	*/
+    bool savePipelineToBinaryFile(const string &filename);
+
+    /**
+     This function will load an entire pipeline from a binary model file saved by savePipelineToBinaryFile.  If useMemoryMapping is true
+     the file is mapped into memory and models that support it (such as RandomForests) use the mapped data directly rather than copying it,
+     so the mapping is shared by every process that loads the same file and stays open for as long as the model uses it.
+
+     @param const string &filename: the name of the file you want to load the pipeline from
+     @param const bool useMemoryMapping: if true the file will be mapped into memory, if false it will be read into memory. Default value = true
+     @return bool returns true if the pipeline was loaded successful, false otherwise
+	*/
+    bool loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMapping = true);
+
+    /**
+     Converts a pipeline file between the text and binary formats.  If the input file is a text file it is saved as a binary file, if it is
+     a binary file it is saved as a text file.
+
+     @param const string &inputFilename: the name of the pipeline file you want to convert
+     @param const string &outputFilename: the name of the file the converted pipeline will be saved to
+     @return bool returns true if the pipeline was converted successful, false otherwise
+	*/
+    static bool convertPipelineFile(const string &inputFilename,const string &outputFilename);
     
     /**
      This function will pass the input vector through any preprocessing or feature extraction modules added to the pipeline.  This function
@@ -383,6 +454,14 @@ public:
 	*/
     UINT getNumPostProcessingModules() const;
 
+    /**
+	 This function returns the number of context modules that have been added to the pipeline at the specific contextLevel.
+	
+	@param const UINT contextLevel: the context level, this should be one of the ContextLevels enums
+	@return UINT representing the number of context modules at the contextLevel, or 0 if the contextLevel is invalid.
+	*/
+    UINT getNumContextModules(const UINT contextLevel) const;
+
     /**
 	 This function returns the current position of the prediction module index. The prediction module index indicates how far along the pipeline a data sample gets before the pipeline 
 	 exits during a prediction.  For example, if you have two preprocessing modules, one feature extraction module, a classifier, and one post processing module in your pipeline and the
@@ -502,6 +581,49 @@ public:
 	*/
     double getTrainingTime() const;
 
+    /**
+     This function returns the number of threads that will be used to run the folds of the k-fold cross validation training functions.
+
+    @return UINT representing the number of cross validation threads, 1 means the folds are run serially on the calling thread
+    */
+    UINT getNumThreads() const;
+    
+    /**
+     This function returns true if runs of linear pre processing modules are fused into a single filter when the pipeline predicts.
+
+    @return bool representing if filter fusion is enabled
+    */
+    bool getUseFilterFusion() const;
+
+    /**
+     This function returns the feature cache used by the training functions, see setFeatureCache.
+
+    @return a pointer to the feature cache, or NULL if no feature cache has been set
+    */
+    FeatureCache* getFeatureCache() const;
+
+    /**
+     This function returns true if the pipeline is recording the latency of each module when it predicts.
+
+    @return bool representing if profiling is enabled
+    */
+    bool getProfilingEnabled() const;
+
+    /**
+     This function returns the profiler that holds the latency histogram, call count and failure count of each module, see PipelineProfiler.
+
+    @return a const reference to the pipeline profiler
+    */
+    const PipelineProfiler& getProfiler() const;
+
+    /**
+     This function returns a table with one row for each module that has been profiled, in the order the modules run, giving the number of calls
+     and failures and the mean, median (p50), 99th percentile (p99) and maximum latency of the module in microseconds.
+
+    @return string containing the profiling report
+    */
+    string getProfilingReportAsString() const;
+
     /**
      This function returns the root mean squared error value from the most recent training.  This value is only relevant when the pipeline is in regression mode.
 
@@ -647,12 +769,21 @@ public:
     vector< TestResult > getCrossValidationResults() const;
 
     /**
-     Gets a pointer to the preprocessing module at the specific moduleIndex.
+     Gets a pointer to the preprocessing module at the specific moduleIndex.  The settings of the module can be changed through this pointer, if
+     filter fusion is enabled the change is picked up the next time the pipeline predicts.
      
      @param const UINT moduleIndex: the index of the pre processing module you want
      @return returns a pointer to the preprocessing module at the specific moduleIndex, or NULL if the moduleIndex is invalid
      */
-    PreProcessing* getPreProcessingModule(const UINT moduleIndex) const;
+    PreProcessing* getPreProcessingModule(const UINT moduleIndex);
+    
+    /**
+     Gets a const pointer to the preprocessing module at the specific moduleIndex.
+     
+     @param const UINT moduleIndex: the index of the pre processing module you want
+     @return returns a const pointer to the preprocessing module at the specific moduleIndex, or NULL if the moduleIndex is invalid
+     */
+    const PreProcessing* getPreProcessingModule(const UINT moduleIndex) const;
 
     /**
      Gets a pointer to the feature extraction module at the specific moduleIndex.
@@ -695,17 +826,32 @@ public:
     
     /**
      Gets a pointer to the preprocessing module at the specific moduleIndex.  You should make sure that the type of the preprocessing module matches the template type. 
+     The settings of the module can be changed through this pointer, if filter fusion is enabled the change is picked up the next time the pipeline predicts.
      
      @param const UINT moduleIndex: the index of the pre processing module you want
      @return returns a pointer to the preprocessing module at the specific moduleIndex, or NULL if the moduleIndex is invalid
      */
-    template <class T> T* getPreProcessingModule(const UINT moduleIndex) const{
+    template <class T> T* getPreProcessingModule(const UINT moduleIndex){
         if( moduleIndex < preProcessingModules.size() ){
+            preProcessingModulesEditable = true;
             return (T*)preProcessingModules[ moduleIndex ];
         }
         return NULL;
     }
     
+    /**
+     Gets a const pointer to the preprocessing module at the specific moduleIndex.  You should make sure that the type of the preprocessing module matches the template type. 
+     
+     @param const UINT moduleIndex: the index of the pre processing module you want
+     @return returns a const pointer to the preprocessing module at the specific moduleIndex, or NULL if the moduleIndex is invalid
+     */
+    template <class T> const T* getPreProcessingModule(const UINT moduleIndex) const{
+        if( moduleIndex < preProcessingModules.size() ){
+            return (const T*)preProcessingModules[ moduleIndex ];
+        }
+        return NULL;
+    }
+    
     /**
      Gets a pointer to the feature extraction module at the specific moduleIndex.  You should make sure that the type of the feature extraction module matches the template type. 
      
@@ -853,6 +999,80 @@ public:
      */
     bool setRegressifier(const Regressifier &regressifier);
 
+    /**
+     Sets the number of threads that will be used to run the folds of the k-fold cross validation training functions.  If this is greater than 1, then
+     each worker thread trains and tests its folds on its own copy of the pipeline, while sharing the training data read-only.  The per-fold results are
+     merged in fold order, so the cross validation accuracy and results match the serial path exactly, and the pipeline is left trained on the last fold.
+     Note that modules which draw from the global rand() sequence during training will not see the same random numbers as they would in the serial path.
+     The default value is 1, which runs the folds serially on the calling thread.
+     
+     @param const UINT numThreads: the number of cross validation threads, this must be greater than 0
+     @return returns true if the number of threads was set successfully, false otherwise
+     */
+    bool setNumThreads(const UINT numThreads);
+    
+    /**
+     Sets if the pipeline should fuse runs of two or more linear time invariant pre processing modules (such as the LowPassFilter, HighPassFilter,
+     MovingAverageFilter, DoubleMovingAverageFilter and FIRFilter) into a single FusedLinearFilter when it predicts, so each sample is filtered in
+     one pass rather than one pass per module.  The output matches the unfused modules to within rounding, except that the fused filters start
+     from zero state, so the startup transient of the moving average filters (which average over the samples seen so far) differs for the first
+     filterSize samples.  Training still runs the original modules.  The fused filters are built the next time the pipeline predicts, and are
+     rebuilt (from zero state) when pre processing modules are added or removed.  Once a module has been returned by the non-const
+     getPreProcessingModule, each prediction compares the transfer function of each module with the one it was fused with, so a change to the
+     settings of a module is picked up by the next prediction and only the fused filter that contains the changed module restarts from zero state.
+     The default value is false.
+     
+     @param const bool useFilterFusion: sets if runs of linear pre processing modules should be fused
+     @return returns true if the parameter was set successfully, false otherwise
+     */
+    bool setUseFilterFusion(const bool useFilterFusion);
+
+    /**
+     Sets the feature cache used by the training functions.  When a feature cache is set and the pipeline has any pre processing or feature
+     extraction modules, the train functions look up the output of these modules in the cache, using a key built from the type and settings
+     of each module and the training data, and only run the modules if the key is not found.  So training the pipeline again on the same data,
+     with the same pre processing and feature extraction settings, only trains the classifier or regressifier.  LabelledClassificationData and
+     LabelledRegressionData are cached as a whole, as the modules process the samples as one stream, and the modules are left in the state
+     stored with the cache entry.  LabelledTimeSeriesClassificationData is cached per sample, as the modules are reset for each sample, so
+     the cached samples are also used by any other training data that holds them (such as the folds of a cross validation).  When a feature
+     cache is set, the k-fold cross validation training functions split the data into folds using a seed built from the training data, so each
+     call with the same data uses the same folds and can use the cached data of each fold.
+
+     The cache is not owned by the pipeline, it must not be deleted while the pipeline uses it, and it is shared with any copies of the pipeline.
+     The cache only knows the settings a module writes with saveSettingsToFile, if a module is changed in any other way then the cache should be
+     cleared.  The default value is NULL, which disables the cache.
+
+     @param FeatureCache *featureCache: a pointer to the feature cache, or NULL to disable the cache
+     @return returns true if the feature cache was set successfully, false otherwise
+     */
+    bool setFeatureCache(FeatureCache *featureCache);
+
+    /**
+     Sets if the pipeline should record the latency of each context, pre processing, feature extraction, classifier, regressifier and post processing
+     module (and of the whole predict call) each time it predicts.  The statistics can be read with getProfiler or printed with printProfilingReport.
+     Only the predict functions are profiled, and predict(MatrixDouble) only records the whole call.  The statistics are not cleared when profiling
+     is turned on or off, call clearProfilingStatistics to clear them (for example after the modules of the pipeline have been changed).  If the
+     library was built with GRT_DISABLE_PROFILING the profiling code is compiled out and profiling can not be enabled.  The default value is false.
+     
+     @param const bool profilingEnabled: sets if the latency of each module should be recorded
+     @return returns true if the parameter was set successfully, false otherwise
+     */
+    bool setProfilingEnabled(const bool profilingEnabled);
+
+    /**
+     Clears the latency statistics of every module.
+     
+     @return returns true if the statistics were cleared successfully, false otherwise
+     */
+    bool clearProfilingStatistics();
+
+    /**
+     Prints the profiling report (see getProfilingReportAsString) to std::cout.
+     
+     @return returns true if the report was printed successfully, false otherwise
+     */
+    bool printProfilingReport() const;
+
     /**
      Adds a new post processing module to the pipeline.  The user can specify the position at which the new module should be inserted into the list of post processing modules.  
      The default position is to insert the new module at the end of the list.
@@ -983,9 +1203,24 @@ public:
     bool clearTestResults();
 
 protected:
-    bool predict_classifier(VectorDouble inputVector);
-    bool predict_regressifier(VectorDouble inputVector);
+    bool savePipelineToFile(fstream &file,const bool saveModel);
+    bool loadPipelineFromFile(fstream &file,const bool loadModel);
+    void updateInputVectorDimensions();
+    bool predict_classifier(const VectorDouble &inputVector);
+    bool predict_regressifier(const VectorDouble &inputVector);
+    bool predictBatch_classifier(const MatrixDouble &inputData,vector< UINT > &unProcessedClassLabels,vector< UINT > &predictedClassLabels,MatrixDouble &classLikelihoods,MatrixDouble &classDistances);
+    template< class T > bool trainKFoldsInParallel(const T &trainingData,const UINT kFoldValue,vector< TestResult > &foldResults);
+    bool getFrontEndHash(const string &dataType,unsigned long long &frontEndHash) const;
+    static unsigned long long hashTrainingData(const LabelledClassificationData &trainingData,const unsigned long long hash);
+    static unsigned long long hashTrainingData(const LabelledClassificationDataView &trainingData,const unsigned long long hash);
+    static unsigned long long hashTrainingData(const LabelledTimeSeriesClassificationData &trainingData,const unsigned long long hash);
+    static unsigned long long hashTrainingData(const LabelledRegressionData &trainingData,const unsigned long long hash);
+    static unsigned long long hashTimeSeries(const MatrixDouble &timeSeries,const unsigned long long hash);
     void deleteAllPreProcessingModules();
+    bool buildFusedPreProcessingModules();
+    void deleteFusedPreProcessingModules();
+    bool updateFusedPreProcessingModules();
+    const vector< PreProcessing* >& getActivePreProcessingModules();
     void deleteAllFeatureExtractionModules();
     void deleteClassifier();
     void deleteRegressifier();
@@ -1003,6 +1238,7 @@ protected:
     UINT predictionModuleIndex;
     UINT numTrainingSamples;
     UINT numTestSamples;
+    UINT numThreads;
     double testAccuracy;
     double testRMSError;
     double testSquaredError;
@@ -1012,6 +1248,8 @@ protected:
     VectorDouble testPrecision;
     VectorDouble testRecall;
     VectorDouble regressionData;
+    VectorDouble predictionInputBuffer;             ///< Reusable buffer for the classifier/regressifier input, so predict does not allocate per sample
+    VectorDouble predictionLabelBuffer;             ///< Reusable buffer for passing the predicted class label to the context and post processing modules
     double testRejectionPrecision;
     double testRejectionRecall;
     MatrixDouble testConfusionMatrix;
@@ -1019,11 +1257,23 @@ protected:
     vector< TestInstanceResult > testResults;
     
     vector< PreProcessing* > preProcessingModules;
+    bool useFilterFusion;
+    bool fusedPreProcessingModulesValid;
+    bool preProcessingModulesEditable;                      ///< True once a pre processing module has been returned by the non-const getPreProcessingModule
+    vector< PreProcessing* > fusedPreProcessingModules;     ///< The pre processing modules predict runs when filter fusion is enabled, runs of linear modules are replaced by a FusedLinearFilter
+    vector< FusedLinearFilter* > fusedLinearFilters;        ///< The filters owned by fusedPreProcessingModules, the other entries point to preProcessingModules
+    vector< UINT > fusedRunStarts;                          ///< The index of the first pre processing module fused into each of the fusedLinearFilters
+    vector< VectorDouble > fusedNumerators;                 ///< The transfer function of each pre processing module when the fused filters were built, empty if the module is not linear
+    vector< VectorDouble > fusedDenominators;
+    VectorDouble transferNumerator;                         ///< Reusable buffers for comparing the transfer functions of the pre processing modules when the pipeline predicts
+    VectorDouble transferDenominator;
     vector< FeatureExtraction* > featureExtractionModules;
     Classifier *classifier;
     Regressifier *regressifier;
     vector< PostProcessing* > postProcessingModules;
     vector< vector< Context* > > contextModules;
+    PipelineProfiler profiler;
+    FeatureCache *featureCache;                     ///< Not owned by the pipeline, NULL if the training functions should not use a feature cache
     
     enum PipelineModes{PIPELINE_MODE_NOT_SET=0,CLASSIFICATION_MODE,REGRESSION_MODE};
     
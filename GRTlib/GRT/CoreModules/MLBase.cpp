@@ -25,6 +25,7 @@ namespace GRT{
 MLBase::MLBase(void){
     trained = false;
     useScaling = false;
+    useFloatPrediction = false;
     baseType = BASE_TYPE_NOT_SET;
     numInputDimensions = 0;
     numOutputDimensions = 0;
@@ -48,6 +49,7 @@ bool MLBase::copyMLBaseVariables(const MLBase *mlBase){
 
     this->trained = mlBase->trained;
     this->useScaling = mlBase->useScaling;
+    this->useFloatPrediction = mlBase->useFloatPrediction;
     this->baseType = mlBase->baseType;
     this->numInputDimensions = mlBase->numInputDimensions;
     this->numOutputDimensions = mlBase->numOutputDimensions;
@@ -63,6 +65,8 @@ bool MLBase::train(LabelledClassificationData trainingData){ return trainInplace
 
 bool MLBase::trainInplace(LabelledClassificationData &trainingData){ return false; }
 
+bool MLBase::train(const LabelledClassificationDataView &trainingData){ return train( trainingData.getLabelledClassificationData() ); }
+
 bool MLBase::train(LabelledTimeSeriesClassificationData trainingData){ return trainInPlace( trainingData ); }
 
 bool MLBase::trainInPlace(LabelledTimeSeriesClassificationData &trainingData){ return false; }
@@ -77,8 +81,14 @@ bool MLBase::trainInplace(MatrixDouble &data){ return false; }
 
 bool MLBase::predict(VectorDouble inputVector){ return false; }
 
+bool MLBase::predictInplace(VectorDouble &inputVector){ return predict( inputVector ); }
+
 bool MLBase::predict(MatrixDouble inputMatrix){ return false; }
 
+bool MLBase::predictFloat(VectorFloat inputVector){ return predictFloatInplace( inputVector ); }
+
+bool MLBase::predictFloatInplace(VectorFloat &inputVector){ return false; }
+
 bool MLBase::MLBase::map(VectorDouble inputVector){ return false; }
 
 bool MLBase::mapInplace(VectorDouble &inputVector){ return false; }
@@ -104,6 +114,31 @@ bool MLBase::loadModelFromFile(string filename){ return false; }
 
 bool MLBase::loadModelFromFile(fstream &file){ return false; }
 
+bool MLBase::saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) const{
+    
+    if( !file.beginTextSection( sectionName ) ){
+        errorLog << "saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) - Failed to start section: " << sectionName << endl;
+        return false;
+    }
+    
+    if( !saveModelToFile( file.getTextStream() ) ){
+        file.endTextSection();
+        return false;
+    }
+    
+    return file.endTextSection();
+}
+
+bool MLBase::loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName){
+    
+    if( !file.beginTextSection( sectionName ) ){
+        errorLog << "loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName) - Failed to find section: " << sectionName << endl;
+        return false;
+    }
+    
+    return loadModelFromFile( file.getTextStream() );
+}
+
 UINT MLBase::getBaseType() const{ return baseType; }
 
 UINT MLBase::getNumInputFeatures() const{ return getNumInputDimensions(); }
@@ -131,6 +166,48 @@ bool MLBase::getIsBaseTypeRegressifier() const{ return baseType==REGRESSIFIER; }
 
 bool MLBase::enableScaling(bool useScaling){ this->useScaling = useScaling; return true; }
 
+bool MLBase::setUseFloatPrediction(const bool useFloatPrediction){
+    
+    if( !useFloatPrediction ){
+        this->useFloatPrediction = false;
+        return true;
+    }
+    
+    if( !getSupportsFloatPrediction() ){
+        warningLog << "setUseFloatPrediction(const bool useFloatPrediction) - This algorithm does not support float prediction!" << endl;
+        return false;
+    }
+    
+    this->useFloatPrediction = true;
+    return updateFloatModel();
+}
+
+bool MLBase::getUseFloatPrediction() const{ return useFloatPrediction; }
+
+bool MLBase::updateFloatModel(){
+    
+    if( !useFloatPrediction || !trained ) return true;
+    
+    if( !buildFloatModel() ){
+        warningLog << "updateFloatModel() - Failed to build the float model, float prediction has been disabled!" << endl;
+        useFloatPrediction = false;
+        return false;
+    }
+    
+    return true;
+}
+
+bool MLBase::predictAsFloat(const VectorDouble &inputVector){
+    
+    const size_t N = inputVector.size();
+    floatInputVector.resize( N );
+    for(size_t j=0; j<N; j++){
+        floatInputVector[j] = float( inputVector[j] );
+    }
+    
+    return predictFloatInplace( floatInputVector );
+}
+
 bool MLBase::registerTrainingResultsObserver( Observer< TrainingResult > &observer ){
     return trainingResultsObserverManager.registerObserver( observer );
 }
@@ -167,10 +244,10 @@ vector< TrainingResult > MLBase::getTrainingResults() const{
     return trainingResults;
 }
 
-bool MLBase::saveBaseSettingsToFile(fstream &file) const{
+bool MLBase::saveBaseSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveBaseSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveBaseSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -32,7 +32,9 @@
 #define GRT_MLBASE_HEADER
 
 #include "GRTBase.h"
+#include "../Util/BinaryModelFile.h"
 #include "../DataStructures/LabelledClassificationData.h"
+#include "../DataStructures/LabelledClassificationDataView.h"
 #include "../DataStructures/LabelledTimeSeriesClassificationData.h"
 
 namespace GRT{
@@ -101,6 +103,16 @@ public:
      @return returns true if the classifier was successfully trained, false otherwise
      */
     virtual bool trainInplace(LabelledClassificationData &trainingData);
+
+    /**
+     This is the training interface for a LabelledClassificationDataView, such as a fold or a bootstrapped view of a dataset.
+     By default it will copy the samples of the view into a new LabelledClassificationData and call the train function, unless it is overwritten
+     by a derived class that can read the samples of the view directly.
+
+     @param const LabelledClassificationDataView &trainingData: a view of the training data that will be used to train the ML model
+     @return returns true if the classifier was successfully trained, false otherwise
+     */
+    virtual bool train(const LabelledClassificationDataView &trainingData);
     
     /**
      This is the main training interface for LabelledTimeSeriesClassificationData.
@@ -160,6 +172,16 @@ public:
      */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the main prediction interface by reference for all the GRT machine learning algorithms. The derived class is free to modify
+     the input vector (for example, to scale it), so the caller should not rely on its contents after this call. This avoids copying the
+     input vector for each prediction. By default it will call the predict function, unless it is overwritten by the derived class.
+     
+     @param VectorDouble &inputVector: a reference to the new input vector for prediction
+     @return returns true if the prediction was completed succesfully, false otherwise
+     */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
     /**
      This is the prediction interface for time series data. This should be overwritten by the derived class.
      
@@ -167,6 +189,24 @@ public:
      @return returns true if the prediction was completed succesfully, false otherwise (the base class always returns false)
      */
     virtual bool predict(MatrixDouble inputMatrix);
+
+    /**
+     This is the single precision prediction interface, it runs the float copy of the trained model that is built when float prediction
+     is enabled (see setUseFloatPrediction).  The results are stored in the same place as the results of the double predict function.
+
+     @param VectorFloat inputVector: the new input vector for prediction
+     @return returns true if the prediction was completed succesfully, false otherwise
+     */
+    virtual bool predictFloat(VectorFloat inputVector);
+
+    /**
+     This is the single precision prediction interface by reference, the derived class is free to modify the input vector.  This should be
+     overwritten by any derived class that supports float prediction.
+
+     @param VectorFloat &inputVector: a reference to the new input vector for prediction
+     @return returns true if the prediction was completed succesfully, false otherwise (the base class always returns false)
+     */
+    virtual bool predictFloatInplace(VectorFloat &inputVector);
     
     /**
      This is the main mapping interface for all the GRT machine learning algorithms. This should be overwritten by the derived class.
@@ -245,6 +285,26 @@ public:
      */
     virtual bool loadModelFromFile(fstream &file);
     
+    /**
+     This saves the trained model to a binary model file.  The default implementation writes the text model (from saveModelToFile) into
+     one text section, a derived class can override this to write its large arrays as binary sections so they can be loaded without
+     being parsed.  Any extra sections should be named sectionName followed by a '/' and the name of the array.
+     
+     @param BinaryModelWriter &file: a reference to the binary model file the model will be saved to
+     @param const string &sectionName: the name of the section the model should be saved to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToBinaryFile(BinaryModelWriter &file,const string &sectionName) const;
+    
+    /**
+     This loads a trained model from a binary model file, the model must have been saved with saveModelToBinaryFile.
+     
+     @param BinaryModelReader &file: a reference to the binary model file the model will be loaded from
+     @param const string &sectionName: the name of the section the model was saved to
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromBinaryFile(BinaryModelReader &file,const string &sectionName);
+    
     /**
      Scales the input value x (which should be in the range [minSource maxSource]) to a value in the new target range of [minTarget maxTarget].
      
@@ -256,7 +316,7 @@ public:
      @param const bool constrain: sets if the scaled value should be constrained to the target range
      @return returns a new value that has been scaled based on the input parameters
      */
-    double inline scale(const double &x,const double &minSource,const double &maxSource,const double &minTarget,const double &maxTarget,const bool constrain=false){
+    double inline scale(const double &x,const double &minSource,const double &maxSource,const double &minTarget,const double &maxTarget,const bool constrain=false) const{
         if( constrain ){
             if( x <= minSource ) return minTarget;
             if( x >= maxSource ) return maxTarget;
@@ -342,6 +402,31 @@ public:
      @return returns true the scaling parameter was updated, false otherwise
      */
     bool enableScaling(bool useScaling);
+
+    /**
+     Sets if the single precision prediction path should be used.  When this is enabled, a float copy of the trained model is built (after
+     training or loading, or straight away if the model is already trained) and every prediction, including the double predict functions,
+     runs on the float copy.  The model is still trained and saved in double precision, so a model trained and saved by a double engine
+     can be loaded and then run in float.  Not every algorithm supports float prediction, see getSupportsFloatPrediction.
+
+     @param const bool useFloatPrediction: sets if the float prediction path should be used
+     @return returns true if the parameter was updated, false if float prediction is not supported or the float model could not be built
+     */
+    bool setUseFloatPrediction(const bool useFloatPrediction);
+
+    /**
+     Gets if the single precision prediction path is being used.
+
+     @return returns true if float prediction is enabled, false otherwise
+     */
+    bool getUseFloatPrediction() const;
+
+    /**
+     Gets if the derived class supports the single precision prediction path.
+
+     @return returns true if float prediction is supported, false otherwise
+     */
+    virtual bool getSupportsFloatPrediction() const{ return false; }
     
     /**
      Registers the observer with the training result observer manager. The observer will then be notified when any new training result is computed.
@@ -413,7 +498,7 @@ protected:
      
      @return returns true if the base settings were saved, false otherwise
      */
-    bool saveBaseSettingsToFile(fstream &file) const;
+    bool saveBaseSettingsToFile(ostream &file) const;
     
     /**
      Loads the core base settings from a file.
@@ -421,9 +506,35 @@ protected:
      @return returns true if the base settings were loaded, false otherwise
      */
     bool loadBaseSettingsFromFile(fstream &file);
+
+    /**
+     Builds the float copy of the trained model that is used by predictFloatInplace.  This should be overwritten by any derived class that
+     supports float prediction.
+
+     @return returns true if the float model was built, false otherwise (the base class always returns false)
+     */
+    virtual bool buildFloatModel(){ return false; }
+
+    /**
+     Builds the float copy of the model if float prediction is enabled and the model is trained.  The derived classes call this at the end of
+     training and loading.  If the float model can not be built then float prediction is disabled and the double model is used.
+
+     @return returns true if the float model is ready or float prediction is not enabled, false otherwise
+     */
+    bool updateFloatModel();
+
+    /**
+     Converts the input vector to float and runs predictFloatInplace, this lets the double predict functions run on the float model.
+
+     @param const VectorDouble &inputVector: the new input vector for prediction
+     @return returns true if the prediction was completed succesfully, false otherwise
+     */
+    bool predictAsFloat(const VectorDouble &inputVector);
     
     bool trained;
     bool useScaling;
+    bool useFloatPrediction;
+    VectorFloat floatInputVector;
     UINT baseType;
     UINT numInputDimensions;
     UINT numOutputDimensions;
@@ -0,0 +1,556 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PipelineSession.h"
+
+namespace GRT{
+
+//Creates a deep copy of a module, returns NULL if the module could not be copied
+template< class T > static T* copyModule(const T *module){
+    if( module == NULL ) return NULL;
+    T *newInstance = module->createNewInstance();
+    if( newInstance == NULL ) return NULL;
+    if( !newInstance->deepCopyFrom( module ) ){
+        delete newInstance;
+        return NULL;
+    }
+    return newInstance;
+}
+
+template< class T > static void deleteModules(vector< T* > &modules){
+    for(UINT i=0; i<modules.size(); i++){
+        delete modules[i];
+        modules[i] = NULL;
+    }
+    modules.clear();
+}
+
+PipelineSession::PipelineSession(){
+    pipeline = NULL;
+    sharedClassifier = NULL;
+    initialized = false;
+    classifier = NULL;
+    regressifier = NULL;
+    predictedClassLabel = 0;
+    contextModules.resize( GestureRecognitionPipeline::NUM_CONTEXT_LEVELS );
+
+    debugLog.setProceedingText("[DEBUG PipelineSession]");
+    errorLog.setProceedingText("[ERROR PipelineSession]");
+    warningLog.setProceedingText("[WARNING PipelineSession]");
+}
+
+PipelineSession::PipelineSession(const GestureRecognitionPipeline &pipeline){
+    this->pipeline = NULL;
+    sharedClassifier = NULL;
+    initialized = false;
+    classifier = NULL;
+    regressifier = NULL;
+    predictedClassLabel = 0;
+    contextModules.resize( GestureRecognitionPipeline::NUM_CONTEXT_LEVELS );
+
+    debugLog.setProceedingText("[DEBUG PipelineSession]");
+    errorLog.setProceedingText("[ERROR PipelineSession]");
+    warningLog.setProceedingText("[WARNING PipelineSession]");
+
+    init( pipeline );
+}
+
+PipelineSession::PipelineSession(const PipelineSession &rhs){
+    pipeline = NULL;
+    sharedClassifier = NULL;
+    initialized = false;
+    classifier = NULL;
+    regressifier = NULL;
+    predictedClassLabel = 0;
+    contextModules.resize( GestureRecognitionPipeline::NUM_CONTEXT_LEVELS );
+
+    debugLog.setProceedingText("[DEBUG PipelineSession]");
+    errorLog.setProceedingText("[ERROR PipelineSession]");
+    warningLog.setProceedingText("[WARNING PipelineSession]");
+
+    *this = rhs;
+}
+
+PipelineSession::~PipelineSession(){
+    clear();
+}
+
+PipelineSession& PipelineSession::operator=(const PipelineSession &rhs){
+
+    if( this != &rhs ){
+        clear();
+
+        if( rhs.initialized && copyModulesFrom( rhs ) ){
+            this->pipeline = rhs.pipeline;
+            this->sharedClassifier = rhs.sharedClassifier;
+            this->prediction = rhs.prediction;
+            this->predictedClassLabel = rhs.predictedClassLabel;
+            this->regressionData = rhs.regressionData;
+            this->initialized = true;
+        }
+    }
+
+    return *this;
+}
+
+bool PipelineSession::init(const GestureRecognitionPipeline &pipeline){
+
+    clear();
+
+    if( !pipeline.getTrained() ){
+        errorLog << "init(const GestureRecognitionPipeline &pipeline) - The pipeline has not been trained!" << endl;
+        return false;
+    }
+
+    //Copy the modules that keep state, so each session has its own history
+    for(UINT i=0; i<pipeline.getNumPreProcessingModules(); i++){
+        PreProcessing *module = copyModule( pipeline.getPreProcessingModule(i) );
+        if( module == NULL ){
+            errorLog << "init(const GestureRecognitionPipeline &pipeline) - Failed to copy PreProcessingModule " << i << endl;
+            clear();
+            return false;
+        }
+        preProcessingModules.push_back( module );
+    }
+
+    for(UINT i=0; i<pipeline.getNumFeatureExtractionModules(); i++){
+        FeatureExtraction *module = copyModule( pipeline.getFeatureExtractionModule(i) );
+        if( module == NULL ){
+            errorLog << "init(const GestureRecognitionPipeline &pipeline) - Failed to copy FeatureExtractionModule " << i << endl;
+            clear();
+            return false;
+        }
+        featureExtractionModules.push_back( module );
+    }
+
+    for(UINT i=0; i<pipeline.getNumPostProcessingModules(); i++){
+        PostProcessing *module = copyModule( pipeline.getPostProcessingModule(i) );
+        if( module == NULL ){
+            errorLog << "init(const GestureRecognitionPipeline &pipeline) - Failed to copy PostProcessingModule " << i << endl;
+            clear();
+            return false;
+        }
+        postProcessingModules.push_back( module );
+    }
+
+    for(UINT k=0; k<GestureRecognitionPipeline::NUM_CONTEXT_LEVELS; k++){
+        for(UINT i=0; i<pipeline.getNumContextModules(k); i++){
+            Context *module = copyModule( pipeline.getContextModule(k,i) );
+            if( module == NULL ){
+                errorLog << "init(const GestureRecognitionPipeline &pipeline) - Failed to copy ContextModule " << i << " at context level " << k << endl;
+                clear();
+                return false;
+            }
+            contextModules[k].push_back( module );
+        }
+    }
+
+    //The classifier is shared if it can predict without writing to itself, otherwise the session needs its own copy
+    if( pipeline.getIsClassifierSet() ){
+        const Classifier *pipelineClassifier = pipeline.getClassifier();
+        if( pipelineClassifier->getSupportsSharedPrediction() && !pipelineClassifier->getUseFloatPrediction() ){
+            sharedClassifier = pipelineClassifier;
+        }else{
+            classifier = copyModule( pipelineClassifier );
+            if( classifier == NULL ){
+                errorLog << "init(const GestureRecognitionPipeline &pipeline) - Failed to copy the classifier!" << endl;
+                clear();
+                return false;
+            }
+        }
+    }
+
+    if( pipeline.getIsRegressifierSet() ){
+        regressifier = copyModule( pipeline.getRegressifier() );
+        if( regressifier == NULL ){
+            errorLog << "init(const GestureRecognitionPipeline &pipeline) - Failed to copy the regressifier!" << endl;
+            clear();
+            return false;
+        }
+    }
+
+    this->pipeline = &pipeline;
+    initialized = true;
+
+    return true;
+}
+
+bool PipelineSession::predict(const VectorDouble &inputVector){
+
+    if( !initialized ){
+        errorLog << "predict(const VectorDouble &inputVector) - The session has not been initialized!" << endl;
+        return false;
+    }
+
+    if( inputVector.size() != pipeline->getInputVectorDimensionsSize() ){
+        errorLog << "predict(const VectorDouble &inputVector) - The dimensionality of the input vector (" << int(inputVector.size()) << ") does not match that of the input vector dimensions of the pipeline (" << pipeline->getInputVectorDimensionsSize() << ")" << endl;
+        return false;
+    }
+
+    if( sharedClassifier != NULL || classifier != NULL ) return predict_classifier( inputVector );
+    if( regressifier != NULL ) return predict_regressifier( inputVector );
+
+    errorLog << "predict(const VectorDouble &inputVector) - Neither a classifier or regressifer is not set" << endl;
+    return false;
+}
+
+bool PipelineSession::reset(){
+
+    for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+        if( !preProcessingModules[ moduleIndex ]->reset() ){
+            errorLog << "Failed To Reset PreProcessingModule " << moduleIndex << endl;
+            return false;
+        }
+    }
+
+    for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+        if( !featureExtractionModules[ moduleIndex ]->reset() ){
+            errorLog << "Failed To Reset FeatureExtractionModule " << moduleIndex << endl;
+            return false;
+        }
+    }
+
+    if( classifier != NULL && !classifier->reset() ){
+        errorLog << "Failed To Reset Classifier! " << classifier->getLastErrorMessage() << endl;
+        return false;
+    }
+
+    if( regressifier != NULL && !regressifier->reset() ){
+        errorLog << "Failed To Reset Regressifier! " << regressifier->getLastErrorMessage() << endl;
+        return false;
+    }
+
+    for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+        if( !postProcessingModules[ moduleIndex ]->reset() ){
+            errorLog << "Failed To Reset PostProcessingModule " << moduleIndex << endl;
+            return false;
+        }
+    }
+
+    for(UINT k=0; k<contextModules.size(); k++){
+        for(UINT moduleIndex=0; moduleIndex<contextModules[k].size(); moduleIndex++){
+            contextModules[k][ moduleIndex ]->reset();
+        }
+    }
+
+    prediction.clear();
+    predictedClassLabel = 0;
+
+    return true;
+}
+
+bool PipelineSession::clear(){
+
+    deleteModules( preProcessingModules );
+    deleteModules( featureExtractionModules );
+    deleteModules( postProcessingModules );
+    for(UINT k=0; k<contextModules.size(); k++){
+        deleteModules( contextModules[k] );
+    }
+
+    if( classifier != NULL ){
+        delete classifier;
+        classifier = NULL;
+    }
+
+    if( regressifier != NULL ){
+        delete regressifier;
+        regressifier = NULL;
+    }
+
+    pipeline = NULL;
+    sharedClassifier = NULL;
+    initialized = false;
+    prediction.clear();
+    predictedClassLabel = 0;
+    regressionData.clear();
+
+    return true;
+}
+
+bool PipelineSession::getInitialized() const{
+    return initialized;
+}
+
+bool PipelineSession::getUsesSharedClassifier() const{
+    return sharedClassifier != NULL;
+}
+
+UINT PipelineSession::getPredictedClassLabel() const{
+    return predictedClassLabel;
+}
+
+UINT PipelineSession::getUnProcessedPredictedClassLabel() const{
+    return prediction.predictedClassLabel;
+}
+
+double PipelineSession::getMaximumLikelihood() const{
+    return prediction.maxLikelihood;
+}
+
+const VectorDouble& PipelineSession::getClassLikelihoods() const{
+    return prediction.classLikelihoods;
+}
+
+const VectorDouble& PipelineSession::getClassDistances() const{
+    return prediction.classDistances;
+}
+
+const VectorDouble& PipelineSession::getRegressionData() const{
+    return regressionData;
+}
+
+const GestureRecognitionPipeline* PipelineSession::getPipeline() const{
+    return pipeline;
+}
+
+bool PipelineSession::copyModulesFrom(const PipelineSession &rhs){
+
+    for(UINT i=0; i<rhs.preProcessingModules.size(); i++){
+        PreProcessing *module = copyModule( rhs.preProcessingModules[i] );
+        if( module == NULL ){ clear(); return false; }
+        preProcessingModules.push_back( module );
+    }
+
+    for(UINT i=0; i<rhs.featureExtractionModules.size(); i++){
+        FeatureExtraction *module = copyModule( rhs.featureExtractionModules[i] );
+        if( module == NULL ){ clear(); return false; }
+        featureExtractionModules.push_back( module );
+    }
+
+    for(UINT i=0; i<rhs.postProcessingModules.size(); i++){
+        PostProcessing *module = copyModule( rhs.postProcessingModules[i] );
+        if( module == NULL ){ clear(); return false; }
+        postProcessingModules.push_back( module );
+    }
+
+    for(UINT k=0; k<rhs.contextModules.size(); k++){
+        for(UINT i=0; i<rhs.contextModules[k].size(); i++){
+            Context *module = copyModule( rhs.contextModules[k][i] );
+            if( module == NULL ){ clear(); return false; }
+            contextModules[k].push_back( module );
+        }
+    }
+
+    if( rhs.classifier != NULL ){
+        classifier = copyModule( rhs.classifier );
+        if( classifier == NULL ){ clear(); return false; }
+    }
+
+    if( rhs.regressifier != NULL ){
+        regressifier = copyModule( rhs.regressifier );
+        if( regressifier == NULL ){ clear(); return false; }
+    }
+
+    return true;
+}
+
+bool PipelineSession::predict_classifier(const VectorDouble &inputVector){
+
+    //The data pointer tracks the output of the most recent module, this avoids copying the data between each stage of the pipeline
+    const VectorDouble *data = &inputVector;
+    bool stopped = false;
+
+    predictedClassLabel = 0;
+
+    //If a START_OF_PIPELINE context module stops the prediction this is not an error, this matches the pipeline
+    if( !processContext( GestureRecognitionPipeline::START_OF_PIPELINE, data, stopped ) ) return false;
+    if( stopped ) return true;
+
+    for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+        if( !preProcessingModules[moduleIndex]->process( *data ) ){
+            errorLog << "predict_classifier(const VectorDouble &inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
+            return false;
+        }
+        data = &preProcessingModules[moduleIndex]->getProcessedData();
+    }
+
+    if( !processContext( GestureRecognitionPipeline::AFTER_PREPROCESSING, data, stopped ) || stopped ) return false;
+
+    for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+        if( !featureExtractionModules[moduleIndex]->computeFeatures( *data ) ){
+            errorLog << "predict_classifier(const VectorDouble &inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
+            return false;
+        }
+        data = &featureExtractionModules[moduleIndex]->getFeatureVector();
+    }
+
+    if( !processContext( GestureRecognitionPipeline::AFTER_FEATURE_EXTRACTION, data, stopped ) || stopped ) return false;
+
+    //Perform the classification, the shared classifier writes its results into the session's prediction
+    if( sharedClassifier != NULL ){
+        if( !sharedClassifier->predictShared( *data, prediction ) ){
+            errorLog << "predict_classifier(const VectorDouble &inputVector) - Prediction Failed!" << endl;
+            return false;
+        }
+    }else{
+        //The classifier may modify its input (i.e. scaling) so we give it a copy in the reusable input buffer
+        predictionInputBuffer = *data;
+        if( !classifier->predictInplace( predictionInputBuffer ) ){
+            errorLog << "predict_classifier(const VectorDouble &inputVector) - Prediction Failed! " << classifier->getLastErrorMessage() << endl;
+            return false;
+        }
+        prediction.predictedClassLabel = classifier->getPredictedClassLabel();
+        prediction.maxLikelihood = classifier->getMaximumLikelihood();
+        prediction.classLikelihoods = classifier->getClassLikelihoods();
+        prediction.classDistances = classifier->getClassDistances();
+    }
+    predictedClassLabel = prediction.predictedClassLabel;
+
+    if( !processContextLabel( GestureRecognitionPipeline::AFTER_CLASSIFIER, predictedClassLabel, stopped ) || stopped ) return false;
+
+    for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+
+        //Select which input we should give the postprocessing module
+        if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() ){
+            predictionLabelBuffer.resize(1);
+            predictionLabelBuffer[0] = predictedClassLabel;
+
+            if( predictionLabelBuffer.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
+                errorLog << "predict_classifier(const VectorDouble &inputVector) - The size of the data vector (" << int(predictionLabelBuffer.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
+                return false;
+            }
+
+            if( !postProcessingModules[moduleIndex]->process( predictionLabelBuffer ) ){
+                errorLog << "predict_classifier(const VectorDouble &inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
+                return false;
+            }
+        }
+
+        //Select which output we should update
+        if( postProcessingModules[moduleIndex]->getIsPostProcessingOutputModePredictedClassLabel() ){
+            const VectorDouble &processedData = postProcessingModules[moduleIndex]->getProcessedData();
+
+            if( processedData.size() != 1 ){
+                errorLog << "predict_classifier(const VectorDouble &inputVector) - The size of the processed data vector (" << int(processedData.size()) << ") from postProcessingModule at the moduleIndex: " << moduleIndex << " is not equal to 1 even though it is in OutputModePredictedClassLabel!" << endl;
+                return false;
+            }
+
+            predictedClassLabel = (UINT)processedData[0];
+        }
+    }
+
+    if( !processContextLabel( GestureRecognitionPipeline::END_OF_PIPELINE, predictedClassLabel, stopped ) || stopped ) return false;
+
+    return true;
+}
+
+bool PipelineSession::predict_regressifier(const VectorDouble &inputVector){
+
+    //The data pointer tracks the output of the most recent module, this avoids copying the data between each stage of the pipeline
+    const VectorDouble *data = &inputVector;
+    bool stopped = false;
+
+    if( !processContext( GestureRecognitionPipeline::START_OF_PIPELINE, data, stopped ) ) return false;
+    if( stopped ) return true;
+
+    for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+        if( !preProcessingModules[moduleIndex]->process( *data ) ){
+            errorLog << "predict_regressifier(const VectorDouble &inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
+            return false;
+        }
+        data = &preProcessingModules[moduleIndex]->getProcessedData();
+    }
+
+    if( !processContext( GestureRecognitionPipeline::AFTER_PREPROCESSING, data, stopped ) || stopped ) return false;
+
+    for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+        if( !featureExtractionModules[moduleIndex]->computeFeatures( *data ) ){
+            errorLog << "predict_regressifier(const VectorDouble &inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
+            return false;
+        }
+        data = &featureExtractionModules[moduleIndex]->getFeatureVector();
+    }
+
+    if( !processContext( GestureRecognitionPipeline::AFTER_FEATURE_EXTRACTION, data, stopped ) || stopped ) return false;
+
+    //The regressifier may modify its input (i.e. scaling) so we give it a copy in the reusable input buffer
+    predictionInputBuffer = *data;
+    if( !regressifier->predictInplace( predictionInputBuffer ) ){
+        errorLog << "predict_regressifier(const VectorDouble &inputVector) - Prediction Failed! " << regressifier->getLastErrorMessage() << endl;
+        return false;
+    }
+    regressionData = regressifier->getRegressionData();
+
+    data = &regressionData;
+    if( !processContext( GestureRecognitionPipeline::AFTER_CLASSIFIER, data, stopped ) || stopped ) return false;
+    if( data != &regressionData ) regressionData = *data;
+
+    for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+        if( regressionData.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
+            errorLog << "predict_regressifier(const VectorDouble &inputVector) - The size of the regression vector (" << int(regressionData.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
+            return false;
+        }
+
+        if( !postProcessingModules[moduleIndex]->process( regressionData ) ){
+            errorLog << "predict_regressifier(const VectorDouble &inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
+            return false;
+        }
+        regressionData = postProcessingModules[moduleIndex]->getProcessedData();
+    }
+
+    data = &regressionData;
+    if( !processContext( GestureRecognitionPipeline::END_OF_PIPELINE, data, stopped ) || stopped ) return false;
+    if( data != &regressionData ) regressionData = *data;
+
+    return true;
+}
+
+bool PipelineSession::processContext(const UINT contextLevel,const VectorDouble *&data,bool &stopped){
+
+    stopped = false;
+    const vector< Context* > &modules = contextModules[ contextLevel ];
+    for(UINT moduleIndex=0; moduleIndex<modules.size(); moduleIndex++){
+        if( !modules[moduleIndex]->process( *data ) ){
+            errorLog << "processContext(...) - Context Module Failed at context level: " << contextLevel << ". ModuleIndex: " << moduleIndex << endl;
+            return false;
+        }
+        if( !modules[moduleIndex]->getOK() ){
+            stopped = true;
+            return true;
+        }
+        data = &modules[moduleIndex]->getProcessedData();
+    }
+
+    return true;
+}
+
+bool PipelineSession::processContextLabel(const UINT contextLevel,UINT &classLabel,bool &stopped){
+
+    stopped = false;
+    const vector< Context* > &modules = contextModules[ contextLevel ];
+    for(UINT moduleIndex=0; moduleIndex<modules.size(); moduleIndex++){
+        predictionLabelBuffer.resize(1);
+        predictionLabelBuffer[0] = classLabel;
+        if( !modules[moduleIndex]->process( predictionLabelBuffer ) ){
+            errorLog << "processContextLabel(...) - Context Module Failed at context level: " << contextLevel << ". ModuleIndex: " << moduleIndex << endl;
+            return false;
+        }
+        if( !modules[moduleIndex]->getOK() ){
+            stopped = true;
+            return true;
+        }
+        classLabel = (UINT)modules[moduleIndex]->getProcessedData()[0];
+    }
+
+    return true;
+}
+
+} //End of namespace GRT
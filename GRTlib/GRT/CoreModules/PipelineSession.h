@@ -0,0 +1,207 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The PipelineSession class holds the state of one user (or one stream of data) running a trained GestureRecognitionPipeline,
+ so many users can share one trained model.
+
+ Training a pipeline builds the model, but predicting with it also changes it: the filters, feature extraction, context and post processing
+ modules keep a history of the data, and the classifier writes its outputs into itself.  This means one pipeline can only serve one stream
+ of data at a time, and running it from several threads needs a lock around every predict call.  A PipelineSession splits the two: the
+ session holds its own copy of every module that keeps state (these are small, such as a filter history or a class label buffer) and its
+ own prediction outputs, while the trained classifier is shared by every session and is only read.  Each session can then be used by its
+ own thread without any locks.
+
+ The classifier is shared if it supports Classifier::predictShared (MinDist, ANBC, GMM, KNN and RandomForests), otherwise each session
+ falls back to its own deep copy of the classifier.  A regressifier is always copied.  Filter fusion is not used by a session, the
+ session runs each pre processing module in turn.
+
+ The pipeline must stay trained and must not be modified (trained, loaded, reset or used for prediction) while any session that was
+ built from it is in use, and it must outlive those sessions.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_PIPELINE_SESSION_HEADER
+#define GRT_PIPELINE_SESSION_HEADER
+
+#include "GestureRecognitionPipeline.h"
+#include "../Util/ClassifierPrediction.h"
+
+namespace GRT{
+
+class PipelineSession : public GRTBase
+{
+public:
+    /**
+     Default Constructor, the session must be initialized with init before it can be used.
+     */
+    PipelineSession();
+
+    /**
+     Creates a session for the trained pipeline, this is the same as calling init.
+
+     @param const GestureRecognitionPipeline &pipeline: the trained pipeline the session will use
+     */
+    PipelineSession(const GestureRecognitionPipeline &pipeline);
+
+    /**
+     Copy Constructor, the new session shares the same pipeline and starts with a copy of the rhs session's state.
+
+     @param const PipelineSession &rhs: another instance of a PipelineSession
+     */
+    PipelineSession(const PipelineSession &rhs);
+
+    /**
+     Default Destructor.
+     */
+    virtual ~PipelineSession();
+
+    /**
+     Defines how the data from the rhs PipelineSession should be copied to this PipelineSession.
+
+     @param const PipelineSession &rhs: another instance of a PipelineSession
+     @return returns a reference to this instance of the PipelineSession
+     */
+    PipelineSession& operator=(const PipelineSession &rhs);
+
+    /**
+     Initializes the session for the trained pipeline.  The state of the pipeline's modules is copied into the session, so the session
+     starts from the pipeline's current state (call reset to start from the beginning).  The pipeline must outlive the session and must
+     not be modified while the session is in use.
+
+     @param const GestureRecognitionPipeline &pipeline: the trained pipeline the session will use
+     @return returns true if the session was initialized, false otherwise
+     */
+    bool init(const GestureRecognitionPipeline &pipeline);
+
+    /**
+     Passes the inputVector through the session's modules and the shared model, in the same way as GestureRecognitionPipeline::predict.
+
+     @param const VectorDouble &inputVector: the input data that will be passed through the pipeline
+     @return returns true if the prediction was successful, false otherwise
+     */
+    bool predict(const VectorDouble &inputVector);
+
+    /**
+     Resets the session's pre processing, feature extraction, context and post processing modules, without changing the shared model.
+
+     @return returns true if the session was reset, false otherwise
+     */
+    bool reset();
+
+    /**
+     Removes the session's modules, after this the session must be initialized again before it can be used.
+
+     @return returns true if the session was cleared, false otherwise
+     */
+    bool clear();
+
+    /**
+     Gets if the session has been initialized.
+
+     @return returns true if the session has been initialized, false otherwise
+     */
+    bool getInitialized() const;
+
+    /**
+     Gets if the session uses the pipeline's classifier directly, if false the session has its own copy of the classifier.
+
+     @return returns true if the classifier is shared, false otherwise
+     */
+    bool getUsesSharedClassifier() const;
+
+    /**
+     Gets the predicted class label of the last prediction, after any post processing.
+
+     @return returns the predicted class label
+     */
+    UINT getPredictedClassLabel() const;
+
+    /**
+     Gets the class label predicted by the classifier in the last prediction, before any post processing.
+
+     @return returns the unprocessed predicted class label
+     */
+    UINT getUnProcessedPredictedClassLabel() const;
+
+    /**
+     Gets the maximum likelihood of the last prediction.
+
+     @return returns the maximum likelihood
+     */
+    double getMaximumLikelihood() const;
+
+    /**
+     Gets the class likelihoods of the last prediction.
+
+     @return returns a reference to the class likelihoods
+     */
+    const VectorDouble& getClassLikelihoods() const;
+
+    /**
+     Gets the class distances of the last prediction.
+
+     @return returns a reference to the class distances
+     */
+    const VectorDouble& getClassDistances() const;
+
+    /**
+     Gets the regression data of the last prediction (regression mode only).
+
+     @return returns a reference to the regression data
+     */
+    const VectorDouble& getRegressionData() const;
+
+    /**
+     Gets the pipeline the session was initialized with.
+
+     @return returns a pointer to the pipeline, or NULL if the session has not been initialized
+     */
+    const GestureRecognitionPipeline* getPipeline() const;
+
+protected:
+    bool copyModulesFrom(const PipelineSession &rhs);
+    bool predict_classifier(const VectorDouble &inputVector);
+    bool predict_regressifier(const VectorDouble &inputVector);
+    bool processContext(const UINT contextLevel,const VectorDouble *&data,bool &stopped);
+    bool processContextLabel(const UINT contextLevel,UINT &classLabel,bool &stopped);
+
+    const GestureRecognitionPipeline *pipeline;         ///< The trained pipeline, this is never modified by the session
+    const Classifier *sharedClassifier;                 ///< The pipeline's classifier, only used if it supports shared prediction
+    bool initialized;
+    vector< PreProcessing* > preProcessingModules;
+    vector< FeatureExtraction* > featureExtractionModules;
+    Classifier *classifier;                             ///< The session's own copy of the classifier, NULL if the classifier is shared
+    Regressifier *regressifier;                         ///< The session's own copy of the regressifier
+    vector< PostProcessing* > postProcessingModules;
+    vector< vector< Context* > > contextModules;
+    ClassifierPrediction prediction;
+    UINT predictedClassLabel;
+    VectorDouble regressionData;
+    VectorDouble predictionInputBuffer;
+    VectorDouble predictionLabelBuffer;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_PIPELINE_SESSION_HEADER
@@ -180,7 +180,7 @@ bool PostProcessing::getIsPostProcessingOutputModeClassLikelihoods() const{
     return postProcessingOutputMode==OUTPUT_MODE_CLASS_LIKELIHOODS; 
 }
     
-vector< double > PostProcessing::getProcessedData() const{ 
+const VectorDouble& PostProcessing::getProcessedData() const{ 
     return processedData; 
 }
 
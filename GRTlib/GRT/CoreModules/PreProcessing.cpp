@@ -81,6 +81,41 @@ bool PreProcessing::reset(){
     return true;
 }
     
+bool PreProcessing::processBatch(const MatrixDouble &inputData,MatrixDouble &outputData){
+    
+    if( !initialized ){
+        errorLog << "processBatch(const MatrixDouble &inputData,MatrixDouble &outputData) - The module has not been initialized!" << endl;
+        return false;
+    }
+    
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << "processBatch(const MatrixDouble &inputData,MatrixDouble &outputData) - The number of columns in the input data (" << inputData.getNumCols() << ") does not match the number of input dimensions (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ){
+        outputData.clear();
+        return true;
+    }
+    if( outputData.getNumRows() != M || outputData.getNumCols() != numOutputDimensions ) outputData.resize( M, numOutputDimensions );
+    
+    //Copy each row into the same buffer so the loop does not allocate
+    VectorDouble inputVector( numInputDimensions );
+    for(UINT i=0; i<M; i++){
+        std::copy( inputData[i], inputData[i]+numInputDimensions, inputVector.begin() );
+        
+        if( !process( inputVector ) || processedData.size() != numOutputDimensions ){
+            errorLog << "processBatch(const MatrixDouble &inputData,MatrixDouble &outputData) - Failed to process row: " << i << endl;
+            return false;
+        }
+        
+        std::copy( processedData.begin(), processedData.end(), outputData[i] );
+    }
+    
+    return true;
+}
+    
 bool PreProcessing::clear(){
     initialized = false;
     numInputDimensions = 0;
@@ -106,10 +141,10 @@ bool PreProcessing::init(){
     return true;
 }
     
-bool PreProcessing::savePreProcessingSettingsToFile(fstream &file) const{
+bool PreProcessing::savePreProcessingSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "savePreProcessingSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "savePreProcessingSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -171,7 +206,7 @@ bool PreProcessing::getInitialized() const{
     return initialized; 
 }
     
-VectorDouble PreProcessing::getProcessedData() const{ 
+const VectorDouble& PreProcessing::getProcessedData() const{ 
     return processedData; 
 }
 
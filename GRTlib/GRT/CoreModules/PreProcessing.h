@@ -72,6 +72,28 @@ public:
      */
     virtual bool process(const VectorDouble &inputVector){ return false; }
     
+    /**
+     Processes each row in the inputData, storing the result for each row in the matching row of the outputData.
+     The rows are processed in order, so modules that keep state (such as filters) give the same result as calling process on each row in turn.
+     The default implementation calls process for each row, the derived class can override this if it can process the block more efficiently.
+     
+     @param const MatrixDouble &inputData: the data to process, each row is one sample
+     @param MatrixDouble &outputData: will be resized to [numRows numOutputDimensions] and filled with the processed data
+     @return returns true if the data was processed, false otherwise
+     */
+    virtual bool processBatch(const MatrixDouble &inputData,MatrixDouble &outputData);
+    
+    /**
+     If the module is a linear time invariant filter, that applies the same filter to each dimension, then this gets the coefficients of its
+     transfer function H(z) = (b[0] + b[1]z^-1 + ...) / (a[0] + a[1]z^-1 + ...).  The GestureRecognitionPipeline uses this to fuse runs of linear
+     filters into a single FusedLinearFilter.  Modules that are not linear time invariant should not override this function.
+     
+     @param VectorDouble &numerator: will be set to the numerator coefficients (b) of the transfer function
+     @param VectorDouble &denominator: will be set to the denominator coefficients (a) of the transfer function
+     @return returns true if the module is a linear time invariant filter, false otherwise (the base class always returns false)
+     */
+    virtual bool getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const{ return false; }
+    
     /**
      This is the main reset interface for all the GRT preprocessing modules. This should be overwritten by the derived class.
      
@@ -109,10 +131,10 @@ public:
      This saves the pre processing settings to a file.
      This function should be overwritten by the derived class.
      
-     @param fstream &file: a reference to the file to save the settings to
+     @param ostream &file: a reference to the file to save the settings to
      @return returns true if the settings were saved successfully, false otherwise (the base class always returns false)
      */
-    virtual bool saveSettingsToFile(fstream &file) const{ return false; }
+    virtual bool saveSettingsToFile(ostream &file) const{ return false; }
     
     /**
      This loads the pre processing settings from a file.
@@ -150,9 +172,9 @@ public:
     bool getInitialized() const;
 
     /**
-     @return returns a VectorDouble containing the most recent processed data
+     @return returns a const reference to a VectorDouble containing the most recent processed data
      */
-	VectorDouble getProcessedData() const;
+	const VectorDouble& getProcessedData() const;
     
     /**
      This typedef defines a map between a string and a PreProcessing pointer.
@@ -186,7 +208,7 @@ protected:
      
      @return returns true if the base settings were saved, false otherwise
      */
-    bool savePreProcessingSettingsToFile(fstream &file) const;
+    bool savePreProcessingSettingsToFile(ostream &file) const;
     
     /**
      Loads the core preprocessing settings from a file.
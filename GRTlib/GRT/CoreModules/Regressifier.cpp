@@ -142,11 +142,13 @@ UINT Regressifier::getValidationSetSize() const{
     return validationSetSize;
 }
     
-VectorDouble Regressifier::getRegressionData() const{ 
+const VectorDouble& Regressifier::getRegressionData() const{ 
+    //The reference must outlive the call, so an untrained regressifier returns a reference to a static empty vector
+    static const VectorDouble emptyRegressionData;
     if( trained ){ 
         return regressionData; 
     } 
-    return VectorDouble(); 
+    return emptyRegressionData; 
 }
     
 vector< MinMax > Regressifier::getInputRanges() const{
@@ -19,6 +19,7 @@
    */
 
 #include "LabelledClassificationData.h"
+#include "LabelledClassificationDataView.h"
 
 namespace GRT{
 
@@ -40,6 +41,10 @@ namespace GRT{
     *this = rhs;
   }
 
+  LabelledClassificationData::LabelledClassificationData(const LabelledClassificationDataView &view){
+    *this = view.getLabelledClassificationData();
+  }
+
   LabelledClassificationData::~LabelledClassificationData(){
   }
 
@@ -55,7 +60,8 @@ namespace GRT{
       this->allowNullGestureClass = rhs.allowNullGestureClass;
       this->externalRanges = rhs.externalRanges;
       this->classTracker = rhs.classTracker;
-      this->data = rhs.data;
+      this->samples = rhs.samples;
+      this->sampleLabels = rhs.sampleLabels;
       this->crossValidationIndexs = rhs.crossValidationIndexs;
       this->debugLog = rhs.debugLog;
       this->errorLog = rhs.errorLog;
@@ -66,7 +72,8 @@ namespace GRT{
 
   void LabelledClassificationData::clear(){
     totalNumSamples = 0;
-    data.clear();
+    samples.clear();
+    sampleLabels.clear();
     classTracker.clear();
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -134,6 +141,16 @@ namespace GRT{
       return false;
     }
 
+    return addSample( classLabel, numDimensions > 0 ? &sample[0] : NULL );
+  }
+
+  bool LabelledClassificationData::addSample(const UINT classLabel,const double *sample){
+
+    if( numDimensions == 0 || sample == NULL ){
+      errorLog << "addSample(const UINT classLabel,const double *sample) - the number of dimensions of the dataset has not been set!" << endl;
+      return false;
+    }
+
     //The class label must be greater than zero (as zero is used for the null rejection class label
     if( classLabel == GRT_DEFAULT_NULL_CLASS_LABEL && !allowNullGestureClass ){
       errorLog << "addSample(const UINT classLabel, VectorDouble &sample) - the class label can not be 0!" << endl;
@@ -144,8 +161,13 @@ namespace GRT{
     crossValidationSetup = false;
     crossValidationIndexs.clear();
 
-    LabelledClassificationSample newSample(classLabel,sample);
-    data.push_back( newSample );
+    //Copy the sample into the next row of the sample matrix
+    if( samples.getNumCols() != numDimensions ) samples.setNumCols( numDimensions );
+    if( !samples.push_back( sample ) ){
+      errorLog << "addSample(const UINT classLabel,const double *sample) - Failed to add the sample to the sample matrix!" << endl;
+      return false;
+    }
+    sampleLabels.push_back( classLabel );
     totalNumSamples++;
 
     if( classTracker.size() == 0 ){
@@ -177,12 +199,13 @@ namespace GRT{
       crossValidationIndexs.clear();
 
       //Find the corresponding class ID for the last training example
-      UINT classLabel = data[ totalNumSamples-1 ].getClassLabel();
+      UINT classLabel = sampleLabels[ totalNumSamples-1 ];
 
       //Remove the training example from the buffer
-      data.erase(data.end()-1);
+      samples.pop_back();
+      sampleLabels.pop_back();
 
-      totalNumSamples = (UINT)data.size();
+      totalNumSamples = (UINT)sampleLabels.size();
 
       //Remove the value from the counter
       for(UINT i=0; i<classTracker.size(); i++){
@@ -200,11 +223,12 @@ namespace GRT{
 
   bool LabelledClassificationData::reserve(const UINT N){
 
-    data.reserve( N );
+    sampleLabels.reserve( N );
 
-    if( data.capacity() >= N ) return true;
+    //The sample matrix can only be reserved once the number of columns is known
+    if( samples.getNumCols() != numDimensions ) samples.setNumCols( numDimensions );
 
-    return false;
+    return samples.reserve( N ) && sampleLabels.capacity() >= N;
   }
 
   UINT LabelledClassificationData::eraseAllSamplesWithClassLabel(const UINT classLabel){
@@ -224,18 +248,27 @@ namespace GRT{
       }
     }
 
-    //Remove the samples with the matching class ID
+    //Remove the samples with the matching class ID, the remaining samples are moved down so the sample matrix stays contiguous
     if( numExamplesToRemove > 0 ){
-      UINT i=0;
-      while( numExamplesRemoved < numExamplesToRemove ){
-        if( data[i].getClassLabel() == classLabel ){
-          data.erase(data.begin()+i);
+      UINT numExamplesKept = 0;
+      for(UINT i=0; i<totalNumSamples; i++){
+        if( sampleLabels[i] == classLabel ){
           numExamplesRemoved++;
-        }else if( ++i == data.size() ) break;
+          continue;
+        }
+        if( numExamplesKept != i ){
+          std::copy( samples[i], samples[i]+numDimensions, samples[numExamplesKept] );
+          sampleLabels[numExamplesKept] = sampleLabels[i];
+        }
+        numExamplesKept++;
+      }
+      for(UINT i=0; i<numExamplesRemoved; i++){
+        samples.pop_back();
       }
+      sampleLabels.resize( numExamplesKept );
     }
 
-    totalNumSamples = (UINT)data.size();
+    totalNumSamples = (UINT)sampleLabels.size();
 
     return numExamplesRemoved;
   }
@@ -283,8 +316,8 @@ namespace GRT{
 
     //Relabel the old class labels
     for(UINT i=0; i<totalNumSamples; i++){
-      if( data[i].getClassLabel() == oldClassLabel ){
-        data[i].set(newClassLabel, data[i].getSample());
+      if( sampleLabels[i] == oldClassLabel ){
+        sampleLabels[i] = newClassLabel;
       }
     }
 
@@ -296,8 +329,8 @@ namespace GRT{
       //Erase the old class tracker
       classTracker.erase( classTracker.begin() + indexOfOldClassLabel );
     }else{
-      //Create a new class tracker
-      classTracker.push_back( ClassTracker(newClassLabel,classTracker[ indexOfOldClassLabel ].counter,classTracker[ indexOfOldClassLabel ].className) );
+      //The old class tracker becomes the tracker of the new class label
+      classTracker[ indexOfOldClassLabel ].classLabel = newClassLabel;
     }
 
     return true;
@@ -331,8 +364,9 @@ namespace GRT{
 
     //Scale the training data
     for(UINT i=0; i<totalNumSamples; i++){
+      double *sample = samples[i];
       for(UINT j=0; j<numDimensions; j++){
-        data[i][j] = Util::scale(data[i][j],ranges[j].minValue,ranges[j].maxValue,minTarget,maxTarget);
+        sample[j] = Util::scale(sample[j],ranges[j].minValue,ranges[j].maxValue,minTarget,maxTarget);
       }
     }
 
@@ -371,9 +405,9 @@ namespace GRT{
     file << "Data:\n";
 
     for(UINT i=0; i<totalNumSamples; i++){
-      file << data[i].getClassLabel();
+      file << sampleLabels[i];
       for(UINT j=0; j<numDimensions; j++){
-        file << "\t" << data[i][j];
+        file << "\t" << samples[i][j];
       }
       file << endl;
     }
@@ -498,17 +532,15 @@ namespace GRT{
       return false;
     }
 
-    LabelledClassificationSample tempSample( numDimensions );
-    data.resize( totalNumSamples, tempSample );
+    //Read the samples straight into the sample matrix
+    samples.resize( totalNumSamples, numDimensions );
+    sampleLabels.resize( totalNumSamples, 0 );
 
     for(UINT i=0; i<totalNumSamples; i++){
-      UINT classLabel = 0;
-      VectorDouble sample(numDimensions,0);
-      file >> classLabel;
+      file >> sampleLabels[i];
       for(UINT j=0; j<numDimensions; j++){
-        file >> sample[j];
+        file >> samples[i][j];
       }
-      data[i].set(classLabel, sample);
     }
 
     file.close();
@@ -529,9 +561,9 @@ namespace GRT{
 
     //Write the data to the CSV file
     for(UINT i=0; i<totalNumSamples; i++){
-      file << data[i].getClassLabel();
+      file << sampleLabels[i];
       for(UINT j=0; j<numDimensions; j++){
-        file << "," << data[i][j];
+        file << "," << samples[i][j];
       }
       file << endl;
     }
@@ -636,10 +668,38 @@ namespace GRT{
     LabelledClassificationData testSet(numDimensions);
     trainingSet.setAllowNullGestureClass( allowNullGestureClass );
     testSet.setAllowNullGestureClass( allowNullGestureClass );
-    vector< UINT > indexs( totalNumSamples );
 
     //Create the random partion indexs
     Random random;
+    vector< UINT > trainingIndexs;
+    vector< UINT > testIndexs;
+    getPartitionIndexs( trainingSizePercentage, useStratifiedSampling, random, trainingIndexs, testIndexs );
+
+    //Reserve the memory
+    trainingSet.reserve( (UINT)trainingIndexs.size() );
+    testSet.reserve( (UINT)testIndexs.size() );
+
+    //Add the data to the training and test sets
+    for(UINT i=0; i<trainingIndexs.size(); i++){
+      trainingSet.addSample( sampleLabels[ trainingIndexs[i] ], samples[ trainingIndexs[i] ] );
+    }
+    for(UINT i=0; i<testIndexs.size(); i++){
+      testSet.addSample( sampleLabels[ testIndexs[i] ], samples[ testIndexs[i] ] );
+    }
+
+    //Overwrite the training data in this instance with the training data of the trainingSet
+    *this = trainingSet;
+
+    sortClassLabels();
+    testSet.sortClassLabels();
+
+    return testSet;
+  }
+
+  void LabelledClassificationData::getPartitionIndexs(const UINT trainingSizePercentage,const bool useStratifiedSampling,Random &random,vector< UINT > &trainingIndexs,vector< UINT > &testIndexs) const{
+
+    trainingIndexs.clear();
+    testIndexs.clear();
     UINT randomIndex = 0;
 
     if( useStratifiedSampling ){
@@ -648,7 +708,7 @@ namespace GRT{
 
       //Add the indexs to their respective classes
       for(UINT i=0; i<totalNumSamples; i++){
-        classData[ getClassLabelIndexValue( data[i].getClassLabel() ) ].push_back( i );
+        classData[ getClassLabelIndexValue( sampleLabels[i] ) ].push_back( i );
       }
 
       //Randomize the order of the indexs in each of the class index buffers
@@ -674,27 +734,24 @@ namespace GRT{
         numTestSamples += numTestExamples;
       }
 
-      trainingSet.reserve( numTrainingSamples );
-      testSet.reserve( numTestSamples );
+      trainingIndexs.reserve( numTrainingSamples );
+      testIndexs.reserve( numTestSamples );
 
-      //Loop over each class and add the data to the trainingSet and testSet
+      //Loop over each class and add the indexs to the training and test indexs
       for(UINT k=0; k<getNumClasses(); k++){
         UINT numTrainingExamples = (UINT) floor( double(classData[k].size()) / 100.0 * double(trainingSizePercentage) );
 
-        //Add the data to the training and test sets
         for(UINT i=0; i<numTrainingExamples; i++){
-          trainingSet.addSample( data[ classData[k][i] ].getClassLabel(), data[ classData[k][i] ].getSample() );
+          trainingIndexs.push_back( classData[k][i] );
         }
         for(UINT i=numTrainingExamples; i<classData[k].size(); i++){
-          testSet.addSample( data[ classData[k][i] ].getClassLabel(), data[ classData[k][i] ].getSample() );
+          testIndexs.push_back( classData[k][i] );
         }
       }
     }else{
 
       const UINT numTrainingExamples = (UINT) floor( double(totalNumSamples) / 100.0 * double(trainingSizePercentage) );
-      //Create the random partion indexs
-      Random random;
-      UINT randomIndex = 0;
+      vector< UINT > indexs( totalNumSamples );
       for(UINT i=0; i<totalNumSamples; i++) indexs[i] = i;
       for(UINT x=0; x<totalNumSamples; x++){
         //Pick a random index
@@ -704,26 +761,27 @@ namespace GRT{
         SWAP(indexs[ x ],indexs[ randomIndex ]);
       }
 
-      //Reserve the memory
-      trainingSet.reserve( numTrainingExamples );
-      testSet.reserve( totalNumSamples-numTrainingExamples );
+      trainingIndexs.assign( indexs.begin(), indexs.begin() + numTrainingExamples );
+      testIndexs.assign( indexs.begin() + numTrainingExamples, indexs.end() );
+    }
+  }
 
-      //Add the data to the training and test sets
-      for(UINT i=0; i<numTrainingExamples; i++){
-        trainingSet.addSample( data[ indexs[i] ].getClassLabel(), data[ indexs[i] ].getSample() );
-      }
-      for(UINT i=numTrainingExamples; i<totalNumSamples; i++){
-        testSet.addSample( data[ indexs[i] ].getClassLabel(), data[ indexs[i] ].getSample() );
-      }
+  bool LabelledClassificationData::getPartitionViews(const UINT trainingSizePercentage,LabelledClassificationDataView &trainingSet,LabelledClassificationDataView &testSet,const bool useStratifiedSampling,const unsigned long long randomSeed) const{
+
+    if( trainingSizePercentage > 100 ){
+      errorLog << "getPartitionViews(const UINT trainingSizePercentage,LabelledClassificationDataView &trainingSet,LabelledClassificationDataView &testSet,const bool useStratifiedSampling,const unsigned long long randomSeed) - The trainingSizePercentage can not be larger than 100!" << endl;
+      return false;
     }
 
-    //Overwrite the training data in this instance with the training data of the trainingSet
-    *this = trainingSet;
+    Random random( randomSeed );
+    vector< UINT > trainingIndexs;
+    vector< UINT > testIndexs;
+    getPartitionIndexs( trainingSizePercentage, useStratifiedSampling, random, trainingIndexs, testIndexs );
 
-    sortClassLabels();
-    testSet.sortClassLabels();
+    trainingSet = LabelledClassificationDataView( *this, trainingIndexs, true );
+    testSet = LabelledClassificationDataView( *this, testIndexs, true );
 
-    return testSet;
+    return true;
   }
 
   bool LabelledClassificationData::merge(const LabelledClassificationData &labelledData){
@@ -742,7 +800,7 @@ namespace GRT{
 
     //Add the data from the labelledData to this instance
     for(UINT i=0; i<labelledData.getNumSamples(); i++){
-      addSample(labelledData[i].getClassLabel(), labelledData[i].getSample());
+      addSample(labelledData.sampleLabels[i], labelledData.samples[i]);
     }
 
     //Set the class names from the dataset
@@ -756,7 +814,7 @@ namespace GRT{
     return true;
   }
 
-  bool LabelledClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling){
+  bool LabelledClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling,const unsigned long long randomSeed){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -794,7 +852,7 @@ namespace GRT{
     crossValidationIndexs.resize(K);
 
     //Create the random partion indexs
-    Random random;
+    Random random( randomSeed );
     UINT randomIndex = 0;
 
     if( useStratifiedSampling ){
@@ -803,7 +861,7 @@ namespace GRT{
 
       //Add the indexs to their respective classes
       for(UINT i=0; i<totalNumSamples; i++){
-        classData[ getClassLabelIndexValue( data[i].getClassLabel() ) ].push_back( i );
+        classData[ getClassLabelIndexValue( sampleLabels[i] ) ].push_back( i );
       }
 
       //Randomize the order of the indexs in each of the class index buffers
@@ -880,7 +938,7 @@ namespace GRT{
         for(UINT i=0; i<crossValidationIndexs[k].size(); i++){
 
           index = crossValidationIndexs[k][i];
-          trainingData.addSample( data[ index ].getClassLabel(), data[ index ].getSample() );
+          trainingData.addSample( sampleLabels[ index ], samples[ index ] );
         }
       }
     }
@@ -907,7 +965,7 @@ namespace GRT{
     for(UINT i=0; i<crossValidationIndexs[ foldIndex ].size(); i++){
 
       index = crossValidationIndexs[ foldIndex ][i];
-      testData.addSample( data[ index ].getClassLabel(), data[ index ].getSample() );
+      testData.addSample( sampleLabels[ index ], samples[ index ] );
     }
 
     testData.sortClassLabels();
@@ -915,6 +973,34 @@ namespace GRT{
     return testData;
   }
 
+  LabelledClassificationDataView LabelledClassificationData::getTrainingFoldView(const UINT foldIndex) const{
+
+    if( !crossValidationSetup ){
+      errorLog << "getTrainingFoldView(const UINT foldIndex) - Cross Validation has not been setup! You need to call the spiltDataIntoKFolds(UINT K,bool useStratifiedSampling) function first before calling this function!" << endl;
+      return LabelledClassificationDataView( *this, vector< UINT >() );
+    }
+
+    if( foldIndex >= kFoldValue ) return LabelledClassificationDataView( *this, vector< UINT >() );
+
+    //The training view consists of the indexs of all the data that is NOT in the foldIndex
+    vector< UINT > indexs;
+    indexs.reserve( totalNumSamples - crossValidationIndexs[ foldIndex ].size() );
+    for(UINT k=0; k<kFoldValue; k++){
+      if( k != foldIndex ){
+        indexs.insert( indexs.end(), crossValidationIndexs[k].begin(), crossValidationIndexs[k].end() );
+      }
+    }
+
+    return LabelledClassificationDataView( *this, indexs, true );
+  }
+
+  LabelledClassificationDataView LabelledClassificationData::getTestFoldView(const UINT foldIndex) const{
+
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return LabelledClassificationDataView( *this, vector< UINT >() );
+
+    return LabelledClassificationDataView( *this, crossValidationIndexs[ foldIndex ], true );
+  }
+
   LabelledClassificationData LabelledClassificationData::getClassData(const UINT classLabel) const{
 
     LabelledClassificationData classData;
@@ -930,17 +1016,16 @@ namespace GRT{
     }
 
     for(UINT i=0; i<totalNumSamples; i++){
-      if( data[i].getClassLabel() == classLabel ){
-        classData.addSample(classLabel, data[i].getSample());
+      if( sampleLabels[i] == classLabel ){
+        classData.addSample(classLabel, samples[i]);
       }
     }
 
     return classData;
   }
 
-  LabelledClassificationData LabelledClassificationData::getBootstrappedDataset(UINT numSamples) const{
+  LabelledClassificationData LabelledClassificationData::getBootstrappedDataset(UINT numSamples,const unsigned long long randomSeed) const{
 
-    Random rand;
     LabelledClassificationData newDataset;
     newDataset.setNumDimensions( getNumDimensions() );
     newDataset.setAllowNullGestureClass( allowNullGestureClass );
@@ -956,10 +1041,9 @@ namespace GRT{
     }
 
     //Randomly select the training samples to add to the new data set
-    UINT randomIndex;
+    const vector< UINT > indexs = getBootstrappedIndexs( numSamples, randomSeed );
     for(UINT i=0; i<numSamples; i++){
-      randomIndex = rand.getRandomNumberInt(0, totalNumSamples);
-      newDataset.addSample(data[randomIndex].getClassLabel(), data[randomIndex].getSample());
+      newDataset.addSample( sampleLabels[ indexs[i] ], samples[ indexs[i] ] );
     }
 
     //Sort the class labels so they are in order
@@ -968,6 +1052,39 @@ namespace GRT{
     return newDataset;
   }
 
+  LabelledClassificationDataView LabelledClassificationData::getBootstrappedView(UINT numSamples,const unsigned long long randomSeed) const{
+
+    if( numSamples == 0 ) numSamples = totalNumSamples;
+
+    LabelledClassificationDataView view( *this, vector< UINT >() );
+    view.useExternalRanges = useExternalRanges;
+    view.externalRanges = externalRanges;
+
+    //Add all the class labels to the view to ensure the view has a list of all the labels
+    for(UINT k=0; k<getNumClasses(); k++){
+      view.classTracker.push_back( ClassTracker(classTracker[k].classLabel,0) );
+    }
+
+    //Randomly select the training samples, the view only stores their indexs
+    view.indexs = getBootstrappedIndexs( numSamples, randomSeed );
+    view.updateClassTracker();
+
+    //Sort the class labels so they are in order
+    sort(view.classTracker.begin(),view.classTracker.end(),ClassTracker::sortByClassLabelAscending);
+
+    return view;
+  }
+
+  vector< UINT > LabelledClassificationData::getBootstrappedIndexs(const UINT numSamples,const unsigned long long randomSeed) const{
+
+    Random rand( randomSeed );
+    vector< UINT > indexs( numSamples );
+    for(UINT i=0; i<numSamples; i++){
+      indexs[i] = rand.getRandomNumberInt(0, totalNumSamples);
+    }
+    return indexs;
+  }
+
   LabelledRegressionData LabelledClassificationData::reformatAsLabelledRegressionData() const{
 
     //Turns the classification into a regression data to enable regression algorithms like the MLP to be used as a classifier
@@ -988,7 +1105,7 @@ namespace GRT{
       VectorDouble targetVector(numTargetDimensions,0);
 
       //Set the class index in the target vector to 1 and all other values in the target vector to 0
-      UINT classLabel = data[i].getClassLabel();
+      UINT classLabel = sampleLabels[i];
 
       if( classLabel > 0 ){
         targetVector[ classLabel-1 ] = 1;
@@ -997,7 +1114,7 @@ namespace GRT{
         return regressionData;
       }
 
-      regressionData.addSample(data[i].getSample(),targetVector);
+      regressionData.addSample((*this)[i].getSample(),targetVector);
     }
 
     return regressionData;
@@ -1014,7 +1131,7 @@ namespace GRT{
     unlabelledData.setNumDimensions( numDimensions );
 
     for(UINT i=0; i<totalNumSamples; i++){
-      unlabelledData.addSample( data[i].getSample() );
+      unlabelledData.addSample( (*this)[i].getSample() );
     }
 
     return unlabelledData;
@@ -1096,20 +1213,10 @@ namespace GRT{
     //If the dataset should be scaled using the external ranges then return the external ranges
     if( useExternalRanges ) return externalRanges;
 
-    vector< MinMax > ranges(numDimensions);
+    //Otherwise return the min and max values for each column of the sample matrix, each column starts from its own first value
+    if( totalNumSamples == 0 ) return vector< MinMax >(numDimensions);
 
-    //Otherwise return the min and max values for each column in the dataset
-    if( totalNumSamples > 0 ){
-      for(UINT j=0; j<numDimensions; j++){
-        ranges[j].minValue = data[0][0];
-        ranges[j].maxValue = data[0][0];
-        for(UINT i=0; i<totalNumSamples; i++){
-          if( data[i][j] < ranges[j].minValue ){ ranges[j].minValue = data[i][j]; }		//Search for the min value
-          else if( data[i][j] > ranges[j].maxValue ){ ranges[j].maxValue = data[i][j]; }	//Search for the max value
-        }
-      }
-    }
-    return ranges;
+    return samples.getRanges();
   }
 
   vector< UINT > LabelledClassificationData::getClassLabels() const{
@@ -1140,10 +1247,13 @@ namespace GRT{
 
     VectorDouble mean(numDimensions,0);
 
-    for(UINT j=0; j<numDimensions; j++){
-      for(UINT i=0; i<totalNumSamples; i++){
-        mean[j] += data[i][j];
+    for(UINT i=0; i<totalNumSamples; i++){
+      const double *sample = samples[i];
+      for(UINT j=0; j<numDimensions; j++){
+        mean[j] += sample[j];
       }
+    }
+    for(UINT j=0; j<numDimensions; j++){
       mean[j] /= double(totalNumSamples);
     }
 
@@ -1152,17 +1262,11 @@ namespace GRT{
 
   VectorDouble LabelledClassificationData::getStdDev() const{
 
-    VectorDouble mean = getMean();
-    VectorDouble stdDev(numDimensions,0);
-
-    for(UINT j=0; j<numDimensions; j++){
-      for(UINT i=0; i<totalNumSamples; i++){
-        stdDev[j] += SQR(data[i][j]-mean[j]);
-      }
-      stdDev[j] = sqrt( stdDev[j] / double(totalNumSamples-1) );
-    }
+    //The mean and variance are computed together in a single pass
+    RunningStatistics stats(numDimensions);
+    if( totalNumSamples > 0 ) stats.update( samples );
 
-    return stdDev;
+    return stats.getStdDev();
   }
 
   MatrixDouble LabelledClassificationData::getClassHistogramData(UINT classLabel,UINT numBins) const{
@@ -1181,12 +1285,12 @@ namespace GRT{
 
     double norm = 0;
     for(UINT i=0; i<M; i++){
-      if( data[i].getClassLabel() == classLabel ){
+      if( sampleLabels[i] == classLabel ){
         for(UINT j=0; j<N; j++){
           UINT binIndex = 0;
           bool binFound = false;
           for(UINT k=0; k<numBins-1; k++){
-            if( data[i][j] >= ranges[i].minValue + (binRange[j]*k) && data[i][j] >= ranges[i].minValue + (binRange[j]*(k+1)) ){
+            if( samples[i][j] >= ranges[i].minValue + (binRange[j]*k) && samples[i][j] >= ranges[i].minValue + (binRange[j]*(k+1)) ){
               binIndex = k;
               binFound = true;
               break;
@@ -1219,16 +1323,16 @@ namespace GRT{
     mean.setAllValues( 0 );
 
     for(UINT i=0; i<totalNumSamples; i++){
-      UINT classIndex = getClassLabelIndexValue( data[i].getClassLabel() );
+      UINT classIndex = getClassLabelIndexValue( sampleLabels[i] );
       for(UINT j=0; j<numDimensions; j++){
-        mean[classIndex][j] += data[i][j];
+        mean[classIndex][j] += samples[i][j];
       }
       counter[ classIndex ]++;
     }
 
     for(UINT k=0; k<getNumClasses(); k++){
       for(UINT j=0; j<numDimensions; j++){
-        mean[k][j] = counter[j] > 0 ? mean[k][j]/counter[j] : 0;
+        mean[k][j] = counter[k] > 0 ? mean[k][j]/counter[k] : 0;
       }
     }
 
@@ -1244,9 +1348,9 @@ namespace GRT{
     stdDev.setAllValues( 0 );
 
     for(UINT i=0; i<totalNumSamples; i++){
-      UINT classIndex = getClassLabelIndexValue( data[i].getClassLabel() );
+      UINT classIndex = getClassLabelIndexValue( sampleLabels[i] );
       for(UINT j=0; j<numDimensions; j++){
-        stdDev[classIndex][j] += SQR(data[i][j]-mean[classIndex][j]);
+        stdDev[classIndex][j] += SQR(samples[i][j]-mean[classIndex][j]);
       }
       counter[ classIndex  ]++;
     }
@@ -1262,19 +1366,11 @@ namespace GRT{
 
   MatrixDouble LabelledClassificationData::getCovarianceMatrix() const{
 
-    VectorDouble mean = getMean();
-    MatrixDouble covariance(numDimensions,numDimensions);
-
-    for(UINT j=0; j<numDimensions; j++){
-      for(UINT k=0; k<numDimensions; k++){
-        for(UINT i=0; i<totalNumSamples; i++){
-          covariance[j][k] += (data[i][j]-mean[j]) * (data[i][k]-mean[k]) ;
-        }
-        covariance[j][k] /= double(totalNumSamples-1);
-      }
-    }
+    //The mean and covariance are computed together in a single pass over the samples, in blocks of rows
+    RunningStatistics stats(numDimensions,true);
+    if( totalNumSamples > 0 ) stats.update( samples );
 
-    return covariance;
+    return stats.getCovarianceMatrix();
   }
 
   vector< MatrixDouble > LabelledClassificationData::getHistogramData(UINT numBins) const{
@@ -1305,7 +1401,7 @@ namespace GRT{
     UINT index = 0;
     vector< UINT > classIndexes(N);
     for(UINT i=0; i<M; i++){
-      if( data[i].getClassLabel() == classLabel ){
+      if( sampleLabels[i] == classLabel ){
         classIndexes[index++] = i;
       }
     }
@@ -1315,17 +1411,31 @@ namespace GRT{
 
   MatrixDouble LabelledClassificationData::getDataAsMatrixDouble() const{
 
-    const UINT M = getNumSamples();
-    const UINT N = getNumDimensions();
-    MatrixDouble d(M,N);
+    //The samples are already stored as a matrix, so this is a single copy of the sample matrix
+    return samples;
+  }
 
-    for(UINT i=0; i<M; i++){
-      for(UINT j=0; j<N; j++){
-        d[i][j] = data[i][j];
-      }
+  MatrixDouble LabelledClassificationData::releaseDataAsMatrixDouble(){
+
+#if __cplusplus >= 201103L
+    MatrixDouble data( std::move( samples ) );
+#else
+    MatrixDouble data( samples );
+#endif
+    clear();
+    return data;
+  }
+
+  vector< LabelledClassificationSample > LabelledClassificationData::getClassificationData() const{
+
+    vector< LabelledClassificationSample > classificationData;
+    classificationData.reserve( totalNumSamples );
+
+    for(UINT i=0; i<totalNumSamples; i++){
+      classificationData.push_back( (*this)[i] );
     }
 
-    return d;
+    return classificationData;
   }
 
 }; //End of namespace GRT
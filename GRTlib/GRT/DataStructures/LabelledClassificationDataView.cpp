@@ -0,0 +1,130 @@
+/*
+   GRT MIT License
+   Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+   */
+
+#include "LabelledClassificationDataView.h"
+
+namespace GRT{
+
+  LabelledClassificationDataView::LabelledClassificationDataView(){
+    data = NULL;
+    numDimensions = 0;
+    useExternalRanges = false;
+  }
+
+  LabelledClassificationDataView::LabelledClassificationDataView(const LabelledClassificationData &data){
+    this->data = &data;
+    numDimensions = data.getNumDimensions();
+    useExternalRanges = data.useExternalRanges;
+    externalRanges = data.externalRanges;
+    classTracker = data.classTracker;
+    indexs.resize( data.getNumSamples() );
+    for(UINT i=0; i<indexs.size(); i++) indexs[i] = i;
+  }
+
+  LabelledClassificationDataView::LabelledClassificationDataView(const LabelledClassificationData &data,const vector< UINT > &indexs,const bool sortClassLabels){
+    this->data = &data;
+    this->indexs = indexs;
+    numDimensions = data.getNumDimensions();
+    useExternalRanges = false;
+    updateClassTracker();
+    if( sortClassLabels ){
+      sort(classTracker.begin(),classTracker.end(),ClassTracker::sortByClassLabelAscending);
+    }
+  }
+
+  LabelledClassificationDataView::~LabelledClassificationDataView(){
+  }
+
+  void LabelledClassificationDataView::updateClassTracker(){
+
+    //Count the samples of each class, the classes already in the tracker (such as the classes of a bootstrapped view) are kept even if the view has no samples for them
+    const vector< UINT > &sampleLabels = data->getSampleLabels();
+    for(UINT i=0; i<indexs.size(); i++){
+      const UINT classLabel = sampleLabels[ indexs[i] ];
+      bool labelFound = false;
+      for(UINT k=0; k<classTracker.size(); k++){
+        if( classLabel == classTracker[k].classLabel ){
+          classTracker[k].counter++;
+          labelFound = true;
+          break;
+        }
+      }
+      if( !labelFound ){
+        classTracker.push_back( ClassTracker(classLabel,1) );
+      }
+    }
+  }
+
+  LabelledClassificationData LabelledClassificationDataView::getLabelledClassificationData() const{
+
+    LabelledClassificationData newDataset;
+    if( data == NULL ) return newDataset;
+
+    newDataset.setNumDimensions( numDimensions );
+    newDataset.setAllowNullGestureClass( data->allowNullGestureClass );
+    newDataset.setExternalRanges( externalRanges, useExternalRanges );
+    newDataset.reserve( getNumSamples() );
+
+    const MatrixDouble &samples = data->getSamples();
+    const vector< UINT > &sampleLabels = data->getSampleLabels();
+    for(UINT i=0; i<indexs.size(); i++){
+      newDataset.addSample( sampleLabels[ indexs[i] ], samples[ indexs[i] ] );
+    }
+
+    //The counts match the view, this keeps the order of the classes of the view and any classes the view has no samples for
+    newDataset.classTracker = classTracker;
+
+    return newDataset;
+  }
+
+  vector< MinMax > LabelledClassificationDataView::getRanges() const{
+
+    //If the view uses the external ranges of the dataset then return the external ranges
+    if( useExternalRanges ) return externalRanges;
+
+    vector< MinMax > ranges(numDimensions);
+
+    //The ranges are computed in the same way as LabelledClassificationData::getRanges, so a view and a copy of the view have the same ranges
+    if( indexs.size() > 0 ){
+      const MatrixDouble &samples = data->getSamples();
+      for(UINT j=0; j<numDimensions; j++){
+        ranges[j].minValue = samples[ indexs[0] ][0];
+        ranges[j].maxValue = samples[ indexs[0] ][0];
+      }
+      for(UINT i=0; i<indexs.size(); i++){
+        const double *sample = samples[ indexs[i] ];
+        for(UINT j=0; j<numDimensions; j++){
+          if( sample[j] < ranges[j].minValue ){ ranges[j].minValue = sample[j]; }		//Search for the min value
+          else if( sample[j] > ranges[j].maxValue ){ ranges[j].maxValue = sample[j]; }	//Search for the max value
+        }
+      }
+    }
+    return ranges;
+  }
+
+  vector< UINT > LabelledClassificationDataView::getClassLabels() const{
+    vector< UINT > classLabels( getNumClasses(), 0 );
+    for(UINT i=0; i<getNumClasses(); i++){
+      classLabels[i] = classTracker[i].classLabel;
+    }
+    return classLabels;
+  }
+
+} //End of namespace GRT
@@ -3,7 +3,8 @@
  @author  Nicholas Gillian <ngillian@media.mit.edu>
  @version 1.0
  
- @brief This class stores the class label and raw data for a single labelled classification sample.
+ @brief This class stores the class label and raw data for a single labelled classification sample.  The LabelledClassificationSampleRef
+ and ConstLabelledClassificationSampleRef classes refer to a sample stored inside a LabelledClassificationData.
  */
 
 /**
@@ -63,7 +64,7 @@ public:
     //Getters
     UINT getNumDimensions() const{ return numDimensions; }
     UINT getClassLabel() const{ return classLabel; }
-    VectorDouble getSample() const{ return sample; }
+    const VectorDouble& getSample() const{ return sample; }
     
     //Setters
 	void set(UINT classLabel,const VectorDouble &sample);
@@ -75,6 +76,55 @@ private:
 
 };
 
+/**
+ A reference to a sample stored in a LabelledClassificationData, this is what the [] operator of the dataset returns.  The sample values
+ are a row of the dataset's contiguous sample matrix and the class label is an element of its label array, so the reference does not own
+ or copy the sample.  The reference is only valid until the dataset is resized.
+ 
+ T is double (or const double) and L is UINT (or const UINT), see the LabelledClassificationSampleRef and ConstLabelledClassificationSampleRef typedefs.
+ */
+template< class T,class L >
+class LabelledClassificationSampleReference{
+public:
+    LabelledClassificationSampleReference(T *sample,L *classLabel,const UINT numDimensions):sample(sample),classLabel(classLabel),numDimensions(numDimensions){}
+    
+    //A reference to a sample that can be changed can also be used as a reference to a const sample
+    LabelledClassificationSampleReference(const LabelledClassificationSampleReference< double,UINT > &rhs):sample(rhs.sample),classLabel(rhs.classLabel),numDimensions(rhs.numDimensions){}
+    
+    inline T& operator[] (const UINT &n) const{
+        return sample[n];
+    }
+    
+    //Converts the reference into a LabelledClassificationSample that owns a copy of the sample
+    operator LabelledClassificationSample() const{ return LabelledClassificationSample( *classLabel, getSample() ); }
+    
+    //Getters
+    UINT getNumDimensions() const{ return numDimensions; }
+    UINT getClassLabel() const{ return *classLabel; }
+    
+    //Returns a copy of the sample, use getData() or the [] operator to read the sample without copying it
+    VectorDouble getSample() const{ return VectorDouble( sample, sample+numDimensions ); }
+    
+    //Returns a pointer to the numDimensions values of the sample
+    T* getData() const{ return sample; }
+    
+    //Setters, these write the class label and values into the dataset.  The class tracker of the dataset is not updated
+    void set(UINT classLabel,const VectorDouble &sample) const{
+        *this->classLabel = classLabel;
+        std::copy( sample.begin(), sample.begin()+std::min( (UINT)sample.size(), numDimensions ), this->sample );
+    }
+    
+private:
+    template< class T2,class L2 > friend class LabelledClassificationSampleReference;
+    
+    T *sample;
+    L *classLabel;
+    UINT numDimensions;
+};
+
+typedef LabelledClassificationSampleReference< double,UINT > LabelledClassificationSampleRef;
+typedef LabelledClassificationSampleReference< const double,const UINT > ConstLabelledClassificationSampleRef;
+
 } //End of namespace GRT
 
 #endif // GRT_LABELLED_CLASSIFICATION_SAMPLE_HEADER
@@ -324,7 +324,7 @@ bool LabelledRegressionData::merge(const LabelledRegressionData &regressionData)
     return true;
 }
 
-bool LabelledRegressionData::spiltDataIntoKFolds(const UINT K){
+bool LabelledRegressionData::spiltDataIntoKFolds(const UINT K,const unsigned long long randomSeed){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -352,7 +352,7 @@ bool LabelledRegressionData::spiltDataIntoKFolds(const UINT K){
     crossValidationIndexs.resize(K);
 
     //Create the random partion indexs
-    Random random;
+    Random random( randomSeed );
     UINT randomIndex = 0;
 
     //Randomize the order of the data
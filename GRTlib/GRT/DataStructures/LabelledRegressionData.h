@@ -254,9 +254,10 @@ public:
      This function prepares the dataset for k-fold cross validation and should be called prior to calling the getTrainingFold(UINT foldIndex) or getTestingFold(UINT foldIndex) functions.  It will spilt the dataset into K-folds, as long as K < M, where M is the number of samples in the dataset.
      
      @param const UINT K: the number of folds the dataset will be split into, K should be less than the number of samples in the dataset
+     @param const unsigned long long randomSeed: the seed used to randomly assign the samples to the folds, if this is zero then the seed will be set using the current system time, default value is 0
 	 @return returns true if the dataset was split correctly, false otherwise
      */
-    bool spiltDataIntoKFolds(const UINT K);
+    bool spiltDataIntoKFolds(const UINT K,const unsigned long long randomSeed = 0);
     
     /**
      Returns the training dataset for the k-th fold for cross validation.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
@@ -669,7 +669,7 @@ bool LabelledTimeSeriesClassificationData::merge(const LabelledTimeSeriesClassif
     return true;
 }
 
-bool LabelledTimeSeriesClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling){
+bool LabelledTimeSeriesClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling,const unsigned long long randomSeed){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -707,7 +707,7 @@ bool LabelledTimeSeriesClassificationData::spiltDataIntoKFolds(const UINT K,cons
     crossValidationIndexs.resize( K );
 
     //Create the random partion indexs
-    Random random;
+    Random random( randomSeed );
     UINT randomIndex = 0;
 
     if( useStratifiedSampling ){
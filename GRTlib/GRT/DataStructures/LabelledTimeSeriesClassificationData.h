@@ -272,9 +272,10 @@ public:
      
 	 @param const UINT K: the number of folds the dataset will be split into, K should be less than the number of samples in the dataset
      @param const bool useStratifiedSampling: sets if the dataset should be broken into homogeneous groups first before randomly being spilt, default value is false
+     @param const unsigned long long randomSeed: the seed used to randomly assign the samples to the folds, if this is zero then the seed will be set using the current system time, default value is 0
 	 @return returns true if the dataset was split correctly, false otherwise
      */
-    bool spiltDataIntoKFolds(const UINT K, const bool useStratifiedSampling = false);
+    bool spiltDataIntoKFolds(const UINT K, const bool useStratifiedSampling = false, const unsigned long long randomSeed = 0);
     
     /**
      Returns the training dataset for the k-th fold for cross validation.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
@@ -127,10 +127,10 @@ bool FFT::loadSettingsFromFile(string filename){
     return true;
 }
 
-bool FFT::saveSettingsToFile(fstream &file) const{
+bool FFT::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -139,7 +139,7 @@ bool FFT::saveSettingsToFile(fstream &file) const{
     
     //Save the base settings to the file
     if( !saveBaseSettingsToFile( file ) ){
-        errorLog << "saveSettingsToFile(fstream &file) - Failed to save base feature extraction settings to file!" << endl;
+        errorLog << "saveSettingsToFile(ostream &file) - Failed to save base feature extraction settings to file!" << endl;
         return false;
     }
     
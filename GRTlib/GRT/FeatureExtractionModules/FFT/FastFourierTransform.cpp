@@ -116,10 +116,10 @@ bool FastFourierTransform::init(const unsigned int windowSize,const unsigned int
         return false;
     }
     
-    initFFT();
-    
     this->windowSize = windowSize;
     this->windowFunction = windowFunction;
+    
+    initFFT();
     this->computeMagnitude = computeMagnitude;
     this->computePhase = computePhase;
     
@@ -449,10 +449,14 @@ int FastFourierTransform::reverseBits(int index, int numBits)
 
 void FastFourierTransform::initFFT()
 {
-    bitTable.resize( MAX_FAST_BITS );
+    //Only build the tables the window size needs, building all MAX_FAST_BITS tables takes a few milliseconds and is done each time the
+    //FFT is copied
+    int numBits = isPowerOfTwo( windowSize ) ? numberOfBitsNeeded( windowSize ) : 0;
+    if( numBits > MAX_FAST_BITS ) numBits = MAX_FAST_BITS;
+    bitTable.resize( numBits );
     
     int len = 2;
-    for (int b = 1; b <= MAX_FAST_BITS; b++) {
+    for (int b = 1; b <= numBits; b++) {
         
         bitTable[b - 1].resize(len);
         
@@ -465,7 +469,7 @@ void FastFourierTransform::initFFT()
 
 inline int FastFourierTransform::fastReverseBits(const int i, const int numBits)
 {
-    if (numBits <= MAX_FAST_BITS)
+    if (numBits <= (int)bitTable.size())
         return bitTable[numBits - 1][i];
     else
         return reverseBits(i, numBits);
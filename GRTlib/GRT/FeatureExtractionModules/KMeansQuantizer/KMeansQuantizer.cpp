@@ -123,10 +123,10 @@ bool KMeansQuantizer::loadSettingsFromFile(string filename){
     return true;
 }
 
-bool KMeansQuantizer::saveSettingsToFile(fstream &file) const{
+bool KMeansQuantizer::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -135,7 +135,7 @@ bool KMeansQuantizer::saveSettingsToFile(fstream &file) const{
 	
     //Second, you should save the base feature extraction settings to the file
     if( !saveBaseSettingsToFile( file ) ){
-        errorLog << "saveSettingsToFile(fstream &file) - Failed to save base feature extraction settings to file!" << endl;
+        errorLog << "saveSettingsToFile(ostream &file) - Failed to save base feature extraction settings to file!" << endl;
         return false;
     }
     
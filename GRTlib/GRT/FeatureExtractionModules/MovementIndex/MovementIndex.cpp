@@ -132,10 +132,10 @@ bool MovementIndex::loadSettingsFromFile(string filename){
     return true;
 }
 
-bool MovementIndex::saveSettingsToFile(fstream &file) const{
+bool MovementIndex::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -144,7 +144,7 @@ bool MovementIndex::saveSettingsToFile(fstream &file) const{
     
     //Save the base settings to the file
     if( !saveBaseSettingsToFile( file ) ){
-        errorLog << "saveSettingsToFile(fstream &file) - Failed to save base feature extraction settings to file!" << endl;
+        errorLog << "saveSettingsToFile(ostream &file) - Failed to save base feature extraction settings to file!" << endl;
         return false;
     }
     
@@ -64,36 +64,49 @@ bool PrincipalComponentAnalysis::computeFeatureVector(const MatrixDouble &data,U
 bool PrincipalComponentAnalysis::computeFeatureVector_(const MatrixDouble &data,const UINT analysisMode){
 
     trained = false;
-    const UINT M = data.getNumRows();
     const UINT N = data.getNumCols();
     this->numInputDimensions = N;
 
-    MatrixDouble msData( M, N );
-
-    //Compute the mean and standard deviation of the input data
-    mean = data.getMean();
-    stdDev = data.getStdDev();
+    //Compute the mean, standard deviation and covariance matrix of the input data in a single pass
+    RunningStatistics stats( N, true );
+    if( !stats.update( data ) ){
+        errorLog << "computeFeatureVector(const MatrixDouble &data,UINT analysisMode) - Failed to compute the statistics of the input data!" << endl;
+        return false;
+    }
+    mean = stats.getMean();
+    stdDev = stats.getStdDev();
+    MatrixDouble cov = stats.getCovarianceMatrix();
 
+    //The covariance of the normalized data is the covariance of the data scaled by the standard deviations
     if( normData ){
-        //Normalize the data
-        for(UINT i=0; i<M; i++)
-            for(UINT j=0; j<N; j++)
-                msData[i][j] = (data[i][j]-mean[j]) / stdDev[j];
-
-    }else{
-        //Mean Subtract Data
-        for(UINT i=0; i<M; i++)
-            for(UINT j=0; j<N; j++)
-                msData[i][j] = data[i][j] - mean[j];
+        for(UINT j=0; j<N; j++)
+            for(UINT k=0; k<N; k++)
+                cov[j][k] /= stdDev[j] * stdDev[k];
     }
 
-    //Get the covariance matrix
-    MatrixDouble cov = msData.getCovarianceMatrix();
-
-    //Use Eigen Value Decomposition to find eigenvectors of the covariance matrix
-    EigenvalueDecomposition eig;
+    //Use the symmetric eigen decomposition to find the eigenvectors of the covariance matrix, the eigenvalues come back in descending order
+    SymmetricEigenDecomposition eig;
+    double sum = 0;
+    bool decomposed = false;
+    if( useTruncatedSolver ){
+        //Only the leading components are computed, so the total variance is taken from the trace of the covariance matrix
+        for(UINT j=0; j<N; j++) sum += cov[j][j];
+
+        if( analysisMode == MAX_VARIANCE ){
+            //Keep doubling the number of components until they explain enough of the variance
+            UINT K = N < 8 ? N : 8;
+            while( true ){
+                if( !(decomposed = eig.decompose( cov, K )) ) break;
+                VectorDouble values = eig.getEigenvalues();
+                double explainedVariance = 0;
+                for(UINT k=0; k<K; k++) explainedVariance += values[k] > 0 ? values[k] : 0;
+                if( K == N || explainedVariance >= maxVariance * sum ) break;
+                K = K*2 < N ? K*2 : N;
+            }
+        }else decomposed = eig.decompose( cov, numPrincipalComponents > 0 ? numPrincipalComponents : 1 );
+    }else decomposed = eig.decompose( cov );
 
-    if( !eig.decompose( cov ) ){
+    if( !decomposed ){
         mean.clear();
         stdDev.clear();
         componentWeights.clear();
@@ -102,40 +115,20 @@ bool PrincipalComponentAnalysis::computeFeatureVector_(const MatrixDouble &data,
         errorLog << "computeFeatureVector(const MatrixDouble &data,UINT analysisMode) - Failed to decompose input matrix!" << endl;
         return false;
     }
-
-    //Get the eigenvectors and eigenvalues
+    VectorDouble eigenvalues = eig.getEigenvalues();
     eigenvectors = eig.getEigenvectors();
-    VectorDouble eigenvalues = eig.getRealEigenvalues();
 
-    //Any eigenvalues less than 0 are not worth anything so set to 0
-    for(UINT i=0; i<eigenvalues.size(); i++){
-        if( eigenvalues[i] < 0 )
-            eigenvalues[i] = 0;
-    }
-
-    //Sort the eigenvalues and compute the component weights
-    double sum = 0;
-    UINT componentIndex = 0;
-    sortedEigenvalues.clear();
-    componentWeights.resize(N,0);
-
-    while( true ){
-        double maxValue = 0;
-        UINT index = 0;
-        for(UINT i=0; i<eigenvalues.size(); i++){
-            if( eigenvalues[i] > maxValue ){
-                maxValue = eigenvalues[i];
-                index = i;
-            }
-        }
-        if( maxValue == 0 || componentIndex >= eigenvalues.size() ){
-            break;
-        }
-        sortedEigenvalues.push_back( IndexedDouble(index,maxValue) );
-        componentWeights[ componentIndex++ ] = eigenvalues[ index ];
-        sum += eigenvalues[ index ];
-        eigenvalues[ index ] = 0; //Set the maxValue to zero so it won't be used again
+    //Any eigenvalues less than 0 are not worth anything so set to 0, the rest are already sorted so become the component weights
+    const UINT numEigenvalues = (UINT)eigenvalues.size();
+    sortedEigenvalues.resize( numEigenvalues );
+    componentWeights.assign(N,0);
+    for(UINT k=0; k<numEigenvalues; k++){
+        if( eigenvalues[k] < 0 ) eigenvalues[k] = 0;
+        sortedEigenvalues[k] = IndexedDouble(k,eigenvalues[k]);
+        componentWeights[k] = eigenvalues[k];
+        if( !useTruncatedSolver ) sum += eigenvalues[k];
     }
+    if( sum <= 0 ) sum = 1;
 
     double cumulativeVariance = 0;
     switch( analysisMode ){
@@ -149,6 +142,10 @@ bool PrincipalComponentAnalysis::computeFeatureVector_(const MatrixDouble &data,
                     numPrincipalComponents = k+1;
                 }
             }
+            //Rounding can leave the sum of the computed weights just short of the maxVariance, in which case keep every computed component
+            if( numPrincipalComponents == 0 ){
+                numPrincipalComponents = numEigenvalues;
+            }
         break;
         case MAX_NUM_PCS:
             //Normalize the component weights and compute the maxVariance
@@ -183,7 +180,6 @@ bool PrincipalComponentAnalysis::project(const MatrixDouble &data,MatrixDouble &
 	}
 	
 	MatrixDouble msData( data );
-	prjData.resize(data.getNumRows(),numPrincipalComponents);
 	
     if( normData ){
         //Mean subtract the data
@@ -197,15 +193,20 @@ bool PrincipalComponentAnalysis::project(const MatrixDouble &data,MatrixDouble &
                 msData[i][j] -= mean[j];
     }
 	
-	//Projected Data
-	for(UINT row=0; row<msData.getNumRows(); row++){//For each row in the final data
+	//Gather the eigenvectors of the principal components into the columns of the projection matrix
+	MatrixDouble projection(numInputDimensions,numPrincipalComponents);
+	for(UINT j=0; j<numInputDimensions; j++){//For each feature
 		for(UINT i=0; i<numPrincipalComponents; i++){//For each PC
-         	prjData[row][i]=0;
-		 	for(UINT j=0; j<data.getNumCols(); j++)//For each feature
-			 	prjData[row][i] += msData[row][j] * eigenvectors[j][sortedEigenvalues[i].index];
+			projection[j][i] = eigenvectors[j][sortedEigenvalues[i].index];
 		}
 	}
 	
+	//Projected Data
+	if( !msData.multiple( projection, prjData ) ){
+        errorLog << "project(const MatrixDouble &data,MatrixDouble &prjData) - Failed to project the data!" << endl;
+		return false;
+	}
+	
 	return true;
 }
     
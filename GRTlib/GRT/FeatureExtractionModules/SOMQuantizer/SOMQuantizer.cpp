@@ -124,10 +124,10 @@ bool SOMQuantizer::loadSettingsFromFile(string filename){
     return true;
 }
 
-bool SOMQuantizer::saveSettingsToFile(fstream &file) const{
+bool SOMQuantizer::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -136,7 +136,7 @@ bool SOMQuantizer::saveSettingsToFile(fstream &file) const{
 	
     //Second, you should save the base feature extraction settings to the file
     if( !saveBaseSettingsToFile( file ) ){
-        errorLog << "saveSettingsToFile(fstream &file) - Failed to save base feature extraction settings to file!" << endl;
+        errorLog << "saveSettingsToFile(ostream &file) - Failed to save base feature extraction settings to file!" << endl;
         return false;
     }
     
@@ -146,7 +146,7 @@ bool SOMQuantizer::saveSettingsToFile(fstream &file) const{
     if( quantizerTrained ){
         file << "SOM: \n";
         if( !som.saveModelToFile( file ) ){
-            errorLog << "saveSettingsToFile(fstream &file) - Failed to save SelfOrganizingMap settings to file!" << endl;
+            errorLog << "saveSettingsToFile(ostream &file) - Failed to save SelfOrganizingMap settings to file!" << endl;
             return false;
         }
     }
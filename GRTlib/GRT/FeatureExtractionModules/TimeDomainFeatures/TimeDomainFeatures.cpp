@@ -138,10 +138,10 @@ bool TimeDomainFeatures::loadSettingsFromFile(string filename){
     return true;
 }
 
-bool TimeDomainFeatures::saveSettingsToFile(fstream &file) const{
+bool TimeDomainFeatures::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -150,7 +150,7 @@ bool TimeDomainFeatures::saveSettingsToFile(fstream &file) const{
     
     //Save the base settings to the file
     if( !saveBaseSettingsToFile( file ) ){
-        errorLog << "saveSettingsToFile(fstream &file) - Failed to save base feature extraction settings to file!" << endl;
+        errorLog << "saveSettingsToFile(ostream &file) - Failed to save base feature extraction settings to file!" << endl;
         return false;
     }
     
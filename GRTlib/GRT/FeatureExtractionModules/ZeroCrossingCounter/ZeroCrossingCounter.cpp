@@ -134,10 +134,10 @@ bool ZeroCrossingCounter::loadSettingsFromFile(string filename){
     return true;
 }
 
-bool ZeroCrossingCounter::saveSettingsToFile(fstream &file){
+bool ZeroCrossingCounter::saveSettingsToFile(ostream &file){
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -146,7 +146,7 @@ bool ZeroCrossingCounter::saveSettingsToFile(fstream &file){
     
     //Save the base settings to the file
     if( !saveBaseSettingsToFile( file ) ){
-        errorLog << "saveSettingsToFile(fstream &file) - Failed to save base feature extraction settings to file!" << endl;
+        errorLog << "saveSettingsToFile(ostream &file) - Failed to save base feature extraction settings to file!" << endl;
         return false;
     }
     
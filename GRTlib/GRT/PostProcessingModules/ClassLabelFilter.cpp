@@ -160,8 +160,11 @@ UINT ClassLabelFilter::filter(UINT predictedClassLabel){
     //Add the current predictedClassLabel to the buffer
     buffer.push_back( predictedClassLabel );
     
-    //Count the class values in the buffer, automatically start with the first value in the buffer
-    vector< ClassTracker > classTracker( 1, ClassTracker( buffer[0], 1 ) );
+    //Count the class values in the buffer, automatically start with the first value in the buffer. The buffer can not hold more classes
+    //than bufferSize, so the tracker is only allocated on the first call
+    classTracker.reserve( bufferSize );
+    classTracker.clear();
+    classTracker.push_back( ClassTracker( buffer[0], 1 ) );
     
     UINT maxCount = classTracker[0].counter;
     UINT maxClass = classTracker[0].classLabel;
@@ -86,7 +86,14 @@ bool DeadZone::process(const VectorDouble &inputVector){
     }
 #endif
     
-    filter( inputVector );
+    for(UINT n=0; n<numInputDimensions; n++){
+        if( inputVector[n] > lowerLimit && inputVector[n] < upperLimit ){
+            processedData[n] = 0;
+        }else{
+            if( inputVector[n] >= upperLimit ) processedData[n] = inputVector[n] - upperLimit;
+            else processedData[n] = inputVector[n] - lowerLimit;
+        }
+    }
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -116,10 +123,10 @@ bool DeadZone::saveSettingsToFile(string filename) const{
 	return true;
 }
 
-bool DeadZone::saveSettingsToFile(fstream &file) const{
+bool DeadZone::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -236,26 +243,9 @@ double DeadZone::filter(const double x){
     
 VectorDouble DeadZone::filter(const VectorDouble &x){
     
-#ifdef GRT_SAFE_CHECKING
-    if( !initialized ){
-        errorLog << "filter(const VectorDouble &x) - Not Initialized!" << endl;
-        return vector<double>();
-    }
+    //Run the filter, the result is stored in processedData
+    if( !process( x ) ) return vector<double>();
     
-    if( x.size() != numInputDimensions ){
-        errorLog << "filter(const VectorDouble &x) - The Number Of Input Dimensions (" << numInputDimensions << ") does not match the size of the input vector (" << x.size() << ")!" << endl;
-        return vector<double>();
-    }
-#endif
-    
-    for(UINT n=0; n<numInputDimensions; n++){
-        if( x[n] > lowerLimit && x[n] < upperLimit ){
-            processedData[n] = 0;
-        }else{
-            if( x[n] >= upperLimit ) processedData[n] = x[n] - upperLimit;
-            else processedData[n] = x[n] - lowerLimit;
-        }
-    }
     return processedData;
 }
 
@@ -104,7 +104,25 @@ bool Derivative::process(const VectorDouble &inputVector){
     }
 #endif
     
-    computeDerivative( inputVector );
+    //Smooth the input if needed
+    if( filterData ){
+        if( !filter.process( inputVector ) ) return false;
+    }
+    const VectorDouble &y = filterData ? filter.getProcessedData() : inputVector;
+    
+    for(UINT n=0; n<numInputDimensions; n++){
+        processedData[n] = (y[n]-yy[n])/delta;
+        yy[n] = y[n];
+    }
+    
+    if( derivativeOrder == SECOND_DERIVATIVE ){
+        double tmp = 0;
+        for(UINT n=0; n<numInputDimensions; n++){
+            tmp = processedData[n];
+            processedData[n] = (processedData[n]-yyy[n])/delta;
+            yyy[n] = tmp;
+        }
+    }
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -135,10 +153,10 @@ bool Derivative::saveSettingsToFile(string filename) const{
     return true;
 }
 
-bool Derivative::saveSettingsToFile(fstream &file) const{
+bool Derivative::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -300,35 +318,8 @@ double Derivative::computeDerivative(const double x){
     
 VectorDouble Derivative::computeDerivative(const VectorDouble &x){
     
-#ifdef GRT_SAFE_CHECKING
-    if( !initialized ){
-        errorLog << "computeDerivative(const VectorDouble &x) - Not Initialized!" << endl;
-        return vector<double>();
-    }
-    
-    if( x.size() != numInputDimensions ){
-        errorLog << "computeDerivative(const VectorDouble &x) - The Number Of Input Dimensions (" << numInputDimensions << ") does not match the size of the input vector (" << x.size() << ")!" << endl;
-        return vector<double>();
-    }
-#endif
-    VectorDouble y;
-    if( filterData ){
-        y = filter.filter( x );
-    }else y = x;
-    
-    for(UINT n=0; n<numInputDimensions; n++){
-        processedData[n] = (y[n]-yy[n])/delta;
-        yy[n] = y[n];
-    }
-    
-    if( derivativeOrder == SECOND_DERIVATIVE ){
-        double tmp = 0;
-        for(UINT n=0; n<numInputDimensions; n++){
-            tmp = processedData[n];
-            processedData[n] = (processedData[n]-yyy[n])/delta;
-            yyy[n] = tmp;
-        }
-    }
+    //Run the derivative, the result is stored in processedData
+    if( !process( x ) ) return vector<double>();
     
     return processedData;
 }
@@ -104,7 +104,23 @@ bool DoubleMovingAverageFilter::process(const VectorDouble &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
+    //Perform the first filter
+    if( !filter1.process( inputVector ) ) return false;
+    
+    const VectorDouble &y = filter1.getProcessedData();
+    
+    //Perform the second filter, if this fails then the output of the first filter is used
+    if( !filter2.process( y ) ){
+        processedData = y;
+        return true;
+    }
+    
+    const VectorDouble &yy = filter2.getProcessedData();
+    
+    //Account for the filter lag
+    for(UINT i=0; i<y.size(); i++){
+        processedData[i] = y[i] + (y[i] - yy[i]);
+    }
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -114,6 +130,27 @@ bool DoubleMovingAverageFilter::reset(){
     if( initialized ) return init(filterSize,numInputDimensions);
     return false;
 }
+
+bool DoubleMovingAverageFilter::getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const{
+    
+    if( !initialized ){
+        return false;
+    }
+    
+    //y = MA(x) + (MA(x) - MA(MA(x))), so b = 2h - h*h, where h is the moving average of size filterSize
+    const double h = 1.0/filterSize;
+    numerator.clear();
+    numerator.resize(filterSize*2-1,0);
+    for(UINT i=0; i<numerator.size(); i++){
+        const UINT overlap = i < filterSize ? i+1 : filterSize*2-1-i;
+        numerator[i] = -h*h*overlap;
+        if( i < filterSize ) numerator[i] += 2*h;
+    }
+    denominator.clear();
+    denominator.resize(1,1);
+    
+    return true;
+}
     
 bool DoubleMovingAverageFilter::saveSettingsToFile(string filename) const{
     
@@ -135,10 +172,10 @@ bool DoubleMovingAverageFilter::saveSettingsToFile(string filename) const{
     return true;
 }
     
-bool DoubleMovingAverageFilter::saveSettingsToFile(fstream &file) const{
+bool DoubleMovingAverageFilter::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -268,36 +305,10 @@ double DoubleMovingAverageFilter::filter(const double x){
     
 vector< double > DoubleMovingAverageFilter::filter(const VectorDouble &x){
     
-#ifdef GRT_SAFE_CHECKING
-    //If the filter has not been initialised then return 0, otherwise filter x and return y
-    if( !initialized ){
-        errorLog << "filter(const VectorDouble &x) - The filter has not been initialized!" << endl;
-        return VectorDouble();
-    }
-    
-    if( x.size() != numInputDimensions ){
-        errorLog << "filter(const VectorDouble &x) - The size of the input vector (" << x.size() << ") does not match that of the number of dimensions of the filter (" << numInputDimensions << ")!" << endl;
-        return VectorDouble();
-    }
-#endif
-    
-    //Perform the first filter
-    VectorDouble y = filter1.filter( x );
-    
-    if( y.size() == 0 ) return y;
-    
-    //Perform the second filter
-    VectorDouble yy = filter2.filter( y );
-    
-    if( yy.size() == 0 ) return y;
-    
-    //Account for the filter lag
-    for(UINT i=0; i<y.size(); i++){
-        yy[i] = y[i] + (y[i] - yy[i]); 
-        processedData[i] = yy[i];
-    }
+    //Run the filter, the result is stored in processedData
+    if( !process( x ) ) return VectorDouble();
     
-    return yy;
+    return processedData;
 }
 
 }//End of namespace GRT
\ No newline at end of file
@@ -117,8 +117,19 @@ bool FIRFilter::process(const VectorDouble &inputVector){
         return false;
     }
     
-    //Run the filter
-    filter( inputVector );
+    //Add the new sample to the buffer
+    y.push_back( inputVector );
+    
+    const UINT K = numTaps-1;
+    
+    //Run the filter for each input dimension
+    for(UINT n=0; n<numInputDimensions; n++){
+        processedData[n] = 0;
+        for(UINT i=0; i<numTaps; i++){
+            processedData[n] += y[K-i][n] * z[i];
+        }
+        processedData[n] *= gain;
+    }
     
     //Check to ensure the size of the filter results match the number of dimensions
     if( processedData.size() == numOutputDimensions ) return true;
@@ -135,13 +146,29 @@ bool FIRFilter::reset(){
         //Set the data history buffer to zero
         for(UINT n=0; n<numInputDimensions; n++){
             for(UINT i=0; i<numTaps; i++){
-                y[n][i] = 0;
+                y[i][n] = 0;
             }
         }
     }
     
     return true;
 }
+
+bool FIRFilter::getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const{
+    
+    if( !initialized ){
+        return false;
+    }
+    
+    numerator.resize(numTaps);
+    for(UINT i=0; i<numTaps; i++){
+        numerator[i] = z[i]*gain;
+    }
+    denominator.clear();
+    denominator.resize(1,1);
+    
+    return true;
+}
     
 bool FIRFilter::clear(){
     
@@ -169,10 +196,10 @@ bool FIRFilter::saveSettingsToFile(string filename) const{
     return true;
 }
 
-bool FIRFilter::saveSettingsToFile(fstream &file) const{
+bool FIRFilter::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -181,7 +208,7 @@ bool FIRFilter::saveSettingsToFile(fstream &file) const{
     
     //Save the preprocessing base variables
     if( !savePreProcessingSettingsToFile( file ) ){
-        errorLog << "saveSettingsToFile(fstream &file) - Failed to save base settings to file!" << endl;
+        errorLog << "saveSettingsToFile(ostream &file) - Failed to save base settings to file!" << endl;
         return false;
     }
     
@@ -423,29 +450,8 @@ double FIRFilter::filter(const double x){
     
 VectorDouble FIRFilter::filter(const VectorDouble &x){
     
-    if( !initialized ){
-        errorLog << "filter(const VectorDouble &x) - Not Initialized!" << endl;
-        return VectorDouble();
-    }
-    
-    if( x.size() != numInputDimensions ){
-        errorLog << "filter(const VectorDouble &x) - The Number Of Input Dimensions (" << numInputDimensions << ") does not match the size of the input vector (" << x.size() << ")!" << endl;
-        return VectorDouble();
-    }
-    
-    //Add the new sample to the buffer
-    y.push_back( x );
-    
-    const UINT K = numTaps-1;
-    
-    //Run the filter for each input dimension
-    for(UINT n=0; n<numInputDimensions; n++){
-        processedData[n] = 0;
-        for(UINT i=0; i<numTaps; i++){
-            processedData[n] += y[K-i][n] * z[i];
-        }
-        processedData[n] *= gain;
-    }
+    //Run the filter, the result is stored in processedData
+    if( !process( x ) ) return VectorDouble();
     
     return processedData;
 }
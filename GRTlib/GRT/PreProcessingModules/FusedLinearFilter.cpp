@@ -0,0 +1,499 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "FusedLinearFilter.h"
+
+namespace GRT{
+
+//Register the FusedLinearFilter module with the PreProcessing base class
+RegisterPreProcessingModule< FusedLinearFilter > FusedLinearFilter::registerModule("FusedLinearFilter");
+
+//Returns the coefficients of the product of the two polynomials a and b
+static VectorDouble multiplyPolynomials(const VectorDouble &a,const VectorDouble &b){
+    VectorDouble c(a.size()+b.size()-1,0);
+    for(UINT i=0; i<a.size(); i++){
+        for(UINT j=0; j<b.size(); j++){
+            c[i+j] += a[i] * b[j];
+        }
+    }
+    return c;
+}
+
+FusedLinearFilter::FusedLinearFilter(){
+    preProcessingType = "FusedLinearFilter";
+    debugLog.setProceedingText("[DEBUG FusedLinearFilter]");
+    errorLog.setProceedingText("[ERROR FusedLinearFilter]");
+    warningLog.setProceedingText("[WARNING FusedLinearFilter]");
+
+    initialized = false;
+    numFusedModules = 0;
+}
+
+FusedLinearFilter::FusedLinearFilter(const FusedLinearFilter &rhs){
+    preProcessingType = "FusedLinearFilter";
+    debugLog.setProceedingText("[DEBUG FusedLinearFilter]");
+    errorLog.setProceedingText("[ERROR FusedLinearFilter]");
+    warningLog.setProceedingText("[WARNING FusedLinearFilter]");
+
+    *this = rhs;
+}
+
+FusedLinearFilter::~FusedLinearFilter(){
+
+}
+
+FusedLinearFilter& FusedLinearFilter::operator=(const FusedLinearFilter &rhs){
+	if(this!=&rhs){
+        this->numFusedModules = rhs.numFusedModules;
+        this->numerator = rhs.numerator;
+        this->denominator = rhs.denominator;
+        this->state = rhs.state;
+
+        copyBaseVariables( (PreProcessing*)&rhs );
+	}
+	return *this;
+}
+
+bool FusedLinearFilter::deepCopyFrom(const PreProcessing *preProcessing){
+
+    if( preProcessing == NULL ) return false;
+
+    if( this->getPreProcessingType() == preProcessing->getPreProcessingType() ){
+
+        //Call the equals operator
+        *this = *(FusedLinearFilter*)preProcessing;
+
+        return true;
+    }
+
+    errorLog << "deepCopyFrom(const PreProcessing *preProcessing) -  PreProcessing Types Do Not Match!" << endl;
+
+    return false;
+}
+
+bool FusedLinearFilter::process(const VectorDouble &inputVector){
+
+    if( !initialized ){
+        errorLog << "process(const VectorDouble &inputVector) - Not initialized!" << endl;
+        return false;
+    }
+
+    if( inputVector.size() != numInputDimensions ){
+        errorLog << "process(const VectorDouble &inputVector) - The size of the inputVector (" << inputVector.size() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+
+    filterSample( &inputVector[0], &processedData[0] );
+
+    return true;
+}
+
+bool FusedLinearFilter::processBatch(const MatrixDouble &inputData,MatrixDouble &outputData){
+
+    if( !initialized ){
+        errorLog << "processBatch(const MatrixDouble &inputData,MatrixDouble &outputData) - Not initialized!" << endl;
+        return false;
+    }
+
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << "processBatch(const MatrixDouble &inputData,MatrixDouble &outputData) - The number of columns in the inputData (" << inputData.getNumCols() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+
+    const UINT M = inputData.getNumRows();
+    if( !outputData.resize( M, numOutputDimensions ) ){
+        errorLog << "processBatch(const MatrixDouble &inputData,MatrixDouble &outputData) - Failed to resize the outputData!" << endl;
+        return false;
+    }
+
+    for(UINT i=0; i<M; i++){
+        filterSample( inputData[i], outputData[i] );
+    }
+
+    //Keep the last output in processedData, to match calling process on each sample
+    if( M > 0 ){
+        for(UINT n=0; n<numOutputDimensions; n++){
+            processedData[n] = outputData[M-1][n];
+        }
+    }
+
+    return true;
+}
+
+void FusedLinearFilter::filterSample(const double *x,double *y){
+
+    //Transposed direct form II: y = b[0]x + s[0], s[i] = b[i+1]x - a[i+1]y + s[i+1].  Each delay is a row of the state, so the inner
+    //loops run over the dimensions and can be vectorized
+    const UINT N = numInputDimensions;
+    const UINT order = getOrder();
+    const double b0 = numerator[0];
+
+    if( order == 0 ){
+        for(UINT n=0; n<N; n++){
+            y[n] = b0 * x[n];
+        }
+        return;
+    }
+
+    const double *s0 = state[0];
+    for(UINT n=0; n<N; n++){
+        y[n] = b0 * x[n] + s0[n];
+    }
+
+    for(UINT i=0; i<order; i++){
+        double *s = state[i];
+        const double b = numerator[i+1];
+        const double a = denominator[i+1];
+        if( i+1 < order ){
+            const double *next = state[i+1];
+            if( a == 0 ){
+                for(UINT n=0; n<N; n++){
+                    s[n] = b * x[n] + next[n];
+                }
+            }else{
+                for(UINT n=0; n<N; n++){
+                    s[n] = b * x[n] - a * y[n] + next[n];
+                }
+            }
+        }else{
+            for(UINT n=0; n<N; n++){
+                s[n] = b * x[n] - a * y[n];
+            }
+        }
+    }
+}
+
+bool FusedLinearFilter::reset(){
+
+    //Reset the base class
+    PreProcessing::reset();
+
+    if( initialized ){
+        state.setAllValues( 0 );
+        return true;
+    }
+
+    return false;
+}
+
+bool FusedLinearFilter::clear(){
+
+    //Clear the base class
+    PreProcessing::clear();
+
+    numFusedModules = 0;
+    numerator.clear();
+    denominator.clear();
+    state.clear();
+
+    return true;
+}
+
+bool FusedLinearFilter::getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const{
+
+    if( !initialized ){
+        return false;
+    }
+
+    numerator = this->numerator;
+    denominator = this->denominator;
+
+    return true;
+}
+
+bool FusedLinearFilter::saveSettingsToFile(string filename) const{
+
+    std::fstream file;
+    file.open(filename.c_str(), std::ios::out);
+
+    if( !saveSettingsToFile( file ) ){
+        file.close();
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+bool FusedLinearFilter::saveSettingsToFile(ostream &file) const{
+
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
+        return false;
+    }
+
+    if( !initialized ){
+        errorLog << "saveSettingsToFile(ostream &file) - The FusedLinearFilter has not been initialized" << endl;
+        return false;
+    }
+
+    file << "GRT_FUSED_LINEAR_FILTER_FILE_V1.0" << endl;
+
+    file << "NumInputDimensions: " << numInputDimensions << endl;
+    file << "NumOutputDimensions: " << numOutputDimensions << endl;
+    file << "NumFusedModules: " << numFusedModules << endl;
+    file << "Order: " << getOrder() << endl;
+
+    //The coefficients of a fused filter can be sensitive to rounding, so write them at full precision
+    const std::streamsize precision = file.precision( 17 );
+
+    file << "Numerator: ";
+    for(UINT i=0; i<numerator.size(); i++){
+        file << numerator[i] << " ";
+    }
+    file << endl;
+
+    file << "Denominator: ";
+    for(UINT i=0; i<denominator.size(); i++){
+        file << denominator[i] << " ";
+    }
+    file << endl;
+
+    file.precision( precision );
+
+    return true;
+}
+
+bool FusedLinearFilter::loadSettingsFromFile(string filename){
+
+    std::fstream file;
+    file.open(filename.c_str(), std::ios::in);
+
+    if( !loadSettingsFromFile( file ) ){
+        file.close();
+        initialized = false;
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+bool FusedLinearFilter::loadSettingsFromFile(fstream &file){
+
+    //Clear the filter
+    clear();
+
+    if( !file.is_open() ){
+        errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
+        return false;
+    }
+
+    string word;
+
+    //Load the header
+    file >> word;
+
+    if( word != "GRT_FUSED_LINEAR_FILTER_FILE_V1.0" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
+        clear();
+        return false;
+    }
+
+    //Load the number of input dimensions
+    file >> word;
+    if( word != "NumInputDimensions:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
+        clear();
+        return false;
+    }
+    UINT numDimensions = 0;
+    file >> numDimensions;
+
+    //Load the number of output dimensions, this always matches the number of input dimensions
+    file >> word;
+    if( word != "NumOutputDimensions:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
+        clear();
+        return false;
+    }
+    file >> word;
+
+    //Load the number of fused modules
+    file >> word;
+    if( word != "NumFusedModules:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumFusedModules header!" << endl;
+        clear();
+        return false;
+    }
+    UINT numModules = 0;
+    file >> numModules;
+
+    //Load the order
+    file >> word;
+    if( word != "Order:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to read Order header!" << endl;
+        clear();
+        return false;
+    }
+    UINT order = 0;
+    file >> order;
+
+    VectorDouble b(order+1);
+    VectorDouble a(order+1);
+
+    //Load the numerator
+    file >> word;
+    if( word != "Numerator:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to read Numerator header!" << endl;
+        clear();
+        return false;
+    }
+    for(UINT i=0; i<=order; i++){
+        file >> b[i];
+    }
+
+    //Load the denominator
+    file >> word;
+    if( word != "Denominator:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to read Denominator header!" << endl;
+        clear();
+        return false;
+    }
+    for(UINT i=0; i<=order; i++){
+        file >> a[i];
+    }
+
+    //Init the filter module to ensure everything is initialized correctly
+    if( !init( b, a, numDimensions ) ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to init the filter!" << endl;
+        clear();
+        return false;
+    }
+    numFusedModules = numModules;
+
+    return true;
+}
+
+bool FusedLinearFilter::init(const VectorDouble &numerator,const VectorDouble &denominator,const UINT numDimensions){
+
+    initialized = false;
+
+    if( numDimensions == 0 ){
+        errorLog << "init(const VectorDouble &numerator,const VectorDouble &denominator,const UINT numDimensions) - NumDimensions must be greater than 0!" << endl;
+        return false;
+    }
+
+    if( numerator.size() == 0 || denominator.size() == 0 ){
+        errorLog << "init(const VectorDouble &numerator,const VectorDouble &denominator,const UINT numDimensions) - The numerator and denominator must not be empty!" << endl;
+        return false;
+    }
+
+    if( denominator[0] == 0 ){
+        errorLog << "init(const VectorDouble &numerator,const VectorDouble &denominator,const UINT numDimensions) - The first denominator coefficient must not be zero!" << endl;
+        return false;
+    }
+
+    //Normalize the coefficients by a[0] and pad them to the same length
+    const UINT length = (UINT)std::max( numerator.size(), denominator.size() );
+    this->numerator.clear();
+    this->numerator.resize( length, 0 );
+    this->denominator.clear();
+    this->denominator.resize( length, 0 );
+    for(UINT i=0; i<numerator.size(); i++){
+        this->numerator[i] = numerator[i] / denominator[0];
+    }
+    for(UINT i=0; i<denominator.size(); i++){
+        this->denominator[i] = denominator[i] / denominator[0];
+    }
+
+    numFusedModules = 1;
+    numInputDimensions = numDimensions;
+    numOutputDimensions = numDimensions;
+
+    //Setup the state, there is one row per delay
+    state.clear();
+    if( length > 1 ){
+        state.resize( length-1, numDimensions );
+        state.setAllValues( 0 );
+    }
+
+    //Initialize the base class
+    return PreProcessing::init();
+}
+
+bool FusedLinearFilter::fuse(const PreProcessing &preProcessingModule){
+
+    VectorDouble b, a;
+    if( !preProcessingModule.getTransferFunction( b, a ) ){
+        errorLog << "fuse(const PreProcessing &preProcessingModule) - The " << preProcessingModule.getPreProcessingType() << " module is not an initialized linear filter!" << endl;
+        return false;
+    }
+
+    if( !initialized ){
+        return init( b, a, preProcessingModule.getNumInputDimensions() );
+    }
+
+    if( preProcessingModule.getNumInputDimensions() != numInputDimensions ){
+        errorLog << "fuse(const PreProcessing &preProcessingModule) - The dimensionality of the module (" << preProcessingModule.getNumInputDimensions() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+
+    //The transfer function of the chain is the product of the transfer functions
+    const UINT numModules = numFusedModules;
+    if( !init( multiplyPolynomials( numerator, b ), multiplyPolynomials( denominator, a ), numInputDimensions ) ){
+        return false;
+    }
+    numFusedModules = numModules + 1;
+
+    return true;
+}
+
+double FusedLinearFilter::filter(const double x){
+
+    //If the filter has not been initialised then return 0, otherwise filter x and return y
+    if( !initialized ){
+        errorLog << "filter(const double x) - The filter has not been initialized!" << endl;
+        return 0;
+    }
+
+    VectorDouble y = filter( VectorDouble(1,x) );
+
+    if( y.size() == 0 ) return 0;
+    return y[0];
+}
+
+VectorDouble FusedLinearFilter::filter(const VectorDouble &x){
+
+    //Run the filter, the result is stored in processedData
+    if( !process( x ) ) return VectorDouble();
+
+    return processedData;
+}
+
+UINT FusedLinearFilter::getNumFusedModules() const{
+    return numFusedModules;
+}
+
+UINT FusedLinearFilter::getOrder() const{
+    return numerator.size() > 0 ? (UINT)numerator.size()-1 : 0;
+}
+
+VectorDouble FusedLinearFilter::getNumerator() const{
+    return numerator;
+}
+
+VectorDouble FusedLinearFilter::getDenominator() const{
+    return denominator;
+}
+
+}//End of namespace GRT
@@ -97,7 +97,16 @@ bool HighPassFilter::process(const vector< double > &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
+    for(UINT n=0; n<numInputDimensions; n++){
+        //Compute the new output
+        processedData[n] = filterFactor * (yy[n] + inputVector[n] - xx[n]) * gain;
+        
+        //Store the current input
+        xx[n] = inputVector[n];
+        
+        //Store the current output
+        yy[n] = processedData[n];
+    }
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -108,6 +117,22 @@ bool HighPassFilter::reset(){
     if( initialized ) return init(filterFactor,gain,numInputDimensions);
     return false;
 }
+
+bool HighPassFilter::getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const{
+    
+    if( !initialized ){
+        return false;
+    }
+    
+    numerator.resize(2);
+    numerator[0] = filterFactor*gain;
+    numerator[1] = -filterFactor*gain;
+    denominator.resize(2);
+    denominator[0] = 1;
+    denominator[1] = -filterFactor*gain;
+    
+    return true;
+}
     
 bool HighPassFilter::saveSettingsToFile(string filename) const{
     
@@ -129,10 +154,10 @@ bool HighPassFilter::saveSettingsToFile(string filename) const{
     return true;
 }
     
-bool HighPassFilter::saveSettingsToFile(fstream &file) const{
+bool HighPassFilter::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -270,28 +295,9 @@ double HighPassFilter::filter(const double x){
     
 VectorDouble HighPassFilter::filter(const VectorDouble &x){
     
-#ifdef GRT_SAFE_CHECKING
-    if( !initialized ){
-        errorLog << "filter(const VectorDouble &x) - Not Initialized!" << endl;
-        return VectorDouble();
-    }
-    
-    if( x.size() != numInputDimensions ){
-        errorLog << "filter(const VectorDouble &x) - The Number Of Input Dimensions (" << numInputDimensions << ") does not match the size of the input vector (" << x.size() << ")!" << endl;
-        return VectorDouble();
-    }
-#endif
+    //Run the filter, the result is stored in processedData
+    if( !process( x ) ) return VectorDouble();
     
-    for(UINT n=0; n<numInputDimensions; n++){
-        //Compute the new output
-        processedData[n] = filterFactor * (yy[n] + x[n] - xx[n]) * gain;
-        
-        //Store the current input
-        xx[n] = x[n];
-        
-        //Store the current output
-        yy[n] = processedData[n];
-    }
     return processedData;
 }
     
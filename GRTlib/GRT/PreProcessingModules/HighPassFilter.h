@@ -100,6 +100,16 @@ public:
      */
     virtual bool reset();
     
+    /**
+     Gets the transfer function of the HighPassFilter, y[n] = filterFactor*gain*(y[n-1] + x[n] - x[n-1]).
+     This overrides the getTransferFunction function in the PreProcessing base class.
+     
+     @param VectorDouble &numerator: will be set to the numerator coefficients of the transfer function
+     @param VectorDouble &denominator: will be set to the denominator coefficients of the transfer function
+     @return returns true if the filter has been initialized, false otherwise
+     */
+    virtual bool getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const;
+    
     /**
      This saves the current settings of the HighPassFilter to a file.
      This overrides the saveSettingsToFile function in the PreProcessing base class.
@@ -113,10 +123,10 @@ public:
      This saves the current settings of the HighPassFilter to a file.
      This overrides the saveSettingsToFile function in the PreProcessing base class.
      
-     @param fstream &file: a reference to the file the settings will be saved to
+     @param ostream &file: a reference to the file the settings will be saved to
      @return returns true if the settings were saved successfully, false otherwise
      */
-    virtual bool saveSettingsToFile(fstream &file) const;
+    virtual bool saveSettingsToFile(ostream &file) const;
     
     /**
      This loads the HighPassFilter settings from a file.
@@ -90,7 +90,10 @@ bool LowPassFilter::process(const VectorDouble &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
+    for(UINT n=0; n<numInputDimensions; n++){
+        processedData[n] = (inputVector[n] * filterFactor) + (yy[n] * (1.0 - filterFactor)) * gain;
+        yy[n] = processedData[n];
+    }
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -101,6 +104,21 @@ bool LowPassFilter::reset(){
     if( initialized ) return init(filterFactor,gain,numInputDimensions);
     return false;
 }
+
+bool LowPassFilter::getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const{
+    
+    if( !initialized ){
+        return false;
+    }
+    
+    numerator.resize(1);
+    numerator[0] = filterFactor;
+    denominator.resize(2);
+    denominator[0] = 1;
+    denominator[1] = -(1.0-filterFactor)*gain;
+    
+    return true;
+}
     
 bool LowPassFilter::saveSettingsToFile(string filename) const{
     
@@ -122,10 +140,10 @@ bool LowPassFilter::saveSettingsToFile(string filename) const{
     return true;
 }
 
-bool LowPassFilter::saveSettingsToFile(fstream &file) const{
+bool LowPassFilter::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -261,22 +279,9 @@ double LowPassFilter::filter(double x){
     
 VectorDouble LowPassFilter::filter(const VectorDouble &x){
     
-#ifdef GRT_SAFE_CHECKING
-    if( !initialized ){
-        errorLog << "filter(const VectorDouble &x) - Not Initialized!" << endl;
-        return VectorDouble();
-    }
+    //Run the filter, the result is stored in processedData
+    if( !process( x ) ) return VectorDouble();
     
-    if( x.size() != numInputDimensions ){
-        errorLog << "filter(const VectorDouble &x) - The Number Of Input Dimensions (" << numInputDimensions << ") does not match the size of the input vector (" << x.size() << ")!" << endl;
-        return VectorDouble();
-    }
-#endif
-    
-    for(UINT n=0; n<numInputDimensions; n++){
-        processedData[n] = (x[n] * filterFactor) + (yy[n] * (1.0 - filterFactor)) * gain;
-        yy[n] = processedData[n];
-    }
     return processedData;
 }
     
@@ -102,7 +102,18 @@ bool MovingAverageFilter::process(const VectorDouble &inputVector){
     }
 #endif
     
-    filter( inputVector );
+    if( ++inputSampleCounter > filterSize ) inputSampleCounter = filterSize;
+    
+    //Add the new value to the buffer
+    dataBuffer.push_back( inputVector );
+    
+    for(unsigned int j=0; j<numInputDimensions; j++){
+        processedData[j] = 0;
+        for(unsigned int i=0; i<inputSampleCounter; i++) {
+            processedData[j] += dataBuffer[i][j];
+        }
+        processedData[j] /= double(inputSampleCounter);
+    }
     
     if( processedData.size() == numOutputDimensions ) return true;
 
@@ -113,6 +124,20 @@ bool MovingAverageFilter::reset(){
     if( initialized ) return init(filterSize,numInputDimensions);
     return false;
 }
+
+bool MovingAverageFilter::getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const{
+    
+    if( !initialized ){
+        return false;
+    }
+    
+    numerator.clear();
+    numerator.resize(filterSize,1.0/filterSize);
+    denominator.clear();
+    denominator.resize(1,1);
+    
+    return true;
+}
     
 bool MovingAverageFilter::saveSettingsToFile(string filename) const{
     
@@ -134,10 +159,10 @@ bool MovingAverageFilter::saveSettingsToFile(string filename) const{
     return true;
 }
 
-bool MovingAverageFilter::saveSettingsToFile(fstream &file) const{
+bool MovingAverageFilter::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -260,31 +285,8 @@ double MovingAverageFilter::filter(const double x){
     
 VectorDouble MovingAverageFilter::filter(const VectorDouble &x){
     
-#ifdef GRT_SAFE_CHECKING
-    //If the filter has not been initialised then return 0, otherwise filter x and return y
-    if( !initialized ){
-        errorLog << "filter(const VectorDouble &x) - The filter has not been initialized!" << endl;
-        return VectorDouble();
-    }
-    
-    if( x.size() != numInputDimensions ){
-        errorLog << "filter(const VectorDouble &x) - The size of the input vector (" << x.size() << ") does not match that of the number of dimensions of the filter (" << numInputDimensions << ")!" << endl;
-        return VectorDouble();
-    }
-#endif
-    
-    if( ++inputSampleCounter > filterSize ) inputSampleCounter = filterSize;
-    
-    //Add the new value to the buffer
-    dataBuffer.push_back( x );
-    
-    for(unsigned int j=0; j<numInputDimensions; j++){
-        processedData[j] = 0;
-        for(unsigned int i=0; i<inputSampleCounter; i++) {
-            processedData[j] += dataBuffer[i][j];
-        }
-        processedData[j] /= double(inputSampleCounter);
-    }
+    //Run the filter, the result is stored in processedData
+    if( !process( x ) ) return VectorDouble();
     
     return processedData;
 }
@@ -94,6 +94,18 @@ public:
      */
     virtual bool reset();
     
+    /**
+     Gets the transfer function of the MovingAverageFilter, the average of the last filterSize inputs.
+     Until filterSize samples have been seen the filter averages over the samples it has seen so far, the transfer function instead
+     treats the missing samples as zeros, so the two only match after the first filterSize samples.
+     This overrides the getTransferFunction function in the PreProcessing base class.
+     
+     @param VectorDouble &numerator: will be set to the numerator coefficients of the transfer function
+     @param VectorDouble &denominator: will be set to the denominator coefficients of the transfer function
+     @return returns true if the filter has been initialized, false otherwise
+     */
+    virtual bool getTransferFunction(VectorDouble &numerator,VectorDouble &denominator) const;
+    
     /**
      This saves the current settings of the MovingAverageFilter to a file.
      This overrides the saveSettingsToFile function in the PreProcessing base class.
@@ -107,10 +119,10 @@ public:
      This saves the current settings of the MovingAverageFilter to a file.
      This overrides the saveSettingsToFile function in the PreProcessing base class.
      
-     @param fstream &file: a reference to the file the settings will be saved to
+     @param ostream &file: a reference to the file the settings will be saved to
      @return returns true if the settings were saved successfully, false otherwise
      */
-    virtual bool saveSettingsToFile(fstream &file) const;
+    virtual bool saveSettingsToFile(ostream &file) const;
     
     /**
      This loads the MovingAverageFilter settings from a file.
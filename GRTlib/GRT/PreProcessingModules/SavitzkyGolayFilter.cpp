@@ -105,7 +105,15 @@ bool SavitzkyGolayFilter::process(const VectorDouble &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
+    //Add the new input data to the data buffer
+    data.push_back( inputVector );
+    
+    //Filter the data
+    for(UINT j=0; j<inputVector.size(); j++){
+        processedData[j] = 0;
+        for(UINT i=0; i<numPoints; i++) 
+            processedData[j] += data[i][j] * coeff[i];
+    }
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -144,10 +152,10 @@ bool SavitzkyGolayFilter::saveSettingsToFile(string filename) const{
     return true;
 }
 
-bool SavitzkyGolayFilter::saveSettingsToFile(fstream &file) const{
+bool SavitzkyGolayFilter::saveSettingsToFile(ostream &file) const{
     
-    if( !file.is_open() ){
-        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+    if( !file.good() ){
+        errorLog << "saveSettingsToFile(ostream &file) - The file is not open!" << endl;
         return false;
     }
     
@@ -311,27 +319,8 @@ double SavitzkyGolayFilter::filter(const double x){
     
 VectorDouble SavitzkyGolayFilter::filter(const VectorDouble &x){
     
-#ifdef GRT_SAFE_CHECKING
-    if( !initialized ){
-        errorLog << "filter(const VectorDouble &x) - Not Initialized!" << endl;
-        return vector<double>();
-    }
-    
-    if( x.size() != numInputDimensions ){
-        errorLog << "filter(const VectorDouble &x) - The Number Of Input Dimensions (" << numInputDimensions << ") does not match the size of the input vector (" << x.size() << ")!" << endl;
-        return vector<double>();
-    }
-#endif
-    
-    //Add the new input data to the data buffer
-    data.push_back( x );
-    
-    //Filter the data
-    for(UINT j=0; j<x.size(); j++){
-        processedData[j] = 0;
-        for(UINT i=0; i<numPoints; i++) 
-            processedData[j] += data[i][j] * coeff[i];
-    }
+    //Run the filter, the result is stored in processedData
+    if( !process( x ) ) return vector<double>();
     
     return processedData;
 }
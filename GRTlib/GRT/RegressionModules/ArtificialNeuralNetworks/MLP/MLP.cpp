@@ -75,6 +75,9 @@ MLP& MLP::operator=(const MLP &rhs){
         this->inputLayer = rhs.inputLayer;
         this->hiddenLayer = rhs.hiddenLayer;
         this->outputLayer = rhs.outputLayer;
+        this->floatInputWeights = rhs.floatInputWeights;
+        this->floatHiddenWeights = rhs.floatHiddenWeights;
+        this->floatOutputWeights = rhs.floatOutputWeights;
         this->inputVectorRanges = rhs.inputVectorRanges;
         this->targetVectorRanges = rhs.targetVectorRanges;
         this->trainingErrorLog = rhs.trainingErrorLog;
@@ -146,6 +149,12 @@ bool MLP::train(LabelledRegressionData trainingData){
     
 //Classifier interface
 bool MLP::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool MLP::predictInplace(VectorDouble &inputVector){
+    
+    if( useFloatPrediction ) return predictAsFloat( inputVector );
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model not trained!" << endl;
@@ -158,46 +167,142 @@ bool MLP::predict(VectorDouble inputVector){
     }
     
     //Set the mapped data as the classLikelihoods
-    regressionData = feedforward( inputVector );
+    feedforwardInplace( inputVector );
+    regressionData = outputNeuronsOutput;
     
     if( classificationModeActive ){
-	
-		//Estimate the class likelihoods        
-        const UINT K = (UINT)regressionData.size();
-        classLikelihoods = regressionData;
-        
-        //Make sure all the values are greater than zero, we do this by finding the min value and adding this onto all the values
-        double minValue = Util::getMin( classLikelihoods );
+        predictFromRegressionData();
+    }
+    
+    return true;
+}
+
+bool MLP::predictFloatInplace(VectorFloat &inputVector){
+    
+    if( !trained ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - Model not trained!" << endl;
+        return false;
+    }
+    
+    if( inputVector.size() != numInputNeurons ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The size of the input vector (" << int(inputVector.size()) << ") does not match that of the number of input dimensions (" << numInputNeurons << ") " << endl;
+        return false;
+    }
+    
+    if( floatInputWeights.size() != numInputNeurons || floatOutputWeights.getNumRows() != numOutputNeurons ){
+        errorLog << "predictFloatInplace(VectorFloat &inputVector) - The float model has not been built, float prediction must be enabled first!" << endl;
+        return false;
+    }
+    
+    floatInputOutput.resize( numInputNeurons );
+    floatHiddenOutput.resize( numHiddenNeurons );
+    floatOutputSums.resize( numOutputNeurons );
+    regressionData.resize( numOutputNeurons );
+    
+	//Scale the input vector if required
+	if( useScaling ){
+		for(UINT i=0; i<numInputNeurons; i++){
+			inputVector[i] = float( scale(inputVector[i],inputVectorRanges[i].minValue,inputVectorRanges[i].maxValue,0.0,1.0) );
+		}
+	}
+    
+    //Input layer
+    for(UINT i=0; i<numInputNeurons; i++){
+        floatInputOutput[i] = float( inputLayer[i].activate( inputLayer[i].bias + inputVector[i] * floatInputWeights[i] ) );
+    }
+    
+    //Hidden Layer
+    MatrixKernels::gemv( floatHiddenWeights[0], floatHiddenWeights.getStride(), &floatInputOutput[0], &floatHiddenOutput[0], numHiddenNeurons, numInputNeurons );
+    for(UINT i=0; i<numHiddenNeurons; i++){
+        floatHiddenOutput[i] = float( hiddenLayer[i].activate( hiddenLayer[i].bias + floatHiddenOutput[i] ) );
+    }
+    
+    //Output Layer
+    MatrixKernels::gemv( floatOutputWeights[0], floatOutputWeights.getStride(), &floatHiddenOutput[0], &floatOutputSums[0], numOutputNeurons, numHiddenNeurons );
+    for(UINT i=0; i<numOutputNeurons; i++){
+        regressionData[i] = outputLayer[i].activate( outputLayer[i].bias + floatOutputSums[i] );
+    }
+    
+	//Scale the output vector if required
+	if( useScaling ){
+		for(UINT i=0; i<numOutputNeurons; i++){
+			regressionData[i] = scale(regressionData[i],0.0,1.0,targetVectorRanges[i].minValue,targetVectorRanges[i].maxValue);
+		}
+	}
+    
+    if( classificationModeActive ){
+        predictFromRegressionData();
+    }
+    
+    return true;
+}
+
+void MLP::predictFromRegressionData(){
+    
+    //Estimate the class likelihoods        
+    const UINT K = (UINT)regressionData.size();
+    classLikelihoods = regressionData;
+    
+    //Make sure all the values are greater than zero, we do this by finding the min value and subtracting this from all the values.
+    //Adding a negative min value could leave the sum close to zero (or negative), which made the likelihoods unstable
+    double minValue = Util::getMin( classLikelihoods );
+    for(UINT i=0; i<K; i++){
+        classLikelihoods[i] -= minValue;
+    }
+    
+    //Normalize the likelihoods so they sum to 1
+    double sum = Util::sum(classLikelihoods);
+    if( sum > 0 ){
         for(UINT i=0; i<K; i++){
-            classLikelihoods[i] += minValue;
+            classLikelihoods[i] /= sum;
         }
-        
-        //Normalize the likelihoods so they sum to 1
-        double sum = Util::sum(classLikelihoods);
-        if( sum > 0 ){
-            for(UINT i=0; i<K; i++){
-                classLikelihoods[i] /= sum;
-            }
+    }
+    
+    //Find the best value
+    double bestValue = classLikelihoods[0];
+    UINT bestIndex = 0;
+    for(UINT i=1; i<K; i++){
+        if( classLikelihoods[i] > bestValue ){
+            bestValue = classLikelihoods[i];
+            bestIndex = i;
         }
-        
-        //Find the best value
-        double bestValue = classLikelihoods[0];
-        UINT bestIndex = 0;
-        for(UINT i=1; i<K; i++){
-            if( classLikelihoods[i] > bestValue ){
-                bestValue = classLikelihoods[i];
-                bestIndex = i;
-            }
+    }
+    
+    //Set the maximum likelihood and predicted class label
+    maxLikelihood = bestValue;
+    predictedClassLabel = bestIndex+1;
+    
+    if( useNullRejection ){
+        if( maxLikelihood < nullRejectionCoeff ){
+            predictedClassLabel = 0;
         }
-        
-        //Set the maximum likelihood and predicted class label
-        maxLikelihood = bestValue;
-        predictedClassLabel = bestIndex+1;
-        
-        if( useNullRejection ){
-            if( maxLikelihood < nullRejectionCoeff ){
-                predictedClassLabel = 0;
-            }
+    }
+}
+
+bool MLP::buildFloatModel(){
+    
+    if( inputLayer.size() != numInputNeurons || hiddenLayer.size() != numHiddenNeurons || outputLayer.size() != numOutputNeurons ) return false;
+    if( numInputNeurons == 0 || numHiddenNeurons == 0 || numOutputNeurons == 0 ) return false;
+    
+    floatInputWeights.resize( numInputNeurons );
+    for(UINT i=0; i<numInputNeurons; i++){
+        if( inputLayer[i].weights.size() != 1 ) return false;
+        floatInputWeights[i] = float( inputLayer[i].weights[0] );
+    }
+    
+    floatHiddenWeights.resize( numHiddenNeurons, numInputNeurons );
+    for(UINT i=0; i<numHiddenNeurons; i++){
+        if( hiddenLayer[i].weights.size() != numInputNeurons ) return false;
+        for(UINT j=0; j<numInputNeurons; j++){
+            floatHiddenWeights[i][j] = float( hiddenLayer[i].weights[j] );
+        }
+    }
+    
+    floatOutputWeights.resize( numOutputNeurons, numHiddenNeurons );
+    for(UINT i=0; i<numOutputNeurons; i++){
+        if( outputLayer[i].weights.size() != numHiddenNeurons ) return false;
+        for(UINT j=0; j<numHiddenNeurons; j++){
+            floatOutputWeights[i][j] = float( outputLayer[i].weights[j] );
         }
     }
     
@@ -288,6 +393,9 @@ bool MLP::clear(){
     inputLayer.clear();
     hiddenLayer.clear();
     outputLayer.clear();
+    floatInputWeights.clear();
+    floatHiddenWeights.clear();
+    floatOutputWeights.clear();
     initialized = false;
     
     return true;
@@ -354,6 +462,10 @@ bool MLP::train_(LabelledRegressionData &trainingData){
     bool tempScalingState = useScaling;
     useScaling = false;
     
+    //Each random training iteration reinitializes the network, which also clears the ranges, so keep a copy to restore after training
+    vector< MinMax > tempInputVectorRanges = inputVectorRanges;
+    vector< MinMax > tempTargetVectorRanges = targetVectorRanges;
+    
     //Setup the memory
     trainingErrorLog.clear();
     inputNeuronsOuput.resize(numInputNeurons);
@@ -377,6 +489,9 @@ bool MLP::train_(LabelledRegressionData &trainingData){
             return false;
             break;
     }
+    
+    inputVectorRanges = tempInputVectorRanges;
+    targetVectorRanges = tempTargetVectorRanges;
 
     
     
@@ -671,6 +786,9 @@ bool MLP::train_(LabelledRegressionData &trainingData){
     
     //Reset the scaling state so the prediction data will be scaled if needed
     useScaling = tempScalingState;
+    
+    //Build the float copy of the weights if float prediction is enabled
+    updateFloatModel();
 
     return true;
 }
@@ -1199,9 +1317,17 @@ double MLP::back_prop(const VectorDouble &trainingExample,const VectorDouble &ta
 
 VectorDouble MLP::feedforward(VectorDouble trainingExample){
     
+    feedforwardInplace( trainingExample );
+    
+    return outputNeuronsOutput;
+}
+    
+void MLP::feedforwardInplace(VectorDouble &trainingExample){
+    
     if( inputNeuronsOuput.size() != numInputNeurons ) inputNeuronsOuput.resize(numInputNeurons,0);
     if( hiddenNeuronsOutput.size() != numHiddenNeurons ) hiddenNeuronsOutput.resize(numHiddenNeurons,0);
     if( outputNeuronsOutput.size() != numOutputNeurons ) outputNeuronsOutput.resize(numOutputNeurons,0);
+    if( inputNeuronInput.size() != 1 ) inputNeuronInput.resize(1,0);
 
 	//Scale the input vector if required
 	if( useScaling ){
@@ -1211,10 +1337,9 @@ VectorDouble MLP::feedforward(VectorDouble trainingExample){
 	}
     
     //Input layer
-	VectorDouble input(1);
     for(UINT i=0; i<numInputNeurons; i++){
-        input[0] = trainingExample[i];
-        inputNeuronsOuput[i] = inputLayer[i].fire( input );
+        inputNeuronInput[0] = trainingExample[i];
+        inputNeuronsOuput[i] = inputLayer[i].fire( inputNeuronInput );
     }
     
     //Hidden Layer
@@ -1234,8 +1359,6 @@ VectorDouble MLP::feedforward(VectorDouble trainingExample){
 		}
 	}
     
-    return outputNeuronsOutput;
-    
 }
 
 void MLP::feedforward(const VectorDouble &trainingExample,VectorDouble &inputNeuronsOuput,VectorDouble &hiddenNeuronsOutput,VectorDouble &outputNeuronsOutput){
@@ -1859,6 +1982,9 @@ bool MLP::loadModelFromFile(fstream &file){
 
     initialized = true;
 	trained = true;
+    
+    //Build the float copy of the weights if float prediction is enabled
+    updateFloatModel();
 
 	return true;
 }
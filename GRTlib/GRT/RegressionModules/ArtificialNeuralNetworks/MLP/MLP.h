@@ -91,6 +91,33 @@ public:
      */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This is the same as the predict function, except the inputVector is passed by reference so it does not need to be copied.
+     The inputVector may be modified (i.e. scaled) by this function.
+     This overrides the predictInplace function in the MLBase base class.
+     
+     @param VectorDouble &inputVector: a reference to the input vector to perform regression on
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictInplace(VectorDouble &inputVector);
+    
+    /**
+     This runs the feedforward step with the float copy of the network weights.  The weighted sums of the hidden and output layers
+     are computed in float, the activation functions are computed in double.
+     This overrides the predictFloatInplace function in the MLBase base class.
+     
+     @param VectorFloat &inputVector: a reference to the input vector to perform regression on
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictFloatInplace(VectorFloat &inputVector);
+    
+    /**
+     The MLP supports the float prediction path.
+     
+     @return returns true
+     */
+    virtual bool getSupportsFloatPrediction() const{ return true; }
+    
     /**
      Clears any previous model or settings.
      
@@ -523,6 +550,14 @@ protected:
      */
     VectorDouble feedforward(VectorDouble trainingExample);
     
+    /**
+     Performs the feedforward step using the current model, the results are written to the outputNeuronsOutput buffer so no memory is
+     allocated once the buffers have been sized.  The trainingExample will be scaled if scaling is enabled.
+     
+     @param VectorDouble &trainingExample: the input vector to use for the feedforward
+     */
+    void feedforwardInplace(VectorDouble &trainingExample);
+    
     /**
      Performs the feedforward step for back propagation, using the input data
      
@@ -533,6 +568,13 @@ protected:
      */
     void feedforward(const VectorDouble &trainingExample,VectorDouble &inputNeuronsOuput,VectorDouble &hiddenNeuronsOutput,VectorDouble &outputNeuronsOutput);
     
+    /**
+     Computes the class likelihoods and predicted class label from the regressionData, this is only used in classification mode.
+     */
+    void predictFromRegressionData();
+    
+    virtual bool buildFloatModel();
+    
     UINT numInputNeurons;
     UINT numHiddenNeurons;
     UINT numOutputNeurons;
@@ -567,9 +609,18 @@ protected:
     VectorDouble inputNeuronsOuput;
     VectorDouble hiddenNeuronsOutput;
     VectorDouble outputNeuronsOutput;
+    VectorDouble inputNeuronInput;
     VectorDouble deltaO;
     VectorDouble deltaH;
     
+    //Float Prediction Stuff
+    VectorFloat floatInputWeights;          //The weight of each input neuron
+    MatrixFloat floatHiddenWeights;         //The weights of the hidden layer, one row per hidden neuron
+    MatrixFloat floatOutputWeights;         //The weights of the output layer, one row per output neuron
+    VectorFloat floatInputOutput;
+    VectorFloat floatHiddenOutput;
+    VectorFloat floatOutputSums;
+    
 public:
     enum TrainingModes{ONLINE_GRADIENT_DESCENT};
     
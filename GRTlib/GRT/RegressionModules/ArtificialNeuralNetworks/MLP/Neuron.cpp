@@ -71,42 +71,30 @@ void Neuron::clear(){
 
 double Neuron::fire(const VectorDouble &x){
     
-    double y = 0;
+    double y = bias;
+    for(UINT i=0; i<numInputs; i++){
+        y += x[i] * weights[i];
+    }
+    return activate( y );
+    
+}
+
+double Neuron::activate(const double y) const{
     
     switch( activationFunction ){
         case(LINEAR):
-            y = bias;
-            for(UINT i=0; i<numInputs; i++){
-                y += x[i] * weights[i];
-            }
-            break;
+            return y;
         case(SIGMOID):
-            y = bias;
-            for(UINT i=0; i<numInputs; i++){
-                y += x[i] * weights[i];
-            }
-	
             //Trick for stopping overflow
-			if( y < -45.0 ){ y = 0; }
-			else if( y > 45.0 ){ y = 1.0; }
-			else{
-				y = 1.0/(1.0+exp(-y));
-			}
-            break;
+			if( y < -45.0 ){ return 0; }
+			else if( y > 45.0 ){ return 1.0; }
+			return 1.0/(1.0+exp(-y));
         case(BIPOLAR_SIGMOID):
-            y = bias;
-            for(UINT i=0; i<numInputs; i++){
-                y += x[i] * weights[i];
-            }
-	
-            if( y < -45.0 ){ y = 0; }
-			else if( y > 45.0 ){ y = 1.0; }
-			else{
-				y = (2.0 / (1.0 + exp(-gamma * y))) - 1.0;
-			}
-            break;
+            if( y < -45.0 ){ return 0; }
+			else if( y > 45.0 ){ return 1.0; }
+			return (2.0 / (1.0 + exp(-gamma * y))) - 1.0;
     }
-    return y;
+    return 0;
     
 }
 
@@ -193,6 +193,10 @@ bool LinearRegression::train(LabelledRegressionData trainingData){
 }
 
 bool LinearRegression::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool LinearRegression::predictInplace(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
@@ -193,6 +193,10 @@ bool LogisticRegression::train(LabelledRegressionData trainingData){
 }
 
 bool LogisticRegression::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool LogisticRegression::predictInplace(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
@@ -166,6 +166,10 @@ bool MultidimensionalRegression::train(LabelledRegressionData trainingData){
 }
 
 bool MultidimensionalRegression::predict(VectorDouble inputVector){
+    return predictInplace( inputVector );
+}
+
+bool MultidimensionalRegression::predictInplace(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
@@ -0,0 +1,479 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "BinaryModelFile.h"
+
+#if defined(__GRT_OSX_BUILD__) || defined(__GRT_LINUX_BUILD__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define GRT_BINARY_MODEL_FILE_USE_MMAP
+#endif
+
+namespace GRT{
+
+///////////////// Memory Mapped File /////////////////
+MemoryMappedFile::MemoryMappedFile(){
+    shared = NULL;
+}
+
+MemoryMappedFile::MemoryMappedFile(const MemoryMappedFile &rhs){
+    shared = rhs.shared;
+    if( shared != NULL ) __atomic_fetch_add( &shared->numReferences, 1, __ATOMIC_RELAXED );
+}
+
+MemoryMappedFile::~MemoryMappedFile(){
+    close();
+}
+
+MemoryMappedFile& MemoryMappedFile::operator=(const MemoryMappedFile &rhs){
+    if( this != &rhs && shared != rhs.shared ){
+        close();
+        shared = rhs.shared;
+        if( shared != NULL ) __atomic_fetch_add( &shared->numReferences, 1, __ATOMIC_RELAXED );
+    }
+    return *this;
+}
+
+bool MemoryMappedFile::open(const string &filename,const bool useMemoryMapping){
+
+    close();
+
+#ifdef GRT_BINARY_MODEL_FILE_USE_MMAP
+    if( useMemoryMapping ){
+        const int fd = ::open( filename.c_str(), O_RDONLY );
+        if( fd < 0 ) return false;
+
+        struct stat fileInfo;
+        if( fstat( fd, &fileInfo ) != 0 || fileInfo.st_size <= 0 ){
+            ::close( fd );
+            return false;
+        }
+
+        void *data = mmap( NULL, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        ::close( fd );
+        if( data == MAP_FAILED ) return false;
+
+        shared = new SharedFile;
+        shared->data = (char*)data;
+        shared->size = (unsigned long long)fileInfo.st_size;
+        shared->mapped = true;
+        shared->numReferences = 1;
+        return true;
+    }
+#endif
+
+    //Memory mapping is not used on this platform (or was not requested), so read the whole file into memory
+    fstream file;
+    file.open( filename.c_str(), std::ios::in | std::ios::binary );
+    if( !file.is_open() ) return false;
+
+    file.seekg( 0, std::ios::end );
+    const streamoff size = file.tellg();
+    file.seekg( 0, std::ios::beg );
+    if( size <= 0 ) return false;
+
+    char *data = (char*)malloc( (size_t)size );
+    if( data == NULL ) return false;
+    file.read( data, size );
+    if( file.gcount() != size ){
+        free( data );
+        return false;
+    }
+
+    shared = new SharedFile;
+    shared->data = data;
+    shared->size = (unsigned long long)size;
+    shared->mapped = false;
+    shared->numReferences = 1;
+
+    return true;
+}
+
+void MemoryMappedFile::close(){
+
+    if( shared == NULL ) return;
+
+    if( __atomic_sub_fetch( &shared->numReferences, 1, __ATOMIC_ACQ_REL ) == 0 ){
+#ifdef GRT_BINARY_MODEL_FILE_USE_MMAP
+        if( shared->mapped ) munmap( shared->data, (size_t)shared->size );
+        else free( shared->data );
+#else
+        free( shared->data );
+#endif
+        delete shared;
+    }
+    shared = NULL;
+}
+
+///////////////// Binary Model Writer /////////////////
+BinaryModelWriter::BinaryModelWriter(){
+    textSectionStart = 0;
+    textSectionOpen = false;
+    debugLog.setProceedingText("[DEBUG BinaryModelWriter]");
+    errorLog.setProceedingText("[ERROR BinaryModelWriter]");
+    warningLog.setProceedingText("[WARNING BinaryModelWriter]");
+}
+
+BinaryModelWriter::~BinaryModelWriter(){
+    if( getIsOpen() ) close();
+}
+
+bool BinaryModelWriter::open(const string &filename){
+
+    if( getIsOpen() ) close();
+
+    sections.clear();
+    textSectionOpen = false;
+
+    file.open( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if( !file.is_open() ){
+        errorLog << "open(const string &filename) - Failed to create file: " << filename << endl;
+        return false;
+    }
+
+    //Text sections are written with enough digits to read every double back exactly, so models that are saved as text keep the same values
+    file.precision( numeric_limits< double >::digits10 + 2 );
+
+    //Write a placeholder header, this is rewritten with the section table offset when the file is closed
+    BinaryModelFileHeader header;
+    file.write( (const char*)&header, sizeof(header) );
+
+    return file.good();
+}
+
+bool BinaryModelWriter::close(){
+
+    if( !getIsOpen() ) return false;
+
+    if( textSectionOpen ){
+        warningLog << "close() - The text section " << textSectionName << " was not finished, it will be finished now" << endl;
+        endTextSection();
+    }
+
+    //Write the section table after the last section, then point the header at it
+    bool ok = alignFile();
+    BinaryModelFileHeader header;
+    header.numSections = (UINT)sections.size();
+    header.tableOffset = (unsigned long long)file.tellp();
+    if( sections.size() > 0 ) file.write( (const char*)&sections[0], sections.size()*sizeof(BinaryModelFileSection) );
+    file.seekp( 0, std::ios::beg );
+    file.write( (const char*)&header, sizeof(header) );
+
+    ok = ok && file.good();
+    file.close();
+    sections.clear();
+
+    if( !ok ){
+        errorLog << "close() - Failed to write the section table!" << endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryModelWriter::getIsOpen() const{
+    return file.is_open();
+}
+
+bool BinaryModelWriter::writeSection(const string &name,const void *data,const unsigned long long numBytes){
+
+    if( !getIsOpen() ){
+        errorLog << "writeSection(const string &name,const void *data,const unsigned long long numBytes) - The file is not open!" << endl;
+        return false;
+    }
+
+    if( textSectionOpen ){
+        errorLog << "writeSection(const string &name,const void *data,const unsigned long long numBytes) - The text section " << textSectionName << " has not been finished!" << endl;
+        return false;
+    }
+
+    if( data == NULL && numBytes > 0 ){
+        errorLog << "writeSection(const string &name,const void *data,const unsigned long long numBytes) - The data pointer is NULL!" << endl;
+        return false;
+    }
+
+    if( !alignFile() ) return false;
+
+    const unsigned long long offset = (unsigned long long)file.tellp();
+    if( !addSection( name, BINARY_SECTION, offset, numBytes ) ) return false;
+    if( numBytes > 0 ) file.write( (const char*)data, (streamsize)numBytes );
+
+    if( !file.good() ){
+        errorLog << "writeSection(const string &name,const void *data,const unsigned long long numBytes) - Failed to write section: " << name << endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryModelWriter::beginTextSection(const string &name){
+
+    if( !getIsOpen() ){
+        errorLog << "beginTextSection(const string &name) - The file is not open!" << endl;
+        return false;
+    }
+
+    if( textSectionOpen ){
+        errorLog << "beginTextSection(const string &name) - The text section " << textSectionName << " has not been finished!" << endl;
+        return false;
+    }
+
+    if( name.length() == 0 || name.length() > GRT_BINARY_MODEL_FILE_MAX_SECTION_NAME_LENGTH || findSection( name ) ){
+        errorLog << "beginTextSection(const string &name) - The section name is not valid or is already used: " << name << endl;
+        return false;
+    }
+
+    if( !alignFile() ) return false;
+
+    textSectionName = name;
+    textSectionStart = (unsigned long long)file.tellp();
+    textSectionOpen = true;
+
+    return true;
+}
+
+bool BinaryModelWriter::endTextSection(){
+
+    if( !textSectionOpen ){
+        errorLog << "endTextSection() - There is no text section to finish!" << endl;
+        return false;
+    }
+
+    textSectionOpen = false;
+    const unsigned long long end = (unsigned long long)file.tellp();
+    if( !file.good() || end < textSectionStart ){
+        errorLog << "endTextSection() - Failed to write section: " << textSectionName << endl;
+        return false;
+    }
+
+    return addSection( textSectionName, TEXT_SECTION, textSectionStart, end-textSectionStart );
+}
+
+fstream& BinaryModelWriter::getTextStream(){
+    return file;
+}
+
+bool BinaryModelWriter::findSection(const string &name) const{
+    for(UINT i=0; i<sections.size(); i++){
+        if( name == sections[i].name ) return true;
+    }
+    return false;
+}
+
+bool BinaryModelWriter::addSection(const string &name,const UINT type,const unsigned long long offset,const unsigned long long size){
+
+    if( name.length() == 0 || name.length() > GRT_BINARY_MODEL_FILE_MAX_SECTION_NAME_LENGTH ){
+        errorLog << "addSection(...) - The section name must have between 1 and " << GRT_BINARY_MODEL_FILE_MAX_SECTION_NAME_LENGTH << " characters: " << name << endl;
+        return false;
+    }
+
+    if( findSection( name ) ){
+        errorLog << "addSection(...) - The file already has a section called: " << name << endl;
+        return false;
+    }
+
+    BinaryModelFileSection section;
+    memcpy( section.name, name.c_str(), name.length() );
+    section.type = type;
+    section.offset = offset;
+    section.size = size;
+    sections.push_back( section );
+
+    return true;
+}
+
+bool BinaryModelWriter::alignFile(){
+
+    //Pad the file with zeros so the next section starts on an aligned offset
+    const char padding[ GRT_BINARY_MODEL_FILE_ALIGNMENT ] = {0};
+    const unsigned long long position = (unsigned long long)file.tellp();
+    const unsigned long long remainder = position % GRT_BINARY_MODEL_FILE_ALIGNMENT;
+    if( remainder > 0 ) file.write( padding, GRT_BINARY_MODEL_FILE_ALIGNMENT-remainder );
+
+    if( !file.good() ){
+        errorLog << "alignFile() - Failed to write to the file!" << endl;
+        return false;
+    }
+
+    return true;
+}
+
+///////////////// Binary Model Reader /////////////////
+BinaryModelReader::BinaryModelReader(){
+    debugLog.setProceedingText("[DEBUG BinaryModelReader]");
+    errorLog.setProceedingText("[ERROR BinaryModelReader]");
+    warningLog.setProceedingText("[WARNING BinaryModelReader]");
+}
+
+BinaryModelReader::~BinaryModelReader(){
+    close();
+}
+
+bool BinaryModelReader::open(const string &filename,const bool useMemoryMapping){
+
+    close();
+
+    if( !mappedFile.open( filename, useMemoryMapping ) ){
+        errorLog << "open(const string &filename,const bool useMemoryMapping) - Failed to open file: " << filename << endl;
+        return false;
+    }
+
+    //Check the header
+    const BinaryModelFileHeader expectedHeader;
+    BinaryModelFileHeader header;
+    if( mappedFile.getSize() < sizeof(header) ){
+        errorLog << "open(const string &filename,const bool useMemoryMapping) - The file is too small to be a binary model file!" << endl;
+        close();
+        return false;
+    }
+    memcpy( &header, mappedFile.getData(), sizeof(header) );
+
+    if( memcmp( header.magic, expectedHeader.magic, sizeof(header.magic) ) != 0 ){
+        errorLog << "open(const string &filename,const bool useMemoryMapping) - The file is not a binary model file!" << endl;
+        close();
+        return false;
+    }
+
+    if( header.byteOrder != expectedHeader.byteOrder ){
+        errorLog << "open(const string &filename,const bool useMemoryMapping) - The file was written on a machine with a different byte order!" << endl;
+        close();
+        return false;
+    }
+
+    if( header.version > GRT_BINARY_MODEL_FILE_VERSION || header.alignment != GRT_BINARY_MODEL_FILE_ALIGNMENT ){
+        errorLog << "open(const string &filename,const bool useMemoryMapping) - The file version " << header.version << " is not supported!" << endl;
+        close();
+        return false;
+    }
+
+    //Read the section table and check every section is inside the file
+    const unsigned long long fileSize = mappedFile.getSize();
+    const unsigned long long tableSize = (unsigned long long)header.numSections * sizeof(BinaryModelFileSection);
+    if( header.tableOffset > fileSize || tableSize > fileSize - header.tableOffset ){
+        errorLog << "open(const string &filename,const bool useMemoryMapping) - The section table is not valid!" << endl;
+        close();
+        return false;
+    }
+
+    sections.resize( header.numSections );
+    if( header.numSections > 0 ) memcpy( &sections[0], mappedFile.getData() + header.tableOffset, (size_t)tableSize );
+    for(UINT i=0; i<sections.size(); i++){
+        BinaryModelFileSection &section = sections[i];
+        section.name[ GRT_BINARY_MODEL_FILE_MAX_SECTION_NAME_LENGTH ] = '\0';
+        if( section.offset > fileSize || section.size > fileSize - section.offset || (section.type != BinaryModelWriter::BINARY_SECTION && section.type != BinaryModelWriter::TEXT_SECTION) ){
+            errorLog << "open(const string &filename,const bool useMemoryMapping) - Section " << section.name << " is not valid!" << endl;
+            close();
+            return false;
+        }
+    }
+
+    //The text sections are read through a stream, so the existing loadModelFromFile functions can be used
+    file.open( filename.c_str(), std::ios::in | std::ios::binary );
+    if( !file.is_open() ){
+        errorLog << "open(const string &filename,const bool useMemoryMapping) - Failed to open file: " << filename << endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryModelReader::close(){
+    if( file.is_open() ) file.close();
+    mappedFile.close();
+    sections.clear();
+    return true;
+}
+
+bool BinaryModelReader::getIsOpen() const{
+    return mappedFile.getIsOpen();
+}
+
+bool BinaryModelReader::getHasSection(const string &name) const{
+    return findSection( name ) != NULL;
+}
+
+const void* BinaryModelReader::getSection(const string &name,unsigned long long &numBytes) const{
+
+    numBytes = 0;
+    const BinaryModelFileSection *section = findSection( name );
+    if( section == NULL || section->type != BinaryModelWriter::BINARY_SECTION ){
+        return NULL;
+    }
+
+    numBytes = section->size;
+    if( numBytes == 0 ) return NULL;
+
+    return mappedFile.getData() + section->offset;
+}
+
+bool BinaryModelReader::beginTextSection(const string &name){
+
+    const BinaryModelFileSection *section = findSection( name );
+    if( section == NULL || section->type != BinaryModelWriter::TEXT_SECTION ){
+        errorLog << "beginTextSection(const string &name) - Failed to find text section: " << name << endl;
+        return false;
+    }
+
+    file.clear();
+    file.seekg( (streamoff)section->offset, std::ios::beg );
+
+    return file.good();
+}
+
+fstream& BinaryModelReader::getTextStream(){
+    return file;
+}
+
+const MemoryMappedFile& BinaryModelReader::getMappedFile() const{
+    return mappedFile;
+}
+
+vector< string > BinaryModelReader::getSectionNames() const{
+    vector< string > names( sections.size() );
+    for(UINT i=0; i<sections.size(); i++){
+        names[i] = sections[i].name;
+    }
+    return names;
+}
+
+bool BinaryModelReader::isBinaryModelFile(const string &filename){
+
+    fstream file;
+    file.open( filename.c_str(), std::ios::in | std::ios::binary );
+    if( !file.is_open() ) return false;
+
+    const BinaryModelFileHeader expectedHeader;
+    char magic[ sizeof(expectedHeader.magic) ];
+    file.read( magic, sizeof(magic) );
+
+    return file.gcount() == sizeof(magic) && memcmp( magic, expectedHeader.magic, sizeof(magic) ) == 0;
+}
+
+const BinaryModelFileSection* BinaryModelReader::findSection(const string &name) const{
+    for(UINT i=0; i<sections.size(); i++){
+        if( name == sections[i].name ) return &sections[i];
+    }
+    return NULL;
+}
+
+}//End of namespace GRT
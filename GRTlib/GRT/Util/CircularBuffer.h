@@ -70,14 +70,13 @@ class CircularBuffer{
         this->bufferInit = false;
             
         if( rhs.bufferInit ){
-            this->resize( rhs.bufferSize );
-            this->readPtr = 0;
-            this->writePtr = 0;
-            for(unsigned int i=0; i<rhs.numValuesInBuffer; i++){
-                this->push_back( rhs.buffer[ i ] );
-            }
+            //Copy the whole buffer, the slots that have not been written yet hold the default value the buffer was resized with
+            this->bufferSize = rhs.bufferSize;
+            this->numValuesInBuffer = rhs.numValuesInBuffer;
+            this->buffer = rhs.buffer;
             this->readPtr = rhs.readPtr;
             this->writePtr = rhs.writePtr;
+            this->bufferInit = true;
         }
     }
     
@@ -112,14 +111,13 @@ class CircularBuffer{
             this->clear();
             
             if( rhs.bufferInit ){
-                this->resize( rhs.bufferSize );
-                this->readPtr = 0;
-                this->writePtr = 0;
-                for(unsigned int i=0; i<rhs.numValuesInBuffer; i++){
-                    this->push_back( rhs.buffer[ i ] );
-                }
+                //Copy the whole buffer, the slots that have not been written yet hold the default value the buffer was resized with
+                this->bufferSize = rhs.bufferSize;
+                this->numValuesInBuffer = rhs.numValuesInBuffer;
+                this->buffer = rhs.buffer;
                 this->readPtr = rhs.readPtr;
                 this->writePtr = rhs.writePtr;
+                this->bufferInit = true;
             }
         }
         return *this;
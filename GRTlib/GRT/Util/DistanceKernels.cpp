@@ -0,0 +1,867 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DistanceKernels.h"
+#include <cmath>
+#include <cstddef>
+
+//SSE2 is part of every x86-64 build, so it is used whenever the compiler enables it
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define GRT_DISTANCE_KERNELS_SSE2
+#endif
+
+//The AVX kernels are compiled with a target attribute and only used if the CPU supports AVX, so the library does not need -mavx
+#if defined(GRT_DISTANCE_KERNELS_SSE2) && defined(__GNUC__) && !defined(__clang__) && ( __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) )
+#include <immintrin.h>
+#define GRT_DISTANCE_KERNELS_AVX
+#endif
+
+//Only 64-bit ARM has double precision NEON, 32-bit ARM builds use the scalar kernels
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GRT_DISTANCE_KERNELS_NEON
+#endif
+
+//32-bit ARM does have single precision NEON, so the float kernels use NEON on any ARM build that enables it
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define GRT_DISTANCE_KERNELS_FLOAT_NEON
+#endif
+
+namespace GRT{
+
+typedef void (*DistanceKernelFunction)(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances);
+
+struct DistanceKernelTable{
+    DistanceKernelFunction squaredEuclidean;
+    DistanceKernelFunction manhattan;
+    DistanceKernelFunction cosine;
+    const char *instructionSet;
+};
+
+static double computeSquaredMagnitude(const double *x,const UINT numDimensions){
+    double mag = 0;
+    for(UINT j=0; j<numDimensions; j++){
+        mag += x[j] * x[j];
+    }
+    return mag;
+}
+
+////////////////////////////////////// Scalar Kernels //////////////////////////////////////
+
+static void squaredEuclideanScalar(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    for(UINT i=0; i<numRows; i++){
+        const double *row = rows + (size_t)i*rowStride;
+        double dist = 0;
+        for(UINT j=0; j<numDimensions; j++){
+            const double d = x[j] - row[j];
+            dist += d * d;
+        }
+        distances[i] = dist;
+    }
+}
+
+static void manhattanScalar(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    for(UINT i=0; i<numRows; i++){
+        const double *row = rows + (size_t)i*rowStride;
+        double dist = 0;
+        for(UINT j=0; j<numDimensions; j++){
+            dist += fabs( x[j] - row[j] );
+        }
+        distances[i] = dist;
+    }
+}
+
+static void cosineScalar(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    const double magX = sqrt( computeSquaredMagnitude( x, numDimensions ) );
+    for(UINT i=0; i<numRows; i++){
+        const double *row = rows + (size_t)i*rowStride;
+        double dot = 0;
+        double magRow = 0;
+        for(UINT j=0; j<numDimensions; j++){
+            dot += x[j] * row[j];
+            magRow += row[j] * row[j];
+        }
+        distances[i] = dot / (magX * sqrt(magRow));
+    }
+}
+
+////////////////////////////////////// SSE2 Kernels //////////////////////////////////////
+//Each kernel processes two rows at a time, with one row in each lane. Two dimensions of both rows are loaded and transposed so
+//each lane still adds the dimensions in order, which keeps the results identical to the scalar kernels
+#if defined(GRT_DISTANCE_KERNELS_SSE2)
+
+static void squaredEuclideanSSE2(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    UINT i = 0;
+    for(; i+2<=numRows; i+=2){
+        const double *row0 = rows + (size_t)i*rowStride;
+        const double *row1 = row0 + rowStride;
+        __m128d sum = _mm_setzero_pd();
+        UINT j = 0;
+        for(; j+2<=numDimensions; j+=2){
+            const __m128d a = _mm_loadu_pd( row0+j );
+            const __m128d b = _mm_loadu_pd( row1+j );
+            __m128d d = _mm_sub_pd( _mm_set1_pd( x[j] ), _mm_unpacklo_pd( a, b ) );
+            sum = _mm_add_pd( sum, _mm_mul_pd( d, d ) );
+            d = _mm_sub_pd( _mm_set1_pd( x[j+1] ), _mm_unpackhi_pd( a, b ) );
+            sum = _mm_add_pd( sum, _mm_mul_pd( d, d ) );
+        }
+        for(; j<numDimensions; j++){
+            const __m128d d = _mm_sub_pd( _mm_set1_pd( x[j] ), _mm_set_pd( row1[j], row0[j] ) );
+            sum = _mm_add_pd( sum, _mm_mul_pd( d, d ) );
+        }
+        _mm_storeu_pd( distances+i, sum );
+    }
+    if( i < numRows ) squaredEuclideanScalar( x, rows + (size_t)i*rowStride, numRows-i, rowStride, numDimensions, distances+i );
+}
+
+static void manhattanSSE2(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    const __m128d signMask = _mm_set1_pd( -0.0 );
+    UINT i = 0;
+    for(; i+2<=numRows; i+=2){
+        const double *row0 = rows + (size_t)i*rowStride;
+        const double *row1 = row0 + rowStride;
+        __m128d sum = _mm_setzero_pd();
+        UINT j = 0;
+        for(; j+2<=numDimensions; j+=2){
+            const __m128d a = _mm_loadu_pd( row0+j );
+            const __m128d b = _mm_loadu_pd( row1+j );
+            sum = _mm_add_pd( sum, _mm_andnot_pd( signMask, _mm_sub_pd( _mm_set1_pd( x[j] ), _mm_unpacklo_pd( a, b ) ) ) );
+            sum = _mm_add_pd( sum, _mm_andnot_pd( signMask, _mm_sub_pd( _mm_set1_pd( x[j+1] ), _mm_unpackhi_pd( a, b ) ) ) );
+        }
+        for(; j<numDimensions; j++){
+            sum = _mm_add_pd( sum, _mm_andnot_pd( signMask, _mm_sub_pd( _mm_set1_pd( x[j] ), _mm_set_pd( row1[j], row0[j] ) ) ) );
+        }
+        _mm_storeu_pd( distances+i, sum );
+    }
+    if( i < numRows ) manhattanScalar( x, rows + (size_t)i*rowStride, numRows-i, rowStride, numDimensions, distances+i );
+}
+
+static void cosineSSE2(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    const double magX = sqrt( computeSquaredMagnitude( x, numDimensions ) );
+    double dot[2];
+    double magRow[2];
+    UINT i = 0;
+    for(; i+2<=numRows; i+=2){
+        const double *row0 = rows + (size_t)i*rowStride;
+        const double *row1 = row0 + rowStride;
+        __m128d dotSum = _mm_setzero_pd();
+        __m128d magSum = _mm_setzero_pd();
+        UINT j = 0;
+        for(; j+2<=numDimensions; j+=2){
+            const __m128d a = _mm_loadu_pd( row0+j );
+            const __m128d b = _mm_loadu_pd( row1+j );
+            __m128d r = _mm_unpacklo_pd( a, b );
+            dotSum = _mm_add_pd( dotSum, _mm_mul_pd( _mm_set1_pd( x[j] ), r ) );
+            magSum = _mm_add_pd( magSum, _mm_mul_pd( r, r ) );
+            r = _mm_unpackhi_pd( a, b );
+            dotSum = _mm_add_pd( dotSum, _mm_mul_pd( _mm_set1_pd( x[j+1] ), r ) );
+            magSum = _mm_add_pd( magSum, _mm_mul_pd( r, r ) );
+        }
+        for(; j<numDimensions; j++){
+            const __m128d r = _mm_set_pd( row1[j], row0[j] );
+            dotSum = _mm_add_pd( dotSum, _mm_mul_pd( _mm_set1_pd( x[j] ), r ) );
+            magSum = _mm_add_pd( magSum, _mm_mul_pd( r, r ) );
+        }
+        _mm_storeu_pd( dot, dotSum );
+        _mm_storeu_pd( magRow, magSum );
+        distances[i] = dot[0] / (magX * sqrt(magRow[0]));
+        distances[i+1] = dot[1] / (magX * sqrt(magRow[1]));
+    }
+    if( i < numRows ) cosineScalar( x, rows + (size_t)i*rowStride, numRows-i, rowStride, numDimensions, distances+i );
+}
+
+#endif //GRT_DISTANCE_KERNELS_SSE2
+
+////////////////////////////////////// AVX Kernels //////////////////////////////////////
+//Each kernel processes four rows at a time, four dimensions of each row are loaded and transposed with a 4x4 shuffle
+#if defined(GRT_DISTANCE_KERNELS_AVX)
+
+#define GRT_DISTANCE_KERNELS_AVX_TRANSPOSE(r0,r1,r2,r3,c0,c1,c2,c3) {       \
+    const __m256d t0 = _mm256_unpacklo_pd( r0, r1 );                        \
+    const __m256d t1 = _mm256_unpackhi_pd( r0, r1 );                        \
+    const __m256d t2 = _mm256_unpacklo_pd( r2, r3 );                        \
+    const __m256d t3 = _mm256_unpackhi_pd( r2, r3 );                        \
+    c0 = _mm256_permute2f128_pd( t0, t2, 0x20 );                            \
+    c1 = _mm256_permute2f128_pd( t1, t3, 0x20 );                            \
+    c2 = _mm256_permute2f128_pd( t0, t2, 0x31 );                            \
+    c3 = _mm256_permute2f128_pd( t1, t3, 0x31 );                            \
+}
+
+__attribute__((target("avx")))
+static void squaredEuclideanAVX(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    UINT i = 0;
+    for(; i+4<=numRows; i+=4){
+        const double *row0 = rows + (size_t)i*rowStride;
+        const double *row1 = row0 + rowStride;
+        const double *row2 = row1 + rowStride;
+        const double *row3 = row2 + rowStride;
+        __m256d sum = _mm256_setzero_pd();
+        __m256d c[4];
+        __m256d d;
+        UINT j = 0;
+        for(; j+4<=numDimensions; j+=4){
+            const __m256d r0 = _mm256_loadu_pd( row0+j );
+            const __m256d r1 = _mm256_loadu_pd( row1+j );
+            const __m256d r2 = _mm256_loadu_pd( row2+j );
+            const __m256d r3 = _mm256_loadu_pd( row3+j );
+            GRT_DISTANCE_KERNELS_AVX_TRANSPOSE( r0, r1, r2, r3, c[0], c[1], c[2], c[3] );
+            for(UINT k=0; k<4; k++){
+                d = _mm256_sub_pd( _mm256_set1_pd( x[j+k] ), c[k] );
+                sum = _mm256_add_pd( sum, _mm256_mul_pd( d, d ) );
+            }
+        }
+        for(; j<numDimensions; j++){
+            d = _mm256_sub_pd( _mm256_set1_pd( x[j] ), _mm256_set_pd( row3[j], row2[j], row1[j], row0[j] ) );
+            sum = _mm256_add_pd( sum, _mm256_mul_pd( d, d ) );
+        }
+        _mm256_storeu_pd( distances+i, sum );
+    }
+    //Clear the upper halves of the AVX registers before the SSE2 kernel, the compiler does not do this when the call is a tail call and
+    //every SSE instruction after it would pay the AVX to SSE transition penalty
+    _mm256_zeroupper();
+    if( i < numRows ) squaredEuclideanSSE2( x, rows + (size_t)i*rowStride, numRows-i, rowStride, numDimensions, distances+i );
+}
+
+__attribute__((target("avx")))
+static void manhattanAVX(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    const __m256d signMask = _mm256_set1_pd( -0.0 );
+    UINT i = 0;
+    for(; i+4<=numRows; i+=4){
+        const double *row0 = rows + (size_t)i*rowStride;
+        const double *row1 = row0 + rowStride;
+        const double *row2 = row1 + rowStride;
+        const double *row3 = row2 + rowStride;
+        __m256d sum = _mm256_setzero_pd();
+        __m256d c[4];
+        UINT j = 0;
+        for(; j+4<=numDimensions; j+=4){
+            const __m256d r0 = _mm256_loadu_pd( row0+j );
+            const __m256d r1 = _mm256_loadu_pd( row1+j );
+            const __m256d r2 = _mm256_loadu_pd( row2+j );
+            const __m256d r3 = _mm256_loadu_pd( row3+j );
+            GRT_DISTANCE_KERNELS_AVX_TRANSPOSE( r0, r1, r2, r3, c[0], c[1], c[2], c[3] );
+            for(UINT k=0; k<4; k++){
+                sum = _mm256_add_pd( sum, _mm256_andnot_pd( signMask, _mm256_sub_pd( _mm256_set1_pd( x[j+k] ), c[k] ) ) );
+            }
+        }
+        for(; j<numDimensions; j++){
+            sum = _mm256_add_pd( sum, _mm256_andnot_pd( signMask, _mm256_sub_pd( _mm256_set1_pd( x[j] ), _mm256_set_pd( row3[j], row2[j], row1[j], row0[j] ) ) ) );
+        }
+        _mm256_storeu_pd( distances+i, sum );
+    }
+    _mm256_zeroupper();
+    if( i < numRows ) manhattanSSE2( x, rows + (size_t)i*rowStride, numRows-i, rowStride, numDimensions, distances+i );
+}
+
+__attribute__((target("avx")))
+static void cosineAVX(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    const double magX = sqrt( computeSquaredMagnitude( x, numDimensions ) );
+    double dot[4];
+    double magRow[4];
+    UINT i = 0;
+    for(; i+4<=numRows; i+=4){
+        const double *row0 = rows + (size_t)i*rowStride;
+        const double *row1 = row0 + rowStride;
+        const double *row2 = row1 + rowStride;
+        const double *row3 = row2 + rowStride;
+        __m256d dotSum = _mm256_setzero_pd();
+        __m256d magSum = _mm256_setzero_pd();
+        __m256d c[4];
+        UINT j = 0;
+        for(; j+4<=numDimensions; j+=4){
+            const __m256d r0 = _mm256_loadu_pd( row0+j );
+            const __m256d r1 = _mm256_loadu_pd( row1+j );
+            const __m256d r2 = _mm256_loadu_pd( row2+j );
+            const __m256d r3 = _mm256_loadu_pd( row3+j );
+            GRT_DISTANCE_KERNELS_AVX_TRANSPOSE( r0, r1, r2, r3, c[0], c[1], c[2], c[3] );
+            for(UINT k=0; k<4; k++){
+                dotSum = _mm256_add_pd( dotSum, _mm256_mul_pd( _mm256_set1_pd( x[j+k] ), c[k] ) );
+                magSum = _mm256_add_pd( magSum, _mm256_mul_pd( c[k], c[k] ) );
+            }
+        }
+        for(; j<numDimensions; j++){
+            const __m256d r = _mm256_set_pd( row3[j], row2[j], row1[j], row0[j] );
+            dotSum = _mm256_add_pd( dotSum, _mm256_mul_pd( _mm256_set1_pd( x[j] ), r ) );
+            magSum = _mm256_add_pd( magSum, _mm256_mul_pd( r, r ) );
+        }
+        _mm256_storeu_pd( dot, dotSum );
+        _mm256_storeu_pd( magRow, magSum );
+        for(UINT k=0; k<4; k++){
+            distances[i+k] = dot[k] / (magX * sqrt(magRow[k]));
+        }
+    }
+    _mm256_zeroupper();
+    if( i < numRows ) cosineSSE2( x, rows + (size_t)i*rowStride, numRows-i, rowStride, numDimensions, distances+i );
+}
+
+#endif //GRT_DISTANCE_KERNELS_AVX
+
+////////////////////////////////////// NEON Kernels //////////////////////////////////////
+//The same layout as the SSE2 kernels, two rows at a time with one row in each lane
+#if defined(GRT_DISTANCE_KERNELS_NEON)
+
+static void squaredEuclideanNEON(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    double column[2];
+    UINT i = 0;
+    for(; i+2<=numRows; i+=2){
+        const double *row0 = rows + (size_t)i*rowStride;
+        const double *row1 = row0 + rowStride;
+        float64x2_t sum = vdupq_n_f64( 0 );
+        float64x2_t d;
+        UINT j = 0;
+        for(; j+2<=numDimensions; j+=2){
+            const float64x2_t a = vld1q_f64( row0+j );
+            const float64x2_t b = vld1q_f64( row1+j );
+            d = vsubq_f64( vdupq_n_f64( x[j] ), vzip1q_f64( a, b ) );
+            sum = vaddq_f64( sum, vmulq_f64( d, d ) );
+            d = vsubq_f64( vdupq_n_f64( x[j+1] ), vzip2q_f64( a, b ) );
+            sum = vaddq_f64( sum, vmulq_f64( d, d ) );
+        }
+        for(; j<numDimensions; j++){
+            column[0] = row0[j];
+            column[1] = row1[j];
+            d = vsubq_f64( vdupq_n_f64( x[j] ), vld1q_f64( column ) );
+            sum = vaddq_f64( sum, vmulq_f64( d, d ) );
+        }
+        vst1q_f64( distances+i, sum );
+    }
+    if( i < numRows ) squaredEuclideanScalar( x, rows + (size_t)i*rowStride, numRows-i, rowStride, numDimensions, distances+i );
+}
+
+static void manhattanNEON(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    double column[2];
+    UINT i = 0;
+    for(; i+2<=numRows; i+=2){
+        const double *row0 = rows + (size_t)i*rowStride;
+        const double *row1 = row0 + rowStride;
+        float64x2_t sum = vdupq_n_f64( 0 );
+        UINT j = 0;
+        for(; j+2<=numDimensions; j+=2){
+            const float64x2_t a = vld1q_f64( row0+j );
+            const float64x2_t b = vld1q_f64( row1+j );
+            sum = vaddq_f64( sum, vabsq_f64( vsubq_f64( vdupq_n_f64( x[j] ), vzip1q_f64( a, b ) ) ) );
+            sum = vaddq_f64( sum, vabsq_f64( vsubq_f64( vdupq_n_f64( x[j+1] ), vzip2q_f64( a, b ) ) ) );
+        }
+        for(; j<numDimensions; j++){
+            column[0] = row0[j];
+            column[1] = row1[j];
+            sum = vaddq_f64( sum, vabsq_f64( vsubq_f64( vdupq_n_f64( x[j] ), vld1q_f64( column ) ) ) );
+        }
+        vst1q_f64( distances+i, sum );
+    }
+    if( i < numRows ) manhattanScalar( x, rows + (size_t)i*rowStride, numRows-i, rowStride, numDimensions, distances+i );
+}
+
+static void cosineNEON(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    const double magX = sqrt( computeSquaredMagnitude( x, numDimensions ) );
+    double column[2];
+    double dot[2];
+    double magRow[2];
+    UINT i = 0;
+    for(; i+2<=numRows; i+=2){
+        const double *row0 = rows + (size_t)i*rowStride;
+        const double *row1 = row0 + rowStride;
+        float64x2_t dotSum = vdupq_n_f64( 0 );
+        float64x2_t magSum = vdupq_n_f64( 0 );
+        float64x2_t r;
+        UINT j = 0;
+        for(; j+2<=numDimensions; j+=2){
+            const float64x2_t a = vld1q_f64( row0+j );
+            const float64x2_t b = vld1q_f64( row1+j );
+            r = vzip1q_f64( a, b );
+            dotSum = vaddq_f64( dotSum, vmulq_f64( vdupq_n_f64( x[j] ), r ) );
+            magSum = vaddq_f64( magSum, vmulq_f64( r, r ) );
+            r = vzip2q_f64( a, b );
+            dotSum = vaddq_f64( dotSum, vmulq_f64( vdupq_n_f64( x[j+1] ), r ) );
+            magSum = vaddq_f64( magSum, vmulq_f64( r, r ) );
+        }
+        for(; j<numDimensions; j++){
+            column[0] = row0[j];
+            column[1] = row1[j];
+            r = vld1q_f64( column );
+            dotSum = vaddq_f64( dotSum, vmulq_f64( vdupq_n_f64( x[j] ), r ) );
+            magSum = vaddq_f64( magSum, vmulq_f64( r, r ) );
+        }
+        vst1q_f64( dot, dotSum );
+        vst1q_f64( magRow, magSum );
+        distances[i] = dot[0] / (magX * sqrt(magRow[0]));
+        distances[i+1] = dot[1] / (magX * sqrt(magRow[1]));
+    }
+    if( i < numRows ) cosineScalar( x, rows + (size_t)i*rowStride, numRows-i, rowStride, numDimensions, distances+i );
+}
+
+#endif //GRT_DISTANCE_KERNELS_NEON
+
+////////////////////////////////////// Single Precision Kernels //////////////////////////////////////
+//The float kernels process one row at a time and spread the dimensions over the lanes, each lane keeps a partial sum that is
+//added together at the end of the row. Two accumulators are used so consecutive adds do not wait on each other
+
+typedef void (*FloatDistanceKernelFunction)(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances);
+
+struct FloatDistanceKernelTable{
+    FloatDistanceKernelFunction squaredEuclidean;
+    FloatDistanceKernelFunction manhattan;
+    FloatDistanceKernelFunction cosine;
+    const char *instructionSet;
+};
+
+static void squaredEuclideanFloatScalar(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        float dist = 0;
+        for(UINT j=0; j<numDimensions; j++){
+            const float d = x[j] - row[j];
+            dist += d * d;
+        }
+        distances[i] = dist;
+    }
+}
+
+static void manhattanFloatScalar(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        float dist = 0;
+        for(UINT j=0; j<numDimensions; j++){
+            dist += fabsf( x[j] - row[j] );
+        }
+        distances[i] = dist;
+    }
+}
+
+static void cosineFloatScalar(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    float magX = 0;
+    for(UINT j=0; j<numDimensions; j++){
+        magX += x[j] * x[j];
+    }
+    magX = sqrtf( magX );
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        float dot = 0;
+        float magRow = 0;
+        for(UINT j=0; j<numDimensions; j++){
+            dot += x[j] * row[j];
+            magRow += row[j] * row[j];
+        }
+        distances[i] = dot / (magX * sqrtf(magRow));
+    }
+}
+
+#if defined(GRT_DISTANCE_KERNELS_SSE2)
+
+static inline float horizontalSumSSE(const __m128 v){
+    __m128 sum = _mm_add_ps( v, _mm_movehl_ps( v, v ) );
+    sum = _mm_add_ss( sum, _mm_shuffle_ps( sum, sum, 1 ) );
+    return _mm_cvtss_f32( sum );
+}
+
+static void squaredEuclideanFloatSSE(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        UINT j = 0;
+        for(; j+8<=numDimensions; j+=8){
+            const __m128 d0 = _mm_sub_ps( _mm_loadu_ps( x+j ), _mm_loadu_ps( row+j ) );
+            const __m128 d1 = _mm_sub_ps( _mm_loadu_ps( x+j+4 ), _mm_loadu_ps( row+j+4 ) );
+            sum0 = _mm_add_ps( sum0, _mm_mul_ps( d0, d0 ) );
+            sum1 = _mm_add_ps( sum1, _mm_mul_ps( d1, d1 ) );
+        }
+        for(; j+4<=numDimensions; j+=4){
+            const __m128 d = _mm_sub_ps( _mm_loadu_ps( x+j ), _mm_loadu_ps( row+j ) );
+            sum0 = _mm_add_ps( sum0, _mm_mul_ps( d, d ) );
+        }
+        float dist = horizontalSumSSE( _mm_add_ps( sum0, sum1 ) );
+        for(; j<numDimensions; j++){
+            const float d = x[j] - row[j];
+            dist += d * d;
+        }
+        distances[i] = dist;
+    }
+}
+
+static void manhattanFloatSSE(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    const __m128 signMask = _mm_set1_ps( -0.0f );
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        UINT j = 0;
+        for(; j+8<=numDimensions; j+=8){
+            sum0 = _mm_add_ps( sum0, _mm_andnot_ps( signMask, _mm_sub_ps( _mm_loadu_ps( x+j ), _mm_loadu_ps( row+j ) ) ) );
+            sum1 = _mm_add_ps( sum1, _mm_andnot_ps( signMask, _mm_sub_ps( _mm_loadu_ps( x+j+4 ), _mm_loadu_ps( row+j+4 ) ) ) );
+        }
+        for(; j+4<=numDimensions; j+=4){
+            sum0 = _mm_add_ps( sum0, _mm_andnot_ps( signMask, _mm_sub_ps( _mm_loadu_ps( x+j ), _mm_loadu_ps( row+j ) ) ) );
+        }
+        float dist = horizontalSumSSE( _mm_add_ps( sum0, sum1 ) );
+        for(; j<numDimensions; j++){
+            dist += fabsf( x[j] - row[j] );
+        }
+        distances[i] = dist;
+    }
+}
+
+static void cosineFloatSSE(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    __m128 magSum = _mm_setzero_ps();
+    UINT j = 0;
+    for(; j+4<=numDimensions; j+=4){
+        const __m128 a = _mm_loadu_ps( x+j );
+        magSum = _mm_add_ps( magSum, _mm_mul_ps( a, a ) );
+    }
+    float magX = horizontalSumSSE( magSum );
+    for(; j<numDimensions; j++){
+        magX += x[j] * x[j];
+    }
+    magX = sqrtf( magX );
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        __m128 dotSum = _mm_setzero_ps();
+        magSum = _mm_setzero_ps();
+        for(j=0; j+4<=numDimensions; j+=4){
+            const __m128 r = _mm_loadu_ps( row+j );
+            dotSum = _mm_add_ps( dotSum, _mm_mul_ps( _mm_loadu_ps( x+j ), r ) );
+            magSum = _mm_add_ps( magSum, _mm_mul_ps( r, r ) );
+        }
+        float dot = horizontalSumSSE( dotSum );
+        float magRow = horizontalSumSSE( magSum );
+        for(; j<numDimensions; j++){
+            dot += x[j] * row[j];
+            magRow += row[j] * row[j];
+        }
+        distances[i] = dot / (magX * sqrtf(magRow));
+    }
+}
+
+#endif //GRT_DISTANCE_KERNELS_SSE2
+
+#if defined(GRT_DISTANCE_KERNELS_AVX)
+
+__attribute__((target("avx")))
+static inline float horizontalSumAVX(const __m256 v){
+    __m128 sum = _mm_add_ps( _mm256_castps256_ps128( v ), _mm256_extractf128_ps( v, 1 ) );
+    sum = _mm_add_ps( sum, _mm_movehl_ps( sum, sum ) );
+    sum = _mm_add_ss( sum, _mm_shuffle_ps( sum, sum, 1 ) );
+    return _mm_cvtss_f32( sum );
+}
+
+__attribute__((target("avx")))
+static void squaredEuclideanFloatAVX(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        UINT j = 0;
+        for(; j+16<=numDimensions; j+=16){
+            const __m256 d0 = _mm256_sub_ps( _mm256_loadu_ps( x+j ), _mm256_loadu_ps( row+j ) );
+            const __m256 d1 = _mm256_sub_ps( _mm256_loadu_ps( x+j+8 ), _mm256_loadu_ps( row+j+8 ) );
+            sum0 = _mm256_add_ps( sum0, _mm256_mul_ps( d0, d0 ) );
+            sum1 = _mm256_add_ps( sum1, _mm256_mul_ps( d1, d1 ) );
+        }
+        for(; j+8<=numDimensions; j+=8){
+            const __m256 d = _mm256_sub_ps( _mm256_loadu_ps( x+j ), _mm256_loadu_ps( row+j ) );
+            sum0 = _mm256_add_ps( sum0, _mm256_mul_ps( d, d ) );
+        }
+        float dist = horizontalSumAVX( _mm256_add_ps( sum0, sum1 ) );
+        for(; j<numDimensions; j++){
+            const float d = x[j] - row[j];
+            dist += d * d;
+        }
+        distances[i] = dist;
+    }
+}
+
+__attribute__((target("avx")))
+static void manhattanFloatAVX(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    const __m256 signMask = _mm256_set1_ps( -0.0f );
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        UINT j = 0;
+        for(; j+16<=numDimensions; j+=16){
+            sum0 = _mm256_add_ps( sum0, _mm256_andnot_ps( signMask, _mm256_sub_ps( _mm256_loadu_ps( x+j ), _mm256_loadu_ps( row+j ) ) ) );
+            sum1 = _mm256_add_ps( sum1, _mm256_andnot_ps( signMask, _mm256_sub_ps( _mm256_loadu_ps( x+j+8 ), _mm256_loadu_ps( row+j+8 ) ) ) );
+        }
+        for(; j+8<=numDimensions; j+=8){
+            sum0 = _mm256_add_ps( sum0, _mm256_andnot_ps( signMask, _mm256_sub_ps( _mm256_loadu_ps( x+j ), _mm256_loadu_ps( row+j ) ) ) );
+        }
+        float dist = horizontalSumAVX( _mm256_add_ps( sum0, sum1 ) );
+        for(; j<numDimensions; j++){
+            dist += fabsf( x[j] - row[j] );
+        }
+        distances[i] = dist;
+    }
+}
+
+__attribute__((target("avx")))
+static void cosineFloatAVX(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    __m256 magSum = _mm256_setzero_ps();
+    UINT j = 0;
+    for(; j+8<=numDimensions; j+=8){
+        const __m256 a = _mm256_loadu_ps( x+j );
+        magSum = _mm256_add_ps( magSum, _mm256_mul_ps( a, a ) );
+    }
+    float magX = horizontalSumAVX( magSum );
+    for(; j<numDimensions; j++){
+        magX += x[j] * x[j];
+    }
+    magX = sqrtf( magX );
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        __m256 dotSum = _mm256_setzero_ps();
+        magSum = _mm256_setzero_ps();
+        for(j=0; j+8<=numDimensions; j+=8){
+            const __m256 r = _mm256_loadu_ps( row+j );
+            dotSum = _mm256_add_ps( dotSum, _mm256_mul_ps( _mm256_loadu_ps( x+j ), r ) );
+            magSum = _mm256_add_ps( magSum, _mm256_mul_ps( r, r ) );
+        }
+        float dot = horizontalSumAVX( dotSum );
+        float magRow = horizontalSumAVX( magSum );
+        for(; j<numDimensions; j++){
+            dot += x[j] * row[j];
+            magRow += row[j] * row[j];
+        }
+        distances[i] = dot / (magX * sqrtf(magRow));
+    }
+}
+
+#endif //GRT_DISTANCE_KERNELS_AVX
+
+#if defined(GRT_DISTANCE_KERNELS_FLOAT_NEON)
+
+static inline float horizontalSumNEON(const float32x4_t v){
+    float32x2_t sum = vadd_f32( vget_low_f32( v ), vget_high_f32( v ) );
+    sum = vpadd_f32( sum, sum );
+    return vget_lane_f32( sum, 0 );
+}
+
+static void squaredEuclideanFloatNEON(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        float32x4_t sum0 = vdupq_n_f32( 0 );
+        float32x4_t sum1 = vdupq_n_f32( 0 );
+        UINT j = 0;
+        for(; j+8<=numDimensions; j+=8){
+            const float32x4_t d0 = vsubq_f32( vld1q_f32( x+j ), vld1q_f32( row+j ) );
+            const float32x4_t d1 = vsubq_f32( vld1q_f32( x+j+4 ), vld1q_f32( row+j+4 ) );
+            sum0 = vaddq_f32( sum0, vmulq_f32( d0, d0 ) );
+            sum1 = vaddq_f32( sum1, vmulq_f32( d1, d1 ) );
+        }
+        for(; j+4<=numDimensions; j+=4){
+            const float32x4_t d = vsubq_f32( vld1q_f32( x+j ), vld1q_f32( row+j ) );
+            sum0 = vaddq_f32( sum0, vmulq_f32( d, d ) );
+        }
+        float dist = horizontalSumNEON( vaddq_f32( sum0, sum1 ) );
+        for(; j<numDimensions; j++){
+            const float d = x[j] - row[j];
+            dist += d * d;
+        }
+        distances[i] = dist;
+    }
+}
+
+static void manhattanFloatNEON(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        float32x4_t sum0 = vdupq_n_f32( 0 );
+        float32x4_t sum1 = vdupq_n_f32( 0 );
+        UINT j = 0;
+        for(; j+8<=numDimensions; j+=8){
+            sum0 = vaddq_f32( sum0, vabdq_f32( vld1q_f32( x+j ), vld1q_f32( row+j ) ) );
+            sum1 = vaddq_f32( sum1, vabdq_f32( vld1q_f32( x+j+4 ), vld1q_f32( row+j+4 ) ) );
+        }
+        for(; j+4<=numDimensions; j+=4){
+            sum0 = vaddq_f32( sum0, vabdq_f32( vld1q_f32( x+j ), vld1q_f32( row+j ) ) );
+        }
+        float dist = horizontalSumNEON( vaddq_f32( sum0, sum1 ) );
+        for(; j<numDimensions; j++){
+            dist += fabsf( x[j] - row[j] );
+        }
+        distances[i] = dist;
+    }
+}
+
+static void cosineFloatNEON(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    float32x4_t magSum = vdupq_n_f32( 0 );
+    UINT j = 0;
+    for(; j+4<=numDimensions; j+=4){
+        const float32x4_t a = vld1q_f32( x+j );
+        magSum = vaddq_f32( magSum, vmulq_f32( a, a ) );
+    }
+    float magX = horizontalSumNEON( magSum );
+    for(; j<numDimensions; j++){
+        magX += x[j] * x[j];
+    }
+    magX = sqrtf( magX );
+    for(UINT i=0; i<numRows; i++){
+        const float *row = rows + (size_t)i*rowStride;
+        float32x4_t dotSum = vdupq_n_f32( 0 );
+        magSum = vdupq_n_f32( 0 );
+        for(j=0; j+4<=numDimensions; j+=4){
+            const float32x4_t r = vld1q_f32( row+j );
+            dotSum = vaddq_f32( dotSum, vmulq_f32( vld1q_f32( x+j ), r ) );
+            magSum = vaddq_f32( magSum, vmulq_f32( r, r ) );
+        }
+        float dot = horizontalSumNEON( dotSum );
+        float magRow = horizontalSumNEON( magSum );
+        for(; j<numDimensions; j++){
+            dot += x[j] * row[j];
+            magRow += row[j] * row[j];
+        }
+        distances[i] = dot / (magX * sqrtf(magRow));
+    }
+}
+
+#endif //GRT_DISTANCE_KERNELS_FLOAT_NEON
+
+////////////////////////////////////// Dispatch //////////////////////////////////////
+
+static DistanceKernelTable selectDistanceKernels(){
+    DistanceKernelTable table;
+    table.squaredEuclidean = squaredEuclideanScalar;
+    table.manhattan = manhattanScalar;
+    table.cosine = cosineScalar;
+    table.instructionSet = "SCALAR";
+
+#if defined(GRT_DISTANCE_KERNELS_NEON)
+    table.squaredEuclidean = squaredEuclideanNEON;
+    table.manhattan = manhattanNEON;
+    table.cosine = cosineNEON;
+    table.instructionSet = "NEON";
+#endif
+
+#if defined(GRT_DISTANCE_KERNELS_SSE2)
+    table.squaredEuclidean = squaredEuclideanSSE2;
+    table.manhattan = manhattanSSE2;
+    table.cosine = cosineSSE2;
+    table.instructionSet = "SSE2";
+#endif
+
+#if defined(GRT_DISTANCE_KERNELS_AVX)
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports("avx") ){
+        table.squaredEuclidean = squaredEuclideanAVX;
+        table.manhattan = manhattanAVX;
+        table.cosine = cosineAVX;
+        table.instructionSet = "AVX";
+    }
+#endif
+
+    return table;
+}
+
+static const DistanceKernelTable& getDistanceKernels(){
+    //The CPU is only checked the first time a kernel is used
+    static const DistanceKernelTable table = selectDistanceKernels();
+    return table;
+}
+
+void DistanceKernels::squaredEuclidean(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    getDistanceKernels().squaredEuclidean( x, rows, numRows, rowStride, numDimensions, distances );
+}
+
+void DistanceKernels::manhattan(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    getDistanceKernels().manhattan( x, rows, numRows, rowStride, numDimensions, distances );
+}
+
+void DistanceKernels::cosine(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances){
+    getDistanceKernels().cosine( x, rows, numRows, rowStride, numDimensions, distances );
+}
+
+double DistanceKernels::squaredEuclidean(const double *a,const double *b,const UINT numDimensions){
+    double dist = 0;
+    squaredEuclideanScalar( a, b, 1, numDimensions, numDimensions, &dist );
+    return dist;
+}
+
+double DistanceKernels::manhattan(const double *a,const double *b,const UINT numDimensions){
+    double dist = 0;
+    manhattanScalar( a, b, 1, numDimensions, numDimensions, &dist );
+    return dist;
+}
+
+double DistanceKernels::cosine(const double *a,const double *b,const UINT numDimensions){
+    double dist = 0;
+    cosineScalar( a, b, 1, numDimensions, numDimensions, &dist );
+    return dist;
+}
+
+static FloatDistanceKernelTable selectFloatDistanceKernels(){
+    FloatDistanceKernelTable table;
+    table.squaredEuclidean = squaredEuclideanFloatScalar;
+    table.manhattan = manhattanFloatScalar;
+    table.cosine = cosineFloatScalar;
+    table.instructionSet = "SCALAR";
+
+#if defined(GRT_DISTANCE_KERNELS_FLOAT_NEON)
+    table.squaredEuclidean = squaredEuclideanFloatNEON;
+    table.manhattan = manhattanFloatNEON;
+    table.cosine = cosineFloatNEON;
+    table.instructionSet = "NEON";
+#endif
+
+#if defined(GRT_DISTANCE_KERNELS_SSE2)
+    table.squaredEuclidean = squaredEuclideanFloatSSE;
+    table.manhattan = manhattanFloatSSE;
+    table.cosine = cosineFloatSSE;
+    table.instructionSet = "SSE";
+#endif
+
+#if defined(GRT_DISTANCE_KERNELS_AVX)
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports("avx") ){
+        table.squaredEuclidean = squaredEuclideanFloatAVX;
+        table.manhattan = manhattanFloatAVX;
+        table.cosine = cosineFloatAVX;
+        table.instructionSet = "AVX";
+    }
+#endif
+
+    return table;
+}
+
+static const FloatDistanceKernelTable& getFloatDistanceKernels(){
+    static const FloatDistanceKernelTable table = selectFloatDistanceKernels();
+    return table;
+}
+
+void DistanceKernels::squaredEuclidean(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    getFloatDistanceKernels().squaredEuclidean( x, rows, numRows, rowStride, numDimensions, distances );
+}
+
+void DistanceKernels::manhattan(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    getFloatDistanceKernels().manhattan( x, rows, numRows, rowStride, numDimensions, distances );
+}
+
+void DistanceKernels::cosine(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances){
+    getFloatDistanceKernels().cosine( x, rows, numRows, rowStride, numDimensions, distances );
+}
+
+std::string DistanceKernels::getInstructionSet(){
+    return getDistanceKernels().instructionSet;
+}
+
+std::string DistanceKernels::getFloatInstructionSet(){
+    return getFloatDistanceKernels().instructionSet;
+}
+
+} //End of namespace GRT
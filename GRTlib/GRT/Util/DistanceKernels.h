@@ -0,0 +1,189 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief This file contains the DistanceKernels class, a set of vectorized distance functions that are shared by the distance based
+ modules (KNN, MinDist, KMeans and DTW).
+
+ Each kernel computes the distance between one vector and a block of rows.  The rows are processed in parallel, one row per SIMD lane
+ (SSE2 or AVX on x86, NEON on 64-bit ARM, with a scalar fallback everywhere else), and each lane sums over the dimensions in the same
+ order as a plain loop would.  This means the results are the same for every row, regardless of the instruction set or how the rows
+ are grouped, and they match the scalar loops the modules used before.  The instruction set is selected at runtime the first time a
+ kernel is used.
+
+ The single precision kernels are used by the float prediction path of the classifiers.  They process one row at a time with the
+ dimensions spread over the SIMD lanes (4 floats for SSE and NEON, 8 for AVX), so they also run on 32-bit ARM, which has float NEON
+ but not double NEON.  The partial sums are added in a different order than a plain loop, so the results can differ from the scalar
+ loop in the last bits, but they are still the same on every call on the same machine.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_DISTANCE_KERNELS_HEADER
+#define GRT_DISTANCE_KERNELS_HEADER
+
+#include "GRTTypedefs.h"
+#include <string>
+
+namespace GRT{
+
+//The number of distances callers should buffer at a time when they stream through a large set of rows
+#define GRT_DISTANCE_KERNEL_BLOCK_SIZE 64
+
+class DistanceKernels{
+public:
+    /**
+     Default constructor.
+     */
+    DistanceKernels(){}
+
+    /**
+     Default destructor.
+     */
+    ~DistanceKernels(){}
+
+    /**
+     Computes the squared Euclidean distance between x and each row, i.e. distances[i] = sum_j (x[j]-rows[i*rowStride+j])^2.
+
+     @param const double *x: a pointer to the vector that will be compared against each row, this must have numDimensions values
+     @param const double *rows: a pointer to the first row
+     @param const UINT numRows: the number of rows
+     @param const UINT rowStride: the number of values between the start of each row
+     @param const UINT numDimensions: the number of dimensions in x and in each row
+     @param double *distances: the numRows distances will be written here
+     @return returns void
+     */
+    static void squaredEuclidean(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances);
+
+    /**
+     Computes the Manhattan distance between x and each row, i.e. distances[i] = sum_j |x[j]-rows[i*rowStride+j]|.
+
+     @param const double *x: a pointer to the vector that will be compared against each row, this must have numDimensions values
+     @param const double *rows: a pointer to the first row
+     @param const UINT numRows: the number of rows
+     @param const UINT rowStride: the number of values between the start of each row
+     @param const UINT numDimensions: the number of dimensions in x and in each row
+     @param double *distances: the numRows distances will be written here
+     @return returns void
+     */
+    static void manhattan(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances);
+
+    /**
+     Computes the cosine between x and each row, i.e. distances[i] = x.row / (|x| * |row|).
+
+     @param const double *x: a pointer to the vector that will be compared against each row, this must have numDimensions values
+     @param const double *rows: a pointer to the first row
+     @param const UINT numRows: the number of rows
+     @param const UINT rowStride: the number of values between the start of each row
+     @param const UINT numDimensions: the number of dimensions in x and in each row
+     @param double *distances: the numRows distances will be written here
+     @return returns void
+     */
+    static void cosine(const double *x,const double *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,double *distances);
+
+    /**
+     Computes the single precision squared Euclidean distance between x and each row, i.e. distances[i] = sum_j (x[j]-rows[i*rowStride+j])^2.
+
+     @param const float *x: a pointer to the vector that will be compared against each row, this must have numDimensions values
+     @param const float *rows: a pointer to the first row
+     @param const UINT numRows: the number of rows
+     @param const UINT rowStride: the number of values between the start of each row
+     @param const UINT numDimensions: the number of dimensions in x and in each row
+     @param float *distances: the numRows distances will be written here
+     @return returns void
+     */
+    static void squaredEuclidean(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances);
+
+    /**
+     Computes the single precision Manhattan distance between x and each row, i.e. distances[i] = sum_j |x[j]-rows[i*rowStride+j]|.
+
+     @param const float *x: a pointer to the vector that will be compared against each row, this must have numDimensions values
+     @param const float *rows: a pointer to the first row
+     @param const UINT numRows: the number of rows
+     @param const UINT rowStride: the number of values between the start of each row
+     @param const UINT numDimensions: the number of dimensions in x and in each row
+     @param float *distances: the numRows distances will be written here
+     @return returns void
+     */
+    static void manhattan(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances);
+
+    /**
+     Computes the single precision cosine between x and each row, i.e. distances[i] = x.row / (|x| * |row|).
+
+     @param const float *x: a pointer to the vector that will be compared against each row, this must have numDimensions values
+     @param const float *rows: a pointer to the first row
+     @param const UINT numRows: the number of rows
+     @param const UINT rowStride: the number of values between the start of each row
+     @param const UINT numDimensions: the number of dimensions in x and in each row
+     @param float *distances: the numRows distances will be written here
+     @return returns void
+     */
+    static void cosine(const float *x,const float *rows,const UINT numRows,const UINT rowStride,const UINT numDimensions,float *distances);
+
+    /**
+     Computes the squared Euclidean distance between a and b.
+
+     @param const double *a: a pointer to the first vector
+     @param const double *b: a pointer to the second vector
+     @param const UINT numDimensions: the number of dimensions in a and b
+     @return returns the squared Euclidean distance between a and b
+     */
+    static double squaredEuclidean(const double *a,const double *b,const UINT numDimensions);
+
+    /**
+     Computes the Manhattan distance between a and b.
+
+     @param const double *a: a pointer to the first vector
+     @param const double *b: a pointer to the second vector
+     @param const UINT numDimensions: the number of dimensions in a and b
+     @return returns the Manhattan distance between a and b
+     */
+    static double manhattan(const double *a,const double *b,const UINT numDimensions);
+
+    /**
+     Computes the cosine between a and b.
+
+     @param const double *a: a pointer to the first vector
+     @param const double *b: a pointer to the second vector
+     @param const UINT numDimensions: the number of dimensions in a and b
+     @return returns the cosine between a and b
+     */
+    static double cosine(const double *a,const double *b,const UINT numDimensions);
+
+    /**
+     Gets the name of the instruction set the kernels are using on this machine, this will be one of "AVX", "SSE2", "NEON" or "SCALAR".
+
+     @return returns the name of the instruction set being used by the kernels
+     */
+    static std::string getInstructionSet();
+
+    /**
+     Gets the name of the instruction set the single precision kernels are using on this machine, this will be one of "AVX", "SSE", "NEON" or "SCALAR".
+
+     @return returns the name of the instruction set being used by the single precision kernels
+     */
+    static std::string getFloatInstructionSet();
+};
+
+} //End of namespace GRT
+
+#endif //GRT_DISTANCE_KERNELS_HEADER
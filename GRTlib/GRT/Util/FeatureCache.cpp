@@ -0,0 +1,393 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "FeatureCache.h"
+
+namespace GRT{
+
+FeatureCache::FeatureCache(const unsigned long long maxMemorySize,const string &spillDirectory){
+    this->maxMemorySize = maxMemorySize;
+    this->spillDirectory = spillDirectory;
+    memorySize = 0;
+    numHits = 0;
+    numMisses = 0;
+    numSpilledEntries = 0;
+    numSpillFiles = 0;
+    pthread_mutex_init( &mutex, NULL );
+
+    debugLog.setProceedingText("[DEBUG FeatureCache]");
+    errorLog.setProceedingText("[ERROR FeatureCache]");
+    warningLog.setProceedingText("[WARNING FeatureCache]");
+}
+
+FeatureCache::~FeatureCache(){
+    clear();
+    pthread_mutex_destroy( &mutex );
+}
+
+bool FeatureCache::lookup(const unsigned long long key,MatrixDouble &data){
+    vector< UINT > sampleIndexes;
+    return lookup( key, data, sampleIndexes, vector< PreProcessing* >(), vector< FeatureExtraction* >() );
+}
+
+bool FeatureCache::lookup(const unsigned long long key,MatrixDouble &data,vector< UINT > &sampleIndexes,const vector< PreProcessing* > &preProcessingModules,const vector< FeatureExtraction* > &featureExtractionModules){
+
+    pthread_mutex_lock( &mutex );
+
+    EntryList::iterator iter;
+    bool found = findEntry( key, iter );
+
+    //The entry can only be used if it holds a copy of each module, so the modules can be left in the same state as if they had processed the data
+    if( found ){
+        if( iter->preProcessingModules.size() != preProcessingModules.size() || iter->featureExtractionModules.size() != featureExtractionModules.size() ){
+            found = false;
+        }
+        for(UINT i=0; i<preProcessingModules.size() && found; i++){
+            if( iter->preProcessingModules[i]->getPreProcessingType() != preProcessingModules[i]->getPreProcessingType() ) found = false;
+        }
+        for(UINT i=0; i<featureExtractionModules.size() && found; i++){
+            if( iter->featureExtractionModules[i]->getFeatureExtractionType() != featureExtractionModules[i]->getFeatureExtractionType() ) found = false;
+        }
+    }
+
+    if( found && iter->spilled ){
+        if( !loadSpilledEntry( *iter ) ){
+            removeEntry( iter );
+            found = false;
+        }
+    }
+
+    if( !found ){
+        numMisses++;
+        pthread_mutex_unlock( &mutex );
+        return false;
+    }
+
+    data = iter->data;
+    sampleIndexes = iter->sampleIndexes;
+    for(UINT i=0; i<preProcessingModules.size(); i++){
+        preProcessingModules[i]->deepCopyFrom( iter->preProcessingModules[i] );
+    }
+    for(UINT i=0; i<featureExtractionModules.size(); i++){
+        featureExtractionModules[i]->deepCopyFrom( iter->featureExtractionModules[i] );
+    }
+
+    //Move the entry to the front of the list, as it is now the most recently used entry
+    entries.splice( entries.begin(), entries, iter );
+    numHits++;
+
+    //Reading a spilled entry back into memory might have made the cache too large
+    enforceMaxMemorySize();
+
+    pthread_mutex_unlock( &mutex );
+
+    return true;
+}
+
+bool FeatureCache::insert(const unsigned long long key,const MatrixDouble &data){
+    return insert( key, data, vector< UINT >(), vector< PreProcessing* >(), vector< FeatureExtraction* >() );
+}
+
+bool FeatureCache::insert(const unsigned long long key,MatrixDouble data,const vector< UINT > &sampleIndexes,const vector< PreProcessing* > &preProcessingModules,const vector< FeatureExtraction* > &featureExtractionModules){
+
+    //Copy the modules before taking the lock, the copies are only owned by the entry once it has been added
+    vector< PreProcessing* > preProcessingCopies;
+    vector< FeatureExtraction* > featureExtractionCopies;
+    bool copied = true;
+    for(UINT i=0; i<preProcessingModules.size() && copied; i++){
+        PreProcessing *module = preProcessingModules[i]->createNewInstance();
+        if( module == NULL ){ copied = false; break; }
+        preProcessingCopies.push_back( module );
+        copied = module->deepCopyFrom( preProcessingModules[i] );
+    }
+    for(UINT i=0; i<featureExtractionModules.size() && copied; i++){
+        FeatureExtraction *module = featureExtractionModules[i]->createNewInstance();
+        if( module == NULL ){ copied = false; break; }
+        featureExtractionCopies.push_back( module );
+        copied = module->deepCopyFrom( featureExtractionModules[i] );
+    }
+
+    if( !copied ){
+        warningLog << "insert(...) - Failed to copy the modules, the entry will not be added to the cache!" << endl;
+        for(UINT i=0; i<preProcessingCopies.size(); i++) delete preProcessingCopies[i];
+        for(UINT i=0; i<featureExtractionCopies.size(); i++) delete featureExtractionCopies[i];
+        return false;
+    }
+
+    pthread_mutex_lock( &mutex );
+
+    EntryList::iterator iter;
+    if( findEntry( key, iter ) ){
+        removeEntry( iter );
+    }
+
+    entries.push_front( FeatureCacheEntry() );
+    FeatureCacheEntry &entry = entries.front();
+    entry.key = key;
+#if __cplusplus >= 201103L
+    entry.data = std::move( data );
+#else
+    entry.data = data;
+#endif
+    entry.sampleIndexes = sampleIndexes;
+    entry.preProcessingModules = preProcessingCopies;
+    entry.featureExtractionModules = featureExtractionCopies;
+    entryMap[ key ] = entries.begin();
+    memorySize += entry.getMemorySize();
+
+    enforceMaxMemorySize();
+
+    //The entry will have been removed if it is larger than the cache and it could not be spilled
+    const bool added = entryMap.find( key ) != entryMap.end();
+
+    pthread_mutex_unlock( &mutex );
+
+    return added;
+}
+
+bool FeatureCache::clear(){
+
+    pthread_mutex_lock( &mutex );
+
+    while( entries.size() > 0 ){
+        removeEntry( entries.begin() );
+    }
+    memorySize = 0;
+    numSpilledEntries = 0;
+
+    pthread_mutex_unlock( &mutex );
+
+    return true;
+}
+
+bool FeatureCache::setMaxMemorySize(const unsigned long long maxMemorySize){
+    pthread_mutex_lock( &mutex );
+    this->maxMemorySize = maxMemorySize;
+    enforceMaxMemorySize();
+    pthread_mutex_unlock( &mutex );
+    return true;
+}
+
+bool FeatureCache::setSpillDirectory(const string &spillDirectory){
+    pthread_mutex_lock( &mutex );
+    this->spillDirectory = spillDirectory;
+    pthread_mutex_unlock( &mutex );
+    return true;
+}
+
+unsigned long long FeatureCache::getMaxMemorySize() const{
+    pthread_mutex_lock( &mutex );
+    const unsigned long long value = maxMemorySize;
+    pthread_mutex_unlock( &mutex );
+    return value;
+}
+
+string FeatureCache::getSpillDirectory() const{
+    pthread_mutex_lock( &mutex );
+    const string value = spillDirectory;
+    pthread_mutex_unlock( &mutex );
+    return value;
+}
+
+unsigned long long FeatureCache::getMemorySize() const{
+    pthread_mutex_lock( &mutex );
+    const unsigned long long value = memorySize;
+    pthread_mutex_unlock( &mutex );
+    return value;
+}
+
+UINT FeatureCache::getNumEntries() const{
+    pthread_mutex_lock( &mutex );
+    const UINT value = (UINT)entries.size();
+    pthread_mutex_unlock( &mutex );
+    return value;
+}
+
+UINT FeatureCache::getNumSpilledEntries() const{
+    pthread_mutex_lock( &mutex );
+    const UINT value = numSpilledEntries;
+    pthread_mutex_unlock( &mutex );
+    return value;
+}
+
+unsigned long long FeatureCache::getNumHits() const{
+    pthread_mutex_lock( &mutex );
+    const unsigned long long value = numHits;
+    pthread_mutex_unlock( &mutex );
+    return value;
+}
+
+unsigned long long FeatureCache::getNumMisses() const{
+    pthread_mutex_lock( &mutex );
+    const unsigned long long value = numMisses;
+    pthread_mutex_unlock( &mutex );
+    return value;
+}
+
+unsigned long long FeatureCache::hash(const void *data,const size_t numBytes,const unsigned long long hash){
+    const unsigned long long m = GRT_FEATURE_CACHE_HASH_MULTIPLIER;
+    const int r = 47;
+    const unsigned char *bytes = (const unsigned char*)data;
+    const size_t numWords = numBytes / sizeof(unsigned long long);
+    unsigned long long value = hash ^ (numBytes * m);
+    
+    for(size_t i=0; i<numWords; i++){
+        unsigned long long k;
+        memcpy( &k, bytes + i*sizeof(unsigned long long), sizeof(unsigned long long) );
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        value ^= k;
+        value *= m;
+    }
+    
+    //Mix in the last few bytes
+    const unsigned char *tail = bytes + numWords*sizeof(unsigned long long);
+    const size_t numTailBytes = numBytes % sizeof(unsigned long long);
+    if( numTailBytes > 0 ){
+        for(size_t i=0; i<numTailBytes; i++) value ^= (unsigned long long)tail[i] << (8*i);
+        value *= m;
+    }
+    
+    value ^= value >> r;
+    value *= m;
+    value ^= value >> r;
+    return value;
+}
+
+unsigned long long FeatureCache::hash(const string &value,const unsigned long long hash){
+    //Include the length, so the boundary between two strings is part of the hash
+    const unsigned long long length = value.size();
+    return FeatureCache::hash( value.c_str(), value.size(), FeatureCache::hash( &length, sizeof(length), hash ) );
+}
+
+bool FeatureCache::findEntry(const unsigned long long key,EntryList::iterator &iter){
+    EntryMap::iterator mapIter = entryMap.find( key );
+    if( mapIter == entryMap.end() ) return false;
+    iter = mapIter->second;
+    return true;
+}
+
+void FeatureCache::removeEntry(EntryList::iterator iter){
+    if( iter->spilled ){
+        remove( iter->spillFilename.c_str() );
+        numSpilledEntries--;
+    }else{
+        memorySize -= iter->getMemorySize();
+    }
+    for(UINT i=0; i<iter->preProcessingModules.size(); i++){
+        delete iter->preProcessingModules[i];
+    }
+    for(UINT i=0; i<iter->featureExtractionModules.size(); i++){
+        delete iter->featureExtractionModules[i];
+    }
+    entryMap.erase( iter->key );
+    entries.erase( iter );
+}
+
+bool FeatureCache::spillEntry(FeatureCacheEntry &entry){
+
+    if( spillDirectory == "" ) return false;
+
+    char filename[64];
+    snprintf( filename, sizeof(filename), "grt_feature_cache_%p_%u.grtm", (void*)this, numSpillFiles++ );
+    const string spillFilename = spillDirectory + "/" + filename;
+
+    vector< UINT > dimensions(2);
+    dimensions[0] = entry.data.getNumRows();
+    dimensions[1] = entry.data.getNumCols();
+
+    BinaryModelWriter writer;
+    if( !writer.open( spillFilename ) ){
+        warningLog << "spillEntry(FeatureCacheEntry &entry) - Failed to create the spill file " << spillFilename << endl;
+        return false;
+    }
+    bool ok = writer.writeSection( "Dimensions", dimensions );
+    ok = ok && writer.writeSection( "Data", entry.data.getData(), (unsigned long long)entry.data.getSize()*sizeof(double) );
+    ok = ok && writer.writeSection( "SampleIndexes", entry.sampleIndexes );
+    ok = writer.close() && ok;
+    if( !ok ){
+        warningLog << "spillEntry(FeatureCacheEntry &entry) - Failed to write the spill file " << spillFilename << endl;
+        remove( spillFilename.c_str() );
+        return false;
+    }
+
+    memorySize -= entry.getMemorySize();
+    entry.data.clear();
+    entry.sampleIndexes.clear();
+    entry.spilled = true;
+    entry.spillFilename = spillFilename;
+    numSpilledEntries++;
+
+    return true;
+}
+
+bool FeatureCache::loadSpilledEntry(FeatureCacheEntry &entry){
+
+    BinaryModelReader reader;
+    if( !reader.open( entry.spillFilename, false ) ){
+        warningLog << "loadSpilledEntry(FeatureCacheEntry &entry) - Failed to open the spill file " << entry.spillFilename << endl;
+        return false;
+    }
+
+    UINT numDimensions = 0;
+    UINT numValues = 0;
+    UINT numSampleIndexes = 0;
+    const UINT *dimensions = reader.getSectionArray< UINT >( "Dimensions", numDimensions );
+    const double *data = reader.getSectionArray< double >( "Data", numValues );
+    const UINT *sampleIndexes = reader.getSectionArray< UINT >( "SampleIndexes", numSampleIndexes );
+    if( dimensions == NULL || numDimensions != 2 || (unsigned long long)dimensions[0]*dimensions[1] != numValues || (numValues > 0 && data == NULL) ){
+        warningLog << "loadSpilledEntry(FeatureCacheEntry &entry) - The spill file " << entry.spillFilename << " is not valid!" << endl;
+        return false;
+    }
+
+    if( numValues > 0 ){
+        entry.data.resize( dimensions[0], dimensions[1] );
+        std::copy( data, data + numValues, entry.data.getData() );
+    }
+    if( sampleIndexes != NULL ) entry.sampleIndexes.assign( sampleIndexes, sampleIndexes + numSampleIndexes );
+    reader.close();
+
+    remove( entry.spillFilename.c_str() );
+    entry.spilled = false;
+    entry.spillFilename = "";
+    numSpilledEntries--;
+    memorySize += entry.getMemorySize();
+
+    return true;
+}
+
+void FeatureCache::enforceMaxMemorySize(){
+
+    //Spill or remove the least recently used entries that are still in memory, until the cache is small enough
+    EntryList::iterator iter = entries.end();
+    while( memorySize > maxMemorySize && iter != entries.begin() ){
+        --iter;
+        if( iter->spilled ) continue;
+        if( !spillEntry( *iter ) ){
+            EntryList::iterator next = iter;
+            ++next;
+            removeEntry( iter );
+            iter = next;
+        }
+    }
+}
+
+} //End of namespace GRT
@@ -0,0 +1,202 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The LatencyHistogram class records how long a repeated operation takes (for example one module of a pipeline) in a fixed set of
+ log-spaced buckets, so the percentiles of the latency can be queried without storing every measurement.
+
+ Each power of two is split into 8 buckets, so a percentile is accurate to within 12.5% of its value, the minimum, maximum and mean are
+ exact.  Updating the histogram is O(1) and does not allocate any memory.  The histogram also counts how many of the operations failed.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_LATENCY_HISTOGRAM_HEADER
+#define GRT_LATENCY_HISTOGRAM_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class LatencyHistogram{
+public:
+    /**
+     Default Constructor.
+     */
+    LatencyHistogram(){
+        clear();
+    }
+
+    /**
+     Default Destructor.
+     */
+    ~LatencyHistogram(){}
+
+    /**
+     Removes all the measurements from the histogram.
+     */
+    void clear(){
+        numCalls = 0;
+        numFailures = 0;
+        totalTime = 0;
+        minimumTime = 0;
+        maximumTime = 0;
+        for(UINT i=0; i<NUM_BUCKETS; i++) buckets[i] = 0;
+    }
+
+    /**
+     Adds one measurement to the histogram.
+
+     @param const unsigned long long time: the time the operation took, in nanoseconds
+     @param const bool success: false if the operation failed, failed operations are still added to the latency histogram
+     */
+    inline void update(const unsigned long long time,const bool success = true){
+        if( numCalls == 0 || time < minimumTime ) minimumTime = time;
+        if( time > maximumTime ) maximumTime = time;
+        numCalls++;
+        if( !success ) numFailures++;
+        totalTime += time;
+        buckets[ getBucketIndex( time ) ]++;
+    }
+
+    /**
+     Adds all the measurements from the rhs histogram to this histogram.
+
+     @param const LatencyHistogram &rhs: the histogram to merge into this one
+     */
+    void merge(const LatencyHistogram &rhs){
+        if( rhs.numCalls == 0 ) return;
+        if( numCalls == 0 || rhs.minimumTime < minimumTime ) minimumTime = rhs.minimumTime;
+        if( rhs.maximumTime > maximumTime ) maximumTime = rhs.maximumTime;
+        numCalls += rhs.numCalls;
+        numFailures += rhs.numFailures;
+        totalTime += rhs.totalTime;
+        for(UINT i=0; i<NUM_BUCKETS; i++) buckets[i] += rhs.buckets[i];
+    }
+
+    /**
+     Gets the number of measurements that have been added to the histogram.
+
+     @return returns the number of calls
+     */
+    unsigned long long getNumCalls() const{ return numCalls; }
+
+    /**
+     Gets the number of measurements that were added with success set to false.
+
+     @return returns the number of failed calls
+     */
+    unsigned long long getNumFailures() const{ return numFailures; }
+
+    /**
+     Gets the total time of all the measurements.
+
+     @return returns the total time in microseconds
+     */
+    double getTotalTime() const{ return totalTime / 1000.0; }
+
+    /**
+     Gets the mean time of the measurements.
+
+     @return returns the mean time in microseconds, or zero if the histogram is empty
+     */
+    double getMeanTime() const{ return numCalls > 0 ? totalTime / (1000.0 * numCalls) : 0; }
+
+    /**
+     Gets the shortest measurement.
+
+     @return returns the minimum time in microseconds, or zero if the histogram is empty
+     */
+    double getMinimumTime() const{ return minimumTime / 1000.0; }
+
+    /**
+     Gets the longest measurement.
+
+     @return returns the maximum time in microseconds, or zero if the histogram is empty
+     */
+    double getMaximumTime() const{ return maximumTime / 1000.0; }
+
+    /**
+     Gets the time below which the given fraction of the measurements fall, for example 0.5 gives the median and 0.99 gives the 99th
+     percentile.  The result is the upper edge of the bucket that holds the percentile (limited to the range of the measurements), so it
+     may overestimate the true percentile by up to 12.5%.
+
+     @param const double percentile: the fraction of measurements, in the range [0 1]
+     @return returns the percentile in microseconds, or zero if the histogram is empty
+     */
+    double getPercentileTime(const double percentile) const{
+        if( numCalls == 0 ) return 0;
+
+        //Find the bucket that holds the ceil(percentile * numCalls)'th measurement
+        const double p = percentile < 0 ? 0 : (percentile > 1 ? 1 : percentile);
+        unsigned long long rank = (unsigned long long)ceil( p * numCalls );
+        if( rank == 0 ) rank = 1;
+
+        unsigned long long count = 0;
+        for(UINT i=0; i<NUM_BUCKETS; i++){
+            count += buckets[i];
+            if( count >= rank ){
+                unsigned long long time = getBucketUpperBound( i );
+                if( time > maximumTime ) time = maximumTime;
+                if( time < minimumTime ) time = minimumTime;
+                return time / 1000.0;
+            }
+        }
+        return getMaximumTime();
+    }
+
+protected:
+    //Values below 16ns get their own bucket, above that each power of two is split into 8 buckets, up to 2^40ns (about 18 minutes)
+    enum{NUM_SUB_BUCKETS=8,MAX_SHIFT=36,NUM_BUCKETS=NUM_SUB_BUCKETS*MAX_SHIFT+2*NUM_SUB_BUCKETS};
+
+    static inline UINT getBucketIndex(const unsigned long long time){
+        if( time < 2*NUM_SUB_BUCKETS ) return (UINT)time;
+
+        //The shift is the number of bits below the 4 most significant bits of the value
+#if defined(__GNUC__)
+        UINT shift = 63 - __builtin_clzll( time ) - 3;
+#else
+        UINT shift = 0;
+        while( (time >> shift) >= 2*NUM_SUB_BUCKETS ) shift++;
+#endif
+        if( shift > MAX_SHIFT ) return NUM_BUCKETS-1;
+        return NUM_SUB_BUCKETS*shift + (UINT)(time >> shift);
+    }
+
+    static inline unsigned long long getBucketUpperBound(const UINT bucketIndex){
+        if( bucketIndex < 2*NUM_SUB_BUCKETS ) return bucketIndex;
+        const UINT shift = bucketIndex / NUM_SUB_BUCKETS - 1;
+        const unsigned long long mantissa = bucketIndex - NUM_SUB_BUCKETS*shift;
+        return ((mantissa+1) << shift) - 1;
+    }
+
+    unsigned long long numCalls;
+    unsigned long long numFailures;
+    unsigned long long totalTime;           ///< The sum of the measurements in nanoseconds
+    unsigned long long minimumTime;
+    unsigned long long maximumTime;
+    unsigned long long buckets[ NUM_BUCKETS ];
+};
+
+}//End of namespace GRT
+
+#endif //GRT_LATENCY_HISTOGRAM_HEADER
@@ -19,6 +19,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include "MatrixDouble.h"
+#include "MatrixKernels.h"
+#include "RunningStatistics.h"
 
 namespace GRT{
    
@@ -28,12 +30,16 @@ MatrixDouble::MatrixDouble(){
     this->dataPtr = NULL;
     this->rows = 0;
     this->cols = 0;
+    this->capacity = 0;
 }
     
 MatrixDouble::MatrixDouble(const unsigned int rows,const unsigned int cols){
     warningLog.setProceedingText("[WARNING MatrixDouble]");
     errorLog.setProceedingText("[ERROR MatrixDouble]");
     this->dataPtr = NULL;
+    this->rows = 0;
+    this->cols = 0;
+    this->capacity = 0;
     if( rows > 0 && cols > 0 ){
         resize(rows, cols);
     }
@@ -43,34 +49,43 @@ MatrixDouble::MatrixDouble(const MatrixDouble &rhs){
     warningLog.setProceedingText("[WARNING MatrixDouble]");
     errorLog.setProceedingText("[ERROR MatrixDouble]");
     this->dataPtr = NULL;
-    this->rows = rhs.rows;
-    this->cols = rhs.cols;
-    if( rhs.dataPtr != NULL ){
-        this->dataPtr = new double*[rows];
-        for(unsigned int i=0; i<rows; i++){
-            dataPtr[i] = new double[cols];
-            for(unsigned int j=0; j<cols; j++)
-                this->dataPtr[i][j] = rhs.dataPtr[i][j];
-        }
-    }
-    
+    this->rows = 0;
+    this->cols = 0;
+    this->capacity = 0;
+    copyFrom( rhs );
 }
     
 MatrixDouble::MatrixDouble(const Matrix<double> &rhs){
     warningLog.setProceedingText("[WARNING MatrixDouble]");
     errorLog.setProceedingText("[ERROR MatrixDouble]");
     this->dataPtr = NULL;
-    this->rows = rhs.getNumRows();
-    this->cols = rhs.getNumCols();
-    if( this->rows > 0 && this->cols > 0 ){
-        this->dataPtr = new double*[rows];
-        for(unsigned int i=0; i<rows; i++){
-            dataPtr[i] = new double[cols];
-            for(unsigned int j=0; j<cols; j++)
-                this->dataPtr[i][j] = rhs[i][j];
-        }
-    }
+    this->rows = 0;
+    this->cols = 0;
+    this->capacity = 0;
+    copyFrom( rhs );
+}
+    
+#if __cplusplus >= 201103L
+MatrixDouble::MatrixDouble(MatrixDouble &&rhs){
+    warningLog.setProceedingText("[WARNING MatrixDouble]");
+    errorLog.setProceedingText("[ERROR MatrixDouble]");
+    this->dataPtr = NULL;
+    this->rows = 0;
+    this->cols = 0;
+    this->capacity = 0;
+    moveFrom( rhs );
 }
+    
+MatrixDouble::MatrixDouble(Matrix<double> &&rhs){
+    warningLog.setProceedingText("[WARNING MatrixDouble]");
+    errorLog.setProceedingText("[ERROR MatrixDouble]");
+    this->dataPtr = NULL;
+    this->rows = 0;
+    this->cols = 0;
+    this->capacity = 0;
+    moveFrom( rhs );
+}
+#endif
 
 MatrixDouble::~MatrixDouble(){
     clear();
@@ -78,34 +93,36 @@ MatrixDouble::~MatrixDouble(){
     
 MatrixDouble& MatrixDouble::operator=(const MatrixDouble &rhs){
     if( this != &rhs ){
-        this->clear();
-        this->rows = rhs.rows;
-        this->cols = rhs.cols;
-        dataPtr = new double*[rows];
-        for(unsigned int i=0; i<rows; i++){
-            dataPtr[i] = new double[cols];
-            for(unsigned int j=0; j<cols; j++)
-                this->dataPtr[i][j] = rhs.dataPtr[i][j];
-        }
+        copyFrom( rhs );
     }
     return *this;
 }
     
 MatrixDouble& MatrixDouble::operator=(const Matrix<double> &rhs){
     if( this != &rhs ){
-        this->clear();
-        this->rows = rhs.getNumRows();
-        this->cols = rhs.getNumCols();
-        dataPtr = new double*[rows];
-        for(unsigned int i=0; i<rows; i++){
-            dataPtr[i] = new double[cols];
-            for(unsigned int j=0; j<cols; j++)
-                this->dataPtr[i][j] = rhs[i][j];
-        }
+        copyFrom( rhs );
     }
     return *this;
 }
     
+#if __cplusplus >= 201103L
+MatrixDouble& MatrixDouble::operator=(MatrixDouble &&rhs){
+    if( this != &rhs ){
+        clear();
+        moveFrom( rhs );
+    }
+    return *this;
+}
+    
+MatrixDouble& MatrixDouble::operator=(Matrix<double> &&rhs){
+    if( this != &rhs ){
+        clear();
+        moveFrom( rhs );
+    }
+    return *this;
+}
+#endif
+    
 MatrixDouble& MatrixDouble::operator=(const vector< VectorDouble> &rhs){
     
     clear();
@@ -121,9 +138,7 @@ MatrixDouble& MatrixDouble::operator=(const vector< VectorDouble> &rhs){
             clear();
             return *this;
         }
-        for(unsigned int j=0; j<N; j++){
-            dataPtr[i][j] = rhs[i][j];
-        }
+        std::copy( rhs[i].begin(), rhs[i].end(), (*this)[i] );
     }
     
     return *this;
@@ -142,7 +157,7 @@ bool MatrixDouble::print(const string title){
     }
     for(unsigned int i=0; i<rows; i++){
         for(unsigned int j=0; j<cols; j++){
-            std::cout << dataPtr[i][j] << "\t";
+            std::cout << (*this)[i][j] << "\t";
         }
         std::cout << std::endl;
     }
@@ -157,7 +172,7 @@ bool MatrixDouble::transpose(){
     MatrixDouble temp(cols,rows);
     for(unsigned int i=0; i<rows; i++){
         for(unsigned int j=0; j<cols; j++){
-            temp[j][i] = dataPtr[i][j];
+            temp[j][i] = (*this)[i][j];
         }
     }
     
@@ -174,7 +189,7 @@ MatrixDouble MatrixDouble::multiple(const double value) const{
     
     for(unsigned int i=0; i<rows; i++){
         for(unsigned int j=0; j<cols; j++){
-            d[i][j] = dataPtr[i][j] * value;
+            d[i][j] = (*this)[i][j] * value;
         }
     }
     
@@ -183,28 +198,48 @@ MatrixDouble MatrixDouble::multiple(const double value) const{
     
 VectorDouble MatrixDouble::multiple(const VectorDouble &b) const{
     
+    VectorDouble c;
+    
+    if( !multiple(b,c) ) return VectorDouble();
+    
+    return c;
+}
+    
+MatrixDouble MatrixDouble::multiple(const MatrixDouble &b) const{
+    
+    MatrixDouble c;
+    
+    if( !multiple(b,c) ) return MatrixDouble();
+    
+    return c;
+}
+    
+bool MatrixDouble::multiple(const VectorDouble &b,VectorDouble &c) const{
+    
     const unsigned int M = rows;
     const unsigned int N = cols;
     const unsigned int K = (unsigned int)b.size();
     
     if( N != K ){
         warningLog << "multiple(vector b) - The size of b (" << b.size() << ") does not match the number of columns in this matrix (" << N << ")" << std::endl;
-        return VectorDouble();
+        return false;
     }
     
-    VectorDouble c(M);
-    
-    for(unsigned int i=0; i<rows; i++){
-        c[i] = 0;
-        for(unsigned int j=0; j<cols; j++){
-            c[i] += dataPtr[i][j]*b[j];
-        }
+    //The kernel can not write over its input, so if c is b then the results are computed in a temporary vector
+    if( &c == &b ){
+        VectorDouble temp( M );
+        if( M > 0 ) MatrixKernels::gemv( dataPtr, cols, &b[0], &temp[0], M, N );
+        c.swap( temp );
+        return true;
     }
     
-    return c;
+    if( c.size() != M ) c.resize( M );
+    if( M > 0 ) MatrixKernels::gemv( dataPtr, cols, N > 0 ? &b[0] : NULL, &c[0], M, N );
+    
+    return true;
 }
     
-MatrixDouble MatrixDouble::multiple(const MatrixDouble &b) const{
+bool MatrixDouble::multiple(const MatrixDouble &b,MatrixDouble &c,const UINT numThreads) const{
     
     const unsigned int M = rows;
     const unsigned int N = cols;
@@ -213,21 +248,26 @@ MatrixDouble MatrixDouble::multiple(const MatrixDouble &b) const{
     
     if( N != K ) {
         warningLog << "multiple(MatrixDouble b) - The number of rows in b (" << b.getNumRows() << ") does not match the number of columns in this matrix (" << N << ")" << std::endl;
-        return MatrixDouble();
+        return false;
     }
     
-    MatrixDouble c(M,L);
+    if( M == 0 || L == 0 ){
+        c.clear();
+        return true;
+    }
     
-    for(unsigned int i=0; i<M; i++){
-        for(unsigned int j=0; j<L; j++){
-            c[i][j] = 0;
-            for(unsigned int k=0; k<K; k++){
-                c[i][j] += dataPtr[i][k] * b[k][j];
-            }
-        }
+    //The kernel can not write over its inputs, so if c is this matrix or b then the results are computed in a temporary matrix
+    if( &c == this || &c == &b ){
+        MatrixDouble temp(M,L);
+        MatrixKernels::gemm( dataPtr, cols, b.getData(), b.getStride(), temp.getData(), temp.getStride(), M, N, L, numThreads );
+        c = temp;
+        return true;
     }
     
-    return c;
+    if( c.getNumRows() != M || c.getNumCols() != L ) c.resize(M,L);
+    MatrixKernels::gemm( dataPtr, cols, b.getData(), b.getStride(), c.getData(), c.getStride(), M, N, L, numThreads );
+    
+    return true;
 }
     
 VectorDouble MatrixDouble::getMean() const{
@@ -237,7 +277,7 @@ VectorDouble MatrixDouble::getMean() const{
     for(unsigned int c=0; c<cols; c++){
         mean[c] = 0;
         for(unsigned int r=0; r<rows; r++){
-            mean[c] += dataPtr[r][c];
+            mean[c] += (*this)[r][c];
         }
         mean[c] /= double( rows );
     }
@@ -247,54 +287,35 @@ VectorDouble MatrixDouble::getMean() const{
     
 VectorDouble MatrixDouble::getStdDev() const{
     
-    VectorDouble mean = getMean();
-	VectorDouble stdDev(cols,0);
-	
-	for(unsigned int j=0; j<cols; j++){
-		for(unsigned int i=0; i<rows; i++){
-			stdDev[j] += (dataPtr[i][j]-mean[j])*(dataPtr[i][j]-mean[j]);
-		}
-		stdDev[j] = sqrt( stdDev[j] / double(rows-1) );
-	}
-    return stdDev;
+    //The mean and variance are computed together in a single pass
+    RunningStatistics stats( cols );
+    stats.update( *this );
+    return stats.getStdDev();
 }
 
 MatrixDouble MatrixDouble::getCovarianceMatrix() const{
     
-    vector<double> mean = getMean();
-    MatrixDouble covMatrix(cols,cols);
-    
-    for(unsigned int j=0; j<cols; j++){
-        for(unsigned int k=0; k<cols; k++){
-            covMatrix[j][k] = 0;
-            for(unsigned int i=0; i<rows; i++){
-                covMatrix[j][k] += (dataPtr[i][j]-mean[j]) * (dataPtr[i][k]-mean[k]);
-            }
-            covMatrix[j][k] /= double(rows-1);
-        }
-    }
-    
-    return covMatrix;
+    //The mean and covariance are computed together in a single pass
+    RunningStatistics stats( cols, true );
+    stats.update( *this );
+    return stats.getCovarianceMatrix();
 }
     
 std::vector< MinMax > MatrixDouble::getRanges() const{
     
     if( rows == 0 ) return std::vector< MinMax >();
     
-    vector< MinMax > ranges(cols);
-    for(unsigned int i=0; i<rows; i++){
-        for(unsigned int j=0; j<cols; j++){
-            ranges[j].updateMinMax( dataPtr[i][j] );
-        }
-    }
-    return ranges;
+    //The ranges are tracked by the same single pass as the mean and variance, so they start from the first row rather than from 0
+    RunningStatistics stats( cols );
+    stats.update( *this );
+    return stats.getRanges();
 }
     
 double MatrixDouble::getTrace() const{
     double t = 0;
     unsigned int K = (rows < cols ? rows : cols);
     for(unsigned int i=0; i < K; i++) {
-        t += dataPtr[i][i];
+        t += (*this)[i][i];
     }
     return t;
 }
@@ -310,7 +331,7 @@ bool MatrixDouble::saveToCSVFile(const string &filename){
     
 	for(UINT i=0; i<rows; i++){
 		for(UINT j=0; j<cols; j++){
-			file << dataPtr[i][j] << (j<cols-1 ? "," : "\n");
+			file << (*this)[i][j] << (j<cols-1 ? "," : "\n");
 		}
 	}
     
@@ -343,7 +364,7 @@ bool MatrixDouble::loadFromCSVFile(const string &filename){
         
         //Get the input vector
         for(UINT j=0; j<cols; j++){
-            dataPtr[i][j] = Util::stringToDouble( parser[i][j] );
+            (*this)[i][j] = Util::stringToDouble( parser[i][j] );
         }
     }
     
@@ -0,0 +1,97 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MatrixFloat.h"
+
+namespace GRT{
+
+MatrixFloat::MatrixFloat(){
+}
+
+MatrixFloat::MatrixFloat(const unsigned int rows,const unsigned int cols){
+    if( rows > 0 && cols > 0 ){
+        resize(rows, cols);
+    }
+}
+
+MatrixFloat::MatrixFloat(const MatrixFloat &rhs){
+    copyFrom( rhs );
+}
+
+MatrixFloat::MatrixFloat(const Matrix<float> &rhs){
+    copyFrom( rhs );
+}
+
+MatrixFloat::MatrixFloat(const Matrix<double> &rhs){
+    copyFromDouble( rhs );
+}
+
+MatrixFloat::~MatrixFloat(){
+    clear();
+}
+
+MatrixFloat& MatrixFloat::operator=(const MatrixFloat &rhs){
+    if( this != &rhs ){
+        copyFrom( rhs );
+    }
+    return *this;
+}
+
+MatrixFloat& MatrixFloat::operator=(const Matrix<float> &rhs){
+    if( this != &rhs ){
+        copyFrom( rhs );
+    }
+    return *this;
+}
+
+MatrixFloat& MatrixFloat::operator=(const Matrix<double> &rhs){
+    copyFromDouble( rhs );
+    return *this;
+}
+
+bool MatrixFloat::copyFromDouble(const Matrix<double> &rhs){
+    const double *src = rhs.getData();
+    if( src == NULL || rhs.getSize() == 0 ){
+        clear();
+        return true;
+    }
+    if( !resize( rhs.getNumRows(), rhs.getNumCols() ) ){
+        return false;
+    }
+    const size_t size = rhs.getSize();
+    for(size_t i=0; i<size; i++){
+        dataPtr[i] = float( src[i] );
+    }
+    return true;
+}
+
+Matrix<double> MatrixFloat::toDouble() const{
+    Matrix<double> m;
+    if( dataPtr == NULL || getSize() == 0 ) return m;
+    m.resize( rows, cols );
+    double *dst = m.getData();
+    const size_t size = getSize();
+    for(size_t i=0; i<size; i++){
+        dst[i] = dataPtr[i];
+    }
+    return m;
+}
+
+} //End of namespace GRT
@@ -0,0 +1,621 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MatrixKernels.h"
+#include <cstddef>
+#include <vector>
+#include <pthread.h>
+
+//SSE2 is part of every x86-64 build, so it is used whenever the compiler enables it
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define GRT_MATRIX_KERNELS_SSE2
+#endif
+
+//The AVX kernels are compiled with a target attribute and only used if the CPU supports AVX, so the library does not need -mavx.
+//FMA is deliberately not used, a fused multiply-add rounds differently from the plain loops
+#if defined(GRT_MATRIX_KERNELS_SSE2) && defined(__GNUC__) && !defined(__clang__) && ( __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) )
+#include <immintrin.h>
+#define GRT_MATRIX_KERNELS_AVX
+#endif
+
+//Only 64-bit ARM has double precision NEON, 32-bit ARM builds use the scalar kernels
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GRT_MATRIX_KERNELS_NEON
+#endif
+
+//32-bit ARM does have single precision NEON, so the float gemv kernel uses NEON on any ARM build that enables it
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define GRT_MATRIX_KERNELS_FLOAT_NEON
+#endif
+
+//The gemm block sizes: a [MC KC] block of a stays in the L2 cache, a [KC NR] strip of the packed b block stays in the L1 cache
+#define GRT_MATRIX_KERNELS_MC 64
+#define GRT_MATRIX_KERNELS_KC 128
+#define GRT_MATRIX_KERNELS_NC 1024
+//Each gemm kernel computes a tile of MR rows by NR columns of c, NR depends on the instruction set but is never more than MAX_NR
+#define GRT_MATRIX_KERNELS_MR 4
+#define GRT_MATRIX_KERNELS_MAX_NR 8
+
+namespace GRT{
+
+typedef void (*GemmKernelFunction)(const double *a0,const double *a1,const double *a2,const double *a3,const double *packedB,const UINT kc,double *c,const UINT cStride);
+typedef void (*GemvKernelFunction)(const double *a,const UINT aStride,const double *x,double *y,const UINT M,const UINT N);
+typedef void (*GemvFloatKernelFunction)(const float *a,const UINT aStride,const float *x,float *y,const UINT M,const UINT N);
+
+struct MatrixKernelTable{
+    GemmKernelFunction gemm;
+    UINT gemmNR;
+    GemvKernelFunction gemv;
+    GemvFloatKernelFunction gemvFloat;
+    const char *instructionSet;
+};
+
+////////////////////////////////////// Scalar Kernels //////////////////////////////////////
+//The gemm kernels add a[r][k]*b[k][j] to the tile of c for each k in order, the [KC NR] strip of b is packed so row k starts at k*NR
+
+static void gemmScalar(const double *a0,const double *a1,const double *a2,const double *a3,const double *packedB,const UINT kc,double *c,const UINT cStride){
+    const double *a[GRT_MATRIX_KERNELS_MR] = {a0,a1,a2,a3};
+    double sum[GRT_MATRIX_KERNELS_MR][4];
+    for(UINT r=0; r<GRT_MATRIX_KERNELS_MR; r++){
+        for(UINT j=0; j<4; j++){
+            sum[r][j] = c[ (size_t)r*cStride + j ];
+        }
+    }
+    for(UINT k=0; k<kc; k++){
+        const double *b = packedB + (size_t)k*4;
+        for(UINT r=0; r<GRT_MATRIX_KERNELS_MR; r++){
+            const double ar = a[r][k];
+            for(UINT j=0; j<4; j++){
+                sum[r][j] += ar * b[j];
+            }
+        }
+    }
+    for(UINT r=0; r<GRT_MATRIX_KERNELS_MR; r++){
+        for(UINT j=0; j<4; j++){
+            c[ (size_t)r*cStride + j ] = sum[r][j];
+        }
+    }
+}
+
+static void gemvScalar(const double *a,const UINT aStride,const double *x,double *y,const UINT M,const UINT N){
+    for(UINT i=0; i<M; i++){
+        const double *row = a + (size_t)i*aStride;
+        double sum = 0;
+        for(UINT j=0; j<N; j++){
+            sum += row[j] * x[j];
+        }
+        y[i] = sum;
+    }
+}
+
+//The float gemv kernels process one row at a time with the columns spread over the lanes, the lanes are added together at the end of the row
+static void gemvFloatScalar(const float *a,const UINT aStride,const float *x,float *y,const UINT M,const UINT N){
+    for(UINT i=0; i<M; i++){
+        const float *row = a + (size_t)i*aStride;
+        float sum = 0;
+        for(UINT j=0; j<N; j++){
+            sum += row[j] * x[j];
+        }
+        y[i] = sum;
+    }
+}
+
+////////////////////////////////////// SSE2 Kernels //////////////////////////////////////
+//The gemm kernel keeps a [4 4] tile of c in eight registers, the gemv kernel processes two rows at a time with one row in each lane
+#if defined(GRT_MATRIX_KERNELS_SSE2)
+
+static void gemmSSE2(const double *a0,const double *a1,const double *a2,const double *a3,const double *packedB,const UINT kc,double *c,const UINT cStride){
+    double *c0 = c;
+    double *c1 = c0 + cStride;
+    double *c2 = c1 + cStride;
+    double *c3 = c2 + cStride;
+    __m128d c00 = _mm_loadu_pd( c0 ), c01 = _mm_loadu_pd( c0+2 );
+    __m128d c10 = _mm_loadu_pd( c1 ), c11 = _mm_loadu_pd( c1+2 );
+    __m128d c20 = _mm_loadu_pd( c2 ), c21 = _mm_loadu_pd( c2+2 );
+    __m128d c30 = _mm_loadu_pd( c3 ), c31 = _mm_loadu_pd( c3+2 );
+    for(UINT k=0; k<kc; k++){
+        const double *b = packedB + (size_t)k*4;
+        const __m128d b0 = _mm_loadu_pd( b );
+        const __m128d b1 = _mm_loadu_pd( b+2 );
+        __m128d a = _mm_set1_pd( a0[k] );
+        c00 = _mm_add_pd( c00, _mm_mul_pd( a, b0 ) );
+        c01 = _mm_add_pd( c01, _mm_mul_pd( a, b1 ) );
+        a = _mm_set1_pd( a1[k] );
+        c10 = _mm_add_pd( c10, _mm_mul_pd( a, b0 ) );
+        c11 = _mm_add_pd( c11, _mm_mul_pd( a, b1 ) );
+        a = _mm_set1_pd( a2[k] );
+        c20 = _mm_add_pd( c20, _mm_mul_pd( a, b0 ) );
+        c21 = _mm_add_pd( c21, _mm_mul_pd( a, b1 ) );
+        a = _mm_set1_pd( a3[k] );
+        c30 = _mm_add_pd( c30, _mm_mul_pd( a, b0 ) );
+        c31 = _mm_add_pd( c31, _mm_mul_pd( a, b1 ) );
+    }
+    _mm_storeu_pd( c0, c00 ); _mm_storeu_pd( c0+2, c01 );
+    _mm_storeu_pd( c1, c10 ); _mm_storeu_pd( c1+2, c11 );
+    _mm_storeu_pd( c2, c20 ); _mm_storeu_pd( c2+2, c21 );
+    _mm_storeu_pd( c3, c30 ); _mm_storeu_pd( c3+2, c31 );
+}
+
+static void gemvSSE2(const double *a,const UINT aStride,const double *x,double *y,const UINT M,const UINT N){
+    UINT i = 0;
+    for(; i+2<=M; i+=2){
+        const double *row0 = a + (size_t)i*aStride;
+        const double *row1 = row0 + aStride;
+        __m128d sum = _mm_setzero_pd();
+        UINT j = 0;
+        for(; j+2<=N; j+=2){
+            const __m128d r0 = _mm_loadu_pd( row0+j );
+            const __m128d r1 = _mm_loadu_pd( row1+j );
+            sum = _mm_add_pd( sum, _mm_mul_pd( _mm_unpacklo_pd( r0, r1 ), _mm_set1_pd( x[j] ) ) );
+            sum = _mm_add_pd( sum, _mm_mul_pd( _mm_unpackhi_pd( r0, r1 ), _mm_set1_pd( x[j+1] ) ) );
+        }
+        for(; j<N; j++){
+            sum = _mm_add_pd( sum, _mm_mul_pd( _mm_set_pd( row1[j], row0[j] ), _mm_set1_pd( x[j] ) ) );
+        }
+        _mm_storeu_pd( y+i, sum );
+    }
+    if( i < M ) gemvScalar( a + (size_t)i*aStride, aStride, x, y+i, M-i, N );
+}
+
+static void gemvFloatSSE(const float *a,const UINT aStride,const float *x,float *y,const UINT M,const UINT N){
+    for(UINT i=0; i<M; i++){
+        const float *row = a + (size_t)i*aStride;
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        UINT j = 0;
+        for(; j+8<=N; j+=8){
+            sum0 = _mm_add_ps( sum0, _mm_mul_ps( _mm_loadu_ps( row+j ), _mm_loadu_ps( x+j ) ) );
+            sum1 = _mm_add_ps( sum1, _mm_mul_ps( _mm_loadu_ps( row+j+4 ), _mm_loadu_ps( x+j+4 ) ) );
+        }
+        for(; j+4<=N; j+=4){
+            sum0 = _mm_add_ps( sum0, _mm_mul_ps( _mm_loadu_ps( row+j ), _mm_loadu_ps( x+j ) ) );
+        }
+        sum0 = _mm_add_ps( sum0, sum1 );
+        sum0 = _mm_add_ps( sum0, _mm_movehl_ps( sum0, sum0 ) );
+        sum0 = _mm_add_ss( sum0, _mm_shuffle_ps( sum0, sum0, 1 ) );
+        float sum = _mm_cvtss_f32( sum0 );
+        for(; j<N; j++){
+            sum += row[j] * x[j];
+        }
+        y[i] = sum;
+    }
+}
+
+#endif //GRT_MATRIX_KERNELS_SSE2
+
+////////////////////////////////////// AVX Kernels //////////////////////////////////////
+//The gemm kernel keeps a [4 8] tile of c in eight registers, the gemv kernel processes four rows at a time with a 4x4 transpose
+#if defined(GRT_MATRIX_KERNELS_AVX)
+
+#define GRT_MATRIX_KERNELS_AVX_TRANSPOSE(r0,r1,r2,r3,c0,c1,c2,c3) {         \
+    const __m256d t0 = _mm256_unpacklo_pd( r0, r1 );                        \
+    const __m256d t1 = _mm256_unpackhi_pd( r0, r1 );                        \
+    const __m256d t2 = _mm256_unpacklo_pd( r2, r3 );                        \
+    const __m256d t3 = _mm256_unpackhi_pd( r2, r3 );                        \
+    c0 = _mm256_permute2f128_pd( t0, t2, 0x20 );                            \
+    c1 = _mm256_permute2f128_pd( t1, t3, 0x20 );                            \
+    c2 = _mm256_permute2f128_pd( t0, t2, 0x31 );                            \
+    c3 = _mm256_permute2f128_pd( t1, t3, 0x31 );                            \
+}
+
+__attribute__((target("avx")))
+static void gemmAVX(const double *a0,const double *a1,const double *a2,const double *a3,const double *packedB,const UINT kc,double *c,const UINT cStride){
+    double *c0 = c;
+    double *c1 = c0 + cStride;
+    double *c2 = c1 + cStride;
+    double *c3 = c2 + cStride;
+    __m256d c00 = _mm256_loadu_pd( c0 ), c01 = _mm256_loadu_pd( c0+4 );
+    __m256d c10 = _mm256_loadu_pd( c1 ), c11 = _mm256_loadu_pd( c1+4 );
+    __m256d c20 = _mm256_loadu_pd( c2 ), c21 = _mm256_loadu_pd( c2+4 );
+    __m256d c30 = _mm256_loadu_pd( c3 ), c31 = _mm256_loadu_pd( c3+4 );
+    for(UINT k=0; k<kc; k++){
+        const double *b = packedB + (size_t)k*8;
+        const __m256d b0 = _mm256_loadu_pd( b );
+        const __m256d b1 = _mm256_loadu_pd( b+4 );
+        __m256d a = _mm256_broadcast_sd( a0+k );
+        c00 = _mm256_add_pd( c00, _mm256_mul_pd( a, b0 ) );
+        c01 = _mm256_add_pd( c01, _mm256_mul_pd( a, b1 ) );
+        a = _mm256_broadcast_sd( a1+k );
+        c10 = _mm256_add_pd( c10, _mm256_mul_pd( a, b0 ) );
+        c11 = _mm256_add_pd( c11, _mm256_mul_pd( a, b1 ) );
+        a = _mm256_broadcast_sd( a2+k );
+        c20 = _mm256_add_pd( c20, _mm256_mul_pd( a, b0 ) );
+        c21 = _mm256_add_pd( c21, _mm256_mul_pd( a, b1 ) );
+        a = _mm256_broadcast_sd( a3+k );
+        c30 = _mm256_add_pd( c30, _mm256_mul_pd( a, b0 ) );
+        c31 = _mm256_add_pd( c31, _mm256_mul_pd( a, b1 ) );
+    }
+    _mm256_storeu_pd( c0, c00 ); _mm256_storeu_pd( c0+4, c01 );
+    _mm256_storeu_pd( c1, c10 ); _mm256_storeu_pd( c1+4, c11 );
+    _mm256_storeu_pd( c2, c20 ); _mm256_storeu_pd( c2+4, c21 );
+    _mm256_storeu_pd( c3, c30 ); _mm256_storeu_pd( c3+4, c31 );
+}
+
+__attribute__((target("avx")))
+static void gemvAVX(const double *a,const UINT aStride,const double *x,double *y,const UINT M,const UINT N){
+    UINT i = 0;
+    for(; i+4<=M; i+=4){
+        const double *row0 = a + (size_t)i*aStride;
+        const double *row1 = row0 + aStride;
+        const double *row2 = row1 + aStride;
+        const double *row3 = row2 + aStride;
+        __m256d sum = _mm256_setzero_pd();
+        __m256d c[4];
+        UINT j = 0;
+        for(; j+4<=N; j+=4){
+            const __m256d r0 = _mm256_loadu_pd( row0+j );
+            const __m256d r1 = _mm256_loadu_pd( row1+j );
+            const __m256d r2 = _mm256_loadu_pd( row2+j );
+            const __m256d r3 = _mm256_loadu_pd( row3+j );
+            GRT_MATRIX_KERNELS_AVX_TRANSPOSE( r0, r1, r2, r3, c[0], c[1], c[2], c[3] );
+            for(UINT k=0; k<4; k++){
+                sum = _mm256_add_pd( sum, _mm256_mul_pd( c[k], _mm256_set1_pd( x[j+k] ) ) );
+            }
+        }
+        for(; j<N; j++){
+            sum = _mm256_add_pd( sum, _mm256_mul_pd( _mm256_set_pd( row3[j], row2[j], row1[j], row0[j] ), _mm256_set1_pd( x[j] ) ) );
+        }
+        _mm256_storeu_pd( y+i, sum );
+    }
+    //Clear the upper halves of the AVX registers before the SSE2 kernel, see squaredEuclideanAVX in DistanceKernels.cpp
+    _mm256_zeroupper();
+    if( i < M ) gemvSSE2( a + (size_t)i*aStride, aStride, x, y+i, M-i, N );
+}
+
+__attribute__((target("avx")))
+static void gemvFloatAVX(const float *a,const UINT aStride,const float *x,float *y,const UINT M,const UINT N){
+    for(UINT i=0; i<M; i++){
+        const float *row = a + (size_t)i*aStride;
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        UINT j = 0;
+        for(; j+16<=N; j+=16){
+            sum0 = _mm256_add_ps( sum0, _mm256_mul_ps( _mm256_loadu_ps( row+j ), _mm256_loadu_ps( x+j ) ) );
+            sum1 = _mm256_add_ps( sum1, _mm256_mul_ps( _mm256_loadu_ps( row+j+8 ), _mm256_loadu_ps( x+j+8 ) ) );
+        }
+        for(; j+8<=N; j+=8){
+            sum0 = _mm256_add_ps( sum0, _mm256_mul_ps( _mm256_loadu_ps( row+j ), _mm256_loadu_ps( x+j ) ) );
+        }
+        sum0 = _mm256_add_ps( sum0, sum1 );
+        __m128 s = _mm_add_ps( _mm256_castps256_ps128( sum0 ), _mm256_extractf128_ps( sum0, 1 ) );
+        s = _mm_add_ps( s, _mm_movehl_ps( s, s ) );
+        s = _mm_add_ss( s, _mm_shuffle_ps( s, s, 1 ) );
+        float sum = _mm_cvtss_f32( s );
+        for(; j<N; j++){
+            sum += row[j] * x[j];
+        }
+        y[i] = sum;
+    }
+}
+
+#endif //GRT_MATRIX_KERNELS_AVX
+
+////////////////////////////////////// NEON Kernels //////////////////////////////////////
+//The same layout as the SSE2 kernels
+#if defined(GRT_MATRIX_KERNELS_NEON)
+
+static void gemmNEON(const double *a0,const double *a1,const double *a2,const double *a3,const double *packedB,const UINT kc,double *c,const UINT cStride){
+    double *c0 = c;
+    double *c1 = c0 + cStride;
+    double *c2 = c1 + cStride;
+    double *c3 = c2 + cStride;
+    float64x2_t c00 = vld1q_f64( c0 ), c01 = vld1q_f64( c0+2 );
+    float64x2_t c10 = vld1q_f64( c1 ), c11 = vld1q_f64( c1+2 );
+    float64x2_t c20 = vld1q_f64( c2 ), c21 = vld1q_f64( c2+2 );
+    float64x2_t c30 = vld1q_f64( c3 ), c31 = vld1q_f64( c3+2 );
+    for(UINT k=0; k<kc; k++){
+        const double *b = packedB + (size_t)k*4;
+        const float64x2_t b0 = vld1q_f64( b );
+        const float64x2_t b1 = vld1q_f64( b+2 );
+        float64x2_t a = vdupq_n_f64( a0[k] );
+        c00 = vaddq_f64( c00, vmulq_f64( a, b0 ) );
+        c01 = vaddq_f64( c01, vmulq_f64( a, b1 ) );
+        a = vdupq_n_f64( a1[k] );
+        c10 = vaddq_f64( c10, vmulq_f64( a, b0 ) );
+        c11 = vaddq_f64( c11, vmulq_f64( a, b1 ) );
+        a = vdupq_n_f64( a2[k] );
+        c20 = vaddq_f64( c20, vmulq_f64( a, b0 ) );
+        c21 = vaddq_f64( c21, vmulq_f64( a, b1 ) );
+        a = vdupq_n_f64( a3[k] );
+        c30 = vaddq_f64( c30, vmulq_f64( a, b0 ) );
+        c31 = vaddq_f64( c31, vmulq_f64( a, b1 ) );
+    }
+    vst1q_f64( c0, c00 ); vst1q_f64( c0+2, c01 );
+    vst1q_f64( c1, c10 ); vst1q_f64( c1+2, c11 );
+    vst1q_f64( c2, c20 ); vst1q_f64( c2+2, c21 );
+    vst1q_f64( c3, c30 ); vst1q_f64( c3+2, c31 );
+}
+
+static void gemvNEON(const double *a,const UINT aStride,const double *x,double *y,const UINT M,const UINT N){
+    double column[2];
+    UINT i = 0;
+    for(; i+2<=M; i+=2){
+        const double *row0 = a + (size_t)i*aStride;
+        const double *row1 = row0 + aStride;
+        float64x2_t sum = vdupq_n_f64( 0 );
+        UINT j = 0;
+        for(; j+2<=N; j+=2){
+            const float64x2_t r0 = vld1q_f64( row0+j );
+            const float64x2_t r1 = vld1q_f64( row1+j );
+            sum = vaddq_f64( sum, vmulq_f64( vzip1q_f64( r0, r1 ), vdupq_n_f64( x[j] ) ) );
+            sum = vaddq_f64( sum, vmulq_f64( vzip2q_f64( r0, r1 ), vdupq_n_f64( x[j+1] ) ) );
+        }
+        for(; j<N; j++){
+            column[0] = row0[j];
+            column[1] = row1[j];
+            sum = vaddq_f64( sum, vmulq_f64( vld1q_f64( column ), vdupq_n_f64( x[j] ) ) );
+        }
+        vst1q_f64( y+i, sum );
+    }
+    if( i < M ) gemvScalar( a + (size_t)i*aStride, aStride, x, y+i, M-i, N );
+}
+
+#endif //GRT_MATRIX_KERNELS_NEON
+
+#if defined(GRT_MATRIX_KERNELS_FLOAT_NEON)
+
+static void gemvFloatNEON(const float *a,const UINT aStride,const float *x,float *y,const UINT M,const UINT N){
+    for(UINT i=0; i<M; i++){
+        const float *row = a + (size_t)i*aStride;
+        float32x4_t sum0 = vdupq_n_f32( 0 );
+        float32x4_t sum1 = vdupq_n_f32( 0 );
+        UINT j = 0;
+        for(; j+8<=N; j+=8){
+            sum0 = vaddq_f32( sum0, vmulq_f32( vld1q_f32( row+j ), vld1q_f32( x+j ) ) );
+            sum1 = vaddq_f32( sum1, vmulq_f32( vld1q_f32( row+j+4 ), vld1q_f32( x+j+4 ) ) );
+        }
+        for(; j+4<=N; j+=4){
+            sum0 = vaddq_f32( sum0, vmulq_f32( vld1q_f32( row+j ), vld1q_f32( x+j ) ) );
+        }
+        sum0 = vaddq_f32( sum0, sum1 );
+        float32x2_t s = vadd_f32( vget_low_f32( sum0 ), vget_high_f32( sum0 ) );
+        s = vpadd_f32( s, s );
+        float sum = vget_lane_f32( s, 0 );
+        for(; j<N; j++){
+            sum += row[j] * x[j];
+        }
+        y[i] = sum;
+    }
+}
+
+#endif //GRT_MATRIX_KERNELS_FLOAT_NEON
+
+////////////////////////////////////// Dispatch //////////////////////////////////////
+
+static MatrixKernelTable selectMatrixKernels(){
+    MatrixKernelTable table;
+    table.gemm = gemmScalar;
+    table.gemmNR = 4;
+    table.gemv = gemvScalar;
+    table.gemvFloat = gemvFloatScalar;
+    table.instructionSet = "SCALAR";
+
+#if defined(GRT_MATRIX_KERNELS_FLOAT_NEON)
+    table.gemvFloat = gemvFloatNEON;
+#endif
+
+#if defined(GRT_MATRIX_KERNELS_NEON)
+    table.gemm = gemmNEON;
+    table.gemmNR = 4;
+    table.gemv = gemvNEON;
+    table.instructionSet = "NEON";
+#endif
+
+#if defined(GRT_MATRIX_KERNELS_SSE2)
+    table.gemm = gemmSSE2;
+    table.gemmNR = 4;
+    table.gemv = gemvSSE2;
+    table.gemvFloat = gemvFloatSSE;
+    table.instructionSet = "SSE2";
+#endif
+
+#if defined(GRT_MATRIX_KERNELS_AVX)
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports("avx") ){
+        table.gemm = gemmAVX;
+        table.gemmNR = 8;
+        table.gemv = gemvAVX;
+        table.gemvFloat = gemvFloatAVX;
+        table.instructionSet = "AVX";
+    }
+#endif
+
+    return table;
+}
+
+static const MatrixKernelTable& getMatrixKernels(){
+    //The CPU is only checked the first time a kernel is used
+    static const MatrixKernelTable table = selectMatrixKernels();
+    return table;
+}
+
+////////////////////////////////////// Blocked GEMM //////////////////////////////////////
+
+/*
+ Computes rows [rowStart rowEnd) of c = a * b.  The columns of c are split into NC wide blocks and the inner dimension into KC deep
+ blocks, each [KC NC] block of b is packed into NR wide strips and then reused for every MR row tile of c.  The partial sums are
+ kept in c between the KC blocks, so each element of c still adds the products in k order.
+*/
+static void gemmRows(const double *a,const UINT aStride,const double *b,const UINT bStride,double *c,const UINT cStride,const UINT rowStart,const UINT rowEnd,const UINT N,const UINT L){
+
+    const MatrixKernelTable &kernels = getMatrixKernels();
+    const UINT NR = kernels.gemmNR;
+
+    for(UINT i=rowStart; i<rowEnd; i++){
+        double *cRow = c + (size_t)i*cStride;
+        for(UINT j=0; j<L; j++){
+            cRow[j] = 0;
+        }
+    }
+
+    if( rowStart >= rowEnd || N == 0 || L == 0 ) return;
+
+    //The packed block only needs to be as big as the largest [kc nc] block of b, rounded up to whole strips
+    const UINT maxKC = N < GRT_MATRIX_KERNELS_KC ? N : GRT_MATRIX_KERNELS_KC;
+    const UINT maxNC = L < GRT_MATRIX_KERNELS_NC ? L : GRT_MATRIX_KERNELS_NC;
+    std::vector< double > packedB( (size_t)maxKC * ((maxNC + NR - 1) / NR) * NR );
+    double tile[ GRT_MATRIX_KERNELS_MR * GRT_MATRIX_KERNELS_MAX_NR ];
+    const double *aRows[ GRT_MATRIX_KERNELS_MR ];
+
+    for(UINT jc=0; jc<L; jc+=GRT_MATRIX_KERNELS_NC){
+        const UINT nc = L-jc < GRT_MATRIX_KERNELS_NC ? L-jc : GRT_MATRIX_KERNELS_NC;
+        const UINT numStrips = (nc + NR - 1) / NR;
+
+        for(UINT pc=0; pc<N; pc+=GRT_MATRIX_KERNELS_KC){
+            const UINT kc = N-pc < GRT_MATRIX_KERNELS_KC ? N-pc : GRT_MATRIX_KERNELS_KC;
+
+            //Pack the [kc nc] block of b into strips of NR columns, the last strip is padded with zeros
+            for(UINT s=0; s<numStrips; s++){
+                double *strip = &packedB[ (size_t)s*kc*NR ];
+                const UINT colStart = jc + s*NR;
+                const UINT numCols = L-colStart < NR ? L-colStart : NR;
+                for(UINT k=0; k<kc; k++){
+                    const double *bRow = b + (size_t)(pc+k)*bStride + colStart;
+                    double *packedRow = strip + (size_t)k*NR;
+                    UINT j = 0;
+                    for(; j<numCols; j++) packedRow[j] = bRow[j];
+                    for(; j<NR; j++) packedRow[j] = 0;
+                }
+            }
+
+            for(UINT ic=rowStart; ic<rowEnd; ic+=GRT_MATRIX_KERNELS_MC){
+                const UINT icEnd = rowEnd-ic < GRT_MATRIX_KERNELS_MC ? rowEnd : ic+GRT_MATRIX_KERNELS_MC;
+
+                for(UINT s=0; s<numStrips; s++){
+                    const double *strip = &packedB[ (size_t)s*kc*NR ];
+                    const UINT colStart = jc + s*NR;
+                    const UINT numCols = L-colStart < NR ? L-colStart : NR;
+
+                    for(UINT i=ic; i<icEnd; i+=GRT_MATRIX_KERNELS_MR){
+                        const UINT numRows = icEnd-i < GRT_MATRIX_KERNELS_MR ? icEnd-i : GRT_MATRIX_KERNELS_MR;
+                        //Missing rows at the bottom edge reuse the first row, their results are thrown away
+                        for(UINT r=0; r<GRT_MATRIX_KERNELS_MR; r++){
+                            aRows[r] = a + (size_t)(i + (r < numRows ? r : 0))*aStride + pc;
+                        }
+                        double *cTile = c + (size_t)i*cStride + colStart;
+
+                        if( numRows == GRT_MATRIX_KERNELS_MR && numCols == NR ){
+                            kernels.gemm( aRows[0], aRows[1], aRows[2], aRows[3], strip, kc, cTile, cStride );
+                            continue;
+                        }
+
+                        //Edge tiles are computed in a full size buffer and only the valid part is copied back
+                        for(UINT r=0; r<GRT_MATRIX_KERNELS_MR; r++){
+                            for(UINT j=0; j<NR; j++){
+                                tile[ r*NR + j ] = r < numRows && j < numCols ? cTile[ (size_t)r*cStride + j ] : 0;
+                            }
+                        }
+                        kernels.gemm( aRows[0], aRows[1], aRows[2], aRows[3], strip, kc, tile, NR );
+                        for(UINT r=0; r<numRows; r++){
+                            for(UINT j=0; j<numCols; j++){
+                                cTile[ (size_t)r*cStride + j ] = tile[ r*NR + j ];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ The band of rows computed by one of the gemm worker threads.
+*/
+struct GemmWorker{
+    const double *a;
+    UINT aStride;
+    const double *b;
+    UINT bStride;
+    double *c;
+    UINT cStride;
+    UINT rowStart;
+    UINT rowEnd;
+    UINT N;
+    UINT L;
+};
+
+static void* gemmWorkerThread(void *workerData){
+    GemmWorker *worker = (GemmWorker*)workerData;
+    gemmRows( worker->a, worker->aStride, worker->b, worker->bStride, worker->c, worker->cStride, worker->rowStart, worker->rowEnd, worker->N, worker->L );
+    return NULL;
+}
+
+void MatrixKernels::gemm(const double *a,const UINT aStride,const double *b,const UINT bStride,double *c,const UINT cStride,const UINT M,const UINT N,const UINT L,const UINT numThreads){
+
+    //Each thread needs at least one MC block of rows, and small products are run on the calling thread
+    UINT numWorkers = numThreads > 0 ? numThreads : 1;
+    const UINT maxWorkers = M / GRT_MATRIX_KERNELS_MC;
+    if( numWorkers > maxWorkers ) numWorkers = maxWorkers;
+    if( (double)M * N * L < GRT_MATRIX_KERNELS_MIN_THREADED_OPS ) numWorkers = 1;
+
+    if( numWorkers <= 1 ){
+        gemmRows( a, aStride, b, bStride, c, cStride, 0, M, N, L );
+        return;
+    }
+
+    //Split the rows into equal bands, rounded to MR rows so only the last band has a partial tile
+    std::vector< GemmWorker > workers( numWorkers );
+    const UINT bandSize = ((M / numWorkers + GRT_MATRIX_KERNELS_MR - 1) / GRT_MATRIX_KERNELS_MR) * GRT_MATRIX_KERNELS_MR;
+    for(UINT t=0; t<numWorkers; t++){
+        GemmWorker &worker = workers[t];
+        worker.a = a;
+        worker.aStride = aStride;
+        worker.b = b;
+        worker.bStride = bStride;
+        worker.c = c;
+        worker.cStride = cStride;
+        worker.rowStart = t*bandSize < M ? t*bandSize : M;
+        worker.rowEnd = t+1 == numWorkers || (t+1)*bandSize > M ? M : (t+1)*bandSize;
+        worker.N = N;
+        worker.L = L;
+    }
+
+    //Start the worker threads, the calling thread computes the first band. If a thread can not be started then its band is computed
+    //on the calling thread instead
+    std::vector< pthread_t > threads( numWorkers );
+    std::vector< bool > threadStarted( numWorkers, false );
+    for(UINT t=1; t<numWorkers; t++){
+        threadStarted[t] = pthread_create( &threads[t], NULL, gemmWorkerThread, &workers[t] ) == 0;
+    }
+
+    gemmWorkerThread( &workers[0] );
+
+    for(UINT t=1; t<numWorkers; t++){
+        if( threadStarted[t] ) pthread_join( threads[t], NULL );
+        else gemmWorkerThread( &workers[t] );
+    }
+}
+
+void MatrixKernels::gemv(const double *a,const UINT aStride,const double *x,double *y,const UINT M,const UINT N){
+    getMatrixKernels().gemv( a, aStride, x, y, M, N );
+}
+
+void MatrixKernels::gemv(const float *a,const UINT aStride,const float *x,float *y,const UINT M,const UINT N){
+    getMatrixKernels().gemvFloat( a, aStride, x, y, M, N );
+}
+
+std::string MatrixKernels::getInstructionSet(){
+    return getMatrixKernels().instructionSet;
+}
+
+} //End of namespace GRT
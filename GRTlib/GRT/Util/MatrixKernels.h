@@ -0,0 +1,116 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief This file contains the MatrixKernels class, a cache-blocked and vectorized matrix-matrix (gemm) and matrix-vector (gemv)
+ product that is used by MatrixDouble::multiple.
+
+ The gemm kernel splits the product into blocks that fit in the cache, packs each block of b into narrow column strips and computes
+ 4 rows of c at a time with SIMD registers (AVX or SSE2 on x86, NEON on 64-bit ARM, with a scalar fallback everywhere else).  Each
+ element of c still adds the products a[i][k]*b[k][j] one at a time in k order, and multiplies and adds are never fused, so the results
+ are exactly the same as a plain triple loop.  Large products can be split over several threads, each thread computes a band of rows.
+ The gemv kernel computes several rows at a time, one row per SIMD lane, again adding the columns in order.  The instruction set is
+ selected at runtime the first time a kernel is used.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_MATRIX_KERNELS_HEADER
+#define GRT_MATRIX_KERNELS_HEADER
+
+#include "GRTTypedefs.h"
+#include <string>
+
+namespace GRT{
+
+//The number of multiply-adds (M*N*L) below which gemm always runs on the calling thread, smaller products are not worth a thread
+#define GRT_MATRIX_KERNELS_MIN_THREADED_OPS 2097152
+
+class MatrixKernels{
+public:
+    /**
+     Default constructor.
+     */
+    MatrixKernels(){}
+
+    /**
+     Default destructor.
+     */
+    ~MatrixKernels(){}
+
+    /**
+     Computes the matrix product c = a * b, where a is [M N], b is [N L] and c is [M L].  All three matrices are row-major and c must
+     not overlap a or b.  If numThreads is greater than one and the product is large enough, the rows of c are split over that many
+     threads, the results are the same for any number of threads.
+
+     @param const double *a: a pointer to the first element of a
+     @param const UINT aStride: the number of values between the start of each row of a
+     @param const double *b: a pointer to the first element of b
+     @param const UINT bStride: the number of values between the start of each row of b
+     @param double *c: a pointer to the first element of c, the M*L results will be written here
+     @param const UINT cStride: the number of values between the start of each row of c
+     @param const UINT M: the number of rows in a and c
+     @param const UINT N: the number of columns in a and the number of rows in b
+     @param const UINT L: the number of columns in b and c
+     @param const UINT numThreads: the maximum number of threads that can be used, the calling thread counts as one of them
+     @return returns void
+     */
+    static void gemm(const double *a,const UINT aStride,const double *b,const UINT bStride,double *c,const UINT cStride,const UINT M,const UINT N,const UINT L,const UINT numThreads = 1);
+
+    /**
+     Computes the matrix-vector product y = a * x, where a is [M N], x has N values and y has M values.  y must not overlap a or x.
+
+     @param const double *a: a pointer to the first element of a
+     @param const UINT aStride: the number of values between the start of each row of a
+     @param const double *x: a pointer to the vector x
+     @param double *y: a pointer to the vector y, the M results will be written here
+     @param const UINT M: the number of rows in a
+     @param const UINT N: the number of columns in a
+     @return returns void
+     */
+    static void gemv(const double *a,const UINT aStride,const double *x,double *y,const UINT M,const UINT N);
+
+    /**
+     Computes the single precision matrix-vector product y = a * x, where a is [M N], x has N values and y has M values.  y must not overlap
+     a or x.  The columns of each row are spread over the SIMD lanes, so the sums are not added in the same order as a plain loop.
+
+     @param const float *a: a pointer to the first element of a
+     @param const UINT aStride: the number of values between the start of each row of a
+     @param const float *x: a pointer to the vector x
+     @param float *y: a pointer to the vector y, the M results will be written here
+     @param const UINT M: the number of rows in a
+     @param const UINT N: the number of columns in a
+     @return returns void
+     */
+    static void gemv(const float *a,const UINT aStride,const float *x,float *y,const UINT M,const UINT N);
+
+    /**
+     Gets the name of the instruction set the kernels are using on this machine, this will be one of "AVX", "SSE2", "NEON" or "SCALAR".
+
+     @return returns the name of the instruction set being used by the kernels
+     */
+    static std::string getInstructionSet();
+};
+
+} //End of namespace GRT
+
+#endif //GRT_MATRIX_KERNELS_HEADER
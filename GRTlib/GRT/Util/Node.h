@@ -362,6 +362,24 @@ public:
     bool getHasRightChild() const{
         return (rightChild != NULL);
     }
+
+    /**
+     This function returns a pointer to the leftChild, this will be NULL if the node does not have a leftChild.
+
+     @return returns a const pointer to the leftChild
+     */
+    const Node* getLeftChild() const{
+        return leftChild;
+    }
+
+    /**
+     This function returns a pointer to the rightChild, this will be NULL if the node does not have a rightChild.
+
+     @return returns a const pointer to the rightChild
+     */
+    const Node* getRightChild() const{
+        return rightChild;
+    }
     
     bool initNode(Node *parent,const UINT depth,const bool isLeafNode = false){
         this->parent = parent;
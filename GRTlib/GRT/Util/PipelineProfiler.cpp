@@ -0,0 +1,117 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PipelineProfiler.h"
+
+#ifdef __GRT_WINDOWS_BUILD__
+    #include <windows.h>
+#endif
+
+namespace GRT{
+
+PipelineProfiler::PipelineProfiler(){
+    enabled = false;
+    stages.resize( NUM_STAGE_TYPES );
+}
+
+PipelineProfiler::~PipelineProfiler(){
+}
+
+bool PipelineProfiler::setEnabled(const bool enabled){
+#ifdef GRT_PROFILING_ENABLED
+    this->enabled = enabled;
+    return true;
+#else
+    this->enabled = false;
+    return !enabled;
+#endif
+}
+
+void PipelineProfiler::clear(){
+    for(UINT i=0; i<NUM_STAGE_TYPES; i++){
+        stages[i].clear();
+    }
+}
+
+void PipelineProfiler::recordStage(const UINT stageType,const UINT moduleIndex,const unsigned long long startTime,const bool success){
+    const unsigned long long endTime = getTimeNanoSeconds();
+    if( stageType >= NUM_STAGE_TYPES ) return;
+
+    //This only allocates the first time a module is recorded
+    vector< LatencyHistogram > &modules = stages[ stageType ];
+    if( moduleIndex >= modules.size() ) modules.resize( moduleIndex+1 );
+
+    modules[ moduleIndex ].update( endTime > startTime ? endTime - startTime : 0, success );
+}
+
+UINT PipelineProfiler::getNumModules(const UINT stageType) const{
+    if( stageType >= NUM_STAGE_TYPES ) return 0;
+    return (UINT)stages[ stageType ].size();
+}
+
+const LatencyHistogram& PipelineProfiler::getStatistics(const UINT stageType,const UINT moduleIndex) const{
+    if( stageType >= NUM_STAGE_TYPES || moduleIndex >= stages[ stageType ].size() ) return emptyStatistics;
+    return stages[ stageType ][ moduleIndex ];
+}
+
+string PipelineProfiler::getStageTypeAsString(const UINT stageType){
+    switch( stageType ){
+        case START_OF_PIPELINE_CONTEXT:
+            return "Context(START_OF_PIPELINE)";
+        case PREPROCESSING:
+            return "PreProcessing";
+        case AFTER_PREPROCESSING_CONTEXT:
+            return "Context(AFTER_PREPROCESSING)";
+        case FEATURE_EXTRACTION:
+            return "FeatureExtraction";
+        case AFTER_FEATURE_EXTRACTION_CONTEXT:
+            return "Context(AFTER_FEATURE_EXTRACTION)";
+        case CLASSIFIER:
+            return "Classifier";
+        case REGRESSIFIER:
+            return "Regressifier";
+        case AFTER_CLASSIFIER_CONTEXT:
+            return "Context(AFTER_CLASSIFIER)";
+        case POSTPROCESSING:
+            return "PostProcessing";
+        case END_OF_PIPELINE_CONTEXT:
+            return "Context(END_OF_PIPELINE)";
+        case PREDICT:
+            return "Predict";
+        default:
+            break;
+    }
+    return "UNKNOWN_STAGE";
+}
+
+unsigned long long PipelineProfiler::getTimeNanoSeconds(){
+#ifdef __GRT_WINDOWS_BUILD__
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency( &frequency );
+    QueryPerformanceCounter( &counter );
+    return (unsigned long long)( counter.QuadPart * (1.0e9 / frequency.QuadPart) );
+#else
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+#endif
+}
+
+} //End of namespace GRT
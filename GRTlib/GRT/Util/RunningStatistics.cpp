@@ -0,0 +1,354 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RunningStatistics.h"
+#include "MatrixKernels.h"
+#include <pthread.h>
+
+namespace GRT{
+
+RunningStatistics::RunningStatistics(const UINT numDimensions,const bool computeCovariance){
+    warningLog.setProceedingText("[WARNING RunningStatistics]");
+    errorLog.setProceedingText("[ERROR RunningStatistics]");
+    this->numDimensions = 0;
+    this->computeCovariance = computeCovariance;
+    this->numSamples = 0;
+    if( numDimensions > 0 ){
+        init( numDimensions, computeCovariance );
+    }
+}
+
+RunningStatistics::RunningStatistics(const RunningStatistics &rhs){
+    warningLog.setProceedingText("[WARNING RunningStatistics]");
+    errorLog.setProceedingText("[ERROR RunningStatistics]");
+    *this = rhs;
+}
+
+RunningStatistics::~RunningStatistics(){
+}
+
+RunningStatistics& RunningStatistics::operator=(const RunningStatistics &rhs){
+    if( this != &rhs ){
+        this->numDimensions = rhs.numDimensions;
+        this->computeCovariance = rhs.computeCovariance;
+        this->numSamples = rhs.numSamples;
+        this->mean = rhs.mean;
+        this->m2 = rhs.m2;
+        this->comoment = rhs.comoment;
+        this->ranges = rhs.ranges;
+    }
+    return *this;
+}
+
+bool RunningStatistics::init(const UINT numDimensions,const bool computeCovariance){
+
+    if( numDimensions == 0 ){
+        errorLog << "init(const UINT numDimensions,const bool computeCovariance) - The number of dimensions must be greater than zero!" << endl;
+        return false;
+    }
+
+    this->numDimensions = numDimensions;
+    this->computeCovariance = computeCovariance;
+    clear();
+
+    return true;
+}
+
+void RunningStatistics::clear(){
+    numSamples = 0;
+    mean.assign( numDimensions, 0 );
+    m2.assign( numDimensions, 0 );
+    ranges.assign( numDimensions, MinMax() );
+    if( computeCovariance && numDimensions > 0 ){
+        comoment.resize( numDimensions, numDimensions );
+        comoment.setAllValues( 0 );
+    }else comoment.clear();
+}
+
+bool RunningStatistics::update(const VectorDouble &sample){
+
+    if( sample.size() != numDimensions || numDimensions == 0 ){
+        errorLog << "update(const VectorDouble &sample) - The size of the sample (" << sample.size() << ") does not match the number of dimensions (" << numDimensions << ")!" << endl;
+        return false;
+    }
+
+    //Welford's update, delta is the difference from the old mean
+    const UINT D = numDimensions;
+    const double n = numSamples + 1.0;
+    const double scale = numSamples / n;
+    VectorDouble delta( D );
+    for(UINT j=0; j<D; j++){
+        delta[j] = sample[j] - mean[j];
+        mean[j] += delta[j] / n;
+        m2[j] += delta[j] * delta[j] * scale;
+
+        if( numSamples == 0 ) ranges[j] = MinMax( sample[j], sample[j] );
+        else ranges[j].updateMinMax( sample[j] );
+    }
+
+    if( computeCovariance ){
+        for(UINT j=0; j<D; j++){
+            double *row = comoment[j];
+            const double deltaJ = delta[j] * scale;
+            for(UINT k=0; k<D; k++){
+                row[k] += deltaJ * delta[k];
+            }
+        }
+    }
+
+    numSamples++;
+
+    return true;
+}
+
+/*
+ The band of rows summarized by one of the update worker threads.
+*/
+struct RunningStatisticsWorker{
+    RunningStatistics *stats;
+    const MatrixDouble *data;
+    UINT rowStart;
+    UINT rowEnd;
+};
+
+bool RunningStatistics::update(const MatrixDouble &data,const UINT numThreads){
+
+    if( data.getNumCols() != numDimensions || numDimensions == 0 ){
+        errorLog << "update(const MatrixDouble &data,const UINT numThreads) - The number of columns in the data (" << data.getNumCols() << ") does not match the number of dimensions (" << numDimensions << ")!" << endl;
+        return false;
+    }
+
+    const UINT M = data.getNumRows();
+    if( M == 0 ) return true;
+
+    //Each thread gets at least four blocks of rows, smaller matrices are summarized on the calling thread
+    UINT numWorkers = numThreads > 0 ? numThreads : 1;
+    const UINT maxWorkers = M / (GRT_RUNNING_STATISTICS_BLOCK_SIZE*4);
+    if( numWorkers > maxWorkers ) numWorkers = maxWorkers;
+
+    if( numWorkers <= 1 ){
+        return updateRows( data, 0, M );
+    }
+
+    //Each worker summarizes its own band, the calling thread runs the first band. If a thread can not be started then its band is
+    //summarized on the calling thread instead
+    vector< RunningStatistics > partialStats( numWorkers, RunningStatistics( numDimensions, computeCovariance ) );
+    vector< RunningStatisticsWorker > workers( numWorkers );
+    for(UINT t=0; t<numWorkers; t++){
+        workers[t].stats = &partialStats[t];
+        workers[t].data = &data;
+        workers[t].rowStart = (UINT)( (unsigned long long)M * t / numWorkers );
+        workers[t].rowEnd = (UINT)( (unsigned long long)M * (t+1) / numWorkers );
+    }
+
+    vector< pthread_t > threads( numWorkers );
+    vector< bool > threadStarted( numWorkers, false );
+    for(UINT t=1; t<numWorkers; t++){
+        threadStarted[t] = pthread_create( &threads[t], NULL, updateWorkerThread, &workers[t] ) == 0;
+    }
+
+    updateWorkerThread( &workers[0] );
+
+    for(UINT t=1; t<numWorkers; t++){
+        if( threadStarted[t] ) pthread_join( threads[t], NULL );
+        else updateWorkerThread( &workers[t] );
+    }
+
+    //Merge the bands in row order, so the results only depend on the number of threads and not on which thread finished first
+    for(UINT t=0; t<numWorkers; t++){
+        if( !merge( partialStats[t] ) ) return false;
+    }
+
+    return true;
+}
+
+void* RunningStatistics::updateWorkerThread(void *workerData){
+    RunningStatisticsWorker *worker = (RunningStatisticsWorker*)workerData;
+    worker->stats->updateRows( *worker->data, worker->rowStart, worker->rowEnd );
+    return NULL;
+}
+
+bool RunningStatistics::merge(const RunningStatistics &rhs){
+
+    if( rhs.numDimensions != numDimensions || rhs.computeCovariance != computeCovariance ){
+        errorLog << "merge(const RunningStatistics &rhs) - The number of dimensions or covariance setting of rhs does not match this instance!" << endl;
+        return false;
+    }
+
+    if( rhs.numSamples == 0 ) return true;
+
+    for(UINT j=0; j<numDimensions; j++){
+        if( numSamples == 0 ) ranges[j] = rhs.ranges[j];
+        else{
+            if( rhs.ranges[j].minValue < ranges[j].minValue ) ranges[j].minValue = rhs.ranges[j].minValue;
+            if( rhs.ranges[j].maxValue > ranges[j].maxValue ) ranges[j].maxValue = rhs.ranges[j].maxValue;
+        }
+    }
+
+    mergeMoments( rhs.numSamples, &rhs.mean[0], &rhs.m2[0], computeCovariance ? &rhs.comoment : NULL );
+
+    return true;
+}
+
+VectorDouble RunningStatistics::getMean() const{
+    return mean;
+}
+
+VectorDouble RunningStatistics::getVariance() const{
+    VectorDouble variance( numDimensions, 0 );
+    if( numSamples < 2 ) return variance;
+    for(UINT j=0; j<numDimensions; j++){
+        variance[j] = m2[j] / double(numSamples-1);
+    }
+    return variance;
+}
+
+VectorDouble RunningStatistics::getStdDev() const{
+    VectorDouble stdDev = getVariance();
+    for(UINT j=0; j<numDimensions; j++){
+        stdDev[j] = sqrt( stdDev[j] );
+    }
+    return stdDev;
+}
+
+vector< MinMax > RunningStatistics::getRanges() const{
+    if( numSamples == 0 ) return vector< MinMax >();
+    return ranges;
+}
+
+MatrixDouble RunningStatistics::getCovarianceMatrix() const{
+
+    if( !computeCovariance ){
+        warningLog << "getCovarianceMatrix() - The covariance is not being computed, call init with computeCovariance set to true!" << endl;
+        return MatrixDouble();
+    }
+
+    MatrixDouble covariance( numDimensions, numDimensions );
+    covariance.setAllValues( 0 );
+    if( numSamples < 2 ) return covariance;
+
+    //The comoment is symmetric in theory, the average of the two halves is used so the result is exactly symmetric
+    const double norm = 1.0 / double(numSamples-1);
+    for(UINT j=0; j<numDimensions; j++){
+        for(UINT k=j; k<numDimensions; k++){
+            const double c = (comoment[j][k] + comoment[k][j]) * 0.5 * norm;
+            covariance[j][k] = c;
+            covariance[k][j] = c;
+        }
+    }
+
+    return covariance;
+}
+
+bool RunningStatistics::updateRows(const MatrixDouble &data,const UINT rowStart,const UINT rowEnd){
+
+    //Note, this does not log anything so that it can be called from the worker threads
+    const UINT D = numDimensions;
+    const UINT blockSize = rowEnd-rowStart < GRT_RUNNING_STATISTICS_BLOCK_SIZE ? rowEnd-rowStart : GRT_RUNNING_STATISTICS_BLOCK_SIZE;
+    if( blockSize == 0 ) return true;
+
+    //Each block is centered on its own mean, the block is then merged into the running statistics with Chan's update
+    VectorDouble blockMean( D );
+    VectorDouble blockM2( D );
+    MatrixDouble centered( blockSize, D );
+    MatrixDouble centeredTransposed;
+    MatrixDouble blockComoment;
+    if( computeCovariance ){
+        centeredTransposed.resize( D, blockSize );
+        blockComoment.resize( D, D );
+    }
+
+    for(UINT blockStart=rowStart; blockStart<rowEnd; blockStart+=blockSize){
+        const UINT B = rowEnd-blockStart < blockSize ? rowEnd-blockStart : blockSize;
+
+        if( numSamples == 0 ){
+            for(UINT j=0; j<D; j++) ranges[j] = MinMax( data[blockStart][j], data[blockStart][j] );
+        }
+
+        std::fill( blockMean.begin(), blockMean.end(), 0 );
+        for(UINT i=0; i<B; i++){
+            const double *x = data[blockStart+i];
+            for(UINT j=0; j<D; j++){
+                blockMean[j] += x[j];
+                ranges[j].updateMinMax( x[j] );
+            }
+        }
+        for(UINT j=0; j<D; j++){
+            blockMean[j] /= double(B);
+        }
+
+        std::fill( blockM2.begin(), blockM2.end(), 0 );
+        for(UINT i=0; i<B; i++){
+            const double *x = data[blockStart+i];
+            double *z = centered[i];
+            for(UINT j=0; j<D; j++){
+                z[j] = x[j] - blockMean[j];
+                blockM2[j] += z[j] * z[j];
+            }
+        }
+
+        //The comoment of the block is centered^T * centered
+        if( computeCovariance ){
+            for(UINT i=0; i<B; i++){
+                const double *z = centered[i];
+                for(UINT j=0; j<D; j++){
+                    centeredTransposed[j][i] = z[j];
+                }
+            }
+            MatrixKernels::gemm( centeredTransposed.getData(), centeredTransposed.getStride(), centered.getData(), centered.getStride(), blockComoment.getData(), blockComoment.getStride(), D, B, D );
+        }
+
+        mergeMoments( B, &blockMean[0], &blockM2[0], computeCovariance ? &blockComoment : NULL );
+    }
+
+    return true;
+}
+
+void RunningStatistics::mergeMoments(const UINT n,const double *rhsMean,const double *rhsM2,const MatrixDouble *rhsComoment){
+
+    //Chan's pairwise update, the moments of the two sets are combined using the difference between their means
+    const UINT D = numDimensions;
+    const double na = numSamples;
+    const double nb = n;
+    const double total = na + nb;
+    const double scale = na * nb / total;
+
+    VectorDouble delta( D );
+    for(UINT j=0; j<D; j++){
+        delta[j] = rhsMean[j] - mean[j];
+        m2[j] += rhsM2[j] + delta[j] * delta[j] * scale;
+        mean[j] = numSamples == 0 ? rhsMean[j] : mean[j] + delta[j] * (nb / total);
+    }
+
+    if( rhsComoment != NULL ){
+        for(UINT j=0; j<D; j++){
+            double *row = comoment[j];
+            const double *rhsRow = (*rhsComoment)[j];
+            const double deltaJ = delta[j] * scale;
+            for(UINT k=0; k<D; k++){
+                row[k] += rhsRow[k] + deltaJ * delta[k];
+            }
+        }
+    }
+
+    numSamples += n;
+}
+
+} //End of namespace GRT
@@ -0,0 +1,411 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SymmetricEigenDecomposition.h"
+#include "MatrixKernels.h"
+
+namespace GRT{
+
+SymmetricEigenDecomposition::SymmetricEigenDecomposition(){
+    warningLog.setProceedingText("[WARNING SymmetricEigenDecomposition]");
+    errorLog.setProceedingText("[ERROR SymmetricEigenDecomposition]");
+    numDimensions = 0;
+}
+
+SymmetricEigenDecomposition::~SymmetricEigenDecomposition(){
+}
+
+bool SymmetricEigenDecomposition::decompose(const MatrixDouble &a){
+
+    if( a.getNumRows() != a.getNumCols() || a.getNumRows() == 0 ){
+        errorLog << "decompose(const MatrixDouble &a) - The matrix must be square and not empty!" << endl;
+        return false;
+    }
+
+    return decomposeFull( a, a.getNumRows() );
+}
+
+bool SymmetricEigenDecomposition::decompose(const MatrixDouble &a,const UINT numComponents){
+
+    if( a.getNumRows() != a.getNumCols() || a.getNumRows() == 0 ){
+        errorLog << "decompose(const MatrixDouble &a,const UINT numComponents) - The matrix must be square and not empty!" << endl;
+        return false;
+    }
+
+    const UINT N = a.getNumRows();
+    if( numComponents == 0 ){
+        errorLog << "decompose(const MatrixDouble &a,const UINT numComponents) - The number of components must be greater than zero!" << endl;
+        return false;
+    }
+
+    //A matrix only has N eigenvalues, so asking for more gives the full decomposition
+    if( numComponents > N ){
+        warningLog << "decompose(const MatrixDouble &a,const UINT numComponents) - The number of components (" << numComponents << ") is larger than the size of the matrix, it will be clamped to " << N << endl;
+        return decomposeFull( a, N );
+    }
+
+    //The subspace is oversampled so the leading eigenvalues converge faster, if it would cover most of the matrix the full decomposition is cheaper
+    const UINT M = numComponents*2 > numComponents+8 ? numComponents*2 : numComponents+8;
+    if( M*2 > N ){
+        return decomposeFull( a, numComponents );
+    }
+
+    //Fill in the upper triangle so the products can run over whole rows
+    MatrixDouble s(N,N);
+    for(UINT i=0; i<N; i++){
+        for(UINT j=0; j<=i; j++){
+            s[i][j] = s[j][i] = a[i][j];
+        }
+    }
+
+    //The subspace is stored as the rows of qt, it starts from a fixed random seed so the results can be repeated
+    Random random( 5489 );
+    MatrixDouble qt(M,N), yt(M,N), vt(M,N), avt(M,N), h(M,M);
+    for(UINT i=0; i<M; i++){
+        for(UINT j=0; j<N; j++){
+            qt[i][j] = random.getRandomNumberGauss();
+        }
+    }
+    if( !orthonormalize( qt, random ) ){
+        errorLog << "decompose(const MatrixDouble &a,const UINT numComponents) - Failed to build the starting subspace!" << endl;
+        return false;
+    }
+
+    SymmetricEigenDecomposition ritz;
+    for(UINT iter=0; iter<GRT_SYMMETRIC_EIGEN_MAX_SUBSPACE_ITERATIONS; iter++){
+
+        //As the matrix is symmetric, the rows of qt * s are the columns of s * q
+        MatrixKernels::gemm( qt.getData(), N, s.getData(), N, yt.getData(), N, M, N, N );
+
+        //Project the matrix onto the subspace, only the lower triangle is needed by the small decomposition
+        for(UINT i=0; i<M; i++){
+            const double *qi = qt[i];
+            for(UINT j=0; j<=i; j++){
+                const double *yj = yt[j];
+                double sum = 0;
+                for(UINT k=0; k<N; k++) sum += qi[k] * yj[k];
+                h[i][j] = sum;
+            }
+        }
+        if( !ritz.decomposeFull( h, M ) ){
+            errorLog << "decompose(const MatrixDouble &a,const UINT numComponents) - Failed to decompose the projected matrix!" << endl;
+            return false;
+        }
+
+        //Rotate the subspace onto the Ritz vectors, avt holds the product of the matrix with each Ritz vector
+        MatrixKernels::gemm( ritz.eigenvectorRows.getData(), M, qt.getData(), N, vt.getData(), N, M, M, N );
+        MatrixKernels::gemm( ritz.eigenvectorRows.getData(), M, yt.getData(), N, avt.getData(), N, M, M, N );
+
+        //The leading Ritz pairs have converged once their residuals are small relative to the largest eigenvalue
+        const double threshold = GRT_SYMMETRIC_EIGEN_TOLERANCE * fabs( ritz.eigenvalues[0] );
+        bool converged = true;
+        for(UINT i=0; i<numComponents && converged; i++){
+            const double lambda = ritz.eigenvalues[i];
+            const double *vi = vt[i];
+            const double *avi = avt[i];
+            double residual = 0;
+            for(UINT k=0; k<N; k++){
+                const double r = avi[k] - lambda * vi[k];
+                residual += r * r;
+            }
+            converged = sqrt( residual ) <= threshold;
+        }
+
+        if( converged ){
+            numDimensions = N;
+            eigenvalues.resize( numComponents );
+            eigenvectorRows.resize( numComponents, N );
+            for(UINT i=0; i<numComponents; i++){
+                eigenvalues[i] = ritz.eigenvalues[i];
+                std::copy( vt[i], vt[i]+N, eigenvectorRows[i] );
+            }
+            return true;
+        }
+
+        //The next subspace is the matrix times the current Ritz vectors
+        std::swap( qt, avt );
+        if( !orthonormalize( qt, random ) ){
+            errorLog << "decompose(const MatrixDouble &a,const UINT numComponents) - Failed to orthonormalize the subspace!" << endl;
+            return false;
+        }
+    }
+
+    warningLog << "decompose(const MatrixDouble &a,const UINT numComponents) - The subspace iteration did not converge, running the full decomposition instead!" << endl;
+
+    return decomposeFull( a, numComponents );
+}
+
+MatrixDouble SymmetricEigenDecomposition::getEigenvectors() const{
+    const UINT K = (UINT)eigenvalues.size();
+    MatrixDouble v;
+    if( K == 0 ) return v;
+    v.resize( numDimensions, K );
+    for(UINT j=0; j<numDimensions; j++){
+        for(UINT k=0; k<K; k++){
+            v[j][k] = eigenvectorRows[k][j];
+        }
+    }
+    return v;
+}
+
+bool SymmetricEigenDecomposition::decomposeFull(const MatrixDouble &a,const UINT numComponents){
+
+    const UINT N = a.getNumRows();
+    MatrixDouble w( a );
+    MatrixDouble vt;
+    VectorDouble d, e;
+
+    tridiagonalize( w, vt, d, e );
+
+    if( !diagonalize( vt, d, e ) ){
+        errorLog << "decompose(const MatrixDouble &a) - The QL iteration did not converge!" << endl;
+        return false;
+    }
+
+    numDimensions = N;
+    sortEigenvectors( vt, d, numComponents );
+
+    return true;
+}
+
+bool SymmetricEigenDecomposition::tridiagonalize(MatrixDouble &w,MatrixDouble &vt,VectorDouble &d,VectorDouble &e){
+
+    //Householder reduction of the lower triangle of w, working up from the last row.  The reflection for row i is stored in the first i
+    //values of that row, and the leading i*i block is updated with the symmetric rank two update A -= u*q' + q*u'
+    const UINT N = w.getNumRows();
+    VectorDouble hs(N,0), p(N,0);
+    d.resize(N);
+    e.assign(N,0);
+
+    for(UINT i=N-1; i>=2; i--){
+        double *u = w[i];
+        double scale = 0;
+        for(UINT k=0; k<i; k++) scale += fabs( u[k] );
+        if( scale == 0 ){
+            e[i] = 0;
+            continue;
+        }
+
+        double sigma = 0;
+        for(UINT k=0; k<i; k++){
+            u[k] /= scale;
+            sigma += u[k] * u[k];
+        }
+        const double alpha = u[i-1];
+        const double g = alpha >= 0 ? -sqrt( sigma ) : sqrt( sigma );
+        const double h = sigma - alpha * g;
+        u[i-1] = alpha - g;
+        e[i] = scale * g;
+        hs[i] = h;
+
+        //p = A * u / h, using the lower triangle for both halves of the product
+        for(UINT j=0; j<i; j++) p[j] = 0;
+        for(UINT j=0; j<i; j++){
+            const double *row = w[j];
+            const double uj = u[j];
+            double sum = row[j] * uj;
+            for(UINT k=0; k<j; k++){
+                sum += row[k] * u[k];
+                p[k] += row[k] * uj;
+            }
+            p[j] += sum;
+        }
+        double up = 0;
+        for(UINT j=0; j<i; j++){
+            p[j] /= h;
+            up += u[j] * p[j];
+        }
+        const double K = up / (h + h);
+        for(UINT j=0; j<i; j++) p[j] -= K * u[j];
+
+        for(UINT j=0; j<i; j++){
+            double *row = w[j];
+            const double uj = u[j];
+            const double qj = p[j];
+            for(UINT k=0; k<=j; k++){
+                row[k] -= uj * p[k] + qj * u[k];
+            }
+        }
+    }
+    if( N > 1 ) e[1] = w[1][0];
+    for(UINT i=0; i<N; i++) d[i] = w[i][i];
+
+    //Accumulate the transpose of the orthogonal transform, Q' = H2 * H3 * ... * Hn-1.  The product of the first reflections only
+    //touches the leading block, so each new reflection is applied to the first i rows and columns
+    vt.resize(N,N);
+    vt.setAllValues(0);
+    for(UINT i=0; i<N; i++) vt[i][i] = 1;
+    for(UINT i=2; i<N; i++){
+        if( hs[i] == 0 ) continue;
+        const double *u = w[i];
+        for(UINT r=0; r<i; r++){
+            double *row = vt[r];
+            double sum = 0;
+            for(UINT k=0; k<i; k++) sum += row[k] * u[k];
+            sum /= hs[i];
+            for(UINT k=0; k<i; k++) row[k] -= sum * u[k];
+        }
+    }
+
+    return true;
+}
+
+bool SymmetricEigenDecomposition::diagonalize(MatrixDouble &vt,VectorDouble &d,VectorDouble &e){
+
+    //Implicit QL iteration on the tridiagonal matrix (as in the EISPACK tql2 routine), each plane rotation is applied to two
+    //contiguous rows of vt
+    const int N = (int)d.size();
+    for(int i=1; i<N; i++) e[i-1] = e[i];
+    e[N-1] = 0;
+
+    double f = 0;
+    double tst1 = 0;
+    const double eps = pow(2.0,-52.0);
+    for(int l=0; l<N; l++){
+
+        //Find a small subdiagonal element
+        tst1 = std::max( tst1, fabs(d[l]) + fabs(e[l]) );
+        int m = l;
+        while( m < N-1 ){
+            if( fabs(e[m]) <= eps*tst1 ) break;
+            m++;
+        }
+
+        //If m == l, d[l] is an eigenvalue, otherwise iterate
+        if( m > l ){
+            UINT iter = 0;
+            do{
+                if( ++iter > GRT_SYMMETRIC_EIGEN_MAX_QL_ITERATIONS ) return false;
+
+                //Compute the implicit shift
+                double g = d[l];
+                double p = (d[l+1] - g) / (2.0 * e[l]);
+                double r = sqrt( p*p + 1.0 );
+                if( p < 0 ) r = -r;
+                d[l] = e[l] / (p + r);
+                d[l+1] = e[l] * (p + r);
+                const double dl1 = d[l+1];
+                double h = g - d[l];
+                for(int i=l+2; i<N; i++) d[i] -= h;
+                f += h;
+
+                //Implicit QL transformation
+                p = d[m];
+                double c = 1.0;
+                double c2 = c;
+                double c3 = c;
+                const double el1 = e[l+1];
+                double s = 0;
+                double s2 = 0;
+                for(int i=m-1; i>=l; i--){
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = sqrt( p*p + e[i]*e[i] );
+                    e[i+1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i+1] = h + s * (c * g + s * d[i]);
+
+                    //Accumulate the transformation
+                    double *vi = vt[i];
+                    double *vi1 = vt[i+1];
+                    for(int k=0; k<N; k++){
+                        const double t = vi1[k];
+                        vi1[k] = s * vi[k] + c * t;
+                        vi[k] = c * vi[k] - s * t;
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+
+            }while( fabs(e[l]) > eps*tst1 );
+        }
+        d[l] += f;
+        e[l] = 0;
+    }
+
+    return true;
+}
+
+void SymmetricEigenDecomposition::sortEigenvectors(const MatrixDouble &vt,const VectorDouble &d,const UINT numComponents){
+
+    const UINT N = (UINT)d.size();
+    vector< IndexedDouble > order( N );
+    for(UINT i=0; i<N; i++) order[i] = IndexedDouble( i, d[i] );
+
+    //Only the leading eigenvalues need to be in order
+    if( numComponents < N ){
+        std::partial_sort( order.begin(), order.begin()+numComponents, order.end(), IndexedDouble::sortIndexedDoubleByValueDescending );
+    }else std::sort( order.begin(), order.end(), IndexedDouble::sortIndexedDoubleByValueDescending );
+
+    eigenvalues.resize( numComponents );
+    eigenvectorRows.resize( numComponents, N );
+    for(UINT k=0; k<numComponents; k++){
+        eigenvalues[k] = order[k].value;
+        std::copy( vt[ order[k].index ], vt[ order[k].index ]+N, eigenvectorRows[k] );
+    }
+}
+
+bool SymmetricEigenDecomposition::orthonormalize(MatrixDouble &qt,Random &random){
+
+    //Modified Gram-Schmidt over the rows, run twice so the rows stay orthogonal to working precision.  A row that is (almost) in the
+    //span of the rows above it is replaced with a random row, this happens when the subspace is larger than the rank of the matrix
+    const UINT M = qt.getNumRows();
+    const UINT N = qt.getNumCols();
+    for(UINT i=0; i<M; i++){
+        double *qi = qt[i];
+        UINT numAttempts = 0;
+        while( true ){
+            double originalNorm = 0;
+            for(UINT k=0; k<N; k++) originalNorm += qi[k] * qi[k];
+            originalNorm = sqrt( originalNorm );
+
+            for(UINT pass=0; pass<2; pass++){
+                for(UINT j=0; j<i; j++){
+                    const double *qj = qt[j];
+                    double dot = 0;
+                    for(UINT k=0; k<N; k++) dot += qi[k] * qj[k];
+                    for(UINT k=0; k<N; k++) qi[k] -= dot * qj[k];
+                }
+            }
+
+            double norm = 0;
+            for(UINT k=0; k<N; k++) norm += qi[k] * qi[k];
+            norm = sqrt( norm );
+
+            if( norm > 1.0e-10 * originalNorm && norm > 0 ){
+                for(UINT k=0; k<N; k++) qi[k] /= norm;
+                break;
+            }
+
+            if( ++numAttempts > 10 ) return false;
+            for(UINT k=0; k<N; k++) qi[k] = random.getRandomNumberGauss();
+        }
+    }
+
+    return true;
+}
+
+} //End of namespace GRT
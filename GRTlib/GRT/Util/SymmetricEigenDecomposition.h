@@ -0,0 +1,120 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The SymmetricEigenDecomposition class computes the eigenvalues and eigenvectors of a real symmetric matrix, such as a
+ covariance matrix.
+
+ The full decomposition reduces the matrix to tridiagonal form with Householder reflections and then diagonalizes it with the
+ implicit QL algorithm.  Only the lower triangle of the matrix is read, and the eigenvectors are accumulated as rows so every
+ inner loop runs over contiguous memory.
+
+ The truncated decomposition only computes the leading eigenvalues and eigenvectors.  It runs a block subspace iteration with
+ Rayleigh-Ritz acceleration, the products with the matrix use the MatrixKernels::gemm kernel, so the cost grows with N*N*K
+ rather than N*N*N.  This is much faster when only a few of the eigenvectors of a large matrix are needed, for example to keep
+ the first few principal components of a few hundred dimensional feature vector.
+
+ In both cases the eigenvalues are returned in descending order, with the matching eigenvectors in the columns of the eigenvector matrix.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_SYMMETRIC_EIGEN_DECOMPOSITION_HEADER
+#define GRT_SYMMETRIC_EIGEN_DECOMPOSITION_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+//The maximum number of QL iterations spent on any one eigenvalue before the full decomposition gives up
+#define GRT_SYMMETRIC_EIGEN_MAX_QL_ITERATIONS 60
+
+//The maximum number of subspace iterations the truncated decomposition will run before it falls back to the full decomposition
+#define GRT_SYMMETRIC_EIGEN_MAX_SUBSPACE_ITERATIONS 500
+
+//The truncated decomposition stops once the residual of every leading eigenvector is below this fraction of the largest eigenvalue
+#define GRT_SYMMETRIC_EIGEN_TOLERANCE 1.0e-10
+
+class SymmetricEigenDecomposition{
+public:
+    /**
+     Default Constructor.
+     */
+    SymmetricEigenDecomposition();
+
+    /**
+     Default Destructor.
+     */
+    ~SymmetricEigenDecomposition();
+
+    /**
+     Computes all the eigenvalues and eigenvectors of the symmetric matrix a.  Only the lower triangle of a is used.
+
+     @param const MatrixDouble &a: the [N N] symmetric matrix that should be decomposed
+     @return returns true if the matrix was decomposed, false otherwise
+     */
+    bool decompose(const MatrixDouble &a);
+
+    /**
+     Computes the numComponents largest eigenvalues of the symmetric matrix a and their eigenvectors.  The matrix must be positive
+     semi-definite (a covariance matrix is), as the iteration converges on the eigenvalues with the largest magnitude.  If numComponents
+     is not much smaller than N, the full decomposition is run and its leading eigenvalues are kept.  If numComponents is larger than N
+     it is clamped to N.
+
+     @param const MatrixDouble &a: the [N N] symmetric positive semi-definite matrix that should be decomposed
+     @param const UINT numComponents: the number of leading eigenvalues to compute, this must be greater than zero
+     @return returns true if the matrix was decomposed, false otherwise
+     */
+    bool decompose(const MatrixDouble &a,const UINT numComponents);
+
+    /**
+     Gets the eigenvalues, sorted in descending order.
+
+     @return returns a VectorDouble with the eigenvalues, this will have N values after a full decomposition or numComponents values after a truncated decomposition
+     */
+    VectorDouble getEigenvalues() const{ return eigenvalues; }
+
+    /**
+     Gets the eigenvectors, the k'th column holds the unit length eigenvector of the k'th eigenvalue.
+
+     @return returns a [N K] MatrixDouble with the eigenvectors, where K is the number of eigenvalues
+     */
+    MatrixDouble getEigenvectors() const;
+
+protected:
+    bool decomposeFull(const MatrixDouble &a,const UINT numComponents);
+    bool tridiagonalize(MatrixDouble &w,MatrixDouble &vt,VectorDouble &d,VectorDouble &e);
+    bool diagonalize(MatrixDouble &vt,VectorDouble &d,VectorDouble &e);
+    void sortEigenvectors(const MatrixDouble &vt,const VectorDouble &d,const UINT numComponents);
+    bool orthonormalize(MatrixDouble &qt,Random &random);
+
+    UINT numDimensions;
+    VectorDouble eigenvalues;
+    MatrixDouble eigenvectorRows;           ///< The eigenvectors stored as the rows of this matrix, in the same order as the eigenvalues
+
+    WarningLog warningLog;
+    ErrorLog errorLog;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_SYMMETRIC_EIGEN_DECOMPOSITION_HEADER
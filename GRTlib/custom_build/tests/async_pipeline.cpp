@@ -0,0 +1,159 @@
+#include "GRT.h"
+
+#include <time.h>
+#include <unistd.h>
+
+using namespace GRT;
+
+//Checks the LockFreeQueue keeps the values in order under each backpressure mode, then compares the time a producer spends handing a
+//sample to an AsyncPipeline with the time it would spend calling predict itself, and checks the async results match the sync predictions
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+struct QueueTest{
+  LockFreeQueue< UINT > *queue;
+  UINT numValues;
+};
+
+static void* producerThread(void *data) {
+  QueueTest *test = (QueueTest*)data;
+  for(UINT i=0; i<test->numValues; i++){
+    test->queue->push( i );
+  }
+  return NULL;
+}
+
+static bool testQueue(const UINT backpressureMode, const char *name) {
+  const UINT numValues = 2000000;
+  LockFreeQueue< UINT > queue(64, 0, backpressureMode);
+  QueueTest test;
+  test.queue = &queue;
+  test.numValues = numValues;
+
+  pthread_t thread;
+  pthread_create( &thread, NULL, producerThread, &test );
+
+  //Pop until the last value arrives, stalling now and then so the queue fills up
+  UINT numPopped = 0;
+  UINT lastValue = 0;
+  bool inOrder = true;
+  UINT value = 0;
+  while( true ){
+    if( !queue.pop( value ) ) continue;
+    if( numPopped > 0 && value <= lastValue ) inOrder = false;
+    if( backpressureMode == LockFreeQueue< UINT >::BLOCK && value != numPopped ) inOrder = false;
+    lastValue = value;
+    numPopped++;
+    if( numPopped % 10000 == 0 ) usleep( 100 );
+    if( value == numValues-1 ) break;
+  }
+  pthread_join( thread, NULL );
+
+  const UINT numLost = queue.getNumDropped() + queue.getNumCoalesced();
+  const bool countsMatch = numPopped + numLost == numValues && queue.getNumPushed() == numValues;
+  printf("%s\tPopped: %u\tDropped: %u\tCoalesced: %u\tMaxSize: %u\tInOrder: %s\tCountsMatch: %s\n", name, numPopped, queue.getNumDropped(),
+         queue.getNumCoalesced(), queue.getMaxSize(), inOrder ? "yes" : "NO", countsMatch ? "yes" : "NO");
+  return inOrder && countsMatch;
+}
+
+class ResultCounter : public Observer< PredictionResult >{
+public:
+  ResultCounter(){ numResults = 0; }
+  virtual void notify(const PredictionResult &result){ numResults++; }
+  UINT numResults;
+};
+
+int main(int argc, const char * argv[]) {
+
+  if( !testQueue( LockFreeQueue< UINT >::BLOCK, "BLOCK\t" ) ) return EXIT_FAILURE;
+  if( !testQueue( LockFreeQueue< UINT >::DROP_OLDEST, "DROP_OLDEST" ) ) return EXIT_FAILURE;
+  if( !testQueue( LockFreeQueue< UINT >::COALESCE, "COALESCE" ) ) return EXIT_FAILURE;
+
+  //A KNN pipeline with a large training set, so each prediction takes a while
+  const UINT numDimensions = 32;
+  const UINT numClasses = 5;
+  const UINT numSamples = 500;
+  Random random(42);
+  LabelledClassificationData trainingData(numDimensions);
+  for(UINT i=0; i<5000; i++){
+    const UINT classLabel = (i % numClasses) + 1;
+    VectorDouble sample(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) sample[j] = sin( classLabel * 0.7 + j ) + random.getRandomNumberGauss(0, 0.5);
+    trainingData.addSample( classLabel, sample );
+  }
+  MatrixDouble data(numSamples, numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    for(UINT j=0; j<numDimensions; j++) data[i][j] = sin( ((i % numClasses) + 1) * 0.7 + j ) + random.getRandomNumberGauss(0, 0.5);
+  }
+
+  GestureRecognitionPipeline pipeline;
+  pipeline.setClassifier( KNN(10) );
+  if( !pipeline.train( trainingData ) ){
+    printf("ERROR: Failed to train the pipeline!\n");
+    return EXIT_FAILURE;
+  }
+
+  //The time the producer spends in each call when it predicts synchronously
+  vector< UINT > labels(numSamples);
+  struct timespec start, end;
+  double syncTime = 0, syncMax = 0;
+  for(UINT i=0; i<numSamples; i++){
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pipeline.predict( data.getRowVector(i) );
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double t = getElapsedMicroSeconds(start, end);
+    syncTime += t;
+    syncMax = std::max( syncMax, t );
+    labels[i] = pipeline.getPredictedClassLabel();
+  }
+  printf("\nSync predict\t\tMean(us): %.2f\tMax(us): %.2f\n", syncTime/numSamples, syncMax);
+
+  const char *modeNames[3] = {"BLOCK", "DROP_OLDEST", "COALESCE"};
+  for(UINT mode=AsyncPipeline::BLOCK; mode<=AsyncPipeline::COALESCE; mode++){
+    AsyncPipeline asyncPipeline;
+    ResultCounter counter;
+    asyncPipeline.registerResultObserver( counter );
+
+    //The result queue is large enough to hold every result, so the results can be checked after the run
+    pipeline.reset();
+    if( !asyncPipeline.start( pipeline, 16, mode, 1024 ) ){
+      printf("ERROR: Failed to start the async pipeline!\n");
+      return EXIT_FAILURE;
+    }
+
+    //Push the samples at a fixed rate, like a sensor callback that delivers a sample every samplePeriod microseconds
+    const double samplePeriod = 0.5 * syncTime / numSamples;
+    double pushTime = 0, pushMax = 0;
+    struct timespec streamStart, now;
+    clock_gettime(CLOCK_MONOTONIC, &streamStart);
+    for(UINT i=0; i<numSamples; i++){
+      VectorDouble sample = data.getRowVector(i);
+      do{ clock_gettime(CLOCK_MONOTONIC, &now); }while( getElapsedMicroSeconds(streamStart, now) < i * samplePeriod );
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      asyncPipeline.pushSample( sample );
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      const double t = getElapsedMicroSeconds(start, end);
+      pushTime += t;
+      pushMax = std::max( pushMax, t );
+    }
+    asyncPipeline.stop( true );
+
+    //Every result that was delivered should match the sync prediction of its sample
+    UINT numResults = 0, numMatches = 0;
+    PredictionResult result;
+    while( asyncPipeline.popResult( result ) ){
+      numResults++;
+      if( result.predictionSuccess && result.predictedClassLabel == labels[ result.sampleIndex ] ) numMatches++;
+    }
+
+    printf("Async %s\tPush mean(us): %.2f\tPush max(us): %.2f\tPushed: %u\tProcessed: %u\tDropped: %u\tCoalesced: %u\tMaxDepth: %u\tObserved: %u\tMatches: %u/%u\n",
+           modeNames[mode], pushTime/numSamples, pushMax, asyncPipeline.getNumPushedSamples(), asyncPipeline.getNumProcessedSamples(),
+           asyncPipeline.getNumDroppedSamples(), asyncPipeline.getNumCoalescedSamples(), asyncPipeline.getMaxQueueDepth(), counter.numResults, numMatches, numResults);
+
+    if( numMatches != numResults || counter.numResults != numResults ) return EXIT_FAILURE;
+    if( mode == AsyncPipeline::BLOCK && numResults != numSamples ) return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
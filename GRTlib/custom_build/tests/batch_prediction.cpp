@@ -0,0 +1,85 @@
+#include "GRT.h"
+
+using namespace GRT;
+
+//Checks GestureRecognitionPipeline::predictBatch gives the same labels, likelihoods and distances as calling predict on each row in turn,
+//for the classifiers with a batch kernel and a classifier that uses the default row by row batch, with and without scaling, null rejection,
+//a preprocessing filter and a postprocessing filter.  The pipeline is copied once trained and both copies are reset, so the filters of
+//both copies start from the same state
+const UINT numDimensions = 5;
+const UINT numClasses = 4;
+
+static LabelledClassificationData createData(Random &random, const UINT numSamples) {
+  LabelledClassificationData data(numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    const UINT classLabel = i % numClasses + 1;
+    VectorDouble sample(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) sample[j] = (classLabel == j+1 ? 3.0 : 0.0) + random.getRandomNumberGauss(0, 1.0) + 10*j;
+    data.addSample( classLabel, sample );
+  }
+  return data;
+}
+
+static bool hasSamePredictions(GestureRecognitionPipeline &batchPipeline, GestureRecognitionPipeline &rowPipeline, const MatrixDouble &inputs) {
+  vector< UINT > labels;
+  MatrixDouble likelihoods, distances;
+  if( !batchPipeline.predictBatch( inputs, labels, likelihoods, distances ) ) return false;
+  if( labels.size() != inputs.getNumRows() ) return false;
+
+  for(UINT i=0; i<inputs.getNumRows(); i++){
+    if( !rowPipeline.predict( inputs.getRowVector(i) ) ) return false;
+    if( rowPipeline.getPredictedClassLabel() != labels[i] ) return false;
+    if( rowPipeline.getClassLikelihoods() != likelihoods.getRowVector(i) ) return false;
+    if( rowPipeline.getClassDistances() != distances.getRowVector(i) ) return false;
+  }
+  return true;
+}
+
+static bool check(const string &name, const Classifier &classifier, const LabelledClassificationData &trainingData, const MatrixDouble &inputs, const bool useFilters) {
+  GestureRecognitionPipeline batchPipeline;
+  if( useFilters ){
+    batchPipeline.addPreProcessingModule( MovingAverageFilter(3, numDimensions) );
+    batchPipeline.addPostProcessingModule( ClassLabelFilter(2, 4) );
+  }
+  batchPipeline.setClassifier( classifier );
+  bool ok = batchPipeline.train( trainingData );
+  if( ok ){
+    GestureRecognitionPipeline rowPipeline( batchPipeline );
+    ok = batchPipeline.reset() && rowPipeline.reset() && hasSamePredictions( batchPipeline, rowPipeline, inputs );
+  }
+  printf("%s%s\t%s\n", name.c_str(), useFilters ? "+Filters" : "", ok ? "ok" : "FAILED");
+  return ok;
+}
+
+int main(int argc, const char * argv[]) {
+
+  TrainingLog::enableLogging( false );
+  WarningLog::enableLogging( false );
+  Random random(42);
+  bool ok = true;
+
+  const LabelledClassificationData trainingData = createData( random, 400 );
+  const LabelledClassificationData testData = createData( random, 300 );
+  MatrixDouble inputs( testData.getNumSamples(), numDimensions );
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    for(UINT j=0; j<numDimensions; j++) inputs[i][j] = testData[i][j];
+  }
+
+  for(UINT n=0; n<2; n++){
+    const bool useFilters = n == 1;
+    ok = check( "MinDist", MinDist(), trainingData, inputs, useFilters ) && ok;
+    ok = check( "MinDistScaledNullRejection", MinDist(true, true), trainingData, inputs, useFilters ) && ok;
+    ok = check( "ANBC", ANBC(), trainingData, inputs, useFilters ) && ok;
+    ok = check( "ANBCScaledNullRejection", ANBC(true, true), trainingData, inputs, useFilters ) && ok;
+    ok = check( "Softmax", Softmax(), trainingData, inputs, useFilters ) && ok;
+    ok = check( "SoftmaxScaled", Softmax(true), trainingData, inputs, useFilters ) && ok;
+    ok = check( "KNN", KNN(5), trainingData, inputs, useFilters ) && ok;
+    ok = check( "KNNScaledNullRejection", KNN(5, true, true), trainingData, inputs, useFilters ) && ok;
+    KNN linearKNN(5);
+    linearKNN.enableSpatialIndex( false );
+    ok = check( "KNNLinear", linearKNN, trainingData, inputs, useFilters ) && ok;
+    ok = check( "DecisionTree", DecisionTree(), trainingData, inputs, useFilters ) && ok;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,188 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Saves trained pipelines as text files and as binary model files, then checks the pipelines loaded from each file give exactly the same
+//predictions as the trained pipeline.  Also prints the size of each file and the time taken to load it, checks a RandomForests model
+//loaded from a mapped file uses the mapping directly, and converts each file to the other format and back
+const UINT numDimensions = 16;
+const UINT numClasses = 6;
+const UINT numLoads = 5;
+
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static long getFileSize(const string &filename) {
+  FILE *file = fopen( filename.c_str(), "rb" );
+  if( file == NULL ) return -1;
+  fseek( file, 0, SEEK_END );
+  const long size = ftell( file );
+  fclose( file );
+  return size;
+}
+
+static MatrixDouble createTimeSeries(Random &random, const UINT classLabel, const UINT length) {
+  MatrixDouble timeSeries(length, numDimensions);
+  const double phase = random.getRandomNumberUniform(0, 0.5);
+  for(UINT i=0; i<length; i++){
+    for(UINT j=0; j<numDimensions; j++){
+      timeSeries[i][j] = sin( (i * 6.0 / length) * (1 + classLabel * 0.25) + phase + j ) + random.getRandomNumberUniform(-0.2, 0.2);
+    }
+  }
+  return timeSeries;
+}
+
+//Runs every input through the pipeline and records the labels and likelihoods
+template< class T >
+static void getPredictions(GestureRecognitionPipeline &pipeline, const vector< T > &inputs, vector< UINT > &labels, vector< double > &likelihoods) {
+  labels.clear();
+  likelihoods.clear();
+  pipeline.reset();
+  for(UINT i=0; i<inputs.size(); i++){
+    pipeline.predict( inputs[i] );
+    labels.push_back( pipeline.getPredictedClassLabel() );
+    likelihoods.push_back( pipeline.getMaximumLikelihood() );
+  }
+}
+
+//Loads the file numLoads times and returns the average time of one load
+static double timeLoad(const string &filename, const bool binary, const bool useMemoryMapping) {
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT i=0; i<numLoads; i++){
+    GestureRecognitionPipeline pipeline;
+    if( binary ) pipeline.loadPipelineFromBinaryFile( filename, useMemoryMapping );
+    else pipeline.loadPipelineFromFile( filename );
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return getElapsedMicroSeconds(start, end) / numLoads;
+}
+
+template< class T >
+static bool runTest(const string &name, GestureRecognitionPipeline &pipeline, const vector< T > &inputs) {
+
+  const string textFilename = "binary_model_file_" + name + ".txt";
+  const string binaryFilename = "binary_model_file_" + name + ".grtm";
+  const string convertedBinaryFilename = "binary_model_file_" + name + "_converted.grtm";
+  const string convertedTextFilename = "binary_model_file_" + name + "_converted.txt";
+
+  vector< UINT > expectedLabels, labels;
+  vector< double > expectedLikelihoods, likelihoods;
+  getPredictions( pipeline, inputs, expectedLabels, expectedLikelihoods );
+
+  if( !pipeline.savePipelineToFile( textFilename ) || !pipeline.savePipelineToBinaryFile( binaryFilename ) ){
+    printf("ERROR: Failed to save the %s pipeline!\n", name.c_str());
+    return false;
+  }
+
+  //The text file is not bit exact (the values are written as decimal text), so it is only checked for the same labels
+  bool match = true;
+  GestureRecognitionPipeline textPipeline;
+  if( !textPipeline.loadPipelineFromFile( textFilename ) ) match = false;
+  getPredictions( textPipeline, inputs, labels, likelihoods );
+  if( labels != expectedLabels ) match = false;
+
+  //The binary file must give exactly the same results, with and without memory mapping
+  bool binaryMatch = true;
+  bool mapped = true;
+  for(UINT k=0; k<2; k++){
+    GestureRecognitionPipeline binaryPipeline;
+    if( !binaryPipeline.loadPipelineFromBinaryFile( binaryFilename, k == 0 ) ) binaryMatch = false;
+    getPredictions( binaryPipeline, inputs, labels, likelihoods );
+    if( labels != expectedLabels || likelihoods != expectedLikelihoods ) binaryMatch = false;
+    if( k == 0 && binaryPipeline.getClassifier()->getClassifierType() == "RandomForests" ){
+      mapped = binaryPipeline.getClassifier< RandomForests >()->getFlatForest().getIsMemoryMapped();
+    }
+  }
+
+  //loadPipelineFromFile should find the binary file by itself
+  GestureRecognitionPipeline autoPipeline;
+  if( !autoPipeline.loadPipelineFromFile( binaryFilename ) ) binaryMatch = false;
+  getPredictions( autoPipeline, inputs, labels, likelihoods );
+  if( labels != expectedLabels || likelihoods != expectedLikelihoods ) binaryMatch = false;
+
+  //Convert text -> binary and binary -> text
+  bool converted = GestureRecognitionPipeline::convertPipelineFile( textFilename, convertedBinaryFilename ) &&
+                   GestureRecognitionPipeline::convertPipelineFile( binaryFilename, convertedTextFilename ) &&
+                   BinaryModelReader::isBinaryModelFile( convertedBinaryFilename ) && !BinaryModelReader::isBinaryModelFile( convertedTextFilename );
+  GestureRecognitionPipeline convertedPipeline;
+  if( !convertedPipeline.loadPipelineFromFile( convertedBinaryFilename ) ) converted = false;
+  getPredictions( convertedPipeline, inputs, labels, likelihoods );
+  if( labels != expectedLabels ) converted = false;
+  if( !convertedPipeline.loadPipelineFromFile( convertedTextFilename ) ) converted = false;
+  getPredictions( convertedPipeline, inputs, labels, likelihoods );
+  if( labels != expectedLabels ) converted = false;
+
+  const double textTime = timeLoad( textFilename, false, false );
+  const double binaryTime = timeLoad( binaryFilename, true, false );
+  const double mappedTime = timeLoad( binaryFilename, true, true );
+
+  printf("%s\tText: %s\tBinary: %s\tMapped: %s\tConverted: %s\tText(bytes): %ld\tBinary(bytes): %ld\tTextLoad(ms): %.2f\tBinaryLoad(ms): %.2f\tMappedLoad(ms): %.2f\n",
+         name.c_str(), match ? "yes" : "NO", binaryMatch ? "yes" : "NO", mapped ? "yes" : "NO", converted ? "yes" : "NO",
+         getFileSize( textFilename ), getFileSize( binaryFilename ), textTime / 1000.0, binaryTime / 1000.0, mappedTime / 1000.0);
+
+  remove( textFilename.c_str() );
+  remove( binaryFilename.c_str() );
+  remove( convertedBinaryFilename.c_str() );
+  remove( convertedTextFilename.c_str() );
+
+  return match && binaryMatch && mapped && converted;
+}
+
+static bool runClassifierTest(const string &name, const Classifier &classifier, const LabelledClassificationData &trainingData, const vector< VectorDouble > &inputs) {
+  GestureRecognitionPipeline pipeline;
+  pipeline.addPreProcessingModule( MovingAverageFilter(5, numDimensions) );
+  pipeline.setClassifier( classifier );
+  pipeline.addPostProcessingModule( ClassLabelFilter(3, 5) );
+  if( !pipeline.train( trainingData ) ){
+    printf("ERROR: Failed to train the %s pipeline!\n", name.c_str());
+    return false;
+  }
+  return runTest( name, pipeline, inputs );
+}
+
+int main(int argc, const char * argv[]) {
+
+  TrainingLog::enableLogging( false );
+  Random random(42);
+
+  LabelledClassificationData trainingData(numDimensions);
+  for(UINT i=0; i<6000; i++){
+    const UINT classLabel = (i % numClasses) + 1;
+    VectorDouble sample(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) sample[j] = sin( classLabel * 0.9 + j ) + random.getRandomNumberGauss(0, 0.4);
+    trainingData.addSample( classLabel, sample );
+  }
+
+  vector< VectorDouble > inputs( 2000, VectorDouble(numDimensions) );
+  for(UINT i=0; i<inputs.size(); i++){
+    for(UINT j=0; j<numDimensions; j++) inputs[i][j] = sin( ((i / 25) % numClasses + 1) * 0.9 + j ) + random.getRandomNumberGauss(0, 0.4);
+  }
+
+  KNN knn(5);
+  knn.enableNullRejection( true );
+  knn.enableSpatialIndex( true );
+  bool ok = true;
+  ok = runClassifierTest( "RandomForests", RandomForests(), trainingData, inputs ) && ok;
+  ok = runClassifierTest( "KNN", knn, trainingData, inputs ) && ok;
+  ok = runClassifierTest( "Softmax", Softmax(), trainingData, inputs ) && ok;
+
+  //DTW keeps its templates as binary data
+  LabelledTimeSeriesClassificationData timeSeriesData(numDimensions);
+  for(UINT i=0; i<numClasses*10; i++) timeSeriesData.addSample( (i % numClasses) + 1, createTimeSeries(random, i % numClasses, 100) );
+  vector< MatrixDouble > timeSeriesInputs;
+  for(UINT i=0; i<50; i++) timeSeriesInputs.push_back( createTimeSeries(random, i % numClasses, 100) );
+
+  GestureRecognitionPipeline dtwPipeline;
+  dtwPipeline.setClassifier( DTW() );
+  if( !dtwPipeline.train( timeSeriesData ) ){
+    printf("ERROR: Failed to train the DTW pipeline!\n");
+    return EXIT_FAILURE;
+  }
+  ok = runTest( "DTW", dtwPipeline, timeSeriesInputs ) && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,398 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Builds a LabelledClassificationData alongside a plain copy of its rows, runs it through the dataset functions and the classifiers that read
+//the samples directly, and checks every result against the same result recomputed from the plain rows.  Then times reading every sample,
+//copying the dataset, extracting the k folds and training a KNN model on a large dataset, and prints the times to stderr
+const UINT numDimensions = 8;
+const UINT numClasses = 5;
+const UINT kFoldValue = 5;
+const unsigned long long randomSeed = 1234;
+
+struct Row{
+  UINT classLabel;
+  VectorDouble sample;
+  bool operator<(const Row &row) const{ return classLabel != row.classLabel ? classLabel < row.classLabel : sample < row.sample; }
+  bool operator==(const Row &row) const{ return classLabel == row.classLabel && sample == row.sample; }
+};
+
+static UINT numFailures = 0;
+
+//Silences the progress libsvm prints while training the SVM
+static void printNothing(const char *s) {}
+
+static double getElapsedMilliSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e3 + (end.tv_nsec - start.tv_nsec) / 1.0e6;
+}
+
+static void check(const string &name, const bool ok) {
+  printf("%s\t%s\n", name.c_str(), ok ? "ok" : "FAILED");
+  if( !ok ) numFailures++;
+}
+
+static bool isClose(const double a, const double b, const double tolerance) {
+  return fabs( a - b ) <= tolerance * (fabs(b) > 1 ? fabs(b) : 1);
+}
+
+static LabelledClassificationData createData(Random &random, const UINT numSamples, vector< Row > &rows) {
+  LabelledClassificationData data(numDimensions);
+  rows.clear();
+  for(UINT i=0; i<numSamples; i++){
+    Row row;
+    row.classLabel = i % numClasses + 1;
+    row.sample.resize(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) row.sample[j] = (row.classLabel == j+1 ? 1.0 : 0.0) + random.getRandomNumberGauss(0, 0.5) + j;
+    data.addSample( row.classLabel, row.sample );
+    rows.push_back( row );
+  }
+  return data;
+}
+
+static vector< Row > getRows(const LabelledClassificationData &data) {
+  vector< Row > rows( data.getNumSamples() );
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    rows[i].classLabel = data[i].getClassLabel();
+    rows[i].sample = data[i].getSample();
+  }
+  return rows;
+}
+
+//The dataset must hold exactly the rows, in the same order, with a class tracker that counts them
+static bool hasRows(const LabelledClassificationData &data, const vector< Row > &rows, const double tolerance = 0) {
+  if( data.getNumSamples() != rows.size() || data.getNumDimensions() != numDimensions ) return false;
+  std::map< UINT, UINT > classCounts;
+  for(UINT i=0; i<rows.size(); i++){
+    if( data[i].getClassLabel() != rows[i].classLabel ) return false;
+    for(UINT j=0; j<numDimensions; j++){
+      if( tolerance == 0 ? data[i][j] != rows[i].sample[j] : !isClose( data[i][j], rows[i].sample[j], tolerance ) ) return false;
+    }
+    classCounts[ rows[i].classLabel ]++;
+  }
+  const vector< UINT > classLabels = data.getClassLabels();
+  const vector< UINT > classSampleCounts = data.getNumSamplesPerClass();
+  if( classLabels.size() != classCounts.size() ) return false;
+  for(UINT k=0; k<classLabels.size(); k++){
+    if( classCounts[ classLabels[k] ] != classSampleCounts[k] ) return false;
+  }
+  return true;
+}
+
+//The datasets must hold the same rows in any order
+static bool hasSameRows(vector< Row > a, vector< Row > b) {
+  std::sort( a.begin(), a.end() );
+  std::sort( b.begin(), b.end() );
+  return a == b;
+}
+
+static vector< Row > getClassRows(const vector< Row > &rows, const UINT classLabel) {
+  vector< Row > classRows;
+  for(UINT i=0; i<rows.size(); i++) if( rows[i].classLabel == classLabel ) classRows.push_back( rows[i] );
+  return classRows;
+}
+
+static bool hasValues(const VectorDouble &v, const VectorDouble &expected, const double tolerance) {
+  if( v.size() != expected.size() ) return false;
+  for(UINT i=0; i<v.size(); i++) if( !isClose( v[i], expected[i], tolerance ) ) return false;
+  return true;
+}
+
+static bool hasValues(const MatrixDouble &m, const MatrixDouble &expected, const double tolerance) {
+  if( m.getNumRows() != expected.getNumRows() || m.getNumCols() != expected.getNumCols() ) return false;
+  for(UINT i=0; i<m.getNumRows(); i++){
+    for(UINT j=0; j<m.getNumCols(); j++) if( !isClose( m[i][j], expected[i][j], tolerance ) ) return false;
+  }
+  return true;
+}
+
+//The statistics of the rows, computed with plain two pass loops
+static VectorDouble getMean(const vector< Row > &rows) {
+  VectorDouble mean(numDimensions, 0);
+  for(UINT i=0; i<rows.size(); i++) for(UINT j=0; j<numDimensions; j++) mean[j] += rows[i].sample[j];
+  for(UINT j=0; j<numDimensions; j++) mean[j] /= rows.size();
+  return mean;
+}
+
+static VectorDouble getStdDev(const vector< Row > &rows) {
+  const VectorDouble mean = getMean( rows );
+  VectorDouble stdDev(numDimensions, 0);
+  for(UINT i=0; i<rows.size(); i++) for(UINT j=0; j<numDimensions; j++) stdDev[j] += SQR( rows[i].sample[j] - mean[j] );
+  for(UINT j=0; j<numDimensions; j++) stdDev[j] = sqrt( stdDev[j] / (rows.size()-1) );
+  return stdDev;
+}
+
+static MatrixDouble getCovariance(const vector< Row > &rows) {
+  const VectorDouble mean = getMean( rows );
+  MatrixDouble covariance(numDimensions, numDimensions);
+  covariance.setAllValues( 0 );
+  for(UINT i=0; i<rows.size(); i++){
+    for(UINT j=0; j<numDimensions; j++){
+      for(UINT k=0; k<numDimensions; k++) covariance[j][k] += (rows[i].sample[j] - mean[j]) * (rows[i].sample[k] - mean[k]);
+    }
+  }
+  for(UINT j=0; j<numDimensions; j++) for(UINT k=0; k<numDimensions; k++) covariance[j][k] /= rows.size()-1;
+  return covariance;
+}
+
+static vector< MinMax > getRanges(const vector< Row > &rows) {
+  vector< MinMax > ranges(numDimensions);
+  for(UINT j=0; j<numDimensions; j++){
+    ranges[j].minValue = ranges[j].maxValue = rows[0].sample[j];
+    for(UINT i=1; i<rows.size(); i++){
+      ranges[j].minValue = std::min( ranges[j].minValue, rows[i].sample[j] );
+      ranges[j].maxValue = std::max( ranges[j].maxValue, rows[i].sample[j] );
+    }
+  }
+  return ranges;
+}
+
+//Returns the accuracy of the classifier on the test data, and the predicted labels and likelihoods in labels and likelihoods
+static double getAccuracy(Classifier &classifier, const LabelledClassificationData &testData, vector< UINT > &labels, vector< VectorDouble > &likelihoods) {
+  UINT numCorrect = 0;
+  labels.resize( testData.getNumSamples() );
+  likelihoods.resize( testData.getNumSamples() );
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    if( !classifier.predict( testData[i].getSample() ) ) return 0;
+    labels[i] = classifier.getPredictedClassLabel();
+    likelihoods[i] = classifier.getClassLikelihoods();
+    if( labels[i] == testData[i].getClassLabel() ) numCorrect++;
+  }
+  return numCorrect / double(testData.getNumSamples());
+}
+
+//The data has one informative dimension per class with a noise of half the class offset, so the classifiers should be right most of the time
+static void checkClassifier(const string &name, Classifier &classifier, const LabelledClassificationData &trainingData, const LabelledClassificationData &testData, const double minAccuracy) {
+  vector< UINT > labels;
+  vector< VectorDouble > likelihoods;
+  const bool trained = classifier.train( trainingData );
+  const double accuracy = trained ? getAccuracy( classifier, testData, labels, likelihoods ) : 0;
+  printf("%s\tAccuracy: %.4f\n", name.c_str(), accuracy);
+  check( name, trained && accuracy >= minAccuracy );
+}
+
+int main(int argc, const char * argv[]) {
+
+  TrainingLog::enableLogging( false );
+  WarningLog::enableLogging( false );
+  LIBSVM::svm_set_print_string_function( printNothing );
+  Random random(42);
+
+  vector< Row > rows, testRows;
+  LabelledClassificationData data = createData( random, 3000, rows );
+  const LabelledClassificationData testData = createData( random, 500, testRows );
+  check( "Data", hasRows( data, rows ) && hasRows( testData, testRows ) );
+
+  //The statistics
+  const vector< MinMax > ranges = data.getRanges();
+  const vector< MinMax > expectedRanges = getRanges( rows );
+  bool rangesOk = ranges.size() == numDimensions;
+  for(UINT j=0; j<ranges.size() && rangesOk; j++){
+    rangesOk = ranges[j].minValue == expectedRanges[j].minValue && ranges[j].maxValue == expectedRanges[j].maxValue;
+  }
+  const vector< MinMax > matrixRanges = data.getDataAsMatrixDouble().getRanges();
+  for(UINT j=0; j<matrixRanges.size() && rangesOk; j++){
+    rangesOk = matrixRanges[j].minValue == ranges[j].minValue && matrixRanges[j].maxValue == ranges[j].maxValue;
+  }
+  check( "Ranges", rangesOk );
+  check( "Mean", hasValues( data.getMean(), getMean( rows ), 1.0e-12 ) );
+  check( "StdDev", hasValues( data.getStdDev(), getStdDev( rows ), 1.0e-12 ) );
+  check( "Covariance", hasValues( data.getCovarianceMatrix(), getCovariance( rows ), 1.0e-12 ) );
+  {
+    const vector< UINT > classLabels = data.getClassLabels();
+    MatrixDouble classMean( (UINT)classLabels.size(), numDimensions ), classStdDev( (UINT)classLabels.size(), numDimensions );
+    for(UINT k=0; k<classLabels.size(); k++){
+      const vector< Row > classRows = getClassRows( rows, classLabels[k] );
+      const VectorDouble mean = getMean( classRows ), stdDev = getStdDev( classRows );
+      for(UINT j=0; j<numDimensions; j++){ classMean[k][j] = mean[j]; classStdDev[k][j] = stdDev[j]; }
+    }
+    check( "ClassMean", hasValues( data.getClassMean(), classMean, 1.0e-12 ) );
+    check( "ClassStdDev", hasValues( data.getClassStdDev(), classStdDev, 1.0e-12 ) );
+  }
+  {
+    const MatrixDouble m = data.getDataAsMatrixDouble();
+    bool ok = m.getNumRows() == rows.size() && m.getNumCols() == numDimensions;
+    for(UINT i=0; i<m.getNumRows() && ok; i++) ok = m.getRowVector(i) == rows[i].sample;
+    check( "AsMatrix", ok );
+  }
+
+  //Every sample must be in exactly one test fold, and each training fold must hold every other sample
+  {
+    bool ok = data.spiltDataIntoKFolds( kFoldValue, false, randomSeed );
+    vector< Row > testFoldRows;
+    for(UINT k=0; k<kFoldValue && ok; k++){
+      const vector< Row > testFold = getRows( data.getTestFoldData( k ) );
+      vector< Row > foldRows = getRows( data.getTrainingFoldData( k ) );
+      ok = testFold.size() == rows.size() / kFoldValue;
+      foldRows.insert( foldRows.end(), testFold.begin(), testFold.end() );
+      ok = ok && hasSameRows( foldRows, rows );
+      testFoldRows.insert( testFoldRows.end(), testFold.begin(), testFold.end() );
+    }
+    check( "Folds", ok && hasSameRows( testFoldRows, rows ) );
+
+    //Each class has 600 samples, so each stratified test fold must hold 120 of each class
+    ok = data.spiltDataIntoKFolds( kFoldValue, true, randomSeed );
+    testFoldRows.clear();
+    for(UINT k=0; k<kFoldValue && ok; k++){
+      const LabelledClassificationData testFold = data.getTestFoldData( k );
+      const vector< UINT > classSampleCounts = testFold.getNumSamplesPerClass();
+      ok = classSampleCounts.size() == numClasses;
+      for(UINT c=0; c<classSampleCounts.size() && ok; c++) ok = classSampleCounts[c] == rows.size() / numClasses / kFoldValue;
+      const vector< Row > testFoldData = getRows( testFold );
+      testFoldRows.insert( testFoldRows.end(), testFoldData.begin(), testFoldData.end() );
+    }
+    check( "StratifiedFolds", ok && hasSameRows( testFoldRows, rows ) );
+  }
+
+  //The partition and the bootstrap are drawn from the system time, so only what does not depend on the draw is checked
+  {
+    LabelledClassificationData copy( data );
+    const LabelledClassificationData testPartition = copy.partition( 80, true );
+    vector< Row > partitionRows = getRows( copy );
+    const vector< Row > testPartitionRows = getRows( testPartition );
+    bool ok = partitionRows.size() == 2400 && testPartitionRows.size() == 600;
+    partitionRows.insert( partitionRows.end(), testPartitionRows.begin(), testPartitionRows.end() );
+    check( "Partition", ok && hasSameRows( partitionRows, rows ) );
+
+    vector< Row > sortedRows( rows );
+    std::sort( sortedRows.begin(), sortedRows.end() );
+    const vector< Row > bootstrapRows = getRows( data.getBootstrappedDataset( 1000 ) );
+    ok = bootstrapRows.size() == 1000;
+    for(UINT i=0; i<bootstrapRows.size() && ok; i++) ok = std::binary_search( sortedRows.begin(), sortedRows.end(), bootstrapRows[i] );
+    check( "Bootstrap", ok );
+  }
+
+  //Editing the dataset, each edit is repeated on the plain rows
+  {
+    LabelledClassificationData copy( data );
+    vector< Row > expected( rows );
+    check( "Class3", hasRows( copy.getClassData( 3 ), getClassRows( rows, 3 ) ) );
+
+    const LabelledRegressionData regressionData = copy.reformatAsLabelledRegressionData();
+    bool ok = regressionData.getNumSamples() == rows.size();
+    for(UINT i=0; i<regressionData.getNumSamples() && ok; i++){
+      const VectorDouble &target = regressionData[i].getTargetVector();
+      ok = regressionData[i].getInputVector() == rows[i].sample && target.size() == numClasses && target[ rows[i].classLabel-1 ] == 1;
+    }
+    check( "Regression", ok );
+
+    const MatrixDouble unlabelled = copy.reformatAsUnlabelledClassificationData().getDataAsMatrixDouble();
+    ok = unlabelled.getNumRows() == rows.size();
+    for(UINT i=0; i<unlabelled.getNumRows() && ok; i++) ok = unlabelled.getRowVector(i) == rows[i].sample;
+    check( "Unlabelled", ok );
+
+    const UINT numErased = copy.eraseAllSamplesWithClassLabel( 2 );
+    vector< Row > kept;
+    for(UINT i=0; i<expected.size(); i++) if( expected[i].classLabel != 2 ) kept.push_back( expected[i] );
+    check( "Erase", numErased == expected.size() - kept.size() && hasRows( copy, kept ) );
+    expected = kept;
+
+    copy.relabelAllSamplesWithClassLabel( 4, 9 );
+    copy.sortClassLabels();
+    copy.removeLastSample();
+    for(UINT i=0; i<expected.size(); i++) if( expected[i].classLabel == 4 ) expected[i].classLabel = 9;
+    expected.pop_back();
+    check( "Relabel", hasRows( copy, expected ) );
+
+    copy.merge( testData );
+    expected.insert( expected.end(), testRows.begin(), testRows.end() );
+    check( "Merge", hasRows( copy, expected ) );
+
+    const vector< MinMax > mergedRanges = getRanges( expected );
+    copy.scale( 0, 1 );
+    for(UINT i=0; i<expected.size(); i++){
+      for(UINT j=0; j<numDimensions; j++){
+        expected[i].sample[j] = (expected[i].sample[j] - mergedRanges[j].minValue) / (mergedRanges[j].maxValue - mergedRanges[j].minValue);
+      }
+    }
+    check( "Scale", hasRows( copy, expected, 1.0e-12 ) );
+
+    copy[0][0] = 42;
+    expected[0].sample[0] = 42;
+    check( "Write", hasRows( copy, expected, 1.0e-12 ) );
+
+    //The text files are written with the default stream precision of 6 significant digits
+    LabelledClassificationData loaded;
+    ok = copy.saveDatasetToFile( "dataset_storage.txt" ) && loaded.loadDatasetFromFile( "dataset_storage.txt" );
+    check( "Loaded", ok && hasRows( loaded, expected, 1.0e-5 ) );
+    loaded.clear();
+    ok = copy.saveDatasetToCSVFile( "dataset_storage.csv" ) && loaded.loadDatasetFromCSVFile( "dataset_storage.csv" );
+    check( "LoadedCSV", ok && hasRows( loaded, expected, 1.0e-5 ) );
+  }
+
+  //A row of the matrix itself can be pushed back, including when the push grows the buffer
+  {
+    MatrixDouble m;
+    bool ok = m.push_back( rows[0].sample );
+    for(UINT i=0; i<17 && ok; i++){
+      ok = m.push_back( m[i] ) && m.getNumRows() == i+2 && m.getRowVector(i+1) == rows[0].sample;
+    }
+    check( "PushBackOwnRow", ok );
+  }
+
+  //The classifiers that read the training samples directly
+  {
+    KNN knn(10);
+    checkClassifier( "KNN", knn, data, testData, 0.7 );
+
+    //The loaded model must give exactly the same predictions
+    KNN loaded;
+    vector< UINT > labels, loadedLabels;
+    vector< VectorDouble > likelihoods, loadedLikelihoods;
+    bool ok = knn.saveModelToFile( "dataset_storage_knn.txt" ) && loaded.loadModelFromFile( "dataset_storage_knn.txt" );
+    ok = ok && getAccuracy( knn, testData, labels, likelihoods ) == getAccuracy( loaded, testData, loadedLabels, loadedLikelihoods );
+    check( "KNN(loaded)", ok && labels == loadedLabels && likelihoods == loadedLikelihoods );
+
+    SVM svm;
+    checkClassifier( "SVM", svm, data, testData, 0.7 );
+    DecisionTree decisionTree;
+    checkClassifier( "DecisionTree", decisionTree, data, testData, 0.6 );
+  }
+
+  //The times, on a dataset large enough that the samples do not fit in the cache
+  LabelledClassificationData large = createData( random, 400000, rows );
+  struct timespec start, end;
+  double sum = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT n=0; n<10; n++){
+    for(UINT i=0; i<large.getNumSamples(); i++){
+      for(UINT j=0; j<numDimensions; j++) sum += large[i][j];
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fprintf(stderr, "Iterate(ms): %.1f\t(%g)\n", getElapsedMilliSeconds(start, end), sum);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT n=0; n<10; n++){
+    LabelledClassificationData copy( large );
+    sum += copy.getNumSamples();
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fprintf(stderr, "Copy(ms): %.1f\n", getElapsedMilliSeconds(start, end));
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  LabelledClassificationData built( numDimensions );
+  VectorDouble sample( numDimensions, 1 );
+  for(UINT i=0; i<large.getNumSamples(); i++) built.addSample( i % numClasses + 1, sample );
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fprintf(stderr, "AddSample(ms): %.1f\n", getElapsedMilliSeconds(start, end));
+
+  large.spiltDataIntoKFolds( kFoldValue, false, randomSeed );
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT k=0; k<kFoldValue; k++){
+    sum += large.getTrainingFoldData( k ).getNumSamples() + large.getTestFoldData( k ).getNumSamples();
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fprintf(stderr, "Folds(ms): %.1f\n", getElapsedMilliSeconds(start, end));
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  KNN knn(10);
+  knn.train( large );
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fprintf(stderr, "KNNTrain(ms): %.1f\n", getElapsedMilliSeconds(start, end));
+
+  printf("Failures: %u\n", numFailures);
+
+  return numFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
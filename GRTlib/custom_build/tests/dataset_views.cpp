@@ -0,0 +1,196 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Checks the fold, partition and bootstrapped views of a LabelledClassificationData hold the same samples as the copies made by
+//getTrainingFoldData, getTestFoldData and getBootstrappedDataset, and that a DecisionTree trained with a view matches a DecisionTree
+//trained with a copy.  Then times making the k folds and the bootstrapped training data of a large dataset as copies and as views
+const UINT numDimensions = 8;
+const UINT numClasses = 5;
+const UINT kFoldValue = 10;
+const unsigned long long randomSeed = 1234;
+
+static double getElapsedMilliSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e3 + (end.tv_nsec - start.tv_nsec) / 1.0e6;
+}
+
+static LabelledClassificationData createData(Random &random, const UINT numSamples) {
+  LabelledClassificationData data(numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    const UINT classLabel = i % numClasses + 1;
+    VectorDouble sample(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) sample[j] = (classLabel == j+1 ? 1.0 : 0.0) + random.getRandomNumberGauss(0, 0.5) + j;
+    data.addSample( classLabel, sample );
+  }
+  return data;
+}
+
+//Two datasets are the same if they hold the same samples in the same order, and list the same classes in the same order
+static bool isSame(const LabelledClassificationData &a, const LabelledClassificationData &b) {
+  if( a.getNumSamples() != b.getNumSamples() || a.getNumDimensions() != b.getNumDimensions() || a.getNumClasses() != b.getNumClasses() ) return false;
+  for(UINT i=0; i<a.getNumSamples(); i++){
+    if( a[i].getClassLabel() != b[i].getClassLabel() ) return false;
+    for(UINT j=0; j<a.getNumDimensions(); j++) if( a[i][j] != b[i][j] ) return false;
+  }
+  const vector< ClassTracker > ta = a.getClassTracker();
+  const vector< ClassTracker > tb = b.getClassTracker();
+  for(UINT k=0; k<ta.size(); k++){
+    if( ta[k].classLabel != tb[k].classLabel || ta[k].counter != tb[k].counter ) return false;
+  }
+  const vector< MinMax > ra = a.getRanges();
+  const vector< MinMax > rb = b.getRanges();
+  for(UINT j=0; j<ra.size(); j++){
+    if( ra[j].minValue != rb[j].minValue || ra[j].maxValue != rb[j].maxValue ) return false;
+  }
+  return true;
+}
+
+//The view must read the same samples through the [] operator as the copy of the view holds
+static bool isSame(const LabelledClassificationDataView &view, const LabelledClassificationData &data) {
+  if( view.getNumSamples() != data.getNumSamples() || view.getNumClasses() != data.getNumClasses() ) return false;
+  for(UINT i=0; i<view.getNumSamples(); i++){
+    if( view[i].getClassLabel() != data[i].getClassLabel() ) return false;
+    for(UINT j=0; j<view.getNumDimensions(); j++) if( view[i][j] != data[i][j] ) return false;
+  }
+  return view.getClassLabels() == data.getClassLabels() && isSame( view.getLabelledClassificationData(), data );
+}
+
+static bool check(const string &name, const bool result) {
+  printf("%s\t%s\n", name.c_str(), result ? "ok" : "FAILED");
+  return result;
+}
+
+static bool hasSamePredictions(Classifier &a, Classifier &b, const LabelledClassificationData &testData) {
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    if( !a.predict( testData[i].getSample() ) || !b.predict( testData[i].getSample() ) ) return false;
+    if( a.getPredictedClassLabel() != b.getPredictedClassLabel() || a.getClassLikelihoods() != b.getClassLikelihoods() ) return false;
+  }
+  return true;
+}
+
+int main(int argc, const char * argv[]) {
+
+  TrainingLog::enableLogging( false );
+  WarningLog::enableLogging( false );
+  Random random(42);
+  bool ok = true;
+
+  LabelledClassificationData data = createData( random, 3000 );
+  const LabelledClassificationData testData = createData( random, 500 );
+
+  //The folds
+  for(UINT n=0; n<2; n++){
+    const bool useStratifiedSampling = n == 1;
+    data.spiltDataIntoKFolds( kFoldValue, useStratifiedSampling, randomSeed );
+    bool sameFolds = true;
+    for(UINT k=0; k<kFoldValue; k++){
+      sameFolds = isSame( data.getTrainingFoldView( k ), data.getTrainingFoldData( k ) ) && sameFolds;
+      sameFolds = isSame( data.getTestFoldView( k ), data.getTestFoldData( k ) ) && sameFolds;
+    }
+    ok = check( useStratifiedSampling ? "StratifiedFolds" : "Folds", sameFolds ) && ok;
+  }
+  ok = check( "FoldOutOfRange", data.getTrainingFoldView( kFoldValue ).getNumSamples() == 0 && data.getTestFoldView( kFoldValue ).getNumSamples() == 0 ) && ok;
+
+  //The bootstrap, the small bootstrap will miss some of the classes, which must still be listed with a count of zero
+  ok = check( "Bootstrap", isSame( data.getBootstrappedView( 0, randomSeed ), data.getBootstrappedDataset( 0, randomSeed ) ) ) && ok;
+  ok = check( "SmallBootstrap", isSame( data.getBootstrappedView( 3, randomSeed ), data.getBootstrappedDataset( 3, randomSeed ) ) && data.getBootstrappedView( 3, randomSeed ).getNumClasses() == numClasses ) && ok;
+  {
+    LabelledClassificationData scaled( data );
+    vector< MinMax > externalRanges( numDimensions, MinMax(-10, 10) );
+    scaled.setExternalRanges( externalRanges, true );
+    const LabelledClassificationDataView view = scaled.getBootstrappedView( 0, randomSeed );
+    ok = check( "BootstrapExternalRanges", isSame( view, scaled.getBootstrappedDataset( 0, randomSeed ) ) && view.getRanges()[0].maxValue == 10 ) && ok;
+  }
+
+  //The partition, the two views must hold every sample of the dataset once, with the classes split in proportion
+  {
+    LabelledClassificationDataView trainingSet, testSet;
+    bool samePartition = data.getPartitionViews( 80, trainingSet, testSet, true, randomSeed );
+    vector< UINT > counts( data.getNumSamples(), 0 );
+    for(UINT i=0; i<trainingSet.getNumSamples(); i++) counts[ trainingSet.getIndexs()[i] ]++;
+    for(UINT i=0; i<testSet.getNumSamples(); i++) counts[ testSet.getIndexs()[i] ]++;
+    for(UINT i=0; i<counts.size(); i++) samePartition = counts[i] == 1 && samePartition;
+    for(UINT k=0; k<trainingSet.getNumClasses(); k++) samePartition = trainingSet.getClassTracker()[k].counter == 480 && samePartition;
+    samePartition = trainingSet.getNumSamples() == 2400 && testSet.getNumSamples() == 600 && samePartition;
+    ok = check( "StratifiedPartition", samePartition ) && ok;
+
+    LabelledClassificationDataView otherTrainingSet, otherTestSet;
+    data.getPartitionViews( 80, otherTrainingSet, otherTestSet, false, randomSeed );
+    ok = check( "Partition", otherTrainingSet.getNumSamples() == 2400 && otherTestSet.getNumSamples() == 600 ) && ok;
+    LabelledClassificationData copy( data );
+    ok = check( "PartitionCopy", copy.partition( 80, true ).getNumSamples() == 600 && copy.getNumSamples() == 2400 ) && ok;
+  }
+
+  //A DecisionTree trained with a view must match a DecisionTree trained with a copy of the view, with and without scaling
+  data.spiltDataIntoKFolds( kFoldValue, false, randomSeed );
+  for(UINT n=0; n<2; n++){
+    const bool useScaling = n == 1;
+    DecisionTree fromView(useScaling, 20, 5, 10, true);
+    DecisionTree fromCopy( fromView );
+    const bool trained = fromView.train( data.getTrainingFoldView( 0 ) ) && fromCopy.train( data.getTrainingFoldData( 0 ) );
+    ok = check( useScaling ? "DecisionTreeScaled" : "DecisionTree", trained && hasSamePredictions( fromView, fromCopy, testData ) ) && ok;
+  }
+
+  //Classifiers that do not read views are trained with a copy of the view
+  {
+    KNN fromView(10), fromCopy(10);
+    Classifier &classifier = fromView;
+    const bool trained = classifier.train( data.getTrainingFoldView( 1 ) ) && fromCopy.train( data.getTrainingFoldData( 1 ) );
+    ok = check( "KNN", trained && hasSamePredictions( fromView, fromCopy, testData ) ) && ok;
+  }
+
+  //A pipeline with no preprocessing or feature extraction modules trains the classifier with the view
+  {
+    GestureRecognitionPipeline fromView, fromCopy;
+    fromView.setClassifier( DecisionTree() );
+    fromCopy.setClassifier( DecisionTree() );
+    const bool trained = fromView.train( data.getTrainingFoldView( 2 ) ) && fromCopy.train( data.getTrainingFoldData( 2 ) );
+    ok = check( "Pipeline", trained && hasSamePredictions( *fromView.getClassifier(), *fromCopy.getClassifier(), testData ) ) && ok;
+  }
+
+  //The random forest and bag are trained with bootstrapped views
+  {
+    RandomForests forest;
+    BAG bag;
+    bag.addClassifierToEnsemble( DecisionTree() );
+    bag.addClassifierToEnsemble( KNN(5) );
+    ok = check( "RandomForests", forest.train( data ) ) && ok;
+    ok = check( "BAG", bag.train( data ) ) && ok;
+  }
+
+  //The times, on a dataset large enough that the samples do not fit in the cache
+  LabelledClassificationData large = createData( random, 400000 );
+  large.spiltDataIntoKFolds( kFoldValue, false, randomSeed );
+  struct timespec start, end;
+  double copyBytes = 0, viewBytes = 0;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT k=0; k<kFoldValue; k++){
+    LabelledClassificationData fold = large.getTrainingFoldData( k );
+    copyBytes += fold.getNumSamples() * (numDimensions * sizeof(double) + sizeof(UINT));
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fprintf(stderr, "FoldCopies(ms): %.1f\tBytes: %.0f\n", getElapsedMilliSeconds(start, end), copyBytes);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT k=0; k<kFoldValue; k++){
+    LabelledClassificationDataView fold = large.getTrainingFoldView( k );
+    viewBytes += fold.getNumSamples() * sizeof(UINT);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fprintf(stderr, "FoldViews(ms): %.1f\tBytes: %.0f\n", getElapsedMilliSeconds(start, end), viewBytes);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT n=0; n<10; n++) large.getBootstrappedDataset( 0, randomSeed );
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fprintf(stderr, "BootstrapCopies(ms): %.1f\n", getElapsedMilliSeconds(start, end));
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT n=0; n<10; n++) large.getBootstrappedView( 0, randomSeed );
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fprintf(stderr, "BootstrapViews(ms): %.1f\n", getElapsedMilliSeconds(start, end));
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,104 @@
+#include "GRT.h"
+#include "Util/DistanceKernels.h"
+
+using namespace GRT;
+
+//Checks the vectorized DistanceKernels against the scalar distances for every number of dimensions and rows up to a few SIMD widths, so
+//every tail of the dimension and row loops is run, with rows that are padded (rowStride > numDimensions) and with input and row pointers
+//that are not aligned to the SIMD width.  The double kernels must match the scalar distances bit for bit, the float kernels add the
+//partial sums in a different order so they are compared against a double precision loop with a tolerance
+const UINT maxDimensions = 37;
+const UINT maxRows = 19;
+const UINT maxStridePadding = 3;
+
+static Random randomGenerator(42);
+
+static bool checkDoubleKernels(const UINT numDimensions, const UINT numRows, const UINT rowStride, const UINT offset) {
+
+  //The offset moves the data off the 16 and 32 byte boundaries of the buffers
+  vector< double > xBuffer( numDimensions+offset+1 ), rowBuffer( numRows*rowStride+offset+1 );
+  double *x = &xBuffer[offset];
+  double *rows = &rowBuffer[offset];
+  for(UINT j=0; j<numDimensions; j++) x[j] = randomGenerator.getRandomNumberGauss(0, 1);
+  for(UINT i=0; i<numRows*rowStride; i++) rows[i] = randomGenerator.getRandomNumberGauss(0, 1);
+
+  vector< double > distances( numRows );
+  bool ok = true;
+
+  DistanceKernels::squaredEuclidean( x, rows, numRows, rowStride, numDimensions, &distances[0] );
+  for(UINT i=0; i<numRows; i++) ok = distances[i] == DistanceKernels::squaredEuclidean( x, rows+i*rowStride, numDimensions ) && ok;
+
+  DistanceKernels::manhattan( x, rows, numRows, rowStride, numDimensions, &distances[0] );
+  for(UINT i=0; i<numRows; i++) ok = distances[i] == DistanceKernels::manhattan( x, rows+i*rowStride, numDimensions ) && ok;
+
+  DistanceKernels::cosine( x, rows, numRows, rowStride, numDimensions, &distances[0] );
+  for(UINT i=0; i<numRows; i++) ok = distances[i] == DistanceKernels::cosine( x, rows+i*rowStride, numDimensions ) && ok;
+
+  //The scalar distances must also match a plain loop, which is what the modules used before the kernels
+  for(UINT i=0; i<numRows; i++){
+    const double *row = rows + i*rowStride;
+    double dist = 0;
+    for(UINT j=0; j<numDimensions; j++) dist += (x[j]-row[j]) * (x[j]-row[j]);
+    ok = dist == DistanceKernels::squaredEuclidean( x, row, numDimensions ) && ok;
+  }
+
+  return ok;
+}
+
+static bool isClose(const double a, const double b, const double scale) {
+  return fabs( a - b ) <= 1.0e-5 * (scale > 1 ? scale : 1);
+}
+
+static bool checkFloatKernels(const UINT numDimensions, const UINT numRows, const UINT rowStride, const UINT offset) {
+
+  vector< float > xBuffer( numDimensions+offset+1 ), rowBuffer( numRows*rowStride+offset+1 );
+  float *x = &xBuffer[offset];
+  float *rows = &rowBuffer[offset];
+  for(UINT j=0; j<numDimensions; j++) x[j] = float( randomGenerator.getRandomNumberGauss(0, 1) );
+  for(UINT i=0; i<numRows*rowStride; i++) rows[i] = float( randomGenerator.getRandomNumberGauss(0, 1) );
+
+  vector< float > euclidean( numRows ), manhattan( numRows ), cosine( numRows );
+  DistanceKernels::squaredEuclidean( x, rows, numRows, rowStride, numDimensions, &euclidean[0] );
+  DistanceKernels::manhattan( x, rows, numRows, rowStride, numDimensions, &manhattan[0] );
+  DistanceKernels::cosine( x, rows, numRows, rowStride, numDimensions, &cosine[0] );
+
+  bool ok = true;
+  for(UINT i=0; i<numRows; i++){
+    const float *row = rows + i*rowStride;
+    double e = 0, m = 0, dot = 0, magX = 0, magRow = 0;
+    for(UINT j=0; j<numDimensions; j++){
+      e += (double(x[j])-row[j]) * (double(x[j])-row[j]);
+      m += fabs( double(x[j])-row[j] );
+      dot += double(x[j]) * row[j];
+      magX += double(x[j]) * x[j];
+      magRow += double(row[j]) * row[j];
+    }
+    ok = isClose( euclidean[i], e, e ) && ok;
+    ok = isClose( manhattan[i], m, m ) && ok;
+    ok = isClose( cosine[i], dot / (sqrt(magX) * sqrt(magRow)), 1 ) && ok;
+  }
+
+  return ok;
+}
+
+int main(int argc, const char * argv[]) {
+
+  printf("InstructionSet: %s\tFloatInstructionSet: %s\n", DistanceKernels::getInstructionSet().c_str(), DistanceKernels::getFloatInstructionSet().c_str());
+
+  UINT numChecks = 0, numDoubleFailures = 0, numFloatFailures = 0;
+  for(UINT numDimensions=1; numDimensions<=maxDimensions; numDimensions++){
+    for(UINT numRows=1; numRows<=maxRows; numRows++){
+      for(UINT padding=0; padding<=maxStridePadding; padding++){
+        for(UINT offset=0; offset<2; offset++){
+          if( !checkDoubleKernels( numDimensions, numRows, numDimensions+padding, offset ) ) numDoubleFailures++;
+          if( !checkFloatKernels( numDimensions, numRows, numDimensions+padding, offset ) ) numFloatFailures++;
+          numChecks++;
+        }
+      }
+    }
+  }
+
+  printf("Checks: %u\tDoubleFailures: %u\tFloatFailures: %u\n", numChecks, numDoubleFailures, numFloatFailures);
+
+  return numDoubleFailures == 0 && numFloatFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,89 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Times DTW predictions with and without the deprecated fast prediction flag as the number of templates and the template length grow.  Both
+//models run the same banded search, so the flag must not change the predicted labels or any of the class distances
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static MatrixDouble createTimeSeries(Random &random, const UINT classLabel, const UINT length, const UINT numDimensions) {
+  MatrixDouble timeSeries(length, numDimensions);
+  const double phase = random.getRandomNumberUniform(0, 0.5);
+  for(UINT i=0; i<length; i++){
+    for(UINT j=0; j<numDimensions; j++){
+      timeSeries[i][j] = sin( (i * 6.0 / length) * (1 + classLabel * 0.25) + phase + j ) + random.getRandomNumberUniform(-0.2, 0.2);
+    }
+  }
+  return timeSeries;
+}
+
+int main(int argc, const char * argv[]) {
+  const UINT numDimensions = 3;
+  const UINT numQueries = 20;
+  Random random;
+
+  TrainingLog::enableLogging(false);
+
+  printf("NumTemplates\tLength\t\tExact(us)\tFast(us)\tSpeedUp\t\tMismatches\n");
+
+  UINT totalMismatches = 0;
+
+  for(UINT length=32; length<=256; length*=2){
+    for(UINT numTemplates=4; numTemplates<=64; numTemplates*=4){
+      //Use one example per class, so each example becomes a template
+      LabelledTimeSeriesClassificationData trainingData(numDimensions);
+      for(UINT k=0; k<numTemplates; k++){
+        trainingData.addSample(k+1, createTimeSeries(random, k, length, numDimensions));
+      }
+
+      DTW exactDTW;
+      DTW fastDTW;
+      fastDTW.enableFastPrediction(true);
+      if (!exactDTW.train(trainingData) || !fastDTW.train(trainingData)) {
+        cout << "ERROR: Failed to train the DTW models!\n";
+        return EXIT_FAILURE;
+      }
+
+      vector< MatrixDouble > queries(numQueries);
+      for(UINT i=0; i<numQueries; i++){
+        queries[i] = createTimeSeries(random, i % numTemplates, length, numDimensions);
+      }
+
+      struct timespec start, end;
+      vector< UINT > exactLabels(numQueries);
+      vector< VectorDouble > exactDistances(numQueries);
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      for(UINT i=0; i<numQueries; i++){
+        if (!exactDTW.predict(queries[i])) {
+          cout << "ERROR: Failed to run the DTW prediction!\n";
+          return EXIT_FAILURE;
+        }
+        exactLabels[i] = exactDTW.getPredictedClassLabel();
+        exactDistances[i] = exactDTW.getClassDistances();
+      }
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double exactTime = getElapsedMicroSeconds(start, end) / numQueries;
+
+      UINT mismatches = 0;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      for(UINT i=0; i<numQueries; i++){
+        if (!fastDTW.predict(queries[i])) {
+          cout << "ERROR: Failed to run the DTW prediction!\n";
+          return EXIT_FAILURE;
+        }
+        if (fastDTW.getPredictedClassLabel() != exactLabels[i] || fastDTW.getClassDistances() != exactDistances[i]) mismatches++;
+      }
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double fastTime = getElapsedMicroSeconds(start, end) / numQueries;
+
+      printf("%u\t\t%u\t\t%.1f\t\t%.1f\t\t%.1fx\t\t%u\n", numTemplates, length, exactTime, fastTime, exactTime / fastTime, mismatches);
+      totalMismatches += mismatches;
+    }
+  }
+
+  return totalMismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
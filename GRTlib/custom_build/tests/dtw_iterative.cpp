@@ -0,0 +1,245 @@
+#include "GRT.h"
+
+#include <pthread.h>
+#include <time.h>
+
+using namespace GRT;
+
+//Checks the iterative DTW search against the original recursive search, which is copied below.  For each warping constraint the class
+//distances, distance matrices and warping paths of a prediction must be bit identical to the recursive search.  Also times both searches
+//as the length of the time series grows, and runs a long prediction on a thread with a small stack
+const UINT numDimensions = 3;
+
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static MatrixDouble createTimeSeries(Random &random, const UINT classLabel, const UINT length) {
+  MatrixDouble timeSeries(length, numDimensions);
+  const double phase = random.getRandomNumberUniform(0, 0.5);
+  for(UINT i=0; i<length; i++){
+    for(UINT j=0; j<numDimensions; j++){
+      timeSeries[i][j] = sin( (i * 6.0 / length) * (1 + classLabel * 0.25) + phase + j ) + random.getRandomNumberUniform(-0.2, 0.2);
+    }
+  }
+  return timeSeries;
+}
+
+//The original recursive search, using the Euclidean distance
+struct RecursiveDTW{
+  bool constrainWarpingPath;
+  double radius;
+
+  double d(int m,int n,MatrixDouble &distanceMatrix,const int M,const int N){
+    double dist = 0;
+    if( isnan( distanceMatrix[m][n] ) ) return NAN;
+    if( constrainWarpingPath ){
+      double r = ceil( min(M,N)*radius );
+      if( fabs( n-((N-1)/((M-1)/double(m))) ) > r ){
+        if( n-((N-1)/((M-1)/double(m))) > 0 ){
+          for(int i=0; i<m; i++) for(int j=n; j<N; j++) distanceMatrix[i][j] = NAN;
+        }else{
+          for(int i=m; i<M; i++) for(int j=0; j<n; j++) distanceMatrix[i][j] = NAN;
+        }
+        return NAN;
+      }
+    }
+    if( distanceMatrix[m][n] < 0 ) return fabs( distanceMatrix[m][n] );
+    if( m == 0 && n == 0 ){
+      dist = distanceMatrix[0][0];
+      distanceMatrix[0][0] = -distanceMatrix[0][0];
+      return dist;
+    }
+    if( m == 0 ){
+      dist = distanceMatrix[m][n] + d(m,n-1,distanceMatrix,M,N);
+      distanceMatrix[m][n] = -dist;
+      return dist;
+    }
+    if( n == 0 ){
+      dist = distanceMatrix[m][n] + d(m-1,n,distanceMatrix,M,N);
+      distanceMatrix[m][n] = -dist;
+      return dist;
+    }
+    double contribDist1 = d(m-1,n-1,distanceMatrix,M,N);
+    double contribDist2 = d(m-1,n,distanceMatrix,M,N);
+    double contribDist3 = d(m,n-1,distanceMatrix,M,N);
+    double minValue = numeric_limits<double>::max();
+    int index = 0;
+    if( contribDist1 < minValue ){ minValue = contribDist1; index = 1; }
+    if( contribDist2 < minValue ){ minValue = contribDist2; index = 2; }
+    if( contribDist3 < minValue ){ minValue = contribDist3; index = 3; }
+    if( index != 0 ) dist = distanceMatrix[m][n] + minValue;
+    distanceMatrix[m][n] = -dist;
+    return dist;
+  }
+
+  double computeDistance(const MatrixDouble &timeSeriesA,const MatrixDouble &timeSeriesB,MatrixDouble &distanceMatrix,vector< IndexDist > &warpPath){
+    const int M = timeSeriesA.getNumRows();
+    const int N = timeSeriesB.getNumRows();
+    const int C = timeSeriesA.getNumCols();
+    int i,j,index = 0;
+    warpPath.clear();
+    distanceMatrix.resize(M, N);
+    for(i=0; i<M; i++){
+      DistanceKernels::squaredEuclidean( timeSeriesA[i], timeSeriesB.getData(), N, timeSeriesB.getStride(), C, distanceMatrix[i] );
+      for(j=0; j<N; j++) distanceMatrix[i][j] = sqrt( distanceMatrix[i][j] );
+    }
+    double distance = sqrt( d(M-1,N-1,distanceMatrix,M,N) );
+    if( isinf(distance) || isnan(distance) ) return INFINITY;
+    for(i=0; i<M; i++) for(j=0; j<N; j++) distanceMatrix[i][j] = fabs( distanceMatrix[i][j] );
+    i=M-1;
+    j=N-1;
+    double totalDist = distanceMatrix[i][j];
+    warpPath.push_back( IndexDist(i,j,distanceMatrix[i][j]) );
+    double normFactor = 1;
+    while( !(i==0 && j==0) ){
+      if( i==0 ) j--;
+      else if( j==0 ) i--;
+      else{
+        double v = numeric_limits<double>::max();
+        index = 0;
+        if( distanceMatrix[i-1][j] < v ){ v = distanceMatrix[i-1][j]; index = 1; }
+        if( distanceMatrix[i][j-1] < v ){ v = distanceMatrix[i][j-1]; index = 2; }
+        if( distanceMatrix[i-1][j-1] <= v ){ index = 3; }
+        if( index == 1 ) i--;
+        else if( index == 2 ) j--;
+        else if( index == 3 ){ i--; j--; }
+        else return INFINITY;
+      }
+      normFactor++;
+      totalDist += distanceMatrix[i][j];
+      warpPath.push_back( IndexDist(i,j,distanceMatrix[i][j]) );
+    }
+    return totalDist/normFactor;
+  }
+};
+
+//Compares two values bit for bit, so NAN matches NAN
+static bool isSame(const double a, const double b) {
+  return memcmp( &a, &b, sizeof(double) ) == 0 || (isnan(a) && isnan(b));
+}
+
+static bool isSame(const MatrixDouble &a, const MatrixDouble &b) {
+  if( a.getNumRows() != b.getNumRows() || a.getNumCols() != b.getNumCols() ) return false;
+  for(UINT i=0; i<a.getNumRows(); i++) for(UINT j=0; j<a.getNumCols(); j++) if( !isSame( a[i][j], b[i][j] ) ) return false;
+  return true;
+}
+
+static bool isSame(const vector< IndexDist > &a, const vector< IndexDist > &b) {
+  if( a.size() != b.size() ) return false;
+  for(UINT i=0; i<a.size(); i++) if( a[i].x != b[i].x || a[i].y != b[i].y || !isSame( a[i].dist, b[i].dist ) ) return false;
+  return true;
+}
+
+//Runs the queries through DTW and checks the distances, distance matrices and warping paths against the recursive search
+static bool runTest(const string &name, const bool constrain, const double radius, const vector< MatrixDouble > &templates, const vector< MatrixDouble > &queries) {
+
+  LabelledTimeSeriesClassificationData trainingData(numDimensions);
+  for(UINT k=0; k<templates.size(); k++) trainingData.addSample( k+1, templates[k] );
+
+  DTW dtw(false, false, 3.0, DTW::TEMPLATE_THRESHOLDS, constrain, radius);
+  if( !dtw.train( trainingData ) ){
+    printf("ERROR: Failed to train the %s model!\n", name.c_str());
+    return false;
+  }
+
+  RecursiveDTW reference;
+  reference.constrainWarpingPath = constrain;
+  reference.radius = radius;
+
+  UINT mismatches = 0;
+  double iterativeTime = 0;
+  double recursiveTime = 0;
+  MatrixDouble distanceMatrix;
+  vector< IndexDist > warpPath;
+  for(UINT q=0; q<queries.size(); q++){
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    dtw.predict( queries[q] );
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    iterativeTime += getElapsedMicroSeconds(start, end);
+
+    const VectorDouble distances = dtw.getClassDistances();
+    const vector< MatrixDouble > distanceMatrices = dtw.getDistanceMatrices();
+    const vector< vector< IndexDist > > warpPaths = dtw.getWarpingPaths();
+    for(UINT k=0; k<dtw.templatesBuffer.size(); k++){
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      const double distance = reference.computeDistance( dtw.templatesBuffer[k].timeSeries, queries[q], distanceMatrix, warpPath );
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      recursiveTime += getElapsedMicroSeconds(start, end);
+      if( !isSame( distance, distances[k] ) ) mismatches++;
+      else if( !isinf( distance ) && (!isSame( distanceMatrix, distanceMatrices[k] ) || !isSame( warpPath, warpPaths[k] )) ) mismatches++;
+    }
+  }
+
+  printf("%s\t%u\t%u\t%.1f\t\t%.1f\t\t%.1fx\t\t%u\n", name.c_str(), templates[0].getNumRows(), queries[0].getNumRows(),
+         recursiveTime / queries.size(), iterativeTime / queries.size(), recursiveTime / iterativeTime, mismatches);
+
+  return mismatches == 0;
+}
+
+struct LongPrediction{
+  DTW *dtw;
+  const MatrixDouble *query;
+  bool ok;
+};
+
+static void* runLongPrediction(void *data) {
+  LongPrediction *p = (LongPrediction*)data;
+  p->ok = p->dtw->predict( *p->query ) && !isinf( p->dtw->getClassDistances()[0] );
+  return NULL;
+}
+
+int main(int argc, const char * argv[]) {
+
+  TrainingLog::enableLogging( false );
+  WarningLog::enableLogging( false );
+  Random random(42);
+
+  printf("Search\t\tM\tN\tRecursive(us)\tIterative(us)\tSpeedUp\t\tMismatches\n");
+
+  bool ok = true;
+  for(UINT length=64; length<=512; length*=2){
+    vector< MatrixDouble > templates, queries;
+    for(UINT k=0; k<4; k++) templates.push_back( createTimeSeries(random, k, length) );
+    for(UINT q=0; q<8; q++) queries.push_back( createTimeSeries(random, q % 4, length + (q % 3) * length / 8) );
+
+    ok = runTest( "Unconstrained", false, 0.2, templates, queries ) && ok;
+    ok = runTest( "Band(r=0.2)", true, 0.2, templates, queries ) && ok;
+    ok = runTest( "Band(r=0.05)", true, 0.05, templates, queries ) && ok;
+
+    //A band this narrow does not connect the rows when the lengths differ, so the full search is used
+    ok = runTest( "Band(r=0)", true, 0, templates, queries ) && ok;
+
+    //A missing value in the input also needs the full search
+    for(UINT q=0; q<queries.size(); q++) queries[q][ length/2 ][0] = NAN;
+    ok = runTest( "Band+NAN", true, 0.2, templates, queries ) && ok;
+    ok = runTest( "Unconst+NAN", false, 0.2, templates, queries ) && ok;
+  }
+
+  //A long template on a thread with a small stack, the recursive search would need a stack frame for every cell along the longest path
+  const UINT longLength = 4000;
+  LabelledTimeSeriesClassificationData longData(numDimensions);
+  longData.addSample( 1, createTimeSeries(random, 0, longLength) );
+  longData.addSample( 2, createTimeSeries(random, 1, longLength) );
+  const MatrixDouble longQuery = createTimeSeries(random, 0, longLength + 100);
+  for(UINT k=0; k<2; k++){
+    DTW dtw(false, false, 3.0, DTW::TEMPLATE_THRESHOLDS, true, k == 0 ? 0.1 : 0.0);
+    dtw.train( longData );
+    LongPrediction prediction;
+    prediction.dtw = &dtw;
+    prediction.query = &longQuery;
+    prediction.ok = false;
+    pthread_attr_t attr;
+    pthread_attr_init( &attr );
+    pthread_attr_setstacksize( &attr, 128 * 1024 );
+    pthread_t thread;
+    pthread_create( &thread, &attr, runLongPrediction, &prediction );
+    pthread_join( thread, NULL );
+    pthread_attr_destroy( &attr );
+    printf("LongTemplate(%s search, %u frames, 128KB stack): %s\n", k == 0 ? "forward" : "full", longLength, prediction.ok ? "ok" : "FAILED");
+    ok = prediction.ok && ok;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+#include "GRT.h"
+
+using namespace GRT;
+
+//Plants time warped copies of three gestures into a stream of noise and checks the streaming (SPRING) DTW search reports each gesture once,
+//with the right class label and with the first and last samples of the match within a few samples of where the gesture was planted.  The
+//distance of a match is the average of the accumulated costs along the warping path, which favours slightly shorter paths, so the end of a
+//slower gesture can be trimmed by a few samples
+const UINT numDimensions = 2;
+const UINT numClasses = 3;
+const UINT templateLength = 40;
+const UINT numPlantedGestures = 30;
+const UINT maxBoundaryError = 5;
+const double noise = 0.02;
+
+//The gestures are a horizontal stroke, a vertical stroke and a circle, none of them contains a copy of another
+static MatrixDouble createGesture(Random &random, const UINT classLabel, const UINT length, const double noise) {
+  MatrixDouble gesture(length, numDimensions);
+  for(UINT i=0; i<length; i++){
+    const double x = i / double(length-1);
+    switch( classLabel ){
+      case 1:
+        gesture[i][0] = 2*x - 1;
+        gesture[i][1] = 0;
+        break;
+      case 2:
+        gesture[i][0] = 0;
+        gesture[i][1] = 2*x - 1;
+        break;
+      default:
+        gesture[i][0] = sin( 2 * PI * x );
+        gesture[i][1] = cos( 2 * PI * x );
+        break;
+    }
+    for(UINT j=0; j<numDimensions; j++) gesture[i][j] += random.getRandomNumberGauss(0, noise);
+  }
+  return gesture;
+}
+
+//The gap between the gestures is well away from the range of the gestures, so nothing in the gap can match
+static void addGap(Random &random, MatrixDouble &stream, const UINT length) {
+  for(UINT i=0; i<length; i++){
+    VectorDouble sample(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) sample[j] = 4 + random.getRandomNumberGauss(0, 0.1);
+    stream.push_back( sample );
+  }
+}
+
+struct Gesture{
+  UINT classLabel;
+  UINT start;
+  UINT end;
+};
+
+static UINT getDifference(const UINT a, const UINT b) {
+  return a > b ? a - b : b - a;
+}
+
+int main(int argc, const char * argv[]) {
+
+  TrainingLog::enableLogging( false );
+  WarningLog::enableLogging( false );
+  Random random(42);
+
+  //Train one template per class, from a few examples of each gesture played back between 75% and 125% of the template length
+  LabelledTimeSeriesClassificationData trainingData(numDimensions);
+  for(UINT k=1; k<=numClasses; k++){
+    for(UINT n=0; n<5; n++){
+      trainingData.addSample( k, createGesture( random, k, templateLength - 10 + 5*n, noise ) );
+    }
+  }
+
+  DTW dtw(false, true, 3.0);
+  if( !dtw.train( trainingData ) ){
+    printf("ERROR: Failed to train the DTW model!\n");
+    return EXIT_FAILURE;
+  }
+  dtw.enableStreamingPrediction( true );
+
+  //Build the stream, each gesture is played back between 85% and 115% of the template length
+  MatrixDouble stream;
+  vector< Gesture > planted;
+  addGap( random, stream, 25 );
+  for(UINT n=0; n<numPlantedGestures; n++){
+    Gesture gesture;
+    gesture.classLabel = random.getRandomNumberInt(1, numClasses+1);
+    const UINT length = random.getRandomNumberInt(templateLength - 6, templateLength + 7);
+    const MatrixDouble samples = createGesture( random, gesture.classLabel, length, noise );
+    gesture.start = stream.getNumRows();
+    for(UINT i=0; i<length; i++) stream.push_back( samples.getRowVector(i) );
+    gesture.end = stream.getNumRows()-1;
+    planted.push_back( gesture );
+    addGap( random, stream, random.getRandomNumberInt(10, 40) );
+  }
+
+  //Stream the samples one at a time, each match is reported on the sample where it is known to be the best match
+  vector< Gesture > detected;
+  for(UINT t=0; t<stream.getNumRows(); t++){
+    if( !dtw.predict( stream.getRowVector(t) ) ){
+      printf("ERROR: Failed to predict sample %u!\n", t);
+      return EXIT_FAILURE;
+    }
+    if( dtw.getPredictedClassLabel() != GRT_DEFAULT_NULL_CLASS_LABEL ){
+      Gesture gesture;
+      gesture.classLabel = dtw.getPredictedClassLabel();
+      gesture.start = dtw.getMatchStartIndex();
+      gesture.end = dtw.getMatchEndIndex();
+      detected.push_back( gesture );
+    }
+  }
+
+  printf("Planted\tLabel\tStart\tEnd\tDetectedLabel\tStart\tEnd\n");
+  UINT numCorrect = 0;
+  UINT d = 0;
+  for(UINT n=0; n<planted.size(); n++){
+    const Gesture &p = planted[n];
+
+    //Any detection that ends before this gesture starts is a false detection, these are counted below
+    while( d < detected.size() && detected[d].end < p.start ) d++;
+
+    bool correct = false;
+    if( d < detected.size() && detected[d].start <= p.end ){
+      const Gesture &q = detected[d];
+      correct = q.classLabel == p.classLabel && getDifference( q.start, p.start ) <= maxBoundaryError && getDifference( q.end, p.end ) <= maxBoundaryError;
+      printf("%u\t%u\t%u\t%u\t%u\t\t%u\t%u\t%s\n", n, p.classLabel, p.start, p.end, q.classLabel, q.start, q.end, correct ? "ok" : "FAILED");
+      d++;
+    }else printf("%u\t%u\t%u\t%u\t-\t\t-\t-\tMISSED\n", n, p.classLabel, p.start, p.end);
+    if( correct ) numCorrect++;
+  }
+
+  const UINT numFalseDetections = (UINT)detected.size() - numCorrect;
+  printf("Planted: %u\tCorrect: %u\tDetections: %u\tFalseDetections: %u\n", numPlantedGestures, numCorrect, (UINT)detected.size(), numFalseDetections);
+
+  return numCorrect == numPlantedGestures && numFalseDetections == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,63 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Times DTW training on a dataset with 500 examples per class, as the number of training threads grows
+static double getElapsedMilliSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e3 + (end.tv_nsec - start.tv_nsec) / 1.0e6;
+}
+
+int main(int argc, const char * argv[]) {
+  const UINT numDimensions = 3;
+  const UINT numClasses = 3;
+  const UINT numExamplesPerClass = 500;
+  const UINT maxThreads = 8;
+  Random random;
+
+  TrainingLog::enableLogging(false);
+
+  //Each example is a noisy sine wave with a random length, so the examples of each class are warped versions of each other
+  LabelledTimeSeriesClassificationData trainingData(numDimensions);
+  for(UINT k=0; k<numClasses; k++){
+    for(UINT n=0; n<numExamplesPerClass; n++){
+      const UINT length = random.getRandomNumberInt(25, 40);
+      MatrixDouble timeSeries(length, numDimensions);
+      for(UINT i=0; i<length; i++){
+        for(UINT j=0; j<numDimensions; j++){
+          timeSeries[i][j] = sin( (i * 6.0 / length) * (1 + k) + j ) + random.getRandomNumberUniform(-0.2, 0.2);
+        }
+      }
+      trainingData.addSample(k+1, timeSeries);
+    }
+  }
+
+  printf("NumThreads\tTrainTime(ms)\tMismatches\n");
+
+  vector< DTWTemplate > serialModels;
+  for(UINT numThreads=1; numThreads<=maxThreads; numThreads*=2){
+    DTW dtw;
+    dtw.setNumThreads(numThreads);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (!dtw.train(trainingData)) {
+      cout << "ERROR: Failed to train the DTW model!\n";
+      return EXIT_FAILURE;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    //The templates and thresholds should not depend on the number of threads
+    vector< DTWTemplate > models = dtw.getModels();
+    if (numThreads == 1) serialModels = models;
+    UINT mismatches = 0;
+    for(UINT k=0; k<models.size(); k++){
+      if (models[k].trainingMu != serialModels[k].trainingMu || models[k].trainingSigma != serialModels[k].trainingSigma) mismatches++;
+    }
+
+    printf("%u\t\t%.1f\t\t%u\n", numThreads, getElapsedMilliSeconds(start, end), mismatches);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Runs a classifier parameter sweep over a pipeline with an FFT + TimeDomainFeatures front end, with and without a FeatureCache.  Checks
+//the cached sweep gives exactly the same cross validation accuracies, and the same predictions after training, as a sweep where every
+//training call starts with an empty cache, and prints the time of each sweep.  The sweeps are run on a continuous stream (LabelledClassificationData,
+//cached as a whole) and on a set of gestures (LabelledTimeSeriesClassificationData, cached per gesture), and again with a cache that is too
+//small for the features so the entries are spilled to disk.  The stream is classified with ANBC and the gestures with DTW
+const UINT numDimensions = 3;
+const UINT numClasses = 4;
+const UINT kFoldValue = 5;
+const UINT fftWindowSize = 32;
+const double nullRejectionCoeffs[] = {1.0, 2.0, 3.0, 4.0};
+const UINT numSweepPoints = sizeof(nullRejectionCoeffs) / sizeof(double);
+
+static double getElapsedMilliSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e3 + (end.tv_nsec - start.tv_nsec) / 1.0e6;
+}
+
+static VectorDouble createSample(Random &random, const UINT classLabel, const UINT t) {
+  VectorDouble sample(numDimensions);
+  for(UINT j=0; j<numDimensions; j++) sample[j] = sin( t * 0.05 * (classLabel + j + 1) ) + random.getRandomNumberGauss(0, 0.3);
+  return sample;
+}
+
+static void setupPipeline(GestureRecognitionPipeline &pipeline, const Classifier &classifier, FeatureCache *featureCache) {
+  FFT fft(fftWindowSize, 1, numDimensions, FFT::HAMMING_WINDOW, true, false);
+  pipeline.addFeatureExtractionModule( fft );
+  pipeline.addFeatureExtractionModule( TimeDomainFeatures(8, 1, fft.getNumOutputDimensions(), false, true, true, false, false) );
+  pipeline.setClassifier( classifier );
+  pipeline.setFeatureCache( featureCache );
+}
+
+struct SweepResult{
+  vector< double > accuracies;
+  vector< UINT > labels;
+  vector< double > likelihoods;
+  double time;
+  double trainingTime;
+};
+
+//Runs the sweep, a k-fold cross validation for each setting and then a training call on all the data followed by predictions on the inputs.
+//The time of the whole sweep and the time of the training calls on all the data are recorded.  If freshCache is true then a new cache is used for every training call, so nothing is reused between settings but the same folds are used (the gestures are cached per gesture, so the folds of one cross validation still share their features)
+template< class T >
+static SweepResult runSweep(const Classifier &classifier, const T &trainingData, const vector< VectorDouble > &inputs, FeatureCache *featureCache, const bool freshCache) {
+  SweepResult result;
+  result.trainingTime = 0;
+  struct timespec start, end, trainStart, trainEnd;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT i=0; i<numSweepPoints; i++){
+    FeatureCache fresh;
+    GestureRecognitionPipeline pipeline;
+    setupPipeline( pipeline, classifier, freshCache ? &fresh : featureCache );
+    pipeline.getClassifier()->setNullRejectionCoeff( nullRejectionCoeffs[i] );
+    pipeline.getClassifier()->enableNullRejection( true );
+    if( !pipeline.train( trainingData, kFoldValue ) ){
+      printf("ERROR: Failed to run the cross validation!\n");
+      result.accuracies.push_back( -1 );
+      continue;
+    }
+    result.accuracies.push_back( pipeline.getCrossValidationAccuracy() );
+
+    FeatureCache freshTrain;
+    if( freshCache ) pipeline.setFeatureCache( &freshTrain );
+    clock_gettime(CLOCK_MONOTONIC, &trainStart);
+    const bool trained = pipeline.train( trainingData );
+    clock_gettime(CLOCK_MONOTONIC, &trainEnd);
+    result.trainingTime += getElapsedMilliSeconds(trainStart, trainEnd);
+    if( !trained ){
+      printf("ERROR: Failed to train the pipeline!\n");
+      continue;
+    }
+    //Predict straight after training, without a reset, so the state the modules were left in by the training call is used
+    for(UINT n=0; n<inputs.size(); n++){
+      pipeline.predict( inputs[n] );
+      result.labels.push_back( pipeline.getPredictedClassLabel() );
+      result.likelihoods.push_back( pipeline.getMaximumLikelihood() );
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  result.time = getElapsedMilliSeconds(start, end);
+  return result;
+}
+
+template< class T >
+static bool runTest(const string &name, const Classifier &classifier, const T &trainingData, const vector< VectorDouble > &inputs, const unsigned long long maxMemorySize, const bool spill) {
+
+  const SweepResult missed = runSweep( classifier, trainingData, inputs, NULL, true );
+
+  FeatureCache featureCache( maxMemorySize, "." );
+  const SweepResult cached = runSweep( classifier, trainingData, inputs, &featureCache, false );
+
+  //Without a cache the folds are drawn from the system time, so this is only used for the time
+  const SweepResult uncached = runSweep( classifier, trainingData, inputs, NULL, false );
+
+  const bool match = missed.accuracies == cached.accuracies && missed.labels == cached.labels && missed.likelihoods == cached.likelihoods;
+  printf("%s\tMatch: %s\tNoCache(ms): %.1f\tMissed(ms): %.1f\tCached(ms): %.1f\tSpeedUp: %.2fx\tTrainNoCache(ms): %.1f\tTrainCached(ms): %.1f\tTrainSpeedUp: %.2fx\tHits: %llu\tMisses: %llu\tEntries: %u\tSpilled: %u\tMemory(KB): %.0f\n",
+         name.c_str(), match ? "yes" : "NO", uncached.time, missed.time, cached.time, uncached.time / cached.time,
+         uncached.trainingTime, cached.trainingTime, uncached.trainingTime / cached.trainingTime,
+         featureCache.getNumHits(), featureCache.getNumMisses(), featureCache.getNumEntries(), featureCache.getNumSpilledEntries(), featureCache.getMemorySize() / 1024.0);
+
+  return match && featureCache.getNumHits() > 0 && (!spill || featureCache.getNumSpilledEntries() > 0);
+}
+
+int main(int argc, const char * argv[]) {
+
+  TrainingLog::enableLogging( false );
+  WarningLog::enableLogging( false );
+  Random random(42);
+
+  //A continuous stream, where the class changes every 200 samples
+  LabelledClassificationData streamData(numDimensions);
+  for(UINT t=0; t<4000; t++){
+    const UINT classLabel = (t / 200) % numClasses + 1;
+    streamData.addSample( classLabel, createSample(random, classLabel, t) );
+  }
+
+  //A set of gestures
+  LabelledTimeSeriesClassificationData gestureData(numDimensions);
+  for(UINT i=0; i<numClasses*10; i++){
+    const UINT classLabel = i % numClasses + 1;
+    MatrixDouble gesture;
+    for(UINT t=0; t<fftWindowSize+40; t++) gesture.push_back( createSample(random, classLabel, t) );
+    gestureData.addSample( classLabel, gesture );
+  }
+
+  vector< VectorDouble > inputs;
+  for(UINT t=0; t<500; t++) inputs.push_back( createSample(random, (t / 100) % numClasses + 1, t) );
+
+  //DTW searches its whole buffer for each prediction, so it only predicts the first few inputs
+  const vector< VectorDouble > gestureInputs( inputs.begin(), inputs.begin() + 40 );
+
+  bool ok = true;
+  ok = runTest( "Stream", ANBC(), streamData, inputs, GRT_FEATURE_CACHE_DEFAULT_MAX_MEMORY_SIZE, false ) && ok;
+  ok = runTest( "Gestures", DTW(), gestureData, gestureInputs, GRT_FEATURE_CACHE_DEFAULT_MAX_MEMORY_SIZE, false ) && ok;
+
+  //Caches that only hold a small part of the features in memory, the rest are spilled to disk
+  ok = runTest( "Stream(spill)", ANBC(), streamData, inputs, 1024 * 1024, true ) && ok;
+  ok = runTest( "Gestures(spill)", DTW(), gestureData, gestureInputs, 64 * 1024, true ) && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,187 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Runs chains of 3 to 6 linear filters over a multichannel stream, both as the individual modules and fused into a single FusedLinearFilter,
+//and reports the cost per sample of the filters on their own and of the whole pipeline prediction, and the largest difference between the
+//outputs once the moving average startup transient has passed
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static void buildChain(GestureRecognitionPipeline &pipeline, const UINT numFilters, const UINT numDimensions) {
+  pipeline.addPreProcessingModule( LowPassFilter(0.2, 1, numDimensions) );
+  pipeline.addPreProcessingModule( HighPassFilter(0.95, 1, numDimensions) );
+  pipeline.addPreProcessingModule( MovingAverageFilter(5, numDimensions) );
+  if( numFilters > 3 ) pipeline.addPreProcessingModule( FIRFilter(FIRFilter::LPF, 20, 100, 10, 1, numDimensions) );
+  if( numFilters > 4 ) pipeline.addPreProcessingModule( DoubleMovingAverageFilter(4, numDimensions) );
+  if( numFilters > 5 ) pipeline.addPreProcessingModule( LowPassFilter(0.5, 1, numDimensions) );
+}
+
+int main(int argc, const char * argv[]) {
+  const UINT numDimensions = 16;
+  const UINT numSamples = 20000;
+  const UINT numWarmupSamples = 100;
+  Random random(42);
+
+  MatrixDouble data(numSamples, numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    for(UINT j=0; j<numDimensions; j++) data[i][j] = sin( 0.01 * i * (j+1) ) + random.getRandomNumberGauss(0, 0.2);
+  }
+
+  //A small classifier so the pipeline can predict, the filters are the part being measured
+  LabelledClassificationData trainingData(numDimensions);
+  for(UINT i=0; i<200; i++){
+    VectorDouble sample(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) sample[j] = random.getRandomNumberGauss( i % 2 == 0 ? -0.1 : 0.1, 0.05 );
+    trainingData.addSample( (i % 2) + 1, sample );
+  }
+
+  printf("Filters\tOrder\tChain(us)\tFused(us)\tSpeedup\tPipeline(us)\tFusedPipeline(us)\tMaxDiff\t\tLabels\tBatchMaxDiff\n");
+
+  for(UINT numFilters=3; numFilters<=6; numFilters++){
+    GestureRecognitionPipeline pipeline;
+    buildChain(pipeline, numFilters, numDimensions);
+    pipeline.setClassifier( MinDist() );
+    if( !pipeline.train( trainingData ) ){
+      printf("ERROR: Failed to train the pipeline!\n");
+      return EXIT_FAILURE;
+    }
+
+    //Check the fused filter has the same transfer function as the chain of modules
+    FusedLinearFilter fusedFilter;
+    for(UINT i=0; i<pipeline.getNumPreProcessingModules(); i++){
+      if( !fusedFilter.fuse( *pipeline.getPreProcessingModule(i) ) ){
+        printf("ERROR: Failed to fuse module %u!\n", i);
+        return EXIT_FAILURE;
+      }
+    }
+
+    //Time the filters on their own, the chain of modules against the fused filter
+    GestureRecognitionPipeline chainPipeline( pipeline );
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT i=0; i<numSamples; i++){
+      VectorDouble x = data.getRowVector(i);
+      const VectorDouble *y = &x;
+      for(UINT k=0; k<chainPipeline.getNumPreProcessingModules(); k++){
+        PreProcessing *module = chainPipeline.getPreProcessingModule(k);
+        if( !module->process( *y ) ) return EXIT_FAILURE;
+        y = &module->getProcessedData();
+      }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double chainTime = getElapsedMicroSeconds(start, end);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT i=0; i<numSamples; i++){
+      if( !fusedFilter.process( data.getRowVector(i) ) ) return EXIT_FAILURE;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double fusedFilterTime = getElapsedMicroSeconds(start, end);
+
+    GestureRecognitionPipeline fusedPipeline( pipeline );
+    fusedPipeline.setUseFilterFusion( true );
+    pipeline.reset();
+    fusedPipeline.reset();
+
+    MatrixDouble unfusedOutput(numSamples, numDimensions);
+    vector< UINT > labels(numSamples);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT i=0; i<numSamples; i++){
+      if( !pipeline.predict( data.getRowVector(i) ) ) return EXIT_FAILURE;
+      labels[i] = pipeline.getPredictedClassLabel();
+      VectorDouble y = pipeline.getPreProcessedData();
+      for(UINT j=0; j<numDimensions; j++) unfusedOutput[i][j] = y[j];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double unfusedTime = getElapsedMicroSeconds(start, end);
+
+    double maxDiff = 0;
+    UINT agree = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT i=0; i<numSamples; i++){
+      if( !fusedPipeline.predict( data.getRowVector(i) ) ) return EXIT_FAILURE;
+      if( i < numWarmupSamples ) continue;
+      if( fusedPipeline.getPredictedClassLabel() == labels[i] ) agree++;
+      VectorDouble y = fusedPipeline.getPreProcessedData();
+      for(UINT j=0; j<numDimensions; j++) maxDiff = std::max( maxDiff, fabs(y[j]-unfusedOutput[i][j]) );
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double fusedTime = getElapsedMicroSeconds(start, end);
+
+    //The batch path should match the sample by sample path exactly
+    double batchMaxDiff = 0;
+    MatrixDouble batchOutput;
+    fusedFilter.reset();
+    if( !fusedFilter.processBatch( data, batchOutput ) ) return EXIT_FAILURE;
+    for(UINT i=numWarmupSamples; i<numSamples; i++){
+      for(UINT j=0; j<numDimensions; j++) batchMaxDiff = std::max( batchMaxDiff, fabs(batchOutput[i][j]-unfusedOutput[i][j]) );
+    }
+
+    printf("%u\t%u\t%.3f\t\t%.3f\t\t%.2f\t%.3f\t\t%.3f\t\t\t%.2e\t%.2f%%\t%.2e\n", numFilters, fusedFilter.getOrder(), chainTime/numSamples, fusedFilterTime/numSamples,
+           chainTime/fusedFilterTime, unfusedTime/numSamples, fusedTime/numSamples, maxDiff, 100.0*agree/(numSamples-numWarmupSamples), batchMaxDiff);
+  }
+
+  //Check the fused filter can be saved and loaded
+  GestureRecognitionPipeline pipeline;
+  buildChain(pipeline, 6, numDimensions);
+  FusedLinearFilter fusedFilter;
+  for(UINT i=0; i<pipeline.getNumPreProcessingModules(); i++) fusedFilter.fuse( *pipeline.getPreProcessingModule(i) );
+  FusedLinearFilter loadedFilter;
+  if( !fusedFilter.saveSettingsToFile("FusedLinearFilterSettings.txt") || !loadedFilter.loadSettingsFromFile("FusedLinearFilterSettings.txt") ){
+    printf("ERROR: Failed to save and load the fused filter!\n");
+    return EXIT_FAILURE;
+  }
+  double loadMaxDiff = 0;
+  for(UINT i=0; i<numSamples; i++){
+    VectorDouble a = fusedFilter.filter( data.getRowVector(i) );
+    VectorDouble b = loadedFilter.filter( data.getRowVector(i) );
+    for(UINT j=0; j<numDimensions; j++) loadMaxDiff = std::max( loadMaxDiff, fabs(a[j]-b[j]) );
+  }
+  printf("\nSave/load max difference: %.2e (%u fused modules)\n", loadMaxDiff, loadedFilter.getNumFusedModules());
+
+  //Reading the settings of a module through the non-const accessor must not restart the fused filters
+  GestureRecognitionPipeline editPipeline;
+  buildChain(editPipeline, 6, numDimensions);
+  editPipeline.setClassifier( MinDist() );
+  if( !editPipeline.train( trainingData ) ) return EXIT_FAILURE;
+  GestureRecognitionPipeline fusedEditPipeline( editPipeline );
+  fusedEditPipeline.setUseFilterFusion( true );
+  GestureRecognitionPipeline fusedReadPipeline( fusedEditPipeline );
+  double readMaxDiff = 0;
+  for(UINT i=0; i<numWarmupSamples*2; i++){
+    if( i == numWarmupSamples && fusedReadPipeline.getPreProcessingModule< LowPassFilter >(0)->getFilterFactor() != 0.2 ) return EXIT_FAILURE;
+    if( !fusedEditPipeline.predict( data.getRowVector(i) ) || !fusedReadPipeline.predict( data.getRowVector(i) ) ) return EXIT_FAILURE;
+    VectorDouble a = fusedEditPipeline.getPreProcessedData();
+    VectorDouble b = fusedReadPipeline.getPreProcessedData();
+    for(UINT j=0; j<numDimensions; j++) readMaxDiff = std::max( readMaxDiff, fabs(a[j]-b[j]) );
+  }
+  printf("Read module max difference: %.2e\n", readMaxDiff);
+
+  //Change the settings of a module through a pointer kept from before the fused filters were built, the fused pipeline must pick up the change
+  LowPassFilter *fusedLowPassFilter = fusedEditPipeline.getPreProcessingModule< LowPassFilter >(0);
+  for(UINT i=0; i<numWarmupSamples; i++){
+    if( !fusedEditPipeline.predict( data.getRowVector(i) ) ) return EXIT_FAILURE;
+  }
+
+  editPipeline.getPreProcessingModule< LowPassFilter >(0)->setFilterFactor( 0.6 );
+  fusedLowPassFilter->setFilterFactor( 0.6 );
+  editPipeline.reset();
+  fusedEditPipeline.reset();
+
+  double editMaxDiff = 0;
+  for(UINT i=0; i<numSamples; i++){
+    if( !editPipeline.predict( data.getRowVector(i) ) || !fusedEditPipeline.predict( data.getRowVector(i) ) ) return EXIT_FAILURE;
+    if( i < numWarmupSamples ) continue;
+    VectorDouble a = editPipeline.getPreProcessedData();
+    VectorDouble b = fusedEditPipeline.getPreProcessedData();
+    for(UINT j=0; j<numDimensions; j++) editMaxDiff = std::max( editMaxDiff, fabs(a[j]-b[j]) );
+  }
+  printf("Edited module max difference: %.2e\n", editMaxDiff);
+
+  return readMaxDiff == 0 && editMaxDiff < 1.0e-6 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,186 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Compares each classifier's double prediction with its float prediction path on the same trained model, reporting how often the
+//predicted labels agree, the largest class likelihood difference and the time taken by each path
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static VectorDouble createSample(Random &random, const UINT classLabel, const UINT numDimensions) {
+  VectorDouble sample(numDimensions);
+  for(UINT j=0; j<numDimensions; j++){
+    sample[j] = 10.0 * sin( classLabel * 0.7 + j ) + random.getRandomNumberGauss(0, 3.0);
+  }
+  return sample;
+}
+
+static void createData(Random &random, const UINT numDimensions, const UINT numClasses, const UINT numSamples, const UINT numQueries, LabelledClassificationData &trainingData, MatrixDouble &queries) {
+  trainingData.clear();
+  trainingData.setNumDimensions(numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    const UINT classLabel = (i % numClasses) + 1;
+    trainingData.addSample(classLabel, createSample(random, classLabel, numDimensions));
+  }
+
+  queries.resize(numQueries, numDimensions);
+  for(UINT i=0; i<numQueries; i++){
+    VectorDouble sample = createSample(random, (i % numClasses) + 1, numDimensions);
+    for(UINT j=0; j<numDimensions; j++) queries[i][j] = sample[j];
+  }
+}
+
+template< class T >
+static bool compare(const char *name, T &model, const MatrixDouble &queries) {
+  T floatModel( model );
+  if( !floatModel.setUseFloatPrediction( true ) ){
+    printf("%s\tERROR: Failed to enable float prediction!\n", name);
+    return false;
+  }
+
+  const UINT M = queries.getNumRows();
+  vector< UINT > labels(M);
+  MatrixDouble likelihoods;
+  struct timespec start, end;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT i=0; i<M; i++){
+    if( !model.predict( queries.getRowVector(i) ) ) return false;
+    labels[i] = model.getPredictedClassLabel();
+    VectorDouble y = model.getClassLikelihoods();
+    if( i == 0 ) likelihoods.resize( M, (UINT)y.size() );
+    for(UINT k=0; k<y.size(); k++) likelihoods[i][k] = y[k];
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double doubleTime = getElapsedMicroSeconds(start, end);
+
+  UINT agree = 0;
+  double maxDiff = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT i=0; i<M; i++){
+    if( !floatModel.predict( queries.getRowVector(i) ) ) return false;
+    if( floatModel.getPredictedClassLabel() == labels[i] ) agree++;
+    VectorDouble y = floatModel.getClassLikelihoods();
+    for(UINT k=0; k<y.size(); k++) maxDiff = std::max( maxDiff, fabs(y[k]-likelihoods[i][k]) );
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double floatTime = getElapsedMicroSeconds(start, end);
+
+  printf("%s\t%.2f%%\t\t%.2e\t%.1f\t\t%.1f\t\t%.2f\n", name, 100.0*agree/M, maxDiff, doubleTime/M, floatTime/M, doubleTime/floatTime);
+  return true;
+}
+
+//The float path must find exactly the same neighbours through the kd-tree index as it does with the linear search
+static bool hasSameFloatNeighbours(const KNN &model, const MatrixDouble &queries) {
+  KNN indexModel( model ), linearModel( model );
+  indexModel.enableSpatialIndex( true );
+  linearModel.enableSpatialIndex( false );
+  if( !indexModel.setUseFloatPrediction( true ) || !linearModel.setUseFloatPrediction( true ) ) return false;
+
+  UINT mismatches = 0;
+  struct timespec start, end;
+  double indexTime = 0, linearTime = 0;
+  for(UINT i=0; i<queries.getNumRows(); i++){
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if( !indexModel.predict( queries.getRowVector(i) ) ) return false;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    indexTime += getElapsedMicroSeconds(start, end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if( !linearModel.predict( queries.getRowVector(i) ) ) return false;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    linearTime += getElapsedMicroSeconds(start, end);
+    if( indexModel.getPredictedClassLabel() != linearModel.getPredictedClassLabel() || indexModel.getClassDistances() != linearModel.getClassDistances() ) mismatches++;
+  }
+
+  const UINT M = queries.getNumRows();
+  printf("\nKNN float index vs linear\tMismatches: %u\tIndex(us): %.1f\tLinear(us): %.1f\n", mismatches, indexTime/M, linearTime/M);
+  return mismatches == 0;
+}
+
+int main(int argc, const char * argv[]) {
+  const UINT numDimensions = 64;
+  const UINT numClasses = 5;
+  const UINT numSamples = 5000;
+  const UINT numQueries = 2000;
+  Random random(42);
+
+  TrainingLog::enableLogging(false);
+
+  LabelledClassificationData trainingData;
+  MatrixDouble queries;
+  createData(random, numDimensions, numClasses, numSamples, numQueries, trainingData, queries);
+
+  //The mixture models can not be fit to 64 dimensional data, so the GMM uses its own 8 dimensional data
+  LabelledClassificationData gmmTrainingData;
+  MatrixDouble gmmQueries;
+  createData(random, 8, numClasses, numSamples, numQueries, gmmTrainingData, gmmQueries);
+
+  printf("Float instruction set: %s\n\n", DistanceKernels::getFloatInstructionSet().c_str());
+  printf("Model\t\tLabels\t\tMaxLikelihoodDiff\tDouble(us)\tFloat(us)\tSpeedup\n");
+
+  KNN knn(10, true);
+  if( !knn.train(trainingData) || !compare("KNN\t", knn, queries) ) return EXIT_FAILURE;
+
+  //The kd-tree index only prunes well in a few dimensions, so the indexed KNN uses the 8 dimensional data
+  KNN indexedKNN(10, true);
+  indexedKNN.enableSpatialIndex(true);
+  if( !indexedKNN.train(gmmTrainingData) || !compare("KNNIndex", indexedKNN, gmmQueries) ) return EXIT_FAILURE;
+
+  MinDist minDist(true, false, 10.0, 10);
+  if( !minDist.train(trainingData) || !compare("MinDist\t", minDist, queries) ) return EXIT_FAILURE;
+
+  ANBC anbc;
+  if( !anbc.train(trainingData) || !compare("ANBC\t", anbc, queries) ) return EXIT_FAILURE;
+
+  GMM gmm(2);
+  if( !gmm.train(gmmTrainingData) || !compare("GMM\t", gmm, gmmQueries) ) return EXIT_FAILURE;
+
+  Softmax softmax(true);
+  if( !softmax.train(trainingData) || !compare("Softmax\t", softmax, queries) ) return EXIT_FAILURE;
+
+  DecisionTree tree;
+  if( !tree.train(trainingData) || !compare("DecisionTree", tree, queries) ) return EXIT_FAILURE;
+
+  RandomForests forest(false, 10, 5, 10);
+  if( !forest.train(trainingData) || !compare("RandomForests", forest, queries) ) return EXIT_FAILURE;
+
+  MLP mlp;
+  mlp.init(numDimensions, 32, numClasses);
+  mlp.setNumRandomTrainingIterations(1);
+  mlp.setMaxNumEpochs(50);
+  mlp.setUseValidationSet(false);
+  if( !mlp.train(trainingData) || !compare("MLP\t", mlp, queries) ) return EXIT_FAILURE;
+
+  //DTW only uses the float templates for the local costs of the banded search
+  const UINT numSeriesDimensions = 16;
+  LabelledTimeSeriesClassificationData timeSeriesData(numSeriesDimensions);
+  for(UINT i=0; i<50; i++){
+    const UINT classLabel = (i % numClasses) + 1;
+    MatrixDouble series(100, numSeriesDimensions);
+    for(UINT t=0; t<series.getNumRows(); t++){
+      for(UINT j=0; j<numSeriesDimensions; j++) series[t][j] = sin( classLabel * 0.05 * t + j ) + random.getRandomNumberGauss(0, 0.1);
+    }
+    timeSeriesData.addSample(classLabel, series);
+  }
+  DTW dtw(false, false, 3.0, DTW::TEMPLATE_THRESHOLDS, true, 0.1);
+  if( !dtw.train(timeSeriesData) ) return EXIT_FAILURE;
+  MatrixDouble streamQueries(numQueries, numSeriesDimensions);
+  for(UINT i=0; i<numQueries; i++){
+    for(UINT j=0; j<numSeriesDimensions; j++) streamQueries[i][j] = sin( ((i/200) % numClasses + 1) * 0.05 * i + j ) + random.getRandomNumberGauss(0, 0.1);
+  }
+  if( !compare("DTW\t", dtw, streamQueries) ) return EXIT_FAILURE;
+
+  //Check the float kd-tree search against the float linear search, with each distance method
+  bool ok = true;
+  for(UINT distanceMethod=KNN::EUCLIDEAN_DISTANCE; distanceMethod<=KNN::MANHATTAN_DISTANCE; distanceMethod++){
+    KNN model(10, true);
+    model.setDistanceMethod(distanceMethod);
+    if( !model.train(gmmTrainingData) ) return EXIT_FAILURE;
+    ok = hasSameFloatNeighbours(model, gmmQueries) && ok;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
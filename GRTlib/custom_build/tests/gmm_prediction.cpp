@@ -0,0 +1,163 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Compares the log domain GMM prediction with the linear likelihoods the GMM used to compute from invSigma and det, checks the
+//diagonal covariance mode and the model files, and times the prediction as the number of dimensions grows
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static VectorDouble createSample(Random &random, const UINT classLabel, const UINT numDimensions) {
+  VectorDouble sample(numDimensions);
+  for(UINT j=0; j<numDimensions; j++){
+    sample[j] = 10.0 * sin( classLabel * 0.7 + j ) + random.getRandomNumberGauss(0, 3.0);
+  }
+  return sample;
+}
+
+//The mixture likelihood as the GMM computed it before the log domain prediction
+static double computeLinearMixtureLikelihood(const MixtureModel &model, const VectorDouble &x) {
+  const UINT N = (UINT)x.size();
+  double sum = 0;
+  double normFactor = 0;
+  for(UINT k=0; k<model.getK(); k++){
+    const GuassModel &gauss = model[k];
+    const double y = (1.0/pow(TWO_PI,N/2.0)) * (1.0/pow(gauss.det,0.5));
+    double q = 0;
+    for(UINT i=0; i<N; i++){
+      double temp = 0;
+      for(UINT j=0; j<N; j++) temp += (x[j]-gauss.mu[j]) * gauss.invSigma[j][i];
+      q += (x[i]-gauss.mu[i]) * temp;
+    }
+    sum += y * exp( -0.5*q );
+    normFactor += y;
+  }
+  return sum / normFactor;
+}
+
+//The mixture models can fail to converge from a bad random start, so retry the training a few times
+static bool train(GMM &gmm, LabelledClassificationData &trainingData) {
+  for(UINT i=0; i<5; i++){
+    if( gmm.train(trainingData) ) return true;
+  }
+  return false;
+}
+
+int main(int argc, const char * argv[]) {
+  const UINT numClasses = 5;
+  const UINT numSamples = 2500;
+  const UINT numQueries = 1000;
+  Random random(42);
+
+  TrainingLog::enableLogging(false);
+  WarningLog::enableLogging(false);
+  ErrorLog::enableLogging(false);
+
+  printf("Dims\tLinear(us)\tCholesky(us)\tDiagonal(us)\tLabels\t\tLinearNaN\tMaxLikelihoodDiff\n");
+
+  const UINT numDimensions[] = {8, 16, 32, 60};
+  for(UINT d=0; d<4; d++){
+    const UINT N = numDimensions[d];
+    LabelledClassificationData trainingData(N);
+    for(UINT i=0; i<numSamples; i++){
+      const UINT classLabel = (i % numClasses) + 1;
+      trainingData.addSample(classLabel, createSample(random, classLabel, N));
+    }
+    //Every tenth query is an outlier far from the training data, which is where the linear likelihoods underflow
+    MatrixDouble queries(numQueries, N);
+    for(UINT i=0; i<numQueries; i++){
+      VectorDouble sample = createSample(random, (i % numClasses) + 1, N);
+      const double gain = i % 10 == 9 ? 5.0 : 1.0;
+      for(UINT j=0; j<N; j++) queries[i][j] = gain * sample[j];
+    }
+
+    GMM gmm(2, true);
+    if( !train(gmm, trainingData) ){
+      printf("%u\tERROR: Failed to train the GMM!\n", N);
+      return EXIT_FAILURE;
+    }
+    GMM diagonal(2, true);
+    diagonal.setUseDiagonalCovariance(true);
+    if( !train(diagonal, trainingData) ){
+      printf("%u\tERROR: Failed to train the diagonal GMM!\n", N);
+      return EXIT_FAILURE;
+    }
+    vector< MixtureModel > models = gmm.getModels();
+    vector< MinMax > ranges = trainingData.getRanges();
+    struct timespec start, end;
+
+    //Run the linear likelihoods the GMM used to compute, counting the queries where every class likelihood underflows
+    vector< UINT > linearLabels(numQueries);
+    MatrixDouble linearLikelihoods(numQueries, numClasses);
+    UINT numLinearNaN = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT i=0; i<numQueries; i++){
+      VectorDouble x = queries.getRowVector(i);
+      for(UINT j=0; j<N; j++){
+        x[j] = (x[j]-ranges[j].minValue) * (GMM_MAX_SCALE_VALUE-GMM_MIN_SCALE_VALUE) / (ranges[j].maxValue-ranges[j].minValue) + GMM_MIN_SCALE_VALUE;
+      }
+      double sum = 0;
+      UINT bestIndex = 0;
+      for(UINT k=0; k<numClasses; k++){
+        linearLikelihoods[i][k] = computeLinearMixtureLikelihood(models[k], x);
+        sum += linearLikelihoods[i][k];
+        if( linearLikelihoods[i][k] > linearLikelihoods[i][bestIndex] ) bestIndex = k;
+      }
+      for(UINT k=0; k<numClasses; k++) linearLikelihoods[i][k] /= sum;
+      if( sum == 0 ) numLinearNaN++;
+      linearLabels[i] = models[bestIndex].getClassLabel();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double linearTime = getElapsedMicroSeconds(start, end);
+
+    UINT agree = 0;
+    double maxDiff = 0;
+    bool linearValid = true;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT i=0; i<numQueries; i++){
+      if( !gmm.predict( queries.getRowVector(i) ) ) return EXIT_FAILURE;
+      VectorDouble y = gmm.getClassLikelihoods();
+      linearValid = !isnan( linearLikelihoods[i][0] );
+      if( !linearValid || linearLabels[i] == gmm.getPredictedClassLabel() ) agree++;
+      for(UINT k=0; k<numClasses; k++){
+        if( isnan( y[k] ) ){
+          printf("%u\tERROR: The class likelihoods are not valid!\n", N);
+          return EXIT_FAILURE;
+        }
+        if( linearValid ) maxDiff = std::max( maxDiff, fabs( y[k]-linearLikelihoods[i][k] ) );
+      }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double choleskyTime = getElapsedMicroSeconds(start, end);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT i=0; i<numQueries; i++){
+      if( !diagonal.predict( queries.getRowVector(i) ) ) return EXIT_FAILURE;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double diagonalTime = getElapsedMicroSeconds(start, end);
+
+    printf("%u\t%.2f\t\t%.2f\t\t%.2f\t\t%.2f%%\t\t%u\t\t%.2e\n", N, linearTime/numQueries, choleskyTime/numQueries, diagonalTime/numQueries, 100.0*agree/numQueries, numLinearNaN, maxDiff);
+
+    //The saved models must predict the same labels once they are loaded
+    if( !diagonal.saveModelToFile("gmm_prediction_model.txt") ) return EXIT_FAILURE;
+    GMM loaded;
+    if( !loaded.loadModelFromFile("gmm_prediction_model.txt") || !loaded.getUseDiagonalCovariance() ){
+      printf("%u\tERROR: Failed to load the diagonal GMM!\n", N);
+      return EXIT_FAILURE;
+    }
+    for(UINT i=0; i<numQueries; i++){
+      diagonal.predict( queries.getRowVector(i) );
+      loaded.predict( queries.getRowVector(i) );
+      if( diagonal.getPredictedClassLabel() != loaded.getPredictedClassLabel() ){
+        printf("%u\tERROR: The loaded GMM does not match the saved GMM!\n", N);
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
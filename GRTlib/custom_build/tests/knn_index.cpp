@@ -0,0 +1,128 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Times KNN predictions with and without the spatial index as the training set grows, and checks the indexed search finds exactly the
+//same labels and class distances as the linear search for every distance method, before and after a save/load round trip
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static const char *getDistanceMethodName(const UINT distanceMethod) {
+  switch( distanceMethod ){
+    case KNN::EUCLIDEAN_DISTANCE: return "Euclidean";
+    case KNN::COSINE_DISTANCE: return "Cosine";
+    default: return "Manhattan";
+  }
+}
+
+//Runs the queries through the model, keeping the predicted labels and class distances
+static bool predict(KNN &knn, const MatrixDouble &queries, vector< UINT > &labels, vector< VectorDouble > &distances) {
+  labels.resize(queries.getNumRows());
+  distances.resize(queries.getNumRows());
+  for(UINT i=0; i<queries.getNumRows(); i++){
+    if( !knn.predict(queries.getRowVector(i)) ) return false;
+    labels[i] = knn.getPredictedClassLabel();
+    distances[i] = knn.getClassDistances();
+  }
+  return true;
+}
+
+//Counts the queries where the indexed model gives a different label or different class distances to the linear labels and distances
+static UINT countMismatches(KNN &indexKNN, const MatrixDouble &queries, const vector< UINT > &linearLabels, const vector< VectorDouble > &linearDistances) {
+  UINT mismatches = 0;
+  for(UINT i=0; i<queries.getNumRows(); i++){
+    if( !indexKNN.predict(queries.getRowVector(i)) ) return queries.getNumRows();
+    if( indexKNN.getPredictedClassLabel() != linearLabels[i] || indexKNN.getClassDistances() != linearDistances[i] ) mismatches++;
+  }
+  return mismatches;
+}
+
+int main(int argc, const char * argv[]) {
+  const UINT numDimensions = 3;
+  const UINT numClasses = 5;
+  const UINT numQueries = 1000;
+  const UINT K = 5;
+  Random random(42);
+
+  //Use the same queries for every dataset size
+  MatrixDouble queries(numQueries, numDimensions);
+  for(UINT i=0; i<numQueries; i++){
+    for(UINT j=0; j<numDimensions; j++){
+      queries[i][j] = random.getRandomNumberUniform(0, 1);
+    }
+  }
+
+  printf("NumSamples\tDistance\tLinear(us)\tIndex(us)\tIndexBuild(ms)\tMismatches\tLoadedMismatches\n");
+
+  UINT totalMismatches = 0;
+  for(UINT numSamples=1000; numSamples<=100000; numSamples*=10){
+    LabelledClassificationData trainingData(numDimensions);
+    VectorDouble sample(numDimensions);
+    for(UINT i=0; i<numSamples; i++){
+      for(UINT j=0; j<numDimensions; j++){
+        sample[j] = random.getRandomNumberUniform(0, 1);
+      }
+      trainingData.addSample(1 + (i % numClasses), sample);
+    }
+
+    for(UINT distanceMethod=KNN::EUCLIDEAN_DISTANCE; distanceMethod<=KNN::MANHATTAN_DISTANCE; distanceMethod++){
+      KNN linearKNN(K);
+      KNN indexKNN(K);
+      linearKNN.setDistanceMethod(distanceMethod);
+      indexKNN.setDistanceMethod(distanceMethod);
+      indexKNN.enableSpatialIndex(true);
+
+      struct timespec start, end;
+      if (!linearKNN.train(trainingData)) {
+        cout << "ERROR: Failed to train the linear KNN model!\n";
+        return EXIT_FAILURE;
+      }
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      if (!indexKNN.train(trainingData)) {
+        cout << "ERROR: Failed to train the indexed KNN model!\n";
+        return EXIT_FAILURE;
+      }
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double buildTime = getElapsedMicroSeconds(start, end) / 1000.0;
+
+      vector< UINT > linearLabels(numQueries);
+      vector< VectorDouble > linearDistances(numQueries);
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      if (!predict(linearKNN, queries, linearLabels, linearDistances)) {
+        cout << "ERROR: Failed to run the linear KNN prediction!\n";
+        return EXIT_FAILURE;
+      }
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double linearTime = getElapsedMicroSeconds(start, end) / numQueries;
+
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      const UINT mismatches = countMismatches(indexKNN, queries, linearLabels, linearDistances);
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double indexTime = getElapsedMicroSeconds(start, end) / numQueries;
+
+      //The model file keeps the training data to 6 significant digits, so the loaded index is compared against a linear search of the loaded data
+      KNN loadedKNN, loadedLinearKNN;
+      if (!indexKNN.saveModelToFile("knn_index_model.txt") || !loadedKNN.loadModelFromFile("knn_index_model.txt") || !loadedLinearKNN.loadModelFromFile("knn_index_model.txt")) {
+        cout << "ERROR: Failed to save or load the indexed KNN model!\n";
+        return EXIT_FAILURE;
+      }
+      if (!loadedKNN.getUseSpatialIndex() || !loadedLinearKNN.enableSpatialIndex(false)) {
+        cout << "ERROR: The loaded KNN model does not use the spatial index, or the index of the linear copy could not be disabled!\n";
+        return EXIT_FAILURE;
+      }
+      if (!predict(loadedLinearKNN, queries, linearLabels, linearDistances)) {
+        cout << "ERROR: Failed to run the loaded linear KNN prediction!\n";
+        return EXIT_FAILURE;
+      }
+      const UINT loadedMismatches = countMismatches(loadedKNN, queries, linearLabels, linearDistances);
+
+      printf("%u\t\t%s\t%.2f\t\t%.2f\t\t%.2f\t\t%u\t\t%u\n", numSamples, getDistanceMethodName(distanceMethod), linearTime, indexTime, buildTime, mismatches, loadedMismatches);
+      totalMismatches += mismatches + loadedMismatches;
+    }
+  }
+
+  return totalMismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,102 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Times MatrixDouble::multiple against the plain loops it used to run, for square matrices from 8x8 to 2048x2048
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static void multipleLoops(const MatrixDouble &a, const MatrixDouble &b, MatrixDouble &c) {
+  const UINT M = a.getNumRows();
+  const UINT K = a.getNumCols();
+  const UINT L = b.getNumCols();
+  c.resize(M, L);
+  for(UINT i=0; i<M; i++){
+    for(UINT j=0; j<L; j++){
+      c[i][j] = 0;
+      for(UINT k=0; k<K; k++){
+        c[i][j] += a[i][k] * b[k][j];
+      }
+    }
+  }
+}
+
+static void multipleLoops(const MatrixDouble &a, const VectorDouble &b, VectorDouble &c) {
+  c.resize(a.getNumRows());
+  for(UINT i=0; i<a.getNumRows(); i++){
+    c[i] = 0;
+    for(UINT j=0; j<a.getNumCols(); j++){
+      c[i] += a[i][j] * b[j];
+    }
+  }
+}
+
+int main(int argc, const char * argv[]) {
+  const UINT numThreads = 4;
+  Random random;
+
+  printf("InstructionSet: %s\n", MatrixKernels::getInstructionSet().c_str());
+  printf("Size\tLoopsGEMM(us)\tGEMM(us)\tGEMM%uT(us)\tLoopsGEMV(us)\tGEMV(us)\tMismatches\n", numThreads);
+
+  UINT totalMismatches = 0;
+  for(UINT n=8; n<=2048; n*=2){
+    MatrixDouble a(n, n), b(n, n);
+    VectorDouble x(n);
+    for(UINT i=0; i<n; i++){
+      x[i] = random.getRandomNumberUniform(-1.0, 1.0);
+      for(UINT j=0; j<n; j++){
+        a[i][j] = random.getRandomNumberUniform(-1.0, 1.0);
+        b[i][j] = random.getRandomNumberUniform(-1.0, 1.0);
+      }
+    }
+
+    //Repeat the small products so each time is measured over roughly the same amount of work
+    const UINT numRepeats = n >= 512 ? 1 : (512 / n) * (512 / n);
+    const UINT numVectorRepeats = (2048 / n) * (2048 / n);
+    struct timespec start, end;
+    MatrixDouble loopsC, c, threadedC;
+    VectorDouble loopsY, y;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT r=0; r<numRepeats; r++) multipleLoops(a, b, loopsC);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double loopsTime = getElapsedMicroSeconds(start, end) / numRepeats;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT r=0; r<numRepeats; r++) a.multiple(b, c);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double gemmTime = getElapsedMicroSeconds(start, end) / numRepeats;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT r=0; r<numRepeats; r++) a.multiple(b, threadedC, numThreads);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double threadedTime = getElapsedMicroSeconds(start, end) / numRepeats;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT r=0; r<numVectorRepeats; r++) multipleLoops(a, x, loopsY);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double loopsVectorTime = getElapsedMicroSeconds(start, end) / numVectorRepeats;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(UINT r=0; r<numVectorRepeats; r++) a.multiple(x, y);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double gemvTime = getElapsedMicroSeconds(start, end) / numVectorRepeats;
+
+    //The kernels add the products in the same order as the loops, so the results should be identical
+    UINT mismatches = 0;
+    for(UINT i=0; i<n; i++){
+      if (y[i] != loopsY[i]) mismatches++;
+      for(UINT j=0; j<n; j++){
+        if (c[i][j] != loopsC[i][j] || threadedC[i][j] != loopsC[i][j]) mismatches++;
+      }
+    }
+
+    printf("%u\t%.2f\t\t%.2f\t\t%.2f\t\t%.2f\t\t%.2f\t\t%u\n", n, loopsTime, gemmTime, threadedTime, loopsVectorTime, gemvTime, mismatches);
+    totalMismatches += mismatches;
+  }
+
+  return totalMismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,215 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Runs grid, random and successive halving searches over KNN, SVM, RandomForests, DTW and MLP pipelines.  Checks the grid search gives the same
+//scores with 1 and 4 threads, and with and without early stopping (for the candidates that were not stopped), and that the winner is the same
+//in each case.  Times each search against a hand-written loop of k-fold training calls over the same candidates
+const UINT numDimensions = 4;
+const UINT numClasses = 4;
+const UINT kFoldValue = 5;
+const unsigned long long randomSeed = 1234;
+
+//Silences the progress libsvm prints while training each SVM candidate
+static void printNothing(const char *s) {}
+
+static double getElapsedMilliSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e3 + (end.tv_nsec - start.tv_nsec) / 1.0e6;
+}
+
+static LabelledClassificationData createClassificationData(Random &random, const UINT numSamples) {
+  LabelledClassificationData data(numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    const UINT classLabel = i % numClasses + 1;
+    VectorDouble sample(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) sample[j] = (classLabel == j+1 ? 1.0 : 0.0) + random.getRandomNumberGauss(0, 0.6);
+    data.addSample( classLabel, sample );
+  }
+  return data;
+}
+
+static LabelledTimeSeriesClassificationData createTimeSeriesData(Random &random, const UINT numSamples) {
+  LabelledTimeSeriesClassificationData data(2);
+  for(UINT i=0; i<numSamples; i++){
+    const UINT classLabel = i % numClasses + 1;
+    const UINT length = 30 + random.getRandomNumberInt(0, 10);
+    MatrixDouble timeSeries(length, 2);
+    for(UINT t=0; t<length; t++){
+      timeSeries[t][0] = sin( t * 0.2 * classLabel ) + random.getRandomNumberGauss(0, 0.4);
+      timeSeries[t][1] = cos( t * 0.1 * classLabel ) + random.getRandomNumberGauss(0, 0.4);
+    }
+    data.addSample( classLabel, timeSeries );
+  }
+  return data;
+}
+
+static LabelledRegressionData createRegressionData(Random &random, const UINT numSamples) {
+  LabelledRegressionData data(2, 1);
+  for(UINT i=0; i<numSamples; i++){
+    VectorDouble input(2), target(1);
+    input[0] = random.getRandomNumberUniform(-1, 1);
+    input[1] = random.getRandomNumberUniform(-1, 1);
+    target[0] = 0.5 + 0.4 * sin( 3 * input[0] ) * input[1];
+    data.addSample( input, target );
+  }
+  return data;
+}
+
+//The hand-written loop the search replaces, a k-fold training call for each candidate
+template< class T >
+static double runLoop(const ParameterSearch &search, const GestureRecognitionPipeline &pipeline, const T &trainingData, const vector< ParameterSearchResult > &candidates) {
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT i=0; i<candidates.size(); i++){
+    GestureRecognitionPipeline candidate( pipeline );
+    search.setParameters( candidate, candidates[i].parameterValues );
+    candidate.train( trainingData, kFoldValue );
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return getElapsedMilliSeconds(start, end);
+}
+
+template< class T >
+static bool runSearch(const string &name, ParameterSearch &search, const GestureRecognitionPipeline &pipeline, const T &trainingData) {
+  if( !search.search( pipeline, trainingData ) ){
+    printf("%s\tERROR: The search failed!\n", name.c_str());
+    return false;
+  }
+  const ParameterSearchResult best = search.getBestResult();
+  const double loopTime = runLoop( search, pipeline, trainingData, search.getLeaderboard() );
+  printf("%s\tCandidates: %u\tStopped: %u\tBest:", name.c_str(), search.getNumCandidates(), search.getNumStoppedCandidates());
+  for(UINT j=0; j<best.parameterValues.size(); j++) printf(" %g", best.parameterValues[j]);
+  printf("\tScore: %.4f\tSearch(ms): %.1f\tLoop(ms): %.1f\tSpeedUp: %.2fx\n", best.score, search.getSearchTime(), loopTime, loopTime / search.getSearchTime());
+  return true;
+}
+
+//Checks the scores of the candidates that completed both searches are identical, and the winners match
+static bool compareSearches(const string &name, const ParameterSearch &a, const ParameterSearch &b) {
+  vector< ParameterSearchResult > ra = a.getLeaderboard();
+  vector< ParameterSearchResult > rb = b.getLeaderboard();
+  if( ra.size() != rb.size() || ra.size() == 0 ) return false;
+  vector< const ParameterSearchResult* > byIndexA( ra.size() ), byIndexB( rb.size() );
+  for(UINT i=0; i<ra.size(); i++){ byIndexA[ ra[i].candidateIndex ] = &ra[i]; byIndexB[ rb[i].candidateIndex ] = &rb[i]; }
+  UINT numCompared = 0, mismatches = 0;
+  for(UINT i=0; i<ra.size(); i++){
+    if( byIndexA[i]->stopped || byIndexB[i]->stopped ) continue;
+    numCompared++;
+    if( byIndexA[i]->score != byIndexB[i]->score || byIndexA[i]->foldScores != byIndexB[i]->foldScores ) mismatches++;
+  }
+  const bool sameWinner = ra[0].candidateIndex == rb[0].candidateIndex && ra[0].score == rb[0].score;
+  printf("%s\tCompared: %u\tMismatches: %u\tSameWinner: %s\n", name.c_str(), numCompared, mismatches, sameWinner ? "yes" : "NO");
+  return mismatches == 0 && sameWinner;
+}
+
+int main(int argc, const char * argv[]) {
+
+  TrainingLog::enableLogging( false );
+  WarningLog::enableLogging( false );
+  LIBSVM::svm_set_print_string_function( printNothing );
+  Random random(42);
+
+  const LabelledClassificationData classificationData = createClassificationData( random, 2000 );
+  const LabelledTimeSeriesClassificationData timeSeriesData = createTimeSeriesData( random, 60 );
+  const LabelledRegressionData regressionData = createRegressionData( random, 400 );
+
+  bool ok = true;
+
+  //Grid search over KNN, with 1 and 4 threads and with and without early stopping
+  {
+    GestureRecognitionPipeline pipeline;
+    pipeline.setClassifier( KNN() );
+    VectorDouble kValues;
+    for(UINT k=1; k<=29; k+=2) kValues.push_back( k );
+    ParameterSearch serial(ParameterSearch::GRID_SEARCH, kFoldValue, 1);
+    serial.setRandomSeed( randomSeed );
+    serial.setUseEarlyStopping( false );
+    serial.addParameter( "KNN.K", kValues );
+    ParameterSearch parallel(ParameterSearch::GRID_SEARCH, kFoldValue, 4);
+    parallel.setRandomSeed( randomSeed );
+    parallel.addParameter( "KNN.K", kValues );
+    ok = runSearch( "KNN grid (1 thread)", serial, pipeline, classificationData ) && ok;
+    ok = runSearch( "KNN grid (4 threads, early stopping)", parallel, pipeline, classificationData ) && ok;
+    ok = compareSearches( "KNN grid serial vs parallel", serial, parallel ) && ok;
+    parallel.printLeaderboard( 5 );
+  }
+
+  //Random search over the C and gamma of an SVM, on a log scale
+  {
+    GestureRecognitionPipeline pipeline;
+    pipeline.setClassifier( SVM() );
+    ParameterSearch search(ParameterSearch::RANDOM_SEARCH, kFoldValue, 4);
+    search.setRandomSeed( randomSeed );
+    search.setNumRandomCandidates( 12 );
+    search.addParameter( "SVM.C", 0.01, 100, true );
+    search.addParameter( "SVM.gamma", 0.01, 10, true );
+    ok = runSearch( "SVM random", search, pipeline, classificationData ) && ok;
+  }
+
+  //Successive halving against the grid search over the size and depth of a random forest
+  {
+    GestureRecognitionPipeline pipeline;
+    pipeline.setClassifier( RandomForests() );
+    VectorDouble forestSizes, maxDepths;
+    for(UINT i=2; i<=16; i*=2) forestSizes.push_back( i );
+    for(UINT i=2; i<=8; i+=3) maxDepths.push_back( i );
+    ParameterSearch grid(ParameterSearch::GRID_SEARCH, kFoldValue, 4);
+    grid.setRandomSeed( randomSeed );
+    grid.addParameter( "RandomForests.forestSize", forestSizes );
+    grid.addParameter( "RandomForests.maxDepth", maxDepths );
+    ParameterSearch halving(ParameterSearch::SUCCESSIVE_HALVING, kFoldValue, 4);
+    halving.setRandomSeed( randomSeed );
+    halving.addParameter( "RandomForests.forestSize", forestSizes );
+    halving.addParameter( "RandomForests.maxDepth", maxDepths );
+    ok = runSearch( "RandomForests grid", grid, pipeline, classificationData ) && ok;
+    ok = runSearch( "RandomForests halving", halving, pipeline, classificationData ) && ok;
+    halving.printLeaderboard( 5 );
+  }
+
+  //DTW warping radius on time series
+  {
+    GestureRecognitionPipeline pipeline;
+    pipeline.setClassifier( DTW(false, false, 3.0, DTW::TEMPLATE_THRESHOLDS, true, 0.2) );
+    VectorDouble radii;
+    radii.push_back( 0.05 ); radii.push_back( 0.1 ); radii.push_back( 0.2 ); radii.push_back( 0.4 );
+    ParameterSearch search(ParameterSearch::GRID_SEARCH, kFoldValue, 4);
+    search.setRandomSeed( randomSeed );
+    search.setUseStratifiedSampling( true );
+    search.addParameter( "DTW.warpingRadius", radii );
+    ok = runSearch( "DTW grid", search, pipeline, timeSeriesData ) && ok;
+  }
+
+  //The hidden layer of an MLP regressifier, ranked by RMS error
+  {
+    MLP mlp;
+    mlp.init(2, 2, 1);
+    mlp.setNumRandomTrainingIterations( 1 );
+    GestureRecognitionPipeline pipeline;
+    pipeline.setRegressifier( mlp );
+    VectorDouble hiddenNeurons;
+    hiddenNeurons.push_back( 1 ); hiddenNeurons.push_back( 4 ); hiddenNeurons.push_back( 8 );
+    ParameterSearch search(ParameterSearch::GRID_SEARCH, kFoldValue, 4);
+    search.setRandomSeed( randomSeed );
+    search.addParameter( "MLP.numHiddenNeurons", hiddenNeurons );
+    ok = runSearch( "MLP grid", search, pipeline, regressionData ) && ok;
+    search.printLeaderboard();
+
+    GestureRecognitionPipeline best( pipeline );
+    ok = search.setBestParameters( best ) && best.train( regressionData ) && ok;
+  }
+
+  //A parameter the classifier does not have fails every candidate
+  {
+    GestureRecognitionPipeline pipeline;
+    pipeline.setClassifier( KNN() );
+    ParameterSearch search;
+    VectorDouble values(1, 10);
+    search.addParameter( "SVM.C", values );
+    const bool failed = !search.search( pipeline, classificationData ) && search.getLeaderboard().size() == 1 && search.getLeaderboard()[0].failed;
+    printf("Wrong parameter\tFailed: %s\n", failed ? "yes" : "NO");
+    ok = failed && ok;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
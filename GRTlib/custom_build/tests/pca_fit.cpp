@@ -0,0 +1,128 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Times the eigen decomposition of PCA covariance matrices with the general EigenvalueDecomposition PCA used to run, the full
+//SymmetricEigenDecomposition and the truncated top-k decomposition, and checks they find the same leading components
+static double getElapsedMilliSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e3 + (end.tv_nsec - start.tv_nsec) / 1.0e6;
+}
+
+//Builds data that looks like a set of FFT magnitudes, a few smooth spectral shapes mixed with noise, so the spectrum decays quickly
+static MatrixDouble buildSpectralData(const UINT M, const UINT N, Random &random) {
+  const UINT numShapes = 12;
+  MatrixDouble shapes(numShapes, N);
+  for(UINT s=0; s<numShapes; s++){
+    const double centre = random.getRandomNumberUniform(0, N);
+    const double width = random.getRandomNumberUniform(N/50.0, N/5.0);
+    for(UINT j=0; j<N; j++) shapes[s][j] = exp( -0.5 * (j-centre) * (j-centre) / (width*width) );
+  }
+  MatrixDouble data(M, N);
+  for(UINT i=0; i<M; i++){
+    for(UINT j=0; j<N; j++) data[i][j] = random.getRandomNumberGauss(0, 0.01);
+    for(UINT s=0; s<numShapes; s++){
+      const double w = random.getRandomNumberGauss(0, 1.0 / (s+1));
+      for(UINT j=0; j<N; j++) data[i][j] += w * shapes[s][j];
+    }
+  }
+  return data;
+}
+
+//Returns the largest difference between the leading K eigenvalues (relative to the largest eigenvalue) and 1 - |cos| of the angle between the eigenvectors
+static void compare(const VectorDouble &values, const MatrixDouble &vectors, const VectorDouble &refValues, const MatrixDouble &refVectors, const UINT K, double &valueError, double &vectorError) {
+  valueError = 0;
+  vectorError = 0;
+  for(UINT k=0; k<K; k++){
+    valueError = std::max(valueError, fabs(values[k]-refValues[k]) / refValues[0]);
+    double dot = 0;
+    for(UINT j=0; j<vectors.getNumRows(); j++) dot += vectors[j][k] * refVectors[j][k];
+    vectorError = std::max(vectorError, 1.0 - fabs(dot));
+  }
+}
+
+int main(int argc, const char * argv[]) {
+  const UINT M = 2000;
+  const UINT K = 10;
+  Random random(42);
+
+  printf("Dims\tGeneral(ms)\tSymmetric(ms)\tTop%u(ms)\tSymValueErr\tSymVectorErr\tTopValueErr\tTopVectorErr\n", K);
+
+  for(UINT N=64; N<=512; N*=2){
+    MatrixDouble data = buildSpectralData(M, N, random);
+    MatrixDouble cov = data.getCovarianceMatrix();
+    struct timespec start, end;
+
+    //The general solver returns its eigenvalues in ascending order
+    EigenvalueDecomposition general;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    general.decompose(cov);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double generalTime = getElapsedMilliSeconds(start, end);
+    VectorDouble generalValues = general.getRealEigenvalues();
+    MatrixDouble generalVectors = general.getEigenvectors();
+    VectorDouble refValues(N);
+    MatrixDouble refVectors(N, N);
+    for(UINT k=0; k<N; k++){
+      refValues[k] = generalValues[N-1-k];
+      for(UINT j=0; j<N; j++) refVectors[j][k] = generalVectors[j][N-1-k];
+    }
+
+    SymmetricEigenDecomposition symmetric;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    symmetric.decompose(cov);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double symmetricTime = getElapsedMilliSeconds(start, end);
+
+    SymmetricEigenDecomposition truncated;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    truncated.decompose(cov, K);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double truncatedTime = getElapsedMilliSeconds(start, end);
+
+    double symValueError, symVectorError, topValueError, topVectorError;
+    compare(symmetric.getEigenvalues(), symmetric.getEigenvectors(), refValues, refVectors, K, symValueError, symVectorError);
+    compare(truncated.getEigenvalues(), truncated.getEigenvectors(), refValues, refVectors, K, topValueError, topVectorError);
+
+    printf("%u\t%.2f\t\t%.2f\t\t%.2f\t\t%.2e\t%.2e\t%.2e\t%.2e\n", N, generalTime, symmetricTime, truncatedTime, symValueError, symVectorError, topValueError, topVectorError);
+  }
+
+  //Fit PCA end to end on 500 dimensional data, keeping the top K components and 95% of the variance
+  MatrixDouble data = buildSpectralData(M, 500, random);
+  printf("\nPCA fit on [%u 500]\tFull(ms)\tTruncated(ms)\tComponents\n", M);
+  for(UINT mode=0; mode<2; mode++){
+    double times[2];
+    UINT numComponents[2];
+    for(UINT truncated=0; truncated<2; truncated++){
+      PrincipalComponentAnalysis pca;
+      pca.setUseTruncatedSolver(truncated == 1);
+      struct timespec start, end;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      if( mode == 0 ) pca.computeFeatureVector(data, K);
+      else pca.computeFeatureVector(data, 0.95);
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      times[truncated] = getElapsedMilliSeconds(start, end);
+      numComponents[truncated] = pca.getNumPrincipalComponents();
+    }
+    printf("%s\t\t\t%.2f\t\t%.2f\t\t%u/%u\n", mode == 0 ? "Top 10" : "95% variance", times[0], times[1], numComponents[0], numComponents[1]);
+  }
+
+  //Asking the truncated solver for more components than the matrix has must give the full decomposition
+  bool clampOk = true;
+  {
+    const UINT N = 6;
+    MatrixDouble smallData = buildSpectralData(M, N, random);
+    MatrixDouble cov = smallData.getCovarianceMatrix();
+    SymmetricEigenDecomposition full, clamped;
+    clampOk = full.decompose(cov) && clamped.decompose(cov, N+4);
+    clampOk = clampOk && clamped.getEigenvalues() == full.getEigenvalues();
+    MatrixDouble fullVectors = full.getEigenvectors(), clampedVectors = clamped.getEigenvectors();
+    for(UINT i=0; i<N && clampOk; i++){
+      for(UINT j=0; j<N; j++) clampOk = clampOk && clampedVectors[i][j] == fullVectors[i][j];
+    }
+  }
+  printf("\nComponents clamped to the matrix size: %s\n", clampOk ? "ok" : "FAILED");
+
+  return clampOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
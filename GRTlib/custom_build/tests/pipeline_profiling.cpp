@@ -0,0 +1,128 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Checks the LatencyHistogram percentiles against the exact percentiles of a skewed set of latencies, then profiles every module of a
+//pipeline, checks each module was recorded once per prediction, prints the profiling report and compares the cost of a prediction with
+//profiling turned off and on
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static bool testHistogram() {
+  const UINT numValues = 100000;
+  Random random(42);
+  LatencyHistogram histogram;
+  vector< unsigned long long > values(numValues);
+  for(UINT i=0; i<numValues; i++){
+    //Mostly around 20us with a long tail, like a module that occasionally stalls
+    values[i] = (unsigned long long)( 20000 * exp( random.getRandomNumberGauss(0, 0.5) ) );
+    if( i % 1000 == 0 ) values[i] *= 50;
+    histogram.update( values[i], i % 100 != 0 );
+  }
+  std::sort( values.begin(), values.end() );
+
+  bool ok = histogram.getNumCalls() == numValues && histogram.getNumFailures() == numValues / 100;
+  ok = ok && histogram.getMaximumTime() == values.back() / 1000.0 && histogram.getMinimumTime() == values.front() / 1000.0;
+
+  const double percentiles[4] = {0.5, 0.9, 0.99, 0.999};
+  printf("Percentile\tExact(us)\tHistogram(us)\tError\n");
+  for(UINT i=0; i<4; i++){
+    const double exact = values[ (UINT)ceil( percentiles[i] * numValues ) - 1 ] / 1000.0;
+    const double estimate = histogram.getPercentileTime( percentiles[i] );
+    const double error = (estimate - exact) / exact;
+    printf("%g\t\t%.3f\t\t%.3f\t\t%.2f%%\n", percentiles[i], exact, estimate, 100 * error);
+    if( error < 0 || error > 0.125 ) ok = false;
+  }
+  printf("Calls: %llu\tFailures: %llu\tMin(us): %.3f\tMax(us): %.3f\tHistogramOK: %s\n\n", histogram.getNumCalls(), histogram.getNumFailures(),
+         histogram.getMinimumTime(), histogram.getMaximumTime(), ok ? "yes" : "NO");
+  return ok;
+}
+
+static double timePredictions(GestureRecognitionPipeline &pipeline, const MatrixDouble &data) {
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT i=0; i<data.getNumRows(); i++){
+    pipeline.predict( data.getRowVector(i) );
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return getElapsedMicroSeconds(start, end) / data.getNumRows();
+}
+
+int main(int argc, const char * argv[]) {
+
+  if( !testHistogram() ) return EXIT_FAILURE;
+
+  const UINT numDimensions = 8;
+  const UINT numClasses = 4;
+  const UINT numSamples = 20000;
+  Random random(42);
+
+  LabelledClassificationData trainingData(numDimensions);
+  for(UINT i=0; i<2000; i++){
+    const UINT classLabel = (i % numClasses) + 1;
+    VectorDouble sample(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) sample[j] = sin( classLabel * 0.9 + j ) + random.getRandomNumberGauss(0, 0.3);
+    trainingData.addSample( classLabel, sample );
+  }
+  MatrixDouble data(numSamples, numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    for(UINT j=0; j<numDimensions; j++) data[i][j] = sin( ((i / 50) % numClasses + 1) * 0.9 + j ) + random.getRandomNumberGauss(0, 0.3);
+  }
+
+  GestureRecognitionPipeline pipeline;
+  pipeline.addContextModule( Gate(true), GestureRecognitionPipeline::START_OF_PIPELINE );
+  pipeline.addPreProcessingModule( LowPassFilter(0.3, 1, numDimensions) );
+  pipeline.addPreProcessingModule( MovingAverageFilter(5, numDimensions) );
+  pipeline.addFeatureExtractionModule( ZeroCrossingCounter(20, 0.01, numDimensions) );
+  pipeline.setClassifier( KNN(5) );
+  pipeline.addPostProcessingModule( ClassLabelFilter(3, 5) );
+  if( !pipeline.train( trainingData ) ){
+    printf("ERROR: Failed to train the pipeline!\n");
+    return EXIT_FAILURE;
+  }
+
+  //Warm up, then time the predictions with profiling off and on
+  timePredictions( pipeline, data );
+  pipeline.reset();
+  const double offTime = timePredictions( pipeline, data );
+  if( pipeline.getProfiler().getNumModules( PipelineProfiler::PREDICT ) != 0 ){
+    printf("ERROR: The profiler recorded a prediction while it was disabled!\n");
+    return EXIT_FAILURE;
+  }
+
+  pipeline.reset();
+  if( !pipeline.setProfilingEnabled( true ) ){
+    printf("Profiling is compiled out of this build\n");
+    return EXIT_SUCCESS;
+  }
+  const double onTime = timePredictions( pipeline, data );
+
+  pipeline.printProfilingReport();
+
+  //Every module should have been called once per prediction
+  const PipelineProfiler &profiler = pipeline.getProfiler();
+  const UINT stageTypes[7] = {PipelineProfiler::START_OF_PIPELINE_CONTEXT, PipelineProfiler::PREPROCESSING, PipelineProfiler::PREPROCESSING,
+                              PipelineProfiler::FEATURE_EXTRACTION, PipelineProfiler::CLASSIFIER, PipelineProfiler::POSTPROCESSING, PipelineProfiler::PREDICT};
+  const UINT moduleIndexes[7] = {0, 0, 1, 0, 0, 0, 0};
+  bool countsMatch = true;
+  double moduleTime = 0;
+  for(UINT i=0; i<7; i++){
+    const LatencyHistogram &statistics = profiler.getStatistics( stageTypes[i], moduleIndexes[i] );
+    if( statistics.getNumCalls() != numSamples || statistics.getNumFailures() != 0 ) countsMatch = false;
+    if( stageTypes[i] != PipelineProfiler::PREDICT ) moduleTime += statistics.getTotalTime();
+  }
+  const double predictTime = profiler.getStatistics( PipelineProfiler::PREDICT, 0 ).getTotalTime();
+
+  printf("\nPredict(us) profiling off: %.3f\ton: %.3f\tOverhead(us): %.3f\tModules/Predict: %.3f\tCountsMatch: %s\n", offTime, onTime, onTime - offTime,
+         moduleTime / predictTime, countsMatch ? "yes" : "NO");
+
+  if( !countsMatch || moduleTime > predictTime ) return EXIT_FAILURE;
+
+  pipeline.clearProfilingStatistics();
+  if( profiler.getStatistics( PipelineProfiler::PREDICT, 0 ).getNumCalls() != 0 ) return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
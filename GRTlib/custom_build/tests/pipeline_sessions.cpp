@@ -0,0 +1,184 @@
+#include "GRT.h"
+
+#include <malloc.h>
+#include <pthread.h>
+#include <time.h>
+
+using namespace GRT;
+
+//Trains one pipeline per classifier, then runs several streams of data through PipelineSessions that share the trained pipeline, one
+//thread per session.  Each session must give exactly the same labels and likelihoods as a copy of the pipeline that runs the same
+//stream on its own.  Also prints the memory used by one session against one copy of the pipeline, and the throughput of the sessions
+//against a single pipeline guarded by a mutex
+const UINT numDimensions = 8;
+const UINT numClasses = 4;
+const UINT numStreams = 8;
+const UINT numSamples = 4000;
+
+struct StreamResult{
+  vector< UINT > labels;
+  vector< UINT > unprocessedLabels;
+  vector< double > likelihoods;
+};
+
+struct ThreadData{
+  PipelineSession *session;
+  GestureRecognitionPipeline *pipeline;
+  pthread_mutex_t *mutex;
+  const MatrixDouble *stream;
+  StreamResult result;
+  bool ok;
+};
+
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static size_t getAllocatedBytes() {
+  return mallinfo2().uordblks;
+}
+
+static void* runSession(void *data) {
+  ThreadData *t = (ThreadData*)data;
+  t->ok = t->session->reset();
+  for(UINT i=0; i<t->stream->getNumRows() && t->ok; i++){
+    if( !t->session->predict( t->stream->getRowVector(i) ) ) t->ok = false;
+    t->result.labels.push_back( t->session->getPredictedClassLabel() );
+    t->result.unprocessedLabels.push_back( t->session->getUnProcessedPredictedClassLabel() );
+    t->result.likelihoods.push_back( t->session->getMaximumLikelihood() );
+  }
+  return NULL;
+}
+
+//The baseline without sessions: every thread shares one pipeline and takes a lock around each prediction.  The streams are mixed
+//together in the pipeline's filters, so this is only used for the throughput
+static void* runLockedPipeline(void *data) {
+  ThreadData *t = (ThreadData*)data;
+  t->ok = true;
+  for(UINT i=0; i<t->stream->getNumRows() && t->ok; i++){
+    pthread_mutex_lock( t->mutex );
+    if( !t->pipeline->predict( t->stream->getRowVector(i) ) ) t->ok = false;
+    pthread_mutex_unlock( t->mutex );
+  }
+  return NULL;
+}
+
+static bool runTest(const string &name, const Classifier &classifier, const LabelledClassificationData &trainingData, const vector< MatrixDouble > &streams) {
+
+  GestureRecognitionPipeline pipeline;
+  pipeline.addPreProcessingModule( LowPassFilter(0.3, 1, numDimensions) );
+  pipeline.addPreProcessingModule( MovingAverageFilter(5, numDimensions) );
+  pipeline.setClassifier( classifier );
+  pipeline.addPostProcessingModule( ClassLabelFilter(3, 5) );
+  if( !pipeline.train( trainingData ) ){
+    printf("ERROR: Failed to train the %s pipeline!\n", name.c_str());
+    return false;
+  }
+
+  //The expected results, each stream is run through its own copy of the pipeline
+  vector< StreamResult > expected( numStreams );
+  for(UINT s=0; s<numStreams; s++){
+    GestureRecognitionPipeline copy;
+    copy = pipeline;
+    copy.reset();
+    for(UINT i=0; i<numSamples; i++){
+      copy.predict( streams[s].getRowVector(i) );
+      expected[s].labels.push_back( copy.getPredictedClassLabel() );
+      expected[s].unprocessedLabels.push_back( copy.getUnProcessedPredictedClassLabel() );
+      expected[s].likelihoods.push_back( copy.getMaximumLikelihood() );
+    }
+  }
+
+  //The memory of one session and one copy of the pipeline, after the first prediction has allocated the buffers
+  size_t before = getAllocatedBytes();
+  PipelineSession *probeSession = new PipelineSession( pipeline );
+  probeSession->predict( streams[0].getRowVector(0) );
+  const size_t sessionBytes = getAllocatedBytes() - before;
+  delete probeSession;
+
+  before = getAllocatedBytes();
+  GestureRecognitionPipeline *probePipeline = new GestureRecognitionPipeline( pipeline );
+  probePipeline->predict( streams[0].getRowVector(0) );
+  const size_t pipelineBytes = getAllocatedBytes() - before;
+  delete probePipeline;
+
+  //Run every stream at the same time, each on its own session
+  vector< PipelineSession > sessions( numStreams, PipelineSession( pipeline ) );
+  vector< ThreadData > threadData( numStreams );
+  vector< pthread_t > threads( numStreams );
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT s=0; s<numStreams; s++){
+    threadData[s].session = &sessions[s];
+    threadData[s].stream = &streams[s];
+    pthread_create( &threads[s], NULL, runSession, &threadData[s] );
+  }
+  for(UINT s=0; s<numStreams; s++) pthread_join( threads[s], NULL );
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double sessionTime = getElapsedMicroSeconds(start, end);
+
+  bool match = true;
+  for(UINT s=0; s<numStreams; s++){
+    const StreamResult &r = threadData[s].result;
+    if( !threadData[s].ok || r.labels != expected[s].labels || r.unprocessedLabels != expected[s].unprocessedLabels || r.likelihoods != expected[s].likelihoods ) match = false;
+  }
+
+  //The same amount of work through one pipeline behind a mutex
+  pthread_mutex_t mutex;
+  pthread_mutex_init( &mutex, NULL );
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(UINT s=0; s<numStreams; s++){
+    threadData[s].pipeline = &pipeline;
+    threadData[s].mutex = &mutex;
+    pthread_create( &threads[s], NULL, runLockedPipeline, &threadData[s] );
+  }
+  for(UINT s=0; s<numStreams; s++) pthread_join( threads[s], NULL );
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double lockedTime = getElapsedMicroSeconds(start, end);
+  pthread_mutex_destroy( &mutex );
+
+  const double numPredictions = numStreams * numSamples;
+  printf("%s\tShared: %s\tMatch: %s\tSession(bytes): %zu\tPipelineCopy(bytes): %zu\tSessions(pred/s): %.0f\tLockedPipeline(pred/s): %.0f\n", name.c_str(),
+         sessions[0].getUsesSharedClassifier() ? "yes" : "no", match ? "yes" : "NO", sessionBytes, pipelineBytes,
+         numPredictions / (sessionTime * 1.0e-6), numPredictions / (lockedTime * 1.0e-6));
+
+  return match;
+}
+
+int main(int argc, const char * argv[]) {
+
+  TrainingLog::enableLogging( false );
+  Random random(42);
+
+  LabelledClassificationData trainingData(numDimensions);
+  for(UINT i=0; i<2000; i++){
+    const UINT classLabel = (i % numClasses) + 1;
+    VectorDouble sample(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) sample[j] = sin( classLabel * 0.9 + j ) + random.getRandomNumberGauss(0, 0.3);
+    trainingData.addSample( classLabel, sample );
+  }
+
+  //Each stream moves through the classes at its own speed
+  vector< MatrixDouble > streams( numStreams );
+  for(UINT s=0; s<numStreams; s++){
+    streams[s].resize( numSamples, numDimensions );
+    for(UINT i=0; i<numSamples; i++){
+      for(UINT j=0; j<numDimensions; j++) streams[s][i][j] = sin( ((i / (20 + 5*s)) % numClasses + 1) * 0.9 + j ) + random.getRandomNumberGauss(0, 0.3);
+    }
+  }
+
+  KNN knn(5);
+  knn.enableNullRejection( true );
+  GMM gmm(2);
+  gmm.enableNullRejection( true );
+
+  bool ok = true;
+  ok = runTest( "MinDist", MinDist(), trainingData, streams ) && ok;
+  ok = runTest( "ANBC", ANBC(), trainingData, streams ) && ok;
+  ok = runTest( "GMM", gmm, trainingData, streams ) && ok;
+  ok = runTest( "KNN", knn, trainingData, streams ) && ok;
+  ok = runTest( "RandomForests", RandomForests(), trainingData, streams ) && ok;
+  ok = runTest( "Softmax", Softmax(), trainingData, streams ) && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
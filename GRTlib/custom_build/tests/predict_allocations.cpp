@@ -0,0 +1,154 @@
+#include "GRT.h"
+
+#include <new>
+#include <cstdlib>
+
+using namespace GRT;
+
+//Counts the heap allocations made by GestureRecognitionPipeline::predict once the pipeline is warm.  Each pipeline is trained, run for a
+//few warm up samples so the per-stage buffers are sized, then the allocations across repeated predict calls must be zero
+static bool countAllocations = false;
+static unsigned long long numAllocations = 0;
+
+void* operator new(size_t size) {
+  if( countAllocations ) numAllocations++;
+  void *ptr = malloc( size > 0 ? size : 1 );
+  if( ptr == NULL ) throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  if( countAllocations ) numAllocations++;
+  void *ptr = malloc( size > 0 ? size : 1 );
+  if( ptr == NULL ) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void *ptr) {
+  free( ptr );
+}
+
+void operator delete[](void *ptr) {
+  free( ptr );
+}
+
+const UINT numDimensions = 6;
+const UINT numClasses = 3;
+const UINT numWarmupSamples = 10;
+const UINT numTestSamples = 500;
+
+static LabelledClassificationData createClassificationData(Random &random, const UINT numSamples) {
+  LabelledClassificationData data(numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    const UINT classLabel = i % numClasses + 1;
+    VectorDouble sample(numDimensions);
+    for(UINT j=0; j<numDimensions; j++) sample[j] = (classLabel == j+1 ? 2.0 : 0.0) + random.getRandomNumberGauss(0, 0.5);
+    data.addSample( classLabel, sample );
+  }
+  return data;
+}
+
+static LabelledRegressionData createRegressionData(Random &random, const UINT numSamples) {
+  LabelledRegressionData data;
+  data.setInputAndTargetDimensions( numDimensions, 1 );
+  for(UINT i=0; i<numSamples; i++){
+    VectorDouble input(numDimensions), target(1, 0);
+    for(UINT j=0; j<numDimensions; j++){
+      input[j] = random.getRandomNumberUniform(0, 1);
+      target[0] += input[j] * (j+1) / double(numDimensions*numDimensions);
+    }
+    data.addSample( input, target );
+  }
+  return data;
+}
+
+//Returns the number of allocations made by the predict calls after the warm up, or -1 if the pipeline failed to predict
+static long long countPredictAllocations(GestureRecognitionPipeline &pipeline, const MatrixDouble &inputs) {
+  VectorDouble inputVector( numDimensions );
+  for(UINT i=0; i<numWarmupSamples; i++){
+    std::copy( inputs[i], inputs[i]+numDimensions, inputVector.begin() );
+    if( !pipeline.predict( inputVector ) ) return -1;
+  }
+
+  numAllocations = 0;
+  countAllocations = true;
+  bool ok = true;
+  for(UINT i=numWarmupSamples; i<inputs.getNumRows(); i++){
+    std::copy( inputs[i], inputs[i]+numDimensions, inputVector.begin() );
+    ok = pipeline.predict( inputVector ) && ok;
+  }
+  countAllocations = false;
+
+  return ok ? (long long)numAllocations : -1;
+}
+
+static bool check(const string &name, GestureRecognitionPipeline &pipeline, const MatrixDouble &inputs) {
+  const long long n = countPredictAllocations( pipeline, inputs );
+  printf("%s\t%lld\t%s\n", name.c_str(), n, n == 0 ? "ok" : "FAILED");
+  return n == 0;
+}
+
+static bool checkClassifier(const string &name, const Classifier &classifier, const LabelledClassificationData &trainingData, const MatrixDouble &inputs, const bool useFilters) {
+  GestureRecognitionPipeline pipeline;
+  if( useFilters ){
+    pipeline.addPreProcessingModule( MovingAverageFilter(5, numDimensions) );
+    pipeline.addPreProcessingModule( LowPassFilter(0.5, 1, numDimensions) );
+    pipeline.addPostProcessingModule( ClassLabelFilter(3, 5) );
+  }
+  pipeline.setClassifier( classifier );
+  if( !pipeline.train( trainingData ) ){
+    printf("%s\tFailed to train!\n", name.c_str());
+    return false;
+  }
+  return check( name, pipeline, inputs );
+}
+
+int main(int argc, const char * argv[]) {
+
+  TrainingLog::enableLogging( false );
+  WarningLog::enableLogging( false );
+  Random random(42);
+  bool ok = true;
+
+  const LabelledClassificationData classificationData = createClassificationData( random, 600 );
+  const LabelledRegressionData regressionData = createRegressionData( random, 300 );
+  MatrixDouble inputs( numWarmupSamples+numTestSamples, numDimensions );
+  for(UINT i=0; i<inputs.getNumRows(); i++){
+    for(UINT j=0; j<numDimensions; j++) inputs[i][j] = random.getRandomNumberGauss(0.5, 1.0);
+  }
+
+  printf("Pipeline\tAllocations\n");
+
+  //The classifiers, on their own and with preprocessing and postprocessing modules
+  for(UINT n=0; n<2; n++){
+    const bool useFilters = n == 1;
+    const string suffix = useFilters ? "+Filters" : "";
+    ok = checkClassifier( "KNN"+suffix, KNN(10), classificationData, inputs, useFilters ) && ok;
+    KNN cosineKNN(10, true);
+    cosineKNN.setDistanceMethod( KNN::COSINE_DISTANCE );
+    ok = checkClassifier( "KNNCosine"+suffix, cosineKNN, classificationData, inputs, useFilters ) && ok;
+    ok = checkClassifier( "ANBC"+suffix, ANBC(), classificationData, inputs, useFilters ) && ok;
+    ok = checkClassifier( "MinDist"+suffix, MinDist(), classificationData, inputs, useFilters ) && ok;
+    ok = checkClassifier( "GMM"+suffix, GMM(2), classificationData, inputs, useFilters ) && ok;
+    ok = checkClassifier( "DecisionTree"+suffix, DecisionTree(), classificationData, inputs, useFilters ) && ok;
+    ok = checkClassifier( "RandomForests"+suffix, RandomForests(), classificationData, inputs, useFilters ) && ok;
+    ok = checkClassifier( "Softmax"+suffix, Softmax(), classificationData, inputs, useFilters ) && ok;
+  }
+
+  //The regressifiers
+  {
+    GestureRecognitionPipeline pipeline;
+    pipeline.setRegressifier( LinearRegression() );
+    ok = ( pipeline.train( regressionData ) && check( "LinearRegression", pipeline, inputs ) ) && ok;
+  }
+  {
+    GestureRecognitionPipeline pipeline;
+    MLP mlp;
+    mlp.init( numDimensions, 4, 1 );
+    mlp.setMaxNumEpochs( 50 );
+    pipeline.setRegressifier( mlp );
+    ok = ( pipeline.train( regressionData ) && check( "MLP", pipeline, inputs ) ) && ok;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
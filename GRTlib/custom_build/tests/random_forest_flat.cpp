@@ -0,0 +1,107 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Times RandomForests predictions through the original node trees, the flat forest and the batched flat forest
+static double getElapsedMicroSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e6 + (end.tv_nsec - start.tv_nsec) / 1.0e3;
+}
+
+static VectorDouble createSample(Random &random, const UINT classLabel, const UINT numDimensions) {
+  VectorDouble sample(numDimensions);
+  for(UINT j=0; j<numDimensions; j++){
+    sample[j] = sin( classLabel * 0.7 + j ) + random.getRandomNumberUniform(-1.0, 1.0);
+  }
+  return sample;
+}
+
+int main(int argc, const char * argv[]) {
+  const UINT numDimensions = 8;
+  const UINT numClasses = 5;
+  const UINT numQueries = 10000;
+  Random random;
+  UINT totalMismatches = 0;
+
+  TrainingLog::enableLogging(false);
+
+  printf("Samples\tMaxDepth\tNodes\tNodeTrees(us)\tFlat(us)\tBatch(us)\tMismatches\n");
+
+  for(UINT numSamples=500; numSamples<=8000; numSamples*=4){
+    for(UINT maxDepth=5; maxDepth<=20; maxDepth+=15){
+      LabelledClassificationData trainingData(numDimensions);
+      for(UINT i=0; i<numSamples; i++){
+        const UINT classLabel = (i % numClasses) + 1;
+        trainingData.addSample(classLabel, createSample(random, classLabel, numDimensions));
+      }
+
+      RandomForests forest(false, 10, 2, maxDepth);
+      if (!forest.train(trainingData)) {
+        cout << "ERROR: Failed to train the RandomForests model!\n";
+        return EXIT_FAILURE;
+      }
+
+      MatrixDouble queries(numQueries, numDimensions);
+      for(UINT i=0; i<numQueries; i++){
+        VectorDouble sample = createSample(random, (i % numClasses) + 1, numDimensions);
+        for(UINT j=0; j<numDimensions; j++) queries[i][j] = sample[j];
+      }
+
+      //Rebuild the pointer linked trees, these are what the forest used to predict with
+      const FlatDecisionForest &flatForest = forest.getFlatForest();
+      vector< DecisionTreeNode* > trees = forest.getForest();
+      if (trees.size() != flatForest.getNumTrees()) {
+        cout << "ERROR: Failed to rebuild the trees of the forest!\n";
+        return EXIT_FAILURE;
+      }
+
+      struct timespec start, end;
+      MatrixDouble nodeSums(numQueries, numClasses);
+      VectorDouble x(numDimensions);
+      VectorDouble y;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      for(UINT i=0; i<numQueries; i++){
+        for(UINT j=0; j<numDimensions; j++) x[j] = queries[i][j];
+        for(UINT k=0; k<numClasses; k++) nodeSums[i][k] = 0;
+        for(UINT t=0; t<trees.size(); t++){
+          trees[t]->predict(x, y);
+          for(UINT k=0; k<numClasses; k++) nodeSums[i][k] += y[k];
+        }
+      }
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double nodeTime = getElapsedMicroSeconds(start, end) / numQueries;
+
+      UINT mismatches = 0;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      for(UINT i=0; i<numQueries; i++){
+        for(UINT j=0; j<numDimensions; j++) x[j] = queries[i][j];
+        forest.predict(x);
+        VectorDouble distances = forest.getClassDistances();
+        for(UINT k=0; k<numClasses; k++) if (distances[k] != nodeSums[i][k]) { mismatches++; break; }
+      }
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double flatTime = getElapsedMicroSeconds(start, end) / numQueries;
+
+      vector< UINT > labels;
+      MatrixDouble likelihoods, distances;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      forest.predictBatch(queries, labels, likelihoods, distances);
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double batchTime = getElapsedMicroSeconds(start, end) / numQueries;
+      for(UINT i=0; i<numQueries; i++){
+        for(UINT k=0; k<numClasses; k++) if (distances[i][k] != nodeSums[i][k]) { mismatches++; break; }
+      }
+
+      for(UINT t=0; t<trees.size(); t++){
+        trees[t]->clear();
+        delete trees[t];
+      }
+
+      printf("%u\t%u\t\t%u\t%.2f\t\t%.2f\t\t%.2f\t\t%u\n", numSamples, maxDepth, flatForest.getNumNodes(), nodeTime, flatTime, batchTime, mismatches);
+      totalMismatches += mismatches;
+    }
+  }
+
+  return totalMismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,122 @@
+#include "GRT.h"
+
+#include <time.h>
+
+using namespace GRT;
+
+//Times the single pass RunningStatistics against the separate mean, standard deviation and covariance passes MatrixDouble used to make
+static double getElapsedMilliSeconds(const struct timespec &start, const struct timespec &end) {
+  return (end.tv_sec - start.tv_sec) * 1.0e3 + (end.tv_nsec - start.tv_nsec) / 1.0e6;
+}
+
+static void twoPassStatistics(const MatrixDouble &data, VectorDouble &mean, VectorDouble &stdDev, MatrixDouble &cov) {
+  const UINT M = data.getNumRows();
+  const UINT N = data.getNumCols();
+  mean = data.getMean();
+  stdDev.assign(N, 0);
+  for(UINT j=0; j<N; j++){
+    for(UINT i=0; i<M; i++) stdDev[j] += (data[i][j]-mean[j])*(data[i][j]-mean[j]);
+    stdDev[j] = sqrt( stdDev[j] / double(M-1) );
+  }
+  cov.resize(N, N);
+  for(UINT j=0; j<N; j++){
+    for(UINT k=0; k<N; k++){
+      cov[j][k] = 0;
+      for(UINT i=0; i<M; i++) cov[j][k] += (data[i][j]-mean[j]) * (data[i][k]-mean[k]);
+      cov[j][k] /= double(M-1);
+    }
+  }
+}
+
+//The ranges must match a plain min and max of each column exactly, the data is offset so a range that starts from 0 is caught
+static bool hasSameRanges(const vector< MinMax > &ranges, const MatrixDouble &data) {
+  if (ranges.size() != data.getNumCols()) return false;
+  for(UINT j=0; j<data.getNumCols(); j++){
+    double minValue = data[0][j], maxValue = data[0][j];
+    for(UINT i=1; i<data.getNumRows(); i++){
+      minValue = std::min(minValue, data[i][j]);
+      maxValue = std::max(maxValue, data[i][j]);
+    }
+    if (ranges[j].minValue != minValue || ranges[j].maxValue != maxValue) return false;
+  }
+  return true;
+}
+
+static double getMaxRelativeError(const VectorDouble &a, const VectorDouble &b) {
+  double maxError = 0;
+  for(UINT i=0; i<a.size(); i++){
+    const double error = fabs(a[i]-b[i]) / (fabs(b[i]) > 1.0e-12 ? fabs(b[i]) : 1.0);
+    if (error > maxError) maxError = error;
+  }
+  return maxError;
+}
+
+int main(int argc, const char * argv[]) {
+  const UINT numThreads = 4;
+  const double offset = 1.0e6;
+  Random random;
+  UINT numRangeMismatches = 0;
+
+  printf("Rows\tDims\tTwoPass(ms)\tSinglePass(ms)\tThreaded(ms)\tPerSample(ms)\tMaxRelError\tRanges\n");
+
+  for(UINT M=10000; M<=1000000; M*=10){
+    for(UINT N=8; N<=64; N*=8){
+      //A large offset makes the mean much bigger than the spread, which is where a naive one pass sum of squares breaks down
+      MatrixDouble data(M, N);
+      for(UINT i=0; i<M; i++){
+        for(UINT j=0; j<N; j++){
+          data[i][j] = offset + random.getRandomNumberGauss(0, 1.0 + j) + (j > 0 ? data[i][j-1] - offset : 0);
+        }
+      }
+
+      struct timespec start, end;
+      VectorDouble mean, stdDev;
+      MatrixDouble cov;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      twoPassStatistics(data, mean, stdDev, cov);
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double twoPassTime = getElapsedMilliSeconds(start, end);
+
+      RunningStatistics stats(N, true);
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      stats.update(data);
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double singlePassTime = getElapsedMilliSeconds(start, end);
+
+      RunningStatistics threadedStats(N, true);
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      threadedStats.update(data, numThreads);
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double threadedTime = getElapsedMilliSeconds(start, end);
+
+      //Record the samples one at a time into two halves and merge them, as a dataset being recorded would
+      RunningStatistics firstHalf(N, true), secondHalf(N, true);
+      VectorDouble sample(N);
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      for(UINT i=0; i<M; i++){
+        for(UINT j=0; j<N; j++) sample[j] = data[i][j];
+        if (i < M/2) firstHalf.update(sample);
+        else secondHalf.update(sample);
+      }
+      firstHalf.merge(secondHalf);
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      double perSampleTime = getElapsedMilliSeconds(start, end);
+
+      double maxError = 0;
+      RunningStatistics *results[3] = {&stats, &threadedStats, &firstHalf};
+      for(UINT r=0; r<3; r++){
+        maxError = std::max(maxError, getMaxRelativeError(results[r]->getMean(), mean));
+        maxError = std::max(maxError, getMaxRelativeError(results[r]->getStdDev(), stdDev));
+        MatrixDouble resultCov = results[r]->getCovarianceMatrix();
+        maxError = std::max(maxError, getMaxRelativeError(resultCov.getData() == NULL ? VectorDouble() : VectorDouble(resultCov.getData(), resultCov.getData()+N*N), VectorDouble(cov.getData(), cov.getData()+N*N)));
+        if (!hasSameRanges(results[r]->getRanges(), data)) numRangeMismatches++;
+      }
+      const bool rangesOk = hasSameRanges(data.getRanges(), data);
+      if (!rangesOk) numRangeMismatches++;
+
+      printf("%u\t%u\t%.2f\t\t%.2f\t\t%.2f\t\t%.2f\t\t%.2e\t%s\n", M, N, twoPassTime, singlePassTime, threadedTime, perSampleTime, maxError, rangesOk ? "ok" : "FAILED");
+    }
+  }
+
+  return numRangeMismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}